@@ -232,6 +232,7 @@
 #define MEM_RESERVED 0x00080000
 #define MEM_HIDDEN 0x00100000
 #define MEM_TASK 0x00200000
+#define MEM_UNREGISTERED 0x00400000
 #define MEM_CALLER 0x00800000
 #define MEM_READ_WRITE 0x00030000
 
@@ -1198,6 +1199,7 @@ struct ClipRectangle {
 #define RES_FREE_SWAP 29
 #define RES_KEY_STATE 30
 #define RES_CORE_IDL 31
+#define RES_THREAD_POOL 32
 
 // Path types for SetResourcePath()
 
@@ -1452,6 +1454,14 @@ struct FieldDef {
    LONG    Value;   // The value of the constant.
 };
 
+struct SlabStats {
+   LONG  Size;         // The largest block size, in bytes, that is served by this class.
+   LONG  Pages;        // Total number of pages that have been allocated to this class.
+   LARGE Allocations;  // Total number of blocks allocated from this class.
+   LARGE Frees;        // Total number of blocks returned to this class, including RemoteFrees.
+   LARGE RemoteFrees;  // Total number of blocks that were freed by a thread other than the one that allocated them.
+};
+
 struct SystemState {
    CSTRING * ErrorMessages;    // A sorted array of all error codes, translated into human readable strings.
    CSTRING   RootPath;         // The current root path, which defaults to the location of the installation folder.
@@ -1464,6 +1474,9 @@ struct SystemState {
    LONG      InstanceID;       // This is the ID of the instance that the calling process resides in.
    LONG      TotalErrorMessages; // The total number of error codes listed in the ErrorMessages array.
    LONG      Stage;            // The current operating stage.  -1 = Initialising, 0 indicates normal operating status; 1 means that the program is shutting down; 2 indicates a program restart; 3 is for mode switches.
+   LONG      TotalSlabClasses; // The total number of entries in the Slabs array.
+   const struct SlabStats * Slabs;     // Allocation counters for each size class of the small block allocator.
+   LARGE     SlabMisses;       // Total number of private allocations that were not eligible for the small block allocator.
 };
 
 struct Variable {
@@ -1558,6 +1571,18 @@ struct ThreadActionMessage {
    FUNCTION  Callback;  // Callback function to execute on action completion.
 };
 
+struct FieldHandle {
+   OBJECTPTR      Object;  // The object that the field belongs to.  This can be an integral child of the queried object.
+   struct Field * Field;   // The field descriptor.
+};
+
+struct ThreadAction {
+   OBJECTPTR Object;    // The object that will perform the action.
+   LONG      ActionID;  // The action or method to execute.
+   APTR      Args;      // Optional parameters for the action or method.
+   ERROR     Error;     // The error code returned by the action.
+};
+
 typedef struct MemInfo {
    APTR     Start;       // The starting address of the memory block (does not apply to shared blocks).
    OBJECTID ObjectID;    // The object that owns the memory block.
@@ -1584,9 +1609,9 @@ struct MsgHandler {
 
 struct KeyStore {
    APTR Mutex;                 // Internal mutex for managing thread-safety.
-   struct KeyPair * * Data;    // Key-pairs are stored here.
+   struct KeySlot * Data;      // Hash table slots that refer to the stored key-pairs.
    LONG TableSize;             // The size of the available storage area.
-   LONG Total;                 // Total number of currently stored key-pairs, including dead keys.
+   LONG Total;                 // Total number of currently stored key-pairs.
    LONG Flags;                 // Optional flags used for VarNew()
 };
 
@@ -1905,6 +1930,11 @@ struct CoreBase {
    ERROR (*_VarLock)(struct KeyStore *, LONG);
    void (*_VLogF)(int, const char *, const char *, va_list);
    ERROR (*_WakeProcess)(LONG);
+   ERROR (*_ActionThreadBatch)(struct ThreadAction *, LONG);
+   ERROR (*_ResolveFieldHandle)(APTR, ULONG, struct FieldHandle *);
+   ERROR (*_GetFieldByHandle)(struct FieldHandle *, FIELD, APTR);
+   ERROR (*_SetFieldByHandle)(struct FieldHandle *, FIELD, ...);
+   ERROR (*_ThreadBatch)(void (*Routine)(APTR, LONG), APTR, LONG);
 };
 
 #ifndef PRV_CORE_MODULE
@@ -2099,6 +2129,11 @@ struct CoreBase {
 #define VarLock(...) (CoreBase->_VarLock)(__VA_ARGS__)
 #define VLogF(...) (CoreBase->_VLogF)(__VA_ARGS__)
 #define WakeProcess(...) (CoreBase->_WakeProcess)(__VA_ARGS__)
+#define ActionThreadBatch(...) (CoreBase->_ActionThreadBatch)(__VA_ARGS__)
+#define ResolveFieldHandle(...) (CoreBase->_ResolveFieldHandle)(__VA_ARGS__)
+#define GetFieldByHandle(...) (CoreBase->_GetFieldByHandle)(__VA_ARGS__)
+#define SetFieldByHandle(...) (CoreBase->_SetFieldByHandle)(__VA_ARGS__)
+#define ThreadBatch(...) (CoreBase->_ThreadBatch)(__VA_ARGS__)
 #endif
 
 
@@ -2504,6 +2539,7 @@ typedef struct rkMetaClass {
     STRING Location;      // Location of the class binary, this field exists purely for caching the location string if the user reads it
     struct ActionEntry ActionTable[AC_END];
     WORD OriginalFieldTotal;
+    struct FieldHash *prvFieldHash;     // Field lookup table, see lookup_id()
   
 #endif
 } objMetaClass;
@@ -3428,6 +3464,10 @@ struct SharedControl {
    LONG MagicKey;                   // This magic key is set to the semaphore key (used only as an indicator for initialisation)
    LONG BlocksOffset;               // Array of available shared memory pages
    LONG SortedBlocksOffset;         // Array of shared memory blocks sorted by MemoryID
+   LONG FreeSlotsOffset;            // Stack of unused indexes in the shared memory blocks table
+   LONG PoolMapOffset;              // Allocation state of the public memory pool, if the pool is in use
+   volatile LONG TotalSorted;       // Total number of entries in the sorted blocks array
+   volatile LONG TotalFreeSlots;    // Total number of entries in the free slot stack
    LONG SemaphoreOffset;            // Offset to the semaphore control array
    LONG TaskOffset;                 // Offset to the task control array
    LONG MemoryOffset;               // Offset to the shared memory allocations
@@ -53,6 +53,7 @@
 #define BAF_BLEND 0x00000002
 #define BAF_FILL 0x00000001
 #define BAF_COPY 0x00000004
+#define BAF_ORDERED 0x00000008
 
 // Flags for CopySurface().
 
@@ -72,7 +73,10 @@
 #define CSTF_NEIGHBOUR 0x00000008
 #define CSTF_CUBIC 0x00000010
 #define CSTF_BICUBIC 0x00000010
+#define CSTF_MITCHELL 0x00000010
 #define CSTF_CLAMP 0x00000020
+#define CSTF_LANCZOS 0x00000040
+#define CSTF_AREA 0x00000080
 
 // Bitmap types
 
@@ -655,6 +659,7 @@ struct DisplayBase {
    ERROR (*_UnsubscribeInput)(LONG);
    CSTRING (*_GetInputTypeName)(LONG);
    DOUBLE (*_ScaleToDPI)(DOUBLE);
+   void (*_GetPresentStats)(LARGE *, LARGE *, LARGE *, LARGE *);
 };
 
 #ifndef PRV_DISPLAY_MODULE
@@ -695,6 +700,7 @@ struct DisplayBase {
 #define gfxUnsubscribeInput(...) (DisplayBase->_UnsubscribeInput)(__VA_ARGS__)
 #define gfxGetInputTypeName(...) (DisplayBase->_GetInputTypeName)(__VA_ARGS__)
 #define gfxScaleToDPI(...) (DisplayBase->_ScaleToDPI)(__VA_ARGS__)
+#define gfxGetPresentStats(...) (DisplayBase->_GetPresentStats)(__VA_ARGS__)
 #endif
 
 #define gfxReleasePointer(a)    (ReleaseObject(a))
@@ -192,6 +192,9 @@
 #define VPF_BITMAP_SIZED 0x00000001
 #define VPF_RENDER_TIME 0x00000002
 #define VPF_RESIZE 0x00000004
+#define VPF_PARALLEL 0x00000008
+#define VPF_INCREMENTAL 0x00000010
+#define VPF_CLEAR 0x00000020
 
 #define VSM_AUTO 0
 #define VSM_NEIGHBOUR 1
@@ -353,10 +356,21 @@ typedef struct rkVectorScene {
    LONG   PageWidth;              // Fixed page width - vector viewport width will be stretched to fit this if resizing is enabled.
    LONG   PageHeight;             // Fixed page height - vector viewport height will be stretched to fit this if resizing is enabled.
    LONG   SampleMethod;           // VSM: Method to use for resampling images and patterns.
+   LONG   DamageX;                // Left edge of the area that was redrawn by the last incremental Draw.
+   LONG   DamageY;                // Top edge of the area that was redrawn by the last incremental Draw.
+   LONG   DamageWidth;            // Width of the area that was redrawn by the last incremental Draw.
+   LONG   DamageHeight;           // Height of the area that was redrawn by the last incremental Draw.
+   LARGE  PathTime;               // Microseconds spent generating paths during the last rendering operation.
+   LARGE  FilterTime;             // Microseconds spent processing filter effects during the last rendering operation.
 
 #ifdef PRV_VECTORSCENE
    class VMAdaptor *Adaptor;
+   class ScratchPool *Scratch; // Recycles the temporary surfaces that are needed while drawing
    agg::rendering_buffer *Buffer;
+   struct rkBitmap *LastBitmap;
+   struct ClipRectangle LastClip;
+   struct ClipRectangle Damage[8]; // Areas of the Bitmap that require redrawing by the next incremental Draw
+   UBYTE  TotalDamage;
    UBYTE  AdaptorType;
   
 #endif
@@ -492,6 +506,7 @@ typedef struct rkVectorFilter {
    objBitmap *SrcBitmap; // A temporary alpha enabled drawing of the vector that is targeted by the filter.
    objBitmap *BkgdBitmap;
    objBitmap *MergeBitmap;
+   class ScratchPool *Pool; // The scene pool that the bank data and MergeBitmap are borrowed from
    STRING Path; // Affix this path to file references (e.g. feImage).
    struct {
       objBitmap *Bitmap;
@@ -502,6 +517,8 @@ typedef struct rkVectorFilter {
    struct effect BkgdGraphic;
    LONG BoundX, BoundY, BoundWidth, BoundHeight;  // Calculated pixel boundary for the entire filter and its effects.
    LONG ViewX, ViewY, ViewWidth, ViewHeight; // Boundary of the target area (for user space coordinate mode)
+   LARGE CacheKey;  // Hash of the inputs that produced the retained effect results, or zero if there is no valid result
+   LARGE CacheSize; // Bitmap memory held for the cached result, as counted against glFilterCacheLimit
    UBYTE BankIndex;
   
 #endif
@@ -700,6 +717,9 @@ struct VectorBase {
    void (*_RewindPath)(APTR);
    LONG (*_GetVertex)(APTR, DOUBLE *, DOUBLE *);
    ERROR (*_ApplyPath)(APTR, APTR);
+   void (*_SetFilterCache)(LARGE);
+   void (*_SetGlyphCache)(LARGE);
+   void (*_GetGlyphCacheStats)(LARGE *, LARGE *, LARGE *);
 };
 
 #ifndef PRV_VECTOR_MODULE
@@ -721,6 +741,9 @@ struct VectorBase {
 #define vecRewindPath(...) (VectorBase->_RewindPath)(__VA_ARGS__)
 #define vecGetVertex(...) (VectorBase->_GetVertex)(__VA_ARGS__)
 #define vecApplyPath(...) (VectorBase->_ApplyPath)(__VA_ARGS__)
+#define vecSetFilterCache(...) (VectorBase->_SetFilterCache)(__VA_ARGS__)
+#define vecSetGlyphCache(...) (VectorBase->_SetGlyphCache)(__VA_ARGS__)
+#define vecGetGlyphCacheStats(...) (VectorBase->_GetGlyphCacheStats)(__VA_ARGS__)
 #endif
 
 //****************************************************************************
@@ -271,6 +271,7 @@ ERROR CLASS_Free(rkMetaClass *Class, APTR Void)
 {
    VarSet(glClassMap, Class->ClassName, NULL, 0); // Deregister the class.
 
+   free_field_hash(Class);
    if (Class->prvFields) { FreeResource(Class->prvFields); Class->prvFields = NULL; }
    if (Class->Methods)   { FreeResource(Class->Methods); Class->Methods = NULL; }
    if (Class->Location)  { FreeResource(Class->Location); Class->Location = NULL; }
@@ -747,9 +748,9 @@ static ERROR GET_PrivateObjects(rkMetaClass *Self, OBJECTID **Array, LONG *Eleme
    parasol::Log log;
    std::list<OBJECTID> objlist;
 
-   ThreadLock lock(TL_PRIVATE_MEM, 4000);
-   if (lock.granted()) {
-      for (const auto & [ id, mem ] : glPrivateMemory) {
+   for (auto &shard : glPrivateMemory.Shards) {
+      std::shared_lock lock(shard.Lock);
+      for (const auto & [ id, mem ] : shard.Map) {
          OBJECTPTR object;
          if ((mem.Flags & MEM_OBJECT) and (object = (OBJECTPTR)mem.Address)) {
             if (Self->SubClassID IS object->ClassID) {
@@ -758,7 +759,6 @@ static ERROR GET_PrivateObjects(rkMetaClass *Self, OBJECTID **Array, LONG *Eleme
          }
       }
    }
-   else return log.warning(ERR_LockFailed);
 
    if (!objlist.size()) {
       *Array = NULL;
@@ -1242,6 +1242,7 @@ ERROR sort_class_fields(rkMetaClass *Class, Field *fields)
 
    for (LONG i=0; i < Class->TotalFields; i++) fields[i].Index = i;
 
+   build_field_hash(Class, NULL);
    return ERR_Okay;
 }
 
@@ -1690,19 +1691,9 @@ ClassItem * find_class(ULONG Hash)
 
 static Field * lookup_id_byclass(rkMetaClass *Class, ULONG FieldID, rkMetaClass **Result)
 {
-   Field *field = Class->prvFields;
-
-   LONG floor = 0;
-   LONG ceiling = Class->TotalFields;
-   while (floor < ceiling) {
-      LONG i = (floor + ceiling)>>1;
-      if (field[i].FieldID < FieldID) floor = i + 1;
-      else if (field[i].FieldID > FieldID) ceiling = i;
-      else {
-         while ((i > 0) AND (field[i-1].FieldID IS FieldID)) i--;
-         *Result = Class;
-         return field+i;
-      }
+   if (auto field = lookup_own_field(Class, FieldID)) {
+      *Result = Class;
+      return field;
    }
 
    if (Class->Flags & CLF_PROMOTE_INTEGRAL) {
@@ -1490,7 +1490,11 @@ static ERROR TASK_Free(objTask *Self, APTR Void)
    if (Self->ProcessPathMID) { FreeResourceID(Self->ProcessPathMID); Self->ProcessPathMID = 0; }
    if (Self->ParametersMID)  { FreeResourceID(Self->ParametersMID);  Self->ParametersMID  = 0; }
    if (Self->CopyrightMID)   { FreeResourceID(Self->CopyrightMID);   Self->CopyrightMID   = 0; }
-   if (Self->MessageMID)     { FreeResourceID(Self->MessageMID);     Self->MessageMID     = 0; }
+   if (Self->MessageMID) {
+      if (Self->MessageMID IS glTaskMessageMID) free_task_queue();
+      FreeResourceID(Self->MessageMID);
+      Self->MessageMID = 0;
+   }
 
    if (Self->MsgAction)          { FreeResource(Self->MsgAction);          Self->MsgAction          = NULL; }
    if (Self->MsgGetField)        { FreeResource(Self->MsgGetField);        Self->MsgGetField        = NULL; }
@@ -1813,12 +1817,13 @@ static ERROR TASK_Init(objTask *Self, APTR Void)
       glCurrentTaskID = Self->Head.UniqueID;
       glCurrentTask   = Self;
 
-      // Allocate the message block for this Task
+      // Allocate the message block for this Task.  Other processes write to the queue without locking it, so the
+      // block is non-blocking.  It remains accessible to this process until the Task is freed.
 
-      if (!AllocMemory(sizeof(MessageHeader), MEM_PUBLIC, (void **)&msgblock, &glTaskMessageMID)) {
+      if (!AllocMemory(sizeof(MessageHeader), MEM_PUBLIC|MEM_NO_BLOCKING, (void **)&msgblock, &glTaskMessageMID)) {
          Self->MessageMID = glTaskMessageMID;
          msgblock->TaskIndex = glTaskEntry->Index;
-         ReleaseMemoryID(glTaskMessageMID);
+         glTaskMessageQueue = msgblock;
       }
       else return ERR_AllocMemory;
 
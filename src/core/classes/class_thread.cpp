@@ -46,104 +46,246 @@ within the thread routine.
 #include "../defs.h"
 #include <parasol/main.h>
 
-#define THREADPOOL_MAX 6
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <thread>
 
 static void thread_entry_cleanup(void *);
 
-static LONG glActionThreadsIndex = 0;
-static struct {
-   objThread *Thread;
-   BYTE InUse;
-} glActionThreads[THREADPOOL_MAX];
+THREADVAR BYTE tlThreadCrashed;
+THREADVAR objThread *tlThreadRef;
 
 //****************************************************************************
-// Retrieve a thread object from the thread pool.
+// ActionThread() requests are executed by a pool of worker threads that is sized to the number of processor cores by
+// default (see --threads in OpenCore()).  Each worker has its own task queue.  A worker takes the newest task from
+// its own queue first, and when that is empty it steals the oldest task from another worker.  The pool is started on
+// the first submission and is stopped by remove_threadpool() on shutdown.
+
+struct PoolTask {
+   void (*Routine)(APTR);
+   APTR Data;
+};
+
+struct PoolWorker {
+   std::mutex Lock; // Guards Tasks
+   std::deque<PoolTask> Tasks;
+   std::thread Thread;
+};
 
-ERROR threadpool_get(objThread **Result)
+static std::vector<PoolWorker *> glWorkers;
+static std::atomic<LONG> glPoolSize(0);      // Published once glWorkers is fully constructed
+static std::atomic<LONG> glPoolQueued(0);    // Tasks that are queued and not yet taken
+static std::atomic<ULONG> glPoolNext(0);     // Round-robin distribution of tasks from non-worker threads
+static std::mutex glPoolLock;                // Guards pool start-up, glPoolStop and sleeping workers
+static std::condition_variable glPoolWake;   // Signalled when a task is queued
+static std::condition_variable glPoolDone;   // Signalled when the last task of a batch is complete
+static bool glPoolStop = false;
+static THREADVAR LONG tlWorkerIndex = -1;    // Index of the pool worker running on this thread, or -1
+
+//****************************************************************************
+// Take a task for the calling thread.  A worker's own queue is checked first, then the queues of the other workers
+// are checked in turn.
+
+static bool take_task(PoolTask &Task)
 {
-   parasol::Log log;
-   objThread *thread = NULL;
-   ERROR error = ERR_Okay;
-
-   log.traceBranch("");
-
-   ThreadLock lock(TL_THREADPOOL, 2000);
-   if (lock.granted()) {
-      for (LONG i=0; i < glActionThreadsIndex; i++) {
-         if ((glActionThreads[i].Thread) and (!glActionThreads[i].InUse)) {
-            thread = glActionThreads[i].Thread;
-            glActionThreads[i].InUse = TRUE;
-            break;
-         }
+   if (glPoolQueued.load(std::memory_order_acquire) <= 0) return false;
+
+   LONG total = glPoolSize.load(std::memory_order_acquire);
+   LONG self = tlWorkerIndex;
+
+   if (self >= 0) {
+      auto worker = glWorkers[self];
+      const std::lock_guard<std::mutex> lock(worker->Lock);
+      if (!worker->Tasks.empty()) {
+         Task = worker->Tasks.back();
+         worker->Tasks.pop_back();
+         glPoolQueued--;
+         return true;
       }
+   }
 
-      if (!thread) { // Allocate a new thread.
-         if (!(error = NewPrivateObject(ID_THREAD, NF_UNTRACKED, (OBJECTPTR *)&thread))) {
-            SetName(&thread->Head, "ActionThread");
-            if (!(error = acInit(&thread->Head))) {
-               LONG i;
-               if ((i = glActionThreadsIndex) < THREADPOOL_MAX) { // Record the thread in the pool, if there is room for it.
-                  glActionThreads[i].Thread = thread;
-                  glActionThreads[i].InUse = TRUE;
-                  glActionThreadsIndex++;
-               }
-            }
-            else { acFree(&thread->Head); thread = NULL; }
-         }
+   LONG start = (self >= 0) ? self + 1 : glPoolNext.load(std::memory_order_relaxed);
+   for (LONG i=0; i < total; i++) {
+      LONG index = (start + i) % total;
+      if (index IS self) continue;
+      auto worker = glWorkers[index];
+      const std::lock_guard<std::mutex> lock(worker->Lock);
+      if (!worker->Tasks.empty()) {
+         Task = worker->Tasks.front();
+         worker->Tasks.pop_front();
+         glPoolQueued--;
+         return true;
+      }
+   }
+
+   return false;
+}
+
+//****************************************************************************
+
+// Entry point for the pool workers.  The thread state is prepared and cleaned up in the same way as thread_entry(), but
+// as there is no Thread object the context refers to the current task.
+
+static void pool_worker(LONG Index)
+{
+   tlThreadCrashed = TRUE;
+   tlThreadRef = NULL;
+   pthread_cleanup_push(&thread_entry_cleanup, NULL);
+
+   ObjectContext worker_ctx = {
+      .Stack  = tlContext,
+      .Object = glCurrentTask ? &glCurrentTask->Head : glTopContext.Object,
+      .Field  = NULL,
+      .Action = 0
+   };
+   tlContext = &worker_ctx;
+   tlWorkerIndex = Index;
+
+   PoolTask task;
+   while (true) {
+      if (take_task(task)) {
+         task.Routine(task.Data);
+         continue;
       }
+
+      std::unique_lock<std::mutex> lock(glPoolLock);
+      if ((glPoolStop) and (glPoolQueued.load() <= 0)) break;
+      glPoolWake.wait(lock, [] { return (glPoolStop) or (glPoolQueued.load() > 0); });
    }
-   else error = log.warning(ERR_Lock);
 
-   if (thread) *Result = thread;
+   tlWorkerIndex = -1;
+   tlContext = &glTopContext;
 
-   return error;
+   tlThreadCrashed = FALSE;
+   pthread_cleanup_pop(TRUE);
 }
 
 //****************************************************************************
-// Mark a thread in the pool as no longer in use.  The thread object will be destroyed if it is not in the pool.
+// Returns the number of workers in the pool, or the number that will be started if the pool is not running yet.
 
-void threadpool_release(objThread *Thread)
+LONG threadpool_size(void)
 {
-   parasol::Log log;
+   if (LONG workers = glPoolSize.load(std::memory_order_acquire)) return workers;
 
-   log.traceBranch("Thread: #%d, Total: %d", Thread->Head.UniqueID, glActionThreadsIndex);
+   LONG total = glThreadPoolSize;
+   if (total < 1) total = std::thread::hardware_concurrency();
+   if (total < 1) total = 1;
+   return total;
+}
 
-   ThreadLock lock(TL_THREADPOOL, 2000);
-   if (lock.granted()) {
-      for (LONG i=0; i < glActionThreadsIndex; i++) {
-         if (glActionThreads[i].Thread IS Thread) {
-            glActionThreads[i].InUse = FALSE;
-            return;
-         }
+//****************************************************************************
+// Start the worker threads.  Called with glPoolLock held.
+
+static ERROR start_pool(void)
+{
+   parasol::Log log("ThreadPool");
+
+   if (glPoolStop) return ERR_SystemLocked;
+
+   LONG total = threadpool_size();
+
+   log.branch("Starting %d worker threads.", total);
+
+   try {
+      glWorkers.reserve(total);
+      for (LONG i=0; i < total; i++) glWorkers.push_back(new PoolWorker);
+      for (LONG i=0; i < total; i++) glWorkers[i]->Thread = std::thread(&pool_worker, i);
+   }
+   catch (...) { // Any workers that did start are kept, provided that there is at least one.
+      while ((!glWorkers.empty()) and (!glWorkers.back()->Thread.joinable())) {
+         delete glWorkers.back();
+         glWorkers.pop_back();
+      }
+      if (glWorkers.empty()) return log.warning(ERR_SystemCall);
+   }
+
+   glPoolSize.store((LONG)glWorkers.size(), std::memory_order_release);
+   return ERR_Okay;
+}
+
+//****************************************************************************
+// Queue a routine for execution by the thread pool.  Tasks submitted by a worker are kept in its own queue so that
+// they are processed with a warm cache; all other submissions are distributed evenly.
+
+ERROR threadpool_submit(void (*Routine)(APTR), APTR Data)
+{
+   if (glPoolSize.load(std::memory_order_acquire) < 1) {
+      const std::lock_guard<std::mutex> lock(glPoolLock);
+      if (glPoolSize.load() < 1) {
+         if (auto error = start_pool()) return error;
       }
+   }
+
+   LONG total = glPoolSize.load(std::memory_order_acquire);
+   LONG index = tlWorkerIndex;
+   if (index < 0) index = glPoolNext.fetch_add(1, std::memory_order_relaxed) % total;
+
+   {
+      auto worker = glWorkers[index];
+      const std::lock_guard<std::mutex> lock(worker->Lock);
+      worker->Tasks.push_back({ Routine, Data });
+   }
+
+   glPoolQueued++;
+
+   { const std::lock_guard<std::mutex> lock(glPoolLock); }
+   glPoolWake.notify_one();
+   return ERR_Okay;
+}
 
-      // If the thread object is not pooled, assume it was allocated dynamically from threadpool_get() and destroy it.
+//****************************************************************************
+// Called by a task on completion to decrement the pending count of its batch.
+
+void threadpool_complete(std::atomic<LONG> &Pending)
+{
+   if (--Pending > 0) return;
+   { const std::lock_guard<std::mutex> lock(glPoolLock); }
+   glPoolDone.notify_all();
+}
+
+//****************************************************************************
+// Wait for a batch of tasks to complete.  The calling thread runs queued tasks while it waits, so a batch will always
+// make progress even if every worker is busy, or if this is called from within a task.
+
+void threadpool_wait(std::atomic<LONG> &Pending)
+{
+   PoolTask task;
+   while (Pending.load() > 0) {
+      if (take_task(task)) {
+         task.Routine(task.Data);
+         continue;
+      }
 
-      lock.release();
-      acFree(&Thread->Head);
+      std::unique_lock<std::mutex> lock(glPoolLock);
+      glPoolDone.wait(lock, [&Pending] { return Pending.load() <= 0; });
    }
 }
 
 //****************************************************************************
-// Destroy the entire thread pool.  For use on application shutdown only.
+// Stop the worker threads once all queued tasks are complete.  For use on application shutdown only.
 
 void remove_threadpool(void)
 {
    parasol::Log log("Core");
 
-   log.traceBranch("Removing the internal thread pool, size %d.", glActionThreadsIndex);
+   log.traceBranch("Removing the internal thread pool, size %d.", glPoolSize.load());
 
-   ThreadLock lock(TL_THREADPOOL, 2000);
-   if (lock.granted()) {
-      for (LONG i=0; i < glActionThreadsIndex; i++) {
-         if (glActionThreads[i].Thread) {
-            if (glActionThreads[i].InUse) log.warning("Pooled thread #%d is still in use on shutdown.", i);
-            acFree(&glActionThreads[i].Thread->Head);
-            glActionThreads[i].Thread = NULL;
-            glActionThreads[i].InUse = FALSE;
-         }
-      }
+   {
+      const std::lock_guard<std::mutex> lock(glPoolLock);
+      glPoolStop = true;
+   }
+   glPoolWake.notify_all();
+
+   if (glPoolQueued.load() > 0) log.warning("%d queued tasks will be completed before shutdown.", glPoolQueued.load());
+
+   for (auto worker : glWorkers) {
+      if (worker->Thread.joinable()) worker->Thread.join();
+      delete worker;
    }
+
+   glPoolSize = 0;
+   glWorkers.clear();
 }
 
 //****************************************************************************
@@ -219,9 +361,6 @@ ERROR msg_threadcallback(APTR Custom, LONG MsgID, LONG MsgType, APTR Message, LO
 //****************************************************************************
 // This is the entry point for all threads.
 
-THREADVAR BYTE tlThreadCrashed;
-THREADVAR objThread *tlThreadRef;
-
 #ifdef _WIN32
 static int thread_entry(objThread *Self)
 #elif __unix__
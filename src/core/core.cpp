@@ -194,7 +194,6 @@ EXPORT struct CoreBase * OpenCore(OpenInfo *Info)
    if (alloc_private_lock(TL_MSGHANDLER, ALF_RECURSIVE)) return NULL;
    if (alloc_private_lock(TL_MEMORY_PAGES, 0)) return NULL; // For controlling access to glMemoryPages
    if (alloc_private_lock(TL_PRINT, 0)) return NULL; // For message logging only.
-   if (alloc_private_lock(TL_THREADPOOL, 0)) return NULL;
    if (alloc_private_lock(TL_OBJECT_LOOKUP, ALF_RECURSIVE)) return NULL;
    if (alloc_private_lock(TL_PRIVATE_MEM, ALF_RECURSIVE)) return NULL;
    if (alloc_private_cond(CN_PRIVATE_MEM, 0)) return NULL;
@@ -418,6 +417,9 @@ EXPORT struct CoreBase * OpenCore(OpenInfo *Info)
          else if (!StrCompare(Info->Args[i], "--gfx-driver=", 13, 0)) {
             StrCopy(Info->Args[i]+13, glDisplayDriver, sizeof(glDisplayDriver));
          }
+         else if (!StrCompare(Info->Args[i], "--threads=", 10, 0)) {
+            glThreadPoolSize = StrToInt(Info->Args[i]+10);
+         }
          else if (!StrMatch(Info->Args[i], "--global"))      Info->Flags |= OPF_GLOBAL_INSTANCE;
          else if (!StrMatch(Info->Args[i], "--solo"))        solo = TRUE;
          else if (!StrMatch(Info->Args[i], "--sync"))        glSync = TRUE;
@@ -602,6 +604,10 @@ EXPORT struct CoreBase * OpenCore(OpenInfo *Info)
 
    glSharedBlocks = (PublicAddress *)ResolveAddress(glSharedControl, glSharedControl->BlocksOffset);
    glSortedBlocks = (SortedAddress *)ResolveAddress(glSharedControl, glSharedControl->SortedBlocksOffset);
+   glFreeSlots    = (LONG *)ResolveAddress(glSharedControl, glSharedControl->FreeSlotsOffset);
+#ifndef USE_SHM
+   glPoolMap      = (PoolMap *)ResolveAddress(glSharedControl, glSharedControl->PoolMapOffset);
+#endif
    shSemaphores   = (SemaphoreEntry *)ResolveAddress(glSharedControl, glSharedControl->SemaphoreOffset);
    shTasks        = (TaskList *)ResolveAddress(glSharedControl, glSharedControl->TaskOffset);
 
@@ -1012,6 +1018,10 @@ EXPORT void CleanSystem(LONG Flags)
 static LONG glMemorySize = sizeof(SharedControl) +
                            (sizeof(PublicAddress) * MAX_BLOCKS) +
                            (sizeof(SortedAddress) * MAX_BLOCKS) +
+                           (sizeof(LONG) * MAX_BLOCKS) +
+#ifndef USE_SHM
+                           sizeof(PoolMap) +
+#endif
                            (sizeof(SemaphoreEntry) * MAX_SEMAPHORES) +
                            (sizeof(WaitLock) * MAX_WAITLOCKS) +
                            (sizeof(TaskList) * MAX_TASKS);
@@ -1279,6 +1289,14 @@ static ERROR init_shared_control(void)
    glSharedControl->SortedBlocksOffset = offset;
    offset += sizeof(SortedAddress) * glSharedControl->MaxBlocks;
 
+   glSharedControl->FreeSlotsOffset = offset;
+   offset += sizeof(LONG) * glSharedControl->MaxBlocks;
+
+#ifndef USE_SHM
+   glSharedControl->PoolMapOffset = offset;
+   offset += sizeof(PoolMap);
+#endif
+
    glSharedControl->SemaphoreOffset = offset;
    offset += sizeof(SemaphoreEntry) * MAX_SEMAPHORES;
 
@@ -1290,6 +1308,8 @@ static ERROR init_shared_control(void)
 
    glSharedControl->MemoryOffset = RoundPageSize(glMemorySize);
 
+   init_public_tables(glSharedControl);
+
    // Allocate public locks (for sharing between processes)
 
    #ifdef __unix__
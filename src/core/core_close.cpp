@@ -183,7 +183,7 @@ EXPORT void CloseCore(void)
       // cleaner exit.
 
       if (glCurrentTask) {
-         const auto children = glObjectChildren[glCurrentTask->Head.UniqueID]; // Take an immutable copy of the resource list
+         const auto children = glObjectChildren.copy(glCurrentTask->Head.UniqueID); // Take an immutable copy of the resource list
 
          if (children.size() > 0) {
             log.branch("Freeing %d objects allocated to task #%d.", (LONG)children.size(), glCurrentTask->Head.UniqueID);
@@ -232,14 +232,16 @@ EXPORT void CloseCore(void)
          parasol::Log log("Shutdown");
          log.branch("Freeing objects owned by foreign processes.");
 
-         for (const auto & [id, mem ] : glPrivateMemory) {
-            if (mem.Flags & MEM_OBJECT) {
-               auto obj = mem.Object;
-               if (obj) {
-                  if ((obj->Stats) and (obj->Flags & NF_FOREIGN_OWNER)) {
-                     acFree(obj);
-                     // Don't be concerned about the stability of glPrivateMemory.  FreeResource() takes measures
-                     // to avoid destabilising it during shutdown.
+         for (auto &shard : glPrivateMemory.Shards) {
+            for (const auto & [id, mem ] : shard.Map) {
+               if (mem.Flags & MEM_OBJECT) {
+                  auto obj = mem.Object;
+                  if (obj) {
+                     if ((obj->Stats) and (obj->Flags & NF_FOREIGN_OWNER)) {
+                        acFree(obj);
+                        // Don't be concerned about the stability of glPrivateMemory.  FreeResource() takes measures
+                        // to avoid destabilising it during shutdown.
+                     }
                   }
                }
             }
@@ -248,12 +250,14 @@ EXPORT void CloseCore(void)
 
       // Remove locks on any private objects that have not been unlocked yet
 
-      for (const auto & [ id, mem ] : glPrivateMemory) {
-         if ((mem.Flags & MEM_OBJECT) and (mem.AccessCount > 0)) {
-            auto obj = mem.Object;
-            if (obj) {
-               log.warning("Removing locks on object #%d, Owner: %d, Locks: %d", obj->UniqueID, obj->OwnerID, mem.AccessCount);
-               for (count=mem.AccessCount; count > 0; count--) ReleaseObject(obj);
+      for (auto &shard : glPrivateMemory.Shards) {
+         for (const auto & [ id, mem ] : shard.Map) {
+            if ((mem.Flags & MEM_OBJECT) and (mem.AccessCount > 0)) {
+               auto obj = mem.Object;
+               if (obj) {
+                  log.warning("Removing locks on object #%d, Owner: %d, Locks: %d", obj->UniqueID, obj->OwnerID, mem.AccessCount);
+                  for (count=mem.AccessCount; count > 0; count--) ReleaseObject(obj);
+               }
             }
          }
       }
@@ -356,11 +360,7 @@ EXPORT void CloseCore(void)
          }
       }
 
-      if (glFDTable) {
-         free(glFDTable);
-         glFDTable = NULL;
-         glTotalFDs = 0;
-      }
+      free_fd_table();
 
       log.trace("Removing private and public memory locks.");
 
@@ -427,6 +427,7 @@ EXPORT void CloseCore(void)
       free_private_memory();
    }
 
+   free_object_table();
    free_translate_buffer();
 
    log.debug("Detaching from the shared memory control structure.");
@@ -467,7 +468,6 @@ EXPORT void CloseCore(void)
    free_private_lock(TL_MSGHANDLER);
    free_private_lock(TL_MEMORY_PAGES);
    free_private_lock(TL_OBJECT_LOOKUP);
-   free_private_lock(TL_THREADPOOL);
    free_private_lock(TL_PRIVATE_MEM);
    free_private_lock(TL_PRINT);       // NB: After TL_PRINT is freed, any calls to message printing functions will result in a crash.
    free_private_cond(CN_PRIVATE_MEM);
@@ -525,11 +525,8 @@ EXPORT void Expunge(WORD Force)
             // if the module code is in use.
 
             bool class_in_use = false;
-            for (const auto & id : glObjectChildren[mod_master->Head.UniqueID]) {
-               auto mem = glPrivateMemory.find(id);
-               if (mem IS glPrivateMemory.end()) continue;
-
-               auto mc = (rkMetaClass *)mem->second.Address;
+            for (const auto & id : glObjectChildren.copy(mod_master->Head.UniqueID)) {
+               auto mc = (rkMetaClass *)GetMemAddress(id);
                if ((mc) and (mc->Head.ClassID IS ID_METACLASS) and (mc->OpenCount > 0)) {
                   log.msg("Module %s manages a class that is in use - Class: %s, Count: %d.", mod_master->Name, mc->ClassName, mc->OpenCount);
                   class_in_use = true;
@@ -586,11 +583,8 @@ EXPORT void Expunge(WORD Force)
                // Search for classes that have been created by this module and check their open count values to figure
                // out if the module code is in use.
 
-               for (const auto & id : glObjectChildren[mod_master->Head.UniqueID]) {
-                  auto mem = glPrivateMemory.find(id);
-                  if (mem IS glPrivateMemory.end()) continue;
-
-                  auto mc = (rkMetaClass *)mem->second.Address;
+               for (const auto & id : glObjectChildren.copy(mod_master->Head.UniqueID)) {
+                  auto mc = (rkMetaClass *)GetMemAddress(id);
                   if ((mc) and (mc->Head.ClassID IS ID_METACLASS) and (mc->OpenCount > 0)) {
                      log.warning("Warning: The %s module holds a class with existing objects (Class: %s, Objects: %d)", mod_master->Name, mc->ClassName, mc->OpenCount);
                   }
@@ -735,32 +729,36 @@ static void free_private_memory(void)
    // Free strings first
 
    LONG count = 0;
-   for (auto & [ id, mem ] : glPrivateMemory) {
-      if ((mem.Address) and (mem.Flags & MEM_STRING)) {
-         if (!glCrashStatus) log.warning("Unfreed private string \"%.80s\" (%p).", (CSTRING)mem.Address, mem.Address);
-         mem.AccessCount = 0;
-         FreeResource(mem.Address);
-         mem.Address = NULL;
-         count++;
+   for (auto &shard : glPrivateMemory.Shards) {
+      for (auto & [ id, mem ] : shard.Map) {
+         if ((mem.Address) and (mem.Flags & MEM_STRING)) {
+            if (!glCrashStatus) log.warning("Unfreed private string \"%.80s\" (%p).", (CSTRING)mem.Address, mem.Address);
+            mem.AccessCount = 0;
+            FreeResource(mem.Address);
+            mem.Address = NULL;
+            count++;
+         }
       }
    }
 
    // Free all other memory blocks
 
-   for (auto & [ id, mem ] : glPrivateMemory) {
-      if (mem.Address) {
-         if (!glCrashStatus) {
-            if (mem.Flags & MEM_OBJECT) {
-               log.warning("Unfreed private object #%d, Size %d, Class: $%.8x, Container: #%d.", mem.MemoryID, mem.Size, mem.Object->ClassID, mem.OwnerID);
+   for (auto &shard : glPrivateMemory.Shards) {
+      for (auto & [ id, mem ] : shard.Map) {
+         if (mem.Address) {
+            if (!glCrashStatus) {
+               if (mem.Flags & MEM_OBJECT) {
+                  log.warning("Unfreed private object #%d, Size %d, Class: $%.8x, Container: #%d.", mem.MemoryID, mem.Size, mem.Object->ClassID, mem.OwnerID);
 
-               if (mem.Object->Flags & NF_PUBLIC) remove_shared_object(mem.MemoryID);
+                  if (mem.Object->Flags & NF_PUBLIC) remove_shared_object(mem.MemoryID);
+               }
+               else log.warning("Unfreed private memory #%d/%p, Size %d, Container: #%d.", mem.MemoryID, mem.Address, mem.Size, mem.OwnerID);
             }
-            else log.warning("Unfreed private memory #%d/%p, Size %d, Container: #%d.", mem.MemoryID, mem.Address, mem.Size, mem.OwnerID);
+            mem.AccessCount = 0;
+            FreeResource(mem.Address);
+            mem.Address = NULL;
+            count++;
          }
-         mem.AccessCount = 0;
-         FreeResource(mem.Address);
-         mem.Address = NULL;
-         count++;
       }
    }
 
@@ -793,7 +791,7 @@ void free_public_resources(OBJECTID TaskID)
                }
 
                if (glSharedBlocks[i].AccessCount > 0) { // Forcibly remove locks if ReleaseMemory() couldn't
-                  ClearMemory(glSharedBlocks+i, sizeof(glSharedBlocks[0]));
+                  remove_public_block(i);
                }
 
                log.msg("Freeing public object header #%d.", glSharedBlocks[i].MemoryID);
@@ -850,7 +848,7 @@ void remove_public_locks(LONG ProcessID)
             }
 
             if (glSharedBlocks[i].AccessCount > 0) { // Forcibly remove locks if ReleaseMemory() couldn't
-               ClearMemory(glSharedBlocks+i, sizeof(glSharedBlocks[0]));
+               remove_public_block(i);
             }
          }
       }
@@ -886,10 +884,12 @@ static void remove_private_locks(void)
 {
    parasol::Log log("Shutdown");
 
-   for (auto & [ id, mem ] : glPrivateMemory) {
-      if ((mem.Address) and (mem.AccessCount > 0)) {
-         if (!glCrashStatus) log.msg("Removing %d locks on private memory block #%d, size %d.", mem.AccessCount, mem.MemoryID, mem.Size);
-         mem.AccessCount = 0;
+   for (auto &shard : glPrivateMemory.Shards) {
+      for (auto & [ id, mem ] : shard.Map) {
+         if ((mem.Address) and (mem.AccessCount > 0)) {
+            if (!glCrashStatus) log.msg("Removing %d locks on private memory block #%d, size %d.", mem.AccessCount, mem.MemoryID, mem.Size);
+            mem.AccessCount = 0;
+         }
       }
    }
 }
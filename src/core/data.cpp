@@ -61,12 +61,17 @@ BYTE glScanClasses = FALSE;
 LONG glDebugMemory = FALSE;
 struct CoreBase *LocalCoreBase = NULL;
 
-std::unordered_map<MEMORYID, PrivateAddress> glPrivateMemory;
-std::unordered_map<OBJECTID, std::set<OBJECTID, std::greater<OBJECTID>>> glObjectChildren;
-std::unordered_map<OBJECTID, std::set<MEMORYID, std::greater<MEMORYID>>> glObjectMemory;
+ShardedMap<MEMORYID, PrivateAddress> glPrivateMemory;
+ShardedMap<OBJECTID, RESOURCE_SET> glObjectChildren;
+ShardedMap<OBJECTID, RESOURCE_SET> glObjectMemory;
+LONG glPrivateMemWaiters = 0;
 
 struct PublicAddress  *glSharedBlocks  = 0;
 struct SortedAddress  *glSortedBlocks  = 0;
+LONG                  *glFreeSlots     = 0;
+#ifndef USE_SHM
+struct PoolMap        *glPoolMap       = 0;
+#endif
 struct ModuleMaster   *glModuleList    = 0;
 struct SharedAccess   *SharedAccess    = 0;
 struct SharedControl  *glSharedControl = 0;
@@ -79,7 +84,7 @@ struct ClassHeader    *glClassDB       = 0;
 struct ModuleHeader   *glModules       = 0;
 struct OpenInfo       *glOpenInfo      = 0;
 struct MsgHandler     *glMsgHandlers   = 0, *glLastMsgHandler = 0;
-std::list<CoreTimer> glTimers;
+TimerQueue glTimers;
 OBJECTID glClassFileID = 0;
 APTR glJNIEnv = 0;
 UWORD glFunctionID = 3333;
@@ -89,12 +94,14 @@ OBJECTID  SystemTaskID     = 0;
 struct KeyStore *glClassMap = NULL;
 struct KeyStore *glFields = NULL;
 LONG glPageSize = 4096; // Default page size is 4k
+LONG glThreadPoolSize = 0; // Zero sizes the ActionThread() pool to the number of processor cores
 LONG glTotalPages = 0;
 LONG glStdErrFlags = 0;
 TIMER glCacheTimer = 0;
 LONG glMemoryFD = -1;
 LONG glKeyState = 0;
 LONG glTaskMessageMID = 0;
+struct MessageHeader *glTaskMessageQueue = NULL;
 LONG glValidateProcessID = 0;
 LONG glProcessID  = 0;
 LONG glInstanceID = 0;
@@ -104,7 +111,11 @@ LONG glEUID = -1, glEGID = -1, glGID = -1, glUID = -1;
 struct rkConfig *glVolumes = NULL; // Volume management object
 struct rkConfig *glDatatypes = NULL;
 struct FDTable *glFDTable = NULL;
-WORD glTotalFDs = 0, glLastFD = 0;
+LONG glTotalFDs = 0, glFDTableSize = 0, glLastFD = 0;
+LONG glFDCallers = 0;
+#ifdef __linux__
+LONG glEpollFD = -1;
+#endif
 UBYTE glTimerCycle = 1;
 CSTRING glIDL = MOD_IDL;
 std::unordered_map<OBJECTID, ObjectSignal> glWFOList;
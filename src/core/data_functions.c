@@ -12,6 +12,7 @@ FDEF argsActionList[] = { { "Void", FD_VOID }, { "ActionTable:Actions", FD_ARRAY
 FDEF argsActionMsg[] = { { "Error", FD_LONG|FD_ERROR }, { "Action", FD_LONG }, { "Object", FD_OBJECTID }, { "Args", FD_PTR }, { "MessageID", FD_LONG }, { "ClassID", FD_LONG|FD_UNSIGNED }, { 0, 0 } };
 FDEF argsActionTags[] = { { "Error", FD_LONG|FD_ERROR }, { "Action", FD_LONG }, { "Object", FD_OBJECTPTR }, { "Tags", FD_TAGS }, { 0, 0 } };
 FDEF argsActionThread[] = { { "Error", FD_LONG|FD_ERROR }, { "Action", FD_LONG }, { "Object", FD_OBJECTPTR }, { "Args", FD_PTR }, { "Callback", FD_FUNCTIONPTR }, { "Key", FD_LONG }, { 0, 0 } };
+FDEF argsActionThreadBatch[] = { { "Error", FD_LONG|FD_ERROR }, { "ThreadAction:Actions", FD_PTR|FD_STRUCT }, { "Total", FD_LONG }, { 0, 0 } };
 FDEF argsAddInfoTag[] = { { "Error", FD_LONG|FD_ERROR }, { "FileInfo:Info", FD_PTR|FD_STRUCT }, { "Name", FD_STR }, { "Value", FD_STR }, { 0, 0 } };
 FDEF argsAddMsgHandler[] = { { "Error", FD_LONG|FD_ERROR }, { "Custom", FD_PTR }, { "MsgType", FD_LONG }, { "Routine", FD_FUNCTIONPTR }, { "MsgHandler:Handle", FD_PTR|FD_STRUCT|FD_RESOURCE|FD_ALLOC|FD_RESULT }, { 0, 0 } };
 FDEF argsAdjustLogLevel[] = { { "Result", FD_LONG }, { "Adjust", FD_LONG }, { 0, 0 } };
@@ -57,6 +58,7 @@ FDEF argsGetEventID[] = { { "Result", FD_LARGE }, { "Group", FD_LONG }, { "SubGr
 FDEF argsGetFeedList[] = { { "Result", FD_LONG }, { "Object", FD_OBJECTPTR }, { 0, 0 } };
 FDEF argsGetField[] = { { "Error", FD_LONG|FD_ERROR }, { "Object", FD_OBJECTPTR }, { "Field", FD_LARGE }, { "Result", FD_PTR }, { 0, 0 } };
 FDEF argsGetFieldArray[] = { { "Error", FD_LONG|FD_ERROR }, { "Object", FD_OBJECTPTR }, { "Field", FD_LARGE }, { "Result", FD_PTR|FD_RESULT }, { "Elements", FD_LONG|FD_RESULT }, { 0, 0 } };
+FDEF argsGetFieldByHandle[] = { { "Error", FD_LONG|FD_ERROR }, { "FieldHandle:Handle", FD_PTR|FD_STRUCT }, { "Type", FD_LARGE }, { "Result", FD_PTR }, { 0, 0 } };
 FDEF argsGetFieldVariable[] = { { "Error", FD_LONG|FD_ERROR }, { "Object", FD_OBJECTPTR }, { "Field", FD_STR }, { "Buffer", FD_BUFFER|FD_STR }, { "Size", FD_LONG|FD_BUFSIZE }, { 0, 0 } };
 FDEF argsGetFields[] = { { "Error", FD_LONG|FD_ERROR }, { "Object", FD_OBJECTPTR }, { "Tags", FD_VARTAGS }, { 0, 0 } };
 FDEF argsGetMemAddress[] = { { "Result", FD_PTR }, { "ID", FD_LONG }, { 0, 0 } };
@@ -99,6 +101,7 @@ FDEF argsReleaseObject[] = { { "Error", FD_LONG|FD_ERROR }, { "Object", FD_OBJEC
 FDEF argsReleasePrivateObject[] = { { "Void", FD_VOID }, { "Object", FD_OBJECTPTR }, { 0, 0 } };
 FDEF argsResolveClassID[] = { { "Result", FD_STR }, { "ID", FD_LONG|FD_UNSIGNED }, { 0, 0 } };
 FDEF argsResolveClassName[] = { { "Result", FD_LONG|FD_UNSIGNED }, { "Name", FD_STR }, { 0, 0 } };
+FDEF argsResolveFieldHandle[] = { { "Error", FD_LONG|FD_ERROR }, { "Object", FD_OBJECTPTR }, { "FieldID", FD_LONG|FD_UNSIGNED }, { "FieldHandle:Handle", FD_PTR|FD_STRUCT }, { 0, 0 } };
 FDEF argsResolveGroupID[] = { { "Result", FD_STR }, { "Group", FD_LONG }, { 0, 0 } };
 FDEF argsResolvePath[] = { { "Error", FD_LONG|FD_ERROR }, { "Path", FD_STR }, { "Flags", FD_LONG }, { "Result", FD_STR|FD_ALLOC|FD_RESULT }, { 0, 0 } };
 FDEF argsResolveUserID[] = { { "Result", FD_STR }, { "User", FD_LONG }, { 0, 0 } };
@@ -113,6 +116,7 @@ FDEF argsSetContext[] = { { "Object", FD_OBJECTPTR }, { "Object", FD_OBJECTPTR }
 FDEF argsSetDefaultPermissions[] = { { "Void", FD_VOID }, { "User", FD_LONG }, { "Group", FD_LONG }, { "Permissions", FD_LONG }, { 0, 0 } };
 FDEF argsSetDocView[] = { { "Error", FD_LONG|FD_ERROR }, { "Path", FD_STR }, { "Document", FD_STR }, { 0, 0 } };
 FDEF argsSetField[] = { { "Error", FD_LONG|FD_ERROR }, { "Object", FD_OBJECTPTR }, { "Field", FD_LARGE }, { "Value", FD_VARTAGS }, { 0, 0 } };
+FDEF argsSetFieldByHandle[] = { { "Error", FD_LONG|FD_ERROR }, { "FieldHandle:Handle", FD_PTR|FD_STRUCT }, { "Type", FD_LARGE }, { "Value", FD_VARTAGS }, { 0, 0 } };
 FDEF argsSetFieldEval[] = { { "Error", FD_LONG|FD_ERROR }, { "Object", FD_OBJECTPTR }, { "Field", FD_STR }, { "Value", FD_STR }, { 0, 0 } };
 FDEF argsSetFields[] = { { "Error", FD_LONG|FD_ERROR }, { "Object", FD_OBJECTPTR }, { "Tags", FD_VARTAGS }, { 0, 0 } };
 FDEF argsSetFieldsID[] = { { "Error", FD_LONG|FD_ERROR }, { "Object", FD_OBJECTID }, { "Tags", FD_VARTAGS }, { 0, 0 } };
@@ -162,6 +166,7 @@ FDEF argsSubscribeFeed[] = { { "Error", FD_LONG|FD_ERROR }, { "Object", FD_OBJEC
 FDEF argsSubscribeTimer[] = { { "Error", FD_LONG|FD_ERROR }, { "Interval", FD_DOUBLE }, { "Callback", FD_FUNCTIONPTR }, { "Subscription", FD_PTR|FD_RESULT }, { 0, 0 } };
 FDEF argsSysLock[] = { { "Error", FD_LONG|FD_ERROR }, { "Index", FD_LONG }, { "MilliSeconds", FD_LONG }, { 0, 0 } };
 FDEF argsSysUnlock[] = { { "Error", FD_LONG|FD_ERROR }, { "Index", FD_LONG }, { 0, 0 } };
+FDEF argsThreadBatch[] = { { "Error", FD_LONG|FD_ERROR }, { "Routine", FD_PTR }, { "Data", FD_PTR }, { "Total", FD_LONG }, { 0, 0 } };
 FDEF argsTranslateCmdRef[] = { { "Error", FD_LONG|FD_ERROR }, { "String", FD_STR }, { "Command", FD_STR|FD_ALLOC|FD_RESULT }, { 0, 0 } };
 FDEF argsUTF8CharLength[] = { { "Result", FD_LONG }, { "String", FD_STR }, { 0, 0 } };
 FDEF argsUTF8CharOffset[] = { { "Result", FD_LONG }, { "String", FD_STR }, { "Offset", FD_LONG }, { 0, 0 } };
@@ -388,6 +393,11 @@ const struct Function glFunctions[] = {
    { (APTR)VarLock, "VarLock", argsVarLock },
    { (APTR)VLogF, "VLogF", argsVLogF },
    { (APTR)WakeProcess, "WakeProcess", argsWakeProcess },
+   { (APTR)ActionThreadBatch, "ActionThreadBatch", argsActionThreadBatch },
+   { (APTR)ResolveFieldHandle, "ResolveFieldHandle", argsResolveFieldHandle },
+   { (APTR)GetFieldByHandle, "GetFieldByHandle", argsGetFieldByHandle },
+   { (APTR)SetFieldByHandle, "SetFieldByHandle", argsSetFieldByHandle },
+   { (APTR)ThreadBatch, "ThreadBatch", argsThreadBatch },
    { NULL, NULL, NULL }
 };
 
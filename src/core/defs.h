@@ -6,7 +6,12 @@
 #endif
 
 #include <set>
+#include <atomic>
+#include <vector>
 #include <functional>
+#include <unordered_map>
+#include <mutex>
+#include <shared_mutex>
 
 #define PRV_CORE
 #define PRV_CORE_MODULE
@@ -149,6 +154,64 @@ public:
       Address(aAddress), MemoryID(aMemoryID), OwnerID(aOwnerID), Size(aSize), Flags(aFlags) { };
 };
 
+// Private memory records and resource tracking tables are sharded by ID so that threads working with unrelated
+// resources do not contend for the same lock.  Readers take a shared lock on a single shard; inserts, removals and
+// modifications to a record require the exclusive lock.  Shard locks are not recursive and must never be held while
+// calling out to other functions.  TL_PRIVATE_MEM may be acquired before a shard lock, but never after.
+
+#define MEM_SHARDS 64 // Must be a power of 2
+
+template <class K, class V> class ShardedMap {
+public:
+   struct Shard {
+      std::shared_mutex Lock;
+      std::unordered_map<K, V> Map;
+   };
+
+   Shard Shards[MEM_SHARDS];
+
+   inline Shard & shard(K Key) { return Shards[ULONG(Key) & (MEM_SHARDS-1)]; }
+
+   bool contains(K Key) {
+      auto &s = shard(Key);
+      std::shared_lock lock(s.Lock);
+      return s.Map.contains(Key);
+   }
+
+   // Returns a copy of the value so that the client can iterate over it without holding a lock.
+
+   V copy(K Key) {
+      auto &s = shard(Key);
+      std::shared_lock lock(s.Lock);
+      auto it = s.Map.find(Key);
+      if (it != s.Map.end()) return it->second;
+      else return V();
+   }
+
+   void erase(K Key) {
+      auto &s = shard(Key);
+      std::unique_lock lock(s.Lock);
+      s.Map.erase(Key);
+   }
+
+   // For maps that hold a container of resource ID's
+
+   template <class T> void insert_into(K Key, T Value) {
+      auto &s = shard(Key);
+      std::unique_lock lock(s.Lock);
+      s.Map[Key].insert(Value);
+   }
+
+   template <class T> void erase_from(K Key, T Value) {
+      auto &s = shard(Key);
+      std::unique_lock lock(s.Lock);
+      auto it = s.Map.find(Key);
+      if (it != s.Map.end()) it->second.erase(Value);
+   }
+};
+
+typedef std::set<MEMORYID, std::greater<MEMORYID>> RESOURCE_SET;
+
 struct rkWatchPath {
    LARGE      Custom;    // User's custom data pointer or value
    HOSTHANDLE Handle;    // The handle for the file being monitored, can be a special reference for virtual paths
@@ -218,7 +281,6 @@ enum {
    TL_PRINT,
    TL_PRIVATE_OBJECTS,
    TL_MSGHANDLER,
-   TL_THREADPOOL,
    TL_END
 };
 
@@ -266,6 +328,15 @@ extern struct virtual_drive glVirtual[20];
 #define PAGE_TABLE_CHUNK     32
 #define MEMHEADER            12    // 8 bytes at start for MEMH and MemoryID, 4 at end for MEMT
 
+// Private blocks of up to SLAB_MAX_SIZE bytes are served by the per-thread small block allocator (lib_slab.cpp).  The
+// header of a slab block uses CODE_MEMS in place of CODE_MEMH.  Slab blocks allocated with MEM_UNREGISTERED use
+// CODE_MEMU, the ID field holds the size and the allocation flags are stored in the LONG that follows the tail cookie.
+
+#define SLAB_CLASSES         5
+#define SLAB_MAX_SIZE        256
+#define CODE_MEMS            0x4D454D53L
+#define CODE_MEMU            0x4D454D55L
+
 // Turning off USE_SHM means that the shared memory pool is available to all processes by default.
 
 #ifdef __ANDROID__
@@ -301,6 +372,37 @@ extern struct virtual_drive glVirtual[20];
   #define STATIC_MEMORY_POOL TRUE // The entire memory-pool is pre-paged.  No paging of individual memory blocks is performed.
 #endif
 
+// If the public memory pool is in use (i.e. USE_SHM is off), space is managed by a buddy allocator.  The pool is divided
+// into extents of POOL_EXTENT grains of PoolMap.Grain bytes, and blocks are allocated in power-of-2 multiples of the
+// grain size within an extent.  A single block is therefore limited to Grain * POOL_EXTENT bytes.  The mmap() pool
+// starts with one extent and gains another each time it is exhausted, up to POOL_MAX_EXTENTS.  The static pool on
+// Windows is pre-paged and covered by a single extent.  The PoolMap lives in the shared control area so that all
+// processes have the same view of the pool.
+
+#ifndef USE_SHM
+  #define POOL_EXTENT 8192
+  #define POOL_ORDERS 14   // log2(POOL_EXTENT) + 1
+  #ifdef STATIC_MEMORY_POOL
+    #define POOL_MAX_EXTENTS 1
+  #else
+    #define POOL_MAX_EXTENTS 16 // 512MB of public memory with 4K pages
+  #endif
+  #define POOL_GRAINS (POOL_EXTENT * POOL_MAX_EXTENTS)
+
+  #define PGS_FREE  1      // The grain is the first in a free block
+  #define PGS_ALLOC 2      // The grain is the first in an allocated block
+
+  struct PoolMap {
+     LONG  Grain;                   // Size of each grain, in bytes.  Must be a multiple of the page size if blocks are paged individually.
+     LONG  TotalGrains;             // Grains in the extents that are in use
+     LONG  FreeHead[POOL_ORDERS];   // First free block in each order, or -1
+     LONG  Next[POOL_GRAINS];       // Free blocks: Next free block in the same order.  Allocated blocks: Index in glSharedBlocks.
+     LONG  Prev[POOL_GRAINS];       // Free blocks: Previous free block in the same order.
+     UBYTE Order[POOL_GRAINS];      // Order of the block that starts at this grain.
+     UBYTE State[POOL_GRAINS];      // PGS flags
+  };
+#endif
+
 #ifdef _WIN32
 
 struct public_lock {
@@ -384,10 +486,32 @@ public:
    OBJECTPTR Subscriber;     // The object that is subscribed (pointer, if private)
    OBJECTID  SubscriberID;   // The object that is subscribed
    FUNCTION  Routine;        // Routine to call if not using AC_Timer - ERROR Routine(OBJECTID, LONG, LONG);
+   LONG      Index;          // Position of the timer in glTimers
    UBYTE     Cycle;
    bool      Locked;
 };
 
+// Timers are held in a binary min-heap ordered by NextCall, so the next timer to expire is always at the front.  Each
+// timer records its position in the heap, which allows it to be removed or rescheduled without a search.
+
+class TimerQueue {
+   public:
+      std::vector<CoreTimer *> Heap;
+
+      ~TimerQueue() { for (auto timer : Heap) delete timer; }
+
+      CoreTimer * next() { return Heap.empty() ? NULL : Heap.front(); }
+      LONG size() { return Heap.size(); }
+
+      void insert(CoreTimer *);
+      void remove(CoreTimer *);
+      void reschedule(CoreTimer *);
+
+   private:
+      void sift_up(LONG);
+      void sift_down(LONG);
+};
+
 /*****************************************************************************
 ** Crash index numbers.  Please note that the order of this index must match the order in which resources are freed in
 ** the shutdown process.
@@ -421,6 +545,32 @@ enum {
    STAGE_SHUTDOWN
 };
 
+/*****************************************************************************
+** Field lookup table for a class, see build_field_hash().  Slots are addressed by multiplying the FieldID with a
+** value that is chosen to avoid collisions, so most lookups hit on the first probe.  Any remaining collisions are
+** resolved by linear probing.  For CLF_PROMOTE_INTEGRAL classes, the fields of integral children are merged into the
+** table once an object with those children has been seen.
+*/
+
+#define FH_OWN 0xff // FieldSlot.Child value for fields that are declared by the class itself
+
+struct FieldSlot {
+   ULONG FieldID;
+   UBYTE Child;                // FH_OWN, or an index into rkMetaClass.Children
+   struct Field *Field;        // NULL if the slot is empty
+   struct rkMetaClass *Source; // The class that declares the field
+};
+
+struct FieldHash {
+   struct FieldHash *Retired;  // The table that this one replaced.  Kept until the class is freed as it may be in use
+   ULONG Multiplier;
+   UBYTE Shift;                // 32 - log2(total slots)
+   UBYTE Merged;               // Bit-mask of the Children[] entries that are merged into this table
+   ULONG Mask;                 // Total slots - 1
+   struct rkMetaClass *ChildClass[8]; // The class of each merged Children[] entry, for rebuilding the table
+   struct FieldSlot Slots[1];
+};
+
 /****************************************************************************/
 
 struct ModuleHeader {
@@ -469,16 +619,21 @@ extern LARGE glTimeLog;
 extern char glAlphaNumeric[256];
 extern struct ModuleMaster  *glModuleList;    // Locked with TL_GENERIC.  Maintained as a linked-list; hashmap unsuitable.
 extern struct PublicAddress *glSharedBlocks;  // Locked with PL_PUBLICMEM
-extern struct SortedAddress *glSortedBlocks;
+extern struct SortedAddress *glSortedBlocks;  // Locked with PL_PUBLICMEM
+extern LONG *glFreeSlots;                     // Locked with PL_PUBLICMEM
+#ifndef USE_SHM
+extern struct PoolMap *glPoolMap;             // Locked with PL_PUBLICMEM
+#endif
 extern struct SharedControl *glSharedControl; // Locked with PL_FORBID
 extern struct TaskList      *shTasks, *glTaskEntry; // Locked with PL_PROCESSES
 extern struct SemaphoreEntry *shSemaphores;     // Locked with PL_SEMAPHORES
 extern const struct ActionTable ActionTable[];  // Read only
 extern const struct Function    glFunctions[];  // Read only
-extern std::list<CoreTimer> glTimers;          // Locked with TL_TIMER
-extern std::unordered_map<MEMORYID, PrivateAddress> glPrivateMemory;  // Locked with TL_PRIVATE_MEM: Note that best performance for looking up ID's is achieved as a sorted array.
-extern std::unordered_map<OBJECTID, std::set<MEMORYID, std::greater<MEMORYID>>> glObjectMemory; // Locked with TL_PRIVATE_MEM.  Sorted with the most recent private memory first
-extern std::unordered_map<OBJECTID, std::set<OBJECTID, std::greater<OBJECTID>>> glObjectChildren; // Locked with TL_PRIVATE_MEM.  Sorted with most recent object first
+extern TimerQueue glTimers;                    // Locked with TL_TIMER
+extern ShardedMap<MEMORYID, PrivateAddress> glPrivateMemory;  // Locked per shard.
+extern ShardedMap<OBJECTID, RESOURCE_SET> glObjectMemory;      // Locked per shard.  Sorted with the most recent private memory first
+extern ShardedMap<OBJECTID, RESOURCE_SET> glObjectChildren;    // Locked per shard.  Sorted with most recent object first
+extern LONG glPrivateMemWaiters;                               // Count of threads sleeping on CN_PRIVATE_MEM
 extern struct MemoryPage   *glMemoryPages;      // Locked with TL_MEMORY_PAGES
 extern struct KeyStore *glObjectLookup;         // Locked with TL_OBJECT_LOOKUP
 extern struct ClassHeader  *glClassDB;          // Read-only.  Class database.
@@ -489,6 +644,7 @@ extern CSTRING glMessages[ERR_END];       // Read-only table of error messages.
 extern const LONG glTotalMessages;
 extern LONG glTotalPages; // Read-only
 extern MEMORYID glTaskMessageMID;        // Read-only
+extern struct MessageHeader *glTaskMessageQueue; // Read-only.  The queue of glTaskMessageMID, mapped for the lifetime of the Task.
 extern LONG glActionCount, glMemRegSize; // Read-only
 extern LONG glProcessID, glInstanceID;   // Read only
 extern HOSTHANDLE glConsoleFD;
@@ -499,6 +655,7 @@ extern WORD glCrashStatus, glCodeIndex, glLastCodeIndex;
 extern UWORD glFunctionID;
 extern BYTE glMasterTask, glProgramStage, glFullOS, glPrivileged, glSync;
 extern LONG glPageSize; // Read only
+extern LONG glThreadPoolSize; // Read only.  Set with --threads, or zero for one worker per processor core
 extern LONG glBufferSize;
 extern TIMER glCacheTimer;
 extern STRING glBuffer;
@@ -586,32 +743,50 @@ extern struct MsgHandler *glMsgHandlers, *glLastMsgHandler;
 ** Message structure and internal ID's for standard Task-to-Task messages.
 */
 
-#define SIZE_MSGBUFFER (1024 * 64)
+#define SIZE_MSGBUFFER (1024 * 64) // Must be a power of 2
+#define MSG_TYPE_SLOTS 64          // Must be a power of 2
+
+// Message states.  A record in the queue is invisible to the consumer until its state is set to MSS_READY.
+
+#define MSS_EMPTY   0 // Space has been reserved but the message is not written yet
+#define MSS_READY   1 // The message is waiting to be processed
+#define MSS_REMOVED 2 // The message has been consumed or deleted.  Its space is reclaimed when the queue head passes it.
+#define MSS_PAD     3 // Unused space at the end of the buffer
 
 struct TaskMessage {
    LARGE Time;
-   LONG UniqueID;   // Unique identifier for this particular message
-   LONG Type;       // Message type ID
-   LONG DataSize;   // Size of the data (does not include the size of the TaskMessage structure)
-   LONG NextMsg;    // Offset to the next message
-   /*
-   #ifdef _WIN32
-      LONG MsgProcess;
-      WINHANDLE MsgSemaphore;
-   #endif
-   #ifdef __unix__
-      THREADLOCK Mutex;
-   #endif
-   */
+   volatile LONG State;  // MSS state.  State and UniqueID are compared and swapped as a pair.
+   LONG UniqueID;        // Unique identifier for this particular message
+   LONG Type;            // Message type ID
+   LONG DataSize;        // Size of the data (does not include the size of the TaskMessage structure)
+   LONG NextMsg;         // Size of the record, including the TaskMessage header and alignment padding
+   LONG Reserved;
    // Data follows
 };
 
+// Message types are indexed so that MSF_NO_DUPLICATE and MSF_UPDATE do not need to scan the queue.
+
+struct MessageType {
+   volatile LONG Type;     // The message type that the slot is bound to, or zero if unused
+   volatile LONG Pending;  // Total messages of this type that are yet to be dispatched, including those in the batch
+   volatile LONG LastID;   // UniqueID of the most recent message of this type
+   volatile ULONG LastPos; // Queue position of the most recent message of this type
+};
+
+// The message queue is a ring buffer that supports multiple producers and a single consumer.  Producers reserve space
+// by advancing the Tail, write their message and then mark it as ready.  The consumer advances the Head as messages
+// are removed.  Positions increase monotonically and are masked with SIZE_MSGBUFFER to get a buffer offset.
+
 struct MessageHeader {
-   LONG NextEntry;     // Byte offset for the next message to be stored
-   WORD Count;         // Count of messages stored in the buffer
-   WORD TaskIndex;     // Process that owns this message queue (refers to an index in the Task array)
-   LONG CompressReset; // Manages message queue compression
-   BYTE Buffer[SIZE_MSGBUFFER + sizeof(struct TaskMessage)];
+   volatile ULONG Head;         // Read position of the consumer
+   volatile ULONG Tail;         // Write position, advanced by producers
+   volatile LONG Count;         // Count of messages stored in the buffer
+   volatile LONG ConsumerLock;  // ID of the thread that is currently reading the queue
+   WORD TaskIndex;              // Process that owns this message queue (refers to an index in the Task array)
+   WORD Padding;
+   LONG Reserved;               // Keeps the Buffer 64-bit aligned
+   struct MessageType Types[MSG_TYPE_SLOTS];
+   BYTE Buffer[SIZE_MSGBUFFER];
 };
 
 struct ValidateMessage {
@@ -766,12 +941,28 @@ struct ziptail {
 } __attribute__((__packed__));
 
 /*****************************************************************************
-** File Descriptor table.  This is for RegisterFD()
+** File Descriptor table.  This is for RegisterFD().  The table grows on demand and is kept sorted by FD so that the
+** records for a descriptor are adjacent and can be found with a binary search.  On Linux the descriptors are also
+** registered with an epoll instance that persists between calls to sleep_task().
 */
 
-#define MAX_FDS 40
+#define FD_TABLE_BLOCK 32 // Growth increment for glFDTable
+#define MAX_WIN_FDS 60    // WaitForMultipleObjects() is limited to 64 handles, some of which are reserved
+
 extern struct FDTable *glFDTable;
-extern WORD glTotalFDs, glLastFD;
+extern LONG glTotalFDs, glFDTableSize, glLastFD;
+extern LONG glFDCallers; // Count of records with RFD_ALWAYS_CALL or RFD_RECALL set
+#ifdef __linux__
+extern LONG glEpollFD;
+#endif
+
+extern LONG find_fd(HOSTHANDLE);
+extern LONG fd_events(HOSTHANDLE);
+extern void update_fd_events(HOSTHANDLE, LONG);
+extern void free_fd_table(void);
+#ifdef __unix__
+extern bool use_select(void);
+#endif
 extern LONG glInotify;
 struct DocView { CSTRING Path; CSTRING Doc; };
 extern struct DocView *glDocView;
@@ -867,6 +1058,7 @@ BYTE  strip_folder(STRING) __attribute__ ((unused));
 ERROR get_file_info(CSTRING, struct FileInfo *, LONG);
 ERROR convert_errno(LONG Error, ERROR Default);
 void free_translate_buffer(void);
+void free_object_table(void);
 void free_file_cache(void);
 
 EXPORT void Expunge(WORD);
@@ -887,10 +1079,13 @@ struct ClassItem * find_class(CLASSID);
 struct ModuleItem * find_module(ULONG);
 LONG   find_public_address(struct SharedControl *, APTR);
 ERROR  find_private_object_entry(OBJECTID, LONG *);
+OBJECTPTR find_private_object(OBJECTID);
 ERROR  find_public_object_entry(struct SharedObjectHeader *, OBJECTID, LONG *);
 ERROR  find_public_mem_id(struct SharedControl *, MEMORYID, LONG *);
+void   init_public_tables(struct SharedControl *);
 void   fix_core_table(struct CoreBase *, FLOAT);
 void   free_events(void);
+void   free_task_queue(void);
 void   free_module_entry(struct ModuleMaster *);
 ERROR  free_ptr_args(APTR, const struct FunctionField *, WORD);
 void   free_public_resources(OBJECTID);
@@ -901,6 +1096,9 @@ ERROR  load_classes(void);
 ERROR  local_copy_args(const struct FunctionField *, LONG, BYTE *, BYTE *, LONG, LONG *, CSTRING);
 void   local_free_args(APTR, const struct FunctionField *);
 struct Field * lookup_id(OBJECTPTR Object, ULONG FieldID, OBJECTPTR *Result);
+struct Field * lookup_own_field(struct rkMetaClass *, ULONG FieldID);
+void   build_field_hash(struct rkMetaClass *, OBJECTPTR);
+void   free_field_hash(struct rkMetaClass *);
 ERROR  msg_event(APTR Custom, LONG MsgID, LONG MsgType, APTR Message, LONG MsgSize);
 ERROR  msg_threadcallback(APTR Custom, LONG MsgID, LONG MsgType, APTR Message, LONG MsgSize);
 ERROR  msg_threadaction(APTR Custom, LONG MsgID, LONG MsgType, APTR Message, LONG MsgSize);
@@ -916,13 +1114,16 @@ void   remove_public_locks(LONG);
 void   remove_semaphores(void);
 void   remove_shared_object(OBJECTID);
 ERROR  resolve_args(APTR, const struct FunctionField *);
+void   remove_public_block(LONG);
 APTR   resolve_public_address(struct PublicAddress *);
 void   scan_classes(void);
 void   set_object_flags(OBJECTPTR, LONG);
 ERROR  sort_class_fields(struct rkMetaClass *, struct Field *);
 void   remove_threadpool(void);
-ERROR  threadpool_get(objThread **);
-void   threadpool_release(objThread *);
+ERROR  threadpool_submit(void (*)(APTR), APTR);
+LONG   threadpool_size(void);
+void   threadpool_complete(std::atomic<LONG> &);
+void   threadpool_wait(std::atomic<LONG> &);
 ERROR  unpage_memory(APTR);
 ERROR  unpage_memory_id(MEMORYID MemoryID);
 ERROR  UnsubscribeActionByID(OBJECTPTR Object, ACTIONID ActionID, OBJECTID SubscriberID);
@@ -976,9 +1177,17 @@ void  thread_unlock(UBYTE);
 ERROR cond_wait(UBYTE, UBYTE, LONG Timeout);
 
 void cond_wake_all(UBYTE);
+void wake_private_waiters(void);
 void cond_wake_single(UBYTE);
 ERROR clear_waitlock(WORD);
 
+// Small block allocator.
+
+APTR slab_alloc(LONG);
+void slab_free(APTR);
+void slab_miss(void);
+void slab_stats(struct SlabStats *, LARGE *);
+
 // Platform specific semaphore functionality.
 
 ERROR plAllocPrivateSemaphore(APTR, LONG InitialValue);
@@ -1131,6 +1340,7 @@ INLINE CSTRING GET_FIELD_NAME(ULONG FieldID)
 
 #define INC_QUEUE(Object) __sync_add_and_fetch(&(Object)->Queue, 1)
 #define SUB_QUEUE(Object) __sync_sub_and_fetch(&(Object)->Queue, 1)
+#define LOCK_QUEUE(Object) __sync_bool_compare_and_swap(&(Object)->Queue, 0, 1) // Acquires an unlocked object
 
 /* // For debugging specific object locking issues only.
 INLINE BYTE INC_QUEUE(OBJECTPTR Object)
@@ -1155,15 +1365,15 @@ INLINE BYTE SUB_QUEUE(OBJECTPTR Object)
 
 INLINE ERROR prv_access(OBJECTPTR Object)
 {
-   if (INC_QUEUE(Object) IS 1) {
+   if (LOCK_QUEUE(Object)) {
       Object->ThreadID = get_thread_id();
       return ERR_Okay;
    }
-   else {
-      if (Object->ThreadID IS get_thread_id()) return ERR_Okay; // If this is for the same thread then it's a nested lock, so there's no issue.
-      SUB_QUEUE(Object); // Put the lock count back to normal before AccessPrivateObject()
-      return AccessPrivateObject(Object, -1); // Can fail if object is marked for deletion.
+   else if (Object->ThreadID IS get_thread_id()) { // If this is for the same thread then it's a nested lock, so there's no issue.
+      INC_QUEUE(Object);
+      return ERR_Okay;
    }
+   else return AccessPrivateObject(Object, -1); // Can fail if object is marked for deletion.
 }
 
 INLINE void prv_release(OBJECTPTR Object)
@@ -75,23 +75,22 @@ struct thread_data {
    BYTE      Parameters;
 };
 
-static ERROR thread_action(rkThread *Thread)
+static void thread_action(thread_data *Data)
 {
    ERROR error;
-   thread_data *data = (thread_data *)Thread->Data;
-   OBJECTPTR obj = data->Object;
+   OBJECTPTR obj = Data->Object;
 
    if (!(error = AccessPrivateObject(obj, 5000))) { // Access the object and process the action.
       __sync_sub_and_fetch(&obj->ThreadPending, 1);
-      error = Action(data->ActionID, obj, data->Parameters ? (data + 1) : NULL);
+      error = Action(Data->ActionID, obj, Data->Parameters ? (Data + 1) : NULL);
 
-      if (data->Parameters) { // Free any temporary buffers that were allocated.
-         if (data->ActionID > 0) local_free_args(data + 1, ActionTable[data->ActionID].Args);
-         else local_free_args(data + 1, obj->Class->Methods[-data->ActionID].Args);
+      if (Data->Parameters) { // Free any temporary buffers that were allocated.
+         if (Data->ActionID > 0) local_free_args(Data + 1, ActionTable[Data->ActionID].Args);
+         else local_free_args(Data + 1, obj->Class->Methods[-Data->ActionID].Args);
       }
 
       if (obj->Flags & NF_FREE) obj = NULL; // Clear the obj pointer because the object will be deleted on release.
-      ReleasePrivateObject(data->Object);
+      ReleasePrivateObject(Data->Object);
    }
    else {
       __sync_sub_and_fetch(&obj->ThreadPending, 1);
@@ -99,19 +98,55 @@ static ERROR thread_action(rkThread *Thread)
 
    // Send a callback notification via messaging if required.  The receiver is in msg_threadaction() in class_thread.c
 
-   if (data->Callback.Type) {
+   if (Data->Callback.Type) {
       ThreadActionMessage msg = {
          .Object   = obj,
-         .ActionID = data->ActionID,
-         .Key      = data->Key,
+         .ActionID = Data->ActionID,
+         .Key      = Data->Key,
          .Error    = error,
-         .Callback = data->Callback
+         .Callback = Data->Callback
       };
       SendMessage(0, MSGID_THREAD_ACTION, MSF_ADD, &msg, sizeof(msg));
    }
 
-   threadpool_release(Thread);
-   return error;
+   free(Data);
+}
+
+//****************************************************************************
+// Refer to ActionThreadBatch().  The result is written to the caller's entry, which remains valid until the batch is
+// complete.
+
+struct batch_task {
+   ThreadAction *Entry;
+   std::atomic<LONG> *Pending;
+};
+
+struct routine_task {
+   void (*Routine)(APTR, LONG);
+   APTR Data;
+   LONG Index;
+   std::atomic<LONG> *Pending;
+};
+
+static void batch_routine(routine_task *Task)
+{
+   Task->Routine(Task->Data, Task->Index);
+   threadpool_complete(*Task->Pending);
+}
+
+static void batch_action(batch_task *Task)
+{
+   auto entry = Task->Entry;
+   OBJECTPTR obj = entry->Object;
+
+   if (!(entry->Error = AccessPrivateObject(obj, 5000))) {
+      __sync_sub_and_fetch(&obj->ThreadPending, 1);
+      entry->Error = Action(entry->ActionID, obj, entry->Args);
+      ReleasePrivateObject(obj);
+   }
+   else __sync_sub_and_fetch(&obj->ThreadPending, 1);
+
+   threadpool_complete(*Task->Pending);
 }
 
 // Free all private memory resources tracked to an object.  Do this before deallocating public objects
@@ -121,63 +156,71 @@ static void free_private_children(OBJECTPTR Object)
 {
    parasol::Log log;
 
-   ThreadLock lock(TL_PRIVATE_MEM, 4000);
-   if (lock.granted()) {
-      {
-         const auto children = glObjectChildren[Object->UniqueID]; // Take an immutable copy of the resource list
-
-         for (const auto id : children) {
-            auto it = glPrivateMemory.find(id);
-            if (it IS glPrivateMemory.end()) continue;
-            auto &mem = it->second;
-
-            if ((mem.Flags & MEM_DELETE) or (!mem.Object)) continue;
+   {
+      const auto children = glObjectChildren.copy(Object->UniqueID); // Take an immutable copy of the resource list
+
+      for (const auto id : children) {
+         OBJECTPTR child;
+         {
+            auto &shard = glPrivateMemory.shard(id);
+            std::shared_lock lock(shard.Lock);
+            auto it = shard.Map.find(id);
+            if (it IS shard.Map.end()) continue;
+            if ((it->second.Flags & MEM_DELETE) or (!it->second.Object)) continue;
+            child = it->second.Object;
+         }
 
-            if (mem.Object->OwnerID != Object->UniqueID) {
-               log.warning("Failed sanity test: Child object #%d has owner ID of #%d that does not match #%d.", mem.Object->UniqueID, mem.Object->OwnerID, Object->UniqueID);
-               continue;
-            }
+         if (child->OwnerID != Object->UniqueID) {
+            log.warning("Failed sanity test: Child object #%d has owner ID of #%d that does not match #%d.", child->UniqueID, child->OwnerID, Object->UniqueID);
+            continue;
+         }
 
-            if (!(mem.Object->Flags & NF_UNLOCK_FREE)) {
-               if (mem.Object->Flags & NF_INTEGRAL) {
-                  log.warning("Found unfreed child object #%d (class %s) belonging to %s object #%d.", mem.Object->UniqueID, ResolveClassID(mem.Object->ClassID), Object->Class->ClassName, Object->UniqueID);
-               }
-               acFree(mem.Object);
+         if (!(child->Flags & NF_UNLOCK_FREE)) {
+            if (child->Flags & NF_INTEGRAL) {
+               log.warning("Found unfreed child object #%d (class %s) belonging to %s object #%d.", child->UniqueID, ResolveClassID(child->ClassID), Object->Class->ClassName, Object->UniqueID);
             }
+            acFree(child);
          }
       }
+   }
 
-      {
-         const auto list = glObjectMemory[Object->UniqueID]; // Take an immutable copy of the resource list
-
-         for (const auto id : list) {
-            auto it = glPrivateMemory.find(id);
-            if (it IS glPrivateMemory.end()) continue;
-            auto &mem = it->second;
-
-            if ((mem.Flags & MEM_DELETE) or (!mem.Address)) continue;
+   {
+      const auto list = glObjectMemory.copy(Object->UniqueID); // Take an immutable copy of the resource list
+
+      for (const auto id : list) {
+         APTR address;
+         LONG flags, size;
+         {
+            auto &shard = glPrivateMemory.shard(id);
+            std::shared_lock lock(shard.Lock);
+            auto it = shard.Map.find(id);
+            if (it IS shard.Map.end()) continue;
+            if ((it->second.Flags & MEM_DELETE) or (!it->second.Address)) continue;
+            address = it->second.Address;
+            flags   = it->second.Flags;
+            size    = it->second.Size;
+         }
 
-            if (glLogLevel >= 3) {
-               if (mem.Flags & MEM_STRING) {
-                  log.warning("Unfreed string \"%.40s\"", (CSTRING)mem.Address);
-               }
-               else if (mem.Flags & MEM_MANAGED) {
-                  auto res = (ResourceManager **)((char *)mem.Address - sizeof(LONG) - sizeof(LONG) - sizeof(ResourceManager *));
-                  if (res[0]) {
-                     log.warning("Unfreed %s resource at %p.", res[0]->Name, mem.Address);
-                  }
-                  else log.warning("Unfreed resource at %p.", mem.Address);
+         if (glLogLevel >= 3) {
+            if (flags & MEM_STRING) {
+               log.warning("Unfreed string \"%.40s\"", (CSTRING)address);
+            }
+            else if (flags & MEM_MANAGED) {
+               auto res = (ResourceManager **)((char *)address - sizeof(LONG) - sizeof(LONG) - sizeof(ResourceManager *));
+               if (res[0]) {
+                  log.warning("Unfreed %s resource at %p.", res[0]->Name, address);
                }
-               else log.warning("Unfreed memory block %p, Size %d", mem.Address, mem.Size);
+               else log.warning("Unfreed resource at %p.", address);
             }
-
-            if (FreeResource(mem.Address) != ERR_Okay) log.warning("Error freeing tracked address %p", mem.Address);
+            else log.warning("Unfreed memory block %p, Size %d", address, size);
          }
-      }
 
-      glObjectChildren.erase(Object->UniqueID);
-      glObjectMemory.erase(Object->UniqueID);
+         if (FreeResource(address) != ERR_Okay) log.warning("Error freeing tracked address %p", address);
+      }
    }
+
+   glObjectChildren.erase(Object->UniqueID);
+   glObjectMemory.erase(Object->UniqueID);
 }
 
 // Free all public memory resources and objects tracked to this object
@@ -1039,7 +1082,7 @@ ERROR ActionTags(LONG ActionID, OBJECTPTR argObject, ...)
 ActionThread: Execute an action in parallel, via a separate thread.
 
 This function follows the same principles of execution as the Action() function, with the difference of executing the
-action in parallel via a dynamically allocated thread.  Please refer to the ~Action() function for general
+action in parallel via the Core's pool of worker threads.  Please refer to the ~Action() function for general
 information on action execution.
 
 To receive feedback of the action's completion, use the Callback parameter and supply a function.  The function
@@ -1052,8 +1095,9 @@ in the next call to ~ProcessMessages(), so as to maintain an orderly execution p
 The 'Error' parameter in the callback reflects the error code returned by the action after it has been called.  Note
 that if ActionThread() fails, the callback will never be executed because the thread attempt will have been aborted.
 
-Please note that there is some overhead involved when safely initialising and executing a new thread.  This function is
-at its most effective when used to perform lengthy processes such as the loading and parsing of data.
+The worker pool is started on the first call to this function.  By default it has one thread for each processor core;
+the `--threads=n` command-line option can be used to change this.  Requests are queued if all workers are busy, so
+there is no limit on the number of actions that can be pending.
 
 -INPUT-
 int(AC) Action: An action or method ID must be specified here.
@@ -1067,8 +1111,8 @@ Okay
 NullArgs
 IllegalMethodID
 MissingClass
-NewObject
-Init
+AllocMemory
+SystemLocked: The thread pool has been shut down.
 -END-
 
 *****************************************************************************/
@@ -1081,81 +1125,181 @@ ERROR ActionThread(ACTIONID ActionID, OBJECTPTR Object, APTR Parameters, FUNCTIO
 
    log.traceBranch("Action: %d, Object: %d, Parameters: %p, Callback: %p, Key: %d", ActionID, Object->UniqueID, Parameters, Callback, Key);
 
+   // Prepare the parameter buffer for passing to the thread routine.  The buffer is released by thread_action().
+
+   auto call = (thread_data *)malloc(sizeof(thread_data) + SIZE_ACTIONBUFFER);
+   if (!call) return log.warning(ERR_AllocMemory);
+
    __sync_add_and_fetch(&Object->ThreadPending, 1);
 
-   ERROR error;
-   objThread *thread = NULL;
-   if (!(error = threadpool_get(&thread))) {
-      // Prepare the parameter buffer for passing to the thread routine.
-
-      LONG argssize;
-      BYTE call_data[sizeof(thread_data) + SIZE_ACTIONBUFFER];
-      BYTE free_args = FALSE;
-      const FunctionField *args = NULL;
-      rkMetaClass *metaclass;
-
-      if (Parameters) {
-         if (ActionID > 0) {
-            args = ActionTable[ActionID].Args;
-            if ((argssize = ActionTable[ActionID].Size) > 0) {
-               if (!(error = local_copy_args(args, argssize, (BYTE *)Parameters, call_data + sizeof(thread_data), SIZE_ACTIONBUFFER, &argssize, ActionTable[ActionID].Name))) {
-                  free_args = TRUE;
-               }
+   ERROR error = ERR_Okay;
+   LONG argssize;
+   BYTE free_args = FALSE;
+   const FunctionField *args = NULL;
+   rkMetaClass *metaclass;
 
-               argssize += sizeof(thread_data);
+   if (Parameters) {
+      if (ActionID > 0) {
+         args = ActionTable[ActionID].Args;
+         if ((argssize = ActionTable[ActionID].Size) > 0) {
+            if (!(error = local_copy_args(args, argssize, (BYTE *)Parameters, (BYTE *)(call + 1), SIZE_ACTIONBUFFER, &argssize, ActionTable[ActionID].Name))) {
+               free_args = TRUE;
             }
-            else argssize = sizeof(thread_data);
          }
-         else if ((metaclass = Object->Class)) {
-            if ((-ActionID) < metaclass->TotalMethods) {
-               args = metaclass->Methods[-ActionID].Args;
-               if ((argssize = metaclass->Methods[-ActionID].Size) > 0) {
-                  if (!(error = local_copy_args(args, argssize, (BYTE *)Parameters, call_data + sizeof(thread_data), SIZE_ACTIONBUFFER, &argssize, metaclass->Methods[-ActionID].Name))) {
-                     free_args = TRUE;
-                  }
+      }
+      else if ((metaclass = Object->Class)) {
+         if ((-ActionID) < metaclass->TotalMethods) {
+            args = metaclass->Methods[-ActionID].Args;
+            if ((argssize = metaclass->Methods[-ActionID].Size) > 0) {
+               if (!(error = local_copy_args(args, argssize, (BYTE *)Parameters, (BYTE *)(call + 1), SIZE_ACTIONBUFFER, &argssize, metaclass->Methods[-ActionID].Name))) {
+                  free_args = TRUE;
                }
-               else log.trace("Ignoring parameters provided for method %s", metaclass->Methods[-ActionID].Name);
-
-               argssize += sizeof(thread_data);
             }
-            else error = log.warning(ERR_IllegalMethodID);
+            else log.trace("Ignoring parameters provided for method %s", metaclass->Methods[-ActionID].Name);
          }
-         else error = log.warning(ERR_MissingClass);
+         else error = log.warning(ERR_IllegalMethodID);
       }
-      else argssize = sizeof(thread_data);
+      else error = log.warning(ERR_MissingClass);
+   }
 
-      // Execute the thread that will call the action.  Refer to thread_action() for the routine.
+   // Queue the task that will call the action.  Refer to thread_action() for the routine.
 
-      if (!error) {
-         SET_FUNCTION_STDC(thread->prv.Routine, (APTR)&thread_action);
-
-         thread_data *call = (thread_data *)call_data;
-         call->Object   = Object;
-         call->ActionID = ActionID;
-         call->Key      = Key;
-         call->Parameters = Parameters ? TRUE : FALSE;
-         if (Callback) call->Callback = *Callback;
-         else call->Callback.Type = 0;
-
-         struct thSetData setdata = {
-            .Data = call,
-            .Size = argssize
-         };
-         Action(MT_ThSetData, &thread->Head, &setdata);
-
-         error = Action(AC_Activate, &thread->Head, NULL);
+   if (!error) {
+      call->Object     = Object;
+      call->ActionID   = ActionID;
+      call->Key        = Key;
+      call->Parameters = free_args;
+      if (Callback) call->Callback = *Callback;
+      else call->Callback.Type = 0;
+
+      error = threadpool_submit((void (*)(APTR))&thread_action, call);
+   }
+
+   if (error) {
+      if (free_args) local_free_args(call + 1, args);
+      free(call);
+      __sync_sub_and_fetch(&Object->ThreadPending, 1);
+   }
+
+   return error;
+}
+
+/*****************************************************************************
+
+-FUNCTION-
+ActionThreadBatch: Execute a batch of actions in parallel and wait for all of them to complete.
+
+This function distributes a list of actions across the worker pool that is used by ~ActionThread(), then waits until
+every action has been executed.  It is intended for work that can be split into independent parts, such as processing
+a set of files or the segments of a large buffer, where the caller cannot continue until all of the parts are done.
+
+Each entry in the Actions array specifies the target Object, the ActionID and an optional pointer to the action's
+Args.  Because the function does not return until the batch is complete, the arguments are used directly and are not
+copied.  The error code returned by each action is written to the entry's Error field.
+
+The calling thread executes queued actions while it waits, so it is safe to call this function from within an action
+that is itself running in the pool.  Completion callbacks are not used and no messages are sent to the message queue.
+The same object can appear in more than one entry, in which case its actions are executed one at a time.
+
+-INPUT-
+struct(*ThreadAction) Actions: An array of actions to execute.
+int Total: The total number of entries in the Actions array.
+
+-ERRORS-
+Okay: All of the actions were executed and returned ERR_Okay.
+NullArgs
+Failed: At least one action failed.  Check the Error field of each entry for details.
+-END-
+
+*****************************************************************************/
+
+ERROR ActionThreadBatch(struct ThreadAction *Actions, LONG Total)
+{
+   parasol::Log log(__FUNCTION__);
+
+   if ((!Actions) or (Total < 1)) return log.warning(ERR_NullArgs);
+
+   log.traceBranch("Total: %d", Total);
+
+   std::vector<batch_task> tasks(Total);
+   std::atomic<LONG> pending(Total);
+
+   for (LONG i=0; i < Total; i++) {
+      auto entry = &Actions[i];
+      tasks[i] = { entry, &pending };
+
+      if ((!entry->ActionID) or (!entry->Object)) {
+         entry->Error = ERR_NullArgs;
+         threadpool_complete(pending);
+         continue;
       }
 
-      if (error) {
-         threadpool_release(thread);
-         if (free_args) local_free_args(call_data + sizeof(thread_data), args);
+      __sync_add_and_fetch(&entry->Object->ThreadPending, 1);
+      if (threadpool_submit((void (*)(APTR))&batch_action, &tasks[i]) != ERR_Okay) {
+         batch_action(&tasks[i]); // The pool is unavailable, so the action is executed by the caller.
       }
    }
-   else error = ERR_NewObject;
 
-   if (error) __sync_sub_and_fetch(&Object->ThreadPending, 1);
+   threadpool_wait(pending);
 
-   return error;
+   for (LONG i=0; i < Total; i++) {
+      if (Actions[i].Error) return ERR_Failed;
+   }
+   return ERR_Okay;
+}
+
+/*****************************************************************************
+
+-FUNCTION-
+ThreadBatch: Execute a routine in parallel for a range of indexes and wait for all of them to complete.
+
+This function calls Routine once for every index from 0 up to Total-1, distributing the calls across the worker pool
+that is used by ~ActionThread().  It returns once every call has completed.  It is the equivalent of
+~ActionThreadBatch() for work that is not performed by an object, such as rendering separate regions of an image
+from shared, read-only data.
+
+The Routine receives the Data pointer and the index of the call.  Calls are made in no particular order and can be
+concurrent, so the Routine must not modify anything that is shared with other indexes without its own
+synchronisation.  Objects are not locked by this function.
+
+The calling thread executes queued calls while it waits, so it is safe to call this function from within an action
+or routine that is itself running in the pool.
+
+-INPUT-
+fptr(void ptr int) Routine: The routine to call for each index.  The template for the function is "void Routine(APTR Data, LONG Index)".
+ptr Data: User specific data pointer that will be passed to the Routine.
+int Total: The total number of calls to make.
+
+-ERRORS-
+Okay
+NullArgs
+-END-
+
+*****************************************************************************/
+
+ERROR ThreadBatch(void (*Routine)(APTR, LONG), APTR Data, LONG Total)
+{
+   parasol::Log log(__FUNCTION__);
+
+   if ((!Routine) or (Total < 1)) return log.warning(ERR_NullArgs);
+
+   if (Total IS 1) { // Not worth the overhead of the pool
+      Routine(Data, 0);
+      return ERR_Okay;
+   }
+
+   std::vector<routine_task> tasks(Total);
+   std::atomic<LONG> pending(Total);
+
+   for (LONG i=0; i < Total; i++) {
+      tasks[i] = { Routine, Data, i, &pending };
+      if (threadpool_submit((void (*)(APTR))&batch_routine, &tasks[i]) != ERR_Okay) {
+         batch_routine(&tasks[i]); // The pool is unavailable, so the routine is executed by the caller.
+      }
+   }
+
+   threadpool_wait(pending);
+   return ERR_Okay;
 }
 
 /*****************************************************************************
@@ -1872,12 +2016,18 @@ ERROR MGR_Free(OBJECTPTR Object, APTR Void)
    if (Object->Flags & NF_TIMER_SUB) {
       ThreadLock lock(TL_TIMER, 200);
       if (lock.granted()) {
-         for (auto it=glTimers.begin(); it != glTimers.end(); ) {
-            if (it->SubscriberID IS Object->UniqueID) {
-               log.warning("%s object #%d has an unfreed timer subscription.", mc->ClassName, Object->UniqueID);
-               it = glTimers.erase(it);
+         std::vector<CoreTimer *> unfreed;
+         for (auto timer : glTimers.Heap) {
+            if (timer->SubscriberID IS Object->UniqueID) unfreed.push_back(timer);
+         }
+
+         for (auto timer : unfreed) {
+            log.warning("%s object #%d has an unfreed timer subscription.", mc->ClassName, Object->UniqueID);
+            if (timer->Locked) timer->Routine.Type = 0; // Removed by ProcessMessages() when the call returns
+            else {
+               glTimers.remove(timer);
+               delete timer;
             }
-            else it++;
          }
       }
    }
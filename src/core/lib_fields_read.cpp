@@ -17,52 +17,238 @@ this by calling SetContext() themselves.
 #include "defs.h"
 #include <parasol/main.h>
 
+#include <stdlib.h>
+
 static THREADVAR char strGetField[400]; // Buffer for retrieving unlisted field values
 
+static std::mutex glFieldHashLock; // Serialises the rebuilding of field tables
+
 //****************************************************************************
-// This internal function provides a fast binary search of field names via ID.
+// Binary search of a class' sorted field array.  Used when a class has no lookup table.
 
-Field * lookup_id(OBJECTPTR Object, ULONG FieldID, OBJECTPTR *Result)
+static Field * search_fields(rkMetaClass *Class, ULONG FieldID)
 {
-   rkMetaClass *mc = (rkMetaClass *)(Object->Class);
-   Field *field = mc->prvFields;
-   *Result = Object;
-
+   Field *field = Class->prvFields;
    LONG floor = 0;
-   LONG ceiling = mc->TotalFields;
+   LONG ceiling = Class->TotalFields;
    while (floor < ceiling) {
       LONG i = (floor + ceiling)>>1;
       if (field[i].FieldID < FieldID) floor = i + 1;
       else if (field[i].FieldID > FieldID) ceiling = i;
       else {
-         while ((i > 0) AND (field[i-1].FieldID IS FieldID)) i--;
+         while ((i > 0) and (field[i-1].FieldID IS FieldID)) i--;
          return field+i;
       }
    }
+   return NULL;
+}
+
+//****************************************************************************
+
+static inline FieldSlot * find_slot(FieldHash *Table, ULONG FieldID)
+{
+   ULONG i = (FieldID * Table->Multiplier) >> Table->Shift;
+   while (Table->Slots[i].Field) {
+      if (Table->Slots[i].FieldID IS FieldID) return Table->Slots + i;
+      i = (i + 1) & Table->Mask;
+   }
+   return NULL;
+}
+
+//****************************************************************************
+// Returns a field that is declared by the class itself, ignoring the fields of integral children.
+
+Field * lookup_own_field(rkMetaClass *Class, ULONG FieldID)
+{
+   if (auto table = __atomic_load_n(&Class->prvFieldHash, __ATOMIC_ACQUIRE)) {
+      auto slot = find_slot(table, FieldID);
+      return ((slot) and (slot->Child IS FH_OWN)) ? slot->Field : NULL;
+   }
+   else return search_fields(Class, FieldID);
+}
+
+//****************************************************************************
+// Build the field lookup table for a class.  If an Object is provided and the class promotes its integral children,
+// the fields of each child that is present are merged into the table.  Children that were merged into the previous
+// table are merged again, so rebuilding the table after the class' fields are sorted does not lose them.  The new
+// table is published without locking readers out, so the table that it replaces is retained until the class is freed.
+
+void build_field_hash(rkMetaClass *Class, OBJECTPTR Object)
+{
+   parasol::Log log(__FUNCTION__);
+
+   // Child pointers are read before the lock is taken, because reading them can call into the class.
+
+   OBJECTPTR children[ARRAYSIZE(Class->Children)];
+   UBYTE present = 0;
+   if ((Object) and (Class->Flags & CLF_PROMOTE_INTEGRAL)) {
+      for (LONG c=0; Class->Children[c] != 0xff; c++) {
+         if ((!copy_field_to_buffer(Object, Class->prvFields + Class->Children[c], FT_POINTER, &children[c], NULL, NULL)) and (children[c])) {
+            present |= 1<<c;
+         }
+      }
+   }
+
+   const std::lock_guard<std::mutex> lock(glFieldHashLock);
+
+   auto previous = Class->prvFieldHash;
+   if ((previous) and (Object) and ((previous->Merged | present) IS previous->Merged)) return; // Nothing new to merge
+
+   std::vector<FieldSlot> entries;
+   entries.reserve(Class->TotalFields);
+
+   // The field array is sorted, so only the first of any duplicate IDs is recorded, as per search_fields().
+
+   for (LONG i=0; i < Class->TotalFields; i++) {
+      auto field = Class->prvFields + i;
+      if ((i > 0) and (field[-1].FieldID IS field->FieldID)) continue;
+      entries.push_back({ field->FieldID, FH_OWN, field, Class });
+   }
+
+   // Children are merged in order, so that a field declared by more than one child resolves to the first.
+
+   rkMetaClass *childclasses[ARRAYSIZE(Class->Children)] = { };
+   UBYTE merged = 0;
+   for (LONG c=0; Class->Children[c] != 0xff; c++) {
+      if (present & (1<<c)) childclasses[c] = (rkMetaClass *)children[c]->Class;
+      else if ((previous) and (previous->Merged & (1<<c))) childclasses[c] = previous->ChildClass[c];
+      else continue;
+
+      auto childclass = childclasses[c];
+      merged |= 1<<c;
+      for (LONG i=0; i < childclass->TotalFields; i++) {
+         auto field = childclass->prvFields + i;
+         if ((i > 0) and (field[-1].FieldID IS field->FieldID)) continue;
+
+         bool exists = false;
+         for (auto &entry : entries) {
+            if (entry.FieldID IS field->FieldID) { exists = true; break; }
+         }
+         if (!exists) entries.push_back({ field->FieldID, (UBYTE)c, field, childclass });
+      }
+   }
+
+   // Choose a table size of at least twice the number of fields, then search for a multiplier that places every
+   // field in its home slot.  If none is found, the table is doubled once and the multiplier with the fewest
+   // collisions is used.
+
+   UBYTE bits = 2;
+   while ((1UL<<bits) < entries.size() * 2) bits++;
+
+   ULONG best_multiplier = 0x9e3779b1;
+   UBYTE best_bits = bits;
+   LONG best_collisions = 0x7fffffff;
+   std::vector<UBYTE> used;
+
+   for (UBYTE b=bits; (b <= bits + 1) and (best_collisions); b++) {
+      used.assign(1UL<<b, 0);
+      ULONG multiplier = 0x9e3779b1;
+      for (LONG attempt=0; (attempt < 64) and (best_collisions); attempt++) {
+         LONG collisions = 0;
+         for (auto &entry : entries) {
+            ULONG i = (entry.FieldID * multiplier) >> (32 - b);
+            if (used[i] IS attempt + 1) collisions++;
+            else used[i] = attempt + 1;
+         }
+
+         if (collisions < best_collisions) {
+            best_collisions = collisions;
+            best_multiplier = multiplier;
+            best_bits = b;
+         }
+
+         multiplier = (multiplier * 1664525 + 1013904223) | 1;
+      }
+   }
+
+   ULONG total = 1UL<<best_bits;
+   auto table = (FieldHash *)calloc(1, sizeof(FieldHash) + (sizeof(FieldSlot) * (total - 1)));
+   if (!table) {
+      log.warning(ERR_AllocMemory);
+      return;
+   }
+
+   table->Multiplier = best_multiplier;
+   table->Shift      = 32 - best_bits;
+   table->Mask       = total - 1;
+   table->Merged     = merged;
+   table->Retired    = previous;
+   CopyMemory(childclasses, table->ChildClass, sizeof(table->ChildClass));
+
+   for (auto &entry : entries) {
+      ULONG i = (entry.FieldID * table->Multiplier) >> table->Shift;
+      while (table->Slots[i].Field) i = (i + 1) & table->Mask;
+      table->Slots[i] = entry;
+   }
+
+   __atomic_store_n(&Class->prvFieldHash, table, __ATOMIC_RELEASE);
+
+   if (best_collisions) log.trace("Class %s: %d fields, %d slots, %d collisions.", Class->ClassName, (LONG)entries.size(), total, best_collisions);
+}
+
+//****************************************************************************
+
+void free_field_hash(rkMetaClass *Class)
+{
+   auto table = Class->prvFieldHash;
+   Class->prvFieldHash = NULL;
+   while (table) {
+      auto retired = table->Retired;
+      free(table);
+      table = retired;
+   }
+}
+
+//****************************************************************************
+// Search the integral children of an object in order.  This is the slow path for CLF_PROMOTE_INTEGRAL classes, taken
+// when a field is not in the lookup table or the child's class differs from the one that was merged.  If a child is
+// found that is not yet merged, the table is rebuilt so that later lookups are resolved directly.
+
+static Field * lookup_children(OBJECTPTR Object, rkMetaClass *Class, ULONG FieldID, OBJECTPTR *Result)
+{
+   auto table = __atomic_load_n(&Class->prvFieldHash, __ATOMIC_ACQUIRE);
+   bool rebuild = false;
+   Field *found = NULL;
+
+   for (LONG i=0; Class->Children[i] != 0xff; i++) {
+      OBJECTPTR child;
+      if ((!copy_field_to_buffer(Object, Class->prvFields + Class->Children[i], FT_POINTER, &child, NULL, NULL)) and (child)) {
+         if ((table) and (!(table->Merged & (1<<i)))) rebuild = true;
+         if ((found = lookup_own_field((rkMetaClass *)child->Class, FieldID))) {
+            *Result = child;
+            break;
+         }
+      }
+   }
+
+   if (rebuild) build_field_hash(Class, Object);
+   return found;
+}
+
+//****************************************************************************
+// Resolves a FieldID for an object.  If the field belongs to an integral child, the child is returned in Result.
+
+Field * lookup_id(OBJECTPTR Object, ULONG FieldID, OBJECTPTR *Result)
+{
+   auto mc = (rkMetaClass *)(Object->Class);
+   *Result = Object;
+
+   if (auto table = __atomic_load_n(&mc->prvFieldHash, __ATOMIC_ACQUIRE)) {
+      if (auto slot = find_slot(table, FieldID)) {
+         if (slot->Child IS FH_OWN) return slot->Field;
 
-   if (mc->Flags & CLF_PROMOTE_INTEGRAL) {
-      for (LONG i=0; mc->Children[i] != 0xff; i++) {
          OBJECTPTR child;
-         if ((!copy_field_to_buffer(Object, mc->prvFields + mc->Children[i], FT_POINTER, &child, NULL, NULL)) AND (child)) {
-            rkMetaClass *childclass = (rkMetaClass *)(child->Class);
-            field = childclass->prvFields;
-
-            LONG floor = 0;
-            LONG ceiling = childclass->TotalFields;
-            while (floor < ceiling) {
-               LONG j = (floor + ceiling)>>1;
-               if (field[j].FieldID < FieldID) floor = j + 1;
-               else if (field[j].FieldID > FieldID) ceiling = j;
-               else {
-                  while ((j > 0) AND (field[j-1].FieldID IS FieldID)) j--;
-                  *Result = child;
-                  return field+j;
-               }
-            }
+         if ((!copy_field_to_buffer(Object, mc->prvFields + mc->Children[slot->Child], FT_POINTER, &child, NULL, NULL)) and
+             (child) and (child->Class IS (rkMetaClass *)slot->Source)) {
+            *Result = child;
+            return slot->Field;
          }
       }
    }
-   return 0;
+   else if (auto field = search_fields(mc, FieldID)) return field;
+
+   if (mc->Flags & CLF_PROMOTE_INTEGRAL) return lookup_children(Object, mc, FieldID, Result);
+   else return NULL;
 }
 
 /*****************************************************************************
@@ -111,6 +297,74 @@ Field * FindField(OBJECTPTR Object, ULONG FieldID, OBJECTPTR *Source) // Read-on
 
 /*****************************************************************************
 
+-FUNCTION-
+ResolveFieldHandle: Resolves a field of an object to a handle, for repeated access to that field.
+
+This function looks up a field of an object and records the result in a FieldHandle structure.  The handle can then be
+passed to ~GetFieldByHandle() and ~SetFieldByHandle() to read and write the field without the cost of looking it up
+again.  This is useful when the same field of an object is accessed many times, e.g. on each frame of an animation.
+
+If the field belongs to an integral child of the object, the child is recorded in the Object field of the handle.
+
+A handle remains valid for as long as the object that it refers to exists.  If the object promotes the fields of an
+integral child, the handle must be resolved again if that child is replaced.
+
+-INPUT-
+obj Object: The target object.
+uint FieldID: The 'FID' number of the field.
+struct(*FieldHandle) Handle: Pointer to a FieldHandle structure that will be initialised by this function.
+
+-ERRORS-
+Okay:
+NullArgs:
+UnsupportedField: The Field is not supported by the object's class.
+-END-
+
+*****************************************************************************/
+
+ERROR ResolveFieldHandle(OBJECTPTR Object, ULONG FieldID, struct FieldHandle *Handle)
+{
+   parasol::Log log(__FUNCTION__);
+
+   if ((!Object) or (!Handle)) return log.warning(ERR_NullArgs);
+
+   if ((Handle->Field = lookup_id(Object, FieldID, &Handle->Object))) return ERR_Okay;
+
+   Handle->Object = NULL;
+   return ERR_UnsupportedField; // No warning is given, as checking for the presence of a field is legitimate.
+}
+
+//****************************************************************************
+// Common to GetField() and GetFieldByHandle().
+
+static void clear_result(ULONG Type, APTR Result)
+{
+#ifdef _LP64
+   if (Type & (FD_DOUBLE|FD_LARGE|FD_POINTER|FD_STRING)) *((LARGE *)Result) = 0;
+   else if (Type & FD_VARIABLE); // Do not touch variable storage.
+   else *((LONG *)Result)  = 0;
+#else
+   if (Type & (FD_DOUBLE|FD_LARGE)) *((LARGE *)Result) = 0;
+   else if (Type & FD_VARIABLE); // Do not touch variable storage.
+   else *((LONG *)Result)  = 0;
+#endif
+}
+
+static ERROR read_field(OBJECTPTR Object, Field *Field, ULONG Type, APTR Result)
+{
+   if (!(Field->Flags & FD_READ)) {
+      parasol::Log log("GetField");
+      if (!Field->Name) log.warning("Illegal attempt to read field %s.", GET_FIELD_NAME(Field->FieldID));
+      else log.warning("Illegal attempt to read field %s.", Field->Name);
+      return ERR_NoFieldAccess;
+   }
+
+   ScopedObjectAccess objlock(Object);
+   return copy_field_to_buffer(Object, Field, Type, Result, NULL, NULL);
+}
+
+/*****************************************************************************
+
 -FUNCTION-
 GetField: Retrieves single field values from objects.
 
@@ -164,27 +418,11 @@ ERROR GetField(OBJECTPTR Object, FIELD FieldID, APTR Result)
    ULONG type = FieldID>>32;
    FieldID = FieldID & 0xffffffff;
 
-#ifdef _LP64
-   if (type & (FD_DOUBLE|FD_LARGE|FD_POINTER|FD_STRING)) *((LARGE *)Result) = 0;
-   else if (type & FD_VARIABLE); // Do not touch variable storage.
-   else *((LONG *)Result)  = 0;
-#else
-   if (type & (FD_DOUBLE|FD_LARGE)) *((LARGE *)Result) = 0;
-   else if (type & FD_VARIABLE); // Do not touch variable storage.
-   else *((LONG *)Result)  = 0;
-#endif
+   clear_result(type, Result);
 
    Field *field;
    if ((field = lookup_id(Object, FieldID, &Object))) {
-      if (!(field->Flags & FD_READ)) {
-         if (!field->Name) log.warning("Illegal attempt to read field %s.", GET_FIELD_NAME(FieldID));
-         else log.warning("Illegal attempt to read field %s.", field->Name);
-         return ERR_NoFieldAccess;
-      }
-
-      ScopedObjectAccess objlock(Object);
-      ERROR error = copy_field_to_buffer(Object, field, type, Result, NULL, NULL);
-      return error;
+      return read_field(Object, field, type, Result);
    }
    else log.warning("Unsupported field %s", GET_FIELD_NAME(FieldID));
 
@@ -193,6 +431,40 @@ ERROR GetField(OBJECTPTR Object, FIELD FieldID, APTR Result)
 
 /*****************************************************************************
 
+-FUNCTION-
+GetFieldByHandle: Retrieves a field value through a handle from ResolveFieldHandle().
+
+This function reads a field value in the same way as ~GetField(), but the field is referenced by a handle that has
+been prepared by ~ResolveFieldHandle().  No lookup of the field is required, which makes this function the fastest means of
+repeatedly reading the same field of an object.
+
+The type of the Result must be indicated in the Type parameter, e.g. `TLONG` or `TSTR`.  Type conversion is performed
+as per GetField().
+
+-INPUT-
+struct(*FieldHandle) Handle: A field handle initialised by ResolveFieldHandle().
+large Type: The type of the Result, e.g. `TLONG`.
+ptr Result: Pointer to the variable that will store the result.
+
+-ERRORS-
+Okay:
+NullArgs:
+NoFieldAccess: Permissions for this field indicate that it is not readable.
+-END-
+
+*****************************************************************************/
+
+ERROR GetFieldByHandle(struct FieldHandle *Handle, FIELD Type, APTR Result)
+{
+   if ((!Handle) or (!Handle->Field) or (!Result)) return ERR_NullArgs;
+
+   ULONG type = Type>>32;
+   clear_result(type, Result);
+   return read_field(Handle->Object, Handle->Field, type, Result);
+}
+
+/*****************************************************************************
+
 -FUNCTION-
 GetFieldArray: Retrieves array field values from objects.
 
@@ -108,6 +108,47 @@ ERROR SetArray(OBJECTPTR Object, FIELD FieldID, APTR Array, LONG Elements)
    }
 }
 
+//****************************************************************************
+// Common to SetField() and SetFieldByHandle().
+
+static ERROR write_field(OBJECTPTR Object, Field *Field, ULONG Type, va_list List)
+{
+   parasol::Log log("SetField");
+
+   if ((!(Field->Flags & (FD_INIT|FD_WRITE))) and (tlContext->Object != Object)) {
+      if (!Field->Name) log.warning("Field %s of class %s is not writeable.", GET_FIELD_NAME(Field->FieldID), ((rkMetaClass *)Object->Class)->ClassName);
+      else log.warning("Field \"%s\" of class %s is not writeable.", Field->Name, ((rkMetaClass *)Object->Class)->ClassName);
+      return ERR_NoFieldAccess;
+   }
+   else if ((Field->Flags & FD_INIT) and (Object->Flags & NF_INITIALISED) and (tlContext->Object != Object)) {
+      if (!Field->Name) log.warning("Field %s in class %s is init-only.", GET_FIELD_NAME(Field->FieldID), ((rkMetaClass *)Object->Class)->ClassName);
+      else log.warning("Field \"%s\" in class %s is init-only.", Field->Name, ((rkMetaClass *)Object->Class)->ClassName);
+      return ERR_NoFieldAccess;
+   }
+
+   ERROR error;
+   prv_access(Object);
+
+   if (Type & (FD_POINTER|FD_STRING|FD_FUNCTION|FD_VARIABLE)) {
+      error = Field->WriteValue(Object, Field, Type, va_arg(List, APTR), 0);
+   }
+   else if (Type & FD_DOUBLE) {
+      DOUBLE value = va_arg(List, DOUBLE);
+      error = Field->WriteValue(Object, Field, Type, &value, 1);
+   }
+   else if (Type & FD_LARGE) {
+      LARGE value = va_arg(List, LARGE);
+      error = Field->WriteValue(Object, Field, Type, &value, 1);
+   }
+   else {
+      LONG value = va_arg(List, LONG);
+      error = Field->WriteValue(Object, Field, Type, &value, 1);
+   }
+
+   prv_release(Object);
+   return error;
+}
+
 /*****************************************************************************
 
 -FUNCTION-
@@ -168,54 +209,52 @@ ERROR SetField(OBJECTPTR Object, FIELD FieldID, ...)
    ULONG type = FieldID>>32;
    FieldID = FieldID & 0xffffffff;
 
-   ERROR error;
    Field *field;
    if ((field = lookup_id(Object, FieldID, &Object))) {
-      // Validation
-
-      if ((!(field->Flags & (FD_INIT|FD_WRITE))) and (tlContext->Object != Object)) {
-         if (!field->Name) log.warning("Field %s of class %s is not writeable.", GET_FIELD_NAME(field->FieldID), ((rkMetaClass *)Object->Class)->ClassName);
-         else log.warning("Field \"%s\" of class %s is not writeable.", field->Name, ((rkMetaClass *)Object->Class)->ClassName);
-         return ERR_NoFieldAccess;
-      }
-      else if ((field->Flags & FD_INIT) and (Object->Flags & NF_INITIALISED) and (tlContext->Object != Object)) {
-         if (!field->Name) log.warning("Field %s in class %s is init-only.", GET_FIELD_NAME(field->FieldID), ((rkMetaClass *)Object->Class)->ClassName);
-         else log.warning("Field \"%s\" in class %s is init-only.", field->Name, ((rkMetaClass *)Object->Class)->ClassName);
-         return ERR_NoFieldAccess;
-      }
-
-      prv_access(Object);
-
       va_list list;
       va_start(list, FieldID);
-
-         if (type & (FD_POINTER|FD_STRING|FD_FUNCTION|FD_VARIABLE)) {
-            error = field->WriteValue(Object, field, type, va_arg(list, APTR), 0);
-         }
-         else {
-            if (type & FD_DOUBLE) {
-               DOUBLE value = va_arg(list, DOUBLE);
-               error = field->WriteValue(Object, field, type, &value, 1);
-            }
-            else if (type & FD_LARGE) {
-               LARGE value = va_arg(list, LARGE);
-               error = field->WriteValue(Object, field, type, &value, 1);
-            }
-            else {
-               LONG value = va_arg(list, LONG);
-               error = field->WriteValue(Object, field, type, &value, 1);
-            }
-         }
-
+      ERROR error = write_field(Object, field, type, list);
       va_end(list);
-
-      prv_release(Object);
+      return error;
    }
    else {
       log.warning("Could not find field %s in object class %s.", GET_FIELD_NAME(FieldID), ((rkMetaClass *)Object->Class)->ClassName);
-      error = ERR_UnsupportedField;
+      return ERR_UnsupportedField;
    }
+}
+
+/*****************************************************************************
 
+-FUNCTION-
+SetFieldByHandle: Sets a field value through a handle from ResolveFieldHandle().
+
+This function writes a field value in the same way as ~SetField(), but the field is referenced by a handle that has
+been prepared by ~ResolveFieldHandle().  No lookup of the field is required, which makes this function the fastest means of
+repeatedly writing to the same field of an object.
+
+The type of the Value must be indicated in the Type parameter, e.g. `TLONG` or `TDOUBLE`.
+
+-INPUT-
+struct(*FieldHandle) Handle: A field handle initialised by ResolveFieldHandle().
+large Type: The type of the Value, e.g. `TLONG`.
+vtags Value: The value that will be written to the field.
+
+-ERRORS-
+Okay:
+NullArgs:
+NoFieldAccess: The field is read-only.
+-END-
+
+*****************************************************************************/
+
+ERROR SetFieldByHandle(struct FieldHandle *Handle, FIELD Type, ...)
+{
+   if ((!Handle) or (!Handle->Field)) return ERR_NullArgs;
+
+   va_list list;
+   va_start(list, Type);
+   ERROR error = write_field(Handle->Object, Handle->Field, Type>>32, list);
+   va_end(list);
    return error;
 }
 
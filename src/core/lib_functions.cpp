@@ -40,6 +40,7 @@ Name: System
 #endif
 
 #include <math.h>
+#include <new>
 
 #include "defs.h"
 
@@ -162,19 +163,17 @@ ERROR CheckObjectExists(OBJECTID ObjectID, CSTRING Name)
    else if (ObjectID > 0) {
       if (ObjectID IS SystemTaskID) return ERR_True;
 
-      ThreadLock lock(TL_PRIVATE_MEM, 4000);
-      if (lock.granted()) {
-         LONG result = ERR_False;
-         auto mem = glPrivateMemory.find(ObjectID);
-         if (mem != glPrivateMemory.end()) {
-            if (mem->second.Object) {
-               if (mem->second.Object->Flags & NF_UNLOCK_FREE);
-               else result = ERR_True;
-            }
+      LONG result = ERR_False;
+      auto &shard = glPrivateMemory.shard(ObjectID);
+      std::shared_lock lock(shard.Lock);
+      auto mem = shard.Map.find(ObjectID);
+      if (mem != shard.Map.end()) {
+         if (mem->second.Object) {
+            if (mem->second.Object->Flags & NF_UNLOCK_FREE);
+            else result = ERR_True;
          }
-         return result;
       }
-      else return log.warning(ERR_LockFailed);
+      return result;
    }
    else return log.warning(ERR_Args);
 }
@@ -636,32 +635,13 @@ ERROR FindPrivateObject(CSTRING InitialName, OBJECTPTR *Object)
    if (number) {
       OBJECTID objectid;
       if ((objectid = (OBJECTID)StrToInt(InitialName))) {
-         ThreadLock lock(TL_PRIVATE_MEM, 4000);
-         if (lock.granted()) {
-            auto mem = glPrivateMemory.find(objectid);
-            if (mem != glPrivateMemory.end()) {
-               if (mem->second.Object) {
-                  *Object = mem->second.Object;
-                  return ERR_Okay;
-               }
-            }
-         }
-         else return log.warning(ERR_LockFailed);
+         if ((*Object = (OBJECTPTR)GetMemAddress(objectid))) return ERR_Okay;
       }
       return ERR_Search;
    }
    else if (!StrMatch("owner", InitialName)) {
       if ((tlContext != &glTopContext) and (tlContext->Object->OwnerID)) {
-         ThreadLock lock(TL_PRIVATE_MEM, 4000);
-         if (lock.granted()) {
-            auto mem = glPrivateMemory.find(tlContext->Object->OwnerID);
-            if (mem != glPrivateMemory.end()) {
-               if ((*Object = mem->second.Object)) {
-                  return ERR_Okay;
-               }
-            }
-         }
-         else return log.warning(ERR_LockFailed);
+         if ((*Object = (OBJECTPTR)GetMemAddress(tlContext->Object->OwnerID))) return ERR_Okay;
       }
       return ERR_Search;
    }
@@ -1123,18 +1103,10 @@ obj: The address of the object is returned, or NULL if the ID does not relate to
 
 OBJECTPTR GetObjectPtr(OBJECTID ObjectID)
 {
-   ThreadLock lock(TL_PRIVATE_MEM, 4000);
-   if (lock.granted()) {
-      auto mem = glPrivateMemory.find(ObjectID);
-      if (mem != glPrivateMemory.end()) {
-         if ((mem->second.Flags & MEM_OBJECT) and (mem->second.Object)) {
-            if (mem->second.Object->UniqueID IS ObjectID) {
-               return mem->second.Object;
-            }
-         }
-      }
-   }
+   if (ObjectID <= 0) return NULL;
 
+   auto obj = find_private_object(ObjectID);
+   if ((obj) and (obj->UniqueID IS ObjectID)) return obj; // The header is not valid until NewObject() has configured it
    return NULL;
 }
 
@@ -1173,12 +1145,11 @@ OBJECTID GetOwnerID(OBJECTID ObjectID)
       }
    }
    else {
-      ThreadLock lock(TL_PRIVATE_MEM, 4000);
-      if (lock.granted()) {
-         auto mem = glPrivateMemory.find(ObjectID);
-         if (mem != glPrivateMemory.end()) {
-            if (mem->second.Object) return mem->second.Object->OwnerID;
-         }
+      auto &shard = glPrivateMemory.shard(ObjectID);
+      std::shared_lock lock(shard.Lock);
+      auto mem = shard.Map.find(ObjectID);
+      if (mem != shard.Map.end()) {
+         if (mem->second.Object) return mem->second.Object->OwnerID;
       }
    }
    return ownerid;
@@ -1207,6 +1178,7 @@ ID's are available:
 <type name="TOTAL_SHARED_MEMORY">The total amount of shared memory in use.</>
 <type name="TASK_CONTROL">Undocumented.</>
 <type name="TASK_LIST">Undocumented.</>
+<type name="THREAD_POOL">The number of worker threads used by ~ActionThread() and ~ThreadBatch().  This is set with the --threads argument, otherwise there is one worker per processor core.</>
 <type name="TOTAL_MEMORY">The total amount of installed RAM in bytes.</>
 <type name="TOTAL_SWAP">The total amount of available swap space.</>
 <type name="USER_ID">Undocumented.</>
@@ -1247,6 +1219,7 @@ LARGE GetResource(LONG Resource)
       case RES_JNI_ENV:         return (MAXINT)glJNIEnv;
       case RES_THREAD_ID:       return (MAXINT)get_thread_id();
       case RES_CORE_IDL:        return (MAXINT)glIDL;
+      case RES_THREAD_POOL:     return threadpool_size();
       case RES_DISPLAY_DRIVER:  if (glDisplayDriver[0]) return (MAXINT)glDisplayDriver; else return 0;
 
 #ifdef __linux__
@@ -1340,6 +1313,9 @@ GetSystemState: Returns miscellaneous data values from the Core.
 The GetSystemState() function is used to retrieve miscellaneous resource and environment values, such as resource
 paths, the Core's version number and the name of the host platform.
 
+The allocation counters for the small block allocator are refreshed on each call.  The hit rate of the allocator can
+be calculated from the total Allocations in the Slabs array versus the SlabMisses value.
+
 -RESULT-
 cstruct(*SystemState): A read-only SystemState structure is returned.
 
@@ -1374,6 +1350,11 @@ const SystemState * GetSystemState(void)
       #endif
    }
 
+   static SlabStats slabs[SLAB_CLASSES];
+   slab_stats(slabs, &state.SlabMisses);
+   state.Slabs = slabs;
+   state.TotalSlabClasses = SLAB_CLASSES;
+
    state.Stage = glSharedControl->SystemState;
    return &state;
 }
@@ -1436,18 +1417,17 @@ ERROR ListChildren(OBJECTID ObjectID, LONG IncludeShared, ChildEntry *List, LONG
    // Build the list of private objects
 
    if (i < *Count) {
-      ThreadLock lock(TL_PRIVATE_MEM, 4000);
-      if (lock.granted()) {
-         for (const auto id : glObjectChildren[ObjectID]) {
-            auto mem = glPrivateMemory.find(id);
-            if (mem IS glPrivateMemory.end()) continue;
-
-            OBJECTPTR child;
-            if (((child = mem->second.Object)) and (!(child->Flags & NF_INTEGRAL))) {
-               List[i].ObjectID = child->UniqueID;
-               List[i].ClassID  = child->ClassID;
-               if (++i >= *Count) break;
-            }
+      for (const auto id : glObjectChildren.copy(ObjectID)) {
+         auto &shard = glPrivateMemory.shard(id);
+         std::shared_lock lock(shard.Lock);
+         auto mem = shard.Map.find(id);
+         if (mem IS shard.Map.end()) continue;
+
+         OBJECTPTR child;
+         if (((child = mem->second.Object)) and (!(child->Flags & NF_INTEGRAL))) {
+            List[i].ObjectID = child->UniqueID;
+            List[i].ClassID  = child->ClassID;
+            if (++i >= *Count) break;
          }
       }
    }
@@ -1604,7 +1584,8 @@ callback can be registered, followed by a write callback in a second call. Indiv
 combining the read/write flags with RFD_REMOVE.
 
 The capabilities of this function and FD handling in general is developed to suit the host platform. On POSIX
-compliant systems, standard file descriptors are used.  In Microsoft Windows, object handles are used and blocking
+compliant systems, standard file descriptors are used.  Linux monitors descriptors with epoll and imposes no limit on
+the number that can be registered; other POSIX systems use select() and are limited to FD_SETSIZE.  In Microsoft Windows, object handles are used and blocking
 restrictions do not apply, except to sockets.
 
 Call the DeregisterFD() macro to simplify unsubscribing once the file descriptor is no longer needed or is destroyed.
@@ -1618,12 +1599,52 @@ ptr Data: User specific data pointer that will be passed to the Routine.  Separa
 -ERRORS-
 Okay: The FD was successfully registered.
 Args: The FD was set to a value of -1.
-ArrayFull: The maximum number of registrable file descriptors has been reached.
+ArrayFull: The descriptor cannot be monitored by the host's fallback mechanism (select() is limited to FD_SETSIZE and Windows to 64 handles).
+AllocMemory: The FD table could not be expanded.
 NoSupport: The host platform does not support file descriptors.
 -END-
 
 *****************************************************************************/
 
+//****************************************************************************
+// Returns the index of the first record for FD in glFDTable, or the position at which it would be inserted.
+
+LONG find_fd(HOSTHANDLE FD)
+{
+   LONG floor = 0, ceiling = glTotalFDs;
+   while (floor < ceiling) {
+      LONG i = (floor + ceiling)>>1;
+      if ((MAXINT)glFDTable[i].FD < (MAXINT)FD) floor = i + 1;
+      else ceiling = i;
+   }
+   return floor;
+}
+
+//****************************************************************************
+// Returns the combined RFD_READ, RFD_WRITE and RFD_EXCEPT flags of all records for FD.
+
+LONG fd_events(HOSTHANDLE FD)
+{
+   LONG events = 0;
+   for (LONG i=find_fd(FD); (i < glTotalFDs) and (glFDTable[i].FD IS FD); i++) {
+      events |= glFDTable[i].Flags & (RFD_READ|RFD_WRITE|RFD_EXCEPT);
+   }
+   return events;
+}
+
+//****************************************************************************
+
+static void remove_fd_record(LONG Index)
+{
+   if (glFDTable[Index].Flags & (RFD_ALWAYS_CALL|RFD_RECALL)) glFDCallers--;
+   if (Index+1 < glTotalFDs) {
+      CopyMemory(glFDTable+Index+1, glFDTable+Index, sizeof(FDTable) * (glTotalFDs-Index-1));
+   }
+   glTotalFDs--;
+}
+
+//****************************************************************************
+
 #ifdef _WIN32
 ERROR RegisterFD(HOSTHANDLE FD, LONG Flags, void (*Routine)(HOSTHANDLE, APTR), APTR Data)
 #else
@@ -1641,41 +1662,56 @@ ERROR RegisterFD(LONG FD, LONG Flags, void (*Routine)(HOSTHANDLE, APTR), APTR Da
    if (FD IS -1) return log.warning(ERR_Args);
 #endif
 
-   if (glTotalFDs >= MAX_FDS) return log.warning(ERR_ArrayFull);
-
-   if (!glFDTable) {
-      if (!(glFDTable = (FDTable *)malloc(sizeof(FDTable) * MAX_FDS))) return ERR_AllocMemory;
-   }
-
    if (Flags & RFD_REMOVE) {
+      if (!glTotalFDs) return ERR_Okay;
+
       if (!(Flags & (RFD_READ|RFD_WRITE|RFD_EXCEPT|RFD_ALWAYS_CALL))) Flags |= RFD_READ|RFD_WRITE|RFD_EXCEPT|RFD_ALWAYS_CALL;
 
-      for (LONG i=glTotalFDs-1; i >= 0; i--) {
-         if ((glFDTable[i].FD IS FD) and ((glFDTable[i].Flags & (RFD_READ|RFD_WRITE|RFD_EXCEPT|RFD_ALWAYS_CALL)) & Flags)) {
+      LONG events = fd_events(FD);
+      for (LONG i=find_fd(FD); (i < glTotalFDs) and (glFDTable[i].FD IS FD);) {
+         if ((glFDTable[i].Flags & (RFD_READ|RFD_WRITE|RFD_EXCEPT|RFD_ALWAYS_CALL)) & Flags) {
             // If the routine address was specified with the remove option, the routine must match.
 
-            if ((Routine) and (glFDTable[i].Routine != Routine)) continue;
-
-            if (i+1 < glTotalFDs) {
-               CopyMemory(glFDTable+i+1, glFDTable+i, sizeof(FDTable) * (glTotalFDs-i-1));
+            if ((!Routine) or (glFDTable[i].Routine IS Routine)) {
+               remove_fd_record(i);
+               continue;
             }
-
-            glTotalFDs--;
          }
+         i++;
       }
+
+      update_fd_events(FD, events);
       return ERR_Okay;
    }
 
    if (!(Flags & (RFD_READ|RFD_WRITE|RFD_EXCEPT|RFD_REMOVE|RFD_ALWAYS_CALL))) Flags |= RFD_READ;
 
+   LONG events = fd_events(FD);
    LONG i;
-   for (i=0; i < glTotalFDs; i++) {
-      if ((glFDTable[i].FD IS FD) and (Flags & (glFDTable[i].Flags & (RFD_READ|RFD_WRITE|RFD_EXCEPT|RFD_ALWAYS_CALL)))) break;
+   for (i=find_fd(FD); (i < glTotalFDs) and (glFDTable[i].FD IS FD); i++) {
+      if (Flags & (glFDTable[i].Flags & (RFD_READ|RFD_WRITE|RFD_EXCEPT|RFD_ALWAYS_CALL))) break;
    }
 
-   if (i >= MAX_FDS) return log.warning(ERR_ArrayFull);
+   if ((i >= glTotalFDs) or (glFDTable[i].FD != FD)) { // New record, inserted at i to keep the table sorted
+#ifdef _WIN32
+      if (glTotalFDs >= MAX_WIN_FDS) return log.warning(ERR_ArrayFull);
+#else
+      if ((FD >= FD_SETSIZE) and (use_select())) return log.warning(ERR_ArrayFull); // select() is limited to FD_SETSIZE
+#endif
+
+      if (glTotalFDs >= glFDTableSize) {
+         auto table = (FDTable *)realloc(glFDTable, sizeof(FDTable) * (glFDTableSize + FD_TABLE_BLOCK + (glFDTableSize>>1)));
+         if (!table) return log.warning(ERR_AllocMemory);
+         glFDTable = table;
+         glFDTableSize += FD_TABLE_BLOCK + (glFDTableSize>>1);
+      }
+
+      log.function("FD: " PF64() ", Routine: %p, Flags: $%.2x (New)", (MAXINT)FD, Routine, Flags);
 
-   if (i IS glTotalFDs) log.function("FD: " PF64() ", Routine: %p, Flags: $%.2x (New)", (MAXINT)FD, Routine, Flags);
+      if (i < glTotalFDs) CopyMemory(glFDTable+i, glFDTable+i+1, sizeof(FDTable) * (glTotalFDs-i));
+      glFDTable[i].Flags = 0;
+      glTotalFDs++;
+   }
 
 #ifdef _WIN32
    // Nothing to do for Win32
@@ -1683,12 +1719,15 @@ ERROR RegisterFD(LONG FD, LONG Flags, void (*Routine)(HOSTHANDLE, APTR), APTR Da
    if ((!Routine) and (FD > 0)) fcntl(FD, F_SETFL, fcntl(FD, F_GETFL) | O_NONBLOCK); // Ensure that the FD is non-blocking
 #endif
 
+   if (glFDTable[i].Flags & (RFD_ALWAYS_CALL|RFD_RECALL)) glFDCallers--;
+   if (Flags & (RFD_ALWAYS_CALL|RFD_RECALL)) glFDCallers++;
+
    glFDTable[i].FD      = FD;
    glFDTable[i].Routine = Routine;
    glFDTable[i].Data    = Data;
    glFDTable[i].Flags   = Flags;
-   if (i >= glTotalFDs) glTotalFDs++;
 
+   update_fd_events(FD, events);
    return ERR_Okay;
 }
 
@@ -1812,8 +1851,7 @@ ERROR SetOwner(OBJECTPTR Object, OBJECTPTR Owner)
             auto list = (SharedObject *)ResolveAddress(header.ptr, header.ptr->Offset);
 
             if (Object->OwnerID) { // Remove reference from the now previous owner
-               auto it = glObjectChildren.find(Object->OwnerID);
-               if (it != glObjectChildren.end()) it->second.erase(Object->UniqueID);
+               glObjectChildren.erase_from(Object->OwnerID, Object->UniqueID);
             }
 
             Object->OwnerID = Owner->UniqueID;
@@ -1837,20 +1875,22 @@ ERROR SetOwner(OBJECTPTR Object, OBJECTPTR Owner)
    }
    else {
       { // Track the object's memory header to the new owner
-         ThreadLock lock(TL_PRIVATE_MEM, 4000);
-         if (lock.granted()) {
-            auto mem = glPrivateMemory.find(Object->UniqueID);
-            if (mem IS glPrivateMemory.end()) return log.warning(ERR_SystemCorrupt);
-            mem->second.OwnerID = Owner->UniqueID;
+         auto &shard = glPrivateMemory.shard(Object->UniqueID);
+         std::unique_lock lock(shard.Lock);
+         auto mem = shard.Map.find(Object->UniqueID);
+         if (mem IS shard.Map.end()) {
+            lock.unlock();
+            return log.warning(ERR_SystemCorrupt);
+         }
+         mem->second.OwnerID = Owner->UniqueID;
+         lock.unlock();
 
-            // Remove reference from the now previous owner
-            if (Object->OwnerID) glObjectChildren[Object->OwnerID].erase(Object->UniqueID);
+         // Remove reference from the now previous owner
+         if (Object->OwnerID) glObjectChildren.erase_from(Object->OwnerID, Object->UniqueID);
 
-            Object->OwnerID = Owner->UniqueID;
+         Object->OwnerID = Owner->UniqueID;
 
-            glObjectChildren[Owner->UniqueID].insert(Object->UniqueID);
-         }
-         else return log.warning(ERR_Lock);
+         glObjectChildren.insert_into(Owner->UniqueID, Object->UniqueID);
       }
 
       // If the owner is public and belongs to another task, subscribe to the FreeResources action so
@@ -2422,7 +2462,7 @@ ptr(func) Callback: A callback function is required that will be called on each
 Okay:
 NullArgs:
 Args:
-ArrayFull: The task's timer array is at capacity - no more subscriptions can be granted.
+AllocMemory:
 BadState: The subscriber is marked for termination.
 SystemLocked:
 
@@ -2449,25 +2489,29 @@ ERROR SubscribeTimer(DOUBLE Interval, FUNCTION *Callback, APTR *Subscription)
          // interruptions that occur per second.
       }
 
-      auto it = glTimers.emplace(glTimers.end());
+      auto timer = new (std::nothrow) CoreTimer;
+      if (!timer) return log.warning(ERR_AllocMemory);
+
       LARGE subscribed = PreciseTime();
-      it->SubscriberID = subscriber->UniqueID;
-      it->Interval     = usInterval;
-      it->LastCall     = subscribed;
-      it->NextCall     = subscribed + usInterval;
-      it->Routine      = *Callback;
-      it->Locked       = false;
-      it->Cycle        = glTimerCycle - 1;
+      timer->SubscriberID = subscriber->UniqueID;
+      timer->Interval     = usInterval;
+      timer->LastCall     = subscribed;
+      timer->NextCall     = subscribed + usInterval;
+      timer->Routine      = *Callback;
+      timer->Locked       = false;
+      timer->Cycle        = glTimerCycle - 1;
+
+      if (subscriber->UniqueID > 0) timer->Subscriber = subscriber;
+      else timer->Subscriber = NULL;
 
-      if (subscriber->UniqueID > 0) it->Subscriber = subscriber;
-      else it->Subscriber = NULL;
+      glTimers.insert(timer);
 
       // For resource tracking purposes it is important for us to keep a record of the subscription so that
       // we don't treat the object address as valid when it's been removed from the system.
 
       subscriber->Flags |= NF_TIMER_SUB;
 
-      if (Subscription) *Subscription = &*it;
+      if (Subscription) *Subscription = timer;
 
       return ERR_Okay;
    }
@@ -2604,6 +2648,7 @@ ERROR UpdateTimer(APTR Subscription, DOUBLE Interval)
          LARGE usInterval = (LARGE)(Interval * 1000000.0);
          timer->Interval = usInterval;
          timer->NextCall = PreciseTime() + usInterval;
+         glTimers.reschedule(timer);
          return ERR_Okay;
       }
       else {
@@ -2614,25 +2659,88 @@ ERROR UpdateTimer(APTR Subscription, DOUBLE Interval)
             return log.warning(ERR_AlreadyLocked);
          }
 
+         glTimers.remove(timer);
          lock.release();
 
          if (timer->Routine.Type IS CALL_SCRIPT) {
             scDerefProcedure(timer->Routine.Script.Script, &timer->Routine);
          }
 
-         for (auto it=glTimers.begin(); it != glTimers.end(); it++) {
-            if (timer IS &(*it)) {
-               glTimers.erase(it);
-               break;
-            }
-         }
-
+         delete timer;
          return ERR_Okay;
       }
    }
    else return log.warning(ERR_SystemLocked);
 }
 
+//****************************************************************************
+// TimerQueue management.  All functions require the TL_TIMER lock.
+
+void TimerQueue::insert(CoreTimer *Timer)
+{
+   Timer->Index = Heap.size();
+   Heap.push_back(Timer);
+   sift_up(Timer->Index);
+}
+
+void TimerQueue::remove(CoreTimer *Timer)
+{
+   LONG i = Timer->Index;
+   if ((i < 0) or (i >= (LONG)Heap.size()) or (Heap[i] != Timer)) return;
+
+   auto last = Heap.back();
+   Heap.pop_back();
+   Timer->Index = -1;
+
+   if (last != Timer) {
+      Heap[i] = last;
+      last->Index = i;
+      sift_up(i);
+      sift_down(last->Index);
+   }
+}
+
+// Restores the heap order after the NextCall value of a queued timer has been changed.
+
+void TimerQueue::reschedule(CoreTimer *Timer)
+{
+   LONG i = Timer->Index;
+   if ((i < 0) or (i >= (LONG)Heap.size()) or (Heap[i] != Timer)) return;
+   sift_up(i);
+   sift_down(Timer->Index);
+}
+
+void TimerQueue::sift_up(LONG Index)
+{
+   auto timer = Heap[Index];
+   while (Index > 0) {
+      LONG parent = (Index - 1)>>1;
+      if (Heap[parent]->NextCall <= timer->NextCall) break;
+      Heap[Index] = Heap[parent];
+      Heap[Index]->Index = Index;
+      Index = parent;
+   }
+   Heap[Index] = timer;
+   timer->Index = Index;
+}
+
+void TimerQueue::sift_down(LONG Index)
+{
+   LONG total = Heap.size();
+   auto timer = Heap[Index];
+   while (1) {
+      LONG child = (Index<<1) + 1;
+      if (child >= total) break;
+      if ((child + 1 < total) and (Heap[child+1]->NextCall < Heap[child]->NextCall)) child++;
+      if (timer->NextCall <= Heap[child]->NextCall) break;
+      Heap[Index] = Heap[child];
+      Heap[Index]->Index = Index;
+      Index = child;
+   }
+   Heap[Index] = timer;
+   timer->Index = Index;
+}
+
 /*****************************************************************************
 
 -FUNCTION-
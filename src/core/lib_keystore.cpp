@@ -8,41 +8,102 @@ Please refer to it for further information on licensing.
 Name: KeyStore
 -END-
 
-Each key-value pair is stored as an independent block of allocated memory from malloc() to minimise resource usage and
-tracking requirements.
+Key-value pairs are stored inline in arena blocks that belong to the KeyStore.  Pairs up to ARENA_MAX_PAIR bytes are
+recycled through size-classed free lists when they are removed or replaced, while larger pairs are allocated
+individually.  Pairs never move once created, so data pointers remain valid until the key is removed or its value no
+longer fits the existing allocation.
 
-Keys cannot be deleted, only marked as dead and then the space is reclaimed when the KeyStore is rehashed.
+The hash table is open-addressed with linear probing.  Removed keys are cleared with backward-shift deletion, so
+there are no tombstones and lookups stop at the first empty slot.  The table is grown when it is three-quarters full.
+
+Thread-safe stores allow any number of concurrent readers through a shared lock.  Modifications take the recursive
+store Mutex (which is also used by VarLock()) followed by the exclusive lock, so a locked store blocks other writers
+but not readers.
 
 *****************************************************************************/
 
 #include "defs.h"
 
+#include <new>
 #include <stdlib.h>
 #include <string.h>
 
 #define KPF_STRING    0x0001
-#define KPF_DEAD      0x0002
 #define KPF_PREHASHED 0x0004 // Pre-hashed keys have no string name.
+#define KPF_EXTERNAL  0x0008 // The pair was too large for the arena and was allocated with malloc().
 
 struct KeyPair {
    UWORD ValueOffset;
    UWORD Flags;
    ULONG KeyHash;
    ULONG ValueLength;
+   ULONG Capacity;    // Total bytes allocated to the pair, including this header.
    // Key name follows
 };
 
+struct KeySlot {
+   ULONG KeyHash;     // Copy of Pair->KeyHash, so that probing does not need to read the pair.
+   KeyPair *Pair;     // NULL if the slot is empty.
+};
+
+struct KeyArena {
+   KeyArena *Next;    // Previously filled arena blocks.
+   LONG Size;
+   LONG Used;
+   // Pair data follows
+};
+
+struct KeyFree {
+   KeyFree *Next;
+};
+
+#define INITIAL_SIZE 32 // The table size must always be a power of 2
+#define ARENA_GRAIN 16
+#define ARENA_CLASSES 32
+#define ARENA_MAX_PAIR (ARENA_GRAIN * ARENA_CLASSES)
+#define ARENA_MIN_BLOCK 1024
+#define ARENA_MAX_BLOCK (64 * 1024)
+
+struct extKeyStore : public KeyStore {
+   std::shared_mutex Lock;              // Shared by readers, exclusive for modifications.
+   KeyArena *Arena;                     // The arena block that is currently being filled.
+   KeyFree  *FreeList[ARENA_CLASSES];   // Recycled pairs, indexed by Capacity / ARENA_GRAIN - 1
+   UBYTE Shift;                         // 32 - log2(TableSize)
+};
+
 INLINE CSTRING GET_KEY_VALUE(KeyPair *KP) { return (CSTRING)(((char *)KP) + KP->ValueOffset); }
 INLINE CSTRING GET_KEY_NAME(KeyPair *KP) { return (KP->Flags & KPF_PREHASHED) ? NULL : ((CSTRING)(KP + 1)); }
-INLINE void DEAD_KEY(KeyPair *KP) { KP->Flags |= KPF_DEAD; }
-INLINE LONG CHECK_DEAD_KEY(KeyPair *KP) { return (KP->Flags & KPF_DEAD) != 0; }
-INLINE LONG GET_KEY_SIZE(KeyPair *KP) { return KP->ValueOffset + KP->ValueLength; }
 
-#define INITIAL_SIZE 128 // The table size must always be a power of 2
-#define BUCKET_SIZE 8
+//****************************************************************************
+// Scoped locks for thread-safe stores.  Unsafe stores are not locked.
 
-#define MOD_TABLESIZE(val,size) ((val) & (size - 1))
-#define HEAD_SIZE sizeof(KeyPair)
+class KeyReadLock {
+   extKeyStore *Store;
+public:
+   KeyReadLock(extKeyStore *pStore) : Store(pStore) {
+      if (Store->Flags & KSF_THREAD_SAFE) Store->Lock.lock_shared();
+   }
+   ~KeyReadLock() {
+      if (Store->Flags & KSF_THREAD_SAFE) Store->Lock.unlock_shared();
+   }
+};
+
+class KeyWriteLock {
+   extKeyStore *Store;
+public:
+   KeyWriteLock(extKeyStore *pStore) : Store(pStore) {
+      if (Store->Flags & KSF_THREAD_SAFE) {
+         LockMutex(Store->Mutex, 0x7fffffff);
+         Store->Lock.lock();
+      }
+   }
+   ~KeyWriteLock() {
+      if (Store->Flags & KSF_THREAD_SAFE) {
+         Store->Lock.unlock();
+         UnlockMutex(Store->Mutex);
+      }
+   }
+};
 
 //****************************************************************************
 // Resource management for KeyStore.
@@ -50,7 +111,7 @@ INLINE LONG GET_KEY_SIZE(KeyPair *KP) { return KP->ValueOffset + KP->ValueLength
 static void KeyStore_free(APTR Address)
 {
    parasol::Log log(__FUNCTION__);
-   KeyStore *store = (KeyStore *)Address;
+   auto store = (extKeyStore *)Address;
 
    if (store->Flags & KSF_AUTO_REMOVE) {
       ULONG key = 0;
@@ -64,16 +125,23 @@ static void KeyStore_free(APTR Address)
 
    if (store->Data) {
       for (LONG i=0; i < store->TableSize; i++) {
-         if (store->Data[i]) free((APTR)store->Data[i]);
+         if ((store->Data[i].Pair) AND (store->Data[i].Pair->Flags & KPF_EXTERNAL)) free(store->Data[i].Pair);
       }
       free(store->Data);
       store->Data = NULL;
    }
 
+   while (auto arena = store->Arena) {
+      store->Arena = arena->Next;
+      free(arena);
+   }
+
    if ((store->Flags & KSF_THREAD_SAFE) AND (store->Mutex)) {
       FreeMutex(store->Mutex);
       store->Mutex = NULL;
    }
+
+   store->~extKeyStore();
 }
 
 static ResourceManager glResourceKeyStore = {
@@ -83,38 +151,96 @@ static ResourceManager glResourceKeyStore = {
 
 //****************************************************************************
 
-INLINE LONG hm_hash_index(LONG TableSize, ULONG KeyHash) {
-   ULONG hash = KeyHash * PRIME_HASH; // This operation greatly improves hash distribution with a more even spread.
-   return MOD_TABLESIZE(hash, TableSize);
+INLINE LONG hm_hash_index(extKeyStore *Store, ULONG KeyHash) {
+   return (ULONG)(KeyHash * PRIME_HASH) >> Store->Shift; // Fibonacci hashing takes the best distributed upper bits.
+}
+
+INLINE void set_table_size(extKeyStore *Store, LONG Size) {
+   Store->TableSize = Size;
+   Store->Shift = 32 - __builtin_ctz(Size);
 }
 
 //****************************************************************************
+// Pairs are carved from the current arena block, or recycled from the free list of their size class.
 
-static KeyPair * build_key_pair(KeyStore *Store, CSTRING Key, const void *Value, LONG Length)
+static KeyPair * alloc_pair(extKeyStore *Store, LONG Size)
 {
-   LONG key_len = StrLength(Key) + 1;
+   LONG capacity = (Size + ARENA_GRAIN - 1) & ~(ARENA_GRAIN - 1);
+
    KeyPair *kp;
-   if ((kp = (KeyPair *)malloc(HEAD_SIZE + key_len + Length))) {
-      kp->ValueOffset = HEAD_SIZE + key_len;
-      kp->Flags       = 0;
-      kp->KeyHash     = StrHash(Key, (Store->Flags & KSF_CASE) != 0);
-      kp->ValueLength = Length;
-      CopyMemory(Key, kp + 1, key_len);
-      if (Value) CopyMemory(Value, (STRING)GET_KEY_VALUE(kp), Length);
-      return kp;
+   if (capacity > ARENA_MAX_PAIR) {
+      if (!(kp = (KeyPair *)malloc(capacity))) return NULL;
+      kp->Flags = KPF_EXTERNAL;
    }
-   else return NULL;
+   else {
+      LONG sc = (capacity / ARENA_GRAIN) - 1;
+      if (Store->FreeList[sc]) {
+         kp = (KeyPair *)Store->FreeList[sc];
+         Store->FreeList[sc] = Store->FreeList[sc]->Next;
+      }
+      else {
+         auto arena = Store->Arena;
+         if ((!arena) OR (arena->Used + capacity > arena->Size)) {
+            LONG block_size = arena ? arena->Size * 2 : ARENA_MIN_BLOCK;
+            if (block_size > ARENA_MAX_BLOCK) block_size = ARENA_MAX_BLOCK;
+
+            auto block = (KeyArena *)malloc(sizeof(KeyArena) + block_size);
+            if (!block) return NULL;
+
+            if (arena) { // The tail of the previous block is recycled rather than wasted.
+               LONG remaining = arena->Size - arena->Used;
+               if (remaining >= ARENA_GRAIN) {
+                  auto tail = (KeyFree *)(((UBYTE *)(arena + 1)) + arena->Used);
+                  LONG tail_class = (remaining / ARENA_GRAIN) - 1;
+                  tail->Next = Store->FreeList[tail_class];
+                  Store->FreeList[tail_class] = tail;
+                  arena->Used += (tail_class + 1) * ARENA_GRAIN;
+               }
+            }
+
+            block->Next = arena;
+            block->Size = block_size;
+            block->Used = 0;
+            Store->Arena = arena = block;
+         }
+
+         kp = (KeyPair *)(((UBYTE *)(arena + 1)) + arena->Used);
+         arena->Used += capacity;
+      }
+      kp->Flags = 0;
+   }
+
+   kp->Capacity = capacity;
+   return kp;
 }
 
-static KeyPair * build_hashed_key_pair(KeyStore *Store, ULONG Key, const void *Value, LONG Length)
+static void free_pair(extKeyStore *Store, KeyPair *Pair)
 {
+   if (Pair->Flags & KPF_EXTERNAL) free(Pair);
+   else {
+      LONG sc = (Pair->Capacity / ARENA_GRAIN) - 1;
+      auto node = (KeyFree *)Pair;
+      node->Next = Store->FreeList[sc];
+      Store->FreeList[sc] = node;
+   }
+}
+
+//****************************************************************************
+// Values are aligned to 64 bits.  If Key is NULL then a pre-hashed key-pair is built.
+
+static KeyPair * build_key_pair(extKeyStore *Store, CSTRING Key, ULONG KeyHash, const void *Value, LONG Length, UWORD Flags)
+{
+   LONG key_len = Key ? (StrLength(Key) + 1) : 1;
+   LONG offset = ALIGN64(sizeof(KeyPair) + key_len);
+
    KeyPair *kp;
-   if ((kp = (KeyPair *)malloc(HEAD_SIZE + 1 + Length))) {
-      kp->ValueOffset = HEAD_SIZE + 1;
-      kp->Flags       = KPF_PREHASHED;
-      kp->KeyHash     = Key;
+   if ((kp = alloc_pair(Store, offset + Length))) {
+      kp->ValueOffset = offset;
+      kp->Flags      |= Flags | (Key ? 0 : KPF_PREHASHED);
+      kp->KeyHash     = KeyHash;
       kp->ValueLength = Length;
-      ((UBYTE *)(kp + 1))[0] = 0;
+      if (Key) CopyMemory(Key, kp + 1, key_len);
+      else ((UBYTE *)(kp + 1))[0] = 0;
       if (Value) CopyMemory(Value, (STRING)GET_KEY_VALUE(kp), Length);
       return kp;
    }
@@ -122,131 +248,152 @@ static KeyPair * build_hashed_key_pair(KeyStore *Store, ULONG Key, const void *V
 }
 
 //****************************************************************************
-// Doubles the size of the hashmap, and rehashes all the elements
+// Doubles the size of the table and reinserts all the pairs.  Readers are excluded by the caller, so the old table is
+// released immediately.
 
-static ERROR hm_rehash(KeyStore *Store)
+static ERROR hm_rehash(extKeyStore *Store)
 {
    parasol::Log log(__FUNCTION__);
-   KeyPair **nv;
-   KeyPair **old = Store->Data;
-   LONG old_size = Store->TableSize;
-   LONG new_size = 2 * Store->TableSize; // Doubling the table size ensures that it's always a power of 2.
-
-   log.traceBranch("Store: %p", Store);
-retry:
-   if ((nv = (KeyPair **)malloc(new_size * sizeof(KeyPair **)))) {
-      ClearMemory(nv, new_size * sizeof(KeyPair **));
-      for (LONG i=0; i < old_size; i++) {
-         if (old[i]) {
-            // Check for dead keys during rehashing - these must be removed.
-
-            if (CHECK_DEAD_KEY(old[i])) {
-               free((APTR)old[i]);
-               old[i] = NULL;
-               continue;
-            }
-
-            // Find a place to store this value in the new hashmap.
-
-            LONG index = hm_hash_index(new_size, old[i]->KeyHash);
-            LONG c;
-            for (c=0; c < BUCKET_SIZE; c++) {
-               if (!nv[index]) { // Empty key found.
-                  nv[index] = old[i];
-                  break;
-               }
-               index = MOD_TABLESIZE(index + 1, new_size);
-            }
 
-            if (c >= BUCKET_SIZE) { // Rare case of too many hash collisions - will need to re-expand the list.
-               new_size = new_size * 2;
-               free(nv);
-               goto retry;
-            }
-         }
-      }
+   LONG new_size = Store->TableSize * 2;
+   log.traceBranch("Store: %p, Size: %d", Store, new_size);
 
-      Store->Data = nv;
-      Store->TableSize = new_size;
-      free(old);
+   auto nv = (KeySlot *)calloc(new_size, sizeof(KeySlot));
+   if (!nv) return ERR_AllocMemory;
 
-      return ERR_Okay;
+   auto old = Store->Data;
+   LONG old_size = Store->TableSize;
+   set_table_size(Store, new_size);
+
+   LONG mask = new_size - 1;
+   for (LONG i=0; i < old_size; i++) {
+      if (!old[i].Pair) continue;
+      LONG index = hm_hash_index(Store, old[i].KeyHash);
+      while (nv[index].Pair) index = (index + 1) & mask;
+      nv[index] = old[i];
    }
-   else return ERR_AllocMemory;
+
+   Store->Data = nv;
+   free(old);
+   return ERR_Okay;
 }
 
 //****************************************************************************
-// Used for setting values in the map, this returns the integer of the location to store a new item, or -1.
+// Note: It is presumed that you have checked for duplicates because this routine does not check for an existing key
+// with the same name.
 
-static LONG hm_newkey(KeyStore *Store, KeyPair *KeyPair)
+static LONG hm_put(extKeyStore *Store, KeyPair *Pair)
 {
-   parasol::Log log(__FUNCTION__);
-
-   if (Store->Total >= Store->TableSize / 2) {
-      log.trace("Hashmap is full and requires expansion.");
-      return -1;
+   if ((Store->Total + 1) * 4 > Store->TableSize * 3) {
+      if (hm_rehash(Store) != ERR_Okay) return -1;
    }
 
-   LONG index = hm_hash_index(Store->TableSize, KeyPair->KeyHash);
-   for (LONG i=0; i < BUCKET_SIZE; i++) {
-      if (!Store->Data[index]) return index;
-      index = MOD_TABLESIZE(index + 1, Store->TableSize);
-   }
-   return -1;
+   LONG mask = Store->TableSize - 1;
+   LONG index = hm_hash_index(Store, Pair->KeyHash);
+   while (Store->Data[index].Pair) index = (index + 1) & mask;
+
+   Store->Data[index].KeyHash = Pair->KeyHash;
+   Store->Data[index].Pair    = Pair;
+   Store->Total++;
+   return index;
 }
 
 //****************************************************************************
-// Note: It is presumed that you have checked for duplicates because this routine does not check for an existing key
-// with the same name.
+// Removes a pair and shifts any displaced successors back towards their home slot, so that probe sequences remain
+// unbroken without the need for tombstones.
 
-static LONG hm_put(KeyStore *Store, KeyPair *KeyPair)
+static void hm_remove(extKeyStore *Store, LONG Index)
 {
-   LONG index = hm_newkey(Store, KeyPair); // Find a place to put our value
-   while (index IS -1) {
-      if (hm_rehash(Store) IS ERR_AllocMemory) return -1;
-      index = hm_newkey(Store, KeyPair);
+   free_pair(Store, Store->Data[Index].Pair);
+
+   LONG mask = Store->TableSize - 1;
+   LONG hole = Index;
+   for (LONG i=(hole + 1) & mask; Store->Data[i].Pair; i = (i + 1) & mask) {
+      LONG home = hm_hash_index(Store, Store->Data[i].KeyHash);
+      if (((i - home) & mask) >= ((i - hole) & mask)) { // The hole lies within the probe sequence of this pair
+         Store->Data[hole] = Store->Data[i];
+         hole = i;
+      }
    }
 
-   Store->Data[index] = KeyPair;
-   Store->Total++;
-   return index;
+   Store->Data[hole].KeyHash = 0;
+   Store->Data[hole].Pair    = NULL;
+   Store->Total--;
+}
+
+//****************************************************************************
+
+INLINE ULONG hm_key_hash(extKeyStore *Store, CSTRING Key) {
+   return StrHash(Key, (Store->Flags & KSF_CASE) != 0);
 }
 
 //****************************************************************************
-// Get the index of a key, or -1 if it's not present.  Note: Dead keys are not ignored, so can be returned.
-// This function also breaks immediately if a NULL pointer is found in the bucket.  This is a useful optimisation, but
-// presumes that keys are never removed and that they can only become 'dead'.  Such keys are cleaned up during a rehash.
+// Get the index of a key, or -1 if it's not present.  The table always has at least one empty slot, which terminates
+// the probe.
 
-static LONG hm_get(KeyStore *Store, CSTRING Key)
+static LONG hm_get(extKeyStore *Store, CSTRING Key, ULONG KeyHash)
 {
-   ULONG key_hash = StrHash(Key, (Store->Flags & KSF_CASE) != 0);
-   LONG index = hm_hash_index(Store->TableSize, key_hash);
-   for (LONG i=0; i < BUCKET_SIZE; i++){
-      if (!Store->Data[index]) break;
-      if (Store->Data[index]->KeyHash IS key_hash) {
+   LONG mask = Store->TableSize - 1;
+   for (LONG index = hm_hash_index(Store, KeyHash); Store->Data[index].Pair; index = (index + 1) & mask) {
+      if (Store->Data[index].KeyHash IS KeyHash) {
+         KeyPair *kp = Store->Data[index].Pair;
+         if (kp->Flags & KPF_PREHASHED) continue;
          if (Store->Flags & KSF_CASE) {
-            if (!strcmp(Key, GET_KEY_NAME(Store->Data[index]))) return index;
+            if (!strcmp(Key, GET_KEY_NAME(kp))) return index;
          }
-         else if (!strcasecmp(Key, GET_KEY_NAME(Store->Data[index]))) return index;
+         else if (!strcasecmp(Key, GET_KEY_NAME(kp))) return index;
       }
-      index = MOD_TABLESIZE(index + 1, Store->TableSize);
    }
 
    return -1;
 }
 
-static LONG hm_get_hashed(KeyStore *Store, ULONG Key)
+static LONG hm_get_hashed(extKeyStore *Store, ULONG Key)
 {
-   LONG index = hm_hash_index(Store->TableSize, Key);
-   for (LONG i=0; i < BUCKET_SIZE; i++){
-      if (!Store->Data[index]) break;
-      if (Store->Data[index]->KeyHash IS Key) return index;
-      index = MOD_TABLESIZE(index + 1, Store->TableSize);
+   LONG mask = Store->TableSize - 1;
+   for (LONG index = hm_hash_index(Store, Key); Store->Data[index].Pair; index = (index + 1) & mask) {
+      if (Store->Data[index].KeyHash IS Key) return index;
    }
 
    return -1;
 }
 
+//****************************************************************************
+// Sets the value of a new or existing key.  An existing pair is updated in place if the new value fits its allocation,
+// which keeps the address of the value stable.  If Key is NULL, KeyHash refers to a pre-hashed key.
+
+static KeyPair * hm_set(extKeyStore *Store, CSTRING Key, ULONG KeyHash, const void *Value, LONG Length, UWORD Flags)
+{
+   LONG ki = Key ? hm_get(Store, Key, KeyHash) : hm_get_hashed(Store, KeyHash);
+   if (ki >= 0) {
+      KeyPair *kp = Store->Data[ki].Pair;
+      if (((kp->Flags & KPF_PREHASHED) IS (Key ? 0 : KPF_PREHASHED)) AND (kp->ValueOffset + Length <= (LONG)kp->Capacity)) {
+         if (Key) CopyMemory(Key, kp + 1, StrLength(Key) + 1); // Case-insensitive matches may differ in case
+         if (Value) memmove((APTR)GET_KEY_VALUE(kp), Value, Length); // The value may overlap the existing data
+         kp->ValueLength = Length;
+         kp->Flags = (kp->Flags & (KPF_EXTERNAL|KPF_PREHASHED)) | Flags;
+         return kp;
+      }
+
+      // The value is copied before the existing pair is released, as it may be the source.
+
+      KeyPair *replacement;
+      if (!(replacement = build_key_pair(Store, Key, KeyHash, Value, Length, Flags))) return NULL;
+      free_pair(Store, kp);
+      Store->Data[ki].Pair = replacement;
+      return replacement;
+   }
+   else {
+      KeyPair *kp;
+      if (!(kp = build_key_pair(Store, Key, KeyHash, Value, Length, Flags))) return NULL;
+      if (hm_put(Store, kp) < 0) {
+         free_pair(Store, kp);
+         return NULL;
+      }
+      return kp;
+   }
+}
+
 /*****************************************************************************
 
 -FUNCTION-
@@ -273,55 +420,26 @@ ERROR VarCopy(KeyStore *Source, KeyStore *Dest)
 
    if ((!Source) OR (!Dest)) return ERR_NullArgs;
 
-   if (!Source->Total) return ERR_Okay; // Nothing to be merged
+   if ((!Source->Total) OR (Source IS Dest)) return ERR_Okay; // Nothing to be merged
 
    log.traceBranch("%p to %p", Source, Dest);
 
-   if (Source->Flags & KSF_THREAD_SAFE) LockMutex(Source->Mutex, 0x7fffffff);
-   if (Dest->Flags & KSF_THREAD_SAFE) LockMutex(Dest->Mutex, 0x7fffffff);
+   auto src = (extKeyStore *)Source;
+   auto dest = (extKeyStore *)Dest;
+   KeyReadLock read(src);
+   KeyWriteLock write(dest);
 
-   LONG i;
-   for (i=0; i < Source->TableSize; i++) {
-      if (!Source->Data[i]) continue;
-      if (CHECK_DEAD_KEY(Source->Data[i])) continue;
+   for (LONG i=0; i < src->TableSize; i++) {
+      KeyPair *kp;
+      if (!(kp = src->Data[i].Pair)) continue;
 
-      LONG size = GET_KEY_SIZE(Source->Data[i]);
+      ULONG hash = kp->KeyHash;
+      CSTRING name = GET_KEY_NAME(kp);
+      if ((name) AND ((src->Flags & KSF_CASE) != (dest->Flags & KSF_CASE))) hash = hm_key_hash(dest, name);
 
-      KeyPair *clone = (KeyPair *)malloc(size);
-      if (clone) {
-         CopyMemory(Source->Data[i], clone, size);
-
-         LONG ki;
-         if (Source->Data[i]->Flags & KPF_PREHASHED) {
-            if ((ki = hm_get_hashed(Dest, Source->Data[i]->KeyHash)) >= 0) { // Key already exists.  Replace it.
-               free((APTR)Dest->Data[ki]);
-               Dest->Data[ki] = clone;
-            }
-            else if (hm_put(Dest, clone) < 0) {
-               if (Source->Flags & KSF_THREAD_SAFE) UnlockMutex(Source->Mutex);
-               if (Dest->Flags & KSF_THREAD_SAFE) UnlockMutex(Dest->Mutex);
-               return ERR_AllocMemory;
-            }
-         }
-         else if ((ki = hm_get(Dest, GET_KEY_NAME(Source->Data[i]))) >= 0) { // Key already exists.  Replace it.
-            free((APTR)Dest->Data[ki]);
-            Dest->Data[ki] = clone;
-         }
-         else if (hm_put(Dest, clone) < 0) {
-            if (Source->Flags & KSF_THREAD_SAFE) UnlockMutex(Source->Mutex);
-            if (Dest->Flags & KSF_THREAD_SAFE) UnlockMutex(Dest->Mutex);
-            return ERR_AllocMemory;
-         }
-      }
-      else {
-         if (Source->Flags & KSF_THREAD_SAFE) UnlockMutex(Source->Mutex);
-         if (Dest->Flags & KSF_THREAD_SAFE) UnlockMutex(Dest->Mutex);
-         return ERR_AllocMemory;
-      }
+      if (!hm_set(dest, name, hash, GET_KEY_VALUE(kp), kp->ValueLength, kp->Flags & KPF_STRING)) return ERR_AllocMemory;
    }
 
-   if (Source->Flags & KSF_THREAD_SAFE) UnlockMutex(Source->Mutex);
-   if (Dest->Flags & KSF_THREAD_SAFE) UnlockMutex(Dest->Mutex);
    return ERR_Okay;
 }
 
@@ -356,23 +474,16 @@ ERROR VarGet(KeyStore *Store, CSTRING Name, APTR *Data, LONG *Size)
 
    log.traceBranch("%s", Name);
 
-   if (Store->Flags & KSF_THREAD_SAFE) LockMutex(Store->Mutex, 0x7fffffff);
+   auto store = (extKeyStore *)Store;
+   KeyReadLock lock(store);
 
    LONG ki;
-   if ((ki = hm_get(Store, Name)) >= 0) {
-      if (CHECK_DEAD_KEY(Store->Data[ki])) {
-         if (Store->Flags & KSF_THREAD_SAFE) UnlockMutex(Store->Mutex);
-         return ERR_DoesNotExist;
-      }
-
-      *Data = (APTR)GET_KEY_VALUE(Store->Data[ki]);
-      if (Size) *Size = Store->Data[ki]->ValueLength;
-
-      if (Store->Flags & KSF_THREAD_SAFE) UnlockMutex(Store->Mutex);
+   if ((ki = hm_get(store, Name, hm_key_hash(store, Name))) >= 0) {
+      *Data = (APTR)GET_KEY_VALUE(store->Data[ki].Pair);
+      if (Size) *Size = store->Data[ki].Pair->ValueLength;
       return ERR_Okay;
    }
 
-   if (Store->Flags & KSF_THREAD_SAFE) UnlockMutex(Store->Mutex);
    return ERR_DoesNotExist;
 }
 
@@ -397,24 +508,14 @@ CSTRING VarGetString(KeyStore *Store, CSTRING Key)
 {
    if ((!Key) OR (!*Key) OR (!Store)) return NULL;
 
-   if (Store->Flags & KSF_THREAD_SAFE) LockMutex(Store->Mutex, 0x7fffffff);
+   auto store = (extKeyStore *)Store;
+   KeyReadLock lock(store);
 
    LONG ki;
-   if ((ki = hm_get(Store, Key)) >= 0) {
-      if (Store->Data[ki]->Flags & KPF_STRING) {
-         if (CHECK_DEAD_KEY(Store->Data[ki])) {
-            if (Store->Flags & KSF_THREAD_SAFE) UnlockMutex(Store->Mutex);
-            return NULL;
-         }
-
-         CSTRING val = GET_KEY_VALUE(Store->Data[ki]);
-
-         if (Store->Flags & KSF_THREAD_SAFE) UnlockMutex(Store->Mutex);
-         return val;
-      }
+   if ((ki = hm_get(store, Key, hm_key_hash(store, Key))) >= 0) {
+      if (store->Data[ki].Pair->Flags & KPF_STRING) return GET_KEY_VALUE(store->Data[ki].Pair);
    }
 
-   if (Store->Flags & KSF_THREAD_SAFE) UnlockMutex(Store->Mutex);
    return NULL;
 }
 
@@ -472,35 +573,28 @@ ERROR VarIterate(KeyStore *Store, CSTRING Index, CSTRING *Key, APTR *Data, LONG
 {
    if (!Store) return ERR_NullArgs;
 
-   if (Store->Flags & KSF_THREAD_SAFE) LockMutex(Store->Mutex, 0x7fffffff);
-
-   LONG ki, i;
+   auto store = (extKeyStore *)Store;
+   KeyReadLock lock(store);
 
+   LONG ki;
    if (Index) {
-      ki = hm_get(Store, Index);
-      if (ki < 0) {
-         if (Store->Flags & KSF_THREAD_SAFE) UnlockMutex(Store->Mutex);
-         return ERR_NotFound;
-      }
+      if ((ki = hm_get(store, Index, hm_key_hash(store, Index))) < 0) return ERR_NotFound;
    }
    else ki = -1;
 
-   for (i=ki+1; i < Store->TableSize; i++) {
-      if ((!Store->Data[i]) OR (CHECK_DEAD_KEY(Store->Data[i])) OR (Store->Data[i]->Flags & KPF_PREHASHED)) continue;
+   for (LONG i=ki+1; i < store->TableSize; i++) {
+      KeyPair *kp = store->Data[i].Pair;
+      if ((!kp) OR (kp->Flags & KPF_PREHASHED)) continue;
 
-      if (Key)  *Key = GET_KEY_NAME(Store->Data[i]);
-      if (Data) *Data = (APTR)GET_KEY_VALUE(Store->Data[i]);
-      if (Size) *Size = Store->Data[i]->ValueLength;
-
-      if (Store->Flags & KSF_THREAD_SAFE) UnlockMutex(Store->Mutex);
+      if (Key)  *Key = GET_KEY_NAME(kp);
+      if (Data) *Data = (APTR)GET_KEY_VALUE(kp);
+      if (Size) *Size = kp->ValueLength;
       return ERR_Okay;
    }
 
    if (Key)  *Key = NULL;
    if (Data) *Data = NULL;
    if (Size) *Size = 0;
-
-   if (Store->Flags & KSF_THREAD_SAFE) UnlockMutex(Store->Mutex);
    return ERR_Finished;
 }
 
@@ -513,6 +607,9 @@ Call VarLock() to acquire a key store's internal lock, preventing other threads
 on the resource until the lock is released.  Calls to VarLock() will nest, and each will need to be matched with a call
 to ~VarUnlock().
 
+The lock excludes other threads that modify the key store.  Functions that only read from the key store do not wait
+for the lock, so a locked store can continue to be read concurrently.
+
 The KeyStore must have been allocated with the THREAD_SAFE flag in the call to ~VarNew() in order to enable
 locking functionality.  If not done so, an error of ERR_BadState is returned.
 
@@ -559,28 +656,32 @@ KeyStore * VarNew(LONG InitialSize, LONG Flags)
 {
    parasol::Log log(__FUNCTION__);
 
+   // The table is grown at 75% capacity, so it is sized to hold the hint without an immediate rehash.
+
+   InitialSize += InitialSize / 3;
    if (InitialSize < INITIAL_SIZE) InitialSize = INITIAL_SIZE;
 
    // Ensure that InitialSize is rounded up to a power of 2
 
    InitialSize = 1<<((__builtin_clz(InitialSize-1) ^ 31) + 1);
 
-   KeyStore *vs;
+   extKeyStore *vs;
 
    ERROR error;
    LONG mem_flags = MEM_DATA|MEM_MANAGED;
    if (Flags & KSF_UNTRACKED) mem_flags |= MEM_UNTRACKED;
-   error = AllocMemory(sizeof(KeyStore), mem_flags, (APTR *)&vs, NULL);
-   if (!error) set_memory_manager(vs, &glResourceKeyStore);
+   error = AllocMemory(sizeof(extKeyStore), mem_flags, (APTR *)&vs, NULL);
+   if (!error) {
+      new (vs) extKeyStore();
+      set_memory_manager(vs, &glResourceKeyStore);
+   }
 
    if (error) {
       log.traceWarning("Failed to allocate memory.");
       return NULL;
    }
 
-   if ((vs->Data = (KeyPair **)malloc(InitialSize * sizeof(STRING)))) {
-      ClearMemory(vs->Data, InitialSize * sizeof(STRING));
-
+   if ((vs->Data = (KeySlot *)calloc(InitialSize, sizeof(KeySlot)))) {
       if (Flags & KSF_THREAD_SAFE) {
          if ((error = AllocMutex(ALF_RECURSIVE, &vs->Mutex)) != ERR_Okay) {
             log.traceWarning("AllocMutex() failed: %s", GetErrorMsg(error));
@@ -589,7 +690,7 @@ KeyStore * VarNew(LONG InitialSize, LONG Flags)
          }
       }
 
-      vs->TableSize = InitialSize;
+      set_table_size(vs, InitialSize);
       vs->Total = 0;
       vs->Flags = Flags;
       return vs;
@@ -632,42 +733,19 @@ ERROR VarSetString(KeyStore *Store, CSTRING Key, CSTRING Value)
 
    if (Key[0] IS '+') log.error("The use of '+' to for appending keys is no longer supported: %s", Key);
 
-   if (Store->Flags & KSF_THREAD_SAFE) LockMutex(Store->Mutex, 0x7fffffff);
+   auto store = (extKeyStore *)Store;
+   KeyWriteLock lock(store);
 
-   LONG ki;
-   if ((ki = hm_get(Store, Key)) >= 0) { // Key already exists.  Replace it.
-      if (!Value) { // Client request to delete the key, so mark it as dead and return.
-         DEAD_KEY(Store->Data[ki]);
-         if (Store->Flags & KSF_THREAD_SAFE) UnlockMutex(Store->Mutex);
-         return ERR_Okay;
-      }
+   ULONG hash = hm_key_hash(store, Key);
 
-      // Free the existing key-pair and replace it with a new one.
-
-      KeyPair *kp = build_key_pair(Store, Key, Value, StrLength(Value) + 1);
-      if (kp) {
-         kp->Flags |= KPF_STRING;
-         free((APTR)Store->Data[ki]);
-         Store->Data[ki] = kp;
-         if (Store->Flags & KSF_THREAD_SAFE) UnlockMutex(Store->Mutex);
-         return ERR_Okay;
-      }
-   }
-   else if (!Value) { // Client requested deletion of a key that doesn't exist - ignore it.
-      if (Store->Flags & KSF_THREAD_SAFE) UnlockMutex(Store->Mutex);
+   if (!Value) { // Client request to delete the key.  Keys that do not exist are ignored.
+      LONG ki;
+      if ((ki = hm_get(store, Key, hash)) >= 0) hm_remove(store, ki);
       return ERR_Okay;
    }
-   else { // Brand new key
-      KeyPair *kp = build_key_pair(Store, Key, Value, StrLength(Value) + 1);
-      if ((kp) AND ((ki = hm_put(Store, kp)) >= 0)) {
-         kp->Flags |= KPF_STRING;
-         if (Store->Flags & KSF_THREAD_SAFE) UnlockMutex(Store->Mutex);
-         return ERR_Okay;
-      }
-   }
 
-   if (Store->Flags & KSF_THREAD_SAFE) UnlockMutex(Store->Mutex);
-   return ERR_AllocMemory;
+   if (hm_set(store, Key, hash, Value, StrLength(Value) + 1, KPF_STRING)) return ERR_Okay;
+   else return ERR_AllocMemory;
 }
 
 /*****************************************************************************
@@ -680,8 +758,7 @@ The VarSet() function will copy a key-value pair to a KeyStore resource.  The st
 ~VarGetString() function.
 
 If the Data pointer is NULL, any existing key with a matching name will be removed and this function will return
-immediately.  Removing a key in this way maintains the existing state of the key store, which means that keys can
-be removed in a loop without concern for the key data pointers being rearranged.
+immediately.  Removing a key does not move the data of any other key, so pointers to existing values remain valid.
 
 Note that the contents of Data will be copied to the KeyStore.  If the data is stored elsewhere in a permanent area
 that will outlast the KeyStore, consider storing a pointer or index instead as this will prevent unnecessary
@@ -707,40 +784,22 @@ APTR VarSet(KeyStore *Store, CSTRING Key, APTR Data, LONG Size)
 
    log.traceBranch("%p: %s = %p", Store, Key, Data);
 
-   if (Store->Flags & KSF_THREAD_SAFE) LockMutex(Store->Mutex, 0x7fffffff);
-
-   LONG ki;
-   if ((ki = hm_get(Store, Key)) >= 0) { // Key already exists.  Replace it.
-      if (!Data) { // Client request to delete the key, so mark it as dead and return.
-         DEAD_KEY(Store->Data[ki]);
-         if (Store->Flags & KSF_THREAD_SAFE) UnlockMutex(Store->Mutex);
-         return NULL;
-      }
+   auto store = (extKeyStore *)Store;
+   KeyWriteLock lock(store);
 
-      // Free the existing key-pair and replace it with a new one.
+   ULONG hash = hm_key_hash(store, Key);
 
-      KeyPair *kp = build_key_pair(Store, Key, Data, Size);
-      if (kp) {
-         free((APTR)Store->Data[ki]);
-         Store->Data[ki] = kp;
-         if (Store->Flags & KSF_THREAD_SAFE) UnlockMutex(Store->Mutex);
-         return (APTR)GET_KEY_VALUE(kp);
-      }
-   }
-   else if (!Data) { // Client requested deletion of a key that doesn't exist - ignore it.
-      if (Store->Flags & KSF_THREAD_SAFE) UnlockMutex(Store->Mutex);
+   if (!Data) { // Client request to delete the key.  Keys that do not exist are ignored.
+      LONG ki;
+      if ((ki = hm_get(store, Key, hash)) >= 0) hm_remove(store, ki);
       return NULL;
    }
-   else { // Brand new key
-      KeyPair *kp = build_key_pair(Store, Key, Data, Size);
-      if ((kp) AND ((ki = hm_put(Store, kp)) >= 0)) {
-         if (Store->Flags & KSF_THREAD_SAFE) UnlockMutex(Store->Mutex);
-         return (APTR)GET_KEY_VALUE(kp);
-      }
-   }
 
-   if (Store->Flags & KSF_THREAD_SAFE) UnlockMutex(Store->Mutex);
-   return NULL;
+   KeyPair *kp;
+   if ((kp = hm_set(store, Key, hash, Data, Size, 0))) {
+      return (APTR)GET_KEY_VALUE(kp);
+   }
+   else return NULL;
 }
 
 /*****************************************************************************
@@ -778,34 +837,16 @@ ERROR VarSetSized(KeyStore *Store, CSTRING Key, LONG Size, APTR *Data, LONG *Dat
 
    log.traceBranch("%p: %s, Size: %d", Store, Key, Size);
 
-   if (Store->Flags & KSF_THREAD_SAFE) LockMutex(Store->Mutex, 0x7fffffff);
+   auto store = (extKeyStore *)Store;
+   KeyWriteLock lock(store);
 
-   LONG ki;
-   if ((ki = hm_get(Store, Key)) >= 0) { // Key already exists.  Replace it.
-      // Free the existing key-pair and replace it with a new one.
-
-      KeyPair *kp = build_key_pair(Store, Key, NULL, Size);
-      if (kp) {
-         free((APTR)Store->Data[ki]);
-         Store->Data[ki] = kp;
-         if (Store->Flags & KSF_THREAD_SAFE) UnlockMutex(Store->Mutex);
-         *Data = (APTR)GET_KEY_VALUE(kp);
-         if (DataSize) *DataSize = Size;
-         return ERR_Okay;
-      }
-   }
-   else { // Brand new key
-      KeyPair *kp = build_key_pair(Store, Key, NULL, Size);
-      if ((kp) AND ((ki = hm_put(Store, kp)) >= 0)) {
-         if (Store->Flags & KSF_THREAD_SAFE) UnlockMutex(Store->Mutex);
-         *Data = (APTR)GET_KEY_VALUE(kp);
-         if (DataSize) *DataSize = Size;
-         return ERR_Okay;
-      }
+   KeyPair *kp;
+   if ((kp = hm_set(store, Key, hm_key_hash(store, Key), NULL, Size, 0))) {
+      *Data = (APTR)GET_KEY_VALUE(kp);
+      if (DataSize) *DataSize = Size;
+      return ERR_Okay;
    }
-
-   if (Store->Flags & KSF_THREAD_SAFE) UnlockMutex(Store->Mutex);
-   return ERR_AllocMemory;
+   else return ERR_AllocMemory;
 }
 
 /*****************************************************************************
@@ -851,22 +892,16 @@ ERROR KeyGet(KeyStore *Store, ULONG Key, APTR *Data, LONG *Size)
 {
    if ((!Store) OR (!Data)) return ERR_NullArgs;
 
-   if (Store->Flags & KSF_THREAD_SAFE) LockMutex(Store->Mutex, 0x7fffffff);
+   auto store = (extKeyStore *)Store;
+   KeyReadLock lock(store);
 
    LONG ki;
-   if ((ki = hm_get_hashed(Store, Key)) >= 0) {
-      if (CHECK_DEAD_KEY(Store->Data[ki])) {
-         if (Store->Flags & KSF_THREAD_SAFE) UnlockMutex(Store->Mutex);
-         return ERR_DoesNotExist;
-      }
-
-      *Data = (APTR)GET_KEY_VALUE(Store->Data[ki]);
-      if (Size) *Size = Store->Data[ki]->ValueLength;
-      if (Store->Flags & KSF_THREAD_SAFE) UnlockMutex(Store->Mutex);
+   if ((ki = hm_get_hashed(store, Key)) >= 0) {
+      *Data = (APTR)GET_KEY_VALUE(store->Data[ki].Pair);
+      if (Size) *Size = store->Data[ki].Pair->ValueLength;
       return ERR_Okay;
    }
 
-   if (Store->Flags & KSF_THREAD_SAFE) UnlockMutex(Store->Mutex);
    return ERR_DoesNotExist;
 }
 
@@ -922,35 +957,28 @@ ERROR KeyIterate(KeyStore *Store, ULONG Index, ULONG *Key, APTR *Data, LONG *Siz
 {
    if (!Store) return ERR_NullArgs;
 
-   if (Store->Flags & KSF_THREAD_SAFE) LockMutex(Store->Mutex, 0x7fffffff);
-
-   LONG ki, i;
+   auto store = (extKeyStore *)Store;
+   KeyReadLock lock(store);
 
+   LONG ki;
    if (Index) {
-      ki = hm_get_hashed(Store, Index);
-      if (ki < 0) {
-         if (Store->Flags & KSF_THREAD_SAFE) UnlockMutex(Store->Mutex);
-         return ERR_NotFound;
-      }
+      if ((ki = hm_get_hashed(store, Index)) < 0) return ERR_NotFound;
    }
    else ki = -1;
 
-   for (i=ki+1; i < Store->TableSize; i++) {
-      if ((!Store->Data[i]) OR (CHECK_DEAD_KEY(Store->Data[i]))) continue;
-
-      if (Key)  *Key = Store->Data[i]->KeyHash;
-      if (Data) *Data = (APTR)GET_KEY_VALUE(Store->Data[i]);
-      if (Size) *Size = Store->Data[i]->ValueLength;
+   for (LONG i=ki+1; i < store->TableSize; i++) {
+      KeyPair *kp = store->Data[i].Pair;
+      if (!kp) continue;
 
-      if (Store->Flags & KSF_THREAD_SAFE) UnlockMutex(Store->Mutex);
+      if (Key)  *Key = kp->KeyHash;
+      if (Data) *Data = (APTR)GET_KEY_VALUE(kp);
+      if (Size) *Size = kp->ValueLength;
       return ERR_Okay;
    }
 
    if (Key)  *Key = 0;
    if (Data) *Data = NULL;
    if (Size) *Size = 0;
-
-   if (Store->Flags & KSF_THREAD_SAFE) UnlockMutex(Store->Mutex);
    return ERR_Finished;
 }
 
@@ -990,43 +1018,18 @@ ERROR KeySet(KeyStore *Store, ULONG Key, const void *Data, LONG Size)
 {
    if (!Store) return ERR_NullArgs;
 
-   if (Store->Flags & KSF_THREAD_SAFE) LockMutex(Store->Mutex, 0x7fffffff);
+   auto store = (extKeyStore *)Store;
+   KeyWriteLock lock(store);
 
-   LONG ki;
-   if ((ki = hm_get_hashed(Store, Key)) >= 0) { // Key already exists.  Replace it.
-      if (!Data) { // Client request to delete the key, so mark it as dead and return.
-         DEAD_KEY(Store->Data[ki]);
-         if (Store->Flags & KSF_THREAD_SAFE) UnlockMutex(Store->Mutex);
-         return ERR_Okay;
-      }
+   LONG ki = hm_get_hashed(store, Key);
 
-      // Free the existing key-pair and replace it with a new one.
-
-      KeyPair *kp = build_hashed_key_pair(Store, Key, Data, Size);
-      if (kp) {
-         free((APTR)Store->Data[ki]);
-         Store->Data[ki] = kp;
-         if (Store->Flags & KSF_THREAD_SAFE) UnlockMutex(Store->Mutex);
-         return ERR_Okay;
-      }
-   }
-   else if (!Data) { // Client requested deletion of a key that doesn't exist - ignore it.
-      if (Store->Flags & KSF_THREAD_SAFE) UnlockMutex(Store->Mutex);
+   if (!Data) { // Client request to delete the key.  Keys that do not exist are ignored.
+      if (ki >= 0) hm_remove(store, ki);
       return ERR_Okay;
    }
-   else { // Brand new key
-      if ((Size > 64 * 1024) OR (Size < 0)) {
-         if (Store->Flags & KSF_THREAD_SAFE) UnlockMutex(Store->Mutex);
-         return ERR_DataSize;
-      }
 
-      KeyPair *kp = build_hashed_key_pair(Store, Key, Data, Size);
-      if ((kp) AND ((ki = hm_put(Store, kp)) >= 0)) {
-         if (Store->Flags & KSF_THREAD_SAFE) UnlockMutex(Store->Mutex);
-         return ERR_Okay;
-      }
-   }
+   if ((ki < 0) AND ((Size > 64 * 1024) OR (Size < 0))) return ERR_DataSize;
 
-   if (Store->Flags & KSF_THREAD_SAFE) UnlockMutex(Store->Mutex);
-   return ERR_AllocMemory;
+   if (hm_set(store, NULL, Key, Data, Size, 0)) return ERR_Okay;
+   else return ERR_AllocMemory;
 }
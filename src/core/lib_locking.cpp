@@ -315,6 +315,18 @@ void cond_wake_all(UBYTE Index)
 
 #endif
 
+//****************************************************************************
+// Wakes threads sleeping in AccessMemory() on a private memory block.  TL_PRIVATE_MEM is only acquired if a thread has
+// registered itself in glPrivateMemWaiters, so uncontended releases never touch the global lock.
+
+void wake_private_waiters(void)
+{
+   if (__atomic_load_n(&glPrivateMemWaiters, __ATOMIC_SEQ_CST) > 0) {
+      ThreadLock lock(TL_PRIVATE_MEM, 4000);
+      if (lock.granted()) cond_wake_all(CN_PRIVATE_MEM);
+   }
+}
+
 //****************************************************************************
 // Note: This function must be called in a LOCK_PUBLIC_MEMORY() zone.
 //
@@ -1053,39 +1065,60 @@ ERROR AccessMemory(MEMORYID MemoryID, LONG Flags, LONG MilliSeconds, APTR *Resul
       else return log.warning(ERR_SystemLocked);
    }
    else {
-      ThreadLock lock(TL_PRIVATE_MEM, 4000);
-      if (lock.granted()) {
-         auto mem = glPrivateMemory.find(MemoryID);
-         if (mem != glPrivateMemory.end()) {
-            LONG thread_id = get_thread_id();
-            // This loop looks odd, but will prevent sleeping if we already have a lock on the memory.
-            // cond_wait() will be met with a global wake-up, not necessarily on the desired block, hence the need for while().
-
-            LARGE end_time = (PreciseTime() / 1000LL) + MilliSeconds;
-            ERROR error = ERR_TimeOut;
-            while ((mem->second.AccessCount > 0) and (mem->second.ThreadLockID != thread_id)) {
-               LONG timeout = end_time - (PreciseTime() / 1000LL);
-               if (timeout <= 0) {
-                  return log.warning(ERR_TimeOut);
-               }
-               else {
-                  //log.msg("Sleep on memory #%d, Access %d, Threads %d/%d", MemoryID, mem->second.AccessCount, (LONG)mem->second.ThreadLockID, thread_id);
-                  if ((error = cond_wait(TL_PRIVATE_MEM, CN_PRIVATE_MEM, timeout))) {
-                     return log.warning(error);
-                  }
-               }
-            }
+      // The record is protected by its shard lock.  An uncontended lock is granted without touching TL_PRIVATE_MEM,
+      // which is only needed when the thread has to sleep on CN_PRIVATE_MEM.
+
+      auto &shard = glPrivateMemory.shard(MemoryID);
+      std::unique_lock shard_lock(shard.Lock);
+      auto mem = shard.Map.find(MemoryID);
+      if ((mem IS shard.Map.end()) or (!mem->second.Address)) {
+         shard_lock.unlock();
+         log.traceWarning("Cannot find private memory ID #%d", MemoryID); // This is not uncommon, so trace only
+         return ERR_MemoryDoesNotExist;
+      }
 
-            mem->second.ThreadLockID = thread_id;
-            __sync_fetch_and_add(&mem->second.AccessCount, 1);
-            tlPrivateLockCount++;
+      LONG thread_id = get_thread_id();
+      if ((mem->second.AccessCount > 0) and (mem->second.ThreadLockID != thread_id)) {
+         shard_lock.unlock();
+
+         ThreadLock lock(TL_PRIVATE_MEM, 4000);
+         if (!lock.granted()) return log.warning(ERR_SystemLocked);
+
+         // Registering as a waiter before re-checking the record guarantees that ReleaseMemory() will see us and
+         // send a wake-up.  cond_wait() will be met with a global wake-up, not necessarily on the desired block,
+         // hence the need for while().
+
+         __sync_fetch_and_add(&glPrivateMemWaiters, 1);
+         LARGE end_time = (PreciseTime() / 1000LL) + MilliSeconds;
+         ERROR error = ERR_Okay;
+         shard_lock.lock();
+         while (true) {
+            mem = shard.Map.find(MemoryID);
+            if ((mem IS shard.Map.end()) or (!mem->second.Address)) { error = ERR_MemoryDoesNotExist; break; }
+            if ((mem->second.AccessCount <= 0) or (mem->second.ThreadLockID IS thread_id)) break;
+
+            shard_lock.unlock();
+            LONG timeout = end_time - (PreciseTime() / 1000LL);
+            if (timeout <= 0) error = ERR_TimeOut;
+            else error = cond_wait(TL_PRIVATE_MEM, CN_PRIVATE_MEM, timeout);
+            if (error) break;
+            shard_lock.lock();
+         }
+         __sync_fetch_and_sub(&glPrivateMemWaiters, 1);
 
-            *Result = mem->second.Address;
-            return ERR_Okay;
+         if (error) {
+            if (shard_lock.owns_lock()) shard_lock.unlock();
+            if (error IS ERR_MemoryDoesNotExist) return error;
+            else return log.warning(error);
          }
-         else log.traceWarning("Cannot find private memory ID #%d", MemoryID); // This is not uncommon, so trace only
       }
-      else return log.warning(ERR_SystemLocked);
+
+      mem->second.ThreadLockID = thread_id;
+      __sync_fetch_and_add(&mem->second.AccessCount, 1);
+      tlPrivateLockCount++;
+
+      *Result = mem->second.Address;
+      return ERR_Okay;
    }
 
    return ERR_MemoryDoesNotExist;
@@ -1142,10 +1175,9 @@ ERROR AccessObject(OBJECTID ObjectID, LONG MilliSeconds, OBJECTPTR *Result)
    if (MilliSeconds <= 0) log.warning("Object: %d, MilliSeconds: %d - This is bad practice.", ObjectID, MilliSeconds);
 
    if (ObjectID > 0) {
-      auto mem = glPrivateMemory.find(ObjectID);
-      if (mem != glPrivateMemory.end()) {
-         if (!(error = AccessPrivateObject((OBJECTPTR)mem->second.Address, MilliSeconds))) {
-            *Result = (OBJECTPTR)mem->second.Address;
+      if ((obj = find_private_object(ObjectID))) {
+         if (!(error = AccessPrivateObject(obj, MilliSeconds))) {
+            *Result = obj;
             return ERR_Okay;
          }
          else return error;
@@ -1270,39 +1302,39 @@ ERROR AccessPrivateObject(OBJECTPTR Object, LONG Timeout)
 
    LONG our_thread = get_thread_id();
 
-   do {
-      // Using an atomic increment we can achieve a 'quick lock' of the object without having to resort to locks.
-      // This is quite safe so long as the developer is being careful with use of the object between threads (i.e. not
-      // destroying the object when other threads could potentially be using it).
+   // A compare-and-swap on the queue gives us a 'quick lock' of an unlocked object without having to resort to
+   // locks.  Unlike an increment, a failed attempt leaves the queue untouched, so only the thread holding the lock
+   // ever modifies a non-zero queue.  This is quite safe so long as the developer is being careful with use of the
+   // object between threads (i.e. not destroying the object when other threads could potentially be using it).
+
+   if (LOCK_QUEUE(Object)) {
+      Object->Locked = 1;
+      Object->ThreadID = our_thread;
+      return ERR_Okay;
+   }
 
-      if (INC_QUEUE(Object) IS 1) {
-         /*if (Object->Flags & NF_FREE) { // Disallow access to objects being freed.
-            SUB_QUEUE(Object);
-            return ERR_MarkedForDeletion;
-         }*/
+   if (our_thread IS Object->ThreadID) { // Support nested locks.
+      INC_QUEUE(Object);
+      return ERR_Okay;
+   }
+
+   // Locks are typically held for a short period, so spin briefly before resorting to a sleep.
+
+   for (LONG spin=0; spin < 64; spin++) {
+      if ((!Object->Queue) and (LOCK_QUEUE(Object))) {
          Object->Locked = 1;
          Object->ThreadID = our_thread;
          return ERR_Okay;
       }
-
-      if (our_thread IS Object->ThreadID) { // Support nested locks.
-         /*if (Object->Flags & NF_FREE) { // Disallow access to objects being freed.
-            SUB_QUEUE(Object);
-            return ERR_MarkedForDeletion;
-         }*/
-         return ERR_Okay;
-      }
-
-      // Problem: If a ReleaseObject() were to occur inside this loop area, it receives a queue value of 1 instead of
-      //    zero.  As a result it would not send a signal, because it mistakenly thinks it still has a lock.
-      // Solution: When restoring the queue, we check for zero.  If true, we try to re-lock because we know that the
-      //    object is free.  By not sleeping, we don't have to be concerned about the missing signal.
-   } while (SUB_QUEUE(Object) IS 0); // Make a correction because we didn't obtain the lock.  Repeat loop if the object lock is at zero (available).
+      #if defined(__x86_64__) || defined(__i386__)
+         __builtin_ia32_pause();
+      #endif
+   }
 
    if (Object->Flags & (NF_FREE|NF_UNLOCK_FREE)) return ERR_MarkedForDeletion; // If the object is currently being removed by another thread, sleeping on it is pointless.
 
    // Problem: What if ReleaseObject() in another thread were to release the object prior to our TL_PRIVATE_OBJECTS lock?  This means that we would never receive the wake signal.
-   // Solution: Prior to cond_wait(), increment the object queue to attempt a lock.  This is *slightly* less efficient than doing it after the cond_wait(), but
+   // Solution: Prior to cond_wait(), attempt to lock the object queue.  This is *slightly* less efficient than doing it after the cond_wait(), but
    //           it will prevent us from sleeping on a signal that we would never receive.
 
    LARGE end_time, current_time;
@@ -1333,18 +1365,17 @@ ERROR AccessPrivateObject(OBJECTPTR Object, LONG Timeout)
                return ERR_DoesNotExist;
             }
 
-            if (INC_QUEUE(Object) IS 1) { // Increment the lock count - also doubles as a prv_access() call if the lock value is 1.
+            if (LOCK_QUEUE(Object)) {
                locks[wl].WaitingForResourceID   = 0;
                locks[wl].WaitingForResourceType = 0;
                locks[wl].WaitingForProcessID    = 0;
                locks[wl].WaitingForThreadID     = 0;
                locks[wl].Flags = 0;
-               Object->Locked = 0;
+               Object->Locked = 1;
                Object->ThreadID = our_thread;
                SUB_SLEEP(Object);
                return ERR_Okay;
             }
-            else SUB_QUEUE(Object);
 
             cond_wait(TL_PRIVATE_OBJECTS, CN_OBJECTS, tmout);
          } // end while()
@@ -1720,56 +1751,57 @@ MEMORYID ReleaseMemory(APTR Address)
 
    // Address was not found in the public memory list - drop through to private list
 
-   if (((LONG *)Address)[-1] != CODE_MEMH) {
+   if ((((LONG *)Address)[-1] != CODE_MEMH) and (((LONG *)Address)[-1] != CODE_MEMS)) {
       log.warning("Address %p is not a recognised address, or the header is corrupt.", Address);
       return 0;
    }
 
-   ThreadLock lock(TL_PRIVATE_MEM, 4000);
-   if (lock.granted()) {
-      auto mem = glPrivateMemory.find(((LONG *)Address)[-2]);
+   auto &shard = glPrivateMemory.shard(((LONG *)Address)[-2]);
+   std::unique_lock lock(shard.Lock);
+   auto mem = shard.Map.find(((LONG *)Address)[-2]);
 
-      if (mem IS glPrivateMemory.end()) {
-         if (tlContext->Object->Class) log.warning("Unable to find a record for memory address %p, ID %d [Context %d, Class %s].", Address, ((LONG *)Address)[-2], tlContext->Object->UniqueID, ((rkMetaClass *)tlContext->Object->Class)->ClassName);
-         else log.warning("Unable to find a record for memory address %p.", Address);
-         if (glLogLevel > 1) PrintDiagnosis(glProcessID, 0);
-         return 0;
-      }
+   if ((mem IS shard.Map.end()) or (!mem->second.Address)) {
+      lock.unlock();
+      if (tlContext->Object->Class) log.warning("Unable to find a record for memory address %p, ID %d [Context %d, Class %s].", Address, ((LONG *)Address)[-2], tlContext->Object->UniqueID, ((rkMetaClass *)tlContext->Object->Class)->ClassName);
+      else log.warning("Unable to find a record for memory address %p.", Address);
+      if (glLogLevel > 1) PrintDiagnosis(glProcessID, 0);
+      return 0;
+   }
 
-      id = mem->second.MemoryID;
+   id = mem->second.MemoryID;
 
-      WORD access;
-      if (mem->second.AccessCount > 0) { // Sometimes ReleaseMemory() is called on private addresses that aren't actually locked.  This is OK - we simply don't do anything in that case.
-         access = __sync_sub_and_fetch(&mem->second.AccessCount, 1);
-         tlPrivateLockCount--;
-      }
-      else access = -1;
+   WORD access;
+   if (mem->second.AccessCount > 0) { // Sometimes ReleaseMemory() is called on private addresses that aren't actually locked.  This is OK - we simply don't do anything in that case.
+      access = __sync_sub_and_fetch(&mem->second.AccessCount, 1);
+      tlPrivateLockCount--;
+   }
+   else access = -1;
 
-      #ifdef DBG_LOCKS
-         log.trace("MemoryID: %d, Address: %p, Locks: %d", id, Address, access);
+   bool free_block = false;
+   if (!access) {
+      #ifdef __unix__
+         mem->second.ThreadLockID = 0; // This is more for peace of mind (it's the access count that matters)
       #endif
 
-      if (!access) {
-         #ifdef __unix__
-            mem->second.ThreadLockID = 0; // This is more for peace of mind (it's the access count that matters)
-         #endif
+      if (mem->second.Flags & MEM_DELETE) free_block = true;
+      else if (mem->second.Flags & MEM_EXCLUSIVE) mem->second.Flags &= ~MEM_EXCLUSIVE;
+   }
 
-         if (mem->second.Flags & MEM_DELETE) {
-            log.trace("Deleting marked private memory block #%d (MEM_DELETE)", id);
-            FreeResource(mem->second.Address); // NB: The block entry will no longer be valid from this point onward
-            cond_wake_all(CN_PRIVATE_MEM); // Wake up any threads sleeping on this memory block.
-            return id;
-         }
-         else if (mem->second.Flags & MEM_EXCLUSIVE) {
-            mem->second.Flags &= ~MEM_EXCLUSIVE;
-         }
+   lock.unlock(); // Nothing is logged while the shard is held
 
-         cond_wake_all(CN_PRIVATE_MEM); // Wake up any threads sleeping on this memory block.
-      }
+   #ifdef DBG_LOCKS
+      log.trace("MemoryID: %d, Address: %p, Locks: %d", id, Address, access);
+   #endif
 
-      return id;
+   if (!access) {
+      if (free_block) {
+         log.trace("Deleting marked private memory block #%d (MEM_DELETE)", id);
+         FreeResource(Address); // NB: The block entry will no longer be valid from this point onward
+      }
+      wake_private_waiters(); // Wake up any threads sleeping on this memory block.
    }
-   else return 0;
+
+   return id;
 }
 
 /*****************************************************************************
@@ -1908,49 +1940,50 @@ ERROR ReleaseMemoryID(MEMORYID MemoryID)
       }
    }
    else {
-      ThreadLock lock(TL_PRIVATE_MEM, 4000);
-      if (lock.granted()) {
-         auto mem = glPrivateMemory.find(MemoryID);
-
-         if (mem IS glPrivateMemory.end()) {
-            if (tlContext->Object->Class) log.warning("Unable to find a record for memory address #%d [Context %d, Class %s].", MemoryID, tlContext->Object->UniqueID, ((rkMetaClass *)tlContext->Object->Class)->ClassName);
-            else log.warning("Unable to find a record for memory #%d.", MemoryID);
-            if (glLogLevel > 1) PrintDiagnosis(glProcessID, 0);
-            return ERR_Search;
-         }
+      auto &shard = glPrivateMemory.shard(MemoryID);
+      std::unique_lock lock(shard.Lock);
+      auto mem = shard.Map.find(MemoryID);
+
+      if ((mem IS shard.Map.end()) or (!mem->second.Address)) {
+         lock.unlock();
+         if (tlContext->Object->Class) log.warning("Unable to find a record for memory address #%d [Context %d, Class %s].", MemoryID, tlContext->Object->UniqueID, ((rkMetaClass *)tlContext->Object->Class)->ClassName);
+         else log.warning("Unable to find a record for memory #%d.", MemoryID);
+         if (glLogLevel > 1) PrintDiagnosis(glProcessID, 0);
+         return ERR_Search;
+      }
 
-         WORD access;
-         if (mem->second.AccessCount > 0) { // Sometimes ReleaseMemory() is called on private addresses that aren't actually locked.  This is OK - we simply don't do anything in that case.
-            access = __sync_sub_and_fetch(&mem->second.AccessCount, 1);
-            tlPrivateLockCount--;
-         }
-         else access = -1;
+      WORD access;
+      if (mem->second.AccessCount > 0) { // Sometimes ReleaseMemory() is called on private addresses that aren't actually locked.  This is OK - we simply don't do anything in that case.
+         access = __sync_sub_and_fetch(&mem->second.AccessCount, 1);
+         tlPrivateLockCount--;
+      }
+      else access = -1;
 
-         #ifdef DBG_LOCKS
-            log.function("MemoryID: %d, Locks: %d", MemoryID, access);
+      APTR free_address = NULL;
+      if (!access) {
+         #ifdef __unix__
+            mem->second.ThreadLockID = 0; // This is more for peace of mind (it's the access count that matters)
          #endif
 
-         if (!access) {
-            #ifdef __unix__
-               mem->second.ThreadLockID = 0; // This is more for peace of mind (it's the access count that matters)
-            #endif
+         if (mem->second.Flags & MEM_DELETE) free_address = mem->second.Address;
+         else if (mem->second.Flags & MEM_EXCLUSIVE) mem->second.Flags &= ~MEM_EXCLUSIVE;
+      }
 
-            if (mem->second.Flags & MEM_DELETE) {
-               log.trace("Deleting marked private memory block #%d (MEM_DELETE)", MemoryID);
-               FreeResource(mem->second.Address);
-               cond_wake_all(CN_PRIVATE_MEM); // Wake up any threads sleeping on this memory block.
-               return ERR_Okay;
-            }
-            else if (mem->second.Flags & MEM_EXCLUSIVE) {
-               mem->second.Flags &= ~MEM_EXCLUSIVE;
-            }
+      lock.unlock(); // Nothing is logged while the shard is held
 
-            cond_wake_all(CN_PRIVATE_MEM); // Wake up any threads sleeping on this memory block.
-         }
+      #ifdef DBG_LOCKS
+         log.function("MemoryID: %d, Locks: %d", MemoryID, access);
+      #endif
 
-         return ERR_Okay;
+      if (!access) {
+         if (free_address) {
+            log.trace("Deleting marked private memory block #%d (MEM_DELETE)", MemoryID);
+            FreeResource(free_address);
+         }
+         wake_private_waiters(); // Wake up any threads sleeping on this memory block.
       }
-      else return log.warning(ERR_SystemLocked);
+
+      return ERR_Okay;
    }
 }
 
@@ -2077,12 +2110,19 @@ void ReleasePrivateObject(OBJECTPTR Object)
       }
    #endif
 
-   // If the queue reaches zero, check if there are other threads sleeping on this object.  If so, use a signal to
-   // wake at least one of them.
+   // Only the thread holding the lock modifies a non-zero queue, so nested releases require no further checks.
+
+   if (Object->Queue > 1) {
+      SUB_QUEUE(Object);
+      return;
+   }
 
-   if (SUB_QUEUE(Object) > 0) return;
+   // The lock state is cleared before the queue reaches zero, otherwise it could overwrite the state of the next
+   // thread to acquire the object.  If there are other threads sleeping on this object then use a signal to wake at
+   // least one of them.
 
    Object->Locked = 0;
+   SUB_QUEUE(Object);
 
    if (Object->SleepQueue > 0) {
       #ifdef DEBUG
@@ -35,13 +35,19 @@ Name: Memory
 
 using namespace parasol;
 
-static void compress_public_memory(SharedControl *);
 #ifdef RANDOMISE_MEM
 static void randomise_memory(UBYTE *, ULONG Size);
 #else
 #define randomise_memory(a,b)
 #endif
 
+static LONG alloc_public_slot(void);
+static void insert_sorted_block(MEMORYID, LONG);
+#ifndef USE_SHM
+static LONG pool_alloc(LONG);
+static void pool_free(LONG);
+#endif
+
 extern LONG glPageSize;
 
 #ifdef __unix__
@@ -80,6 +86,275 @@ static void randomise_memory(UBYTE *Address, ULONG Size)
 }
 #endif
 
+//****************************************************************************
+// Private objects are indexed by ID in an open-addressed table that readers search without taking a lock.  Writers are
+// serialised by glObjectTableLock.  A slot is filled by writing the object address before the ID, and emptied by
+// overwriting the ID with OT_REMOVED before the address is cleared.  Readers confirm that the ID is unchanged after
+// reading the address, and because object IDs are never reused, a confirmed read cannot belong to a different object.
+//
+// The table is replaced when it fills with live or removed entries.  Each thread that reads the table owns a hazard
+// slot on its own cache line, in which it publishes the table that it is searching.  A replaced table is released by
+// the next writer that finds it absent from every hazard slot.  A thread can only protect one table at a time, so no
+// more tables can be waiting for release than there are reading threads.
+
+#define OT_REMOVED -1
+#define OT_MIN_SIZE 256 // Must be a power of 2
+
+struct ObjectSlot {
+   OBJECTID  ID;      // Zero if the slot has never been used
+   OBJECTPTR Object;
+};
+
+struct ObjectTable {
+   ObjectTable *Retired; // Replaced tables that are waiting to be released
+   LONG Size;
+   LONG Used;            // Slots holding a live or removed entry
+   LONG Live;
+   UBYTE Shift;
+   ObjectSlot Slots[1];
+};
+
+struct alignas(64) ObjectReader {
+   ObjectTable *Hazard = NULL; // The table that the owning thread is searching
+   ObjectReader *Next = NULL;
+   bool InUse = true;          // False once the owning thread has exited, after which the slot can be adopted
+};
+
+static ObjectTable *glObjectTable = NULL;
+static ObjectTable *glRetiredTables = NULL;
+static ObjectReader *glObjectReaders = NULL; // Hazard slots, guarded by glObjectTableLock
+static std::mutex glObjectTableLock;
+static THREADVAR ObjectReader *tlObjectReader = NULL;
+static THREADVAR bool tlObjectReaderExited = false;
+
+// Releases the hazard slot of the current thread on exit.
+
+struct ObjectReaderOwner {
+   ObjectReader *Reader = NULL;
+
+   ~ObjectReaderOwner() {
+      const std::lock_guard<std::mutex> lock(glObjectTableLock);
+      tlObjectReaderExited = true;
+      if (!Reader) return;
+      tlObjectReader = NULL;
+      Reader->InUse = false;
+      Reader = NULL;
+   }
+};
+
+static thread_local ObjectReaderOwner tlObjectReaderOwner;
+
+INLINE LONG object_index(ObjectTable *Table, OBJECTID ID)
+{
+   return (ULONG)(ULONG(ID) * PRIME_HASH) >> Table->Shift;
+}
+
+static ObjectTable * new_object_table(LONG Size)
+{
+   auto table = (ObjectTable *)calloc(1, sizeof(ObjectTable) + (sizeof(ObjectSlot) * (Size - 1)));
+   if (table) {
+      table->Size  = Size;
+      table->Shift = 32 - __builtin_ctz(Size);
+   }
+   return table;
+}
+
+//****************************************************************************
+// Returns the hazard slot of the current thread, or NULL if one cannot be provided.
+
+static ObjectReader * get_object_reader(void)
+{
+   if (tlObjectReader) return tlObjectReader;
+   if (tlObjectReaderExited) return NULL; // tlObjectReaderOwner has been destroyed and cannot release a new slot
+
+   const std::lock_guard<std::mutex> lock(glObjectTableLock);
+
+   ObjectReader *reader;
+   for (reader=glObjectReaders; reader; reader=reader->Next) {
+      if (!reader->InUse) {
+         reader->InUse = true;
+         break;
+      }
+   }
+
+   if (!reader) {
+      if (!(reader = new (std::nothrow) ObjectReader)) return NULL;
+      reader->Next = glObjectReaders;
+      glObjectReaders = reader;
+   }
+
+   tlObjectReaderOwner.Reader = reader;
+   tlObjectReader = reader;
+   return reader;
+}
+
+//****************************************************************************
+
+static OBJECTPTR search_object_table(ObjectTable *Table, OBJECTID ObjectID)
+{
+   LONG mask = Table->Size - 1;
+   LONG index = object_index(Table, ObjectID);
+   for (LONG i=0; i < Table->Size; i++, index = (index + 1) & mask) {
+      auto &slot = Table->Slots[index];
+      OBJECTID id = __atomic_load_n(&slot.ID, __ATOMIC_ACQUIRE);
+      if (!id) break;
+      if (id IS ObjectID) {
+         OBJECTPTR obj = __atomic_load_n(&slot.Object, __ATOMIC_ACQUIRE);
+         if (__atomic_load_n(&slot.ID, __ATOMIC_ACQUIRE) IS ObjectID) return obj;
+         break;
+      }
+   }
+   return NULL;
+}
+
+//****************************************************************************
+// Returns the address of a private object without locking.  The object is not locked by this function.  The table is
+// published in the hazard slot of the thread and confirmed as current before it is searched, so a writer that
+// replaces it in the meantime will see the hazard and keep the table until the search is complete.
+
+OBJECTPTR find_private_object(OBJECTID ObjectID)
+{
+   auto reader = get_object_reader();
+   if (!reader) { // Only at thread exit or when out of memory
+      const std::lock_guard<std::mutex> lock(glObjectTableLock);
+      return glObjectTable ? search_object_table(glObjectTable, ObjectID) : NULL;
+   }
+
+   ObjectTable *table = __atomic_load_n(&glObjectTable, __ATOMIC_SEQ_CST);
+   while (true) {
+      __atomic_store_n(&reader->Hazard, table, __ATOMIC_SEQ_CST);
+      auto current = __atomic_load_n(&glObjectTable, __ATOMIC_SEQ_CST);
+      if (current IS table) break;
+      table = current;
+   }
+
+   OBJECTPTR result = table ? search_object_table(table, ObjectID) : NULL;
+
+   __atomic_store_n(&reader->Hazard, (ObjectTable *)NULL, __ATOMIC_RELEASE);
+   return result;
+}
+
+//****************************************************************************
+// Releases retired tables that are not referenced by a hazard slot.  Called by every writer while tables are waiting,
+// so a table is released by the first write that follows the end of the last search in it.  Must be called with
+// glObjectTableLock.
+
+static void release_retired_tables(void)
+{
+   auto prev = &glRetiredTables;
+   while (auto table = *prev) {
+      bool hazard = false;
+      for (auto reader=glObjectReaders; reader; reader=reader->Next) {
+         if (__atomic_load_n(&reader->Hazard, __ATOMIC_SEQ_CST) IS table) { hazard = true; break; }
+      }
+
+      if (hazard) prev = &table->Retired;
+      else {
+         *prev = table->Retired;
+         free(table);
+      }
+   }
+}
+
+//****************************************************************************
+// Replaces the table with one that is sized for the live entries.  Must be called with glObjectTableLock.
+
+static ERROR rebuild_object_table(void)
+{
+   auto old = glObjectTable;
+
+   LONG size = OT_MIN_SIZE;
+   if (old) while (size < old->Live * 4) size *= 2;
+
+   ObjectTable *table;
+   if (!(table = new_object_table(size))) return ERR_AllocMemory;
+
+   if (old) {
+      LONG mask = size - 1;
+      for (LONG i=0; i < old->Size; i++) {
+         if (old->Slots[i].ID <= 0) continue;
+         LONG index = object_index(table, old->Slots[i].ID);
+         while (table->Slots[index].ID) index = (index + 1) & mask;
+         table->Slots[index] = old->Slots[i];
+      }
+      table->Live = table->Used = old->Live;
+
+      old->Retired = glRetiredTables;
+      glRetiredTables = old;
+   }
+
+   __atomic_store_n(&glObjectTable, table, __ATOMIC_SEQ_CST);
+
+   release_retired_tables();
+   return ERR_Okay;
+}
+
+//****************************************************************************
+// The object cannot be found by ID if this function fails, so the caller must abort its allocation.
+
+static ERROR register_private_object(OBJECTID ObjectID, OBJECTPTR Object)
+{
+   std::lock_guard<std::mutex> lock(glObjectTableLock);
+
+   if (glRetiredTables) release_retired_tables();
+
+   if ((!glObjectTable) or ((glObjectTable->Used + 1) * 4 > glObjectTable->Size * 3)) {
+      if (auto error = rebuild_object_table()) return error;
+   }
+
+   auto table = glObjectTable;
+   LONG mask = table->Size - 1;
+   LONG index = object_index(table, ObjectID);
+   while (table->Slots[index].ID > 0) index = (index + 1) & mask;
+
+   auto &slot = table->Slots[index];
+   if (!slot.ID) table->Used++;
+   table->Live++;
+   __atomic_store_n(&slot.Object, Object, __ATOMIC_RELEASE);
+   __atomic_store_n(&slot.ID, ObjectID, __ATOMIC_RELEASE);
+   return ERR_Okay;
+}
+
+//****************************************************************************
+
+static void deregister_private_object(OBJECTID ObjectID)
+{
+   std::lock_guard<std::mutex> lock(glObjectTableLock);
+
+   if (glRetiredTables) release_retired_tables();
+
+   if (auto table = glObjectTable) {
+      LONG mask = table->Size - 1;
+      LONG index = object_index(table, ObjectID);
+      for (LONG i=0; i < table->Size; i++, index = (index + 1) & mask) {
+         auto &slot = table->Slots[index];
+         if (!slot.ID) break;
+         if (slot.ID IS ObjectID) {
+            __atomic_store_n(&slot.ID, (OBJECTID)OT_REMOVED, __ATOMIC_RELEASE);
+            __atomic_store_n(&slot.Object, (OBJECTPTR)NULL, __ATOMIC_RELEASE);
+            table->Live--;
+            break;
+         }
+      }
+   }
+}
+
+//****************************************************************************
+// Called on shutdown, when no other threads are active.  Hazard slots are kept because thread exit handlers may still
+// refer to them.
+
+void free_object_table(void)
+{
+   std::lock_guard<std::mutex> lock(glObjectTableLock);
+
+   while (auto table = glRetiredTables) {
+      glRetiredTables = table->Retired;
+      free(table);
+   }
+
+   if (glObjectTable) { free(glObjectTable); glObjectTable = NULL; }
+}
+
 /*****************************************************************************
 
 -FUNCTION-
@@ -115,6 +390,11 @@ to the ~ReleaseMemory() function to remove the lock, or it will remain in memory
 Memory that is allocated through AllocMemory() is automatically cleared with zero-byte values.  When allocating large
 blocks it may be wise to turn off this feature - you can do this by setting the MEM_NO_CLEAR flag.
 
+On hosts that share public memory through a common pool (Windows, and Unix systems that do not use SysV shared
+memory) the size of each public block is limited.  On Windows the entire pool is 2MB.  Elsewhere a block may not exceed
+8192 pages and the pool grows on demand to a maximum of 16 times that amount.  Allocations that exceed these limits
+fail with ERR_Failed.
+
 -INPUT-
 int Size:     The size of the memory block.
 int(MEM) Flags: Optional flags.
@@ -165,7 +445,7 @@ ERROR AllocMemory(LONG Size, LONG Flags, APTR *Address, MEMORYID *MemoryID)
    // Figure out what object the memory block will belong to.  The preferred default is for it to belong to the current context.
 
    if (Flags & MEM_HIDDEN)         object_id = 0;
-   else if (Flags & MEM_UNTRACKED) object_id = 0;
+   else if (Flags & (MEM_UNTRACKED|MEM_UNREGISTERED)) object_id = 0;
    else if (Flags & MEM_TASK)      object_id = glCurrentTaskID;
    else if (Flags & MEM_CALLER) {
       if (tlContext->Stack) object_id = tlContext->Stack->Object->UniqueID;
@@ -183,13 +463,10 @@ ERROR AllocMemory(LONG Size, LONG Flags, APTR *Address, MEMORYID *MemoryID)
 
       // Check that there is room for more public memory allocations
 
-      if ((glSharedControl->NextBlock < 0) or (glSharedControl->NextBlock >= glSharedControl->MaxBlocks)) {
-         compress_public_memory(glSharedControl);
-         if (glSharedControl->NextBlock >= glSharedControl->MaxBlocks) {
-            log.warning("The maximum number of public memory blocks (%d) has been exhausted.", glSharedControl->MaxBlocks);
-            UNLOCK_PUBLIC_MEMORY();
-            return ERR_ArrayFull;
-         }
+      if ((glSharedControl->TotalFreeSlots <= 0) and (glSharedControl->NextBlock >= glSharedControl->MaxBlocks)) {
+         log.warning("The maximum number of public memory blocks (%d) has been exhausted.", glSharedControl->MaxBlocks);
+         UNLOCK_PUBLIC_MEMORY();
+         return ERR_ArrayFull;
       }
 
       // If the memory block is reserved, check if the ID already exists
@@ -207,8 +484,6 @@ retry:
       if (Flags & MEM_RESERVED) memid = reserved_id;
       else memid = __sync_fetch_and_sub(&glSharedControl->IDCounter, 1);
 
-      LONG blk;
-
 #ifdef _WIN32
 
       handle = NULL;
@@ -219,56 +494,11 @@ retry:
             return ERR_AllocMemory;
          }
          offset = -1; // An offset of -1 means that the block is not in the pool area
-         blk = glSharedControl->NextBlock;
       }
-      else {
-         offset = 0; // Get the offset of the last block on the list
-         for (blk=glSharedControl->NextBlock-1; blk >= 0; blk--) {
-            if (glSharedBlocks[blk].MemoryID) {
-               if (glSharedBlocks[blk].Offset IS -1) continue;
-               offset = glSharedBlocks[blk].Offset + glSharedBlocks[blk].Size;
-               break;
-            }
-         }
-
-         blk = glSharedControl->NextBlock;
-
-         // Please remember that the address list must always be sorted on the offset field
-
-         if ((offset + Size) > glSharedControl->PoolSize) { // Check the memory pool for available space so that we can avoid expanding the size of the pool.
-            offset = 0;
-            for (i=0; i < glSharedControl->NextBlock; i++) {
-               if (glSharedBlocks[i].MemoryID) {
-                  if (glSharedBlocks[i].Offset IS -1) continue;
-                  if ((offset + Size) < glSharedBlocks[i].Offset) { // We have found some space for our block
-                     if ((i > 0) and (!glSharedBlocks[i-1].MemoryID)) {
-                        // The block(s) just behind the point of insertion are empty - let's make use of this
-                        while ((i > 0) and (!glSharedBlocks[i-1].MemoryID)) i--;
-                     }
-                     else {
-                        // Make space in the array for our block entry
-                        LONG end;
-                        for (end=i; (glSharedBlocks[end].MemoryID) and (end < glSharedControl->NextBlock); end++);
-                        if ((end IS glSharedControl->NextBlock) and (glSharedControl->NextBlock IS glSharedControl->MaxBlocks)) {
-                           UNLOCK_PUBLIC_MEMORY();
-                           return ERR_ArrayFull;
-                        }
-                        CopyMemory(glSharedBlocks + i, glSharedBlocks + i + 1, sizeof(PublicAddress) * (end - i));
-                        if (end IS glSharedControl->NextBlock) __sync_fetch_and_add(&glSharedControl->NextBlock, 1);
-                     }
-                     blk = i;
-                     break;
-                  }
-                  else offset = glSharedBlocks[i].Offset + glSharedBlocks[i].Size;
-               }
-            }
-
-            if (i IS glSharedControl->NextBlock) {
-               log.error("Out of public memory space.  Limited to %d bytes.", INITIAL_PUBLIC_SIZE);
-               UNLOCK_PUBLIC_MEMORY();
-               return ERR_Failed;
-            }
-         }
+      else if ((offset = pool_alloc(Size)) IS -1) {
+         log.error("Out of public memory space.  Limited to %d bytes.", INITIAL_PUBLIC_SIZE);
+         UNLOCK_PUBLIC_MEMORY();
+         return ERR_Failed;
       }
 
 #elif USE_SHM
@@ -326,58 +556,34 @@ retry:
          }
       }
 
-      blk = glSharedControl->NextBlock;
-
 #else
 
-      // Get the offset of the last block on the list
-
-      offset = 0;
-      for (blk=glSharedControl->NextBlock-1; blk >= 0; blk--) {
-         if (glSharedBlocks[blk].MemoryID) {
-            offset = glSharedBlocks[blk].Offset + RoundPageSize(glSharedBlocks[blk].Size);
-            break;
-         }
-      }
-
-      LONG page_size = Size + glPageSize - (Size % glPageSize);
-      blk = glSharedControl->NextBlock;
-
-      if ((offset + Size) > glSharedControl->PoolSize) {
-         // Check the memory pool for available space so that we can avoid expanding the size of the pool.
-
-         LONG current_offset = 0;
-         for (LONG i=0; i < glSharedControl->NextBlock; i++) {
-            if (glSharedBlocks[i].MemoryID) {
-               if ((current_offset + page_size) < glSharedBlocks[i].Offset) {
-                  if ((i > 0) and (!glSharedBlocks[i-1].MemoryID)) {
-                     while ((i > 0) and (!glSharedBlocks[i-1].MemoryID)) i--;
-                  }
-                  else CopyMemory(glSharedBlocks + i, glSharedBlocks + i + 1, sizeof(PublicAddress) * (glSharedControl->NextBlock - i));
-
-                  offset = current_offset;
-                  blk = i;
-                  break;
-               }
-               else current_offset = glSharedBlocks[i].Offset + RoundPageSize(glSharedBlocks[i].Size);
-            }
-         }
+      if ((offset = pool_alloc(Size)) IS -1) {
+         log.warning("Out of public memory space for %d bytes.  Blocks are limited to %d bytes and the pool to %d bytes.",
+            Size, glPoolMap->Grain * POOL_EXTENT, glPoolMap->Grain * POOL_GRAINS);
+         UNLOCK_PUBLIC_MEMORY();
+         return ERR_Failed;
       }
 
       // Expand the size of the page file if the end of the block exceeds the pool's capacity.
 
-      if (offset + page_size > glSharedControl->PoolSize) {
-         if (ftruncate(glMemoryFD, glSharedControl->MemoryOffset + offset + page_size) IS -1) {
-            log.warning("Failed to increase memory pool size to %d bytes.", glSharedControl->MemoryOffset + offset + page_size);
+      LONG end = offset + (glPoolMap->Grain << glPoolMap->Order[offset / glPoolMap->Grain]);
+      if (end > glSharedControl->PoolSize) {
+         if (ftruncate(glMemoryFD, glSharedControl->MemoryOffset + end) IS -1) {
+            log.warning("Failed to increase memory pool size to %d bytes.", glSharedControl->MemoryOffset + end);
+            pool_free(offset);
             UNLOCK_PUBLIC_MEMORY();
             return ERR_Failed;
          }
 
-         glSharedControl->PoolSize = offset + page_size;
+         glSharedControl->PoolSize = end;
       }
 #endif
 
-      // Record the memory allocation
+      // Record the memory allocation.  Slots in glSharedBlocks are stable for the lifetime of the block, so the index
+      // is also recorded against the block's ID and pool offset.
+
+      LONG blk = alloc_public_slot();
 
       ClearMemory(glSharedBlocks + blk, sizeof(PublicAddress));
 
@@ -391,6 +597,14 @@ retry:
          glSharedBlocks[blk].Handle    = handle;
       #endif
 
+      insert_sorted_block(memid, blk);
+      #ifdef _WIN32
+         if (offset != -1) glPoolMap->Next[offset / glPoolMap->Grain] = blk;
+      #elif !defined(USE_SHM)
+         glPoolMap->Next[offset / glPoolMap->Grain] = blk;
+      #endif
+      __sync_fetch_and_add(&glSharedControl->BlocksUsed, 1);
+
       // Record the task that the memory block should be tracked to.  The current context plays an important part in
       // this, because if the object is shared then we want the allocation to track back to the task responsible for
       // maintaining that object rather than having it track back to our own task.
@@ -408,7 +622,7 @@ retry:
 
       if (Address) {
          if (page_memory(glSharedBlocks + blk, Address) != ERR_Okay) {
-            ClearMemory(glSharedBlocks + blk, sizeof(PublicAddress));
+            remove_public_block(blk);
             UNLOCK_PUBLIC_MEMORY();
             log.warning("Paging the newly allocated block of size %d failed.", Size);
             return ERR_LockFailed;
@@ -422,8 +636,8 @@ retry:
             }
             else {
                log.warning("Out of memory locks.");
-               ClearMemory(glSharedBlocks + blk, sizeof(PublicAddress));
                unpage_memory(*Address);
+               remove_public_block(blk);
                UNLOCK_PUBLIC_MEMORY();
                return ERR_ArrayFull;
             }
@@ -453,9 +667,6 @@ retry:
 
       *MemoryID = glSharedBlocks[blk].MemoryID;
 
-      __sync_fetch_and_add(&glSharedControl->BlocksUsed, 1);
-      if (blk IS glSharedControl->NextBlock) __sync_fetch_and_add(&glSharedControl->NextBlock, 1);
-
       UNLOCK_PUBLIC_MEMORY();
 
       if (glShowPublic) log.pmsg("AllocPublic(#%d, %d, $%.8x, Index: %d, Owner: %d)", *MemoryID, Size, Flags, blk, object_id);
@@ -467,9 +678,35 @@ retry:
       LONG full_size = Size + MEMHEADER;
       if (Flags & MEM_MANAGED) full_size += sizeof(ResourceManager *);
 
+      // Small data and string blocks are served from the slab cache of the current thread.
+
       APTR start_mem;
-      if (!(Flags & MEM_NO_CLEAR)) start_mem = calloc(1, full_size);
-      else start_mem = malloc(full_size);
+      LONG head_code;
+      if ((Size <= SLAB_MAX_SIZE) and (!(Flags & (MEM_MANAGED|MEM_OBJECT|MEM_NO_POOL|MEM_CODE|MEM_VIDEO|MEM_TEXTURE|MEM_AUDIO))) and
+          ((start_mem = slab_alloc(Size)))) {
+         if (!(Flags & MEM_NO_CLEAR)) ClearMemory(start_mem, full_size);
+         head_code = CODE_MEMS;
+
+         // MEM_UNREGISTERED blocks are referenced by address only and are not registered.  The size is stored in the
+         // header instead of an ID and the flags follow the tail cookie, so that MemoryPtrInfo() and ReallocMemory()
+         // still work.  Slab chunks always have room for the extra LONG.
+
+         if ((Flags & MEM_UNREGISTERED) and (!MemoryID)) {
+            ((LONG *)start_mem)[0] = Size;
+            ((LONG *)start_mem)[1] = CODE_MEMU;
+            ((LONG *)((char *)start_mem + full_size - 4))[0] = CODE_MEMT;
+            ((LONG *)((char *)start_mem + full_size))[0] = Flags;
+            *Address = (char *)start_mem + sizeof(LONG) + sizeof(LONG);
+            if (glShowPrivate) log.pmsg("AllocMemory(%p, %d, $%.8x, Unregistered)", *Address, Size, Flags);
+            return ERR_Okay;
+         }
+      }
+      else {
+         slab_miss();
+         if (!(Flags & MEM_NO_CLEAR)) start_mem = calloc(1, full_size);
+         else start_mem = malloc(full_size);
+         head_code = CODE_MEMH;
+      }
 
       if (!start_mem) {
          log.warning("Could not allocate %d bytes.", Size);
@@ -479,59 +716,67 @@ retry:
       APTR data_start = (char *)start_mem + sizeof(LONG) + sizeof(LONG); // Skip MEMH and unique ID.
       if (Flags & MEM_MANAGED) data_start = (char *)data_start + sizeof(ResourceManager *); // Skip managed resource reference.
 
-      ThreadLock lock(TL_PRIVATE_MEM, 4000);
-      if (lock.granted()) { // For keeping threads synchronised, it is essential that this lock is made early on.
-         MEMORYID unique_id = __sync_fetch_and_add(&glSharedControl->PrivateIDCounter, 1);
+      MEMORYID unique_id = __sync_fetch_and_add(&glSharedControl->PrivateIDCounter, 1);
 
-         // Configure the memory header and place boundary cookies at the start and end of the memory block.
+      // Configure the memory header and place boundary cookies at the start and end of the memory block.
 
-         APTR header = start_mem;
-         if (Flags & MEM_MANAGED) {
-            ((ResourceManager **)header)[0] = NULL;
-            header = (char *)header + sizeof(ResourceManager *);
-         }
+      APTR header = start_mem;
+      if (Flags & MEM_MANAGED) {
+         ((ResourceManager **)header)[0] = NULL;
+         header = (char *)header + sizeof(ResourceManager *);
+      }
 
-         ((LONG *)header)[0]  = unique_id;
-         header = (char *)header + sizeof(LONG);
+      ((LONG *)header)[0]  = unique_id;
+      header = (char *)header + sizeof(LONG);
 
-         ((LONG *)header)[0]  = CODE_MEMH;
-         header = (char *)header + sizeof(LONG);
+      ((LONG *)header)[0]  = head_code;
+      header = (char *)header + sizeof(LONG);
 
-         ((LONG *)((char *)start_mem + full_size - 4))[0] = CODE_MEMT;
+      ((LONG *)((char *)start_mem + full_size - 4))[0] = CODE_MEMT;
 
-         // Remember the memory block's details such as the size, ID, flags and object that it belongs to.  This helps us
-         // with resource tracking, identifying the memory block and freeing it later on.  Hidden blocks are never recorded.
+      // Remember the memory block's details such as the size, ID, flags and object that it belongs to.  This helps us
+      // with resource tracking, identifying the memory block and freeing it later on.  Hidden blocks are never recorded.
+      // Only the shards that the ID and owner belong to are locked, so allocations in other threads are unaffected.
 
-         if (!(Flags & MEM_HIDDEN)) {
-            glPrivateMemory.insert(std::pair<MEMORYID, PrivateAddress>(unique_id, PrivateAddress(data_start, unique_id, object_id, (ULONG)Size, (WORD)Flags)));
-            if (Flags & MEM_OBJECT) {
-               if (object_id) glObjectChildren[object_id].insert(unique_id);
-            }
-            else glObjectMemory[object_id].insert(unique_id);
+      if (!(Flags & MEM_HIDDEN)) {
+         auto &shard = glPrivateMemory.shard(unique_id);
+         {
+            std::unique_lock lock(shard.Lock);
+            shard.Map.emplace(unique_id, PrivateAddress(data_start, unique_id, object_id, (ULONG)Size, (WORD)Flags));
          }
 
-         // Gain exclusive access if both the address pointer and memory ID have been specified.
-
-         if ((MemoryID) and (Address)) {
-            if (Flags & MEM_NO_LOCK) *Address = data_start;
-            else if (AccessMemory(unique_id, MEM_READ_WRITE, 2000, Address) != ERR_Okay) {
-               log.warning("Memory block %d stolen during allocation!", *MemoryID);
-               return ERR_AccessMemory;
+         if (Flags & MEM_OBJECT) {
+            if (auto error = register_private_object(unique_id, (OBJECTPTR)data_start)) {
+               {
+                  std::unique_lock lock(shard.Lock);
+                  shard.Map.erase(unique_id);
+               }
+               free(start_mem);
+               log.warning("Failed to register object #%d.", unique_id);
+               return error;
             }
-            *MemoryID = unique_id;
-         }
-         else {
-            if (Address)  *Address  = data_start;
-            if (MemoryID) *MemoryID = unique_id;
+            if (object_id) glObjectChildren.insert_into(object_id, unique_id);
          }
+         else glObjectMemory.insert_into(object_id, unique_id);
+      }
 
-         if (glShowPrivate) log.pmsg("AllocMemory(%p/#%d, %d, $%.8x, Owner: #%d)", data_start, unique_id, Size, Flags, object_id);
-         return ERR_Okay;
+      // Gain exclusive access if both the address pointer and memory ID have been specified.
+
+      if ((MemoryID) and (Address)) {
+         if (Flags & MEM_NO_LOCK) *Address = data_start;
+         else if (AccessMemory(unique_id, MEM_READ_WRITE, 2000, Address) != ERR_Okay) {
+            log.warning("Memory block %d stolen during allocation!", *MemoryID);
+            return ERR_AccessMemory;
+         }
+         *MemoryID = unique_id;
       }
       else {
-         freemem(start_mem);
-         return ERR_LockFailed;
+         if (Address)  *Address  = data_start;
+         if (MemoryID) *MemoryID = unique_id;
       }
+
+      if (glShowPrivate) log.pmsg("AllocMemory(%p/#%d, %d, $%.8x, Owner: #%d)", data_start, unique_id, Size, Flags, object_id);
+      return ERR_Okay;
    }
 }
 
@@ -573,10 +818,7 @@ ERROR CheckMemoryExists(MEMORYID MemoryID)
       return ERR_False;
    }
    else {
-      ThreadLock lock(TL_PRIVATE_MEM, 4000);
-      if (lock.granted()) {
-         if (glPrivateMemory.contains(MemoryID)) return ERR_True;
-      }
+      if (glPrivateMemory.contains(MemoryID)) return ERR_True;
    }
 
    return ERR_False;
@@ -675,62 +917,46 @@ ERROR FreeResource(const void *Address)
 
    APTR start_mem = (char *)Address - sizeof(LONG) - sizeof(LONG);
 
-   ThreadLock lock(TL_PRIVATE_MEM, 4000);
-   if (lock.granted()) {
-      // Find the memory block in our registered list.  NOTE: If the program passes a public memory address to this
-      // function, a crash will occur here because the -2 index will likely cause a segfault.
-
-      LONG id = ((LONG *)start_mem)[0];
-      ULONG head = ((LONG *)start_mem)[1];
-
-      auto it = glPrivateMemory.find(id);
+   // Find the memory block in our registered list.  NOTE: If the program passes a public memory address to this
+   // function, a crash will occur here because the -2 index will likely cause a segfault.
 
-      if (it IS glPrivateMemory.end()) {
-         if (head IS CODE_MEMH) log.warning("Second attempt at freeing address %p detected.", Address);
-         else log.warning("Address %p is not a known private memory block.", Address);
-         #ifdef DEBUG
-         PrintDiagnosis(0, 0);
-         #endif
-         return ERR_Memory;
-      }
-
-      auto &mem = it->second;
-
-      if (glShowPrivate) {
-         log.pmsg("FreeResource(%p, Size: %d, $%.8x, Owner: #%d)", Address, mem.Size, mem.Flags, mem.OwnerID);
-      }
+   LONG id = ((LONG *)start_mem)[0];
+   ULONG head = ((LONG *)start_mem)[1];
 
-      if ((mem.OwnerID) and (tlContext->Object->UniqueID) and (mem.OwnerID != tlContext->Object->UniqueID)) {
-         log.warning("Attempt to free address %p (size %d) owned by #%d.", Address, mem.Size, mem.OwnerID);
-      }
-
-      if (mem.AccessCount > 0) {
-         log.trace("Address %p owned by #%d marked for deletion (open count %d).", Address, mem.OwnerID, mem.AccessCount);
-         mem.Flags |= MEM_DELETE;
-         return ERR_Okay;
-      }
-
-      // If the block has a resource manager then call its Free() implementation.
+   if (head IS CODE_MEMU) { // Unregistered slab block; the ID field holds the size.
+      LONG size = id;
+      if (glShowPrivate) log.pmsg("FreeResource(%p, Size: %d, Unregistered)", Address, size);
+      if (((LONG *)((BYTE *)Address + size))[0] != CODE_MEMT) log.warning("Bad tail on address %p, size %d.", Address, size);
+      randomise_memory((APTR)Address, size);
+      slab_free(start_mem);
+      return ERR_Okay;
+   }
 
-      if (mem.Flags & MEM_MANAGED) {
-         start_mem = (char *)start_mem - sizeof(ResourceManager *);
+   auto &shard = glPrivateMemory.shard(id);
+   std::unique_lock lock(shard.Lock);
 
-         auto rm = ((ResourceManager **)start_mem)[0];
-         if ((rm) and (rm->Free)) rm->Free((APTR)Address);
-         else log.warning("Resource manager not defined for block #%d.", id);
-      }
+   auto it = shard.Map.find(id);
 
-      auto size = mem.Size;
-      BYTE *end = ((BYTE *)Address) + size;
+   if ((it IS shard.Map.end()) or (!it->second.Address)) {
+      lock.unlock();
+      if ((head IS CODE_MEMH) or (head IS CODE_MEMS)) log.warning("Second attempt at freeing address %p detected.", Address);
+      else log.warning("Address %p is not a known private memory block.", Address);
+      #ifdef DEBUG
+      PrintDiagnosis(0, 0);
+      #endif
+      return ERR_Memory;
+   }
 
-      if (head != CODE_MEMH) log.warning("Bad header on address %p, size %d.", Address, size);
-      if (((LONG *)end)[0] != CODE_MEMT) log.warning("Bad tail on address %p, size %d.", Address, size);
+   // The details of the block are copied out so that the shard can be unlocked before anything is logged.  Unless the
+   // block is locked or has a resource manager, the record is removed at the same time.
 
-      if (mem.Flags & MEM_OBJECT) {
-         if (glObjectChildren.contains(mem.OwnerID)) glObjectChildren[mem.OwnerID].erase(id);
-      }
-      else if (glObjectMemory.contains(mem.OwnerID)) glObjectMemory[mem.OwnerID].erase(id);
+   const auto size   = it->second.Size;
+   const auto owner  = it->second.OwnerID;
+   const auto flags  = it->second.Flags;
+   const auto access = it->second.AccessCount;
 
+   auto release_record = [&]() {
+      auto &mem = it->second;
       mem.Address  = 0;
       mem.MemoryID = 0;
       mem.OwnerID  = 0;
@@ -739,19 +965,59 @@ ERROR FreeResource(const void *Address)
       mem.ThreadLockID = 0;
       #endif
 
-      randomise_memory((APTR)Address, size);
+      // NB: Guarantee the stability of glPrivateMemory by not erasing records during shutdown (just clear the values).
 
-      freemem(start_mem);
+      if (glProgramStage != STAGE_SHUTDOWN) shard.Map.erase(it);
+   };
 
-      // NB: Guarantee the stability of glPrivateMemory by not erasing records during shutdown (just clear the values).
+   if (access > 0) it->second.Flags |= MEM_DELETE;
+   else if (!(flags & MEM_MANAGED)) release_record();
 
-      if (glProgramStage != STAGE_SHUTDOWN) {
-         glPrivateMemory.erase(id);
-      }
+   lock.unlock();
+
+   if (glShowPrivate) log.pmsg("FreeResource(%p, Size: %d, $%.8x, Owner: #%d)", Address, size, flags, owner);
 
+   if ((owner) and (tlContext->Object->UniqueID) and (owner != tlContext->Object->UniqueID)) {
+      log.warning("Attempt to free address %p (size %d) owned by #%d.", Address, size, owner);
+   }
+
+   if (access > 0) {
+      log.trace("Address %p owned by #%d marked for deletion (open count %d).", Address, owner, access);
       return ERR_Okay;
    }
-   else return ERR_LockFailed;
+
+   // If the block has a resource manager then call its Free() implementation.  The shard is unlocked for the duration
+   // because the manager is free to release other resources.
+
+   if (flags & MEM_MANAGED) {
+      start_mem = (char *)start_mem - sizeof(ResourceManager *);
+
+      auto rm = ((ResourceManager **)start_mem)[0];
+      if ((rm) and (rm->Free)) rm->Free((APTR)Address);
+      else log.warning("Resource manager not defined for block #%d.", id);
+
+      lock.lock();
+      it = shard.Map.find(id);
+      if ((it IS shard.Map.end()) or (!it->second.Address)) return ERR_Okay; // Freed by the resource manager
+      release_record();
+      lock.unlock();
+   }
+
+   BYTE *end = ((BYTE *)Address) + size;
+   if ((head != CODE_MEMH) and (head != CODE_MEMS)) log.warning("Bad header on address %p, size %d.", Address, size);
+   if (((LONG *)end)[0] != CODE_MEMT) log.warning("Bad tail on address %p, size %d.", Address, size);
+
+   if (flags & MEM_OBJECT) {
+      deregister_private_object(id);
+      glObjectChildren.erase_from(owner, id);
+   }
+   else glObjectMemory.erase_from(owner, id);
+
+   randomise_memory((APTR)Address, size);
+
+   if (head IS CODE_MEMS) slab_free(start_mem);
+   else freemem(start_mem);
+   return ERR_Okay;
 }
 
 /*****************************************************************************
@@ -801,8 +1067,6 @@ ERROR FreeResourceID(MEMORYID MemoryID)
                //}
             }
 
-            __sync_fetch_and_sub(&glSharedControl->BlocksUsed, 1);
-
             #ifdef _WIN32
                APTR pool = ResolveAddress(glSharedControl, glSharedControl->MemoryOffset);
 
@@ -862,7 +1126,7 @@ ERROR FreeResourceID(MEMORYID MemoryID)
                // Do nothing for mmap'ed memory since it uses the offset method
             #endif
 
-            ClearMemory(glSharedBlocks + entry, sizeof(PublicAddress));
+            remove_public_block(entry);
             return ERR_Okay;
          }
       }
@@ -871,52 +1135,63 @@ ERROR FreeResourceID(MEMORYID MemoryID)
    else if (MemoryID > 0) { // Search the private memory control table
       if (glShowPrivate) log.function("#%d", MemoryID);
 
-      ThreadLock lock(TL_PRIVATE_MEM, 4000);
-      if (lock.granted()) {
-         auto it = glPrivateMemory.find(MemoryID);
-         if (glPrivateMemory.contains(MemoryID)) {
-            auto &mem = it->second;
+      auto &shard = glPrivateMemory.shard(MemoryID);
+      std::unique_lock lock(shard.Lock);
+      auto it = shard.Map.find(MemoryID);
+      if ((it != shard.Map.end()) and (it->second.Address)) {
+         auto &mem = it->second;
+         if (mem.AccessCount > 0) {
+            auto access = mem.AccessCount;
+            mem.Flags |= MEM_DELETE;
+            lock.unlock();
+            log.msg("Private memory ID #%d marked for deletion (open count %d).", MemoryID, access);
+         }
+         else {
+            auto address = mem.Address;
+            auto size    = mem.Size;
+            auto owner   = mem.OwnerID;
+            auto flags   = mem.Flags;
+
+            mem.Address  = 0;
+            mem.MemoryID = 0;
+            mem.OwnerID  = 0;
+            mem.Flags    = 0;
+            #ifdef __unix__
+            mem.ThreadLockID = 0;
+            #endif
+
+            if (glProgramStage != STAGE_SHUTDOWN) shard.Map.erase(it);
+
+            lock.unlock();
+
             ERROR error = ERR_Okay;
-            if (mem.AccessCount > 0) {
-               log.msg("Private memory ID #%d marked for deletion (open count %d).", MemoryID, mem.AccessCount);
-               mem.Flags |= MEM_DELETE;
-            }
-            else {
-               BYTE *mem_end = ((BYTE *)mem.Address) + mem.Size;
+            BYTE *mem_end = ((BYTE *)address) + size;
+            auto head = ((LONG *)address)[-1];
 
-               if (((LONG *)mem.Address)[-1] != CODE_MEMH) {
-                  log.warning("Bad header on block #%d, address %p, size %d.", MemoryID, mem.Address, mem.Size);
-                  error = ERR_InvalidData;
-               }
+            if ((head != CODE_MEMH) and (head != CODE_MEMS)) {
+               log.warning("Bad header on block #%d, address %p, size %d.", MemoryID, address, size);
+               error = ERR_InvalidData;
+            }
 
-               if (((LONG *)mem_end)[0] != CODE_MEMT) {
-                  log.warning("Bad tail on block #%d, address %p, size %d.", MemoryID, mem.Address, mem.Size);
-                  error = ERR_InvalidData;
-               }
+            if (((LONG *)mem_end)[0] != CODE_MEMT) {
+               log.warning("Bad tail on block #%d, address %p, size %d.", MemoryID, address, size);
+               error = ERR_InvalidData;
+            }
 
-               randomise_memory(mem.Address, mem.Size);
-               freemem(((LONG *)mem.Address)-2);
+            randomise_memory(address, size);
 
-               if (mem.Flags & MEM_OBJECT) {
-                  if (glObjectChildren.contains(mem.OwnerID)) glObjectChildren[mem.OwnerID].erase(MemoryID);
-               }
-               else if (glObjectMemory.contains(mem.OwnerID)) glObjectMemory[mem.OwnerID].erase(MemoryID);
-
-               mem.Address  = 0;
-               mem.MemoryID = 0;
-               mem.OwnerID  = 0;
-               mem.Flags    = 0;
-               #ifdef __unix__
-               mem.ThreadLockID = 0;
-               #endif
-
-               if (glProgramStage != STAGE_SHUTDOWN) {
-                  glPrivateMemory.erase(MemoryID);
-               }
+            if (flags & MEM_OBJECT) {
+               deregister_private_object(MemoryID);
+               glObjectChildren.erase_from(owner, MemoryID);
             }
+            else glObjectMemory.erase_from(owner, MemoryID);
 
+            if (head IS CODE_MEMS) slab_free(((LONG *)address)-2);
+            else freemem(((LONG *)address)-2);
             return error;
          }
+
+         return ERR_Okay;
       }
    }
    else return log.warning(ERR_NullArgs);
@@ -949,13 +1224,10 @@ ptr: Returns the address of the memory ID, or NULL if the ID does not refer to a
 APTR GetMemAddress(MEMORYID MemoryID)
 {
    if (MemoryID > 0) {
-      ThreadLock lock(TL_PRIVATE_MEM, 4000);
-      if (lock.granted()) {
-         auto mem = glPrivateMemory.find(MemoryID);
-         if (mem != glPrivateMemory.end()) {
-            return mem->second.Address;
-         }
-      }
+      auto &shard = glPrivateMemory.shard(MemoryID);
+      std::shared_lock lock(shard.Lock);
+      auto mem = shard.Map.find(MemoryID);
+      if (mem != shard.Map.end()) return mem->second.Address;
    }
    return NULL;
 }
@@ -1022,23 +1294,21 @@ ERROR MemoryIDInfo(MEMORYID MemoryID, struct MemInfo *MemInfo, LONG Size)
       else return log.warning(ERR_SystemLocked);
    }
    else { // Search private memory blocks
-      ThreadLock lock(TL_PRIVATE_MEM, 4000);
-      if (lock.granted()) {
-         auto mem = glPrivateMemory.find(MemoryID);
-         if (mem != glPrivateMemory.end()) {
-            MemInfo->Start       = mem->second.Address;
-            MemInfo->ObjectID    = mem->second.OwnerID;
-            MemInfo->Size        = mem->second.Size;
-            MemInfo->AccessCount = mem->second.AccessCount;
-            MemInfo->Flags       = mem->second.Flags | MEM_PUBLIC;
-            MemInfo->MemoryID    = mem->second.MemoryID;
-            MemInfo->TaskID      = glCurrentTaskID;
-            MemInfo->Handle      = 0;
-            return ERR_Okay;
-         }
-         else return ERR_MemoryDoesNotExist;
+      auto &shard = glPrivateMemory.shard(MemoryID);
+      std::shared_lock lock(shard.Lock);
+      auto mem = shard.Map.find(MemoryID);
+      if ((mem != shard.Map.end()) and (mem->second.Address)) {
+         MemInfo->Start       = mem->second.Address;
+         MemInfo->ObjectID    = mem->second.OwnerID;
+         MemInfo->Size        = mem->second.Size;
+         MemInfo->AccessCount = mem->second.AccessCount;
+         MemInfo->Flags       = mem->second.Flags | MEM_PUBLIC;
+         MemInfo->MemoryID    = mem->second.MemoryID;
+         MemInfo->TaskID      = glCurrentTaskID;
+         MemInfo->Handle      = 0;
+         return ERR_Okay;
       }
-      else return log.warning(ERR_SystemLocked);
+      else return ERR_MemoryDoesNotExist;
    }
 }
 
@@ -1130,13 +1400,23 @@ ERROR MemoryPtrInfo(APTR Memory, struct MemInfo *MemInfo, LONG Size)
       else return log.warning(ERR_SystemLocked);
    }
 
+   // Unregistered slab blocks carry their size in the header and their flags after the tail.
+
+   if (((LONG *)Memory)[-1] IS CODE_MEMU) {
+      MemInfo->Start  = Memory;
+      MemInfo->Size   = ((LONG *)Memory)[-2];
+      MemInfo->Flags  = ((LONG *)((char *)Memory + MemInfo->Size + 4))[0];
+      MemInfo->TaskID = glCurrentTaskID;
+      return ERR_Okay;
+   }
+
    // Search private memory areas.  This is a bit slow, but if the memory pointer is guaranteed to have
    // come from AllocMemory() then the optimal solution for the client is to pull the ID from
    // (LONG *)Memory)[-2] first and call MemoryIDInfo() instead.
 
-   ThreadLock memlock(TL_PRIVATE_MEM, 4000);
-   if (memlock.granted()) {
-      for (const auto & [ id, mem ] : glPrivateMemory) {
+   for (auto &shard : glPrivateMemory.Shards) {
+      std::shared_lock lock(shard.Lock);
+      for (const auto & [ id, mem ] : shard.Map) {
          if (Memory IS mem.Address) {
             MemInfo->Start       = Memory;
             MemInfo->ObjectID    = mem.OwnerID;
@@ -1215,9 +1495,16 @@ ERROR ReallocMemory(APTR Address, LONG NewSize, APTR *Memory, MEMORYID *MemoryID
 
    if ((glShowPrivate) or (glShowPublic)) log.branch("Address: %p, NewSize: %d", Address, NewSize);
 
+   // MemInfo can only report the lower 16 bits of the flags, so those of an unregistered block are read directly.
+
+   LONG flags = meminfo.Flags;
+   if ((!(meminfo.Flags & MEM_PUBLIC)) and (((LONG *)Address)[-1] IS CODE_MEMU)) {
+      flags = ((LONG *)((char *)Address + meminfo.Size + 4))[0];
+   }
+
    // Allocate the new memory block and copy the data across
 
-   if (!AllocMemory(NewSize, meminfo.Flags, Memory, MemoryID)) {
+   if (!AllocMemory(NewSize, flags, Memory, MemoryID)) {
       if (NewSize < meminfo.Size) copysize = NewSize;
       else copysize = meminfo.Size;
 
@@ -1240,32 +1527,193 @@ ERROR ReallocMemory(APTR Address, LONG NewSize, APTR *Memory, MEMORYID *MemoryID
    else return log.error(ERR_AllocMemory);
 }
 
+/*****************************************************************************
+** Public memory blocks are recorded in glSharedBlocks, and a block keeps the same slot for its lifetime.  Freed slots
+** are pushed to glFreeSlots for reuse, so there is no need to compact the table.  A separate index, glSortedBlocks, is
+** kept in descending order of MemoryID for the benefit of find_public_mem_id().  All of these functions must be called
+** while PL_PUBLICMEM is locked.
+*/
+
+void init_public_tables(SharedControl *Control)
+{
+#ifndef USE_SHM
+   auto map = (PoolMap *)ResolveAddress(Control, Control->PoolMapOffset);
+   ClearMemory(map, sizeof(PoolMap));
+   #ifdef STATIC_MEMORY_POOL
+      map->Grain = INITIAL_PUBLIC_SIZE / POOL_EXTENT;
+   #else
+      map->Grain = glPageSize;
+   #endif
+   map->TotalGrains = POOL_EXTENT;
+   for (LONG o=0; o < POOL_ORDERS; o++) map->FreeHead[o] = -1;
+   map->FreeHead[POOL_ORDERS-1] = 0; // The pool starts as a single free extent
+   map->Next[0]  = -1;
+   map->Prev[0]  = -1;
+   map->Order[0] = POOL_ORDERS-1;
+   map->State[0] = PGS_FREE;
+#endif
+}
+
 //****************************************************************************
-// Compresses the public memory table, keeping it in the correct record order.
+// The caller must have confirmed that a slot is available.
 
-static void compress_public_memory(SharedControl *Control)
+static LONG alloc_public_slot(void)
 {
-   LONG i;
+   if (glSharedControl->TotalFreeSlots > 0) return glFreeSlots[__sync_sub_and_fetch(&glSharedControl->TotalFreeSlots, 1)];
+   else return __sync_fetch_and_add(&glSharedControl->NextBlock, 1);
+}
+
+//****************************************************************************
+
+static void insert_sorted_block(MEMORYID MemoryID, LONG Index)
+{
+   // New IDs are taken from a decrementing counter, so in the common case the entry is appended to the end.
+
+   LONG floor = 0;
+   LONG ceiling = glSharedControl->TotalSorted;
+   while (floor < ceiling) {
+      LONG i = (floor + ceiling)>>1;
+      if (MemoryID < glSortedBlocks[i].MemoryID) floor = i + 1;
+      else ceiling = i;
+   }
+
+   if (floor < glSharedControl->TotalSorted) {
+      memmove(glSortedBlocks + floor + 1, glSortedBlocks + floor, sizeof(SortedAddress) * (glSharedControl->TotalSorted - floor));
+   }
 
-   // Find the first empty index.
-   for (i=0; (i < Control->NextBlock) and (glSharedBlocks[i].MemoryID); i++);
+   glSortedBlocks[floor].MemoryID = MemoryID;
+   glSortedBlocks[floor].Index    = Index;
+   __sync_fetch_and_add(&glSharedControl->TotalSorted, 1);
+}
 
-   if (i >= Control->NextBlock) return;
+//****************************************************************************
 
-   for (LONG j=i+1; j < Control->NextBlock; j++) {
-      if (glSharedBlocks[j].MemoryID) { // Move the record at position j to position i
-         glSharedBlocks[i] = glSharedBlocks[j];
-         ClearMemory(glSharedBlocks + j, sizeof(PublicAddress));
-         i++;
+static void remove_sorted_block(MEMORYID MemoryID)
+{
+   LONG floor = 0;
+   LONG ceiling = glSharedControl->TotalSorted;
+   while (floor < ceiling) {
+      LONG i = (floor + ceiling)>>1;
+      if (MemoryID < glSortedBlocks[i].MemoryID) floor = i + 1;
+      else if (MemoryID > glSortedBlocks[i].MemoryID) ceiling = i;
+      else {
+         __sync_fetch_and_sub(&glSharedControl->TotalSorted, 1);
+         memmove(glSortedBlocks + i, glSortedBlocks + i + 1, sizeof(SortedAddress) * (glSharedControl->TotalSorted - i));
+         return;
       }
    }
+}
+
+/*****************************************************************************
+** Buddy allocator for the public memory pool.  Blocks are allocated in power-of-2 multiples of the grain size, which
+** makes allocation and release O(log n) and guarantees that freed neighbours are merged.  The Next field of an
+** allocated block refers to its slot in glSharedBlocks, so that addresses in the pool can be resolved directly.
+** Buddies never cross an extent, so a new extent can be added to the top order when the pool is exhausted.
+*/
+
+#ifndef USE_SHM
+
+static void pool_unlink(LONG Grain)
+{
+   auto map = glPoolMap;
+   if (map->Prev[Grain] != -1) map->Next[map->Prev[Grain]] = map->Next[Grain];
+   else map->FreeHead[map->Order[Grain]] = map->Next[Grain];
+   if (map->Next[Grain] != -1) map->Prev[map->Next[Grain]] = map->Prev[Grain];
+   map->State[Grain] = 0;
+}
+
+static void pool_push(LONG Grain, LONG Order)
+{
+   auto map = glPoolMap;
+   map->Order[Grain] = Order;
+   map->State[Grain] = PGS_FREE;
+   map->Prev[Grain]  = -1;
+   map->Next[Grain]  = map->FreeHead[Order];
+   if (map->Next[Grain] != -1) map->Prev[map->Next[Grain]] = Grain;
+   map->FreeHead[Order] = Grain;
+}
+
+// Returns the offset of the allocated space, or -1 if the pool is exhausted.
+
+static LONG pool_alloc(LONG Size)
+{
+   auto map = glPoolMap;
+   LONG grains = (Size + map->Grain - 1) / map->Grain;
+   LONG order;
+   for (order=0; (order < POOL_ORDERS) and ((1<<order) < grains); order++);
+
+   if (order >= POOL_ORDERS) return -1;
+
+   LONG o;
+   for (o=order; (o < POOL_ORDERS) and (map->FreeHead[o] IS -1); o++);
+   if (o >= POOL_ORDERS) { // Grow the pool by another extent, provided that offsets remain within range
+      if ((map->TotalGrains >= POOL_GRAINS) or
+          (LARGE(map->TotalGrains + POOL_EXTENT) * map->Grain > 0x7fffffffLL)) return -1;
+      pool_push(map->TotalGrains, POOL_ORDERS-1);
+      map->TotalGrains += POOL_EXTENT;
+      o = POOL_ORDERS-1;
+   }
+
+   LONG grain = map->FreeHead[o];
+   pool_unlink(grain);
+
+   while (o > order) { // Split the block, returning the upper half to the free list each time
+      o--;
+      pool_push(grain + (1<<o), o);
+   }
+
+   map->Order[grain] = order;
+   map->State[grain] = PGS_ALLOC;
+   map->Next[grain]  = -1;
+   map->Prev[grain]  = -1;
+   return grain * map->Grain;
+}
+
+static void pool_free(LONG Offset)
+{
+   auto map = glPoolMap;
+   LONG grain = Offset / map->Grain;
+   LONG order = map->Order[grain];
+   map->State[grain] = 0;
+
+   while (order < POOL_ORDERS-1) {
+      LONG buddy = grain ^ (1<<order);
+      if ((map->State[buddy] != PGS_FREE) or (map->Order[buddy] != order)) break;
+      pool_unlink(buddy);
+      if (buddy < grain) grain = buddy;
+      order++;
+   }
+
+   pool_push(grain, order);
+}
+
+#endif
+
+//****************************************************************************
+// Removes a public block from the tables and releases its space in the pool.  Releasing the underlying resource (e.g.
+// an shm segment) is the responsibility of the caller.
 
-   Control->NextBlock = i;
+void remove_public_block(LONG Index)
+{
+   auto block = glSharedBlocks + Index;
+   if (!block->MemoryID) return;
+
+   remove_sorted_block(block->MemoryID);
+
+#ifdef _WIN32
+   if (block->Offset != -1) pool_free(block->Offset);
+#elif !defined(USE_SHM)
+   pool_free(block->Offset);
+#endif
+
+   ClearMemory(block, sizeof(PublicAddress));
+   glFreeSlots[__sync_fetch_and_add(&glSharedControl->TotalFreeSlots, 1)] = Index;
+   __sync_fetch_and_sub(&glSharedControl->BlocksUsed, 1);
 }
 
 /*****************************************************************************
-** This function works on the principle that the glSharedBlocks memory array is sorted by the address offset.  This
-** function is known to be utilised by ReleaseMemory() and MemoryPtrInfo().
+** Returns the index of the public block at Address.  This function is known to be utilised by ReleaseMemory() and
+** MemoryPtrInfo().
 **
 ** Please note that page_memory() is responsible for managing the pages that this function needs to reference.
 **
@@ -1284,12 +1732,12 @@ LONG find_public_address(SharedControl *Control, APTR Address)
    // This section is ineffective if the public memory pool is not used for this host system (the PoolSize will be zero).
 
 #ifdef STATIC_MEMORY_POOL
-   APTR pool = ResolveAddress(glSharedControl, glSharedControl->MemoryOffset);
-   if ((Address >= pool) and (Address < (char *)pool + glSharedControl->PoolSize)) {
-      for (LONG block=0; block < Control->NextBlock; block++) {
-         if (Address IS ResolveAddress(glSharedControl, glSharedControl->MemoryOffset + glSharedBlocks[block].Offset)) {
-            return block;
-         }
+   char *pool = (char *)ResolveAddress(glSharedControl, glSharedControl->MemoryOffset);
+   if ((Address >= pool) and (Address < pool + glSharedControl->PoolSize)) {
+      LONG offset = (char *)Address - pool;
+      if (!(offset % glPoolMap->Grain)) {
+         LONG grain = offset / glPoolMap->Grain;
+         if (glPoolMap->State[grain] IS PGS_ALLOC) return glPoolMap->Next[grain];
       }
 
       // The address is within the public memory pool range, but not paged as a memory block.
@@ -1310,11 +1758,8 @@ LONG find_public_address(SharedControl *Control, APTR Address)
                break; // Drop through for error
             }
 
-            for (LONG block=0; block < Control->NextBlock; block++) {
-               if (glSharedBlocks[block].MemoryID IS glMemoryPages[i].MemoryID) {
-                  return block;
-               }
-            }
+            LONG block;
+            if (!find_public_mem_id(Control, glMemoryPages[i].MemoryID, &block)) return block;
 
             log.warning("Address %p, block #%d is paged but is not in the public memory table.", glMemoryPages[i].Address, glMemoryPages[i].MemoryID);
 
@@ -1353,10 +1798,8 @@ ERROR find_public_mem_id(SharedControl *Control, MEMORYID MemoryID, LONG *EntryP
 {
    if (EntryPos) *EntryPos = 0;
 
-#if 0
-   // Binary search disabled because glSortedBlocks is not implemented yet.
    LONG floor = 0;
-   LONG ceiling = Control->NextBlock;
+   LONG ceiling = Control->TotalSorted;
    while (floor < ceiling) {
       LONG i = (floor + ceiling)>>1;
       if (MemoryID < glSortedBlocks[i].MemoryID) floor = i + 1;
@@ -1366,14 +1809,6 @@ ERROR find_public_mem_id(SharedControl *Control, MEMORYID MemoryID, LONG *EntryP
          return ERR_Okay;
       }
    }
-#else
-   for (LONG block=0; block < Control->NextBlock; block++) {
-      if (MemoryID IS glSharedBlocks[block].MemoryID) {
-         if (EntryPos) *EntryPos = block;
-         return ERR_Okay;
-      }
-   }
-#endif
 
    return ERR_MemoryDoesNotExist;
 }
@@ -23,6 +23,10 @@ Name: Messages
 #include <sys/time.h>
 #include <sys/types.h>
 #include <sys/wait.h>
+#include <poll.h>
+#ifdef __linux__
+#include <sys/epoll.h>
+#endif
 #endif
 
 #ifdef _WIN32
@@ -31,6 +35,9 @@ Name: Messages
 #include <stdio.h>
 #endif
 
+#include <thread>
+#include <vector>
+
 #include "defs.h"
 
 static ERROR wake_task(LONG Index, CSTRING);
@@ -69,6 +76,438 @@ static THREADVAR UBYTE tlMsgSent = FALSE;
 
 #define MAX_MSEC 1000
 
+/*****************************************************************************
+** Message queue management.  Refer to the MessageHeader structure for an overview of the ring buffer.
+**
+** Producers never lock the queue.  Reading is restricted to one thread at a time via the ConsumerLock, which is
+** held for the time that it takes to copy messages out of the queue and never while handlers are running.  Only the
+** consumer advances the Head, so a message remains valid for as long as the ConsumerLock is held.
+*/
+
+#define MSG_MASK (SIZE_MSGBUFFER - 1)
+#define MSG_RECORD_SIZE(a) ALIGN64(sizeof(TaskMessage) + (a))
+#define BATCH_RECORD_SIZE(a) ALIGN64(sizeof(Message) + (a))
+#define DEFAULT_MSGBUFSIZE 16384
+
+static LONG glUniqueMsgID = 1;
+
+// Messages that have been moved from the local queue by ProcessMessages() and are yet to be dispatched.  They are
+// stored as a Message structure followed by the message data.  Only accessible to the main thread.
+
+struct MessageBatch {
+   UBYTE *Buffer;
+   LONG Size;  // Allocated size of the Buffer
+   LONG Used;  // Bytes in use
+   LONG Read;  // Offset of the next message to dispatch
+};
+
+static MessageBatch glBatch = { NULL, 0, 0, 0 };
+
+//****************************************************************************
+// Returns the record at queue position Pos, or NULL if Pos refers to the tail end of the buffer that is too small to
+// hold a record.
+
+INLINE TaskMessage * msg_at(MessageHeader *Header, ULONG Pos)
+{
+   LONG offset = Pos & MSG_MASK;
+   if (SIZE_MSGBUFFER - offset < (LONG)sizeof(TaskMessage)) return NULL;
+   return (TaskMessage *)(Header->Buffer + offset);
+}
+
+INLINE ULONG next_pos(TaskMessage *Msg, ULONG Pos)
+{
+   if (Msg) return Pos + Msg->NextMsg;
+   else return Pos + (SIZE_MSGBUFFER - (Pos & MSG_MASK));
+}
+
+INLINE bool is_local_queue(MessageHeader *Header)
+{
+   return (Header IS glTaskMessageQueue) or ((glTaskEntry) and (Header->TaskIndex IS glTaskEntry->Index));
+}
+
+//****************************************************************************
+// Returns the index slot for a message type.  If Create is true, a free slot will be bound to the type if it is not
+// already indexed.  NULL is returned if the index is full.
+
+static MessageType * find_msg_type(MessageHeader *Header, LONG Type, bool Create)
+{
+   ULONG i = (ULONG)Type & (MSG_TYPE_SLOTS - 1);
+   for (LONG n=0; n < MSG_TYPE_SLOTS; n++, i = (i + 1) & (MSG_TYPE_SLOTS - 1)) {
+      auto slot = Header->Types + i;
+      LONG type = slot->Type;
+      if (type IS Type) return slot;
+      else if (!type) {
+         if (!Create) return NULL;
+         if (__sync_bool_compare_and_swap(&slot->Type, 0, Type)) return slot;
+         if (slot->Type IS Type) return slot; // Another thread bound the slot to the same type
+      }
+   }
+   return NULL;
+}
+
+//****************************************************************************
+// Claims a ready message for removal.  Returns false if another thread removed it first.
+
+INLINE bool claim_msg(TaskMessage *Msg)
+{
+   return __sync_bool_compare_and_swap(&Msg->State, MSS_READY, MSS_REMOVED);
+}
+
+// As for claim_msg(), but also confirms that the message still has the expected UniqueID.  This is required when the
+// caller is not the consumer, because the space may have been reclaimed and reused at any time.
+
+static bool claim_msg_id(TaskMessage *Msg, LONG UniqueID)
+{
+   LONG expect[2]  = { MSS_READY, UniqueID };
+   LONG replace[2] = { MSS_REMOVED, UniqueID };
+   return __sync_bool_compare_and_swap((LARGE *)&Msg->State, *(LARGE *)expect, *(LARGE *)replace);
+}
+
+// Must be called once a message has been claimed.
+
+static void msg_removed(MessageHeader *Header, LONG Type)
+{
+   if (auto slot = find_msg_type(Header, Type, false)) __sync_fetch_and_sub(&slot->Pending, 1);
+   __sync_fetch_and_sub(&Header->Count, 1);
+}
+
+// Messages that are moved to the batch remain pending in the type index until they are dispatched or removed from the
+// batch, so that MSF_NO_DUPLICATE and MSF_UPDATE continue to see them.
+
+static void batch_msg_removed(LONG Type)
+{
+   if (!glTaskMessageQueue) return;
+   if (auto slot = find_msg_type(glTaskMessageQueue, Type, false)) __sync_fetch_and_sub(&slot->Pending, 1);
+}
+
+//****************************************************************************
+
+static void lock_consumer(MessageHeader *Header)
+{
+   LONG thread = get_thread_id();
+   LARGE end = 0;
+   while (!__sync_bool_compare_and_swap(&Header->ConsumerLock, 0, thread)) {
+      if (!end) end = PreciseTime() + (2000LL * 1000LL);
+      else if (PreciseTime() > end) {
+         // The lock is only held for as long as it takes to copy messages, so the holder has probably crashed.
+         parasol::Log log(__FUNCTION__);
+         LONG holder = Header->ConsumerLock;
+         log.warning("Message queue reader lock held by thread %d is being reset.", holder);
+         __sync_bool_compare_and_swap(&Header->ConsumerLock, holder, 0);
+         end = 0;
+      }
+      std::this_thread::yield();
+   }
+}
+
+INLINE void unlock_consumer(MessageHeader *Header)
+{
+   __atomic_store_n(&Header->ConsumerLock, 0, __ATOMIC_RELEASE);
+}
+
+//****************************************************************************
+// Advances the Head past messages that have been removed.  Reclaimed space is cleared so that records written over
+// it later will start with a state of MSS_EMPTY.  Requires the ConsumerLock.
+
+static void reclaim_msgs(MessageHeader *Header)
+{
+   ULONG tail = __atomic_load_n(&Header->Tail, __ATOMIC_ACQUIRE);
+   ULONG pos  = Header->Head;
+   while (pos != tail) {
+      auto msg = msg_at(Header, pos);
+      ULONG next;
+      if (msg) {
+         LONG state = __atomic_load_n(&msg->State, __ATOMIC_ACQUIRE);
+         if ((state != MSS_REMOVED) and (state != MSS_PAD)) break;
+         next = next_pos(msg, pos);
+      }
+      else next = next_pos(NULL, pos);
+
+      ClearMemory(Header->Buffer + (pos & MSG_MASK), next - pos);
+      pos = next;
+   }
+
+   __atomic_store_n(&Header->Head, pos, __ATOMIC_RELEASE);
+}
+
+//****************************************************************************
+// Calls Routine for each message that is ready in the queue, until it returns false.  Requires the ConsumerLock.
+
+template <class T> static void scan_queue(MessageHeader *Header, T &&Routine)
+{
+   ULONG tail = __atomic_load_n(&Header->Tail, __ATOMIC_ACQUIRE);
+   for (ULONG pos=Header->Head; pos != tail; ) {
+      auto msg = msg_at(Header, pos);
+      if (msg) {
+         LONG state = __atomic_load_n(&msg->State, __ATOMIC_ACQUIRE);
+         if (state IS MSS_EMPTY) break; // The message is still being written.  Anything beyond it is not visible yet.
+         if ((state IS MSS_READY) and (!Routine(msg))) break;
+      }
+      pos = next_pos(msg, pos);
+   }
+}
+
+//****************************************************************************
+// Reserves space for a record of RecordSize bytes.  If there is not enough room at the end of the buffer, the remainder
+// is marked as padding and the record is placed at the start.  Returns NULL if the queue is full.
+
+static TaskMessage * reserve_msg(MessageHeader *Header, LONG RecordSize, ULONG *Pos)
+{
+   ULONG tail, pos, end;
+   do {
+      ULONG head = __atomic_load_n(&Header->Head, __ATOMIC_ACQUIRE); // Must be read before the Tail
+      tail = __atomic_load_n(&Header->Tail, __ATOMIC_ACQUIRE);
+      pos  = tail;
+      if ((LONG)(tail & MSG_MASK) + RecordSize > SIZE_MSGBUFFER) pos += SIZE_MSGBUFFER - (tail & MSG_MASK);
+      end = pos + RecordSize;
+      if (end - head > SIZE_MSGBUFFER) return NULL;
+   } while (!__sync_bool_compare_and_swap(&Header->Tail, tail, end));
+
+   if (pos != tail) {
+      if (auto pad = msg_at(Header, tail)) {
+         pad->NextMsg = pos - tail;
+         __atomic_store_n(&pad->State, MSS_PAD, __ATOMIC_RELEASE);
+      }
+   }
+
+   *Pos = pos;
+   return (TaskMessage *)(Header->Buffer + (pos & MSG_MASK));
+}
+
+//****************************************************************************
+// Calls Routine for each message in the batch that is yet to be dispatched.  Messages in the batch are older than
+// those in the queue, so they should be scanned first.
+
+template <class T> static void scan_batch(MessageHeader *Header, T &&Routine)
+{
+   if ((!tlMainThread) or (!is_local_queue(Header))) return;
+
+   for (LONG offset=glBatch.Read; offset < glBatch.Used; ) {
+      auto msg = (Message *)(glBatch.Buffer + offset);
+      offset += BATCH_RECORD_SIZE(msg->Size);
+      if ((msg->Type) and (!Routine(msg))) break;
+   }
+}
+
+//****************************************************************************
+// Writes a message to a queue.  Returns ERR_NothingDone if MSF_NO_DUPLICATE prevented the message from being sent.
+
+static ERROR write_msg(MessageHeader *Header, LONG Type, LONG Flags, APTR Data, LONG Size)
+{
+   auto slot = find_msg_type(Header, Type, true);
+
+   if (Flags & MSF_NO_DUPLICATE) {
+      if (slot) {
+         if (!__sync_bool_compare_and_swap(&slot->Pending, 0, 1)) return ERR_NothingDone;
+      }
+      else { // The type index is full, so fall back to a scan of the batch and the queue.
+         bool found = false;
+         scan_batch(Header, [&](Message *Msg) { return !(found = (Msg->Type IS Type)); });
+         if (!found) {
+            lock_consumer(Header);
+            scan_queue(Header, [&](TaskMessage *Msg) { return !(found = (Msg->Type IS Type)); });
+            unlock_consumer(Header);
+         }
+         if (found) return ERR_NothingDone;
+      }
+   }
+   else {
+      if (Flags & MSF_UPDATE) { // Delete the existing message of this type before adding the new one.
+         // A message that has been moved to the batch can only be removed by the main thread.  For other threads it
+         // will be dispatched as normal.
+
+         bool found = false;
+         scan_batch(Header, [&](Message *Msg) {
+            if (Msg->Type != Type) return true;
+            Msg->Type = 0;
+            if (slot) __sync_fetch_and_sub(&slot->Pending, 1);
+            found = true;
+            return false;
+         });
+
+         if (found);
+         else if (slot) {
+            if (slot->Pending > 0) {
+               LONG id  = slot->LastID;
+               ULONG pos = slot->LastPos;
+               if (pos - Header->Head < Header->Tail - Header->Head) {
+                  auto msg = msg_at(Header, pos);
+                  if ((msg) and (claim_msg_id(msg, id))) msg_removed(Header, Type);
+               }
+            }
+         }
+         else {
+            lock_consumer(Header);
+            scan_queue(Header, [&](TaskMessage *Msg) {
+               if ((Msg->Type IS Type) and (claim_msg(Msg))) {
+                  msg_removed(Header, Type);
+                  return false;
+               }
+               return true;
+            });
+            reclaim_msgs(Header);
+            unlock_consumer(Header);
+         }
+      }
+
+      if (slot) __sync_fetch_and_add(&slot->Pending, 1);
+   }
+
+   ULONG pos;
+   auto msg = reserve_msg(Header, MSG_RECORD_SIZE(Size), &pos);
+   if (!msg) {
+      if (slot) __sync_fetch_and_sub(&slot->Pending, 1);
+      return ERR_ArrayFull;
+   }
+
+   msg->UniqueID = __sync_add_and_fetch(&glUniqueMsgID, 1);
+   msg->Type     = Type;
+   msg->DataSize = Size;
+   msg->NextMsg  = MSG_RECORD_SIZE(Size);
+   msg->Time     = PreciseTime();
+   if (Size) CopyMemory(Data, msg + 1, Size);
+
+   if (slot) {
+      slot->LastID  = msg->UniqueID;
+      slot->LastPos = pos;
+   }
+
+   __sync_fetch_and_add(&Header->Count, 1);
+   __atomic_store_n(&msg->State, MSS_READY, __ATOMIC_RELEASE); // The message is now visible to the consumer
+   return ERR_Okay;
+}
+
+//****************************************************************************
+// Moves as many waiting messages as will fit from the queue to the batch buffer, so that the queue is locked once for
+// a burst of messages rather than once per message.  Returns the total number of messages moved.
+
+static LONG dequeue_batch(MessageHeader *Header)
+{
+   parasol::Log log(__FUNCTION__);
+
+   glBatch.Used = 0;
+   glBatch.Read = 0;
+
+   if (Header->Count <= 0) return 0;
+
+   lock_consumer(Header);
+
+   LONG total = 0;
+   scan_queue(Header, [&](TaskMessage *Msg) {
+      if ((Msg->DataSize < 0) or (Msg->DataSize > SIZE_MSGBUFFER)) { // Check message validity
+         log.warning("Invalid message found in queue: Type: %d, Size: %d", Msg->Type, Msg->DataSize);
+         if (claim_msg(Msg)) msg_removed(Header, Msg->Type);
+         return true;
+      }
+
+      LONG size = BATCH_RECORD_SIZE(Msg->DataSize);
+      if (glBatch.Used + size > glBatch.Size) {
+         if (glBatch.Used) return false; // The batch is full
+
+         // The message is larger than the batch buffer, so the buffer is expanded.
+
+         if (glBatch.Buffer) { FreeResource(glBatch.Buffer); glBatch.Buffer = NULL; glBatch.Size = 0; }
+         LONG bufsize = (size > DEFAULT_MSGBUFSIZE) ? size : DEFAULT_MSGBUFSIZE;
+         if (AllocMemory(bufsize, MEM_NO_CLEAR|MEM_UNTRACKED, (APTR *)&glBatch.Buffer, NULL)) return false;
+         glBatch.Size = bufsize;
+      }
+
+      if (claim_msg(Msg)) {
+         auto dest = (Message *)(glBatch.Buffer + glBatch.Used);
+         dest->UniqueID = Msg->UniqueID;
+         dest->Type     = Msg->Type;
+         dest->Size     = Msg->DataSize;
+         dest->Time     = Msg->Time;
+         CopyMemory(Msg + 1, dest + 1, Msg->DataSize);
+         glBatch.Used += size;
+         __sync_fetch_and_sub(&Header->Count, 1); // The type remains pending until the message is dispatched
+         total++;
+      }
+      return true;
+   });
+
+   reclaim_msgs(Header);
+   unlock_consumer(Header);
+   return total;
+}
+
+//****************************************************************************
+// Returns a message queue address.  The local queue is permanently mapped, so no lock is necessary to access it.
+
+static ERROR access_queue(MEMORYID QueueID, MessageHeader **Header)
+{
+   if ((QueueID IS glTaskMessageMID) and (glTaskMessageQueue)) {
+      *Header = glTaskMessageQueue;
+      return ERR_Okay;
+   }
+   else return AccessMemory(QueueID, MEM_READ_WRITE, 2000, (APTR *)Header);
+}
+
+INLINE void release_queue(MessageHeader *Header)
+{
+   if (Header != glTaskMessageQueue) ReleaseMemory(Header);
+}
+
+//****************************************************************************
+// Copies the next message that is due for dispatch to Buffer, refilling the batch from the local queue when it is
+// empty.  The message is copied so that nested calls to ProcessMessages() can safely refill the batch.
+
+static ERROR next_message(Message **Buffer, LONG *BufferSize)
+{
+   while (true) {
+      while (glBatch.Read < glBatch.Used) {
+         auto src = (Message *)(glBatch.Buffer + glBatch.Read);
+         if (!src->Type) { // Removed by GetMessage() or UpdateMessage()
+            glBatch.Read += BATCH_RECORD_SIZE(src->Size);
+            continue;
+         }
+
+         LONG size = sizeof(Message) + src->Size;
+         if ((*Buffer) and (*BufferSize < size)) {
+            FreeResource(*Buffer);
+            *Buffer = NULL;
+         }
+
+         if (!*Buffer) {
+            *BufferSize = (size > DEFAULT_MSGBUFSIZE) ? size : DEFAULT_MSGBUFSIZE;
+            if (AllocMemory(*BufferSize, MEM_NO_CLEAR, (APTR *)Buffer, NULL)) return ERR_AllocMemory;
+         }
+
+         CopyMemory(src, *Buffer, size);
+         glBatch.Read += BATCH_RECORD_SIZE(src->Size);
+         batch_msg_removed(src->Type);
+         return ERR_Okay;
+      }
+
+      MessageHeader *header;
+      if (access_queue(glTaskMessageMID, &header)) return ERR_AccessMemory;
+      LONG total = dequeue_batch(header);
+      release_queue(header);
+      if (!total) return ERR_Search;
+   }
+}
+
+//****************************************************************************
+// Called when the Task is freed.  Releases the local queue and any messages in the batch that have not been
+// dispatched.
+
+void free_task_queue(void)
+{
+   if (glTaskMessageQueue) {
+      auto queue = glTaskMessageQueue;
+      glTaskMessageQueue = NULL;
+      ReleaseMemory(queue);
+   }
+
+   if (glBatch.Buffer) {
+      FreeResource(glBatch.Buffer);
+      glBatch.Buffer = NULL;
+   }
+   glBatch.Size = 0;
+   glBatch.Used = 0;
+   glBatch.Read = 0;
+}
+
 /*****************************************************************************
 
 -FUNCTION-
@@ -191,67 +630,55 @@ ERROR GetMessage(MEMORYID MessageMID, LONG Type, LONG Flags, APTR Buffer, LONG B
 
    MessageHeader *header;
    if (Flags & MSF_ADDRESS) header = (MessageHeader *)(MAXINT)MessageMID;
-   else if (AccessMemory(MessageMID, MEM_READ_WRITE, 2000, (void **)&header) != ERR_Okay) {
+   else if (access_queue(MessageMID, &header) != ERR_Okay) {
       return ERR_AccessMemory;
    }
 
-   TaskMessage *msg = (TaskMessage *)header->Buffer;
-   TaskMessage *prevmsg = NULL;
-   LONG j = 0;
-   while (j < header->Count) {
-      if (!msg->Type) goto next;
-
-      if (Flags & MSF_MESSAGE_ID) {
-         // The Type argument actually refers to a unique message ID when MSF_MESSAGE_ID is used
-         if (msg->UniqueID != Type) goto next;
-      }
-      else if ((Type) and (msg->Type != Type)) goto next;
-
-      // Copy the message to the buffer
+   auto match = [&](LONG MsgType, LONG UniqueID) {
+      if (Flags & MSF_MESSAGE_ID) return UniqueID IS Type; // The Type argument actually refers to a unique message ID when MSF_MESSAGE_ID is used
+      else return (!Type) or (MsgType IS Type);
+   };
 
+   auto copy = [&](const Message &Header, const void *Data) {
       if ((Buffer) and ((size_t)BufferSize >= sizeof(Message))) {
-         LONG len;
-         ((Message *)Buffer)->UniqueID = msg->UniqueID;
-         ((Message *)Buffer)->Type     = msg->Type;
-         ((Message *)Buffer)->Size     = msg->DataSize;
-         ((Message *)Buffer)->Time     = msg->Time;
-         BufferSize -= sizeof(Message);
-         if (BufferSize < msg->DataSize) {
-            ((Message *)Buffer)->Size = BufferSize;
-            len = BufferSize;
-         }
-         else len = msg->DataSize;
-         CopyMemory(msg + 1, ((BYTE *)Buffer) + sizeof(Message), len);
+         auto msg = (Message *)Buffer;
+         *msg = Header;
+         LONG len = BufferSize - (LONG)sizeof(Message);
+         if (len < Header.Size) msg->Size = len;
+         else len = Header.Size;
+         CopyMemory(Data, msg + 1, len);
       }
-
-      // Remove the message from the buffer
-
-      if (prevmsg) {
-         if (msg->NextMsg) prevmsg->NextMsg += msg->NextMsg;
-         else prevmsg->NextMsg = 0;
-      }
-      else {
-         msg->Type = 0;
-         msg->DataSize = 0;
-      }
-
-      // Decrement the message count
-
-      header->CompressReset = 0;
-      header->Count--;
-      if (header->Count IS 0) header->NextEntry = 0;
-
-      if (!(Flags & MSF_ADDRESS)) ReleaseMemoryID(MessageMID);
-      return ERR_Okay;
-
-next:
-      if (msg->Type) j++;
-      prevmsg = msg;
-      msg = (TaskMessage *)ResolveAddress(msg, msg->NextMsg);
+   };
+
+   ERROR error = ERR_Search;
+
+   scan_batch(header, [&](Message *Msg) {
+      if (!match(Msg->Type, Msg->UniqueID)) return true;
+      copy(*Msg, Msg + 1);
+      batch_msg_removed(Msg->Type);
+      Msg->Type = 0; // Remove the message from the batch
+      error = ERR_Okay;
+      return false;
+   });
+
+   if (error) {
+      lock_consumer(header);
+
+      scan_queue(header, [&](TaskMessage *Msg) {
+         if (!match(Msg->Type, Msg->UniqueID)) return true;
+         if (!claim_msg(Msg)) return true;
+         copy(Message { Msg->Time, Msg->UniqueID, Msg->Type, Msg->DataSize }, Msg + 1);
+         msg_removed(header, Msg->Type);
+         error = ERR_Okay;
+         return false;
+      });
+
+      if (!error) reclaim_msgs(header);
+      unlock_consumer(header);
    }
 
-   if (!(Flags & MSF_ADDRESS)) ReleaseMemoryID(MessageMID);
-   return ERR_Search;
+   if (!(Flags & MSF_ADDRESS)) release_queue(header);
+   return error;
 }
 
 /*****************************************************************************
@@ -327,10 +754,6 @@ ERROR ProcessMessages(LONG Flags, LONG TimeOut)
    BYTE breaking = FALSE;
    ERROR error;
 
-   #ifdef DEBUG
-      LARGE periodic = PreciseTime();
-   #endif
-
    if (!tlMainThread) { // Message handler for threads.
       UBYTE buffer[2048];
       LONG offset = 0;
@@ -450,18 +873,19 @@ ERROR ProcessMessages(LONG Flags, LONG TimeOut)
       } // while(TRUE)
    }
    else do { // Standard message handler for the core process.
-      // Call all objects on the timer list (managed by SubscribeTimer()).  To manage timer locking cleanly, the loop
-      // is restarted after each client call.  To prevent more than one call per cycle, the glTimerCycle is used to
-      // prevent secondary calls.
+      // Call all objects on the timer list (managed by SubscribeTimer()).  glTimers is ordered by NextCall, so only
+      // expired timers are visited and the front of the queue is re-read after each client call.  To prevent more than
+      // one call per cycle, the glTimerCycle is used to prevent secondary calls.  A timer that has already been called
+      // in this cycle will halt the scan; any timers behind it are picked up on the next cycle.
 
       glTimerCycle++;
-timer_cycle:
       if ((glTaskState IS TSTATE_STOPPING) and (!(Flags & PMF_SYSTEM_NO_BREAK)));
       else if (!thread_lock(TL_TIMER, 200)) {
          LARGE current_time = PreciseTime();
-         for (auto timer=glTimers.begin(); timer != glTimers.end(); ) {
-            if (current_time < timer->NextCall) { timer++; continue; }
-            if (timer->Cycle IS glTimerCycle) { timer++; continue; }
+         CoreTimer *timer;
+         while ((timer = glTimers.next())) {
+            if (current_time < timer->NextCall) break;
+            if (timer->Cycle IS glTimerCycle) break;
 
             LARGE elapsed = current_time - timer->LastCall;
 
@@ -469,6 +893,7 @@ timer_cycle:
             if (timer->NextCall < current_time) timer->NextCall = current_time;
             timer->LastCall = current_time;
             timer->Cycle = glTimerCycle;
+            glTimers.reschedule(timer);
 
             //log.trace("Subscriber: %d, Interval: %d, Time: " PF64(), timer->SubscriberID, timer->Interval, current_time);
 
@@ -514,105 +939,35 @@ timer_cycle:
             }
             else error = ERR_Terminate;
 
+            if (relock) {
+               thread_lock(TL_TIMER, -1);
+               current_time = PreciseTime();
+            }
+
             timer->Locked = false;
 
             if (error IS ERR_Terminate) {
+               glTimers.remove(timer);
+
                if (timer->Routine.Type IS CALL_SCRIPT) {
+                  thread_unlock(TL_TIMER);
                   scDerefProcedure(timer->Routine.Script.Script, &timer->Routine);
+                  thread_lock(TL_TIMER, -1);
                }
 
-               timer = glTimers.erase(timer);
+               delete timer;
             }
-            else timer++;
-
-            if (relock) goto timer_cycle;
-         } // for
+         }
 
          thread_unlock(TL_TIMER);
       }
 
-      // This sub-routine consumes all of the queued messages
+      // This sub-routine consumes all of the queued messages.  Messages are removed from the queue in batches and then
+      // dispatched one at a time.
 
       WORD msgcount = 0;
       BYTE repass = FALSE;
-      while (1) {
-         MessageHeader *msgbuffer;
-         BYTE msgfound = FALSE;
-         if (!AccessMemory(glTaskMessageMID, MEM_READ_WRITE, 2000, (void **)&msgbuffer)) {
-            if (msgbuffer->Count) {
-               auto scanmsg = (TaskMessage *)msgbuffer->Buffer;
-               TaskMessage *prevmsg = NULL;
-
-               #ifdef DEBUG
-               if (PreciseTime() - periodic > 1000000LL) {
-                  periodic = PreciseTime();
-                  log.trace("Message count: %d", msgbuffer->Count);
-               }
-               #endif
-
-               while (1) {
-                  if (!scanmsg->Type); // Ignore removed messages.
-                  else if ((scanmsg->DataSize < 0) or (scanmsg->DataSize > 1024 * 1024)) { // Check message validity
-                     log.warning("Invalid message found in queue: Type: %d, Size: %d", scanmsg->Type, scanmsg->DataSize);
-                     scanmsg->Type = 0;
-                     scanmsg->DataSize = 0;
-                  }
-                  else { // Message found.  Process it.
-                     if ((msg) and ((size_t)msgbufsize < sizeof(Message) + scanmsg->DataSize)) { // Is our message buffer large enough?
-                        log.trace("Freeing message buffer for expansion %d < %d + %d", msgbufsize, sizeof(Message), scanmsg->DataSize);
-                        FreeResource(msg);
-                        msg = NULL;
-                     }
-
-                     if (!msg) {
-                        #define DEFAULT_MSGBUFSIZE 16384
-
-                        if (sizeof(Message) + scanmsg->DataSize  > DEFAULT_MSGBUFSIZE) {
-                           msgbufsize = sizeof(Message) + scanmsg->DataSize;
-                        }
-                        else msgbufsize = DEFAULT_MSGBUFSIZE;
-
-                        if (AllocMemory(msgbufsize, MEM_NO_CLEAR, (APTR *)&msg, NULL) != ERR_Okay) break;
-                     }
-
-                     ((Message *)msg)->UniqueID = scanmsg->UniqueID;
-                     ((Message *)msg)->Type     = scanmsg->Type;
-                     ((Message *)msg)->Size     = scanmsg->DataSize;
-                     ((Message *)msg)->Time     = scanmsg->Time;
-                     CopyMemory(scanmsg + 1, ((BYTE *)msg) + sizeof(Message), scanmsg->DataSize);
-
-                     // Remove the message from the buffer
-
-                     if (prevmsg) {
-                        if (scanmsg->NextMsg) prevmsg->NextMsg += scanmsg->NextMsg;
-                        else prevmsg->NextMsg = 0;
-                     }
-                     else {
-                        scanmsg->Type = 0;
-                        scanmsg->DataSize = 0;
-                     }
-
-                     // Decrement the message count
-
-                     msgbuffer->CompressReset = 0;
-                     msgbuffer->Count--;
-                     if (msgbuffer->Count IS 0) msgbuffer->NextEntry = 0;
-                     msgfound = TRUE;
-                     break;
-                  }
-
-                  // Go to next message
-                  prevmsg = scanmsg;
-                  if (scanmsg->NextMsg) scanmsg = (TaskMessage *)ResolveAddress(scanmsg, scanmsg->NextMsg);
-                  else break;
-               } // while(1)
-            }
-
-            ReleaseMemoryID(glTaskMessageMID);
-         }
-
-         if (!msgfound) break;
-
+      while (!next_message(&msg, &msgbufsize)) {
          tlCurrentMsg = (Message *)msg; // This global variable is available through GetResourcePtr(RES_CURRENTMSG)
 
          if ((msg->Type IS MSGID_BREAK) and (tlMsgRecursion > 1)) breaking = TRUE; // MSGID_BREAK will break out of recursive calls to ProcessMessages() only
@@ -660,7 +1015,7 @@ timer_cycle:
             repass = TRUE;
             break; // Break if there are a lot of messages, so that we can call message hooks etc
          }
-      } // while(1)
+      }
 
       // This code is used to validate suspect processes
 
@@ -686,14 +1041,16 @@ timer_cycle:
       LARGE wait = 0;
       if ((repass) or (breaking) or ((glTaskState IS TSTATE_STOPPING) and (!(Flags & PMF_SYSTEM_NO_BREAK))));
       else if (timeout_end > 0) {
-         // Wait for someone to communicate with us, or stall until an interrupt is due.
+         // Wait for someone to communicate with us, or stall until an interrupt is due.  The next timer is always at
+         // the front of glTimers.  The sleep period is rounded up to the millisecond so that the task does not wake
+         // before the timer has expired.
 
          LARGE sleep_time = timeout_end;
          {
             ThreadLock lock(TL_TIMER, 200);
             if (lock.granted()) {
-               for (const auto &timer : glTimers) {
-                  if (timer.NextCall < sleep_time) sleep_time = timer.NextCall;
+               if (auto timer = glTimers.next()) {
+                  if (timer->NextCall < sleep_time) sleep_time = timer->NextCall;
                }
             }
          }
@@ -707,7 +1064,7 @@ timer_cycle:
       #ifdef _WIN32
          if (tlMainThread) {
             tlMessageBreak = TRUE;  // Break if the host OS sends us a native message
-            sleep_task(wait / 1000LL, FALSE); // Even if wait is zero, we still need to clear FD's and call FD hooks
+            sleep_task((wait + 999LL) / 1000LL, FALSE); // Even if wait is zero, we still need to clear FD's and call FD hooks
             tlMessageBreak = FALSE;
 
             if (wait) {
@@ -719,7 +1076,7 @@ timer_cycle:
          else {
          }
       #else
-         sleep_task(wait / 1000LL); // Event if wait is zero, we still need to clear FD's and call FD hooks
+         sleep_task((wait + 999LL) / 1000LL); // Event if wait is zero, we still need to clear FD's and call FD hooks
       #endif
 
       // Continue the loop?
@@ -797,52 +1154,47 @@ ERROR ScanMessages(APTR MessageQueue, LONG *Index, LONG Type, APTR Buffer, LONG
    if ((!MessageQueue) or (!Index)) return log.warning(ERR_NullArgs);
    if (!Buffer) BufferSize = 0;
 
-   MessageHeader *header = (MessageHeader *)MessageQueue;
-   TaskMessage *msg, *prevmsg = NULL;
-
-   LONG j = 0;
-
-   if (*Index > 0) {
-      msg = (TaskMessage *)header->Buffer;
-      while ((j < header->Count) and (j < *Index)) {
-         if (msg->Type) j++;
-         prevmsg = msg;
-         if (!msg->NextMsg) break;
-         msg = (TaskMessage *)ResolveAddress(msg, msg->NextMsg);
-      }
-   }
-   else if (*Index < 0) {
+   if (*Index < 0) {
       *Index = -1;
       return ERR_Search;
    }
-   else msg = (TaskMessage *)header->Buffer;
-
-   while (j < header->Count) {
-      if ((msg->Type) and ((msg->Type IS Type) or (!Type))) {
-         if ((Buffer) and ((size_t)BufferSize >= sizeof(Message))) {
-            ((Message *)Buffer)->UniqueID = msg->UniqueID;
-            ((Message *)Buffer)->Type     = msg->Type;
-            ((Message *)Buffer)->Size     = msg->DataSize;
-            ((Message *)Buffer)->Time     = msg->Time;
-
-            BufferSize -= sizeof(Message);
-            if (BufferSize < msg->DataSize) {
-               ((Message *)Buffer)->Size = BufferSize;
-               CopyMemory(msg + 1, ((BYTE *)Buffer) + sizeof(Message), BufferSize);
-            }
-            else CopyMemory(msg + 1, ((BYTE *)Buffer) + sizeof(Message), msg->DataSize);
-         }
 
-         *Index = j + 1;
-         return ERR_Okay;
+   auto header = (MessageHeader *)MessageQueue;
+
+   // Messages are counted in order of arrival, so the Index can skip those that have already been analysed.
+
+   LONG j = 0;
+   bool found = false;
+   auto check = [&](const Message &Msg, const void *Data) {
+      if (j++ < *Index) return true;
+      if ((Type) and (Msg.Type != Type)) return true;
+
+      if ((Buffer) and ((size_t)BufferSize >= sizeof(Message))) {
+         auto msg = (Message *)Buffer;
+         *msg = Msg;
+         LONG len = BufferSize - (LONG)sizeof(Message);
+         if (len < Msg.Size) msg->Size = len;
+         else len = Msg.Size;
+         CopyMemory(Data, msg + 1, len);
       }
 
-      if (msg->Type) j++;
-      prevmsg = msg;
-      if (!msg->NextMsg) break;
-      msg = (TaskMessage *)ResolveAddress(msg, msg->NextMsg);
+      *Index = j;
+      found = true;
+      return false;
+   };
+
+   scan_batch(header, [&](Message *Msg) { return check(*Msg, Msg + 1); });
+
+   if (!found) {
+      lock_consumer(header);
+      scan_queue(header, [&](TaskMessage *Msg) {
+         return check(Message { Msg->Time, Msg->UniqueID, Msg->Type, Msg->DataSize }, Msg + 1);
+      });
+      unlock_consumer(header);
    }
 
+   if (found) return ERR_Okay;
+
    *Index = -1;
    return ERR_Search;
 }
@@ -878,30 +1230,25 @@ AccessMemory: Access to the message queue memory was denied.
 
 *****************************************************************************/
 
-static LONG glUniqueMsgID = 1;
-
 static void view_messages(MessageHeader *Header) __attribute__ ((unused));
 
 static void view_messages(MessageHeader *Header)
 {
    parasol::Log log("Messages");
 
-   log.warning("Count: %d, Next: %d", Header->Count, Header->NextEntry);
+   log.warning("Count: %d, Head: %u, Tail: %u", Header->Count, Header->Head, Header->Tail);
 
-   auto msg = (TaskMessage *)Header->Buffer;
-   WORD count = 0;
-   while (count < Header->Count) {
-      if (msg->Type) {
-         if (msg->Type IS MSGID_ACTION) {
-            ActionMessage *action = (ActionMessage *)(msg + 1);
-            if (action->ActionID > 0) log.warning("Action: %s, Object: %d, Args: %d [Size: %d, Next: %d]", ActionTable[action->ActionID].Name, action->ObjectID, action->SendArgs, msg->DataSize, msg->NextMsg);
-            else log.warning("Method: %d, Object: %d, Args: %d [Size: %d, Next: %d]", action->ActionID, action->ObjectID, action->SendArgs, msg->DataSize, msg->NextMsg);
-         }
-         else log.warning("Type: %d, Size: %d, Next: %d", msg->Type, msg->DataSize, msg->NextMsg);
-         count++;
+   lock_consumer(Header);
+   scan_queue(Header, [&](TaskMessage *Msg) {
+      if (Msg->Type IS MSGID_ACTION) {
+         auto action = (ActionMessage *)(Msg + 1);
+         if (action->ActionID > 0) log.warning("Action: %s, Object: %d, Args: %d [Size: %d, Next: %d]", ActionTable[action->ActionID].Name, action->ObjectID, action->SendArgs, Msg->DataSize, Msg->NextMsg);
+         else log.warning("Method: %d, Object: %d, Args: %d [Size: %d, Next: %d]", action->ActionID, action->ObjectID, action->SendArgs, Msg->DataSize, Msg->NextMsg);
       }
-      msg = (TaskMessage *)ResolveAddress(msg, msg->NextMsg);
-   }
+      else log.warning("Type: %d, Size: %d, Next: %d", Msg->Type, Msg->DataSize, Msg->NextMsg);
+      return true;
+   });
+   unlock_consumer(Header);
 }
 
 ERROR SendMessage(MEMORYID MessageMID, LONG Type, LONG Flags, APTR Data, LONG Size)
@@ -924,162 +1271,37 @@ ERROR SendMessage(MEMORYID MessageMID, LONG Type, LONG Flags, APTR Data, LONG Si
       Size = 0;
    }
 
-   LONG msgsize = (Size + 3) & (~3); // Raise the size if not long-word aligned
+   if (MSG_RECORD_SIZE(Size) > SIZE_MSGBUFFER) {
+      log.warning("Message size of %d bytes exceeds the capacity of the queue.", Size);
+      return ERR_ArrayFull;
+   }
 
-   LONG i;
-   ERROR error;
-   TaskMessage *msg, *prevmsg;
    MessageHeader *header;
-   if (!(error = AccessMemory(MessageMID, MEM_READ_WRITE, 2000, (void **)&header))) {
-      if (Flags & (MSF_NO_DUPLICATE|MSF_UPDATE)) {
-         msg = (TaskMessage *)header->Buffer;
-         prevmsg = NULL;
-         i = 0;
-         while (i < header->Count) {
-            if (msg->Type IS Type) {
-               if (Flags & MSF_NO_DUPLICATE) {
-                  ReleaseMemoryID(MessageMID);
-                  return ERR_Okay;
-               }
-               else {
-                  // Delete the existing message type before adding the new one when the MF_UPDATE flag has been specified.
-
-                  if (prevmsg) {
-                     if (msg->NextMsg) prevmsg->NextMsg += msg->NextMsg;
-                     else prevmsg->NextMsg = 0;
-                  }
-                  else {
-                     msg->UniqueID = 0;
-                     msg->Type     = 0;
-                     msg->DataSize = 0;
-                     msg->Time     = 0;
-                  }
-
-                  // Decrement the message count
-
-                  header->Count--;
-                  if (header->Count IS 0) header->NextEntry = 0;
-                  break;
-               }
-            }
-            if (msg->Type) i++;
-            prevmsg = msg;
-            msg = (TaskMessage *)ResolveAddress(msg, msg->NextMsg);
-         }
-      }
-
-      if ((header->NextEntry + sizeof(TaskMessage) + msgsize) >= SIZE_MSGBUFFER) {
-
-         if (header->CompressReset) {
-            // Do nothing if we've already tried compression and no messages have been pulled off the queue since that time.
-            log.warning("Message buffer %d is at capacity.", MessageMID);
-            ReleaseMemoryID(MessageMID);
-            return ERR_ArrayFull;
-         }
-
-         // Compress the message buffer
-         // Suspect that this compression routine corrupts the message queue.
-
-//         LONG j, nextentry, nextoffset;
-//         log.msg("Compressing message buffer #%d.", MessageMID);
-//
-//         msg = (TaskMessage *)header->Buffer;
-//         nextentry = 0; // Set the next entry point to position zero to start the compression
-//         j = 0;
-//         while (j < header->Count) {
-//            nextoffset = msg->NextMsg; // Get the offset to the next message
-//            if (msg->Type) {
-//               CopyMemory(msg, header->Buffer + nextentry, sizeof(TaskMessage) + msg->DataSize);
-//               nextentry += sizeof(TaskMessage) + ((msg->DataSize + 3) & ~3);
-//               j++;
-//            }
-//            if (!nextoffset) break;
-//            msg = (TaskMessage *)ResolveAddress(msg, nextoffset);
-//         }
-//         header->NextEntry = nextentry;
-
-         // This routine is slower than the normal compression technique, but is tested as working.
-
-         MessageHeader *buffer;
-         if (!AllocMemory(sizeof(MessageHeader), MEM_DATA|MEM_NO_CLEAR, (APTR *)&buffer, NULL)) {
-            // Compress the message buffer to a temporary data store
-
-            buffer->NextEntry = 0;
-            buffer->TaskIndex = header->TaskIndex;
-            /*
-            #ifdef _WIN32
-               buffer->MsgProcess = header->MsgProcess;
-               buffer->MsgSemaphore = header->MsgSemaphore;
-            #else
-               buffer->Mutex = header->Mutex;
-            #endif
-            */
-
-            auto srcmsg  = (TaskMessage *)header->Buffer;
-            auto destmsg = (TaskMessage *)buffer->Buffer;
-            for (buffer->Count=0; buffer->Count < header->Count;) {
-               if (srcmsg->Type) {
-                  CopyMemory(srcmsg, destmsg, sizeof(TaskMessage) + srcmsg->DataSize);
-                  destmsg->NextMsg = sizeof(TaskMessage) + ((srcmsg->DataSize + 3) & ~3);
-                  buffer->NextEntry += destmsg->NextMsg;
-                  destmsg = (TaskMessage *)ResolveAddress(destmsg, destmsg->NextMsg);
-                  buffer->Count++;
-               }
-               srcmsg = (TaskMessage *)ResolveAddress(srcmsg, srcmsg->NextMsg);
-            }
-
-            CopyMemory(buffer, header, sizeof(MessageHeader)); // Copy our new message buffer over the old one
-            FreeResource(buffer);
-         }
-
-         log.debug("Buffer compressed to %d bytes, %d messages on the queue.", header->NextEntry, header->Count);
-
-         // Check if space is now available
-
-         if ((header->NextEntry + sizeof(TaskMessage) + msgsize) >= SIZE_MSGBUFFER) {
-            log.warning("Message buffer %d is at capacity and I cannot compress the queue.", MessageMID);
-
-            //view_messages(header);
-
-            header->CompressReset = 1;
-            ReleaseMemoryID(MessageMID);
-            return ERR_ArrayFull;
-         }
-      }
-
-      // Set up the message entry
-
-      msg = (TaskMessage *)(header->Buffer + header->NextEntry);
-      msg->UniqueID = __sync_add_and_fetch(&glUniqueMsgID, 1);
-      msg->Type     = Type;
-      msg->DataSize = Size;
-      msg->NextMsg  = sizeof(TaskMessage) + msgsize;
-      msg->Time     = PreciseTime();
-
-      // Copy the message data, if given
+   ERROR error;
+   if ((error = access_queue(MessageMID, &header))) {
+      log.warning("Could not gain access to message port #%d: %s", MessageMID, glMessages[error]);
+      return error; // Important that the original AccessMemory() error is returned (some code depends on this for detailed clarification)
+   }
 
-      if ((Data) and (msgsize)) CopyMemory(Data, msg + 1, Size);
+   error = write_msg(header, Type, Flags, Data, Size);
+   WORD taskindex = header->TaskIndex;
+   release_queue(header);
 
-      header->NextEntry += msg->NextMsg;
-      header->Count++;
-      header->CompressReset = 0;
+   if (error IS ERR_NothingDone) return ERR_Okay; // MSF_NO_DUPLICATE and the message type is already queued
+   else if (error IS ERR_ArrayFull) {
+      log.warning("Message buffer %d is at capacity.", MessageMID);
+      return ERR_ArrayFull;
+   }
 
-      // Alert the foreign process to indicate that there are messages available.
+   // Alert the foreign process to indicate that there are messages available.
 
-      WORD taskindex = header->TaskIndex;
-      ReleaseMemoryID(MessageMID);
-      wake_task(taskindex, __func__);
+   wake_task(taskindex, __func__);
 
-      #ifdef _WIN32
-         tlMsgSent = TRUE;
-      #endif
+   #ifdef _WIN32
+      tlMsgSent = TRUE;
+   #endif
 
-      return ERR_Okay;
-   }
-   else {
-      log.warning("Could not gain access to message port #%d: %s", MessageMID, glMessages[error]);
-      return error; // Important that the original AccessMemory() error is returned (some code depends on this for detailed clarification)
-   }
+   return ERR_Okay;
 }
 
 /*****************************************************************************
@@ -1191,11 +1413,10 @@ ERROR send_thread_msg(LONG Handle, LONG Type, APTR Data, LONG Size)
 
    log.function("Type: %d, Data: %p, Size: %d", Type, Data, Size);
 
-   TaskMessage msg;
+   Message msg;
    msg.UniqueID = __sync_add_and_fetch(&glUniqueMsgID, 1);
    msg.Type     = Type;
-   msg.DataSize = Size;
-   msg.NextMsg  = sizeof(TaskMessage) + Size;
+   msg.Size     = Size;
    msg.Time     = PreciseTime();
 
 #ifdef _WIN32
@@ -1307,33 +1528,51 @@ ERROR UpdateMessage(APTR Queue, LONG MessageID, LONG Type, APTR Buffer, LONG Buf
    if ((!Queue) or (!MessageID)) return log.warning(ERR_NullArgs);
 
    auto header = (MessageHeader *)Queue;
-   auto msg = (TaskMessage *)header->Buffer;
-   TaskMessage *prevmsg = NULL;
-   LONG j = 0;
-   while (j < header->Count) {
-      if (msg->UniqueID IS MessageID) {
-         if (Buffer) {
-            LONG len = (BufferSize > msg->DataSize) ? msg->DataSize : BufferSize;
-            CopyMemory(Buffer, msg + 1, len);
-         }
+   ERROR error = ERR_Search;
+
+   scan_batch(header, [&](Message *Msg) {
+      if (Msg->UniqueID != MessageID) return true;
+      if (Buffer) CopyMemory(Buffer, Msg + 1, (BufferSize > Msg->Size) ? Msg->Size : BufferSize);
+      if (Type IS -1) { // Delete the message from the batch
+         batch_msg_removed(Msg->Type);
+         Msg->Type = 0;
+      }
+      else if ((Type) and (Type != Msg->Type)) {
+         if (auto slot = find_msg_type(header, Type, true)) __sync_fetch_and_add(&slot->Pending, 1);
+         batch_msg_removed(Msg->Type);
+         Msg->Type = Type;
+      }
+      error = ERR_Okay;
+      return false;
+   });
+
+   if (error) {
+      lock_consumer(header);
+
+      scan_queue(header, [&](TaskMessage *Msg) {
+         if (Msg->UniqueID != MessageID) return true;
+
+         if (Buffer) CopyMemory(Buffer, Msg + 1, (BufferSize > Msg->DataSize) ? Msg->DataSize : BufferSize);
 
          if (Type IS -1) { // Delete the message from the queue
-            if (msg->Type) {
-               msg->Type = 0;
-               header->Count--;
-            }
+            if (claim_msg(Msg)) msg_removed(header, Msg->Type);
+         }
+         else if ((Type) and (Type != Msg->Type)) { // Move the message to its new type in the index
+            if (auto slot = find_msg_type(header, Type, true)) __sync_fetch_and_add(&slot->Pending, 1);
+            if (auto slot = find_msg_type(header, Msg->Type, false)) __sync_fetch_and_sub(&slot->Pending, 1);
+            Msg->Type = Type;
          }
-         else if (Type) msg->Type = Type;
 
-         return ERR_Okay;
-      }
+         error = ERR_Okay;
+         return false;
+      });
 
-      if (msg->Type) j++;
-      prevmsg = msg;
-      msg = (TaskMessage *)ResolveAddress(msg, msg->NextMsg);
+      if (Type IS -1) reclaim_msgs(header);
+      unlock_consumer(header);
    }
 
-   return log.warning(ERR_Search);
+   if (error) return log.warning(error);
+   return ERR_Okay;
 }
 
 /*****************************************************************************
@@ -1372,146 +1611,357 @@ ERROR WakeProcess(LONG ProcessID)
 }
 
 /*****************************************************************************
-** Function: sleep_task() - Unix version
+** On Linux, registered descriptors are monitored with an edge-triggered epoll instance that is maintained by
+** RegisterFD(), so sleep_task() does not need to rebuild anything before it sleeps.  Because an edge is only reported
+** once, each descriptor is polled after its routines have been called.  If it is still ready (the routine did not
+** drain it, or a socket remains writeable) it is queued in glFDPending and dispatched on the next call to sleep_task()
+** without sleeping.  This preserves the level-triggered behaviour of select(), which remains in use on other Unix
+** systems and if epoll is unavailable.
 */
 
 #ifdef __unix__
-ERROR sleep_task(LONG Timeout)
+
+#define MAX_EPOLL_EVENTS 64
+
+struct FDEvent {
+   HOSTHANDLE FD;
+   LONG Events; // RFD_READ, RFD_WRITE
+};
+
+static std::vector<FDEvent> glFDPending;
+
+//****************************************************************************
+// Returns true if descriptors are monitored with select().  The epoll instance is created on the first call.
+
+bool use_select(void)
 {
-   parasol::Log log(__FUNCTION__);
+#ifdef __linux__
+   if (glEpollFD IS -1) {
+      if ((glEpollFD = epoll_create1(EPOLL_CLOEXEC)) IS -1) {
+         parasol::Log log(__FUNCTION__);
+         log.warning("epoll_create1() failed, falling back to select(): %s", strerror(errno));
+         glEpollFD = -2; // Do not try again
+      }
+   }
+   return glEpollFD < 0;
+#else
+   return true;
+#endif
+}
 
-   if (!tlMainThread) {
-      log.warning("Only the main thread can call this function.");
-      return ERR_Failed;
+//****************************************************************************
+
+static void queue_fd(HOSTHANDLE FD, LONG Events)
+{
+   for (auto &pending : glFDPending) {
+      if (pending.FD IS FD) {
+         pending.Events |= Events;
+         return;
+      }
    }
-   else if (tlPublicLockCount > 0) {
-      log.warning("Cannot sleep while holding %d global locks.", tlPublicLockCount);
-      return ERR_Okay;
+   glFDPending.push_back({ FD, Events });
+}
+
+#endif
+
+//****************************************************************************
+// Brings the epoll registration of FD in line with its records in glFDTable.  OldEvents must be the result of
+// fd_events() prior to the records being modified.
+
+void update_fd_events(HOSTHANDLE FD, LONG OldEvents)
+{
+#ifdef __linux__
+   if ((FD < 0) or (use_select())) return;
+
+   LONG events = fd_events(FD) & (RFD_READ|RFD_WRITE);
+   if (events IS (OldEvents & (RFD_READ|RFD_WRITE))) return;
+
+   struct epoll_event ev;
+   ev.data.u64 = 0;
+   ev.data.fd  = FD;
+   ev.events   = EPOLLET | ((events & RFD_READ) ? EPOLLIN : 0) | ((events & RFD_WRITE) ? EPOLLOUT : 0);
+
+   if (!events) { // Fails harmlessly if the FD was closed prior to deregistration
+      epoll_ctl(glEpollFD, EPOLL_CTL_DEL, FD, &ev);
+      return;
    }
-   else if (tlPrivateLockCount != 0) {
-      char buffer[120];
-      size_t pos = 0;
-      for (const auto & [ id, mem ] : glPrivateMemory) {
-         if (mem.AccessCount > 0) {
-            pos += snprintf(buffer+pos, sizeof(buffer)-pos, "%d.%d ", mem.MemoryID, mem.AccessCount);
-            if (pos >= sizeof(buffer)-1) break;
+
+   // A closed and reused FD may have been dropped by the kernel without our knowledge, so a failed modification is
+   // retried as an addition and vice versa.  Modifying a registration re-evaluates the descriptor, so any readiness
+   // that already exists is reported by the next epoll_wait().
+
+   LONG op = (OldEvents & (RFD_READ|RFD_WRITE)) ? EPOLL_CTL_MOD : EPOLL_CTL_ADD;
+   if (epoll_ctl(glEpollFD, op, FD, &ev) IS -1) {
+      if ((op IS EPOLL_CTL_MOD) and (errno IS ENOENT)) op = EPOLL_CTL_ADD;
+      else if ((op IS EPOLL_CTL_ADD) and (errno IS EEXIST)) op = EPOLL_CTL_MOD;
+      else op = -1;
+
+      if ((op IS -1) or (epoll_ctl(glEpollFD, op, FD, &ev) IS -1)) {
+         if (errno IS EPERM) queue_fd(FD, events); // Regular files are not supported by epoll, but select() treats them as always ready
+         else {
+            parasol::Log log(__FUNCTION__);
+            log.warning("epoll_ctl() failed for FD %d: %s", FD, strerror(errno));
          }
       }
+   }
+#endif
+}
 
-      if (pos > 0) log.warning("WARNING - Sleeping with %d private locks held (%s)", tlPrivateLockCount, buffer);
+//****************************************************************************
+// Called on shutdown.
+
+void free_fd_table(void)
+{
+   if (glFDTable) {
+      free(glFDTable);
+      glFDTable = NULL;
    }
+   glTotalFDs    = 0;
+   glFDTableSize = 0;
+   glFDCallers   = 0;
 
-   struct timeval tv;
-   struct timespec time;
-   fd_set fread, fwrite;
+#ifdef __unix__
+   glFDPending.clear();
+   glFDPending.shrink_to_fit();
+#endif
 
-   //log.trace("Time-out: %d", Timeout);
+#ifdef __linux__
+   if (glEpollFD >= 0) close(glEpollFD);
+   glEpollFD = -1;
+#endif
+}
 
-   LONG maxfd = -1;
-   if (glTotalFDs > 0) {
-      FD_ZERO(&fread);
-      FD_ZERO(&fwrite);
-      for (LONG i=0; i < glTotalFDs; i++) {
-         if (glFDTable[i].Flags & RFD_STOP_RECURSE) continue; // This is an internally managed flag to prevent recursion
-         if (glFDTable[i].Flags & RFD_READ) FD_SET(glFDTable[i].FD, &fread);
-         if (glFDTable[i].Flags & RFD_WRITE) FD_SET(glFDTable[i].FD, &fwrite);
-         //log.trace("Listening to %d, Read: %d, Write: %d, Routine: %p, Flags: $%.2x", glFDTable[i].FD, (glFDTable[i].Flags & RFD_READ) ? 1 : 0, (glFDTable[i].Flags & RFD_WRITE) ? 1 : 0, glFDTable[i].Routine, glFDTable[i].Flags);
-         if (glFDTable[i].FD > maxfd) maxfd = glFDTable[i].FD;
-
-         if (glFDTable[i].Flags & RFD_ALWAYS_CALL) {
-            if (glFDTable[i].Routine) glFDTable[i].Routine(glFDTable[i].FD, glFDTable[i].Data);
+#ifdef __unix__
+
+//****************************************************************************
+// Queues FD for another dispatch if it is still ready after its routines have been called.
+
+static void check_fd(HOSTHANDLE FD)
+{
+   LONG events = fd_events(FD) & (RFD_READ|RFD_WRITE);
+   if (!events) return; // The routine deregistered the FD
+
+   struct pollfd pfd = { FD, (short)(((events & RFD_READ) ? POLLIN : 0) | ((events & RFD_WRITE) ? POLLOUT : 0)), 0 };
+   if (poll(&pfd, 1, 0) <= 0) return;
+
+   if (pfd.revents & POLLNVAL) {
+      parasol::Log log(__FUNCTION__);
+      log.warning("FD %d was closed without a call to deregister it.", FD);
+      RegisterFD(FD, RFD_REMOVE|RFD_READ|RFD_WRITE|RFD_EXCEPT, NULL, NULL);
+      return;
+   }
+
+   LONG ready = 0;
+   if (pfd.revents & (POLLIN|POLLHUP|POLLERR)) ready |= RFD_READ;
+   if (pfd.revents & (POLLOUT|POLLHUP|POLLERR)) ready |= RFD_WRITE;
+   if (ready & events) queue_fd(FD, ready & events);
+}
+
+//****************************************************************************
+// Calls the read and/or write routines that are registered against FD.  The routines can modify glFDTable, so records
+// are always located afresh.
+
+static void dispatch_fd(HOSTHANDLE FD, LONG Events)
+{
+   static const LONG types[2] = { RFD_READ, RFD_WRITE };
+   bool called = false;
+
+   for (auto type : types) {
+      if (!(Events & type)) continue;
+
+      LONG i;
+      for (i=find_fd(FD); (i < glTotalFDs) and (glFDTable[i].FD IS FD); i++) {
+         if (glFDTable[i].Flags & type) break;
+      }
+
+      if ((i >= glTotalFDs) or (glFDTable[i].FD != FD)) continue;
+      if (glFDTable[i].Flags & RFD_STOP_RECURSE) continue; // This is an internally managed flag to prevent recursion
+
+      if (!(glFDTable[i].Flags & RFD_ALLOW_RECURSION)) glFDTable[i].Flags |= RFD_STOP_RECURSE;
+
+      auto routine = glFDTable[i].Routine;
+      if (routine) routine(FD, glFDTable[i].Data);
+      else if (type IS RFD_READ) {
+         UBYTE buffer[64];
+         if (FD IS glSocket) {
+            socklen_t socklen;
+            struct sockaddr_un *sockpath = get_socket_path(glProcessID, &socklen);
+            while (recvfrom(glSocket, &buffer, sizeof(buffer), 0, (struct sockaddr *)sockpath, &socklen) > 0);
          }
-         else if (glFDTable[i].Flags & RFD_RECALL) {
-            // If the RECALL flag is set against an FD, it was done so because the subscribed routine needs to manually check
-            // for incoming/outgoing data.  These are considered 'one-off' checks, so the subscriber will need to set the RECALL flag
-            // again if it wants this service maintained.
-            //
-            // See the SSL support routines as an example of this requirement.
+         else while (read(FD, &buffer, sizeof(buffer)) > 0);
+      }
+      called = true;
 
-            glFDTable[i].Flags &= ~RFD_RECALL; // Turn off the recall flag as each call is a one-off
+      for (i=find_fd(FD); (i < glTotalFDs) and (glFDTable[i].FD IS FD); i++) {
+         if (glFDTable[i].Flags & type) glFDTable[i].Flags &= ~RFD_STOP_RECURSE;
+      }
+   }
 
-            if (!(glFDTable[i].Flags & RFD_ALLOW_RECURSION)) {
-               glFDTable[i].Flags |= RFD_STOP_RECURSE;
-            }
+#ifdef __linux__
+   if ((called) and (glEpollFD >= 0)) check_fd(FD);
+#endif
+}
 
-            if (glFDTable[i].Routine) {
-               glFDTable[i].Routine(glFDTable[i].FD, glFDTable[i].Data);
+//****************************************************************************
+// Calls routines that are registered with RFD_ALWAYS_CALL, and RFD_RECALL routines that need to manually check for
+// incoming/outgoing data.  Returns the Timeout, which is reduced if a subscriber re-applies RFD_RECALL.
 
-               if (glFDTable[i].Flags & RFD_RECALL) {
-                  // If the RECALL flag was re-applied by the subscriber, we need to employ a reduced timeout so that the subscriber doesn't get 'stuck'.
+static LONG call_fd_routines(LONG Timeout)
+{
+   for (LONG i=0; i < glTotalFDs; i++) {
+      if (glFDTable[i].Flags & RFD_STOP_RECURSE) continue;
 
-                  if (Timeout > 10) Timeout = 10;
-               }
-            }
+      if (glFDTable[i].Flags & RFD_ALWAYS_CALL) {
+         if (glFDTable[i].Routine) glFDTable[i].Routine(glFDTable[i].FD, glFDTable[i].Data);
+      }
+      else if (glFDTable[i].Flags & RFD_RECALL) {
+         // If the RECALL flag is set against an FD, it was done so because the subscribed routine needs to manually check
+         // for incoming/outgoing data.  These are considered 'one-off' checks, so the subscriber will need to set the RECALL flag
+         // again if it wants this service maintained.
+         //
+         // See the SSL support routines as an example of this requirement.
+
+         glFDTable[i].Flags &= ~RFD_RECALL; // Turn off the recall flag as each call is a one-off
+         glFDCallers--;
+
+         if (!(glFDTable[i].Flags & RFD_ALLOW_RECURSION)) {
+            glFDTable[i].Flags |= RFD_STOP_RECURSE;
+         }
+
+         if (glFDTable[i].Routine) {
+            glFDTable[i].Routine(glFDTable[i].FD, glFDTable[i].Data);
+
+            if (glFDTable[i].Flags & RFD_RECALL) {
+               // If the RECALL flag was re-applied by the subscriber, we need to employ a reduced timeout so that the subscriber doesn't get 'stuck'.
 
-            glFDTable[i].Flags &= ~RFD_STOP_RECURSE;
+               if (Timeout > 10) Timeout = 10;
+            }
          }
+
+         glFDTable[i].Flags &= ~RFD_STOP_RECURSE;
       }
    }
+   return Timeout;
+}
+
+/*****************************************************************************
+** Function: sleep_task() - Unix version
+*/
+
+ERROR sleep_task(LONG Timeout)
+{
+   parasol::Log log(__FUNCTION__);
 
-   LONG result = 0;
-   if (Timeout < 0) { // Sleep indefinitely
-      if (glTotalFDs > 0) result = select(maxfd + 1, &fread, &fwrite, NULL, NULL);
-      else pause();
+   if (!tlMainThread) {
+      log.warning("Only the main thread can call this function.");
+      return ERR_Failed;
    }
-   else if (Timeout IS 0) { // A zero second timeout means that we just poll the FD's and call them if they have data.  This is really useful for periodically flushing the FD's.
-      if (glTotalFDs > 0) {
-         tv.tv_sec = 0;
-         tv.tv_usec = 0;
-         result = select(maxfd + 1, &fread, &fwrite, NULL, &tv);
-      }
+   else if (tlPublicLockCount > 0) {
+      log.warning("Cannot sleep while holding %d global locks.", tlPublicLockCount);
+      return ERR_Okay;
    }
-   else {
-      if (glTotalFDs > 0) {
-         tv.tv_sec = Timeout / 1000;
-         tv.tv_usec = (Timeout - (tv.tv_sec * 1000)) * 1000;
-         result = select(maxfd + 1, &fread, &fwrite, NULL, &tv);
+   else if (tlPrivateLockCount != 0) {
+      char buffer[120];
+      size_t pos = 0;
+      for (auto &shard : glPrivateMemory.Shards) {
+         std::shared_lock lock(shard.Lock);
+         for (const auto & [ id, mem ] : shard.Map) {
+            if (mem.AccessCount > 0) {
+               pos += snprintf(buffer+pos, sizeof(buffer)-pos, "%d.%d ", mem.MemoryID, mem.AccessCount);
+               if (pos >= sizeof(buffer)-1) break;
+            }
+         }
+         if (pos >= sizeof(buffer)-1) break;
       }
-      else {
+
+      if (pos > 0) log.warning("WARNING - Sleeping with %d private locks held (%s)", tlPrivateLockCount, buffer);
+   }
+
+   //log.trace("Time-out: %d", Timeout);
+
+   if (glFDCallers > 0) Timeout = call_fd_routines(Timeout);
+
+   if (glTotalFDs <= 0) {
+      if (Timeout < 0) pause(); // Sleep indefinitely
+      else if (Timeout > 0) {
          if (Timeout > MAX_MSEC) Timeout = MAX_MSEC; // Do not sleep too long, in case the Linux kernel doesn't wake us when signalled (kernel 2.6)
+         struct timespec time;
          time.tv_sec  = Timeout/1000;
          time.tv_nsec = (Timeout - (time.tv_sec * 1000)) * 1000;
          nanosleep(&time, NULL);
       }
+      return ERR_Okay;
    }
 
-   UBYTE buffer[64];
-   if (result > 0) {
-      for (LONG i=0; i < glTotalFDs; i++) {
-         if (glFDTable[i].Flags & RFD_READ) {  // Readable FD support
-            if (FD_ISSET(glFDTable[i].FD, &fread)) {
-               if (!(glFDTable[i].Flags & RFD_ALLOW_RECURSION)) {
-                  glFDTable[i].Flags |= RFD_STOP_RECURSE;
-               }
+#ifdef __linux__
+   if (!use_select()) {
+      std::vector<FDEvent> pending;
+      pending.swap(glFDPending); // Routines may queue new entries while the current set is dispatched
+      if (!pending.empty()) Timeout = 0;
 
-               if (glFDTable[i].Routine) {
-                  glFDTable[i].Routine(glFDTable[i].FD, glFDTable[i].Data);
-               }
-               else if (glFDTable[i].FD IS glSocket) {
-                  socklen_t socklen;
-                  struct sockaddr_un *sockpath = get_socket_path(glProcessID, &socklen);
-                  recvfrom(glSocket, &buffer, sizeof(buffer), 0, (struct sockaddr *)sockpath, &socklen);
-               }
-               else while (read(glFDTable[i].FD, &buffer, sizeof(buffer)) > 0);
-            }
+      struct epoll_event events[MAX_EPOLL_EVENTS];
+      LONG total = epoll_wait(glEpollFD, events, MAX_EPOLL_EVENTS, Timeout);
 
-            glFDTable[i].Flags &= ~RFD_STOP_RECURSE;
-         }
+      if (total IS -1) {
+         if (errno != EINTR) log.warning("epoll_wait() error %d: %s", errno, strerror(errno));
+         total = 0;
+      }
 
-         if (glFDTable[i].Flags & RFD_WRITE) { // Writeable FD support
-            if (FD_ISSET(glFDTable[i].FD, &fwrite)) {
-               if (!(glFDTable[i].Flags & RFD_ALLOW_RECURSION)) {
-                  glFDTable[i].Flags |= RFD_STOP_RECURSE;
-               }
+      for (auto &entry : pending) { // Merge pending entries into the reported events so that no FD is dispatched twice
+         LONG e;
+         for (e=0; (e < total) and (events[e].data.fd != entry.FD); e++);
+         if (e < total) events[e].events |= ((entry.Events & RFD_READ) ? EPOLLIN : 0) | ((entry.Events & RFD_WRITE) ? EPOLLOUT : 0);
+         else dispatch_fd(entry.FD, entry.Events);
+      }
 
-               if (glFDTable[i].Routine) {
-                  glFDTable[i].Routine(glFDTable[i].FD, glFDTable[i].Data);
-               }
-            }
+      for (LONG e=0; e < total; e++) {
+         LONG ready = 0;
+         if (events[e].events & (EPOLLIN|EPOLLHUP|EPOLLERR)) ready |= RFD_READ;
+         if (events[e].events & (EPOLLOUT|EPOLLHUP|EPOLLERR)) ready |= RFD_WRITE;
+         dispatch_fd(events[e].data.fd, ready);
+      }
 
-            glFDTable[i].Flags &= ~RFD_STOP_RECURSE;
-         }
+      return ERR_Okay;
+   }
+#endif
+
+   // Fallback to select(), for which the FD sets have to be rebuilt on each call.
+
+   fd_set fread, fwrite;
+   FD_ZERO(&fread);
+   FD_ZERO(&fwrite);
+   LONG maxfd = -1;
+   for (LONG i=0; i < glTotalFDs; i++) {
+      if (glFDTable[i].Flags & RFD_STOP_RECURSE) continue; // This is an internally managed flag to prevent recursion
+      if ((glFDTable[i].FD < 0) or (glFDTable[i].FD >= FD_SETSIZE)) continue;
+      if (glFDTable[i].Flags & RFD_READ) FD_SET(glFDTable[i].FD, &fread);
+      if (glFDTable[i].Flags & RFD_WRITE) FD_SET(glFDTable[i].FD, &fwrite);
+      //log.trace("Listening to %d, Read: %d, Write: %d, Routine: %p, Flags: $%.2x", glFDTable[i].FD, (glFDTable[i].Flags & RFD_READ) ? 1 : 0, (glFDTable[i].Flags & RFD_WRITE) ? 1 : 0, glFDTable[i].Routine, glFDTable[i].Flags);
+      if (glFDTable[i].FD > maxfd) maxfd = glFDTable[i].FD;
+   }
+
+   struct timeval tv;
+   LONG result;
+   if (Timeout < 0) result = select(maxfd + 1, &fread, &fwrite, NULL, NULL); // Sleep indefinitely
+   else { // A zero second timeout means that we just poll the FD's and call them if they have data.  This is really useful for periodically flushing the FD's.
+      tv.tv_sec = Timeout / 1000;
+      tv.tv_usec = (Timeout - (tv.tv_sec * 1000)) * 1000;
+      result = select(maxfd + 1, &fread, &fwrite, NULL, &tv);
+   }
+
+   if (result > 0) {
+      // The set of ready descriptors is captured first because the routines can modify glFDTable.
+
+      std::vector<FDEvent> ready;
+      for (LONG i=0; i < glTotalFDs; i++) {
+         auto fd = glFDTable[i].FD;
+         if ((fd < 0) or (fd >= FD_SETSIZE)) continue;
+         if ((i > 0) and (glFDTable[i-1].FD IS fd)) continue;
+         LONG events = (FD_ISSET(fd, &fread) ? RFD_READ : 0) | (FD_ISSET(fd, &fwrite) ? RFD_WRITE : 0);
+         if (events) ready.push_back({ fd, events });
       }
+
+      for (auto &entry : ready) dispatch_fd(entry.FD, entry.Events);
    }
    else if (result IS -1) {
       if (errno IS EINTR); // Interrupt caught during sleep
@@ -1521,7 +1971,7 @@ ERROR sleep_task(LONG Timeout)
 
          struct stat info;
          for (LONG i=0; i < glTotalFDs; i++) {
-            if (fstat(glFDTable[i].FD, &info) < 0) {
+            if ((glFDTable[i].FD >= 0) and (fstat(glFDTable[i].FD, &info) < 0)) {
                if (errno IS EBADF) {
                   log.warning("FD %d was closed without a call to deregister it.", glFDTable[i].FD);
                   RegisterFD(glFDTable[i].FD, RFD_REMOVE|RFD_READ|RFD_WRITE|RFD_EXCEPT, NULL, NULL);
@@ -1557,11 +2007,15 @@ ERROR sleep_task(LONG Timeout, BYTE SystemOnly)
    else if (tlPrivateLockCount != 0) {
       char buffer[120];
       size_t pos = 0;
-      for (const auto & [ id, mem ] : glPrivateMemory) {
-         if (mem.AccessCount > 0) {
-            pos += snprintf(buffer+pos, sizeof(buffer)-pos, "#%d +%d ", mem.MemoryID, mem.AccessCount);
-            if (pos >= sizeof(buffer)-1) break;
+      for (auto &shard : glPrivateMemory.Shards) {
+         std::shared_lock lock(shard.Lock);
+         for (const auto & [ id, mem ] : shard.Map) {
+            if (mem.AccessCount > 0) {
+               pos += snprintf(buffer+pos, sizeof(buffer)-pos, "#%d +%d ", mem.MemoryID, mem.AccessCount);
+               if (pos >= sizeof(buffer)-1) break;
+            }
          }
+         if (pos >= sizeof(buffer)-1) break;
       }
 
       if (pos > 0) log.warning("WARNING - Sleeping with %d private locks held (%s)", tlPrivateLockCount, buffer);
@@ -1597,7 +2051,11 @@ ERROR sleep_task(LONG Timeout, BYTE SystemOnly)
          log.trace("Sleeping on process semaphore only.");
       }
       else {
-         for (LONG i=0; i < glTotalFDs; i++) {
+         // Handles are listed from glLastFD onwards so that the most recently signalled handle moves to the end of the
+         // queue.  WaitForMultipleObjects() favours handles that are early in the list.
+
+         for (LONG n=0; n < glTotalFDs; n++) {
+            LONG i = (glLastFD + n) % glTotalFDs;
             if (glFDTable[i].Flags & RFD_SOCKET) continue; // Ignore network socket FDs (triggered as normal windows messages)
 
             //log.trace("Listening to %d, Read: %d, Write: %d, Routine: %p, Flags: $%.2x", (LONG)(MAXINT)glFDTable[i].FD, (glFDTable[i].Flags & RFD_READ) ? 1 : 0, (glFDTable[i].Flags & RFD_WRITE) ? 1 : 0, glFDTable[i].Routine, glFDTable[i].Flags);
@@ -1612,7 +2070,7 @@ ERROR sleep_task(LONG Timeout, BYTE SystemOnly)
             else {
                log.warning("FD " PF64() " has no READ/WRITE/EXCEPT flag setting - de-registering.", (LARGE)glFDTable[i].FD);
                RegisterFD(glFDTable[i].FD, RFD_REMOVE|RFD_READ|RFD_WRITE|RFD_EXCEPT, NULL, NULL);
-               i--;
+               break; // The table has been modified, the remaining handles will be picked up on the next cycle
             }
          }
       }
@@ -1648,11 +2106,7 @@ ERROR sleep_task(LONG Timeout, BYTE SystemOnly)
          LONG ifd = lookup[i];
          if (glFDTable[ifd].Routine) glFDTable[ifd].Routine(glFDTable[ifd].FD, glFDTable[ifd].Data);
 
-         if ((glTotalFDs > 1) and (ifd < glTotalFDs-1)) { // Move the most recently signalled handle to the end of the queue
-            FDTable last = glFDTable[glTotalFDs-1];
-            glFDTable[glTotalFDs-1] = glFDTable[ifd];
-            glFDTable[ifd] = last;
-         }
+         glLastFD = ifd + 1; // Move the most recently signalled handle to the end of the queue
 
          break;
       }
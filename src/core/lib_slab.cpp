@@ -0,0 +1,234 @@
+/*****************************************************************************
+
+The small block allocator serves private memory blocks of up to SLAB_MAX_SIZE bytes on behalf of AllocMemory().
+
+Each thread owns a SlabCache that holds a free list for each size class.  Chunks are carved from pages of
+SLAB_PAGE_SIZE bytes that are aligned to their size, so the page header (and therefore the owning cache) can be found
+from any chunk address.  Blocks that are freed by the owning thread are returned to the local free list.  Blocks that
+are freed by any other thread are pushed to a lock-free list that the owner reclaims when its local list is empty.
+Neither path takes a lock.
+
+When a thread exits, its cache is marked as orphaned and is adopted by the next thread that needs one.  The exiting
+thread gives up its cache at the same time, so blocks that it frees from its remaining thread_local destructors take
+the remote path and any allocations that it makes are served by malloc().  Pages are never returned to the system.
+
+*****************************************************************************/
+
+#ifdef _WIN32
+   #include <malloc.h>
+#else
+   #include <stdlib.h>
+#endif
+
+#include <atomic>
+#include <new>
+
+#include "defs.h"
+#include <parasol/modules/core.h>
+
+#define SLAB_PAGE_SIZE   (64 * 1024) // Pages are aligned to their size - must be a power of 2
+#define SLAB_PAGE_HEADER 64          // Space reserved at the start of each page for the SlabPage header
+#define SLAB_STRIDE(a)   (((a) + MEMHEADER + 15) & (~15))
+
+struct SlabChunk {
+   SlabChunk *Next;
+};
+
+struct SlabCache;
+
+struct SlabPage {
+   SlabCache *Cache; // The cache that the page belongs to
+   LONG Class;       // Index of the size class served by the page
+};
+
+struct SlabCache {
+   SlabChunk *Free[SLAB_CLASSES] = { };                  // Chunks freed by the owner.
+   std::atomic<SlabChunk *> Remote[SLAB_CLASSES] = { };  // Chunks freed by other threads.
+   char  *Carve[SLAB_CLASSES] = { };                     // Next unused chunk in the most recent page.
+   char  *CarveEnd[SLAB_CLASSES] = { };
+   LARGE Allocations[SLAB_CLASSES] = { };
+   LARGE Frees[SLAB_CLASSES] = { };
+   LARGE RemoteFrees[SLAB_CLASSES] = { };
+   LONG  Pages[SLAB_CLASSES] = { };
+   LARGE Misses = 0;
+   SlabCache *Next = NULL;
+   bool Orphaned = false;
+};
+
+// Counters are only written by the thread that owns the cache, so a relaxed store is sufficient for GetSystemState()
+// to read them safely from elsewhere.
+
+template <class T> inline void inc_counter(T &Counter)
+{
+   __atomic_store_n(&Counter, Counter + 1, __ATOMIC_RELAXED);
+}
+
+// Data sizes served by each class.  The stride of a class includes the header and tail cookies, rounded up to 16 bytes
+// so that addresses are aligned in the same way as blocks returned by malloc().
+
+static const LONG glClassSize[SLAB_CLASSES] = { 16, 32, 64, 128, 256 };
+static const LONG glClassStride[SLAB_CLASSES] = {
+   SLAB_STRIDE(16), SLAB_STRIDE(32), SLAB_STRIDE(64), SLAB_STRIDE(128), SLAB_STRIDE(256)
+};
+
+static std::mutex glSlabLock; // Guards glSlabCaches.  Only used when a thread acquires or releases its cache.
+static SlabCache *glSlabCaches = NULL;
+static THREADVAR SlabCache *tlSlabCache = NULL;
+static THREADVAR bool tlSlabExited = false; // True once the thread has released its cache
+
+// Releases the cache of the current thread on exit.  The cache can be adopted by another thread as soon as the lock is
+// dropped, so the thread must stop referring to it before then.
+
+struct SlabOwner {
+   SlabCache *Cache = NULL;
+
+   ~SlabOwner() {
+      const std::lock_guard<std::mutex> lock(glSlabLock);
+      tlSlabExited = true;
+      if (!Cache) return;
+      tlSlabCache = NULL;
+      Cache->Orphaned = true;
+      Cache = NULL;
+   }
+};
+
+static thread_local SlabOwner tlSlabOwner;
+
+//****************************************************************************
+
+static SlabCache * get_cache(void)
+{
+   if (tlSlabCache) return tlSlabCache;
+   if (tlSlabExited) return NULL; // tlSlabOwner has been destroyed and cannot release a new cache
+
+   const std::lock_guard<std::mutex> lock(glSlabLock);
+
+   SlabCache *cache;
+   for (cache=glSlabCaches; cache; cache=cache->Next) {
+      if (cache->Orphaned) {
+         cache->Orphaned = false;
+         break;
+      }
+   }
+
+   if (!cache) {
+      if (!(cache = new (std::nothrow) SlabCache)) return NULL;
+      cache->Next = glSlabCaches;
+      glSlabCaches = cache;
+   }
+
+   tlSlabOwner.Cache = cache;
+   tlSlabCache = cache;
+   return cache;
+}
+
+//****************************************************************************
+
+static bool new_page(SlabCache *Cache, LONG Class)
+{
+   APTR page;
+#ifdef _WIN32
+   if (!(page = _aligned_malloc(SLAB_PAGE_SIZE, SLAB_PAGE_SIZE))) return false;
+#else
+   if (posix_memalign(&page, SLAB_PAGE_SIZE, SLAB_PAGE_SIZE)) return false;
+#endif
+
+   ((SlabPage *)page)->Cache = Cache;
+   ((SlabPage *)page)->Class = Class;
+
+   Cache->Carve[Class]    = (char *)page + SLAB_PAGE_HEADER;
+   Cache->CarveEnd[Class] = (char *)page + SLAB_PAGE_SIZE;
+   inc_counter(Cache->Pages[Class]);
+   return true;
+}
+
+/*****************************************************************************
+** Returns a chunk that can hold Size bytes of data plus the MEMHEADER cookies, or NULL if the size is not served by
+** the slab allocator.  The chunk is not cleared.
+*/
+
+APTR slab_alloc(LONG Size)
+{
+   if ((Size <= 0) or (Size > SLAB_MAX_SIZE)) return NULL;
+
+   LONG c;
+   for (c=0; glClassSize[c] < Size; c++);
+
+   auto cache = get_cache();
+   if (!cache) return NULL;
+
+   SlabChunk *chunk;
+   if ((chunk = cache->Free[c])) {
+      cache->Free[c] = chunk->Next;
+   }
+   else if ((chunk = cache->Remote[c].exchange(NULL, std::memory_order_acquire))) {
+      cache->Free[c] = chunk->Next;
+   }
+   else {
+      if (cache->Carve[c] + glClassStride[c] > cache->CarveEnd[c]) {
+         if (!new_page(cache, c)) return NULL;
+      }
+      chunk = (SlabChunk *)cache->Carve[c];
+      cache->Carve[c] += glClassStride[c];
+   }
+
+   inc_counter(cache->Allocations[c]);
+   return chunk;
+}
+
+/*****************************************************************************
+** Returns a chunk from slab_alloc() to the cache that owns it.  The header cookie is overwritten so that a second
+** attempt at freeing the block is detectable.
+*/
+
+void slab_free(APTR Chunk)
+{
+   auto page  = (SlabPage *)((UMAXINT)Chunk & ~(UMAXINT)(SLAB_PAGE_SIZE - 1));
+   auto owner = page->Cache;
+   auto c     = page->Class;
+   auto chunk = (SlabChunk *)Chunk;
+
+   if (owner IS tlSlabCache) {
+      chunk->Next = owner->Free[c];
+      owner->Free[c] = chunk;
+      inc_counter(owner->Frees[c]);
+   }
+   else {
+      chunk->Next = owner->Remote[c].load(std::memory_order_relaxed);
+      while (!owner->Remote[c].compare_exchange_weak(chunk->Next, chunk, std::memory_order_release, std::memory_order_relaxed));
+      __sync_fetch_and_add(&owner->RemoteFrees[c], 1);
+   }
+}
+
+//****************************************************************************
+// Records a private allocation that was not eligible for the slab allocator.
+
+void slab_miss(void)
+{
+   if (auto cache = get_cache()) inc_counter(cache->Misses);
+}
+
+//****************************************************************************
+// Totals the counters of all caches.  Stats must refer to an array of SLAB_CLASSES entries.
+
+void slab_stats(SlabStats *Stats, LARGE *Misses)
+{
+   ClearMemory(Stats, sizeof(SlabStats) * SLAB_CLASSES);
+   *Misses = 0;
+
+   const std::lock_guard<std::mutex> lock(glSlabLock);
+
+   for (LONG c=0; c < SLAB_CLASSES; c++) Stats[c].Size = glClassSize[c];
+
+   for (auto cache=glSlabCaches; cache; cache=cache->Next) {
+      for (LONG c=0; c < SLAB_CLASSES; c++) {
+         Stats[c].Pages       += __atomic_load_n(&cache->Pages[c], __ATOMIC_RELAXED);
+         Stats[c].Allocations += __atomic_load_n(&cache->Allocations[c], __ATOMIC_RELAXED);
+         Stats[c].RemoteFrees += __atomic_load_n(&cache->RemoteFrees[c], __ATOMIC_RELAXED);
+         Stats[c].Frees       += __atomic_load_n(&cache->Frees[c], __ATOMIC_RELAXED);
+      }
+      *Misses += __atomic_load_n(&cache->Misses, __ATOMIC_RELAXED);
+   }
+
+   for (LONG c=0; c < SLAB_CLASSES; c++) Stats[c].Frees += Stats[c].RemoteFrees;
+}
@@ -195,6 +195,11 @@ ERROR VarSetSized(struct KeyStore * Store, CSTRING Key, LONG Size, APTR * Data,
 ERROR VarLock(struct KeyStore * Store, LONG Timeout);
 void VLogF(LONG Flags, CSTRING Header, CSTRING Message, va_list Args);
 ERROR WakeProcess(LONG ProcessID);
+ERROR ActionThreadBatch(struct ThreadAction * Actions, LONG Total);
+ERROR ResolveFieldHandle(OBJECTPTR Object, ULONG FieldID, struct FieldHandle * Handle);
+ERROR GetFieldByHandle(struct FieldHandle * Handle, FIELD Type, APTR Result);
+ERROR SetFieldByHandle(struct FieldHandle * Handle, FIELD Type, ...);
+ERROR ThreadBatch(void (*Routine)(APTR, LONG) , APTR Data, LONG Total);
 
 #ifdef  __cplusplus
 }
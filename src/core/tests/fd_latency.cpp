@@ -0,0 +1,230 @@
+/*****************************************************************************
+
+The source code of the Parasol project is made publicly available under the
+terms described in the LICENSE.TXT file that is distributed with this package.
+Please refer to it for further information on licensing.
+
+******************************************************************************
+
+This program measures how quickly a sleeping task is woken by activity on a registered file descriptor.  A large
+number of local socket pairs are opened and one end of each is monitored with RegisterFD().  A thread then writes to
+randomly chosen pairs, one at a time, and the main thread records the time between the write and the call to the
+read routine.  A burst of writes to many pairs is then used to confirm that every descriptor is dispatched.
+
+Options: -pairs [n] -wakes [n]
+
+*****************************************************************************/
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/resource.h>
+#include <parasol/main.h>
+#include <startup.h>
+#include <parasol/modules/core.h>
+
+CSTRING ProgName      = "FDLatency";
+CSTRING ProgAuthor    = "Paul Manias";
+CSTRING ProgDate      = "October 2026";
+CSTRING ProgCopyright = "Paul Manias (c) 2026";
+LONG  ProgDebug = -1;
+FLOAT ProgCoreVersion = 1.0;
+
+extern struct CoreBase *CoreBase;
+static LONG glTotalPairs = 2000;
+static LONG glTotalWakes = 2000;
+static LONG glMsgType    = 0;
+static LONG glFailures   = 0;
+static LONG (*glPairs)[2] = NULL;
+static LARGE *glLatency = NULL;
+static volatile LARGE glSendTime = 0;
+static volatile LONG glReceived = 0;
+
+//****************************************************************************
+
+static void read_pair(HOSTHANDLE FD, APTR Data)
+{
+   LARGE now = PreciseTime();
+   UBYTE buffer[64];
+   LONG total = 0, result;
+   while ((result = read(FD, buffer, sizeof(buffer))) > 0) total += result;
+
+   if (total > 0) {
+      LONG index = __sync_fetch_and_add(&glReceived, 1);
+      if ((glSendTime) and (index < glTotalWakes)) glLatency[index] = now - glSendTime;
+   }
+}
+
+//****************************************************************************
+
+static ERROR msg_handler(APTR Custom, LONG MsgID, LONG MsgType, APTR Message, LONG MsgSize)
+{
+   return ERR_Terminate;
+}
+
+//****************************************************************************
+// Wakes the main thread by writing to a random pair, then waits for the read routine to acknowledge it.
+
+static void * send_wakes(APTR Arg)
+{
+   UBYTE byte = 1;
+
+   for (LONG i=0; i < glTotalWakes; i++) {
+      LONG pair = rand() % glTotalPairs;
+      glSendTime = PreciseTime();
+      if (write(glPairs[pair][1], &byte, 1) != 1) {
+         __sync_fetch_and_add(&glFailures, 1);
+         break;
+      }
+
+      LARGE timeout = PreciseTime() + 1000000LL;
+      while ((glReceived <= i) and (PreciseTime() < timeout)) sched_yield();
+      if (glReceived <= i) {
+         print("Wake %d on pair %d was not received.", i, pair);
+         __sync_fetch_and_add(&glFailures, 1);
+         break;
+      }
+   }
+
+   glSendTime = 0;
+   SendMessage(0, glMsgType, 0, NULL, 0);
+   return NULL;
+}
+
+//****************************************************************************
+
+static int compare_large(const void *A, const void *B)
+{
+   LARGE a = *(LARGE *)A, b = *(LARGE *)B;
+   return (a < b) ? -1 : ((a > b) ? 1 : 0);
+}
+
+//****************************************************************************
+
+static void test_latency(void)
+{
+   glReceived = 0;
+
+   pthread_t thread;
+   pthread_create(&thread, NULL, &send_wakes, NULL);
+   ProcessMessages(0, 60000);
+   pthread_join(thread, NULL);
+
+   LONG total = (glReceived < glTotalWakes) ? glReceived : glTotalWakes;
+   if (total < 1) return;
+
+   qsort(glLatency, total, sizeof(LARGE), &compare_large);
+   LARGE sum = 0;
+   for (LONG i=0; i < total; i++) sum += glLatency[i];
+
+   print("Wakes: %d, Average: %.1fus, Min: " PF64() "us, Median: " PF64() "us, 99%%: " PF64() "us, Max: " PF64() "us",
+      total, DOUBLE(sum) / DOUBLE(total), glLatency[0], glLatency[total / 2], glLatency[(total * 99) / 100], glLatency[total-1]);
+}
+
+//****************************************************************************
+// Every tenth pair is written to before the task sleeps, so more descriptors are ready than a single wait returns.
+
+static void test_burst(void)
+{
+   UBYTE byte = 1;
+   LONG expected = 0;
+
+   glReceived = 0;
+   for (LONG i=0; i < glTotalPairs; i += 10) {
+      if (write(glPairs[i][1], &byte, 1) IS 1) expected++;
+   }
+
+   LARGE start = PreciseTime();
+   while ((glReceived < expected) and (PreciseTime() - start < 5000000LL)) ProcessMessages(0, 0);
+   LARGE elapsed = PreciseTime() - start;
+
+   print("Burst: %d of %d descriptors dispatched in %.2fms", glReceived, expected, DOUBLE(elapsed) / 1000.0);
+   if (glReceived != expected) glFailures++;
+}
+
+//****************************************************************************
+
+int main(int argc, CSTRING *argv)
+{
+   const char *msg = init_parasol(argc, argv);
+   if (msg) {
+      print(msg);
+      return -1;
+   }
+
+   CSTRING *args;
+   if ((!GetPointer(CurrentTask(), FID_Parameters, &args)) and (args)) {
+      for (LONG i=0; args[i]; i++) {
+         if (!StrMatch(args[i], "-pairs")) {
+            if (args[++i]) glTotalPairs = StrToInt(args[i]);
+            else break;
+         }
+         else if (!StrMatch(args[i], "-wakes")) {
+            if (args[++i]) glTotalWakes = StrToInt(args[i]);
+            else break;
+         }
+      }
+   }
+
+   if (glTotalPairs < 1) glTotalPairs = 1;
+
+   // Each pair consumes two descriptors, so the soft limit is raised as far as the host allows.
+
+   struct rlimit limit;
+   if (!getrlimit(RLIMIT_NOFILE, &limit)) {
+      limit.rlim_cur = limit.rlim_max;
+      setrlimit(RLIMIT_NOFILE, &limit);
+   }
+
+   glPairs   = new LONG[glTotalPairs][2];
+   glLatency = new LARGE[glTotalWakes];
+   glMsgType = AllocateID(IDTYPE_MESSAGE);
+
+   LONG opened = 0;
+   for (; opened < glTotalPairs; opened++) {
+      int fds[2];
+      if (socketpair(AF_UNIX, SOCK_STREAM, 0, fds)) break;
+      fcntl(fds[0], F_SETFL, fcntl(fds[0], F_GETFL) | O_NONBLOCK);
+      glPairs[opened][0] = fds[0];
+      glPairs[opened][1] = fds[1];
+   }
+
+   if (opened < glTotalPairs) {
+      print("Only %d of %d socket pairs could be opened.", opened, glTotalPairs);
+      glTotalPairs = opened;
+   }
+
+   LARGE start = PreciseTime();
+   for (LONG i=0; i < glTotalPairs; i++) {
+      if (RegisterFD(glPairs[i][0], RFD_READ, &read_pair, NULL)) {
+         print("Failed to register pair %d (FD %d).", i, glPairs[i][0]);
+         glFailures++;
+         break;
+      }
+   }
+   print("Pairs: %d, Registration: %.2fms", glTotalPairs, DOUBLE(PreciseTime() - start) / 1000.0);
+
+   auto call = make_function_stdc(msg_handler);
+   MsgHandler *handler;
+   if ((!glFailures) and (glTotalPairs > 0) and (!AddMsgHandler(NULL, glMsgType, &call, &handler))) {
+      test_latency();
+      test_burst();
+      FreeResource(handler);
+   }
+
+   for (LONG i=0; i < glTotalPairs; i++) {
+      DeregisterFD(glPairs[i][0]);
+      close(glPairs[i][0]);
+      close(glPairs[i][1]);
+   }
+
+   if (glFailures) print("%d failures detected.", glFailures);
+
+   delete[] glPairs;
+   delete[] glLatency;
+   close_parasol();
+   return glFailures ? -1 : 0;
+}
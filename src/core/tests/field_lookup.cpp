@@ -0,0 +1,127 @@
+/*****************************************************************************
+
+The source code of the Parasol project is made publicly available under the
+terms described in the LICENSE.TXT file that is distributed with this package.
+Please refer to it for further information on licensing.
+
+******************************************************************************
+
+This program measures the cost of field access.  The fields of a Time object are read and written with GetLong() and
+SetLong(), which look up the field on every call, and then through a FieldHandle that is resolved once with
+ResolveFieldHandle().  The values returned by both methods are compared, and unknown fields must fail to resolve.
+
+Options: -calls [n]
+
+*****************************************************************************/
+
+#include <parasol/main.h>
+#include <startup.h>
+#include <parasol/modules/core.h>
+
+CSTRING ProgName      = "FieldLookup";
+CSTRING ProgAuthor    = "Paul Manias";
+CSTRING ProgDate      = "October 2026";
+CSTRING ProgCopyright = "Paul Manias (c) 2026";
+LONG  ProgDebug = -1;
+FLOAT ProgCoreVersion = 1.0;
+
+extern struct CoreBase *CoreBase;
+static LONG glTotalCalls = 1000000;
+static LONG glFailures = 0;
+
+static const FIELD glFields[] = { FID_Year, FID_Month, FID_Day, FID_Hour, FID_Minute, FID_Second };
+static const LONG glTotalFields = ARRAYSIZE(glFields);
+
+//****************************************************************************
+
+static void test_lookup(OBJECTPTR Time)
+{
+   FieldHandle handles[glTotalFields];
+   for (LONG f=0; f < glTotalFields; f++) {
+      if (ResolveFieldHandle(Time, glFields[f], &handles[f])) {
+         print("Failed to resolve field #%d.", f);
+         glFailures++;
+         return;
+      }
+   }
+
+   LONG sum_id = 0, sum_handle = 0, value;
+
+   LARGE start = PreciseTime();
+   for (LONG i=0; i < glTotalCalls; i++) {
+      if (!GetLong(Time, glFields[i % glTotalFields], &value)) sum_id += value;
+   }
+   LARGE by_id = PreciseTime() - start;
+
+   start = PreciseTime();
+   for (LONG i=0; i < glTotalCalls; i++) {
+      if (!GetFieldByHandle(&handles[i % glTotalFields], TLONG, &value)) sum_handle += value;
+   }
+   LARGE by_handle = PreciseTime() - start;
+
+   print("Get: %d calls, by ID: %.1fns per call, by handle: %.1fns per call", glTotalCalls,
+      DOUBLE(by_id) * 1000.0 / DOUBLE(glTotalCalls), DOUBLE(by_handle) * 1000.0 / DOUBLE(glTotalCalls));
+
+   if (sum_id != sum_handle) {
+      print("Reads by ID and by handle returned different values.");
+      glFailures++;
+   }
+
+   start = PreciseTime();
+   for (LONG i=0; i < glTotalCalls; i++) SetLong(Time, FID_Second, i % 60);
+   by_id = PreciseTime() - start;
+
+   start = PreciseTime();
+   for (LONG i=0; i < glTotalCalls; i++) SetFieldByHandle(&handles[5], TLONG, i % 60);
+   by_handle = PreciseTime() - start;
+
+   print("Set: %d calls, by ID: %.1fns per call, by handle: %.1fns per call", glTotalCalls,
+      DOUBLE(by_id) * 1000.0 / DOUBLE(glTotalCalls), DOUBLE(by_handle) * 1000.0 / DOUBLE(glTotalCalls));
+
+   if ((GetLong(Time, FID_Second, &value)) or (value != (glTotalCalls - 1) % 60)) {
+      print("The value written by handle was not retained.");
+      glFailures++;
+   }
+
+   FieldHandle unknown;
+   if (!ResolveFieldHandle(Time, 0x12345678, &unknown)) {
+      print("An unknown field was resolved.");
+      glFailures++;
+   }
+}
+
+//****************************************************************************
+
+int main(int argc, CSTRING *argv)
+{
+   const char *msg = init_parasol(argc, argv);
+   if (msg) {
+      print(msg);
+      return -1;
+   }
+
+   CSTRING *args;
+   if ((!GetPointer(CurrentTask(), FID_Parameters, &args)) and (args)) {
+      for (LONG i=0; args[i]; i++) {
+         if (!StrMatch(args[i], "-calls")) {
+            if (args[++i]) glTotalCalls = StrToInt(args[i]);
+            else break;
+         }
+      }
+   }
+
+   OBJECTPTR time;
+   if (!CreateObject(ID_TIME, 0, &time, TAGEND)) {
+      test_lookup(time);
+      acFree(time);
+   }
+   else {
+      print("Failed to create a Time object.");
+      glFailures++;
+   }
+
+   if (glFailures) print("%d failures detected.", glFailures);
+
+   close_parasol();
+   return glFailures ? -1 : 0;
+}
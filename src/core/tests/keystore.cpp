@@ -0,0 +1,222 @@
+/*****************************************************************************
+
+The source code of the Parasol project is made publicly available under the
+terms described in the LICENSE.TXT file that is distributed with this package.
+Please refer to it for further information on licensing.
+
+******************************************************************************
+
+This program measures the throughput of the KeyStore functions.  Named keys are written, read, replaced and removed
+with VarSet() and VarGet(), and pre-hashed keys with KeySet() and KeyGet().  The remaining keys are checked after
+each removal pass.  A thread-safe store is then read by an increasing number of threads to show that concurrent
+readers do not serialise.
+
+Options: -keys [n] -threads [n] -reads [n]
+
+*****************************************************************************/
+
+#include <pthread.h>
+#include <parasol/main.h>
+#include <startup.h>
+#include <parasol/modules/core.h>
+
+CSTRING ProgName      = "KeyStore";
+CSTRING ProgAuthor    = "Paul Manias";
+CSTRING ProgDate      = "October 2026";
+CSTRING ProgCopyright = "Paul Manias (c) 2026";
+LONG  ProgDebug = -1;
+FLOAT ProgCoreVersion = 1.0;
+
+extern struct CoreBase *CoreBase;
+static LONG glTotalKeys    = 100000;
+static LONG glTotalThreads = 4;
+static LONG glTotalReads   = 1000000;
+static LONG glFailures     = 0;
+static char (*glNames)[16] = NULL;
+static KeyStore *glShared  = NULL;
+
+struct thread_info {
+   pthread_t thread;
+   LONG index;
+};
+
+//****************************************************************************
+
+static void report(CSTRING Label, LONG Total, LARGE Elapsed)
+{
+   print("%-16s %8d calls, %7.1fns per call", Label, Total, DOUBLE(Elapsed) * 1000.0 / DOUBLE(Total));
+}
+
+//****************************************************************************
+
+static void test_named(void)
+{
+   KeyStore *store;
+   if (!(store = VarNew(0, 0))) {
+      glFailures++;
+      return;
+   }
+
+   LARGE start = PreciseTime();
+   for (LONG i=0; i < glTotalKeys; i++) {
+      if (!VarSet(store, glNames[i], &i, sizeof(i))) glFailures++;
+   }
+   report("VarSet (new)", glTotalKeys, PreciseTime() - start);
+
+   start = PreciseTime();
+   for (LONG i=0; i < glTotalKeys; i++) {
+      LONG value = i * 2;
+      if (!VarSet(store, glNames[i], &value, sizeof(value))) glFailures++;
+   }
+   report("VarSet (replace)", glTotalKeys, PreciseTime() - start);
+
+   start = PreciseTime();
+   for (LONG i=0; i < glTotalKeys; i++) {
+      LONG *value;
+      if ((VarGet(store, glNames[i], (APTR *)&value, NULL)) or (*value != i * 2)) glFailures++;
+   }
+   report("VarGet", glTotalKeys, PreciseTime() - start);
+
+   start = PreciseTime();
+   for (LONG i=0; i < glTotalKeys; i += 2) VarSet(store, glNames[i], NULL, 0);
+   report("VarSet (remove)", glTotalKeys / 2, PreciseTime() - start);
+
+   if (store->Total != glTotalKeys / 2) {
+      print("Expected %d keys after removal, found %d.", glTotalKeys / 2, store->Total);
+      glFailures++;
+   }
+
+   for (LONG i=0; i < glTotalKeys; i++) {
+      LONG *value;
+      ERROR error = VarGet(store, glNames[i], (APTR *)&value, NULL);
+      if (i & 1) {
+         if ((error) or (*value != i * 2)) glFailures++;
+      }
+      else if (!error) glFailures++;
+   }
+
+   FreeResource(store);
+}
+
+//****************************************************************************
+
+static void test_hashed(void)
+{
+   KeyStore *store;
+   if (!(store = VarNew(0, 0))) {
+      glFailures++;
+      return;
+   }
+
+   LARGE start = PreciseTime();
+   for (LONG i=0; i < glTotalKeys; i++) {
+      if (KeySet(store, i + 1, &i, sizeof(i))) glFailures++;
+   }
+   report("KeySet", glTotalKeys, PreciseTime() - start);
+
+   start = PreciseTime();
+   for (LONG i=0; i < glTotalKeys; i++) {
+      LONG *value;
+      if ((KeyGet(store, i + 1, (APTR *)&value, NULL)) or (*value != i)) glFailures++;
+   }
+   report("KeyGet", glTotalKeys, PreciseTime() - start);
+
+   for (LONG i=0; i < glTotalKeys; i += 3) KeySet(store, i + 1, NULL, 0);
+
+   for (LONG i=0; i < glTotalKeys; i++) {
+      LONG *value;
+      ERROR error = KeyGet(store, i + 1, (APTR *)&value, NULL);
+      if (i % 3) {
+         if ((error) or (*value != i)) glFailures++;
+      }
+      else if (!error) glFailures++;
+   }
+
+   FreeResource(store);
+}
+
+//****************************************************************************
+
+static void * read_keys(thread_info *Info)
+{
+   ULONG seed = Info->index + 1;
+   for (LONG i=0; i < glTotalReads; i++) {
+      seed = seed * 1103515245 + 12345;
+      LONG key = (seed >> 8) % glTotalKeys;
+      LONG *value;
+      if ((VarGet(glShared, glNames[key], (APTR *)&value, NULL)) or (*value != key)) {
+         __sync_fetch_and_add(&glFailures, 1);
+      }
+   }
+   return NULL;
+}
+
+static void test_concurrent(void)
+{
+   if (!(glShared = VarNew(glTotalKeys, KSF_THREAD_SAFE))) {
+      glFailures++;
+      return;
+   }
+
+   for (LONG i=0; i < glTotalKeys; i++) VarSet(glShared, glNames[i], &i, sizeof(i));
+
+   for (LONG total=1; total <= glTotalThreads; total *= 2) {
+      thread_info threads[total];
+      LARGE start = PreciseTime();
+      for (LONG i=0; i < total; i++) {
+         threads[i].index = i;
+         pthread_create(&threads[i].thread, NULL, (void * (*)(void *))&read_keys, &threads[i]);
+      }
+      for (LONG i=0; i < total; i++) pthread_join(threads[i].thread, NULL);
+      LARGE elapsed = PreciseTime() - start;
+
+      print("Readers: %2d, %10.0f reads per second", total, DOUBLE(total) * DOUBLE(glTotalReads) * 1000000.0 / DOUBLE(elapsed));
+   }
+
+   FreeResource(glShared);
+   glShared = NULL;
+}
+
+//****************************************************************************
+
+int main(int argc, CSTRING *argv)
+{
+   const char *msg = init_parasol(argc, argv);
+   if (msg) {
+      print(msg);
+      return -1;
+   }
+
+   CSTRING *args;
+   if ((!GetPointer(CurrentTask(), FID_Parameters, &args)) and (args)) {
+      for (LONG i=0; args[i]; i++) {
+         if (!StrMatch(args[i], "-keys")) {
+            if (args[++i]) glTotalKeys = StrToInt(args[i]);
+            else break;
+         }
+         else if (!StrMatch(args[i], "-threads")) {
+            if (args[++i]) glTotalThreads = StrToInt(args[i]);
+            else break;
+         }
+         else if (!StrMatch(args[i], "-reads")) {
+            if (args[++i]) glTotalReads = StrToInt(args[i]);
+            else break;
+         }
+      }
+   }
+
+   if (glTotalKeys < 2) glTotalKeys = 2;
+
+   glNames = new char[glTotalKeys][16];
+   for (LONG i=0; i < glTotalKeys; i++) StrFormat(glNames[i], sizeof(glNames[i]), "key%d", i);
+
+   test_named();
+   test_hashed();
+   test_concurrent();
+
+   if (glFailures) print("%d failures detected.", glFailures);
+
+   delete[] glNames;
+   close_parasol();
+   return glFailures ? -1 : 0;
+}
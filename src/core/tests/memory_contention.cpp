@@ -0,0 +1,234 @@
+/*****************************************************************************
+
+The source code of the Parasol project is made publicly available under the
+terms described in the LICENSE.TXT file that is distributed with this package.
+Please refer to it for further information on licensing.
+
+******************************************************************************
+
+This program measures contention on the private memory registry.  Each thread allocates a batch of blocks, resolves
+them through GetMemAddress() and MemoryIDInfo(), then frees them.  The test is repeated for 1, 2, 4... threads up to
+the limit given by '-threads' so that the scaling of the registry can be observed.
+
+The registration of small blocks is checked first: MEM_UNTRACKED blocks must still be given an ID, while
+MEM_UNREGISTERED blocks must not, and the latter must survive MemoryPtrInfo() and ReallocMemory().
+
+A final test starts threads that free and allocate blocks from a thread_local destructor that runs after their slab
+cache has been released, while other threads adopt the released caches.
+
+Options: -threads [n] -blocks [n] -rounds [n] -size [n]
+
+*****************************************************************************/
+
+#include <pthread.h>
+#include <parasol/main.h>
+#include <startup.h>
+#include <parasol/modules/core.h>
+
+CSTRING ProgName      = "MemoryContention";
+CSTRING ProgAuthor    = "Paul Manias";
+CSTRING ProgDate      = "October 2026";
+CSTRING ProgCopyright = "Paul Manias (c) 2026";
+LONG  ProgDebug = -1;
+FLOAT ProgCoreVersion = 1.0;
+
+extern struct CoreBase *CoreBase;
+static LONG glTotalThreads = 8;
+static LONG glTotalBlocks  = 1000;
+static LONG glRounds       = 100;
+static LONG glBlockSize    = 64;
+static volatile LONG glFailures = 0;
+
+struct thread_info {
+   pthread_t thread;
+   LONG index;
+};
+
+//****************************************************************************
+
+static void * test_contention(thread_info *Info)
+{
+   auto ids = new MEMORYID[glTotalBlocks];
+   auto addresses = new APTR[glTotalBlocks];
+
+   for (LONG r=0; r < glRounds; r++) {
+      for (LONG i=0; i < glTotalBlocks; i++) {
+         ids[i] = 0;
+         if (AllocMemory(glBlockSize, MEM_DATA|MEM_NO_CLEAR, &addresses[i], &ids[i])) {
+            __sync_fetch_and_add(&glFailures, 1);
+            addresses[i] = NULL;
+         }
+         else ReleaseMemoryID(ids[i]);
+      }
+
+      for (LONG i=0; i < glTotalBlocks; i++) {
+         if (!addresses[i]) continue;
+         MemInfo info;
+         if (GetMemAddress(ids[i]) != addresses[i]) __sync_fetch_and_add(&glFailures, 1);
+         if ((MemoryIDInfo(ids[i], &info)) or (info.Size != glBlockSize)) __sync_fetch_and_add(&glFailures, 1);
+      }
+
+      for (LONG i=0; i < glTotalBlocks; i++) {
+         if (addresses[i]) FreeResource(addresses[i]);
+      }
+   }
+
+   delete[] ids;
+   delete[] addresses;
+   return NULL;
+}
+
+//****************************************************************************
+// Blocks held by an exit_holder are released when the thread's thread_local objects are destroyed.  The holder is
+// constructed before the first allocation, so it is destroyed after the thread has released its slab cache.
+
+struct exit_holder {
+   APTR Blocks[64] = { };
+
+   ~exit_holder() {
+      for (auto &block : Blocks) {
+         if (block) FreeResource(block);
+         APTR late;
+         if (AllocMemory(glBlockSize, MEM_DATA, &late, NULL)) __sync_fetch_and_add(&glFailures, 1);
+         else FreeResource(late);
+      }
+   }
+};
+
+static thread_local exit_holder tlExitHolder;
+
+static void * test_exit(thread_info *Info)
+{
+   auto &holder = tlExitHolder;
+   for (auto &block : holder.Blocks) {
+      MEMORYID id = 0;
+      if (AllocMemory(glBlockSize, MEM_DATA, &block, &id)) {
+         __sync_fetch_and_add(&glFailures, 1);
+         block = NULL;
+      }
+      else ReleaseMemoryID(id);
+   }
+   return NULL;
+}
+
+static void run_exit_test(LONG Threads)
+{
+   thread_info threads[Threads];
+
+   for (LONG r=0; r < glRounds; r++) {
+      for (LONG i=0; i < Threads; i++) {
+         threads[i].index = i;
+         pthread_create(&threads[i].thread, NULL, (void * (*)(void *))&test_exit, &threads[i]);
+      }
+      for (LONG i=0; i < Threads; i++) pthread_join(threads[i].thread, NULL);
+   }
+
+   print("Thread exit: %d rounds of %d threads", glRounds, Threads);
+}
+
+//****************************************************************************
+
+static void check_registration(void)
+{
+   APTR address;
+   MemInfo info;
+
+   if (!AllocMemory(glBlockSize, MEM_DATA|MEM_UNTRACKED, &address, NULL)) {
+      if ((MemoryPtrInfo(address, &info)) or (!info.MemoryID)) {
+         print("MEM_UNTRACKED block %p was not registered.", address);
+         __sync_fetch_and_add(&glFailures, 1);
+      }
+      FreeResource(address);
+   }
+   else __sync_fetch_and_add(&glFailures, 1);
+
+   STRING str;
+   if (!AllocMemory(32, MEM_STRING|MEM_UNREGISTERED, &str, NULL)) {
+      StrCopy("unregistered", str, 32);
+      if ((MemoryPtrInfo(str, &info)) or (info.MemoryID) or (info.Size != 32) or (!(info.Flags & MEM_STRING))) {
+         print("MEM_UNREGISTERED block %p reports ID %d, size %d, flags $%.4x.", str, info.MemoryID, info.Size, info.Flags);
+         __sync_fetch_and_add(&glFailures, 1);
+      }
+
+      if ((!ReallocMemory(str, 200, &str, NULL)) and (!StrMatch("unregistered", str))) FreeResource(str);
+      else {
+         print("Failed to reallocate MEM_UNREGISTERED block %p.", str);
+         __sync_fetch_and_add(&glFailures, 1);
+      }
+   }
+   else __sync_fetch_and_add(&glFailures, 1);
+}
+
+//****************************************************************************
+
+static void run_test(LONG Threads)
+{
+   thread_info threads[Threads];
+
+   LARGE start = PreciseTime();
+
+   for (LONG i=0; i < Threads; i++) {
+      threads[i].index = i;
+      pthread_create(&threads[i].thread, NULL, (void * (*)(void *))&test_contention, &threads[i]);
+   }
+
+   for (LONG i=0; i < Threads; i++) pthread_join(threads[i].thread, NULL);
+
+   LARGE elapsed = PreciseTime() - start;
+   DOUBLE ops = DOUBLE(Threads) * glRounds * glTotalBlocks;
+   print("Threads: %2d, Time: %8.2fms, %10.0f alloc/free pairs per second, %.0f per thread", Threads,
+      DOUBLE(elapsed) / 1000.0, ops * 1000000.0 / DOUBLE(elapsed), (ops * 1000000.0 / DOUBLE(elapsed)) / Threads);
+}
+
+//****************************************************************************
+
+int main(int argc, CSTRING *argv)
+{
+   const char *msg = init_parasol(argc, argv);
+   if (msg) {
+      print(msg);
+      return -1;
+   }
+
+   CSTRING *args;
+   if ((!GetPointer(CurrentTask(), FID_Parameters, &args)) and (args)) {
+      for (LONG i=0; args[i]; i++) {
+         if (!StrMatch(args[i], "-threads")) {
+            if (args[++i]) glTotalThreads = StrToInt(args[i]);
+            else break;
+         }
+         else if (!StrMatch(args[i], "-blocks")) {
+            if (args[++i]) glTotalBlocks = StrToInt(args[i]);
+            else break;
+         }
+         else if (!StrMatch(args[i], "-rounds")) {
+            if (args[++i]) glRounds = StrToInt(args[i]);
+            else break;
+         }
+         else if (!StrMatch(args[i], "-size")) {
+            if (args[++i]) glBlockSize = StrToInt(args[i]);
+            else break;
+         }
+      }
+   }
+
+   print("Blocks per round: %d, Rounds: %d, Block size: %d", glTotalBlocks, glRounds, glBlockSize);
+
+   check_registration();
+
+   for (LONG threads=1; threads <= glTotalThreads; threads *= 2) run_test(threads);
+
+   run_exit_test(glTotalThreads);
+
+   auto state = GetSystemState();
+   for (LONG i=0; i < state->TotalSlabClasses; i++) {
+      auto &slab = state->Slabs[i];
+      print("Slab %3d: %8d pages, " PF64() " allocations, " PF64() " frees, " PF64() " remote frees", slab.Size, slab.Pages, slab.Allocations, slab.Frees, slab.RemoteFrees);
+   }
+   print("Slab misses: " PF64(), state->SlabMisses);
+
+   if (glFailures) print("%d operations failed.", glFailures);
+
+   close_parasol();
+   return glFailures ? -1 : 0;
+}
@@ -0,0 +1,259 @@
+/*****************************************************************************
+
+The source code of the Parasol project is made publicly available under the
+terms described in the LICENSE.TXT file that is distributed with this package.
+Please refer to it for further information on licensing.
+
+******************************************************************************
+
+This program measures the throughput of the task message queue.  A number of threads write messages to the queue of
+the current task while the main thread dispatches them with ProcessMessages().  Every message carries a sequence
+number so that lost, duplicated and reordered messages are detected.  The MSF_NO_DUPLICATE and MSF_UPDATE flags are
+then checked against a queue that is not being processed, and against messages that have been moved to the dispatch
+batch but are yet to be dispatched.
+
+Options: -threads [n] -messages [n] -size [n]
+
+*****************************************************************************/
+
+#include <pthread.h>
+#include <sched.h>
+#include <parasol/main.h>
+#include <startup.h>
+#include <parasol/modules/core.h>
+
+CSTRING ProgName      = "MessageQueue";
+CSTRING ProgAuthor    = "Paul Manias";
+CSTRING ProgDate      = "October 2026";
+CSTRING ProgCopyright = "Paul Manias (c) 2026";
+LONG  ProgDebug = -1;
+FLOAT ProgCoreVersion = 1.0;
+
+extern struct CoreBase *CoreBase;
+static LONG glTotalThreads  = 4;
+static LONG glTotalMessages = 100000;
+static LONG glMessageSize   = 16;
+static LONG glMsgType       = 0;
+static LONG glReceived      = 0;
+static LONG glFailures      = 0;
+static volatile LONG glQueueFull = 0;
+static LONG *glLastSequence = NULL;
+
+struct thread_info {
+   pthread_t thread;
+   LONG index;
+};
+
+struct test_msg {
+   LONG Thread;
+   LONG Sequence;
+};
+
+//****************************************************************************
+
+static ERROR msg_handler(APTR Custom, LONG MsgID, LONG MsgType, APTR Message, LONG MsgSize)
+{
+   auto msg = (test_msg *)Message;
+   if ((!msg) or (MsgSize != glMessageSize)) glFailures++;
+   else if (msg->Sequence != glLastSequence[msg->Thread] + 1) glFailures++;
+   else glLastSequence[msg->Thread] = msg->Sequence;
+   glReceived++;
+   return ERR_Okay;
+}
+
+//****************************************************************************
+
+static void * send_messages(thread_info *Info)
+{
+   UBYTE buffer[glMessageSize];
+   auto msg = (test_msg *)buffer;
+   msg->Thread = Info->index;
+
+   for (LONG i=0; i < glTotalMessages; i++) {
+      msg->Sequence = i;
+      ERROR error;
+      while ((error = SendMessage(0, glMsgType, 0, buffer, glMessageSize)) IS ERR_ArrayFull) {
+         __sync_fetch_and_add(&glQueueFull, 1);
+         sched_yield();
+      }
+      if (error) __sync_fetch_and_add(&glFailures, 1);
+   }
+
+   return NULL;
+}
+
+//****************************************************************************
+
+static void run_test(LONG Threads)
+{
+   thread_info threads[Threads];
+
+   glReceived = 0;
+   glQueueFull = 0;
+   for (LONG i=0; i < Threads; i++) glLastSequence[i] = -1;
+
+   LARGE start = PreciseTime();
+
+   for (LONG i=0; i < Threads; i++) {
+      threads[i].index = i;
+      pthread_create(&threads[i].thread, NULL, (void * (*)(void *))&send_messages, &threads[i]);
+   }
+
+   LONG expected = Threads * glTotalMessages;
+   while (glReceived < expected) {
+      if (ProcessMessages(0, 10) IS ERR_Terminate) break;
+   }
+
+   for (LONG i=0; i < Threads; i++) pthread_join(threads[i].thread, NULL);
+
+   LARGE elapsed = PreciseTime() - start;
+   print("Threads: %2d, Time: %8.2fms, %10.0f messages per second, queue full %d times", Threads,
+      DOUBLE(elapsed) / 1000.0, DOUBLE(expected) * 1000000.0 / DOUBLE(elapsed), glQueueFull);
+}
+
+//****************************************************************************
+// Messages are only dispatched by ProcessMessages(), so the queue can be inspected with GetMessage() in between.
+
+static void test_flags(void)
+{
+   test_msg msg = { 0, 0 };
+
+   SendMessage(0, glMsgType, MSF_NO_DUPLICATE, &msg, sizeof(msg));
+   msg.Sequence = 1;
+   SendMessage(0, glMsgType, MSF_NO_DUPLICATE, &msg, sizeof(msg));
+
+   UBYTE buffer[sizeof(Message) + sizeof(test_msg)];
+   auto received = (test_msg *)(buffer + sizeof(Message));
+   if ((GetMessage(0, glMsgType, 0, buffer, sizeof(buffer))) or (received->Sequence != 0)) {
+      print("MSF_NO_DUPLICATE failed to keep the first message.");
+      glFailures++;
+   }
+   if (!GetMessage(0, glMsgType, 0, buffer, sizeof(buffer))) {
+      print("MSF_NO_DUPLICATE failed to drop the second message.");
+      glFailures++;
+   }
+
+   for (LONG i=0; i < 3; i++) {
+      msg.Sequence = i;
+      SendMessage(0, glMsgType, MSF_UPDATE, &msg, sizeof(msg));
+   }
+
+   if ((GetMessage(0, glMsgType, 0, buffer, sizeof(buffer))) or (received->Sequence != 2)) {
+      print("MSF_UPDATE did not retain the most recent message.");
+      glFailures++;
+   }
+   if (!GetMessage(0, glMsgType, 0, buffer, sizeof(buffer))) {
+      print("MSF_UPDATE failed to replace earlier messages.");
+      glFailures++;
+   }
+}
+
+//****************************************************************************
+// ProcessMessages() moves waiting messages to a batch before dispatching them.  Messages that are sent while a batch
+// is being dispatched must still respect MSF_NO_DUPLICATE and MSF_UPDATE for the messages that remain in the batch.
+
+static LONG glTriggerType = 0, glDupType = 0, glUpdateType = 0;
+static LONG glDupReceived = 0, glUpdateReceived = 0, glUpdateSequence = -1;
+
+static ERROR batch_handler(APTR Custom, LONG MsgID, LONG MsgType, APTR Message, LONG MsgSize)
+{
+   test_msg msg = { 0, 1 };
+   if (MsgType IS glTriggerType) {
+      SendMessage(0, glDupType, MSF_NO_DUPLICATE, &msg, sizeof(msg));
+      SendMessage(0, glUpdateType, MSF_UPDATE, &msg, sizeof(msg));
+   }
+   else if (MsgType IS glDupType) glDupReceived++;
+   else if (MsgType IS glUpdateType) {
+      glUpdateReceived++;
+      glUpdateSequence = ((test_msg *)Message)->Sequence;
+   }
+   else return ERR_NoSupport;
+   return ERR_Okay;
+}
+
+static void test_batch_flags(void)
+{
+   glTriggerType = AllocateID(IDTYPE_MESSAGE);
+   glDupType     = AllocateID(IDTYPE_MESSAGE);
+   glUpdateType  = AllocateID(IDTYPE_MESSAGE);
+
+   auto call = make_function_stdc(batch_handler);
+   MsgHandler *handler;
+   if (AddMsgHandler(NULL, 0, &call, &handler)) {
+      glFailures++;
+      return;
+   }
+
+   test_msg msg = { 0, 0 };
+   SendMessage(0, glTriggerType, 0, &msg, sizeof(msg));
+   SendMessage(0, glDupType, MSF_NO_DUPLICATE, &msg, sizeof(msg));
+   SendMessage(0, glUpdateType, MSF_UPDATE, &msg, sizeof(msg));
+
+   for (LONG i=0; i < 3; i++) ProcessMessages(0, 0);
+
+   FreeResource(handler);
+
+   if (glDupReceived != 1) {
+      print("MSF_NO_DUPLICATE delivered %d messages while the first was waiting in the batch.", glDupReceived);
+      glFailures++;
+   }
+
+   if ((glUpdateReceived != 1) or (glUpdateSequence != 1)) {
+      print("MSF_UPDATE delivered %d messages, last sequence %d, while the first was waiting in the batch.", glUpdateReceived, glUpdateSequence);
+      glFailures++;
+   }
+}
+
+//****************************************************************************
+
+int main(int argc, CSTRING *argv)
+{
+   const char *msg = init_parasol(argc, argv);
+   if (msg) {
+      print(msg);
+      return -1;
+   }
+
+   CSTRING *args;
+   if ((!GetPointer(CurrentTask(), FID_Parameters, &args)) and (args)) {
+      for (LONG i=0; args[i]; i++) {
+         if (!StrMatch(args[i], "-threads")) {
+            if (args[++i]) glTotalThreads = StrToInt(args[i]);
+            else break;
+         }
+         else if (!StrMatch(args[i], "-messages")) {
+            if (args[++i]) glTotalMessages = StrToInt(args[i]);
+            else break;
+         }
+         else if (!StrMatch(args[i], "-size")) {
+            if (args[++i]) glMessageSize = StrToInt(args[i]);
+            else break;
+         }
+      }
+   }
+
+   if (glMessageSize < (LONG)sizeof(test_msg)) glMessageSize = sizeof(test_msg);
+
+   glMsgType = AllocateID(IDTYPE_MESSAGE);
+   glLastSequence = new LONG[glTotalThreads];
+
+   test_flags();
+   test_batch_flags();
+
+   auto call = make_function_stdc(msg_handler);
+   MsgHandler *handler;
+   if (!AddMsgHandler(NULL, glMsgType, &call, &handler)) {
+      print("Messages per thread: %d, Message size: %d", glTotalMessages, glMessageSize);
+
+      for (LONG threads=1; threads <= glTotalThreads; threads *= 2) run_test(threads);
+
+      FreeResource(handler);
+   }
+   else glFailures++;
+
+   if (glFailures) print("%d failures detected.", glFailures);
+
+   delete[] glLastSequence;
+   close_parasol();
+   return glFailures ? -1 : 0;
+}
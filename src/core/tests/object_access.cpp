@@ -0,0 +1,269 @@
+/*****************************************************************************
+
+The source code of the Parasol project is made publicly available under the
+terms described in the LICENSE.TXT file that is distributed with this package.
+Please refer to it for further information on licensing.
+
+******************************************************************************
+
+This program measures the cost of resolving and locking private objects.  Uncontended AccessObject(),
+AccessPrivateObject() and GetObjectPtr() calls are timed on a set of Time objects, then an increasing number of threads
+lock objects by ID in parallel.  Finally all threads compete for a single object and increment a counter that is only
+protected by the object lock, so that any failure of mutual exclusion is detected.  The last test resolves objects
+from several threads while the main thread creates and frees enough objects to replace the object table repeatedly.
+
+Options: -objects [n] -threads [n] -calls [n]
+
+*****************************************************************************/
+
+#include <pthread.h>
+#include <parasol/main.h>
+#include <startup.h>
+#include <parasol/modules/core.h>
+
+CSTRING ProgName      = "ObjectAccess";
+CSTRING ProgAuthor    = "Paul Manias";
+CSTRING ProgDate      = "October 2026";
+CSTRING ProgCopyright = "Paul Manias (c) 2026";
+LONG  ProgDebug = -1;
+FLOAT ProgCoreVersion = 1.0;
+
+extern struct CoreBase *CoreBase;
+static LONG glTotalObjects = 1000;
+static LONG glTotalThreads = 4;
+static LONG glTotalCalls   = 1000000;
+static LONG glFailures     = 0;
+static LONG glCounter      = 0;
+static LONG glStop         = 0;
+static OBJECTPTR *glObjects = NULL;
+
+struct thread_info {
+   pthread_t thread;
+   LONG index;
+};
+
+//****************************************************************************
+
+static void report(CSTRING Label, LONG Total, LARGE Elapsed)
+{
+   print("%-20s %8d calls, %7.1fns per call", Label, Total, DOUBLE(Elapsed) * 1000.0 / DOUBLE(Total));
+}
+
+//****************************************************************************
+
+static void test_uncontended(void)
+{
+   LARGE start = PreciseTime();
+   for (LONG i=0; i < glTotalCalls; i++) {
+      OBJECTPTR obj = glObjects[i % glTotalObjects];
+      OBJECTPTR locked;
+      if (!AccessObject(obj->UniqueID, 1000, &locked)) {
+         if (locked != obj) glFailures++;
+         ReleaseObject(locked);
+      }
+      else glFailures++;
+   }
+   report("AccessObject", glTotalCalls, PreciseTime() - start);
+
+   start = PreciseTime();
+   for (LONG i=0; i < glTotalCalls; i++) {
+      OBJECTPTR obj = glObjects[i % glTotalObjects];
+      if (!AccessPrivateObject(obj, 1000)) ReleasePrivateObject(obj);
+      else glFailures++;
+   }
+   report("AccessPrivateObject", glTotalCalls, PreciseTime() - start);
+
+   start = PreciseTime();
+   for (LONG i=0; i < glTotalCalls; i++) {
+      OBJECTPTR obj = glObjects[i % glTotalObjects];
+      if (GetObjectPtr(obj->UniqueID) != obj) glFailures++;
+   }
+   report("GetObjectPtr", glTotalCalls, PreciseTime() - start);
+
+   // Nested locks must be released in full before another thread can gain access.
+
+   OBJECTPTR obj = glObjects[0];
+   if (!AccessPrivateObject(obj, 1000)) {
+      if (!AccessPrivateObject(obj, 1000)) ReleasePrivateObject(obj);
+      else glFailures++;
+      if (obj->Queue != 1) glFailures++;
+      ReleasePrivateObject(obj);
+   }
+   else glFailures++;
+   if ((obj->Queue) or (obj->Locked)) glFailures++;
+}
+
+//****************************************************************************
+// Each thread locks objects from its own range, so there is no contention on the locks themselves.
+
+static void * access_objects(thread_info *Info)
+{
+   LONG range = glTotalObjects / glTotalThreads;
+   if (range < 1) range = 1;
+   LONG first = (Info->index * range) % glTotalObjects;
+
+   for (LONG i=0; i < glTotalCalls; i++) {
+      OBJECTPTR obj = glObjects[first + (i % range)];
+      OBJECTPTR locked;
+      if (!AccessObject(obj->UniqueID, 5000, &locked)) ReleaseObject(locked);
+      else __sync_fetch_and_add(&glFailures, 1);
+   }
+   return NULL;
+}
+
+static void test_parallel(void)
+{
+   for (LONG total=1; total <= glTotalThreads; total *= 2) {
+      thread_info threads[total];
+      LARGE start = PreciseTime();
+      for (LONG i=0; i < total; i++) {
+         threads[i].index = i;
+         pthread_create(&threads[i].thread, NULL, (void * (*)(void *))&access_objects, &threads[i]);
+      }
+      for (LONG i=0; i < total; i++) pthread_join(threads[i].thread, NULL);
+      LARGE elapsed = PreciseTime() - start;
+
+      print("Threads: %2d, %10.0f locks per second", total, DOUBLE(total) * DOUBLE(glTotalCalls) * 1000000.0 / DOUBLE(elapsed));
+   }
+}
+
+//****************************************************************************
+// All threads compete for the same object.  The counter is not atomic, so lost increments indicate a broken lock.
+
+static void * increment_counter(thread_info *Info)
+{
+   OBJECTPTR obj = glObjects[0];
+   LONG total = glTotalCalls / 10;
+   for (LONG i=0; i < total; i++) {
+      if (!AccessPrivateObject(obj, 5000)) {
+         glCounter++;
+         ReleasePrivateObject(obj);
+      }
+      else __sync_fetch_and_add(&glFailures, 1);
+   }
+   return NULL;
+}
+
+static void test_contended(void)
+{
+   thread_info threads[glTotalThreads];
+   glCounter = 0;
+
+   LARGE start = PreciseTime();
+   for (LONG i=0; i < glTotalThreads; i++) {
+      threads[i].index = i;
+      pthread_create(&threads[i].thread, NULL, (void * (*)(void *))&increment_counter, &threads[i]);
+   }
+   for (LONG i=0; i < glTotalThreads; i++) pthread_join(threads[i].thread, NULL);
+   LARGE elapsed = PreciseTime() - start;
+
+   LONG expected = (glTotalCalls / 10) * glTotalThreads;
+   report("Contended", expected, elapsed);
+   if (glCounter != expected) {
+      print("Counter is %d, expected %d.", glCounter, expected);
+      glFailures++;
+   }
+}
+
+//****************************************************************************
+// Readers resolve existing objects while the table is replaced underneath them.  A replaced table that is released too
+// early will return the wrong address or crash.
+
+static void * resolve_objects(thread_info *Info)
+{
+   LONG i = Info->index;
+   while (!__atomic_load_n(&glStop, __ATOMIC_ACQUIRE)) {
+      OBJECTPTR obj = glObjects[i++ % glTotalObjects];
+      if (GetObjectPtr(obj->UniqueID) != obj) __sync_fetch_and_add(&glFailures, 1);
+   }
+   return NULL;
+}
+
+static void test_rebuild(void)
+{
+   const LONG batch = 4096;
+   auto extra = new OBJECTPTR[batch];
+   thread_info threads[glTotalThreads];
+
+   glStop = 0;
+   for (LONG i=0; i < glTotalThreads; i++) {
+      threads[i].index = i;
+      pthread_create(&threads[i].thread, NULL, (void * (*)(void *))&resolve_objects, &threads[i]);
+   }
+
+   LARGE start = PreciseTime();
+   LONG total = 0;
+   for (LONG round=0; round < 10; round++) {
+      LONG created = 0;
+      for (; created < batch; created++) {
+         if (CreateObject(ID_TIME, 0, &extra[created], TAGEND)) break;
+      }
+      total += created;
+      if (created != batch) glFailures++;
+      for (LONG i=0; i < created; i++) acFree(extra[i]);
+   }
+
+   __atomic_store_n(&glStop, 1, __ATOMIC_RELEASE);
+   for (LONG i=0; i < glTotalThreads; i++) pthread_join(threads[i].thread, NULL);
+
+   report("Create during reads", total, PreciseTime() - start);
+   delete[] extra;
+}
+
+//****************************************************************************
+
+int main(int argc, CSTRING *argv)
+{
+   const char *msg = init_parasol(argc, argv);
+   if (msg) {
+      print(msg);
+      return -1;
+   }
+
+   CSTRING *args;
+   if ((!GetPointer(CurrentTask(), FID_Parameters, &args)) and (args)) {
+      for (LONG i=0; args[i]; i++) {
+         if (!StrMatch(args[i], "-objects")) {
+            if (args[++i]) glTotalObjects = StrToInt(args[i]);
+            else break;
+         }
+         else if (!StrMatch(args[i], "-threads")) {
+            if (args[++i]) glTotalThreads = StrToInt(args[i]);
+            else break;
+         }
+         else if (!StrMatch(args[i], "-calls")) {
+            if (args[++i]) glTotalCalls = StrToInt(args[i]);
+            else break;
+         }
+      }
+   }
+
+   if (glTotalObjects < 1) glTotalObjects = 1;
+   if (glTotalThreads < 1) glTotalThreads = 1;
+
+   glObjects = new OBJECTPTR[glTotalObjects];
+
+   LONG created = 0;
+   for (; created < glTotalObjects; created++) {
+      if (CreateObject(ID_TIME, 0, &glObjects[created], TAGEND)) break;
+   }
+
+   if (created IS glTotalObjects) {
+      test_uncontended();
+      test_parallel();
+      test_contended();
+      test_rebuild();
+   }
+   else {
+      print("Failed to create %d Time objects.", glTotalObjects);
+      glFailures++;
+   }
+
+   for (LONG i=0; i < created; i++) acFree(glObjects[i]);
+
+   if (glFailures) print("%d failures detected.", glFailures);
+
+   delete[] glObjects;
+   close_parasol();
+   return glFailures ? -1 : 0;
+}
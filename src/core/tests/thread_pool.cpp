@@ -0,0 +1,193 @@
+/*****************************************************************************
+
+The source code of the Parasol project is made publicly available under the
+terms described in the LICENSE.TXT file that is distributed with this package.
+Please refer to it for further information on licensing.
+
+******************************************************************************
+
+This program measures the thread pool that executes ActionThread() requests.  A set of Time objects is created and
+their Query action is called in parallel, first with ActionThread() and completion callbacks that are received
+through ProcessMessages(), then with ActionThreadBatch().  Every request carries a key so that lost and duplicated
+callbacks are detected.  Finally ThreadBatch() is called with a routine that records each index that it receives.
+
+Options: -objects [n] -actions [n] -wave [n]
+
+*****************************************************************************/
+
+#include <parasol/main.h>
+#include <startup.h>
+#include <parasol/modules/core.h>
+
+CSTRING ProgName      = "ThreadPool";
+CSTRING ProgAuthor    = "Paul Manias";
+CSTRING ProgDate      = "October 2026";
+CSTRING ProgCopyright = "Paul Manias (c) 2026";
+LONG  ProgDebug = -1;
+FLOAT ProgCoreVersion = 1.0;
+
+extern struct CoreBase *CoreBase;
+static LONG glTotalObjects = 64;
+static LONG glTotalActions = 20000;
+static LONG glWaveSize     = 500; // Limits the number of callback messages that are queued at any time
+static LONG glFailures     = 0;
+static LONG glReceived     = 0;
+static UBYTE *glKeys       = NULL;
+static OBJECTPTR *glObjects = NULL;
+
+//****************************************************************************
+
+static void action_callback(ACTIONID ActionID, OBJECTPTR Object, ERROR Error, LONG Key)
+{
+   if ((Key < 0) or (Key >= glTotalActions) or (glKeys[Key]) or (Error != ERR_Okay)) glFailures++;
+   else glKeys[Key] = 1;
+   glReceived++;
+}
+
+//****************************************************************************
+
+static void test_callbacks(void)
+{
+   auto call = make_function_stdc(action_callback);
+   ClearMemory(glKeys, glTotalActions);
+   glReceived = 0;
+
+   LARGE start = PreciseTime();
+   for (LONG i=0; i < glTotalActions; ) {
+      LONG wave = i + glWaveSize;
+      if (wave > glTotalActions) wave = glTotalActions;
+      for (; i < wave; i++) {
+         if (ActionThread(AC_Query, glObjects[i % glTotalObjects], NULL, &call, i)) {
+            glFailures++;
+            glReceived++;
+         }
+      }
+
+      LARGE timeout = PreciseTime() + 5000000LL;
+      while ((glReceived < i) and (PreciseTime() < timeout)) ProcessMessages(0, 1);
+      if (glReceived < i) {
+         print("Only %d of %d callbacks were received.", glReceived, i);
+         glFailures++;
+         return;
+      }
+   }
+   LARGE elapsed = PreciseTime() - start;
+
+   print("ActionThread: %d actions in %.2fms, %.2fus per action", glTotalActions, DOUBLE(elapsed) / 1000.0,
+      DOUBLE(elapsed) / DOUBLE(glTotalActions));
+}
+
+//****************************************************************************
+
+static void test_batch(void)
+{
+   auto actions = new ThreadAction[glTotalActions];
+   for (LONG i=0; i < glTotalActions; i++) {
+      actions[i].Object   = glObjects[i % glTotalObjects];
+      actions[i].ActionID = AC_Query;
+      actions[i].Args     = NULL;
+      actions[i].Error    = ERR_NoData;
+   }
+
+   LARGE start = PreciseTime();
+   if (ActionThreadBatch(actions, glTotalActions)) glFailures++;
+   LARGE elapsed = PreciseTime() - start;
+
+   LONG failed = 0;
+   for (LONG i=0; i < glTotalActions; i++) {
+      if (actions[i].Error) failed++;
+   }
+
+   print("ActionThreadBatch: %d actions in %.2fms, %.2fus per action, %d failed", glTotalActions,
+      DOUBLE(elapsed) / 1000.0, DOUBLE(elapsed) / DOUBLE(glTotalActions), failed);
+
+   if (failed) glFailures++;
+   delete[] actions;
+}
+
+//****************************************************************************
+
+static void count_index(LONG *Counts, LONG Index)
+{
+   __sync_fetch_and_add(&Counts[Index], 1);
+}
+
+static void test_routines(void)
+{
+   auto counts = new LONG[glTotalActions];
+   ClearMemory(counts, sizeof(LONG) * glTotalActions);
+
+   LARGE start = PreciseTime();
+   if (ThreadBatch((void (*)(APTR, LONG))&count_index, counts, glTotalActions)) glFailures++;
+   LARGE elapsed = PreciseTime() - start;
+
+   LONG failed = 0;
+   for (LONG i=0; i < glTotalActions; i++) {
+      if (counts[i] != 1) failed++;
+   }
+
+   print("ThreadBatch: %d routines in %.2fms, %.2fus per routine, %d failed", glTotalActions,
+      DOUBLE(elapsed) / 1000.0, DOUBLE(elapsed) / DOUBLE(glTotalActions), failed);
+
+   if (failed) glFailures++;
+   delete[] counts;
+}
+
+//****************************************************************************
+
+int main(int argc, CSTRING *argv)
+{
+   const char *msg = init_parasol(argc, argv);
+   if (msg) {
+      print(msg);
+      return -1;
+   }
+
+   CSTRING *args;
+   if ((!GetPointer(CurrentTask(), FID_Parameters, &args)) and (args)) {
+      for (LONG i=0; args[i]; i++) {
+         if (!StrMatch(args[i], "-objects")) {
+            if (args[++i]) glTotalObjects = StrToInt(args[i]);
+            else break;
+         }
+         else if (!StrMatch(args[i], "-actions")) {
+            if (args[++i]) glTotalActions = StrToInt(args[i]);
+            else break;
+         }
+         else if (!StrMatch(args[i], "-wave")) {
+            if (args[++i]) glWaveSize = StrToInt(args[i]);
+            else break;
+         }
+      }
+   }
+
+   if (glTotalObjects < 1) glTotalObjects = 1;
+   if (glWaveSize < 1) glWaveSize = 1;
+
+   glKeys = new UBYTE[glTotalActions];
+   glObjects = new OBJECTPTR[glTotalObjects];
+
+   LONG created = 0;
+   for (; created < glTotalObjects; created++) {
+      if (CreateObject(ID_TIME, 0, &glObjects[created], TAGEND)) break;
+   }
+
+   if (created IS glTotalObjects) {
+      test_callbacks();
+      test_batch();
+      test_routines();
+   }
+   else {
+      print("Failed to create %d Time objects.", glTotalObjects);
+      glFailures++;
+   }
+
+   for (LONG i=0; i < created; i++) acFree(glObjects[i]);
+
+   if (glFailures) print("%d failures detected.", glFailures);
+
+   delete[] glKeys;
+   delete[] glObjects;
+   close_parasol();
+   return glFailures ? -1 : 0;
+}
@@ -0,0 +1,194 @@
+/*****************************************************************************
+
+The source code of the Parasol project is made publicly available under the
+terms described in the LICENSE.TXT file that is distributed with this package.
+Please refer to it for further information on licensing.
+
+******************************************************************************
+
+This program measures the timer service.  A large number of subscriptions are created and cancelled with
+SubscribeTimer() and UpdateTimer() to time the management of the queue.  A smaller set of timers with mixed intervals
+is then run with ProcessMessages(), and the lateness of each call and the call counts are checked.
+
+Options: -timers [n] -active [n] -time [ms]
+
+*****************************************************************************/
+
+#include <parasol/main.h>
+#include <startup.h>
+#include <parasol/modules/core.h>
+
+CSTRING ProgName      = "Timers";
+CSTRING ProgAuthor    = "Paul Manias";
+CSTRING ProgDate      = "October 2026";
+CSTRING ProgCopyright = "Paul Manias (c) 2026";
+LONG  ProgDebug = -1;
+FLOAT ProgCoreVersion = 1.0;
+
+extern struct CoreBase *CoreBase;
+static LONG glTotalTimers = 10000;
+static LONG glActiveTimers = 200;
+static LONG glRunTime = 1000;
+static LONG glFailures = 0;
+
+struct timer_info {
+   APTR  Subscription;
+   LARGE Interval;  // Microseconds
+   LARGE Expected;  // PreciseTime() at which the next call is due
+   LARGE Lateness;  // Total lateness of all calls
+   LONG  Calls;
+};
+
+static timer_info *glTimers = NULL;
+
+//****************************************************************************
+
+static ERROR idle_callback(OBJECTPTR Subscriber, LARGE Elapsed, LARGE CurrentTime)
+{
+   return ERR_Okay;
+}
+
+//****************************************************************************
+// Subscriptions are created in bulk, then cancelled in a random order.
+
+static void test_management(void)
+{
+   auto subs = new APTR[glTotalTimers];
+   auto call = make_function_stdc(idle_callback);
+
+   LARGE start = PreciseTime();
+   for (LONG i=0; i < glTotalTimers; i++) {
+      if (SubscribeTimer(1.0 + (DOUBLE)(i % 1000) * 0.01, &call, &subs[i])) {
+         glFailures++;
+         subs[i] = NULL;
+      }
+   }
+   LARGE subscribed = PreciseTime();
+
+   for (LONG i=0; i < glTotalTimers; i++) { // Shuffle
+      LONG j = rand() % glTotalTimers;
+      APTR tmp = subs[i];
+      subs[i] = subs[j];
+      subs[j] = tmp;
+   }
+
+   LARGE shuffled = PreciseTime();
+   for (LONG i=0; i < glTotalTimers; i++) {
+      if ((subs[i]) and (UpdateTimer(subs[i], 0))) glFailures++;
+   }
+   LARGE end = PreciseTime();
+
+   print("Timers: %d, Subscribe: %.3fus each, Cancel: %.3fus each", glTotalTimers,
+      DOUBLE(subscribed - start) / DOUBLE(glTotalTimers), DOUBLE(end - shuffled) / DOUBLE(glTotalTimers));
+
+   delete[] subs;
+}
+
+//****************************************************************************
+// The callback does not receive the subscription, so the call is credited to the timer that is most overdue.
+
+static timer_info * find_timer(LARGE Time)
+{
+   timer_info *best = NULL;
+   for (LONG i=0; i < glActiveTimers; i++) {
+      auto &timer = glTimers[i];
+      if (timer.Expected > Time) continue;
+      if ((!best) or (timer.Expected < best->Expected)) best = &timer;
+   }
+   return best;
+}
+
+//****************************************************************************
+
+static ERROR active_callback(OBJECTPTR Subscriber, LARGE Elapsed, LARGE CurrentTime)
+{
+   LARGE now = PreciseTime();
+   if (auto timer = find_timer(now)) {
+      timer->Lateness += now - timer->Expected;
+      timer->Expected += timer->Interval;
+      timer->Calls++;
+   }
+   return ERR_Okay;
+}
+
+//****************************************************************************
+// Timers with intervals between 5ms and 100ms are run for the requested period.  An idle task should sleep until the
+// next timer is due, so the average lateness of each call indicates the precision of the sleep.
+
+static void test_precision(void)
+{
+   auto call = make_function_stdc(active_callback);
+   LARGE start = PreciseTime();
+   for (LONG i=0; i < glActiveTimers; i++) {
+      auto &timer = glTimers[i];
+      timer.Interval = 5000 + ((i * 7919) % 96) * 1000;
+      timer.Expected = start + timer.Interval;
+      timer.Lateness = 0;
+      timer.Calls    = 0;
+      if (SubscribeTimer(DOUBLE(timer.Interval) / 1000000.0, &call, &timer.Subscription)) {
+         glFailures++;
+         timer.Subscription = NULL;
+      }
+   }
+
+   ProcessMessages(0, glRunTime);
+
+   LARGE elapsed = PreciseTime() - start;
+   LONG calls = 0, expected = 0;
+   LARGE lateness = 0;
+   for (LONG i=0; i < glActiveTimers; i++) {
+      auto &timer = glTimers[i];
+      if (timer.Subscription) UpdateTimer(timer.Subscription, 0);
+      calls    += timer.Calls;
+      lateness += timer.Lateness;
+      expected += elapsed / timer.Interval;
+   }
+
+   print("Active timers: %d, Run time: %.0fms, Calls: %d of %d expected, Average lateness: %.1fus", glActiveTimers,
+      DOUBLE(elapsed) / 1000.0, calls, expected, calls ? DOUBLE(lateness) / DOUBLE(calls) : 0.0);
+
+   if (calls < (expected * 9) / 10) {
+      print("Too few timer calls were made.");
+      glFailures++;
+   }
+}
+
+//****************************************************************************
+
+int main(int argc, CSTRING *argv)
+{
+   const char *msg = init_parasol(argc, argv);
+   if (msg) {
+      print(msg);
+      return -1;
+   }
+
+   CSTRING *args;
+   if ((!GetPointer(CurrentTask(), FID_Parameters, &args)) and (args)) {
+      for (LONG i=0; args[i]; i++) {
+         if (!StrMatch(args[i], "-timers")) {
+            if (args[++i]) glTotalTimers = StrToInt(args[i]);
+            else break;
+         }
+         else if (!StrMatch(args[i], "-active")) {
+            if (args[++i]) glActiveTimers = StrToInt(args[i]);
+            else break;
+         }
+         else if (!StrMatch(args[i], "-time")) {
+            if (args[++i]) glRunTime = StrToInt(args[i]);
+            else break;
+         }
+      }
+   }
+
+   glTimers = new timer_info[glActiveTimers];
+
+   test_management();
+   test_precision();
+
+   if (glFailures) print("%d failures detected.", glFailures);
+
+   delete[] glTimers;
+   close_parasol();
+   return glFailures ? -1 : 0;
+}
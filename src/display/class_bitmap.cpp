@@ -685,8 +685,8 @@ This method performs a flood-fill operation on a bitmap.  It requires an X and Y
 initiate the flood-fill operation.  The colour value indicated in RGB will be used to change the targeted pixel and all
 adjacent pixels that share the targeted pixel's colour.
 
-The speed of the algorithm is wholly dependent on the amount of pixels that need to be filled, although hardware
-support may be used for filling if it is available.
+The fill is performed a scanline at a time, so the speed of the algorithm depends on the number of pixel rows that
+need to be filled rather than the total number of pixels.
 
 -INPUT-
 int X: The horizontal point to start the flood fill.
@@ -699,8 +699,6 @@ NullArgs
 
 *****************************************************************************/
 
-static void flood_fill(objBitmap *, LONG, LONG, ULONG, ULONG);
-
 static ERROR BITMAP_Flood(objBitmap *Self, struct bmpFlood *Args)
 {
    parasol::Log log;
@@ -713,30 +711,21 @@ static ERROR BITMAP_Flood(objBitmap *Self, struct bmpFlood *Args)
       ULONG background = Self->ReadUCPixel(Self, Args->X, Args->Y);;
 
       if (background != Args->Colour) {
-         flood_fill(Self, Args->X, Args->Y, Args->Colour, background);
+         ClipRectangle clip;
+         clip.Left   = Self->Clip.Left;
+         clip.Top    = Self->Clip.Top;
+         clip.Right  = Self->Clip.Right;
+         clip.Bottom = Self->Clip.Bottom;
+
+         span_colour span;
+         init_span_colour(span, Self, Args->Colour, 255);
+         flood_spans(Self, span, Args->X, Args->Y, clip);
       }
    }
 
    return ERR_Okay;
 }
 
-static void flood_fill(objBitmap *Self, LONG X, LONG Y, ULONG FillColour, ULONG Background)
-{
-   if ((X >= Self->Clip.Left) and (X < Self->Clip.Right) AND
-       (Y >= Self->Clip.Top) and (Y < Self->Clip.Bottom)) {
-
-      ULONG background = Self->ReadUCPixel(Self, X, Y);
-
-      if (background IS Background) {
-         Self->DrawUCPixel(Self, X, Y, FillColour);
-         flood_fill(Self, X + 1, Y, FillColour, Background);
-         flood_fill(Self, X - 1, Y, FillColour, Background);
-         flood_fill(Self, X, Y + 1, FillColour, Background);
-         flood_fill(Self, X, Y - 1, FillColour, Background);
-      }
-   }
-}
-
 /******************************************************************************
 -ACTION-
 Flush: Flushes pending graphics operations and returns when the accelerator is idle.
@@ -765,8 +754,11 @@ static ERROR BITMAP_Flush(objBitmap *Self, APTR Void)
 static ERROR BITMAP_Free(objBitmap *Self, APTR Void)
 {
    #ifdef __xwindows__
+      discard_damage(Self, Self->x11.drawable);
+
       if (Self->x11.XShmImage IS TRUE) {
-         // Tell the X11 server to detach from the memory block
+         // Tell the X11 server to detach from the memory block once it has finished reading it
+         sync_shm_image(Self);
          XShmDetach(XDisplay, &Self->x11.ShmInfo);
          Self->x11.XShmImage = FALSE;
       }
@@ -1140,6 +1132,9 @@ Lock: Locks the bitmap surface so that you can manipulate the graphics directly.
 static ERROR BITMAP_Lock(objBitmap *Self, APTR Void)
 {
 #ifdef __xwindows__
+   if ((Self->x11.drawable) and (glDamage.Total)) flush_damage();
+   sync_shm_image(Self);
+
    if (Self->x11.drawable) {
       WORD alignment;
       LONG size, bpp;
@@ -1467,7 +1462,7 @@ static ERROR BITMAP_Read(objBitmap *Self, struct acRead *Args)
 static ERROR BITMAP_ReleaseObject(objBitmap *Self, APTR Void)
 {
 #ifdef __xwindows__
-   XSync(XDisplay, False);
+   if (!glHeadless) XSync(XDisplay, False);
 #endif
 
    if ((Self->Data) and (Self->DataMID)) { ReleaseMemoryID(Self->DataMID); Self->Data = NULL; }
@@ -1602,6 +1597,8 @@ setfields:
 #ifdef __xwindows__
    WORD alignment;
    if (Self->x11.XShmImage) {
+      discard_damage(Self, 0);
+      sync_shm_image(Self);
       Self->x11.XShmImage = FALSE; // Set to FALSE in case we fail (will drop through to standard XImage support)
       XShmDetach(XDisplay, &Self->x11.ShmInfo);  // Remove the previous attachment
       XSync(XDisplay, False);
@@ -1672,7 +1669,7 @@ setfields:
    }
 
 #ifdef __xwindows__
-   XSync(XDisplay, False);
+   if (!glHeadless) XSync(XDisplay, False);
 #endif
    return ERR_Okay;
 }
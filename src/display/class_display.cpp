@@ -410,6 +410,7 @@ Flush: Flush pending graphics operations to the display.
 static ERROR DISPLAY_Flush(objDisplay *Self, APTR Void)
 {
 #ifdef __xwindows__
+   present_frame();
    XSync(XDisplay, False);
 #elif _GLES_
    if (!lock_graphics_active(__func__)) {
@@ -457,6 +458,8 @@ static ERROR DISPLAY_Free(objDisplay *Self, APTR Void)
    if (XDisplay) {
       while (XCheckWindowEvent(XDisplay, Self->XWindowHandle, ExposureMask, &xevent) IS True);
 
+      discard_damage(NULL, Self->XWindowHandle);
+
       if (!(Self->Flags & SCR_CUSTOM_WINDOW)) {
          if (Self->WindowHandle) {
             XDestroyWindow(XDisplay, Self->XWindowHandle);
@@ -2542,6 +2545,7 @@ static ERROR SET_Flags(objDisplay *Self, LONG Value)
          swa.event_mask  = 0;
          XChangeWindowAttributes(XDisplay, Self->XWindowHandle, CWEventMask, &swa);
 
+         discard_damage(NULL, Self->XWindowHandle);
          XDestroyWindow(XDisplay, Self->XWindowHandle);
          Self->WindowHandle = NULL;
 
@@ -111,7 +111,7 @@ static struct {
 
 static resolution * get_resolutions(objDisplay *);
 static ERROR create_bitmap_class(void);
-static ERROR dither(objBitmap *, objBitmap *, ColourFormat *, LONG, LONG, LONG, LONG, LONG, LONG);
+static ERROR dither(objBitmap *, objBitmap *, ColourFormat *, LONG, LONG, LONG, LONG, LONG, LONG, LONG);
 
 static SharedControl *glSharedControl = NULL;
 static LONG glSixBitDisplay = FALSE;
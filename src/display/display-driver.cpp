@@ -279,6 +279,8 @@ static OBJECTID glPointerID = 0;
 static DISPLAYINFO *glDisplayInfo;
 static APTR glDither = NULL;
 static LONG glDitherSize = 0;
+static UBYTE *glDitherCube = NULL;
+static ULONG glDitherCubeHash = 0;
 
 //****************************************************************************
 // Alpha blending data.
@@ -292,6 +294,27 @@ INLINE UBYTE clipByte(LONG value)
    return value;
 }
 
+#include "lib_blit.cpp"
+#include "lib_dither.cpp"
+
+// Returns true if the pixels of a bitmap are held in client memory with the layout that the blitting kernels expect.
+
+static bool is_mem_bitmap(objBitmap *Bitmap)
+{
+   if (Bitmap->Type != BMP_CHUNKY) return false;
+#ifdef _WIN32
+   if (Bitmap->prvAFlags & BF_WINVIDEO) return false;
+#endif
+   return !(Bitmap->DataFlags & (MEM_VIDEO|MEM_TEXTURE));
+}
+
+#include "lib_resample.cpp"
+#include "lib_spans.cpp"
+
+#ifdef __xwindows__
+#include "x11/lib_present.cpp"
+#endif
+
 //****************************************************************************
 // GLES specific functions
 
@@ -621,41 +644,52 @@ static ERROR get_display_info(OBJECTID DisplayID, DISPLAYINFO *Info, LONG InfoSi
       Info->Flags = 0;
 
 #ifdef __xwindows__
-      XPixmapFormatValues *list;
-      LONG count, i;
-
-      Info->Width  = glRootWindow.width;
-      Info->Height = glRootWindow.height;
-      Info->AccelFlags = -1;
-      #warning TODO: Get display density
-      Info->VDensity = 96;
-      Info->HDensity = 96;
-
-      if (glDGAAvailable IS TRUE) {
-         Info->AccelFlags &= ~ACF_VIDEO_BLIT; // Turn off video blitting when DGA is active
+      if (glHeadless) { // There is no X server to query, so the defaults of a display-less build are returned
+         Info->Width         = 1024;
+         Info->Height        = 768;
+         Info->BitsPerPixel  = 32;
+         Info->BytesPerPixel = 4;
+         Info->AccelFlags    = ACF_SOFTWARE_BLIT;
+         Info->HDensity      = 96;
+         Info->VDensity      = 96;
       }
+      else {
+         XPixmapFormatValues *list;
+         LONG count, i;
+
+         Info->Width  = glRootWindow.width;
+         Info->Height = glRootWindow.height;
+         Info->AccelFlags = -1;
+         #warning TODO: Get display density
+         Info->VDensity = 96;
+         Info->HDensity = 96;
 
-      Info->BitsPerPixel = DefaultDepth(XDisplay, DefaultScreen(XDisplay));
+         if (glDGAAvailable IS TRUE) {
+            Info->AccelFlags &= ~ACF_VIDEO_BLIT; // Turn off video blitting when DGA is active
+         }
 
-      if (Info->BitsPerPixel <= 8) Info->BytesPerPixel = 1;
-      else if (Info->BitsPerPixel <= 16) Info->BytesPerPixel = 2;
-      else if (Info->BitsPerPixel <= 24) Info->BytesPerPixel = 3;
-      else Info->BytesPerPixel = 4;
+         Info->BitsPerPixel = DefaultDepth(XDisplay, DefaultScreen(XDisplay));
 
-      if ((list = XListPixmapFormats(XDisplay, &count))) {
-         for (i=0; i < count; i++) {
-            if (list[i].depth IS Info->BitsPerPixel) {
-               Info->BytesPerPixel = list[i].bits_per_pixel;
-               if (list[i].bits_per_pixel <= 8) Info->BytesPerPixel = 1;
-               else if (list[i].bits_per_pixel <= 16) Info->BytesPerPixel = 2;
-               else if (list[i].bits_per_pixel <= 24) Info->BytesPerPixel = 3;
-               else {
-                  Info->BytesPerPixel = 4;
-                  Info->BitsPerPixel  = 32;
+         if (Info->BitsPerPixel <= 8) Info->BytesPerPixel = 1;
+         else if (Info->BitsPerPixel <= 16) Info->BytesPerPixel = 2;
+         else if (Info->BitsPerPixel <= 24) Info->BytesPerPixel = 3;
+         else Info->BytesPerPixel = 4;
+
+         if ((list = XListPixmapFormats(XDisplay, &count))) {
+            for (i=0; i < count; i++) {
+               if (list[i].depth IS Info->BitsPerPixel) {
+                  Info->BytesPerPixel = list[i].bits_per_pixel;
+                  if (list[i].bits_per_pixel <= 8) Info->BytesPerPixel = 1;
+                  else if (list[i].bits_per_pixel <= 16) Info->BytesPerPixel = 2;
+                  else if (list[i].bits_per_pixel <= 24) Info->BytesPerPixel = 3;
+                  else {
+                     Info->BytesPerPixel = 4;
+                     Info->BitsPerPixel  = 32;
+                  }
                }
             }
+            XFree(list);
          }
-         XFree(list);
       }
 
 #elif _WIN32
@@ -949,6 +983,7 @@ static ERROR CMDInit(OBJECTPTR argModule, struct CoreBase *argCoreBase)
          if (XShmQueryVersion(XDisplay, &shmmajor, &shmminor, &pixmaps)) {
             log.msg("X11 shared image extension is active.");
             glX11ShmImage = TRUE;
+            glShmCompletion = XShmGetEventBase(XDisplay) + ShmCompletion;
          }
       #endif
 
@@ -1022,17 +1057,11 @@ static ERROR CMDInit(OBJECTPTR argModule, struct CoreBase *argCoreBase)
    // Initialise 64K alpha blending table, for cutting down on multiplications.  This memory block is shared, so one
    // table serves all processes.
 
-   log.msg("Initialise blending table.");
+   log.msg("Initialise blending table, %s blitting kernels.", glBlitISANames[glBlitISA]);
 
    memoryid = RPM_AlphaBlend;
    if (!(error = AllocMemory(256 * 256, MEM_UNTRACKED|MEM_PUBLIC|MEM_RESERVED|MEM_NO_BLOCKING, &glAlphaLookup, &memoryid))) {
-      LONG i = 0;
-      for (WORD iAlpha=0; iAlpha < 256; iAlpha++) {
-         DOUBLE fAlpha = (DOUBLE)iAlpha * (1.0 / 255.0);
-         for (WORD iValue=0; iValue < 256; iValue++) {
-            glAlphaLookup[i++] = clipByte(F2I((DOUBLE)iValue * fAlpha));
-         }
-      }
+      build_alpha_lookup(glAlphaLookup);
    }
    else if (error IS ERR_ResourceExists) {
       if (!glAlphaLookup) {
@@ -1063,6 +1092,7 @@ static ERROR CMDExpunge(void)
    if (glCompress)    { acFree(glCompress); glCompress = NULL; }
    if (glAlphaLookup) { ReleaseMemory(glAlphaLookup); glAlphaLookup = NULL; }
    if (glDither)      { FreeResource(glDither); glDither = NULL; }
+   if (glDitherCube)  { FreeResource(glDitherCube); glDitherCube = NULL; }
 
    DeregisterFD((HOSTHANDLE)-2); // Disable input_event_loop()
 
@@ -1086,6 +1116,9 @@ static ERROR CMDExpunge(void)
       XSetIOErrorHandler(NULL);
 
       if (XDisplay) {
+         flush_damage();
+         sync_shm_image(NULL);
+
          for (i=0; i < ARRAYSIZE(XCursors); i++) {
             if (XCursors[i].XCursor) XFreeCursor(XDisplay, XCursors[i].XCursor);
          }
@@ -2314,6 +2347,9 @@ static ERROR LockSurface(objBitmap *Bitmap, WORD Access)
    LONG size;
    WORD alignment;
 
+   if ((Bitmap->x11.drawable) and (glDamage.Total)) flush_damage(); // Drawing to a window must follow queued damage
+   if (Access & SURFACE_WRITE) sync_shm_image(Bitmap);
+
    if ((Bitmap->Flags & BMF_X11_DGA) and (glDGAAvailable)) {
       return ERR_Okay;
    }
@@ -2510,8 +2546,10 @@ If the TRANSPARENT flag is set in the source object, all colours that match the
 the copy operation.
 
 To enable dithering, pass BAF_DITHER in the Flags argument.  The drawing algorithm will use dithering if the source
-needs to be down-sampled to the target bitmap's bit depth.  To enable alpha blending, set BAF_BLEND (the source bitmap
-will also need to have the BMF_ALPHA_CHANNEL flag set to indicate that an alpha channel is available).
+needs to be down-sampled to the target bitmap's bit depth.  Floyd-Steinberg error diffusion is used by default.  Add
+BAF_ORDERED for an ordered dither, which is faster and gives output that is stable when the source is animated.  To
+enable alpha blending, set BAF_BLEND (the source bitmap will also need to have the BMF_ALPHA_CHANNEL flag set to
+indicate that an alpha channel is available).
 
 -INPUT-
 obj(Bitmap) Bitmap: The source bitmap.
@@ -2845,6 +2883,7 @@ static ERROR gfxCopyArea(objBitmap *Bitmap, objBitmap *dest, LONG Flags, LONG X,
             dest->Clip.Bottom = cb;
          }
          else if (Bitmap->Flags & BMF_TRANSPARENT) {
+            flush_damage();
             while (Height > 0) {
                for (i = 0; i < Width; i++) {
                   colour = Bitmap->ReadUCPixel(Bitmap, X + i, Y);
@@ -2855,23 +2894,15 @@ static ERROR gfxCopyArea(objBitmap *Bitmap, objBitmap *dest, LONG Flags, LONG X,
             }
          }
          else {
-            // Source is an ximage, destination is a pixmap
-
-            if (Bitmap->x11.XShmImage IS TRUE)  {
-               if (XShmPutImage(XDisplay, dest->x11.drawable, glXGC, &Bitmap->x11.ximage, X, Y, DestX, DestY, Width, Height, False)) {
+            // Source is an ximage, destination is a pixmap.  The area is batched with the rest of the frame.
 
-               }
-               else log.warning("XShmPutImage() failed.");
-            }
-            else {
-               XPutImage(XDisplay, dest->x11.drawable, glXGC,
-                  &Bitmap->x11.ximage, X, Y, DestX, DestY, Width, Height);
-            }
+            present_area(Bitmap, dest->x11.drawable, X, Y, Width, Height, DestX, DestY);
          }
       }
       else {
          // Both the source and the destination are pixmaps
 
+         flush_damage();
          XCopyArea(XDisplay, Bitmap->x11.drawable, dest->x11.drawable,
             glXGC, X, Y, Width, Height, DestX, DestY);
       }
@@ -2948,113 +2979,38 @@ static ERROR gfxCopyArea(objBitmap *Bitmap, objBitmap *dest, LONG Flags, LONG X,
 
       if (!LockSurface(Bitmap, SURFACE_READ)) {
          if (!LockSurface(dest, SURFACE_WRITE)) {
-            UBYTE red, green, blue, *dest_lookup;
+            UBYTE red, green, blue;
             UWORD alpha;
 
-            dest_lookup = glAlphaLookup + (255<<8);
+            const blit_params params = { *Bitmap->ColourFormat, *dest->ColourFormat, UBYTE(Bitmap->Opacity), (Flags & BAF_COPY) ? true : false };
 
             if (dest->BitsPerPixel IS 32) { // Both bitmaps are 32 bit
-               const UBYTE sA = Bitmap->ColourFormat->AlphaPos>>3;
-               const UBYTE sR = Bitmap->ColourFormat->RedPos>>3;
-               const UBYTE sG = Bitmap->ColourFormat->GreenPos>>3;
-               const UBYTE sB = Bitmap->ColourFormat->BluePos>>3;
-               const UBYTE dA = dest->ColourFormat->AlphaPos>>3;
-               const UBYTE dR = dest->ColourFormat->RedPos>>3;
-               const UBYTE dG = dest->ColourFormat->GreenPos>>3;
-               const UBYTE dB = dest->ColourFormat->BluePos>>3;
-
-               UBYTE *sdata = Bitmap->Data + (Y * Bitmap->LineWidth) + (X<<2);
+               const UBYTE *sdata = Bitmap->Data + (Y * Bitmap->LineWidth) + (X<<2);
                UBYTE *ddata = dest->Data + (DestY * dest->LineWidth) + (DestX<<2);
+               const BLIT_ROW blend = (Bitmap IS dest) ? blend32_scalar : glBlitKernels[glBlitISA].Blend32;
 
-               if (Flags & BAF_COPY) { // Avoids blending in cases where the destination pixel is empty.
-                  for (LONG y=0; y < Height; y++) {
-                     UBYTE *sp = sdata, *dp = ddata;
-                     for (LONG x=0; x < Width; x++) {
-                        if (dp[dA]) {
-                           if (sp[sA] IS 0xff) ((ULONG *)dp)[0] = ((ULONG *)sp)[0];
-                           else if (sp[sA]) {
-                              dp[dR] = dp[dR] + (((sp[sR] - dp[dR]) * sp[sA])>>8);
-                              dp[dG] = dp[dG] + (((sp[sG] - dp[dG]) * sp[sA])>>8);
-                              dp[dB] = dp[dB] + (((sp[sB] - dp[dB]) * sp[sA])>>8);
-                              dp[dA] = dp[dA] + ((sp[sA] * (0xff-dp[dA]))>>8);
-                           }
-                        }
-                        else ((ULONG *)dp)[0] = ((ULONG *)sp)[0];
-
-                        sp += 4;
-                        dp += 4;
-                     }
-                     sdata += Bitmap->LineWidth;
-                     ddata += dest->LineWidth;
-                  }
-               }
-               else {
-                  while (Height > 0) {
-                     UBYTE *sp = sdata, *dp = ddata;
-                     if (Bitmap->Opacity IS 0xff) {
-                        for (i=0; i < Width; i++) {
-                           if (sp[sA] IS 0xff) ((ULONG *)dp)[0] = ((ULONG *)sp)[0];
-                           else if (sp[sA]) {
-                              UBYTE alpha = sp[sA];
-                              dp[dR] = dp[dR] + (((sp[sR] - dp[dR]) * alpha)>>8);
-                              dp[dG] = dp[dG] + (((sp[sG] - dp[dG]) * alpha)>>8);
-                              dp[dB] = dp[dB] + (((sp[sB] - dp[dB]) * alpha)>>8);
-                              dp[dA] = dp[dA] + ((sp[sA] * (0xff-dp[dA]))>>8);
-                           }
-
-                           sp += 4;
-                           dp += 4;
-                        }
-                     }
-                     else {
-                        for (i=0; i < Width; i++) {
-                           if (sp[sA]) {
-                              UBYTE alpha = (sp[sA] * Bitmap->Opacity)>>8;
-                              dp[dR] = dp[dR] + (((sp[sR] - dp[dR]) * alpha)>>8);
-                              dp[dG] = dp[dG] + (((sp[sG] - dp[dG]) * alpha)>>8);
-                              dp[dB] = dp[dB] + (((sp[sB] - dp[dB]) * alpha)>>8);
-                              dp[dA] = dp[dA] + ((sp[sA] * (0xff-dp[dA]))>>8);
-                           }
-
-                           sp += 4;
-                           dp += 4;
-                        }
-                     }
-                     sdata += Bitmap->LineWidth;
-                     ddata += dest->LineWidth;
-                     Height--;
-                  }
+               for (LONG y=0; y < Height; y++) {
+                  blend(sdata, ddata, Width, params);
+                  sdata += Bitmap->LineWidth;
+                  ddata += dest->LineWidth;
                }
             }
             else if (dest->BytesPerPixel IS 2) {
-               UWORD *ddata;
-               ULONG *sdata = (ULONG *)(Bitmap->Data + (Y * Bitmap->LineWidth) + (X<<2));
-               ddata = (UWORD *)(dest->Data + (DestY * dest->LineWidth) + (DestX<<1));
-               while (Height > 0) {
-                  for (i=0; i < Width; i++) {
-                     colour = sdata[i];
-                     alpha = ((UBYTE)(colour >> Bitmap->prvColourFormat.AlphaPos));
-                     alpha = (glAlphaLookup + (alpha<<8))[Bitmap->Opacity]<<8; // Multiply the source pixel by overall translucency level
-
-                     if (alpha >= BLEND_MAX_THRESHOLD<<8) {
-                        ddata[i] = PackPixel(dest, (UBYTE)(colour >> Bitmap->prvColourFormat.RedPos),
-                                                   (UBYTE)(colour >> Bitmap->prvColourFormat.GreenPos),
-                                                   (UBYTE)(colour >> Bitmap->prvColourFormat.BluePos));
-                     }
-                     else if (alpha >= BLEND_MIN_THRESHOLD<<8) {
-                        red   = colour >> Bitmap->prvColourFormat.RedPos;
-                        green = colour >> Bitmap->prvColourFormat.GreenPos;
-                        blue  = colour >> Bitmap->prvColourFormat.BluePos;
-                        srctable  = glAlphaLookup + (alpha);
-                        desttable = dest_lookup - (alpha);
-                        ddata[i] = PackPixel(dest, (UBYTE)(srctable[red]   + desttable[UnpackRed(dest, ddata[i])]),
-                                                   (UBYTE)(srctable[green] + desttable[UnpackGreen(dest, ddata[i])]),
-                                                   (UBYTE)(srctable[blue]  + desttable[UnpackBlue(dest, ddata[i])]));
-                     }
-                  }
-                  sdata = (ULONG *)(((UBYTE *)sdata) + Bitmap->LineWidth);
-                  ddata = (UWORD *)(((UBYTE *)ddata) + dest->LineWidth);
-                  Height--;
+               const UBYTE *sdata = Bitmap->Data + (Y * Bitmap->LineWidth) + (X<<2);
+               UBYTE *ddata = dest->Data + (DestY * dest->LineWidth) + (DestX<<1);
+               for (LONG y=0; y < Height; y++) {
+                  glBlitKernels[glBlitISA].Blend16(sdata, ddata, Width, params);
+                  sdata += Bitmap->LineWidth;
+                  ddata += dest->LineWidth;
+               }
+            }
+            else if ((dest->BytesPerPixel IS 3) and (is_mem_bitmap(dest))) {
+               const UBYTE *sdata = Bitmap->Data + (Y * Bitmap->LineWidth) + (X<<2);
+               UBYTE *ddata = dest->Data + (DestY * dest->LineWidth) + (DestX * 3);
+               for (LONG y=0; y < Height; y++) {
+                  glBlitKernels[glBlitISA].Blend24(sdata, ddata, Width, params);
+                  sdata += Bitmap->LineWidth;
+                  ddata += dest->LineWidth;
                }
             }
             else {
@@ -3291,14 +3247,27 @@ static ERROR gfxCopyArea(objBitmap *Bitmap, objBitmap *dest, LONG Flags, LONG X,
                        ((Bitmap->BitsPerPixel <= 8) and (dest->BitsPerPixel > 8)))) {
                      if (Bitmap->Flags & BMF_TRANSPARENT);
                      else {
-                        dither(Bitmap, dest, NULL, Width, Height, X, Y, DestX, DestY);
+                        dither(Bitmap, dest, NULL, Width, Height, X, Y, DestX, DestY, Flags);
                         dithered = TRUE;
                      }
                   }
                }
 
                if (dithered IS FALSE) {
-                  if ((Bitmap IS dest) and (DestY >= Y) and (DestY < Y+Height)) {
+                  if ((Bitmap->BytesPerPixel IS 4) and ((dest->BytesPerPixel IS 2) or (dest->BytesPerPixel IS 3)) and
+                      (is_mem_bitmap(Bitmap)) and (is_mem_bitmap(dest))) {
+                     // Conversion of 32-bit memory bitmaps to 16 and 24 bit
+                     const blit_params params = { *Bitmap->ColourFormat, *dest->ColourFormat, 255, false };
+                     const BLIT_ROW convert = (dest->BytesPerPixel IS 2) ? glBlitKernels[glBlitISA].Copy16 : glBlitKernels[glBlitISA].Copy24;
+                     const UBYTE *sdata = Bitmap->Data + (Y * Bitmap->LineWidth) + (X<<2);
+                     UBYTE *ddata = dest->Data + (DestY * dest->LineWidth) + (DestX * dest->BytesPerPixel);
+                     for (LONG y=0; y < Height; y++) {
+                        convert(sdata, ddata, Width, params);
+                        sdata += Bitmap->LineWidth;
+                        ddata += dest->LineWidth;
+                     }
+                  }
+                  else if ((Bitmap IS dest) and (DestY >= Y) and (DestY < Y+Height)) {
                      while (Height > 0) {
                         Y += Height - 1;
                         DestY  += Height - 1;
@@ -3347,6 +3316,9 @@ available options.
 
 <types lookup="CSTF"/>
 
+The CUBIC, LANCZOS and AREA filters are separable and give the best quality, particularly for large reductions such as
+thumbnails.  Alpha channels are respected by premultiplying the source, and large images are processed in parallel.
+
 Special operations like transparency and alpha blending are not currently supported by this routine.
 
 -INPUT-
@@ -3398,6 +3370,19 @@ static ERROR gfxCopyStretch(objBitmap *Bitmap, objBitmap *Dest, LONG Flags, LONG
    if ((Bitmap->Clip.Right <= X) or (Bitmap->Clip.Top >= Y+Height) or
        (Bitmap->Clip.Bottom <= Y) or (Bitmap->Clip.Left >= X+Width)) return ERR_Okay;
 
+   if (Flags & (CSTF_CUBIC|CSTF_LANCZOS|CSTF_AREA)) { // Separable filters, refer to lib_resample.cpp
+      log.traceBranch("#%d (%dx%d,%dx%d) TO #%d (%dx%d)", Bitmap->Head.UniqueID,  X, Y, Width, Height, Dest->Head.UniqueID, DestWidth, DestHeight);
+
+      if (!LockSurface(Bitmap, SURFACE_READ)) {
+         if (!LockSurface(Dest, SURFACE_WRITE)) {
+            resample_stretch(Bitmap, Dest, Flags, X, Y, Width, Height, DestX, DestY, DestWidth, DestHeight);
+            UnlockSurface(Dest);
+         }
+         UnlockSurface(Bitmap);
+      }
+      return ERR_Okay;
+   }
+
    // Figure out a good resampling routine if none is specified.  At a minimum, bresenham is fast and better than nearest-neighbour.
 
    if (!(Flags & (CSTF_BILINEAR|CSTF_BRESENHAM|CSTF_NEIGHBOUR))) {
@@ -4310,22 +4295,8 @@ int Fill:    Set to TRUE to fill the ellipse.
 
 *****************************************************************************/
 
-#define DRAWPIXEL(bmp,x,y,col) \
-   if ((x >= clipleft) and (y >= cliptop) and (x < clipright) and (y < clipbottom)) { \
-      if (bmp->Opacity < 255) { \
-         bmp->ReadUCRPixel(bmp, x, y, &rgb); \
-         bmp->DrawUCPixel(bmp, x, y, PackPixel(bmp, srctable[red] + desttable[rgb.Red], srctable[green] + desttable[rgb.Green], srctable[blue]  + desttable[rgb.Blue])); \
-      } \
-      else bmp->DrawUCPixel(bmp,x,y,col); \
-   }
-
 static void gfxDrawEllipse(objBitmap *Bitmap, LONG X, LONG Y, LONG Width, LONG Height, ULONG Colour, LONG Fill)
 {
-   UBYTE *srctable, *desttable;
-   RGB8 rgb;
-   LONG rx, ry, cx, cy, clipleft, clipright, cliptop, clipbottom;
-   UBYTE red, green, blue;
-
    if (!Bitmap) return;
 
    if ((Width < 1) or (Height < 1)) return;
@@ -4333,114 +4304,33 @@ static void gfxDrawEllipse(objBitmap *Bitmap, LONG X, LONG Y, LONG Width, LONG H
    if ((Bitmap->Clip.Right <= X) or (Bitmap->Clip.Top >= Y+Height) or
        (Bitmap->Clip.Bottom <= Y) or (Bitmap->Clip.Left >= X+Width)) return;
 
-   if (!LockSurface(Bitmap, SURFACE_WRITE)) {
-
-      rx = Width>>1;
-      ry = Height>>1;
-      cx = X + rx;
-      cy = Y + ry;
+   if (!LockSurface(Bitmap, (Bitmap->Opacity < 255) ? SURFACE_READWRITE : SURFACE_WRITE)) {
+      LONG rx = Width>>1;
+      LONG ry = Height>>1;
+      const LONG cx = X + rx + Bitmap->XOffset;
+      const LONG cy = Y + ry + Bitmap->YOffset;
 
       if (rx < 1) rx = 1;
       if (ry < 1) ry = 1;
 
-      if (!Fill) {
-         LONG t1 = rx * rx, t2 = t1<<1, t3 = t2<<1;
-         LONG t4 = ry * ry, t5 = t4<<1, t6 = t5<<1;
-         LONG t7 = rx * t5, t8 = t7<<1, t9 = 0;
-         LONG d1 = t2 - t7 + (t4>>1);
-         LONG d2 = (t1>>1) - t8 + t5;
-         WORD x = rx, y = 0;
-
-         clipleft   = Bitmap->Clip.Left  + Bitmap->XOffset;
-         clipright  = Bitmap->Clip.Right + Bitmap->XOffset;
-         cliptop    = Bitmap->Clip.Top + Bitmap->YOffset;
-         clipbottom = Bitmap->Clip.Bottom + Bitmap->YOffset;
-
-         cx += Bitmap->XOffset;
-         cy += Bitmap->YOffset;
-
-         red   = UnpackRed(Bitmap, Colour);
-         green = UnpackGreen(Bitmap, Colour);
-         blue  = UnpackBlue(Bitmap, Colour);
-
-         srctable  = glAlphaLookup + ((Bitmap->Opacity)<<8);
-         desttable = glAlphaLookup + ((255 - Bitmap->Opacity)<<8);
-
-         while (d2 < 0) {
-            DRAWPIXEL(Bitmap, cx + x, cy + y, Colour);
-            DRAWPIXEL(Bitmap, cx + x, cy - y, Colour);
-            DRAWPIXEL(Bitmap, cx - x, cy + y, Colour);
-            DRAWPIXEL(Bitmap, cx - x, cy - y, Colour);
-            y++;
-            t9 += t3;
-            if (d1 < 0) {
-               d1 += t9 + t2;
-               d2 += t9;
-            }
-            else {
-               x--;
-               t8 -= t6;
-               d1 += t9 + t2 - t8;
-               d2 += t9 + t5 - t8;
-            }
-         }
+      ClipRectangle clip;
+      clip.Left   = Bitmap->Clip.Left + Bitmap->XOffset;
+      clip.Right  = Bitmap->Clip.Right + Bitmap->XOffset;
+      clip.Top    = Bitmap->Clip.Top + Bitmap->YOffset;
+      clip.Bottom = Bitmap->Clip.Bottom + Bitmap->YOffset;
 
-         do {
-            DRAWPIXEL(Bitmap, cx + x, cy + y, Colour);
-            DRAWPIXEL(Bitmap, cx + x, cy - y, Colour);
-            DRAWPIXEL(Bitmap, cx - x, cy + y, Colour);
-            DRAWPIXEL(Bitmap, cx - x, cy - y, Colour);
-            x--;
-            t8 -= t6;
-            if (d2 < 0) {
-               y++;
-               t9 += t3;
-               d2 += t9 + t5 - t8;
-            }
-            else d2 += t5 - t8;
-         } while (x>=0);
+      span_colour span;
+      init_span_colour(span, Bitmap, Colour, Bitmap->Opacity);
+
+      if ((Fill) and (!span.Direct)) { // Rows are passed to DrawRectangle() so that video bitmaps are accelerated
+         ellipse_spans(rx, ry, true, [&](LONG SX, LONG SY, LONG SWidth) {
+            gfxDrawRectangle(Bitmap, cx + SX - Bitmap->XOffset, cy + SY - Bitmap->YOffset, SWidth, 1, Colour, BAF_FILL);
+         });
       }
       else {
-         LONG t1 = rx*rx, t2 = t1<<1, t3 = t2<<1;
-         LONG t4 = ry*ry, t5 = t4<<1, t6 = t5<<1;
-         LONG t7 = rx*t5, t8 = t7<<1, t9 = 0;
-         LONG d1 = t2 - t7 + (t4>>1);
-         LONG d2 = (t1>>1) - t8 + t5;
-         WORD x = rx, y = 0;
-
-         while (d2 < 0) {
-            gfxDrawRectangle(Bitmap, cx,   cy+y, x+1, 1, Colour, BAF_FILL);
-            gfxDrawRectangle(Bitmap, cx-x, cy+y, x+1, 1, Colour, BAF_FILL);
-            gfxDrawRectangle(Bitmap, cx,   cy-y, x+1, 1, Colour, BAF_FILL);
-            gfxDrawRectangle(Bitmap, cx-x, cy-y, x+1, 1, Colour, BAF_FILL);
-            y++;
-            t9 += t3;
-            if (d1 < 0) {
-               d1 += t9 + t2;
-               d2 += t9;
-            }
-            else {
-               x--;
-               t8 -= t6;
-               d1 += t9 + t2 - t8;
-               d2 += t9 + t5 - t8;
-            }
-         }
-
-         do {
-            gfxDrawRectangle(Bitmap, cx+x, cy,   1, y+1, Colour, BAF_FILL);
-            gfxDrawRectangle(Bitmap, cx+x, cy-y, 1, y+1, Colour, BAF_FILL);
-            gfxDrawRectangle(Bitmap, cx-x, cy,   1, y+1, Colour, BAF_FILL);
-            gfxDrawRectangle(Bitmap, cx-x, cy-y, 1, y+1, Colour, BAF_FILL);
-            x--;
-            t8 -= t6;
-            if (d2 < 0) {
-               y++;
-               t9 += t3;
-               d2 += t9 + t5 - t8;
-            }
-            else d2 += t5 - t8;
-         } while (x>=0);
+         ellipse_spans(rx, ry, Fill, [&](LONG SX, LONG SY, LONG SWidth) {
+            fill_clipped_span(Bitmap, span, clip, cx + SX, cy + SY, SWidth);
+         });
       }
 
       UnlockSurface(Bitmap);
@@ -4578,12 +4468,6 @@ uint Colour: The pixel colour for drawing the line.
 
 static void gfxDrawLine(objBitmap *Bitmap, LONG X, LONG Y, LONG EndX, LONG EndY, ULONG Colour)
 {
-   RGB8 pixel, rgb;
-   LONG i, dx, dy, l, m, x_inc, y_inc;
-   LONG err_1, dx2, dy2;
-   LONG drawx, drawy, clipleft, clipright, clipbottom, cliptop;
-   ULONG colour;
-
    if (Bitmap->Opacity < 1) return;
 
    #ifdef __xwindows__
@@ -4595,19 +4479,20 @@ static void gfxDrawLine(objBitmap *Bitmap, LONG X, LONG Y, LONG EndX, LONG EndY,
          rectangles.height = Bitmap->Clip.Bottom + Bitmap->YOffset - rectangles.y;
          XSetClipRectangles(XDisplay, glClipXGC, 0, 0, &rectangles, 1, YXSorted);
 
+         flush_damage();
          XSetForeground(XDisplay, glClipXGC, Colour);
          XDrawLine(XDisplay, Bitmap->x11.drawable, glClipXGC, X + Bitmap->XOffset, Y + Bitmap->YOffset, EndX + Bitmap->XOffset, EndY + Bitmap->YOffset);
          return;
       }
    #endif
 
-   rgb.Red   = UnpackRed(Bitmap, Colour);
-   rgb.Green = UnpackGreen(Bitmap, Colour);
-   rgb.Blue  = UnpackBlue(Bitmap, Colour);
-
    #ifdef _WIN32
 
       if ((Bitmap->prvAFlags & BF_WINVIDEO) and (Bitmap->Opacity >= 255)) {
+         RGB8 rgb;
+         rgb.Red   = UnpackRed(Bitmap, Colour);
+         rgb.Green = UnpackGreen(Bitmap, Colour);
+         rgb.Blue  = UnpackBlue(Bitmap, Colour);
          winSetClipping(Bitmap->win.Drawable, Bitmap->Clip.Left + Bitmap->XOffset, Bitmap->Clip.Top + Bitmap->YOffset,
             Bitmap->Clip.Right + Bitmap->XOffset, Bitmap->Clip.Bottom + Bitmap->YOffset);
          winDrawLine(Bitmap->win.Drawable, X + Bitmap->XOffset, Y + Bitmap->YOffset,
@@ -4621,99 +4506,19 @@ static void gfxDrawLine(objBitmap *Bitmap, LONG X, LONG Y, LONG EndX, LONG EndY,
 
    if (LockSurface(Bitmap, SURFACE_READWRITE) != ERR_Okay) return;
 
-   drawx = X + Bitmap->XOffset;
-   drawy = Y + Bitmap->YOffset;
-   dx    = ((EndX + Bitmap->XOffset) - (X + Bitmap->XOffset));
-   dy    = ((EndY + Bitmap->YOffset) - (Y + Bitmap->YOffset));
-   x_inc = (dx < 0) ? -1 : 1;
-   if (dx < 0) l = -dx;
-   else l = dx;
-   y_inc = (dy < 0) ? -1 : 1;
-   if (dy < 0) m = -dy;
-   else m = dy;
-   dx2   = l << 1;
-   dy2   = m << 1;
-
-   cliptop    = Bitmap->Clip.Top    + Bitmap->YOffset;
-   clipbottom = Bitmap->Clip.Bottom + Bitmap->YOffset;
-   clipleft   = Bitmap->Clip.Left   + Bitmap->XOffset;
-   clipright  = Bitmap->Clip.Right  + Bitmap->XOffset;
-
-   if (Bitmap->Opacity < 255) {
-      // Translucent routine
-
-      if ((l >= m)) {
-         err_1 = dy2 - l;
-         for (i = 0; i < l; i++) {
-            if ((drawx >= clipleft) and (drawx < clipright) and (drawy >= cliptop) and (drawy < clipbottom))  {
-               Bitmap->ReadUCRPixel(Bitmap, drawx, drawy, &pixel);
-               pixel.Red   = rgb.Red   + (((pixel.Red   - rgb.Red)   * (255 - Bitmap->Opacity))>>8);
-               pixel.Green = rgb.Green + (((pixel.Green - rgb.Green) * (255 - Bitmap->Opacity))>>8);
-               pixel.Blue  = rgb.Blue  + (((pixel.Blue  - rgb.Blue)  * (255 - Bitmap->Opacity))>>8);
-               pixel.Alpha = 255;
-               Bitmap->DrawUCRPixel(Bitmap, drawx, drawy, &pixel);
-            }
-            if (err_1 > 0) { drawy += y_inc; err_1 -= dx2; }
-            err_1 += dy2;
-            drawx += x_inc;
-         }
-      }
-      else {
-         err_1 = dx2 - m;
-         for (i = 0; i < m; i++) {
-            if ((drawx >= clipleft) and (drawx < clipright) and (drawy >= cliptop) and (drawy < clipbottom))  {
-               Bitmap->ReadUCRPixel(Bitmap, drawx, drawy, &pixel);
-               pixel.Red   = rgb.Red   + (((pixel.Red   - rgb.Red)   * (255 - Bitmap->Opacity))>>8);
-               pixel.Green = rgb.Green + (((pixel.Green - rgb.Green) * (255 - Bitmap->Opacity))>>8);
-               pixel.Blue  = rgb.Blue  + (((pixel.Blue  - rgb.Blue)  * (255 - Bitmap->Opacity))>>8);
-               pixel.Alpha = 255;
-               Bitmap->DrawUCRPixel(Bitmap, drawx, drawy, &pixel);
-            }
-            if (err_1 > 0) { drawx += x_inc; err_1 -= dy2; }
-            err_1 += dx2;
-            drawy += y_inc;
-         }
-      }
-
-      if ((drawx >= clipleft) and (drawx < clipright) and (drawy >= cliptop) and (drawy < clipbottom))  {
-         Bitmap->ReadUCRPixel(Bitmap, drawx, drawy, &pixel);
-         pixel.Red   = rgb.Red   + (((pixel.Red   - rgb.Red) * (255 - Bitmap->Opacity))>>8);
-         pixel.Green = rgb.Green + (((pixel.Green - rgb.Green) * (255 - Bitmap->Opacity))>>8);
-         pixel.Blue  = rgb.Blue  + (((pixel.Blue  - rgb.Blue) * (255 - Bitmap->Opacity))>>8);
-         pixel.Alpha = 255;
-         Bitmap->DrawUCRPixel(Bitmap, drawx, drawy, &pixel);
-      }
-   }
-   else {
-      colour = Colour;
+   ClipRectangle clip;
+   clip.Left   = Bitmap->Clip.Left   + Bitmap->XOffset;
+   clip.Right  = Bitmap->Clip.Right  + Bitmap->XOffset;
+   clip.Top    = Bitmap->Clip.Top    + Bitmap->YOffset;
+   clip.Bottom = Bitmap->Clip.Bottom + Bitmap->YOffset;
 
-      if (l >= m) {
-         err_1 = dy2 - l;
-         for (i = 0; i < l; i++) {
-            if ((drawx >= clipleft) and (drawx < clipright) and (drawy >= cliptop) and (drawy < clipbottom))  {
-               Bitmap->DrawUCPixel(Bitmap, drawx, drawy, colour);
-            }
-            if (err_1 > 0) { drawy += y_inc; err_1 -= dx2; }
-            err_1 += dy2;
-            drawx += x_inc;
-         }
-      }
-      else {
-         err_1 = dx2 - m;
-         for (i = 0; i < m; i++) {
-            if ((drawx >= clipleft) and (drawx < clipright) and (drawy >= cliptop) and (drawy < clipbottom))  {
-               Bitmap->DrawUCPixel(Bitmap, drawx, drawy, colour);
-            }
-            if (err_1 > 0) { drawx += x_inc; err_1 -= dy2; }
-            err_1 += dx2;
-            drawy += y_inc;
-         }
-      }
+   span_colour span;
+   init_span_colour(span, Bitmap, Colour, Bitmap->Opacity);
 
-      if ((drawx >= clipleft) and (drawx < clipright) and (drawy >= cliptop) and (drawy < clipbottom))  {
-         Bitmap->DrawUCPixel(Bitmap, drawx, drawy, colour);
-      }
-   }
+   line_spans(X + Bitmap->XOffset, Y + Bitmap->YOffset, EndX + Bitmap->XOffset, EndY + Bitmap->YOffset,
+      [&](LONG SX, LONG SY, LONG SWidth) {
+         fill_clipped_span(Bitmap, span, clip, SX, SY, SWidth);
+      });
 
    UnlockSurface(Bitmap);
 }
@@ -4738,6 +4543,9 @@ void gfxDrawRGBPixel(objBitmap *Bitmap, LONG X, LONG Y, RGB8 *Pixel)
 {
    if ((X >= Bitmap->Clip.Right) or (X < Bitmap->Clip.Left)) return;
    if ((Y >= Bitmap->Clip.Bottom) or (Y < Bitmap->Clip.Top)) return;
+#ifdef __xwindows__
+   if ((Bitmap->x11.drawable) and (glDamage.Total)) flush_damage();
+#endif
    Bitmap->DrawUCRPixel(Bitmap, X + Bitmap->XOffset, Y + Bitmap->YOffset, Pixel);
 }
 
@@ -4761,6 +4569,9 @@ static void gfxDrawPixel(objBitmap *Bitmap, LONG X, LONG Y, ULONG Colour)
 {
    if ((X >= Bitmap->Clip.Right) or (X < Bitmap->Clip.Left)) return;
    if ((Y >= Bitmap->Clip.Bottom) or (Y < Bitmap->Clip.Top)) return;
+#ifdef __xwindows__
+   if ((Bitmap->x11.drawable) and (glDamage.Total)) flush_damage();
+#endif
    Bitmap->DrawUCPixel(Bitmap, X + Bitmap->XOffset, Y + Bitmap->YOffset, Colour);
 }
 
@@ -4789,11 +4600,7 @@ int(BAF) Flags: Use BAF_FILL to fill the rectangle.  Use of BAF_BLEND will enabl
 static void gfxDrawRectangle(objBitmap *Bitmap, LONG X, LONG Y, LONG Width, LONG Height, ULONG Colour, LONG Flags)
 {
    parasol::Log log(__FUNCTION__);
-   RGB8 pixel;
-   UBYTE *data;
-   UWORD *word;
-   ULONG *longdata;
-   LONG xend, x, EX, EY, i;
+   LONG EX, EY;
 
    if (!Bitmap) return;
 
@@ -4832,10 +4639,6 @@ static void gfxDrawRectangle(objBitmap *Bitmap, LONG X, LONG Y, LONG Width, LONG
    if ((X + Width) >= Bitmap->Clip.Right + Bitmap->XOffset)   Width = Bitmap->Clip.Right + Bitmap->XOffset - X;
    if ((Y + Height) >= Bitmap->Clip.Bottom + Bitmap->YOffset) Height = Bitmap->Clip.Bottom + Bitmap->YOffset - Y;
 
-   UWORD red   = UnpackRed(Bitmap, Colour);
-   UWORD green = UnpackGreen(Bitmap, Colour);
-   UWORD blue  = UnpackBlue(Bitmap, Colour);
-
    // Translucent rectangle support
 
    UBYTE opacity = 255;
@@ -4846,104 +4649,9 @@ static void gfxDrawRectangle(objBitmap *Bitmap, LONG X, LONG Y, LONG Width, LONG
 
    if (opacity < 255) {
       if (!LockSurface(Bitmap, SURFACE_READWRITE)) {
-         UWORD wordpixel;
-
-         if (Bitmap->BitsPerPixel IS 32) {
-            ULONG cmb_alpha;
-            longdata = (ULONG *)(Bitmap->Data + (Bitmap->LineWidth * Y));
-            xend = X + Width;
-            cmb_alpha = 255 << Bitmap->prvColourFormat.AlphaPos;
-            while (Height > 0) {
-               i = X;
-               while (i < xend) {
-                  UBYTE sr = longdata[i]>>Bitmap->prvColourFormat.RedPos;
-                  UBYTE sg = longdata[i]>>Bitmap->prvColourFormat.GreenPos;
-                  UBYTE sb = longdata[i]>>Bitmap->prvColourFormat.BluePos;
-
-                  longdata[i] = (((((red   - sr)*opacity)>>8)+sr) << Bitmap->prvColourFormat.RedPos) |
-                                (((((green - sg)*opacity)>>8)+sg) << Bitmap->prvColourFormat.GreenPos) |
-                                (((((blue  - sb)*opacity)>>8)+sb) << Bitmap->prvColourFormat.BluePos) |
-                                cmb_alpha;
-                  i++;
-               }
-               longdata = (ULONG *)(((BYTE *)longdata) + Bitmap->LineWidth);
-               Height--;
-            }
-         }
-         else if (Bitmap->BitsPerPixel IS 24) {
-            data = Bitmap->Data + (Bitmap->LineWidth * Y);
-            X    = X * Bitmap->BytesPerPixel;
-            xend = X + (Width * Bitmap->BytesPerPixel);
-            while (Height > 0) {
-               i = X;
-               while (i < xend) {
-                  data[i] = (((blue - data[i])*opacity)>>8)+data[i]; i++;
-                  data[i] = (((green - data[i])*opacity)>>8)+data[i]; i++;
-                  data[i] = (((red - data[i])*opacity)>>8)+data[i]; i++;
-               }
-               data += Bitmap->LineWidth;
-               Height--;
-            }
-         }
-         else if (Bitmap->BitsPerPixel IS 16) {
-            word = (UWORD *)(Bitmap->Data + (Bitmap->LineWidth * Y));
-            xend = X + Width;
-            while (Height > 0) {
-               i = X;
-               while (i < xend) {
-                  UBYTE sr = (word[i] & 0x001f)<<3;
-                  UBYTE sg = (word[i] & 0x07e0)>>3;
-                  UBYTE sb = (word[i] & 0xf800)>>8;
-                  sr = (((red   - sr)*opacity)>>8) + sr;
-                  sg = (((green - sg)*opacity)>>8) + sg;
-                  sb = (((blue  - sb)*opacity)>>8) + sb;
-                  wordpixel =  (sb>>3) & 0x001f;
-                  wordpixel |= (sg<<3) & 0x07e0;
-                  wordpixel |= (sr<<8) & 0xf800;
-                  word[i] = wordpixel;
-                  i++;
-               }
-               word = (UWORD *)(((UBYTE *)word) + Bitmap->LineWidth);
-               Height--;
-            }
-         }
-         else if (Bitmap->BitsPerPixel IS 15) {
-            word = (UWORD *)(Bitmap->Data + (Bitmap->LineWidth * Y));
-            xend = X + Width;
-            while (Height > 0) {
-               i = X;
-               while (i < xend) {
-                  UBYTE sr = (word[i] & 0x001f)<<3;
-                  UBYTE sg = (word[i] & 0x03e0)>>2;
-                  UBYTE sb = (word[i] & 0x7c00)>>7;
-                  sr = (((red   - sr)*opacity)>>8) + sr;
-                  sg = (((green - sg)*opacity)>>8) + sg;
-                  sb = (((blue  - sb)*opacity)>>8) + sb;
-                  wordpixel =  (sb>>3) & 0x001f;
-                  wordpixel |= (sg<<2) & 0x03e0;
-                  wordpixel |= (sr<<7) & 0x7c00;
-                  word[i] = wordpixel;
-                  i++;
-               }
-               word = (UWORD *)(((UBYTE *)word) + Bitmap->LineWidth);
-               Height--;
-            }
-         }
-         else {
-            while (Height > 0) {
-               for (i=X; i < X + Width; i++) {
-                  Bitmap->ReadUCRPixel(Bitmap, i, Y, &pixel);
-                  pixel.Red   = (((red - pixel.Red)*opacity)>>8) + pixel.Red;
-                  pixel.Green = (((green - pixel.Green)*opacity)>>8) + pixel.Green;
-                  pixel.Blue  = (((blue - pixel.Blue)*opacity)>>8) + pixel.Blue;
-                  pixel.Alpha = 255;
-                  Bitmap->DrawUCRPixel(Bitmap, i, Y, &pixel);
-               }
-               Y++;
-               Height--;
-            }
-         }
-
+         span_colour span;
+         init_span_colour(span, Bitmap, Colour, opacity);
+         for (; Height > 0; Height--, Y++) fill_span(Bitmap, span, X, Y, Width);
          UnlockSurface(Bitmap);
       }
 
@@ -4963,13 +4671,15 @@ static void gfxDrawRectangle(objBitmap *Bitmap, LONG X, LONG Y, LONG Width, LONG
 
    #ifdef _WIN32
       if (Bitmap->win.Drawable) {
-         winDrawRectangle(Bitmap->win.Drawable, X, Y, Width, Height, red, green, blue);
+         winDrawRectangle(Bitmap->win.Drawable, X, Y, Width, Height, UnpackRed(Bitmap, Colour),
+            UnpackGreen(Bitmap, Colour), UnpackBlue(Bitmap, Colour));
          return;
       }
    #endif
 
    #ifdef __xwindows__
       if (Bitmap->DataFlags & (MEM_VIDEO|MEM_TEXTURE)) {
+         flush_damage();
          XSetForeground(XDisplay, glXGC, Colour);
          XFillRectangle(XDisplay, Bitmap->x11.drawable, glXGC, X, Y, Width, Height);
          return;
@@ -4984,56 +4694,9 @@ static void gfxDrawRectangle(objBitmap *Bitmap, LONG X, LONG Y, LONG Width, LONG
          return;
       }
 
-      if (Bitmap->Type IS BMP_CHUNKY) {
-         if (Bitmap->BitsPerPixel IS 32) {
-            longdata = (ULONG *)(Bitmap->Data + (Bitmap->LineWidth * Y));
-            while (Height > 0) {
-               for (x=X; x < (X+Width); x++) longdata[x] = Colour;
-               longdata = (ULONG *)(((UBYTE *)longdata) + Bitmap->LineWidth);
-               Height--;
-            }
-         }
-         else if (Bitmap->BitsPerPixel IS 24) {
-            data = Bitmap->Data + (Bitmap->LineWidth * Y);
-            X = X + X + X;
-            xend = X + Width + Width + Width;
-            while (Height > 0) {
-               for (x=X; x < xend;) {
-                  data[x++] = blue; data[x++] = green; data[x++] = red;
-               }
-               data += Bitmap->LineWidth;
-               Height--;
-            }
-         }
-         else if ((Bitmap->BitsPerPixel IS 16) or (Bitmap->BitsPerPixel IS 15)) {
-            word = (UWORD *)(Bitmap->Data + (Bitmap->LineWidth * Y));
-            xend = X + Width;
-            while (Height > 0) {
-               for (x=X; x < xend; x++) word[x] = (UWORD)Colour;
-               word = (UWORD *)(((BYTE *)word) + Bitmap->LineWidth);
-               Height--;
-            }
-         }
-         else if (Bitmap->BitsPerPixel IS 8) {
-            data = Bitmap->Data + (Bitmap->LineWidth * Y);
-            xend = X + Width;
-            while (Height > 0) {
-               for (x=X; x < xend;) data[x++] = Colour;
-               data += Bitmap->LineWidth;
-               Height--;
-            }
-         }
-         else while (Height > 0) {
-            for (i=X; i < X + Width; i++) Bitmap->DrawUCPixel(Bitmap, i, Y, Colour);
-            Y++;
-            Height--;
-         }
-      }
-      else while (Height > 0) {
-         for (i=X; i < X + Width; i++) Bitmap->DrawUCPixel(Bitmap, i, Y, Colour);
-         Y++;
-         Height--;
-      }
+      span_colour span;
+      init_span_colour(span, Bitmap, Colour, 255);
+      for (; Height > 0; Height--, Y++) fill_span(Bitmap, span, X, Y, Width);
 
       UnlockSurface(Bitmap);
    }
@@ -5175,8 +4838,9 @@ static DOUBLE gfxScaleToDPI(DOUBLE Value)
 Resample: Resamples a bitmap by dithering it to a new set of colour masks.
 
 The Resample() function provides a means for resampling a bitmap to a new colour format without changing the actual
-bit depth of the image. It uses dithering so as to retain the quality of the image when down-sampling.  This function
-is generally used to 'pre-dither' true colour bitmaps in preparation for copying to bitmaps with lower colour quality.
+bit depth of the image. It uses Floyd-Steinberg dithering so as to retain the quality of the image when down-sampling.
+This function is generally used to 'pre-dither' true colour bitmaps in preparation for copying to bitmaps with lower
+colour quality.
 
 You are required to supply a ColourFormat structure that describes the colour format that you would like to apply to
 the bitmap's image data.
@@ -5195,7 +4859,7 @@ static ERROR gfxResample(objBitmap *Bitmap, ColourFormat *Format)
 {
    if ((!Bitmap) or (!Format)) return ERR_NullArgs;
 
-   dither(Bitmap, Bitmap, Format, Bitmap->Width, Bitmap->Height, 0, 0, 0, 0);
+   dither(Bitmap, Bitmap, Format, Bitmap->Width, Bitmap->Height, 0, 0, 0, 0, 0);
    return ERR_Okay;
 }
 
@@ -5250,6 +4914,9 @@ Sync: Waits for the completion of all active bitmap operations.
 The Sync() function will wait for all current video operations to complete before it returns.  This ensures that it is
 safe to write to video memory with the CPU, preventing any possibility of clashes with the onboard graphics chip.
 
+On X11, bitmaps that are copied to a window are presented asynchronously from shared memory.  Calling Sync() on such
+a bitmap sends any areas that are queued for presentation, then waits until the X server has finished reading them.
+
 -INPUT-
 obj(Bitmap) Bitmap: Pointer to the bitmap that you want to synchronise or NULL to sleep on the graphics accelerator.
 -END-
@@ -5258,203 +4925,44 @@ obj(Bitmap) Bitmap: Pointer to the bitmap that you want to synchronise or NULL t
 
 static void gfxSync(objBitmap *Bitmap)
 {
-
+#ifdef __xwindows__
+   sync_shm_image(Bitmap);
+#endif
 }
 
-//****************************************************************************
-// NOTE: Please ensure that the Width and Height are already clipped to meet the restrictions of BOTH the source and
-// destination bitmaps.
-
-#define DITHER_ERROR(c)                  /* Dither one colour component */ \
-   dif = (buf1[x].c>>3) - (brgb.c<<3);   /* An eighth of the error */ \
-   if (dif) {                            \
-      val3 = buf2[x+1].c + (dif<<1);     /* 1/4 down & right */ \
-      dif = dif + dif + dif;             \
-      val1 = buf1[x+1].c + dif;          /* 3/8 to the right */ \
-      val2 = buf2[x].c + dif;            /* 3/8 to the next row */ \
-      if (dif > 0) {                     /* Check for overflow */ \
-         buf1[x+1].c = MIN(16383, val1); \
-         buf2[x].c   = MIN(16383, val2); \
-         buf2[x+1].c = MIN(16383, val3); \
-      }                                  \
-      else if (dif < 0) {                \
-         buf1[x+1].c = MAX(0, val1);     \
-         buf2[x].c   = MAX(0, val2);     \
-         buf2[x+1].c = MAX(0, val3);     \
-      }                                  \
-   }
-
-static ERROR dither(objBitmap *Bitmap, objBitmap *Dest, ColourFormat *Format, LONG Width, LONG Height,
-   LONG SrcX, LONG SrcY, LONG DestX, LONG DestY)
-{
-   parasol::Log log(__FUNCTION__);
-   RGB16 *buf1, *buf2, *buffer;
-   RGB8 brgb;
-   UBYTE *srcdata, *destdata, *data;
-   LONG dif, val1, val2, val3;
-   LONG x, y;
-   ULONG colour;
-   WORD index;
-   UBYTE rmask, gmask, bmask;
-
-   if ((Width < 1) or (Height < 1)) return ERR_Okay;
-
-   // Punch the developer for making stupid mistakes
-
-   if ((Dest->BitsPerPixel >= 24) and (!Format)) {
-      log.warning("Dithering attempted to a %dbpp bitmap.", Dest->BitsPerPixel);
-      return ERR_Failed;
-   }
-
-   // Do a straight copy if the bitmap is too small for dithering
-
-   if ((Height < 2) or (Width < 2)) {
-      for (y=SrcY; y < SrcY+Height; y++) {
-         for (x=SrcX; x < SrcX+Width; x++) {
-            Bitmap->ReadUCRPixel(Bitmap, x, y, &brgb);
-            Dest->DrawUCRPixel(Dest, x, y, &brgb);
-         }
-      }
-      return ERR_Okay;
-   }
-
-   // Allocate buffer for dithering
-
-   if (Width * (LONG)sizeof(RGB16) * 2 > glDitherSize) {
-      if (glDither) { FreeResource(glDither); glDither = NULL; }
-
-      if (AllocMemory(Width * sizeof(RGB16) * 2, MEM_NO_CLEAR|MEM_UNTRACKED, &glDither, NULL) != ERR_Okay) {
-         return ERR_AllocMemory;
-      }
-   }
-
-   buf1 = (RGB16 *)glDither;
-   buf2 = buf1 + Width;
-
-   // Prime buf2, which will be copied to buf1 at the start of the loop.  We work with six binary "decimal places" to reduce roundoff errors.
-
-   for (x=0,index=0; x < Width; x++,index+=Bitmap->BytesPerPixel) {
-      Bitmap->ReadUCRIndex(Bitmap, Bitmap->Data + index, &brgb);
-      buf2[x].Red   = brgb.Red<<6;
-      buf2[x].Green = brgb.Green<<6;
-      buf2[x].Blue  = brgb.Blue<<6;
-      buf2[x].Alpha = brgb.Alpha;
-   }
-
-   if (!Format) Format = &Dest->prvColourFormat;
-
-   srcdata = Bitmap->Data + ((SrcY+1) * Bitmap->LineWidth);
-   destdata = Dest->Data + (DestY * Dest->LineWidth);
-   rmask = Format->RedMask   << Format->RedShift;
-   gmask = Format->GreenMask << Format->GreenShift;
-   bmask = Format->BlueMask  << Format->BlueShift;
-
-   for (y=0; y < Height - 1; y++) {
-      // Move line 2 to line 1, line 2 then is empty for reading the next row
-
-      buffer = buf2;
-      buf2 = buf1;
-      buf1 = buffer;
-
-      // Read the next source line
-
-      if (Bitmap->BytesPerPixel IS 4) {
-         buffer = buf2;
-         data = srcdata+(SrcX<<2);
-         for (x=0; x < Width; x++, data+=4, buffer++) {
-            colour = ((ULONG *)data)[0];
-            buffer->Red   = ((UBYTE)(colour >> Bitmap->prvColourFormat.RedPos))<<6;
-            buffer->Green = ((UBYTE)(colour >> Bitmap->prvColourFormat.GreenPos))<<6;
-            buffer->Blue  = ((UBYTE)(colour >> Bitmap->prvColourFormat.BluePos))<<6;
-            buffer->Alpha = ((UBYTE)(colour >> Bitmap->prvColourFormat.AlphaPos));
-         }
-      }
-      else if (Bitmap->BytesPerPixel IS 2) {
-         buffer = buf2;
-         data = srcdata+(SrcX<<1);
-         for (x=0; x < Width; x++, data+=2, buffer++) {
-            colour = ((UWORD *)data)[0];
-            buffer->Red   = UnpackRed(Bitmap, colour)<<6;
-            buffer->Green = UnpackGreen(Bitmap, colour)<<6;
-            buffer->Blue  = UnpackBlue(Bitmap, colour)<<6;
-         }
-      }
-      else {
-         buffer = buf2;
-         data = srcdata + (SrcX * Bitmap->BytesPerPixel);
-         for (x=0; x < Width; x++, data+=Bitmap->BytesPerPixel, buffer++) {
-            Bitmap->ReadUCRIndex(Bitmap, data, &brgb);
-            buffer->Red   = brgb.Red<<6;
-            buffer->Green = brgb.Green<<6;
-            buffer->Blue  = brgb.Blue<<6;
-         }
-      }
-
-      // Dither
-
-      buffer = buf1;
-      data = destdata + (DestX * Dest->BytesPerPixel);
-      if (Dest->BytesPerPixel IS 2) {
-         for (x=0; x < Width - 1; x++,data+=2,buffer++) {
-            brgb.Red   = (buffer->Red>>6) & rmask;
-            brgb.Green = (buffer->Green>>6) & gmask;
-            brgb.Blue  = (buffer->Blue>>6) & bmask;
-            ((UWORD *)data)[0] = ((brgb.Red>>Dest->prvColourFormat.RedShift) << Dest->prvColourFormat.RedPos) |
-                                 ((brgb.Green>>Dest->prvColourFormat.GreenShift) << Dest->prvColourFormat.GreenPos) |
-                                 ((brgb.Blue>>Dest->prvColourFormat.BlueShift) << Dest->prvColourFormat.BluePos);
-            DITHER_ERROR(Red);
-            DITHER_ERROR(Green);
-            DITHER_ERROR(Blue);
-         }
-      }
-      else if (Dest->BytesPerPixel IS 4) {
-         for (x=0; x < Width-1; x++,data+=4,buffer++) {
-            brgb.Red   = (buffer->Red>>6) & rmask;
-            brgb.Green = (buffer->Green>>6) & gmask;
-            brgb.Blue  = (buffer->Blue>>6) & bmask;
-            ((ULONG *)data)[0] = PackPixelWBA(Dest, brgb.Red, brgb.Green, brgb.Blue, buffer->Alpha);
-            DITHER_ERROR(Red);
-            DITHER_ERROR(Green);
-            DITHER_ERROR(Blue);
-         }
-      }
-      else {
-         for (x=0; x < Width - 1; x++,data+=Dest->BytesPerPixel,buffer++) {
-            brgb.Red   = (buffer->Red>>6) & rmask;
-            brgb.Green = (buffer->Green>>6) & gmask;
-            brgb.Blue  = (buffer->Blue>>6) & bmask;
-            Dest->DrawUCRIndex(Dest, data, &brgb);
-            DITHER_ERROR(Red);
-            DITHER_ERROR(Green);
-            DITHER_ERROR(Blue);
-         }
-      }
+/*****************************************************************************
 
-      // Draw the last pixel in the row - no downward propagation
+-FUNCTION-
+GetPresentStats: Returns statistics for the presentation of bitmaps to the display.
 
-      brgb.Red   = buf1[Width-1].Red>>6;
-      brgb.Green = buf1[Width-1].Green>>6;
-      brgb.Blue  = buf1[Width-1].Blue>>6;
-      brgb.Alpha = buf1[Width-1].Alpha;
-      Dest->DrawUCRIndex(Dest, destdata + ((Width - 1) * Dest->BytesPerPixel), &brgb);
+On hosted displays that support it, areas that are copied to a window with ~CopyArea() are collected for each frame.
+Overlapping and neighbouring areas are merged before they are sent to the display server as a batch.  This function
+returns running totals that can be used to measure the effectiveness of the batching, for instance the average number
+of puts per frame.  A frame ends when the Flush action is called on a @Display.
 
-      srcdata += Bitmap->LineWidth;
-      destdata += Dest->LineWidth;
-   }
+All values are zero if batching is not supported by the host.
 
-   // Draw the last row of pixels - no leftward propagation
+-INPUT-
+&large Frames: The total number of frames in which at least one area was presented.
+&large Areas: The total number of areas that have been submitted for presentation.
+&large Puts: The total number of image transfers that were sent to the display server.
+&large Bytes: The total number of bytes in the transferred images.
 
-   if (Bitmap != Dest) {
-      for (x=0,index=0; x < Width; x++,index+=Dest->BytesPerPixel) {
-         brgb.Red   = buf2[x].Red>>6;
-         brgb.Green = buf2[x].Green>>6;
-         brgb.Blue  = buf2[x].Blue>>6;
-         brgb.Alpha = buf2[x].Alpha;
-         Dest->DrawUCRIndex(Dest, destdata+index, &brgb);
-      }
-   }
+*****************************************************************************/
 
-   return ERR_Okay;
+static void gfxGetPresentStats(LARGE *Frames, LARGE *Areas, LARGE *Puts, LARGE *Bytes)
+{
+#ifdef __xwindows__
+   if (Frames) *Frames = glPresentFrames;
+   if (Areas)  *Areas  = glPresentRects;
+   if (Puts)   *Puts   = glPresentPuts;
+   if (Bytes)  *Bytes  = glPresentBytes;
+#else
+   if (Frames) *Frames = 0;
+   if (Areas)  *Areas  = 0;
+   if (Puts)   *Puts   = 0;
+   if (Bytes)  *Bytes  = 0;
+#endif
 }
 
 /******************************************************************************
@@ -66,6 +66,7 @@ FDEF argsGetDisplayInfo[] = { { "Error", FD_ERROR }, { "Display", FD_OBJECTID },
 FDEF argsGetDisplayType[] = { { "Result", FD_LONG }, { 0, 0 } };
 FDEF argsGetInputEvent[] = { { "Error", FD_ERROR }, { "dcInputReady:Input", FD_PTR|FD_STRUCT }, { "Flags", FD_LONG }, { "InputEvent:Msg", FD_PTR|FD_STRUCT|FD_RESULT }, { 0, 0 } };
 FDEF argsGetInputTypeName[] = { { "Result", FD_STR }, { "Type", FD_LONG }, { 0, 0 } };
+FDEF argsGetPresentStats[] = { { "Void", FD_VOID }, { "Frames", FD_LARGE|FD_RESULT }, { "Areas", FD_LARGE|FD_RESULT }, { "Puts", FD_LARGE|FD_RESULT }, { "Bytes", FD_LARGE|FD_RESULT }, { 0, 0 } };
 FDEF argsGetRelativeCursorPos[] = { { "Error", FD_ERROR }, { "Surface", FD_OBJECTID }, { "X", FD_LONG|FD_RESULT }, { "Y", FD_LONG|FD_RESULT }, { 0, 0 } };
 FDEF argsLockCursor[] = { { "Error", FD_ERROR }, { "Surface", FD_OBJECTID }, { 0, 0 } };
 FDEF argsReadPixel[] = { { "Result", FD_LONG }, { "Bitmap", FD_OBJECTPTR }, { "X", FD_LONG }, { "Y", FD_LONG }, { 0, 0 } };
@@ -124,6 +125,7 @@ Function JumpTable[] = {
    { scrUnsupported, "GetInputEvent", argsGetInputEvent },
    { scrUnsupported, "GetInputTypeName", argsGetInputTypeName },
    { scrUnsupported, "ScaleToDPI", argsScaleToDPI },
+   { scrUnsupported, "GetPresentStats", argsGetPresentStats },
    { NULL, NULL, NULL }
 };
 
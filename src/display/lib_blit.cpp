@@ -0,0 +1,253 @@
+/*****************************************************************************
+
+Row kernels for the software blitting paths of gfxCopyArea() that take a 32-bit source.  Alpha blending is supported
+for 32, 24 and 16 bit destinations, and straight conversion for 24 and 16 bit destinations.  The scalar kernels are
+the reference implementation.  SSE2 and SSSE3 kernels produce bit-identical output and the best instruction set is
+chosen once at startup via CPUID.  It can be overridden by setting glBlitISA.
+
+The 32-bit blend is described in simd_blend.h, which is shared with the vector module.  The 24 and 16 bit blends use
+the rounded multiplications of glAlphaLookup, which are computed as ((x + 128) + ((x + 128)>>8))>>8 where x is the
+product of the value and alpha level.
+
+*****************************************************************************/
+
+enum { BLIT_SCALAR=0, BLIT_SSE2, BLIT_SSSE3, BLIT_END };
+
+static const CSTRING glBlitISANames[BLIT_END] = { "Scalar", "SSE2", "SSSE3" };
+
+struct blit_params {
+   ColourFormat Src;  // Format of the 32-bit source
+   ColourFormat Dest; // Format of the destination
+   UBYTE Opacity;     // Opacity of the source bitmap
+   bool Copy;         // BAF_COPY: Copy the source pixel if the destination pixel is empty
+};
+
+typedef void (*BLIT_ROW)(const UBYTE *Src, UBYTE *Dest, LONG Width, const blit_params &);
+
+struct blit_kernels {
+   BLIT_ROW Blend32;
+   BLIT_ROW Blend24;
+   BLIT_ROW Blend16;
+   BLIT_ROW Copy24;
+   BLIT_ROW Copy16;
+};
+
+//****************************************************************************
+// Initialises the 64K alpha blending table.  Entry (Alpha<<8) + Value is Value * Alpha / 255, rounded.
+
+static void build_alpha_lookup(UBYTE *Table)
+{
+   LONG i = 0;
+   for (WORD iAlpha=0; iAlpha < 256; iAlpha++) {
+      DOUBLE fAlpha = (DOUBLE)iAlpha * (1.0 / 255.0);
+      for (WORD iValue=0; iValue < 256; iValue++) {
+         LONG value = F2I((DOUBLE)iValue * fAlpha);
+         Table[i++] = (value < 0) ? 0 : (value > 255) ? 255 : value;
+      }
+   }
+}
+
+// Byte positions of the red and blue components of 24-bit pixels, as written by MemDrawLSBRGBPixel24() and
+// MemDrawMSBRGBPixel24().
+
+INLINE LONG red_pos24(const ColourFormat &Format) { return (Format.RedPos IS 16) ? 2 : 0; }
+INLINE LONG blue_pos24(const ColourFormat &Format) { return (Format.RedPos IS 16) ? 0 : 2; }
+
+//****************************************************************************
+// Scalar kernels.
+
+static void blend32_scalar(const UBYTE *Src, UBYTE *Dest, LONG Width, const blit_params &Params)
+{
+   const UBYTE sA = Params.Src.AlphaPos>>3;
+   const UBYTE sR = Params.Src.RedPos>>3;
+   const UBYTE sG = Params.Src.GreenPos>>3;
+   const UBYTE sB = Params.Src.BluePos>>3;
+   const UBYTE dA = Params.Dest.AlphaPos>>3;
+   const UBYTE dR = Params.Dest.RedPos>>3;
+   const UBYTE dG = Params.Dest.GreenPos>>3;
+   const UBYTE dB = Params.Dest.BluePos>>3;
+
+   const UBYTE *sp = Src;
+   UBYTE *dp = Dest;
+
+   if (Params.Copy) { // Avoids blending in cases where the destination pixel is empty.
+      for (LONG x=0; x < Width; x++) {
+         if (dp[dA]) {
+            if (sp[sA] IS 0xff) ((ULONG *)dp)[0] = ((ULONG *)sp)[0];
+            else if (sp[sA]) {
+               dp[dR] = dp[dR] + (((sp[sR] - dp[dR]) * sp[sA])>>8);
+               dp[dG] = dp[dG] + (((sp[sG] - dp[dG]) * sp[sA])>>8);
+               dp[dB] = dp[dB] + (((sp[sB] - dp[dB]) * sp[sA])>>8);
+               dp[dA] = dp[dA] + ((sp[sA] * (0xff-dp[dA]))>>8);
+            }
+         }
+         else ((ULONG *)dp)[0] = ((ULONG *)sp)[0];
+
+         sp += 4;
+         dp += 4;
+      }
+   }
+   else if (Params.Opacity IS 0xff) {
+      for (LONG x=0; x < Width; x++) {
+         if (sp[sA] IS 0xff) ((ULONG *)dp)[0] = ((ULONG *)sp)[0];
+         else if (sp[sA]) {
+            UBYTE alpha = sp[sA];
+            dp[dR] = dp[dR] + (((sp[sR] - dp[dR]) * alpha)>>8);
+            dp[dG] = dp[dG] + (((sp[sG] - dp[dG]) * alpha)>>8);
+            dp[dB] = dp[dB] + (((sp[sB] - dp[dB]) * alpha)>>8);
+            dp[dA] = dp[dA] + ((sp[sA] * (0xff-dp[dA]))>>8);
+         }
+
+         sp += 4;
+         dp += 4;
+      }
+   }
+   else {
+      for (LONG x=0; x < Width; x++) {
+         if (sp[sA]) {
+            UBYTE alpha = (sp[sA] * Params.Opacity)>>8;
+            dp[dR] = dp[dR] + (((sp[sR] - dp[dR]) * alpha)>>8);
+            dp[dG] = dp[dG] + (((sp[sG] - dp[dG]) * alpha)>>8);
+            dp[dB] = dp[dB] + (((sp[sB] - dp[dB]) * alpha)>>8);
+            dp[dA] = dp[dA] + ((sp[sA] * (0xff-dp[dA]))>>8);
+         }
+
+         sp += 4;
+         dp += 4;
+      }
+   }
+}
+
+static void blend24_scalar(const UBYTE *Src, UBYTE *Dest, LONG Width, const blit_params &Params)
+{
+   const LONG dR = red_pos24(Params.Dest), dB = blue_pos24(Params.Dest);
+   const ULONG *sdata = (const ULONG *)Src;
+
+   for (LONG i=0; i < Width; i++, Dest += 3) {
+      ULONG colour = sdata[i];
+      UWORD alpha = ((UBYTE)(colour >> Params.Src.AlphaPos));
+      alpha = (glAlphaLookup + (alpha<<8))[Params.Opacity]; // Multiply the source pixel by overall translucency level
+
+      if (alpha >= BLEND_MAX_THRESHOLD) {
+         Dest[dR] = colour >> Params.Src.RedPos;
+         Dest[1]  = colour >> Params.Src.GreenPos;
+         Dest[dB] = colour >> Params.Src.BluePos;
+      }
+      else if (alpha >= BLEND_MIN_THRESHOLD) {
+         UBYTE red   = colour >> Params.Src.RedPos;
+         UBYTE green = colour >> Params.Src.GreenPos;
+         UBYTE blue  = colour >> Params.Src.BluePos;
+
+         const UBYTE *srctable  = glAlphaLookup + (alpha<<8);
+         const UBYTE *desttable = glAlphaLookup + ((255-alpha)<<8);
+
+         Dest[dR] = srctable[red]   + desttable[Dest[dR]];
+         Dest[1]  = srctable[green] + desttable[Dest[1]];
+         Dest[dB] = srctable[blue]  + desttable[Dest[dB]];
+      }
+   }
+}
+
+static void blend16_scalar(const UBYTE *Src, UBYTE *Dest, LONG Width, const blit_params &Params)
+{
+   const ColourFormat *df = &Params.Dest;
+   const UBYTE *dest_lookup = glAlphaLookup + (255<<8);
+   const ULONG *sdata = (const ULONG *)Src;
+   UWORD *ddata = (UWORD *)Dest;
+
+   for (LONG i=0; i < Width; i++) {
+      ULONG colour = sdata[i];
+      UWORD alpha = ((UBYTE)(colour >> Params.Src.AlphaPos));
+      alpha = (glAlphaLookup + (alpha<<8))[Params.Opacity]<<8; // Multiply the source pixel by overall translucency level
+
+      if (alpha >= BLEND_MAX_THRESHOLD<<8) {
+         ddata[i] = CFPackPixel(df, (UBYTE)(colour >> Params.Src.RedPos),
+                                    (UBYTE)(colour >> Params.Src.GreenPos),
+                                    (UBYTE)(colour >> Params.Src.BluePos)) | CFPackAlpha(df, 255);
+      }
+      else if (alpha >= BLEND_MIN_THRESHOLD<<8) {
+         UBYTE red   = colour >> Params.Src.RedPos;
+         UBYTE green = colour >> Params.Src.GreenPos;
+         UBYTE blue  = colour >> Params.Src.BluePos;
+         const UBYTE *srctable  = glAlphaLookup + (alpha);
+         const UBYTE *desttable = dest_lookup - (alpha);
+         ddata[i] = CFPackPixel(df, (UBYTE)(srctable[red]   + desttable[CFUnpackRed(df, ddata[i])]),
+                                    (UBYTE)(srctable[green] + desttable[CFUnpackGreen(df, ddata[i])]),
+                                    (UBYTE)(srctable[blue]  + desttable[CFUnpackBlue(df, ddata[i])])) | CFPackAlpha(df, 255);
+      }
+   }
+}
+
+static void copy24_scalar(const UBYTE *Src, UBYTE *Dest, LONG Width, const blit_params &Params)
+{
+   const LONG dR = red_pos24(Params.Dest), dB = blue_pos24(Params.Dest);
+   const ULONG *sdata = (const ULONG *)Src;
+
+   for (LONG i=0; i < Width; i++, Dest += 3) {
+      Dest[dR] = sdata[i] >> Params.Src.RedPos;
+      Dest[1]  = sdata[i] >> Params.Src.GreenPos;
+      Dest[dB] = sdata[i] >> Params.Src.BluePos;
+   }
+}
+
+static void copy16_scalar(const UBYTE *Src, UBYTE *Dest, LONG Width, const blit_params &Params)
+{
+   const ColourFormat *df = &Params.Dest;
+   const ULONG *sdata = (const ULONG *)Src;
+   UWORD *ddata = (UWORD *)Dest;
+
+   for (LONG i=0; i < Width; i++) {
+      ddata[i] = CFPackPixel(df, (UBYTE)(sdata[i] >> Params.Src.RedPos), (UBYTE)(sdata[i] >> Params.Src.GreenPos),
+         (UBYTE)(sdata[i] >> Params.Src.BluePos)) | CFPackAlpha(df, 255);
+   }
+}
+
+//****************************************************************************
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+
+#include <immintrin.h>
+#include "simd_blend.h"
+
+#define SIMD_NS     blit_sse2
+#define SIMD_TARGET "sse2"
+#define SIMD_SSSE3  0
+#include "lib_blit_sse.cpp"
+#undef SIMD_NS
+#undef SIMD_TARGET
+#undef SIMD_SSSE3
+
+#define SIMD_NS     blit_ssse3
+#define SIMD_TARGET "ssse3"
+#define SIMD_SSSE3  1
+#include "lib_blit_sse.cpp"
+#undef SIMD_NS
+#undef SIMD_TARGET
+#undef SIMD_SSSE3
+
+static const blit_kernels glBlitKernels[BLIT_END] = {
+   { blend32_scalar, blend24_scalar, blend16_scalar, copy24_scalar, copy16_scalar },
+   { blit_sse2::blend32, blit_sse2::blend24, blit_sse2::blend16, blit_sse2::copy24, blit_sse2::copy16 },
+   { blit_ssse3::blend32, blit_ssse3::blend24, blit_ssse3::blend16, blit_ssse3::copy24, blit_ssse3::copy16 }
+};
+
+static LONG detect_blit_isa(void)
+{
+   __builtin_cpu_init();
+   if (__builtin_cpu_supports("ssse3")) return BLIT_SSSE3;
+   else if (__builtin_cpu_supports("sse2")) return BLIT_SSE2;
+   else return BLIT_SCALAR;
+}
+
+static LONG glBlitISA = detect_blit_isa();
+
+#else
+
+static const blit_kernels glBlitKernels[BLIT_END] = {
+   { blend32_scalar, blend24_scalar, blend16_scalar, copy24_scalar, copy16_scalar }
+};
+
+static LONG glBlitISA = BLIT_SCALAR;
+
+#endif
+
@@ -0,0 +1,240 @@
+// 128-bit blitting kernels that process four 32-bit source pixels per step.  The SSE2 and SSSE3 passes only differ
+// in the packing of 24-bit pixels; see simd_blend.h for how this file is included.  Row remainders are passed to the
+// scalar kernels.
+
+namespace SIMD_NS {
+
+// Computes Value / 255 with rounding for unsigned 16-bit values up to 255 * 255, matching glAlphaLookup.
+
+SSE_INLINE __m128i div255(__m128i Value)
+{
+   const __m128i t = _mm_add_epi16(Value, _mm_set1_epi16(128));
+   return _mm_srli_epi16(_mm_add_epi16(t, _mm_srli_epi16(t, 8)), 8);
+}
+
+// Extracts an 8-bit channel from four 32-bit pixels, returning one value per 32-bit lane.
+
+SSE_INLINE __m128i channel4(__m128i Pixels, LONG Pos)
+{
+   return _mm_and_si128(_mm_srl_epi32(Pixels, _mm_cvtsi32_si128(Pos)), _mm_set1_epi32(0xff));
+}
+
+// Extracts an 8-bit channel from eight 32-bit pixels, returning one value per 16-bit lane.
+
+SSE_INLINE __m128i channel8(__m128i Lo, __m128i Hi, LONG Pos)
+{
+   return _mm_packs_epi32(channel4(Lo, Pos), channel4(Hi, Pos));
+}
+
+// Rearranges the colour channels of four 32-bit pixels to the byte order of a 24-bit destination, leaving the top byte
+// of each lane empty.
+
+SSE_INLINE __m128i to_rgb24(__m128i Pixels, const blit_params &Params)
+{
+   return _mm_or_si128(_mm_or_si128(
+      _mm_sll_epi32(channel4(Pixels, Params.Src.RedPos), _mm_cvtsi32_si128(red_pos24(Params.Dest)<<3)),
+      _mm_slli_epi32(channel4(Pixels, Params.Src.GreenPos), 8)),
+      _mm_sll_epi32(channel4(Pixels, Params.Src.BluePos), _mm_cvtsi32_si128(blue_pos24(Params.Dest)<<3)));
+}
+
+// 24-bit pixels are expanded to, and packed from, the low three bytes of each 32-bit lane.  Exactly 12 bytes are
+// accessed so that the last pixel of a row can be processed in memory that ends at the row.
+
+SSE_INLINE __m128i load_rgb24(const UBYTE *Data)
+{
+#if SIMD_SSSE3
+   LONG hi;
+   memcpy(&hi, Data + 8, sizeof(hi));
+   const __m128i v = _mm_unpacklo_epi64(_mm_loadl_epi64((const __m128i *)Data), _mm_cvtsi32_si128(hi));
+   return _mm_shuffle_epi8(v, _mm_setr_epi8(0,1,2,-1, 3,4,5,-1, 6,7,8,-1, 9,10,11,-1));
+#else
+   ULONG px[4];
+   memcpy(&px[0], Data, 4);
+   memcpy(&px[1], Data + 3, 4);
+   memcpy(&px[2], Data + 6, 4);
+   memcpy(&px[3], Data + 8, 4);
+   return _mm_and_si128(_mm_setr_epi32(px[0], px[1], px[2], px[3]>>8), _mm_set1_epi32(0xffffff));
+#endif
+}
+
+SSE_INLINE void store_rgb24(UBYTE *Data, __m128i Pixels)
+{
+#if SIMD_SSSE3
+   const __m128i v = _mm_shuffle_epi8(Pixels, _mm_setr_epi8(0,1,2, 4,5,6, 8,9,10, 12,13,14, -1,-1,-1,-1));
+   const LONG hi = _mm_cvtsi128_si32(_mm_srli_si128(v, 8));
+   _mm_storel_epi64((__m128i *)Data, v);
+   memcpy(Data + 8, &hi, sizeof(hi));
+#else
+   // Each store overwrites the unused byte of the previous one.  The last pixel is stored with the final byte of the
+   // third.
+
+   alignas(16) ULONG px[4];
+   _mm_store_si128((__m128i *)px, Pixels);
+   px[3] = (px[3]<<8) | ((px[2]>>16) & 0xff);
+   memcpy(Data, &px[0], 4);
+   memcpy(Data + 3, &px[1], 4);
+   memcpy(Data + 6, &px[2], 4);
+   memcpy(Data + 8, &px[3], 4);
+#endif
+}
+
+// Packs eight channel values to the 16-bit format of the destination.
+
+SSE_INLINE __m128i pack16(__m128i Red, __m128i Green, __m128i Blue, const ColourFormat &Format)
+{
+   const __m128i r = _mm_sll_epi16(_mm_and_si128(_mm_srl_epi16(Red, _mm_cvtsi32_si128(Format.RedShift)),
+      _mm_set1_epi16(Format.RedMask)), _mm_cvtsi32_si128(Format.RedPos));
+   const __m128i g = _mm_sll_epi16(_mm_and_si128(_mm_srl_epi16(Green, _mm_cvtsi32_si128(Format.GreenShift)),
+      _mm_set1_epi16(Format.GreenMask)), _mm_cvtsi32_si128(Format.GreenPos));
+   const __m128i b = _mm_sll_epi16(_mm_and_si128(_mm_srl_epi16(Blue, _mm_cvtsi32_si128(Format.BlueShift)),
+      _mm_set1_epi16(Format.BlueMask)), _mm_cvtsi32_si128(Format.BluePos));
+   return _mm_or_si128(_mm_or_si128(r, g), _mm_or_si128(b, _mm_set1_epi16(WORD(CFPackAlpha(&Format, 255)))));
+}
+
+SSE_INLINE __m128i unpack16(__m128i Pixels, UBYTE Pos, UBYTE Mask, UBYTE Shift)
+{
+   return _mm_sll_epi16(_mm_and_si128(_mm_srl_epi16(Pixels, _mm_cvtsi32_si128(Pos)), _mm_set1_epi16(Mask)),
+      _mm_cvtsi32_si128(Shift));
+}
+
+// Blends the unpacked 16-bit lanes of Src and Dest with rounding, as srctable[Src] + desttable[Dest].
+
+SSE_INLINE __m128i mix16(__m128i Src, __m128i Dest, __m128i Alpha)
+{
+   return _mm_add_epi16(div255(_mm_mullo_epi16(Src, Alpha)),
+      div255(_mm_mullo_epi16(Dest, _mm_sub_epi16(_mm_set1_epi16(255), Alpha))));
+}
+
+//****************************************************************************
+// 32-bit to 32-bit alpha blend.  The vector path requires that both bitmaps use the same channel layout.
+
+SSE_KERNEL void blend32(const UBYTE *Src, UBYTE *Dest, LONG Width, const blit_params &Params)
+{
+   if ((Params.Src.RedPos != Params.Dest.RedPos) or (Params.Src.GreenPos != Params.Dest.GreenPos) or
+       (Params.Src.BluePos != Params.Dest.BluePos) or (Params.Src.AlphaPos != Params.Dest.AlphaPos)) {
+      blend32_scalar(Src, Dest, Width, Params);
+      return;
+   }
+
+   const __m128i zero  = _mm_setzero_si128();
+   const __m128i amask = _mm_set1_epi32(ULONG(0xff)<<Params.Src.AlphaPos);
+   const __m128i ashift = _mm_cvtsi32_si128(Params.Src.AlphaPos);
+   const __m128i opacity = _mm_set1_epi32(Params.Opacity);
+   const bool full = (Params.Copy) or (Params.Opacity IS 0xff);
+
+   LONG x = 0;
+   for (; x+4 <= Width; x += 4, Src += 16, Dest += 16) {
+      const __m128i s = _mm_loadu_si128((const __m128i *)Src);
+      const __m128i d = _mm_loadu_si128((const __m128i *)Dest);
+      const __m128i sa = channel4(s, Params.Src.AlphaPos);
+
+      __m128i a, copy;
+      if (full) {
+         a = sa;
+         copy = _mm_cmpeq_epi32(sa, _mm_set1_epi32(0xff));
+         if (Params.Copy) copy = _mm_or_si128(copy, _mm_cmpeq_epi32(channel4(d, Params.Dest.AlphaPos), zero));
+      }
+      else {
+         a = _mm_srli_epi32(_mm_mullo_epi16(sa, opacity), 8);
+         copy = zero;
+      }
+
+      // The colour channels are blended with the effective alpha and the alpha channel with the source alpha.
+
+      __m128i ab = _mm_or_si128(_mm_or_si128(a, _mm_slli_epi32(a, 8)), _mm_or_si128(_mm_slli_epi32(a, 16), _mm_slli_epi32(a, 24)));
+      ab = _mm_or_si128(_mm_andnot_si128(amask, ab), _mm_sll_epi32(sa, ashift));
+      const __m128i src = _mm_or_si128(s, amask);
+
+      const __m128i alo = _mm_unpacklo_epi8(ab, zero);
+      const __m128i ahi = _mm_unpackhi_epi8(ab, zero);
+      _mm_storeu_si128((__m128i *)Dest, simd_select4(copy, s, simd_blend256(d, src, alo, ahi)));
+   }
+
+   if (x < Width) blend32_scalar(Src, Dest, Width - x, Params);
+}
+
+//****************************************************************************
+// 32-bit to 24-bit alpha blend.
+
+SSE_KERNEL void blend24(const UBYTE *Src, UBYTE *Dest, LONG Width, const blit_params &Params)
+{
+   const __m128i zero = _mm_setzero_si128();
+   const __m128i opacity = _mm_set1_epi32(Params.Opacity);
+
+   LONG x = 0;
+   for (; x+4 <= Width; x += 4, Src += 16, Dest += 12) {
+      const __m128i s = _mm_loadu_si128((const __m128i *)Src);
+      const __m128i a = div255(_mm_mullo_epi16(channel4(s, Params.Src.AlphaPos), opacity));
+      if (_mm_movemask_epi8(_mm_cmpeq_epi32(a, zero)) IS 0xffff) continue;
+
+      const __m128i d = load_rgb24(Dest);
+      const __m128i rgb = to_rgb24(s, Params);
+      const __m128i a16 = _mm_or_si128(a, _mm_slli_epi32(a, 16));
+
+      const __m128i lo = mix16(_mm_unpacklo_epi8(rgb, zero), _mm_unpacklo_epi8(d, zero), _mm_unpacklo_epi32(a16, a16));
+      const __m128i hi = mix16(_mm_unpackhi_epi8(rgb, zero), _mm_unpackhi_epi8(d, zero), _mm_unpackhi_epi32(a16, a16));
+
+      store_rgb24(Dest, simd_select4(_mm_cmpeq_epi32(a, zero), d, _mm_packus_epi16(lo, hi)));
+   }
+
+   if (x < Width) blend24_scalar(Src, Dest, Width - x, Params);
+}
+
+//****************************************************************************
+// 32-bit to 16-bit alpha blend, eight pixels per step.
+
+SSE_KERNEL void blend16(const UBYTE *Src, UBYTE *Dest, LONG Width, const blit_params &Params)
+{
+   const ColourFormat &df = Params.Dest;
+   const __m128i zero = _mm_setzero_si128();
+   const __m128i opacity = _mm_set1_epi16(Params.Opacity);
+
+   LONG x = 0;
+   for (; x+8 <= Width; x += 8, Src += 32, Dest += 16) {
+      const __m128i s0 = _mm_loadu_si128((const __m128i *)Src);
+      const __m128i s1 = _mm_loadu_si128((const __m128i *)(Src + 16));
+      const __m128i a = div255(_mm_mullo_epi16(channel8(s0, s1, Params.Src.AlphaPos), opacity));
+      const __m128i skip = _mm_cmpeq_epi16(a, zero);
+      if (_mm_movemask_epi8(skip) IS 0xffff) continue;
+
+      const __m128i d = _mm_loadu_si128((const __m128i *)Dest);
+      const __m128i red   = mix16(channel8(s0, s1, Params.Src.RedPos), unpack16(d, df.RedPos, df.RedMask, df.RedShift), a);
+      const __m128i green = mix16(channel8(s0, s1, Params.Src.GreenPos), unpack16(d, df.GreenPos, df.GreenMask, df.GreenShift), a);
+      const __m128i blue  = mix16(channel8(s0, s1, Params.Src.BluePos), unpack16(d, df.BluePos, df.BlueMask, df.BlueShift), a);
+
+      _mm_storeu_si128((__m128i *)Dest, simd_select4(skip, d, pack16(red, green, blue, df)));
+   }
+
+   if (x < Width) blend16_scalar(Src, Dest, Width - x, Params);
+}
+
+//****************************************************************************
+// Straight conversion of 32-bit pixels to 24-bit.
+
+SSE_KERNEL void copy24(const UBYTE *Src, UBYTE *Dest, LONG Width, const blit_params &Params)
+{
+   LONG x = 0;
+   for (; x+4 <= Width; x += 4, Src += 16, Dest += 12) {
+      store_rgb24(Dest, to_rgb24(_mm_loadu_si128((const __m128i *)Src), Params));
+   }
+
+   if (x < Width) copy24_scalar(Src, Dest, Width - x, Params);
+}
+
+//****************************************************************************
+// Straight conversion of 32-bit pixels to 16-bit, eight pixels per step.
+
+SSE_KERNEL void copy16(const UBYTE *Src, UBYTE *Dest, LONG Width, const blit_params &Params)
+{
+   LONG x = 0;
+   for (; x+8 <= Width; x += 8, Src += 32, Dest += 16) {
+      const __m128i s0 = _mm_loadu_si128((const __m128i *)Src);
+      const __m128i s1 = _mm_loadu_si128((const __m128i *)(Src + 16));
+      _mm_storeu_si128((__m128i *)Dest, pack16(channel8(s0, s1, Params.Src.RedPos),
+         channel8(s0, s1, Params.Src.GreenPos), channel8(s0, s1, Params.Src.BluePos), Params.Dest));
+   }
+
+   if (x < Width) copy16_scalar(Src, Dest, Width - x, Params);
+}
+
+} // namespace
@@ -0,0 +1,351 @@
+/*****************************************************************************
+
+Dithering of bitmaps to lower colour depths, as used by gfxCopyArea() with BAF_DITHER and by gfxResample().  Each row
+is read into a buffer of 8-bit RGBA values.  The buffer is then quantised with Floyd-Steinberg error diffusion, or with
+an 8x8 Bayer matrix if BAF_ORDERED is set, and packed to the destination in one pass.  Quantisation and packing are
+table-driven for 8, 16, 24 and 32 bit memory layouts.  Other destinations are drawn through DrawUCRIndex().
+
+A quantised channel is truncated to the mask of the target format, which is the value that UnpackRed() and its
+siblings return for the packed pixel.  Destinations with a palette use an inverse colour map from 15-bit RGB to palette
+index.  The map is cached until the palette changes, and each cell holds the RGBToValue() match for the cell centre.
+
+*****************************************************************************/
+
+#define DITHER_CUBE_SIZE (32 * 32 * 32)
+
+static const UBYTE glBayer8[64] = {
+    0, 32,  8, 40,  2, 34, 10, 42,
+   48, 16, 56, 24, 50, 18, 58, 26,
+   12, 44,  4, 36, 14, 46,  6, 38,
+   60, 28, 52, 20, 62, 30, 54, 22,
+    3, 35, 11, 43,  1, 33,  9, 41,
+   51, 19, 59, 27, 49, 17, 57, 25,
+   15, 47,  7, 39, 13, 45,  5, 37,
+   63, 31, 55, 23, 61, 29, 53, 21
+};
+
+struct dither_tables {
+   UBYTE Level[3][256];       // Quantised value of each red, green and blue value
+   ULONG Pack[3][256];        // Destination bits for each quantised value
+   WORD  Bias[3][64];         // Ordered dither offset for each cell of the Bayer matrix
+   const UBYTE *Cube;         // Inverse colour map, if the destination uses a palette
+   const RGBPalette *Palette;
+};
+
+//****************************************************************************
+
+static ULONG palette_hash(const RGBPalette *Palette)
+{
+   ULONG hash = 2166136261 ^ Palette->AmtColours;
+   for (LONG i=0; i < Palette->AmtColours; i++) {
+      hash = (hash ^ Palette->Col[i].Red) * 16777619;
+      hash = (hash ^ Palette->Col[i].Green) * 16777619;
+      hash = (hash ^ Palette->Col[i].Blue) * 16777619;
+   }
+   return hash;
+}
+
+// Returns the inverse colour map for a palette.  The scoring is identical to RGBToValue(), including the exclusion of
+// the background colour at index zero.
+
+static const UBYTE * get_dither_cube(const RGBPalette *Palette)
+{
+   const ULONG hash = palette_hash(Palette);
+   if ((glDitherCube) and (hash IS glDitherCubeHash)) return glDitherCube;
+
+   if (!glDitherCube) {
+      if (AllocMemory(DITHER_CUBE_SIZE, MEM_NO_CLEAR|MEM_UNTRACKED, &glDitherCube, NULL) != ERR_Okay) return NULL;
+   }
+
+   for (LONG i=0; i < DITHER_CUBE_SIZE; i++) {
+      const WORD red = ((i>>10)<<3) + 4, green = (((i>>5) & 0x1f)<<3) + 4, blue = ((i & 0x1f)<<3) + 4;
+      LONG best_match = 0x7fffffff;
+      UBYTE best = 0;
+      for (LONG c=Palette->AmtColours-1; c > 0; c--) {
+         const LONG match = abs(red - Palette->Col[c].Red) + abs(green - Palette->Col[c].Green) + abs(blue - Palette->Col[c].Blue);
+         if (match < best_match) {
+            best_match = match;
+            best = c;
+            if (!match) break;
+         }
+      }
+      glDitherCube[i] = best;
+   }
+
+   glDitherCubeHash = hash;
+   return glDitherCube;
+}
+
+//****************************************************************************
+// Format describes the precision of the quantised values and Dest describes the layout that they are packed to.
+
+static ERROR init_dither_tables(dither_tables &Tables, objBitmap *Dest, const ColourFormat *Format)
+{
+   const ColourFormat *df = Dest->ColourFormat;
+   const UBYTE masks[3]  = { UBYTE(Format->RedMask << Format->RedShift), UBYTE(Format->GreenMask << Format->GreenShift), UBYTE(Format->BlueMask << Format->BlueShift) };
+   const UBYTE shift[3]  = { df->RedShift, df->GreenShift, df->BlueShift };
+   const UBYTE dmask[3]  = { df->RedMask, df->GreenMask, df->BlueMask };
+   const UBYTE pos[3]    = { df->RedPos, df->GreenPos, df->BluePos };
+
+   Tables.Cube    = NULL;
+   Tables.Palette = NULL;
+
+   if ((Dest->BytesPerPixel IS 1) and (Dest->Palette) and (Dest->Palette->AmtColours > 1)) {
+      if (!(Tables.Cube = get_dither_cube(Dest->Palette))) return ERR_AllocMemory;
+      Tables.Palette = Dest->Palette;
+
+      // The step between neighbouring palette colours is estimated from the size of a uniform colour cube.
+
+      LONG levels = 2;
+      while ((levels + 1) * (levels + 1) * (levels + 1) <= Dest->Palette->AmtColours) levels++;
+      const LONG step = 256 / levels;
+      for (LONG c=0; c < 3; c++) {
+         for (LONG i=0; i < 64; i++) Tables.Bias[c][i] = ((glBayer8[i] * step)>>6) - (step>>1);
+      }
+      return ERR_Okay;
+   }
+
+   for (LONG c=0; c < 3; c++) {
+      const LONG step = 256 - masks[c]; // Distance between quantised values, e.g. 8 for a 5-bit channel
+      for (LONG v=0; v < 256; v++) {
+         Tables.Level[c][v] = v & masks[c];
+         Tables.Pack[c][v]  = ((ULONG(v & masks[c]) >> shift[c]) & dmask[c]) << pos[c];
+      }
+      for (LONG i=0; i < 64; i++) Tables.Bias[c][i] = (glBayer8[i] * step)>>6;
+   }
+
+   return ERR_Okay;
+}
+
+//****************************************************************************
+// Reads a row of pixels from the source as RGBA.
+
+static void dither_read_row(objBitmap *Bitmap, UBYTE *Data, LONG Width, UBYTE *Row)
+{
+   const ColourFormat *sf = Bitmap->ColourFormat;
+
+   if (Bitmap->BytesPerPixel IS 4) {
+      const ULONG *src = (const ULONG *)Data;
+      for (LONG x=0; x < Width; x++, Row += 4) {
+         const ULONG colour = src[x];
+         Row[0] = colour >> sf->RedPos;
+         Row[1] = colour >> sf->GreenPos;
+         Row[2] = colour >> sf->BluePos;
+         Row[3] = colour >> sf->AlphaPos;
+      }
+   }
+   else if (Bitmap->BytesPerPixel IS 3) {
+      const LONG r = red_pos24(*sf), b = blue_pos24(*sf);
+      for (LONG x=0; x < Width; x++, Row += 4, Data += 3) {
+         Row[0] = Data[r];
+         Row[1] = Data[1];
+         Row[2] = Data[b];
+         Row[3] = 255;
+      }
+   }
+   else if (Bitmap->BytesPerPixel IS 2) {
+      const UWORD *src = (const UWORD *)Data;
+      for (LONG x=0; x < Width; x++, Row += 4) {
+         const ULONG colour = src[x];
+         Row[0] = UnpackRed(Bitmap, colour);
+         Row[1] = UnpackGreen(Bitmap, colour);
+         Row[2] = UnpackBlue(Bitmap, colour);
+         Row[3] = 255;
+      }
+   }
+   else if ((Bitmap->BytesPerPixel IS 1) and (Bitmap->Palette)) {
+      const RGB8 *col = Bitmap->Palette->Col;
+      for (LONG x=0; x < Width; x++, Row += 4) {
+         Row[0] = col[Data[x]].Red;
+         Row[1] = col[Data[x]].Green;
+         Row[2] = col[Data[x]].Blue;
+         Row[3] = 255;
+      }
+   }
+   else {
+      RGB8 rgb;
+      for (LONG x=0; x < Width; x++, Row += 4, Data += Bitmap->BytesPerPixel) {
+         Bitmap->ReadUCRIndex(Bitmap, Data, &rgb);
+         Row[0] = rgb.Red;
+         Row[1] = rgb.Green;
+         Row[2] = rgb.Blue;
+         Row[3] = rgb.Alpha;
+      }
+   }
+}
+
+//****************************************************************************
+// Floyd-Steinberg error diffusion of a row.  The error buffers store three values per pixel, scaled by 16, and have a
+// guard pixel at each end.  Only the first two pixels of Next need to be cleared by the caller.  Quantised values replace the content of Row, and
+// palette indexes are written to Index if the destination uses a palette.
+
+static void dither_row_fs(const dither_tables &Tables, UBYTE *Row, UBYTE *Index, LONG Width, LONG *Current, LONG *Next)
+{
+   Current += 3;
+   Next    += 3;
+
+   for (LONG x=0; x < Width; x++, Row += 4, Current += 3, Next += 3) {
+      LONG value[3];
+      for (LONG c=0; c < 3; c++) {
+         const LONG v = Row[c] + ((Current[c] + 8)>>4);
+         value[c] = (v < 0) ? 0 : (v > 255) ? 255 : v;
+      }
+
+      if (Tables.Cube) {
+         const UBYTE i = Tables.Cube[((value[0]>>3)<<10) | ((value[1]>>3)<<5) | (value[2]>>3)];
+         Index[x] = i;
+         Row[0] = Tables.Palette->Col[i].Red;
+         Row[1] = Tables.Palette->Col[i].Green;
+         Row[2] = Tables.Palette->Col[i].Blue;
+      }
+      else {
+         Row[0] = Tables.Level[0][value[0]];
+         Row[1] = Tables.Level[1][value[1]];
+         Row[2] = Tables.Level[2][value[2]];
+      }
+
+      for (LONG c=0; c < 3; c++) {
+         const LONG error = value[c] - Row[c];
+         Current[c+3] += error * 7;
+         Next[c-3]    += error * 3;
+         Next[c]      += error * 5;
+         Next[c+3]     = error; // First contribution to this pixel
+      }
+   }
+}
+
+//****************************************************************************
+// Ordered dithering of a row.  X and Y locate the first pixel of the row in the destination.
+
+static void dither_row_ordered(const dither_tables &Tables, UBYTE *Row, UBYTE *Index, LONG Width, LONG X, LONG Y)
+{
+   const LONG row = (Y & 7)<<3;
+
+   for (LONG x=0; x < Width; x++, Row += 4) {
+      const LONG cell = row + ((X + x) & 7);
+      LONG value[3];
+      for (LONG c=0; c < 3; c++) {
+         const LONG v = Row[c] + Tables.Bias[c][cell];
+         value[c] = (v < 0) ? 0 : (v > 255) ? 255 : v;
+      }
+
+      if (Tables.Cube) {
+         const UBYTE i = Tables.Cube[((value[0]>>3)<<10) | ((value[1]>>3)<<5) | (value[2]>>3)];
+         Index[x] = i;
+         Row[0] = Tables.Palette->Col[i].Red;
+         Row[1] = Tables.Palette->Col[i].Green;
+         Row[2] = Tables.Palette->Col[i].Blue;
+      }
+      else {
+         Row[0] = Tables.Level[0][value[0]];
+         Row[1] = Tables.Level[1][value[1]];
+         Row[2] = Tables.Level[2][value[2]];
+      }
+   }
+}
+
+//****************************************************************************
+
+static void dither_write_row(const dither_tables &Tables, objBitmap *Dest, UBYTE *Data, const UBYTE *Row,
+   const UBYTE *Index, LONG Width)
+{
+   if (Tables.Cube) CopyMemory(Index, Data, Width);
+   else if (Dest->BytesPerPixel IS 2) {
+      UWORD *dest = (UWORD *)Data;
+      for (LONG x=0; x < Width; x++, Row += 4) {
+         dest[x] = Tables.Pack[0][Row[0]] | Tables.Pack[1][Row[1]] | Tables.Pack[2][Row[2]];
+      }
+   }
+   else if (Dest->BytesPerPixel IS 4) {
+      const UBYTE alpha_pos = Dest->ColourFormat->AlphaPos;
+      ULONG *dest = (ULONG *)Data;
+      for (LONG x=0; x < Width; x++, Row += 4) {
+         dest[x] = Tables.Pack[0][Row[0]] | Tables.Pack[1][Row[1]] | Tables.Pack[2][Row[2]] | (ULONG(Row[3]) << alpha_pos);
+      }
+   }
+   else if (Dest->BytesPerPixel IS 3) {
+      const LONG r = red_pos24(*Dest->ColourFormat), b = blue_pos24(*Dest->ColourFormat);
+      for (LONG x=0; x < Width; x++, Row += 4, Data += 3) {
+         Data[r] = Row[0];
+         Data[1] = Row[1];
+         Data[b] = Row[2];
+      }
+   }
+   else {
+      RGB8 rgb;
+      for (LONG x=0; x < Width; x++, Row += 4, Data += Dest->BytesPerPixel) {
+         rgb.Red   = Row[0];
+         rgb.Green = Row[1];
+         rgb.Blue  = Row[2];
+         rgb.Alpha = Row[3];
+         Dest->DrawUCRIndex(Dest, Data, &rgb);
+      }
+   }
+}
+
+//****************************************************************************
+// Dithers an area of Bitmap to Dest, which may be the same bitmap.  If a Format is provided then the colour values are
+// reduced to its precision, otherwise the format of the destination is used.  Set BAF_ORDERED in the Flags to use
+// ordered dithering in place of error diffusion.
+//
+// NOTE: Please ensure that the Width and Height are already clipped to meet the restrictions of BOTH the source and
+// destination bitmaps.
+
+static ERROR dither(objBitmap *Bitmap, objBitmap *Dest, ColourFormat *Format, LONG Width, LONG Height,
+   LONG SrcX, LONG SrcY, LONG DestX, LONG DestY, LONG Flags)
+{
+   parasol::Log log(__FUNCTION__);
+
+   if ((Width < 1) or (Height < 1)) return ERR_Okay;
+
+   if ((Dest->BitsPerPixel >= 24) and (!Format)) {
+      log.warning("Dithering attempted to a %dbpp bitmap.", Dest->BitsPerPixel);
+      return ERR_Failed;
+   }
+
+   if (!Format) Format = Dest->ColourFormat;
+
+   dither_tables tables;
+   if (init_dither_tables(tables, Dest, Format) != ERR_Okay) return ERR_AllocMemory;
+
+   // The scratch buffer holds two rows of errors, a row of pixels and a row of palette indexes.
+
+   const LONG err_size = (Width + 2) * 3;
+   const LONG size = (err_size * 2 * sizeof(LONG)) + (Width * 5);
+   if (size > glDitherSize) {
+      if (glDither) { FreeResource(glDither); glDither = NULL; glDitherSize = 0; }
+
+      if (AllocMemory(size, MEM_NO_CLEAR|MEM_UNTRACKED, &glDither, NULL) != ERR_Okay) {
+         return ERR_AllocMemory;
+      }
+      glDitherSize = size;
+   }
+
+   LONG *current = (LONG *)glDither;
+   LONG *next    = current + err_size;
+   UBYTE *row    = (UBYTE *)(next + err_size);
+   UBYTE *index  = row + (Width * 4);
+
+   ClearMemory(next, err_size * sizeof(LONG));
+
+   UBYTE *srcdata  = Bitmap->Data + (SrcY * Bitmap->LineWidth) + (SrcX * Bitmap->BytesPerPixel);
+   UBYTE *destdata = Dest->Data + (DestY * Dest->LineWidth) + (DestX * Dest->BytesPerPixel);
+
+   for (LONG y=0; y < Height; y++) {
+      dither_read_row(Bitmap, srcdata, Width, row);
+
+      if (Flags & BAF_ORDERED) dither_row_ordered(tables, row, index, Width, DestX, DestY + y);
+      else {
+         std::swap(current, next);
+         ClearMemory(next, 6 * sizeof(LONG));
+         dither_row_fs(tables, row, index, Width, current, next);
+      }
+
+      dither_write_row(tables, Dest, destdata, row, index, Width);
+
+      srcdata  += Bitmap->LineWidth;
+      destdata += Dest->LineWidth;
+   }
+
+   return ERR_Okay;
+}
@@ -0,0 +1,359 @@
+/*****************************************************************************
+
+Separable resampling for gfxCopyStretch(), used by the CSTF_AREA, CSTF_CUBIC and CSTF_LANCZOS filters.
+
+The weights of each output column and row are computed once per call.  The source is read one row at a time, converted
+to premultiplied floating point RGBA and filtered horizontally.  A ring of filtered rows is kept for the vertical pass,
+so memory use is independent of the size of the source.  Output rows are split into bands that are processed in
+parallel by the worker pool of the Core when both bitmaps are held in memory.
+
+Reductions of more than 2:1 can be prefiltered with CSTF_FILTER_SOURCE.  Each source row is then read from a virtual
+mip level, in which blocks of 2^n x 2^n pixels are averaged, and the filter kernel only needs to cover a 2:1
+reduction of that level.  The source bitmap is not modified.
+
+As with the bilinear filter, taps that fall past the edge of the source area are transparent unless CSTF_CLAMP is set,
+in which case the edge pixels are repeated.  Sources without an alpha channel are always clamped.
+
+*****************************************************************************/
+
+#include <vector>
+
+#define RESAMPLE_MIN_BAND     16    // Minimum number of output rows in a band
+#define RESAMPLE_MIN_PARALLEL 65536 // Output areas with fewer pixels than this are processed by the caller only
+
+enum { RSF_AREA=0, RSF_MITCHELL, RSF_LANCZOS };
+
+// Contributions of the source to each output column or row.  Every output index has Stride weights, of which the first
+// Count[i] apply to the source pixels that begin at Start[i].
+
+struct resample_weights {
+   std::vector<LONG> Start, Count;
+   std::vector<FLOAT> Weights;
+   LONG Stride;
+};
+
+struct resample_job {
+   objBitmap *Src, *Dest;
+   resample_weights X, Y;
+   ClipRectangle SrcClip;  // Readable area of the source, offsets included
+   LONG SrcX, SrcY;        // Top-left of the source area, offsets included
+   LONG MipX, MipY;        // Mip level of each axis
+   LONG MipWidth;          // Width of the source area at the mip level
+   LONG DestX, DestY;      // Top-left of the first output pixel, offsets included
+   LONG Width;             // Number of output columns
+   LONG Height;            // Number of output rows
+   LONG Bands;
+   bool SrcAlpha, DestAlpha, SrcMem, DestMem;
+};
+
+//****************************************************************************
+
+static DOUBLE mitchell_filter(DOUBLE X)
+{
+   const DOUBLE B = 1.0 / 3.0, C = 1.0 / 3.0;
+   X = fabs(X);
+   if (X < 1.0) return ((12.0 - 9.0 * B - 6.0 * C) * X * X * X + (-18.0 + 12.0 * B + 6.0 * C) * X * X + (6.0 - 2.0 * B)) / 6.0;
+   else if (X < 2.0) return ((-B - 6.0 * C) * X * X * X + (6.0 * B + 30.0 * C) * X * X + (-12.0 * B - 48.0 * C) * X + (8.0 * B + 24.0 * C)) / 6.0;
+   else return 0;
+}
+
+static DOUBLE lanczos_filter(DOUBLE X)
+{
+   X = fabs(X);
+   if (X < 1e-8) return 1.0;
+   else if (X < 3.0) return (3.0 * sin(PI * X) * sin(PI * X / 3.0)) / (PI * PI * X * X);
+   else return 0;
+}
+
+//****************************************************************************
+// Computes the weights for mapping SrcSize source pixels to DestSize output pixels, where Scale is the number of
+// source pixels per output pixel.  Only the output range First to First+Total-1 is computed.  If Clamp is true, source
+// indexes are clamped to the edges.  Otherwise the taps past the edges are transparent and their weights are dropped.
+
+static void calc_weights(resample_weights &Weights, LONG Filter, LONG SrcSize, DOUBLE Scale, LONG First, LONG Total,
+   bool Clamp)
+{
+   const DOUBLE stretch = (Scale > 1.0) ? Scale : 1.0;
+   const DOUBLE support = (Filter IS RSF_AREA) ? (Scale * 0.5) + 0.5 : ((Filter IS RSF_LANCZOS) ? 3.0 : 2.0) * stretch;
+
+   Weights.Stride = LONG(ceil(support * 2.0)) + 1;
+   Weights.Start.resize(Total);
+   Weights.Count.resize(Total);
+   Weights.Weights.assign(size_t(Total) * Weights.Stride, 0);
+
+   std::vector<DOUBLE> w(Weights.Stride);
+   for (LONG i=0; i < Total; i++) {
+      const LONG o = First + i;
+      const DOUBLE centre = (o + 0.5) * Scale;
+
+      LONG lo = LONG(floor(centre - support));
+      LONG hi = LONG(ceil(centre + support));
+      if (hi - lo > Weights.Stride) hi = lo + Weights.Stride;
+
+      const LONG start = (lo < 0) ? 0 : (lo >= SrcSize) ? SrcSize - 1 : lo;
+      LONG end = (hi > SrcSize) ? SrcSize : hi;
+      if (end <= start) end = start + 1;
+
+      std::fill(w.begin(), w.end(), 0.0);
+      DOUBLE total = 0;
+      for (LONG s=lo; s < hi; s++) {
+         DOUBLE v;
+         if (Filter IS RSF_AREA) { // Coverage of the source pixel by the footprint of the output pixel
+            const DOUBLE left  = (s > o * Scale) ? s : o * Scale;
+            const DOUBLE right = (s + 1 < (o + 1) * Scale) ? s + 1 : (o + 1) * Scale;
+            v = (right > left) ? right - left : 0;
+         }
+         else if (Filter IS RSF_LANCZOS) v = lanczos_filter((s + 0.5 - centre) / stretch);
+         else v = mitchell_filter((s + 0.5 - centre) / stretch);
+
+         total += v;
+         if ((!Clamp) and ((s < 0) or (s >= SrcSize))) continue;
+
+         const LONG c = (s < start) ? start : (s >= end) ? end - 1 : s;
+         w[c - start] += v;
+      }
+
+      if (total IS 0) { w[0] = 1.0; total = 1.0; }
+
+      Weights.Start[i] = start;
+      Weights.Count[i] = end - start;
+      FLOAT *dw = Weights.Weights.data() + (size_t(i) * Weights.Stride);
+      for (LONG c=0; c < end - start; c++) dw[c] = w[c] / total;
+   }
+}
+
+//****************************************************************************
+// Reads source pixel X,Y (offsets included) as premultiplied RGBA.
+
+INLINE void read_source(const resample_job &Job, LONG X, LONG Y, FLOAT *Out)
+{
+   RGB8 rgb;
+   if (Job.SrcMem) {
+      const ULONG colour = ((ULONG *)(Job.Src->Data + (Y * Job.Src->LineWidth)))[X];
+      const ColourFormat *cf = Job.Src->ColourFormat;
+      rgb.Red   = colour >> cf->RedPos;
+      rgb.Green = colour >> cf->GreenPos;
+      rgb.Blue  = colour >> cf->BluePos;
+      rgb.Alpha = colour >> cf->AlphaPos;
+   }
+   else Job.Src->ReadUCRPixel(Job.Src, X, Y, &rgb);
+
+   if (Job.SrcAlpha) {
+      const FLOAT a = rgb.Alpha * (1.0f / 255.0f);
+      Out[0] = rgb.Red * a;
+      Out[1] = rgb.Green * a;
+      Out[2] = rgb.Blue * a;
+      Out[3] = rgb.Alpha;
+   }
+   else {
+      Out[0] = rgb.Red;
+      Out[1] = rgb.Green;
+      Out[2] = rgb.Blue;
+      Out[3] = 255;
+   }
+}
+
+// Reads row Y of the source area at the mip level of the job.  Source coordinates outside of the clipping region are
+// clamped to its edges.
+
+static void read_source_row(const resample_job &Job, LONG Y, FLOAT *Out)
+{
+   const LONG bw = 1<<Job.MipX, bh = 1<<Job.MipY;
+   std::fill(Out, Out + (Job.MipWidth * 4), 0.0f);
+
+   for (LONG j=0; j < bh; j++) {
+      LONG sy = Job.SrcY + (Y * bh) + j;
+      if (sy < Job.SrcClip.Top) sy = Job.SrcClip.Top;
+      else if (sy >= Job.SrcClip.Bottom) sy = Job.SrcClip.Bottom - 1;
+
+      for (LONG x=0; x < Job.MipWidth; x++) {
+         FLOAT *out = Out + (x * 4);
+         for (LONG i=0; i < bw; i++) {
+            LONG sx = Job.SrcX + (x * bw) + i;
+            if (sx < Job.SrcClip.Left) sx = Job.SrcClip.Left;
+            else if (sx >= Job.SrcClip.Right) sx = Job.SrcClip.Right - 1;
+
+            FLOAT px[4];
+            read_source(Job, sx, sy, px);
+            out[0] += px[0];
+            out[1] += px[1];
+            out[2] += px[2];
+            out[3] += px[3];
+         }
+      }
+   }
+
+   if ((bw > 1) or (bh > 1)) {
+      const FLOAT scale = 1.0f / FLOAT(bw * bh);
+      for (LONG i=0; i < Job.MipWidth * 4; i++) Out[i] *= scale;
+   }
+}
+
+//****************************************************************************
+
+INLINE UBYTE resample_clamp(FLOAT Value)
+{
+   if (Value <= 0) return 0;
+   else if (Value >= 255.0f) return 255;
+   else return UBYTE(Value + 0.5f);
+}
+
+static void write_dest_row(const resample_job &Job, LONG Y, const FLOAT *In)
+{
+   const ColourFormat *cf = Job.Dest->ColourFormat;
+   for (LONG x=0; x < Job.Width; x++, In += 4) {
+      RGB8 rgb;
+      const FLOAT a = In[3];
+      if ((Job.SrcAlpha) and (a < 254.5f)) {
+         if (a <= 0.5f) rgb = { 0, 0, 0, 0 };
+         else {
+            const FLOAT ia = 255.0f / a;
+            rgb.Red   = resample_clamp(In[0] * ia);
+            rgb.Green = resample_clamp(In[1] * ia);
+            rgb.Blue  = resample_clamp(In[2] * ia);
+            rgb.Alpha = resample_clamp(a);
+         }
+      }
+      else {
+         rgb.Red   = resample_clamp(In[0]);
+         rgb.Green = resample_clamp(In[1]);
+         rgb.Blue  = resample_clamp(In[2]);
+         rgb.Alpha = 255;
+      }
+
+      if (Job.DestMem) {
+         ((ULONG *)(Job.Dest->Data + ((Job.DestY + Y) * Job.Dest->LineWidth)))[Job.DestX + x] =
+            (ULONG(rgb.Red) << cf->RedPos) | (ULONG(rgb.Green) << cf->GreenPos) | (ULONG(rgb.Blue) << cf->BluePos) |
+            (ULONG(Job.DestAlpha ? rgb.Alpha : 255) << cf->AlphaPos);
+      }
+      else Job.Dest->DrawUCRPixel(Job.Dest, Job.DestX + x, Job.DestY + Y, &rgb);
+   }
+}
+
+//****************************************************************************
+// Produces the output rows of a band.  The source rows that are needed advance with each output row, so horizontally
+// filtered rows are held in a ring that is large enough for the taps of one output row.
+
+static void resample_band(APTR Data, LONG Index)
+{
+   auto &job = *(resample_job *)Data;
+   const LONG start = (job.Height * Index) / job.Bands;
+   const LONG end   = (job.Height * (Index + 1)) / job.Bands;
+   if (start >= end) return;
+
+   const LONG ring = job.Y.Stride;
+   const LONG row_size = job.Width * 4;
+   std::vector<FLOAT> source(job.MipWidth * 4), filtered(size_t(ring) * row_size), output(row_size);
+   std::vector<LONG> ring_row(ring, -1);
+
+   for (LONG y=start; y < end; y++) {
+      const LONG first = job.Y.Start[y];
+      const FLOAT *wy = job.Y.Weights.data() + (size_t(y) * job.Y.Stride);
+
+      std::fill(output.begin(), output.end(), 0.0f);
+      for (LONG j=0; j < job.Y.Count[y]; j++) {
+         const LONG sy = first + j;
+         FLOAT *row = filtered.data() + (size_t(sy % ring) * row_size);
+
+         if (ring_row[sy % ring] != sy) {
+            read_source_row(job, sy, source.data());
+
+            for (LONG x=0; x < job.Width; x++) {
+               const FLOAT *wx = job.X.Weights.data() + (size_t(x) * job.X.Stride);
+               const FLOAT *sp = source.data() + (job.X.Start[x] * 4);
+               FLOAT r = 0, g = 0, b = 0, a = 0;
+               for (LONG i=0; i < job.X.Count[x]; i++, sp += 4) {
+                  r += sp[0] * wx[i];
+                  g += sp[1] * wx[i];
+                  b += sp[2] * wx[i];
+                  a += sp[3] * wx[i];
+               }
+               row[(x * 4) + 0] = r;
+               row[(x * 4) + 1] = g;
+               row[(x * 4) + 2] = b;
+               row[(x * 4) + 3] = a;
+            }
+            ring_row[sy % ring] = sy;
+         }
+
+         const FLOAT w = wy[j];
+         for (LONG i=0; i < row_size; i++) output[i] += row[i] * w;
+      }
+
+      write_dest_row(job, y, output.data());
+   }
+}
+
+//****************************************************************************
+// Stretches the source area X, Y, Width, Height to the destination area.  The surfaces of both bitmaps must be locked
+// by the caller.
+
+static void resample_stretch(objBitmap *Src, objBitmap *Dest, LONG Flags, LONG X, LONG Y, LONG Width, LONG Height,
+   LONG DestX, LONG DestY, LONG DestWidth, LONG DestHeight)
+{
+   parasol::Log log(__FUNCTION__);
+
+   resample_job job;
+   job.Src  = Src;
+   job.Dest = Dest;
+
+   // The destination area is restricted to the clipping region, but the mapping to the source is not affected.
+
+   LONG dx = DestX, dy = DestY, dr = DestX + DestWidth, db = DestY + DestHeight;
+   if (dx < Dest->Clip.Left) dx = Dest->Clip.Left;
+   if (dy < Dest->Clip.Top) dy = Dest->Clip.Top;
+   if (dr > Dest->Clip.Right) dr = Dest->Clip.Right;
+   if (db > Dest->Clip.Bottom) db = Dest->Clip.Bottom;
+   if ((dr <= dx) or (db <= dy)) return;
+
+   job.Width   = dr - dx;
+   job.Height  = db - dy;
+   job.DestX   = dx + Dest->XOffset;
+   job.DestY   = dy + Dest->YOffset;
+   job.SrcX    = X + Src->XOffset;
+   job.SrcY    = Y + Src->YOffset;
+
+   job.SrcClip = Src->Clip;
+   job.SrcClip.Left   += Src->XOffset;
+   job.SrcClip.Right  += Src->XOffset;
+   job.SrcClip.Top    += Src->YOffset;
+   job.SrcClip.Bottom += Src->YOffset;
+
+   job.SrcAlpha  = (Src->BitsPerPixel IS 32) and (Src->Flags & BMF_ALPHA_CHANNEL);
+   job.DestAlpha = (Dest->BitsPerPixel IS 32) and (Dest->Flags & BMF_ALPHA_CHANNEL);
+   job.SrcMem    = (Src->BytesPerPixel IS 4) and (is_mem_bitmap(Src));
+   job.DestMem   = (Dest->BytesPerPixel IS 4) and (is_mem_bitmap(Dest));
+
+   // Each mip level halves the source area.  Levels are chosen so that the remaining reduction is no more than 2:1.
+
+   job.MipX = job.MipY = 0;
+   if (Flags & CSTF_FILTER_SOURCE) {
+      while ((Width>>(job.MipX + 1)) >= DestWidth * 2) job.MipX++;
+      while ((Height>>(job.MipY + 1)) >= DestHeight * 2) job.MipY++;
+   }
+
+   const LONG mip_width  = (Width + (1<<job.MipX) - 1)>>job.MipX;
+   const LONG mip_height = (Height + (1<<job.MipY) - 1)>>job.MipY;
+   job.MipWidth = mip_width;
+
+   LONG filter;
+   if (Flags & CSTF_LANCZOS) filter = RSF_LANCZOS;
+   else if (Flags & CSTF_CUBIC) filter = RSF_MITCHELL;
+   else filter = RSF_AREA;
+
+   const bool clamp = (Flags & CSTF_CLAMP) or (!job.SrcAlpha);
+   calc_weights(job.X, filter, mip_width, (DOUBLE(Width) / DOUBLE(1<<job.MipX)) / DOUBLE(DestWidth), dx - DestX, job.Width, clamp);
+   calc_weights(job.Y, filter, mip_height, (DOUBLE(Height) / DOUBLE(1<<job.MipY)) / DOUBLE(DestHeight), dy - DestY, job.Height, clamp);
+
+   job.Bands = 1;
+   if ((is_mem_bitmap(Src)) and (is_mem_bitmap(Dest)) and (LARGE(job.Width) * LARGE(job.Height) >= RESAMPLE_MIN_PARALLEL)) {
+      job.Bands = GetResource(RES_THREAD_POOL);
+      if (job.Bands > job.Height / RESAMPLE_MIN_BAND) job.Bands = job.Height / RESAMPLE_MIN_BAND;
+      if (job.Bands < 1) job.Bands = 1;
+   }
+
+   log.trace("Filter: %d, Mip: %d/%d, Taps: %dx%d, Bands: %d", filter, job.MipX, job.MipY, job.X.Stride, job.Y.Stride, job.Bands);
+
+   if (job.Bands > 1) ThreadBatch(&resample_band, &job, job.Bands);
+   else resample_band(&job, 0);
+}
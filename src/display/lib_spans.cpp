@@ -0,0 +1,344 @@
+/*****************************************************************************
+
+Span routines for the software drawing primitives.  Rectangles, lines, ellipses and flood fills are broken into
+horizontal spans that are clipped once and then written directly to the rows of memory bitmaps.  Solid spans are
+filled with 128-bit stores or memset().  Translucent spans are blended through per-channel tables that are built once
+per primitive, using the same arithmetic as the original per-pixel routines: dest + (((colour - dest) * opacity)>>8).
+
+Bitmaps that are not in client memory, such as video surfaces and planar bitmaps, are drawn through the DrawUCPixel()
+and ReadUCRPixel() function pointers as before.
+
+The byte order of 24-bit pixels follows MemDrawLSBPixel24() and MemDrawMSBPixel24(), so the blue component is always
+held in the first byte.
+
+*****************************************************************************/
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+struct span_colour {
+   ULONG Colour;          // The packed colour, as passed to DrawUCPixel()
+   ULONG Raw;             // The colour as it is stored in memory, in the form returned by span_read()
+   UBYTE Red, Green, Blue;
+   UBYTE Opacity;
+   bool  Direct;          // True if spans can be written to Bitmap->Data
+   UBYTE Blend[3][256];   // Blended red, green and blue for each destination value.  Valid if Opacity < 255
+   ULONG Packed[3][256];  // Blended 15/16 bit channels, indexed by the unpacked channel bits
+};
+
+//****************************************************************************
+
+static void init_span_colour(span_colour &Span, objBitmap *Bitmap, ULONG Colour, UBYTE Opacity)
+{
+   Span.Colour  = Colour;
+   Span.Opacity = Opacity;
+   Span.Red     = UnpackRed(Bitmap, Colour);
+   Span.Green   = UnpackGreen(Bitmap, Colour);
+   Span.Blue    = UnpackBlue(Bitmap, Colour);
+
+   Span.Direct = (Bitmap->Data) and (is_mem_bitmap(Bitmap)) and (Bitmap->BytesPerPixel >= 1) and (Bitmap->BytesPerPixel <= 4);
+   if ((Opacity < 255) and (Bitmap->BytesPerPixel < 2)) Span.Direct = false; // Blending with a palette
+
+   switch (Bitmap->BytesPerPixel) {
+      case 4:  Span.Raw = Colour; break;
+      case 3:  Span.Raw = (Bitmap->ColourFormat->RedPos IS 16) ? (Colour & 0xffffff) :
+                  (((Colour>>16) & 0xff) | (Colour & 0xff00) | ((Colour & 0xff)<<16)); break;
+      case 2:  Span.Raw = Colour & 0xffff; break;
+      default: Span.Raw = Colour & 0xff; break;
+   }
+
+   if (Opacity < 255) {
+      const UBYTE colour[3] = { Span.Red, Span.Green, Span.Blue };
+      for (LONG c=0; c < 3; c++) {
+         for (LONG v=0; v < 256; v++) Span.Blend[c][v] = (((colour[c] - v) * Opacity)>>8) + v;
+      }
+
+      if (Bitmap->BytesPerPixel IS 2) {
+         const ColourFormat *cf = Bitmap->ColourFormat;
+         const UBYTE shift[3] = { cf->RedShift, cf->GreenShift, cf->BlueShift };
+         const UBYTE mask[3]  = { cf->RedMask, cf->GreenMask, cf->BlueMask };
+         const UBYTE pos[3]   = { cf->RedPos, cf->GreenPos, cf->BluePos };
+         for (LONG c=0; c < 3; c++) {
+            for (LONG q=0; q <= mask[c]; q++) {
+               Span.Packed[c][q] = ((Span.Blend[c][UBYTE(q << shift[c])] >> shift[c]) & mask[c]) << pos[c];
+            }
+         }
+      }
+   }
+}
+
+//****************************************************************************
+// Reads a pixel in the form used by span_colour.Raw.  Only valid for Direct bitmaps.
+
+INLINE ULONG span_read(objBitmap *Bitmap, LONG X, LONG Y)
+{
+   const UBYTE *row = Bitmap->Data + (Y * Bitmap->LineWidth);
+   switch (Bitmap->BytesPerPixel) {
+      case 4:  return ((const ULONG *)row)[X];
+      case 3:  row += X * 3; return row[0] | (row[1]<<8) | (row[2]<<16);
+      case 2:  return ((const UWORD *)row)[X];
+      default: return row[X];
+   }
+}
+
+static void fill_span32(ULONG *Dest, ULONG Value, LONG Width)
+{
+   if ((Value & 0xff) * 0x01010101 IS Value) {
+      memset(Dest, Value & 0xff, Width<<2);
+      return;
+   }
+
+#if defined(__SSE2__)
+   const __m128i value = _mm_set1_epi32(Value);
+   for (; Width >= 4; Width -= 4, Dest += 4) _mm_storeu_si128((__m128i *)Dest, value);
+#endif
+   while (Width-- > 0) *Dest++ = Value;
+}
+
+//****************************************************************************
+// Draws a span that has already been clipped.  X and Y are absolute, i.e. they include the bitmap's XOffset and
+// YOffset.
+
+static void fill_span(objBitmap *Bitmap, const span_colour &Span, LONG X, LONG Y, LONG Width)
+{
+   if (!Span.Direct) {
+      if (Span.Opacity < 255) {
+         RGB8 pixel;
+         for (LONG x=X; x < X + Width; x++) {
+            Bitmap->ReadUCRPixel(Bitmap, x, Y, &pixel);
+            pixel.Red   = Span.Blend[0][pixel.Red];
+            pixel.Green = Span.Blend[1][pixel.Green];
+            pixel.Blue  = Span.Blend[2][pixel.Blue];
+            pixel.Alpha = 255;
+            Bitmap->DrawUCRPixel(Bitmap, x, Y, &pixel);
+         }
+      }
+      else for (LONG x=X; x < X + Width; x++) Bitmap->DrawUCPixel(Bitmap, x, Y, Span.Colour);
+      return;
+   }
+
+   UBYTE *row = Bitmap->Data + (Y * Bitmap->LineWidth);
+
+   if (Span.Opacity IS 255) {
+      switch (Bitmap->BytesPerPixel) {
+         case 4: fill_span32((ULONG *)row + X, Span.Raw, Width); break;
+
+         case 3: {
+            UBYTE pattern[12]; // Four pixels
+            for (LONG i=0; i < 12; i += 3) {
+               pattern[i] = Span.Raw; pattern[i+1] = Span.Raw>>8; pattern[i+2] = Span.Raw>>16;
+            }
+            UBYTE *data = row + (X * 3);
+            for (; Width >= 4; Width -= 4, data += 12) CopyMemory(pattern, data, 12);
+            if (Width > 0) CopyMemory(pattern, data, Width * 3);
+            break;
+         }
+
+         case 2: {
+            UWORD *data = (UWORD *)row + X;
+            if (((size_t)data & 2) and (Width > 0)) { *data++ = Span.Raw; Width--; }
+            fill_span32((ULONG *)data, Span.Raw | (Span.Raw<<16), Width>>1);
+            if (Width & 1) data[Width - 1] = Span.Raw;
+            break;
+         }
+
+         default: memset(row + X, Span.Raw, Width); break;
+      }
+      return;
+   }
+
+   const ColourFormat *cf = Bitmap->ColourFormat;
+   switch (Bitmap->BytesPerPixel) {
+      case 4: {
+         const UBYTE rp = cf->RedPos, gp = cf->GreenPos, bp = cf->BluePos;
+         const ULONG alpha = ULONG(255) << cf->AlphaPos;
+         ULONG *data = (ULONG *)row + X;
+         for (LONG x=0; x < Width; x++) {
+            const ULONG pixel = data[x];
+            data[x] = (ULONG(Span.Blend[0][UBYTE(pixel >> rp)]) << rp) |
+                      (ULONG(Span.Blend[1][UBYTE(pixel >> gp)]) << gp) |
+                      (ULONG(Span.Blend[2][UBYTE(pixel >> bp)]) << bp) | alpha;
+         }
+         break;
+      }
+
+      case 3: {
+         UBYTE *data = row + (X * 3);
+         for (LONG x=0; x < Width; x++, data += 3) {
+            data[0] = Span.Blend[2][data[0]];
+            data[1] = Span.Blend[1][data[1]];
+            data[2] = Span.Blend[0][data[2]];
+         }
+         break;
+      }
+
+      case 2: {
+         const UBYTE rp = cf->RedPos, gp = cf->GreenPos, bp = cf->BluePos;
+         const UBYTE rm = cf->RedMask, gm = cf->GreenMask, bm = cf->BlueMask;
+         UWORD *data = (UWORD *)row + X;
+         for (LONG x=0; x < Width; x++) {
+            const UWORD pixel = data[x];
+            data[x] = Span.Packed[0][(pixel >> rp) & rm] | Span.Packed[1][(pixel >> gp) & gm] | Span.Packed[2][(pixel >> bp) & bm];
+         }
+         break;
+      }
+   }
+}
+
+// Clips a span to an absolute clipping area before drawing it.
+
+INLINE void fill_clipped_span(objBitmap *Bitmap, const span_colour &Span, const ClipRectangle &Clip, LONG X, LONG Y,
+   LONG Width)
+{
+   if ((Y < Clip.Top) or (Y >= Clip.Bottom)) return;
+   if (X < Clip.Left) { Width -= Clip.Left - X; X = Clip.Left; }
+   if (X + Width > Clip.Right) Width = Clip.Right - X;
+   if (Width > 0) fill_span(Bitmap, Span, X, Y, Width);
+}
+
+//****************************************************************************
+// Breaks a Bresenham line into horizontal runs, calling Span(X, Y, Width) for each.  Both end points are included.
+
+template <class T> static void line_spans(LONG X, LONG Y, LONG EndX, LONG EndY, T &&Span)
+{
+   const LONG dx = EndX - X, dy = EndY - Y;
+   const LONG x_inc = (dx < 0) ? -1 : 1, y_inc = (dy < 0) ? -1 : 1;
+   const LONG l = (dx < 0) ? -dx : dx, m = (dy < 0) ? -dy : dy;
+   const LONG dx2 = l<<1, dy2 = m<<1;
+
+   if (l >= m) {
+      LONG err = dy2 - l, start = X;
+      for (LONG i=0; i < l; i++) {
+         if (err > 0) {
+            if (x_inc > 0) Span(start, Y, X - start + 1);
+            else Span(X, Y, start - X + 1);
+            Y += y_inc;
+            err -= dx2;
+            start = X + x_inc;
+         }
+         err += dy2;
+         X += x_inc;
+      }
+
+      if (x_inc > 0) Span(start, Y, X - start + 1);
+      else Span(X, Y, start - X + 1);
+   }
+   else {
+      LONG err = dx2 - m;
+      for (LONG i=0; i < m; i++) {
+         Span(X, Y, 1);
+         if (err > 0) { X += x_inc; err -= dy2; }
+         err += dx2;
+         Y += y_inc;
+      }
+      Span(X, Y, 1);
+   }
+}
+
+//****************************************************************************
+// Runs the midpoint algorithm for an ellipse with radii RX and RY, calling Span(X, Y, Width) relative to the centre.
+// Filled ellipses produce one span per row.  Outlines produce single pixels, with no pixel being drawn twice.
+
+template <class T> static void ellipse_spans(LONG RX, LONG RY, bool Fill, T &&Span)
+{
+   LONG t1 = RX * RX, t2 = t1<<1, t3 = t2<<1;
+   LONG t4 = RY * RY, t5 = t4<<1, t6 = t5<<1;
+   LONG t7 = RX * t5, t8 = t7<<1, t9 = 0;
+   LONG d1 = t2 - t7 + (t4>>1);
+   LONG d2 = (t1>>1) - t8 + t5;
+   LONG x = RX, y = 0, last_row = -1;
+
+   auto plot = [&]() {
+      if (Fill) {
+         // The first visit to a row has the widest extent, as x only decreases.
+         if (y != last_row) {
+            Span(-x, y, (x<<1) + 1);
+            if (y) Span(-x, -y, (x<<1) + 1);
+            last_row = y;
+         }
+      }
+      else {
+         Span(x, y, 1);
+         if (x) Span(-x, y, 1);
+         if (y) {
+            Span(x, -y, 1);
+            if (x) Span(-x, -y, 1);
+         }
+      }
+   };
+
+   while (d2 < 0) {
+      plot();
+      y++;
+      t9 += t3;
+      if (d1 < 0) {
+         d1 += t9 + t2;
+         d2 += t9;
+      }
+      else {
+         x--;
+         t8 -= t6;
+         d1 += t9 + t2 - t8;
+         d2 += t9 + t5 - t8;
+      }
+   }
+
+   do {
+      plot();
+      x--;
+      t8 -= t6;
+      if (d2 < 0) {
+         y++;
+         t9 += t3;
+         d2 += t9 + t5 - t8;
+      }
+      else d2 += t5 - t8;
+   } while (x >= 0);
+}
+
+//****************************************************************************
+// Scanline flood fill.  Every pixel that is 4-connected to (X, Y) and shares its colour is replaced with the span
+// colour, which must be opaque.  The coordinates and clipping area are absolute.
+
+static void flood_spans(objBitmap *Bitmap, const span_colour &Span, LONG X, LONG Y, const ClipRectangle &Clip)
+{
+   struct seed { LONG X, Y; };
+
+   auto read = [Bitmap, &Span](LONG PX, LONG PY) -> ULONG {
+      return Span.Direct ? span_read(Bitmap, PX, PY) : Bitmap->ReadUCPixel(Bitmap, PX, PY);
+   };
+
+   const ULONG background = read(X, Y);
+   std::vector<seed> stack = { { X, Y } };
+   bool first = true;
+
+   while (!stack.empty()) {
+      const seed s = stack.back();
+      stack.pop_back();
+      if (read(s.X, s.Y) != background) continue;
+
+      LONG left = s.X, right = s.X + 1;
+      while ((left > Clip.Left) and (read(left - 1, s.Y) IS background)) left--;
+      while ((right < Clip.Right) and (read(right, s.Y) IS background)) right++;
+
+      fill_span(Bitmap, Span, left, s.Y, right - left);
+
+      if (first) { // Stop if the fill colour cannot be distinguished from the background
+         if (read(X, Y) IS background) return;
+         first = false;
+      }
+
+      for (LONG y : { s.Y - 1, s.Y + 1 }) {
+         if ((y < Clip.Top) or (y >= Clip.Bottom)) continue;
+         bool in_run = false;
+         for (LONG x=left; x < right; x++) {
+            if (read(x, y) IS background) {
+               if (!in_run) stack.push_back({ x, y });
+               in_run = true;
+            }
+            else in_run = false;
+         }
+      }
+   }
+}
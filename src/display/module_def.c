@@ -41,6 +41,7 @@ static ERROR gfxSubscribeInput(FUNCTION * Callback, OBJECTID SurfaceFilter, LONG
 static ERROR gfxUnsubscribeInput(LONG Handle);
 static CSTRING gfxGetInputTypeName(LONG Type);
 static DOUBLE gfxScaleToDPI(DOUBLE Value);
+static void gfxGetPresentStats(LARGE * Frames, LARGE * Areas, LARGE * Puts, LARGE * Bytes);
 
 #ifdef  __cplusplus
 }
@@ -68,6 +69,7 @@ FDEF argsGetCursorPos[] = { { "Error", FD_LONG|FD_ERROR }, { "X", FD_LONG|FD_RES
 FDEF argsGetDisplayInfo[] = { { "Error", FD_LONG|FD_ERROR }, { "Display", FD_OBJECTID }, { "DisplayInfo:Info", FD_PTR|FD_STRUCT|FD_RESULT }, { 0, 0 } };
 FDEF argsGetDisplayType[] = { { "Result", FD_LONG }, { 0, 0 } };
 FDEF argsGetInputTypeName[] = { { "Result", FD_STR }, { "Type", FD_LONG }, { 0, 0 } };
+FDEF argsGetPresentStats[] = { { "Void", FD_VOID }, { "Frames", FD_LARGE|FD_RESULT }, { "Areas", FD_LARGE|FD_RESULT }, { "Puts", FD_LARGE|FD_RESULT }, { "Bytes", FD_LARGE|FD_RESULT }, { 0, 0 } };
 FDEF argsGetRelativeCursorPos[] = { { "Error", FD_LONG|FD_ERROR }, { "Surface", FD_OBJECTID }, { "X", FD_LONG|FD_RESULT }, { "Y", FD_LONG|FD_RESULT }, { 0, 0 } };
 FDEF argsLockCursor[] = { { "Error", FD_LONG|FD_ERROR }, { "Surface", FD_OBJECTID }, { 0, 0 } };
 FDEF argsReadPixel[] = { { "Result", FD_LONG }, { "Bitmap", FD_OBJECTPTR }, { "X", FD_LONG }, { "Y", FD_LONG }, { 0, 0 } };
@@ -125,6 +127,7 @@ const struct Function glFunctions[] = {
    { (APTR)gfxUnsubscribeInput, "UnsubscribeInput", argsUnsubscribeInput },
    { (APTR)gfxGetInputTypeName, "GetInputTypeName", argsGetInputTypeName },
    { (APTR)gfxScaleToDPI, "ScaleToDPI", argsScaleToDPI },
+   { (APTR)gfxGetPresentStats, "GetPresentStats", argsGetPresentStats },
    { NULL, NULL, NULL }
 };
 
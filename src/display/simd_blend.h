@@ -0,0 +1,59 @@
+#ifndef SIMD_BLEND_H
+#define SIMD_BLEND_H 1
+
+/*****************************************************************************
+
+SSE2 helpers shared by the 32-bit blending kernels of gfxCopyArea() (display/lib_blit.cpp) and the span renderer of
+the vector module (vector/scene/scene_spans.cpp).  Include after <immintrin.h> on GCC compatible x86 targets only.
+
+The blend is computed as (dest * (256 - alpha) + src * alpha) >> 8, which is the same value as
+dest + (((src - dest) * alpha)>>8) but never leaves the range of an unsigned 16-bit integer.  Using a source value of
+255 for the alpha channel gives the alpha formula of BLEND32().
+
+Kernels that have an SSE2 and an SSSE3 variant are written once in a *_sse.cpp file that is included twice, with
+SIMD_NS naming the namespace, SIMD_TARGET the instruction set and SIMD_SSSE3 set to 1 for the SSSE3 pass.  The
+helpers here only use SSE2 and are inlined into both.
+
+*****************************************************************************/
+
+#define SSE_INLINE static inline __attribute__((target(SIMD_TARGET), always_inline))
+#define SSE_KERNEL static __attribute__((target(SIMD_TARGET)))
+
+#define SIMD_HELPER static inline __attribute__((target("sse2"), always_inline))
+
+// Returns A where Mask is set and B otherwise.
+
+SIMD_HELPER __m128i simd_select4(__m128i Mask, __m128i A, __m128i B)
+{
+   return _mm_or_si128(_mm_and_si128(Mask, A), _mm_andnot_si128(Mask, B));
+}
+
+// Expands four 8-bit coverage values to one value per 32-bit lane.
+
+SIMD_HELPER __m128i simd_covers4(const UBYTE *Covers)
+{
+   LONG packed;
+   memcpy(&packed, Covers, sizeof(packed));
+   const __m128i zero = _mm_setzero_si128();
+   return _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(packed), zero), zero);
+}
+
+// Blends the bytes of Src into Dest.  ALo and AHi hold the 16-bit alpha level of each byte in the low and high
+// halves of the registers respectively.
+
+SIMD_HELPER __m128i simd_blend256(__m128i Dest, __m128i Src, __m128i ALo, __m128i AHi)
+{
+   const __m128i zero = _mm_setzero_si128();
+   const __m128i k256 = _mm_set1_epi16(256);
+
+   const __m128i lo = _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(Dest, zero), _mm_sub_epi16(k256, ALo)),
+      _mm_mullo_epi16(_mm_unpacklo_epi8(Src, zero), ALo));
+   const __m128i hi = _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(Dest, zero), _mm_sub_epi16(k256, AHi)),
+      _mm_mullo_epi16(_mm_unpackhi_epi8(Src, zero), AHi));
+
+   return _mm_packus_epi16(_mm_srli_epi16(lo, 8), _mm_srli_epi16(hi, 8));
+}
+
+#undef SIMD_HELPER
+
+#endif // SIMD_BLEND_H
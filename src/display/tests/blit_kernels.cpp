@@ -0,0 +1,286 @@
+/*****************************************************************************
+
+The source code of the Parasol project is made publicly available under the
+terms described in the LICENSE.TXT file that is distributed with this package.
+Please refer to it for further information on licensing.
+
+******************************************************************************
+
+This program checks the SIMD row kernels that gfxCopyArea() uses for 32-bit sources against the scalar kernels.
+Random rows with partially transparent pixels are blended and converted to 32, 24 and 16 bit destinations of
+differing channel layouts, with random opacity levels, and every resulting row must be bit-identical to the output of
+the scalar code.  The rounded arithmetic of the SIMD kernels is also checked against every entry of the alpha
+blending table.
+
+The throughput of each kernel is then reported in Mpixels/s for every format pair.
+
+Options: -iterations [n] -pixels [n] -seed [n]
+
+*****************************************************************************/
+
+#include <parasol/main.h>
+#include <startup.h>
+#include <parasol/modules/core.h>
+#include <parasol/modules/display.h>
+
+#include <string.h>
+
+#define BLEND_MAX_THRESHOLD 255
+#define BLEND_MIN_THRESHOLD 1
+
+static UBYTE *glAlphaLookup = NULL;
+
+#include "../lib_blit.cpp"
+
+CSTRING ProgName      = "BlitKernels";
+CSTRING ProgAuthor    = "Paul Manias";
+CSTRING ProgDate      = "October 2026";
+CSTRING ProgCopyright = "Paul Manias (c) 2026";
+LONG  ProgDebug = -1;
+FLOAT ProgCoreVersion = 1.0;
+
+extern struct CoreBase *CoreBase;
+static LONG glIterations = 100000;
+static LONG glPixels     = 1920;
+static ULONG glSeed      = 0x2545f491;
+static LONG glFailures   = 0;
+
+enum { OP_BLEND32=0, OP_BLEND24, OP_BLEND16, OP_COPY24, OP_COPY16, OP_END };
+
+static const CSTRING glOpNames[OP_END] = { "blend 32 > 32", "blend 32 > 24", "blend 32 > 16", "copy 32 > 24",
+   "copy 32 > 16" };
+
+static const LONG glDestBPP[OP_END] = { 4, 3, 2, 3, 2 };
+
+enum { FMT_BGRA=0, FMT_RGBA, FMT_BGR, FMT_RGB, FMT_565, FMT_555, FMT_END };
+
+#define ROW_WIDTH 96
+
+//****************************************************************************
+
+static ULONG rnd(void)
+{
+   glSeed ^= glSeed << 13;
+   glSeed ^= glSeed >> 17;
+   glSeed ^= glSeed << 5;
+   return glSeed;
+}
+
+// Favour the values that select special cases in the blending code.
+
+static UBYTE rnd_byte(void)
+{
+   switch (rnd() % 4) {
+      case 0:  return 0;
+      case 1:  return 255;
+      default: return rnd();
+   }
+}
+
+//****************************************************************************
+
+static void init_format(ColourFormat &Format, LONG Type)
+{
+   ClearMemory(&Format, sizeof(Format));
+   switch (Type) {
+      case FMT_BGRA:
+      case FMT_RGBA:
+         Format.RedPos   = (Type IS FMT_BGRA) ? 16 : 0;
+         Format.GreenPos = 8;
+         Format.BluePos  = (Type IS FMT_BGRA) ? 0 : 16;
+         Format.AlphaPos = 24;
+         Format.RedMask = Format.GreenMask = Format.BlueMask = Format.AlphaMask = 0xff;
+         Format.BitsPerPixel = 32;
+         break;
+
+      case FMT_BGR:
+      case FMT_RGB:
+         Format.RedPos   = (Type IS FMT_BGR) ? 16 : 0;
+         Format.GreenPos = 8;
+         Format.BluePos  = (Type IS FMT_BGR) ? 0 : 16;
+         Format.RedMask = Format.GreenMask = Format.BlueMask = 0xff;
+         Format.BitsPerPixel = 24;
+         break;
+
+      case FMT_565:
+      case FMT_555:
+         Format.RedShift   = 3;
+         Format.GreenShift = (Type IS FMT_565) ? 2 : 3;
+         Format.BlueShift  = 3;
+         Format.RedMask    = 0x1f;
+         Format.GreenMask  = (Type IS FMT_565) ? 0x3f : 0x1f;
+         Format.BlueMask   = 0x1f;
+         Format.RedPos     = (Type IS FMT_565) ? 11 : 10;
+         Format.GreenPos   = 5;
+         Format.BluePos    = 0;
+         Format.BitsPerPixel = (Type IS FMT_565) ? 16 : 15;
+         break;
+   }
+}
+
+// Selects a random destination format for an operation.
+
+static LONG dest_format(LONG Op)
+{
+   switch (glDestBPP[Op]) {
+      case 4:  return (rnd() & 1) ? FMT_BGRA : FMT_RGBA;
+      case 3:  return (rnd() & 1) ? FMT_BGR : FMT_RGB;
+      default: return (rnd() & 1) ? FMT_565 : FMT_555;
+   }
+}
+
+static BLIT_ROW get_kernel(LONG ISA, LONG Op)
+{
+   auto &k = glBlitKernels[ISA];
+   switch (Op) {
+      case OP_BLEND32: return k.Blend32;
+      case OP_BLEND24: return k.Blend24;
+      case OP_BLEND16: return k.Blend16;
+      case OP_COPY24:  return k.Copy24;
+      default:         return k.Copy16;
+   }
+}
+
+//****************************************************************************
+// The SIMD kernels compute the entries of the alpha blending table arithmetically.
+
+static void test_lookup(void)
+{
+   LONG mismatches = 0;
+   for (LONG a=0; a < 256; a++) {
+      for (LONG v=0; v < 256; v++) {
+         const LONG t = (a * v) + 128;
+         if (glAlphaLookup[(a<<8) + v] != ((t + (t>>8))>>8)) mismatches++;
+      }
+   }
+
+   print("Alpha table: %d mismatches", mismatches);
+   if (mismatches) glFailures++;
+}
+
+//****************************************************************************
+// Every kernel is compared to the scalar kernel over the entire row, so writes beyond the span are detected too.
+
+static void test_kernels(LONG ISA)
+{
+   UBYTE src[ROW_WIDTH * 4], expected[ROW_WIDTH * 4], result[ROW_WIDTH * 4];
+
+   LONG mismatches = 0;
+   for (LONG i=0; i < glIterations; i++) {
+      const LONG op     = rnd() % OP_END;
+      const LONG x      = rnd() % 8;
+      const LONG length = 1 + (rnd() % (ROW_WIDTH - 8));
+      const LONG bpp    = glDestBPP[op];
+
+      blit_params params;
+      init_format(params.Src, (rnd() & 1) ? FMT_BGRA : FMT_RGBA);
+      init_format(params.Dest, dest_format(op));
+      params.Opacity = rnd_byte();
+      params.Copy    = (op IS OP_BLEND32) and (rnd() & 1);
+
+      for (LONG p=0; p < ROW_WIDTH * 4; p++) {
+         src[p] = (p & 3) IS 3 ? rnd_byte() : rnd();
+         expected[p] = ((p & 3) IS 3) or (rnd() & 1) ? rnd_byte() : rnd();
+      }
+      CopyMemory(expected, result, sizeof(result));
+
+      get_kernel(BLIT_SCALAR, op)(src + (x * 4), expected + (x * bpp), length, params);
+      get_kernel(ISA, op)(src + (x * 4), result + (x * bpp), length, params);
+
+      if (memcmp(expected, result, sizeof(result))) {
+         if (!mismatches) {
+            for (LONG p=0; p < ROW_WIDTH * 4; p++) {
+               if (expected[p] != result[p]) {
+                  print("%s %s: byte %d is $%.2x, expected $%.2x (x: %d, length: %d, opacity: %d)", glBlitISANames[ISA],
+                     glOpNames[op], p, result[p], expected[p], x, length, params.Opacity);
+                  break;
+               }
+            }
+         }
+         mismatches++;
+      }
+   }
+
+   print("%-6s %d rows, %d mismatches", glBlitISANames[ISA], glIterations, mismatches);
+   if (mismatches) glFailures++;
+}
+
+//****************************************************************************
+
+static void benchmark(LONG ISA)
+{
+   auto src  = new UBYTE[glPixels * 4];
+   auto dest = new UBYTE[glPixels * 4];
+
+   for (LONG p=0; p < glPixels * 4; p++) src[p] = (p & 3) IS 3 ? rnd_byte() : rnd();
+
+   const LONG repeat = (32 * 1024 * 1024) / glPixels;
+   for (LONG op=0; op < OP_END; op++) {
+      blit_params params;
+      init_format(params.Src, FMT_BGRA);
+      init_format(params.Dest, (glDestBPP[op] IS 4) ? FMT_BGRA : (glDestBPP[op] IS 3) ? FMT_BGR : FMT_565);
+      params.Opacity = 0xff;
+      params.Copy    = false;
+
+      auto kernel = get_kernel(ISA, op);
+      for (LONG p=0; p < glPixels * 4; p++) dest[p] = p;
+
+      LARGE start = PreciseTime();
+      for (LONG r=0; r < repeat; r++) kernel(src, dest, glPixels, params);
+      LARGE elapsed = PreciseTime() - start;
+
+      print("%-6s %-14s %8.1f Mpixels/s", glBlitISANames[ISA], glOpNames[op],
+         DOUBLE(repeat) * DOUBLE(glPixels) / DOUBLE(elapsed ? elapsed : 1));
+   }
+
+   delete[] dest;
+   delete[] src;
+}
+
+//****************************************************************************
+
+int main(int argc, CSTRING *argv)
+{
+   const char *msg = init_parasol(argc, argv);
+   if (msg) {
+      print(msg);
+      return -1;
+   }
+
+   CSTRING *args;
+   if ((!GetPointer(CurrentTask(), FID_Parameters, &args)) and (args)) {
+      for (LONG i=0; args[i]; i++) {
+         if (!StrMatch(args[i], "-iterations")) {
+            if (args[++i]) glIterations = StrToInt(args[i]);
+            else break;
+         }
+         else if (!StrMatch(args[i], "-pixels")) {
+            if (args[++i]) glPixels = StrToInt(args[i]);
+            else break;
+         }
+         else if (!StrMatch(args[i], "-seed")) {
+            if (args[++i]) glSeed = StrToInt(args[i]);
+            else break;
+         }
+      }
+   }
+
+   if (glPixels < 1) glPixels = 1;
+   if (!glSeed) glSeed = 1;
+
+   UBYTE lookup[256 * 256];
+   build_alpha_lookup(lookup);
+   glAlphaLookup = lookup;
+
+   const LONG detected = glBlitISA;
+   print("Detected instruction set: %s", glBlitISANames[detected]);
+
+   test_lookup();
+   for (LONG isa=BLIT_SCALAR+1; isa <= detected; isa++) test_kernels(isa);
+   for (LONG isa=BLIT_SCALAR; isa <= detected; isa++) benchmark(isa);
+
+   if (glFailures) print("%d failures detected.", glFailures);
+
+   close_parasol();
+   return glFailures ? -1 : 0;
+}
@@ -0,0 +1,531 @@
+/*****************************************************************************
+
+The source code of the Parasol project is made publicly available under the
+terms described in the LICENSE.TXT file that is distributed with this package.
+Please refer to it for further information on licensing.
+
+******************************************************************************
+
+This program checks the span-based dithering routines that gfxCopyArea() and gfxResample() use for low-depth
+destinations.  Random gradient images are dithered with Floyd-Steinberg and ordered modes.  The targets are 16-bit
+565 and 555 layouts, a 256 colour palette, and 24 and 32 bit bitmaps that are reduced to 16-bit precision.  Each
+result must be bit-identical to a reference image.  Reference images are produced by a straightforward per-pixel
+implementation that works on the whole image and searches the palette directly.  The tests use source and
+destination offsets as well as in-place conversion.
+
+Flat fields are also dithered, to confirm that the average of each channel is kept.  The throughput of each mode is
+reported in Mpixels/s next to that of the per-pixel reference.
+
+Options: -iterations [n] -seed [n]
+
+*****************************************************************************/
+
+#include <parasol/main.h>
+#include <startup.h>
+#include <parasol/modules/core.h>
+#include <parasol/modules/display.h>
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <utility>
+#include <vector>
+
+#define BLEND_MAX_THRESHOLD 255
+#define BLEND_MIN_THRESHOLD 1
+
+static UBYTE *glAlphaLookup = NULL;
+static APTR glDither = NULL;
+static LONG glDitherSize = 0;
+static UBYTE *glDitherCube = NULL;
+static ULONG glDitherCubeHash = 0;
+
+#include "../lib_blit.cpp"
+#include "../lib_dither.cpp"
+
+CSTRING ProgName      = "Dither";
+CSTRING ProgAuthor    = "Paul Manias";
+CSTRING ProgDate      = "October 2026";
+CSTRING ProgCopyright = "Paul Manias (c) 2026";
+LONG  ProgDebug = -1;
+FLOAT ProgCoreVersion = 1.0;
+
+extern struct CoreBase *CoreBase;
+static LONG glIterations = 20;
+static ULONG glSeed      = 0x2545f491;
+static LONG glFailures   = 0;
+
+enum { FMT_BGRA=0, FMT_BGR, FMT_565, FMT_555, FMT_PAL, FMT_END };
+
+static const CSTRING glFormatNames[FMT_END] = { "BGRA", "BGR", "565", "555", "8-bit" };
+
+struct test_bitmap {
+   objBitmap Bitmap;
+   ColourFormat Format;
+   RGBPalette Palette;
+   std::vector<UBYTE> Data;
+
+   test_bitmap(LONG Width, LONG Height, LONG Type);
+   test_bitmap(const test_bitmap &) = delete;
+};
+
+//****************************************************************************
+
+static ULONG rnd(void)
+{
+   glSeed ^= glSeed << 13;
+   glSeed ^= glSeed >> 17;
+   glSeed ^= glSeed << 5;
+   return glSeed;
+}
+
+static void init_format(ColourFormat &Format, LONG Type)
+{
+   ClearMemory(&Format, sizeof(Format));
+   switch (Type) {
+      case FMT_BGRA:
+         Format.RedPos   = 16;
+         Format.GreenPos = 8;
+         Format.BluePos  = 0;
+         Format.AlphaPos = 24;
+         Format.RedMask = Format.GreenMask = Format.BlueMask = Format.AlphaMask = 0xff;
+         Format.BitsPerPixel = 32;
+         break;
+
+      case FMT_BGR:
+         Format.RedPos   = 16;
+         Format.GreenPos = 8;
+         Format.BluePos  = 0;
+         Format.RedMask = Format.GreenMask = Format.BlueMask = 0xff;
+         Format.BitsPerPixel = 24;
+         break;
+
+      case FMT_565:
+      case FMT_555:
+         Format.RedShift   = 3;
+         Format.GreenShift = (Type IS FMT_565) ? 2 : 3;
+         Format.BlueShift  = 3;
+         Format.RedMask    = 0x1f;
+         Format.GreenMask  = (Type IS FMT_565) ? 0x3f : 0x1f;
+         Format.BlueMask   = 0x1f;
+         Format.RedPos     = (Type IS FMT_565) ? 11 : 10;
+         Format.GreenPos   = 5;
+         Format.BluePos    = 0;
+         Format.BitsPerPixel = (Type IS FMT_565) ? 16 : 15;
+         break;
+
+      case FMT_PAL:
+         Format.RedMask = Format.GreenMask = Format.BlueMask = 0xff;
+         Format.BitsPerPixel = 8;
+         break;
+   }
+}
+
+// A 6x6x6 colour cube followed by a grey ramp.  Index zero is reserved as the background colour.
+
+static void init_palette(RGBPalette &Palette)
+{
+   ClearMemory(&Palette, sizeof(Palette));
+   Palette.AmtColours = 256;
+   LONG i = 1;
+   for (LONG r=0; r < 6; r++) {
+      for (LONG g=0; g < 6; g++) {
+         for (LONG b=0; b < 6; b++, i++) {
+            Palette.Col[i].Red   = r * 51;
+            Palette.Col[i].Green = g * 51;
+            Palette.Col[i].Blue  = b * 51;
+            Palette.Col[i].Alpha = 255;
+         }
+      }
+   }
+
+   for (LONG g=0; i < 256; i++, g++) {
+      Palette.Col[i].Red = Palette.Col[i].Green = Palette.Col[i].Blue = 8 + (g * 6);
+      Palette.Col[i].Alpha = 255;
+   }
+}
+
+test_bitmap::test_bitmap(LONG Width, LONG Height, LONG Type)
+{
+   ClearMemory(&Bitmap, sizeof(Bitmap));
+   init_format(Format, Type);
+   init_palette(Palette);
+
+   Bitmap.Width         = Width;
+   Bitmap.Height        = Height;
+   Bitmap.BitsPerPixel  = Format.BitsPerPixel;
+   Bitmap.BytesPerPixel = (Format.BitsPerPixel + 7) / 8;
+   Bitmap.LineWidth     = ((Width * Bitmap.BytesPerPixel) + 3) & ~3;
+   Bitmap.Type          = BMP_CHUNKY;
+   Bitmap.ColourFormat  = &Format;
+   Bitmap.Palette       = &Palette;
+
+   Data.resize(Bitmap.LineWidth * Height);
+   Bitmap.Data = Data.data();
+}
+
+//****************************************************************************
+// Fills a bitmap with random gradients and noise.  Returns the RGBA value of every pixel as it reads back.
+
+static void fill_bitmap(test_bitmap &Bitmap, std::vector<UBYTE> &Pixels)
+{
+   objBitmap *bmp = &Bitmap.Bitmap;
+   const LONG gx = 1 + (rnd() % 8), gy = 1 + (rnd() % 8), noise = 1 + (rnd() % 64);
+
+   Pixels.resize(bmp->Width * bmp->Height * 4);
+   for (LONG y=0; y < bmp->Height; y++) {
+      UBYTE *data = bmp->Data + (y * bmp->LineWidth);
+      for (LONG x=0; x < bmp->Width; x++) {
+         LONG rgb[3] = { (x * gx) + (y * gy), (x * gy * 2) - y + 128, (y * gx) + 40 };
+         for (auto &c : rgb) {
+            c += (rnd() % noise) - (noise>>1);
+            c = (c < 0) ? 0 : (c > 255) ? 255 : c;
+         }
+         const UBYTE alpha = rnd();
+
+         UBYTE *pixel = Pixels.data() + (((y * bmp->Width) + x) * 4);
+         switch (bmp->BytesPerPixel) {
+            case 4:
+               ((ULONG *)data)[x] = CFPackPixelWBA(bmp->ColourFormat, rgb[0], rgb[1], rgb[2], alpha);
+               pixel[0] = rgb[0]; pixel[1] = rgb[1]; pixel[2] = rgb[2]; pixel[3] = alpha;
+               break;
+
+            case 3:
+               data[(x * 3) + 2] = rgb[0]; data[(x * 3) + 1] = rgb[1]; data[x * 3] = rgb[2];
+               pixel[0] = rgb[0]; pixel[1] = rgb[1]; pixel[2] = rgb[2]; pixel[3] = 255;
+               break;
+
+            case 2: {
+               const UWORD colour = CFPackPixel(bmp->ColourFormat, rgb[0], rgb[1], rgb[2]);
+               ((UWORD *)data)[x] = colour;
+               pixel[0] = CFUnpackRed(bmp->ColourFormat, colour);
+               pixel[1] = CFUnpackGreen(bmp->ColourFormat, colour);
+               pixel[2] = CFUnpackBlue(bmp->ColourFormat, colour);
+               pixel[3] = 255;
+               break;
+            }
+
+            default: {
+               const UBYTE i = 1 + (rnd() % 255);
+               data[x] = i;
+               pixel[0] = bmp->Palette->Col[i].Red; pixel[1] = bmp->Palette->Col[i].Green;
+               pixel[2] = bmp->Palette->Col[i].Blue; pixel[3] = 255;
+               break;
+            }
+         }
+      }
+   }
+}
+
+//****************************************************************************
+// The per-pixel reference.  Pixels is the RGBA source for the area to be dithered, and the expected RGBA result
+// replaces it.  Palette indexes are returned in Index.
+
+static LONG bayer(LONG X, LONG Y)
+{
+   LONG value = 0;
+   for (LONG bit=0; bit < 3; bit++) {
+      value |= (((X ^ Y)>>bit) & 1) << ((2 * (2 - bit)) + 1);
+      value |= ((Y>>bit) & 1) << (2 * (2 - bit));
+   }
+   return value;
+}
+
+static UBYTE reference_match(const RGBPalette &Palette, LONG Red, LONG Green, LONG Blue)
+{
+   Red   = ((Red>>3)<<3) + 4;
+   Green = ((Green>>3)<<3) + 4;
+   Blue  = ((Blue>>3)<<3) + 4;
+
+   LONG best_match = 0x7fffffff, best = 0;
+   for (LONG i=Palette.AmtColours-1; i > 0; i--) {
+      const LONG match = abs(Red - Palette.Col[i].Red) + abs(Green - Palette.Col[i].Green) + abs(Blue - Palette.Col[i].Blue);
+      if (match < best_match) {
+         if (!match) return i;
+         best_match = match;
+         best = i;
+      }
+   }
+   return best;
+}
+
+static void reference_dither(std::vector<UBYTE> &Pixels, std::vector<UBYTE> &Index, LONG Width, LONG Height,
+   const ColourFormat &Format, const RGBPalette *Palette, bool Ordered, LONG DestX, LONG DestY)
+{
+   const UBYTE masks[3] = { UBYTE(Format.RedMask << Format.RedShift), UBYTE(Format.GreenMask << Format.GreenShift),
+      UBYTE(Format.BlueMask << Format.BlueShift) };
+
+   LONG levels = 2;
+   if (Palette) while ((levels + 1) * (levels + 1) * (levels + 1) <= Palette->AmtColours) levels++;
+
+   std::vector<LONG> errors((Width + 2) * (Height + 1) * 3, 0);
+   auto err = [&](LONG X, LONG Y, LONG C) -> LONG & { return errors[(((Y * (Width + 2)) + X + 1) * 3) + C]; };
+
+   Index.assign(Width * Height, 0);
+   for (LONG y=0; y < Height; y++) {
+      for (LONG x=0; x < Width; x++) {
+         UBYTE *pixel = Pixels.data() + (((y * Width) + x) * 4);
+         LONG value[3];
+         for (LONG c=0; c < 3; c++) {
+            LONG v;
+            if (Ordered) {
+               const LONG cell = bayer((DestX + x) & 7, (DestY + y) & 7);
+               if (Palette) v = pixel[c] + ((cell * (256 / levels))>>6) - ((256 / levels)>>1);
+               else v = pixel[c] + ((cell * (256 - masks[c]))>>6);
+            }
+            else v = pixel[c] + ((err(x, y, c) + 8)>>4);
+            value[c] = (v < 0) ? 0 : (v > 255) ? 255 : v;
+         }
+
+         if (Palette) {
+            const UBYTE i = reference_match(*Palette, value[0], value[1], value[2]);
+            Index[(y * Width) + x] = i;
+            pixel[0] = Palette->Col[i].Red;
+            pixel[1] = Palette->Col[i].Green;
+            pixel[2] = Palette->Col[i].Blue;
+         }
+         else for (LONG c=0; c < 3; c++) pixel[c] = value[c] & masks[c];
+
+         if (!Ordered) {
+            for (LONG c=0; c < 3; c++) {
+               const LONG error = value[c] - pixel[c];
+               err(x + 1, y, c)     += error * 7;
+               err(x - 1, y + 1, c) += error * 3;
+               err(x, y + 1, c)     += error * 5;
+               err(x + 1, y + 1, c) += error;
+            }
+         }
+      }
+   }
+}
+
+//****************************************************************************
+// Compares an area of the destination to the expected RGBA and palette index values.
+
+static bool compare(test_bitmap &Dest, const std::vector<UBYTE> &Pixels, const std::vector<UBYTE> &Index,
+   LONG DestX, LONG DestY, LONG Width, LONG Height, CSTRING Name)
+{
+   objBitmap *bmp = &Dest.Bitmap;
+   const ColourFormat *df = bmp->ColourFormat;
+
+   for (LONG y=0; y < Height; y++) {
+      const UBYTE *data = bmp->Data + ((DestY + y) * bmp->LineWidth);
+      for (LONG x=0; x < Width; x++) {
+         const UBYTE *pixel = Pixels.data() + (((y * Width) + x) * 4);
+         const LONG dx = DestX + x;
+         ULONG expected, result;
+         switch (bmp->BytesPerPixel) {
+            case 4:
+               expected = CFPackPixelWBA(df, pixel[0], pixel[1], pixel[2], pixel[3]);
+               result = ((ULONG *)data)[dx];
+               break;
+            case 3:
+               expected = (pixel[0]<<16) | (pixel[1]<<8) | pixel[2];
+               result = (data[(dx * 3) + 2]<<16) | (data[(dx * 3) + 1]<<8) | data[dx * 3];
+               break;
+            case 2:
+               expected = CFPackPixel(df, pixel[0], pixel[1], pixel[2]);
+               result = ((UWORD *)data)[dx];
+               break;
+            default:
+               expected = Index[(y * Width) + x];
+               result = data[dx];
+               break;
+         }
+
+         if (expected != result) {
+            print("%s: pixel %d,%d is $%.8x, expected $%.8x", Name, x, y, result, expected);
+            return false;
+         }
+      }
+   }
+   return true;
+}
+
+//****************************************************************************
+
+static void test_reference(void)
+{
+   static const LONG src_formats[]  = { FMT_BGRA, FMT_BGRA, FMT_BGRA, FMT_565, FMT_BGR, FMT_BGRA };
+   static const LONG dest_formats[] = { FMT_565, FMT_555, FMT_PAL, FMT_PAL, FMT_BGR, FMT_BGRA };
+
+   LONG mismatches = 0, total = 0;
+   for (LONG i=0; i < glIterations; i++) {
+      for (LONG t=0; t < LONG(sizeof(dest_formats) / sizeof(dest_formats[0])); t++) {
+         for (LONG mode=0; mode < 2; mode++) {
+            const LONG width = 1 + (rnd() % 70), height = 1 + (rnd() % 40);
+            const LONG sx = rnd() % 9, sy = rnd() % 9;
+            const LONG dx = rnd() % 9, dy = rnd() % 9;
+
+            // Destinations of 24 and 32 bits are only dithered by Resample(), which is always in place.
+
+            const bool resample = (dest_formats[t] IS FMT_BGR) or (dest_formats[t] IS FMT_BGRA);
+            test_bitmap src(width + sx, height + sy, resample ? dest_formats[t] : src_formats[t]);
+            test_bitmap dest(width + dx, height + dy, dest_formats[t]);
+            test_bitmap *target = resample ? &src : &dest;
+
+            std::vector<UBYTE> source, pixels, index;
+            fill_bitmap(src, source);
+            for (LONG y=0; y < height; y++) {
+               const UBYTE *row = source.data() + ((((sy + y) * (width + sx)) + sx) * 4);
+               pixels.insert(pixels.end(), row, row + (width * 4));
+            }
+
+            ColourFormat reduced;
+            init_format(reduced, FMT_565);
+            const ColourFormat *format = resample ? &reduced : target->Bitmap.ColourFormat;
+            const bool palette = target->Bitmap.BytesPerPixel IS 1;
+            const LONG ox = resample ? sx : dx, oy = resample ? sy : dy;
+            reference_dither(pixels, index, width, height, *format, palette ? target->Bitmap.Palette : NULL, mode,
+               ox, oy);
+
+            dither(&src.Bitmap, &target->Bitmap, resample ? &reduced : NULL, width, height, sx, sy, ox, oy,
+               BAF_DITHER | (mode ? BAF_ORDERED : 0));
+
+            char name[80];
+            snprintf(name, sizeof(name), "%s > %s %s", glFormatNames[src_formats[t]], glFormatNames[dest_formats[t]],
+               mode ? "ordered" : "diffused");
+            if (!compare(*target, pixels, index, ox, oy, width, height, name)) mismatches++;
+            total++;
+         }
+      }
+   }
+
+   print("Reference images: %d tested, %d mismatches", total, mismatches);
+   if (mismatches) glFailures++;
+}
+
+//****************************************************************************
+// The average of a dithered flat field must be within a level of the original colour.
+
+static void test_flat_fields(void)
+{
+   LONG failures = 0;
+   for (LONG dest_format : { FMT_565, FMT_555, FMT_PAL }) {
+      for (LONG mode=0; mode < 2; mode++) {
+         for (LONG i=0; i < 16; i++) {
+            const UBYTE rgb[3] = { UBYTE(rnd()), UBYTE(rnd()), UBYTE(rnd()) };
+            test_bitmap src(64, 64, FMT_BGRA), dest(64, 64, dest_format);
+            for (LONG p=0; p < 64 * 64; p++) ((ULONG *)src.Bitmap.Data)[p] = CFPackPixelWBA(&src.Format, rgb[0], rgb[1], rgb[2], 255);
+
+            dither(&src.Bitmap, &dest.Bitmap, NULL, 64, 64, 0, 0, 0, 0, BAF_DITHER | (mode ? BAF_ORDERED : 0));
+
+            DOUBLE sum[3] = { 0, 0, 0 };
+            for (LONG y=16; y < 48; y++) {
+               for (LONG x=16; x < 48; x++) {
+                  UBYTE colour[3];
+                  if (dest_format IS FMT_PAL) {
+                     const RGB8 &col = dest.Palette.Col[dest.Bitmap.Data[(y * dest.Bitmap.LineWidth) + x]];
+                     colour[0] = col.Red; colour[1] = col.Green; colour[2] = col.Blue;
+                  }
+                  else {
+                     const UWORD pixel = ((UWORD *)(dest.Bitmap.Data + (y * dest.Bitmap.LineWidth)))[x];
+                     colour[0] = CFUnpackRed(&dest.Format, pixel);
+                     colour[1] = CFUnpackGreen(&dest.Format, pixel);
+                     colour[2] = CFUnpackBlue(&dest.Format, pixel);
+                  }
+                  for (LONG c=0; c < 3; c++) sum[c] += colour[c];
+               }
+            }
+
+            // Colours beyond the last level of a channel cannot be reached.  An ordered dither only keeps the
+            // average for evenly spaced levels, which excludes the palette.
+
+            if ((mode) and (dest_format IS FMT_PAL)) continue;
+
+            for (LONG c=0; c < 3; c++) {
+               const DOUBLE mean = sum[c] / (32 * 32);
+               const DOUBLE limit = (dest_format IS FMT_PAL) ? 255 : (dest_format IS FMT_565) and (c IS 1) ? 252 : 248;
+               const DOUBLE target = (rgb[c] > limit) ? limit : rgb[c];
+               if (fabs(mean - target) > 1.0) {
+                  if (!failures) {
+                     print("%s %s: channel %d averages %.2f, expected %d", glFormatNames[dest_format],
+                        mode ? "ordered" : "diffused", c, mean, rgb[c]);
+                  }
+                  failures++;
+               }
+            }
+         }
+      }
+   }
+
+   print("Flat fields: %d failures", failures);
+   if (failures) glFailures++;
+}
+
+//****************************************************************************
+
+static void benchmark(void)
+{
+   const LONG width = 1920, height = 1080;
+   test_bitmap src(width, height, FMT_BGRA);
+   std::vector<UBYTE> source, index;
+   fill_bitmap(src, source);
+
+   for (LONG dest_format : { FMT_565, FMT_PAL }) {
+      test_bitmap dest(width, height, dest_format);
+      for (LONG mode=0; mode < 2; mode++) {
+         const LONG flags = BAF_DITHER | (mode ? BAF_ORDERED : 0);
+         dither(&src.Bitmap, &dest.Bitmap, NULL, width, height, 0, 0, 0, 0, flags); // Builds the colour cube
+
+         const LONG repeat = 5;
+         LARGE start = PreciseTime();
+         for (LONG r=0; r < repeat; r++) dither(&src.Bitmap, &dest.Bitmap, NULL, width, height, 0, 0, 0, 0, flags);
+         LARGE elapsed = PreciseTime() - start;
+
+         std::vector<UBYTE> pixels(source);
+         start = PreciseTime();
+         reference_dither(pixels, index, width, height, dest.Format, (dest_format IS FMT_PAL) ? &dest.Palette : NULL,
+            mode, 0, 0);
+         LARGE ref_elapsed = PreciseTime() - start;
+
+         print("32 > %-6s %-9s %8.1f Mpixels/s (per-pixel reference: %.1f Mpixels/s)", glFormatNames[dest_format],
+            mode ? "ordered" : "diffused", DOUBLE(repeat) * width * height / DOUBLE(elapsed ? elapsed : 1),
+            DOUBLE(width) * height / DOUBLE(ref_elapsed ? ref_elapsed : 1));
+      }
+   }
+}
+
+//****************************************************************************
+
+int main(int argc, CSTRING *argv)
+{
+   const char *msg = init_parasol(argc, argv);
+   if (msg) {
+      print(msg);
+      return -1;
+   }
+
+   CSTRING *args;
+   if ((!GetPointer(CurrentTask(), FID_Parameters, &args)) and (args)) {
+      for (LONG i=0; args[i]; i++) {
+         if (!StrMatch(args[i], "-iterations")) {
+            if (args[++i]) glIterations = StrToInt(args[i]);
+            else break;
+         }
+         else if (!StrMatch(args[i], "-seed")) {
+            if (args[++i]) glSeed = StrToInt(args[i]);
+            else break;
+         }
+      }
+   }
+
+   if (!glSeed) glSeed = 1;
+
+   UBYTE lookup[256 * 256]; // Initialised as in the display module, although only the 24-bit helpers of lib_blit.cpp are used
+   build_alpha_lookup(lookup);
+   glAlphaLookup = lookup;
+
+   test_reference();
+   test_flat_fields();
+   benchmark();
+
+   if (glDither)     { FreeResource(glDither); glDither = NULL; }
+   if (glDitherCube) { FreeResource(glDitherCube); glDitherCube = NULL; }
+
+   if (glFailures) print("%d failures detected.", glFailures);
+
+   close_parasol();
+   return glFailures ? -1 : 0;
+}
@@ -0,0 +1,241 @@
+/*****************************************************************************
+
+The source code of the Parasol project is made publicly available under the
+terms described in the LICENSE.TXT file that is distributed with this package.
+Please refer to it for further information on licensing.
+
+******************************************************************************
+
+This program measures the batched presentation of client bitmaps to an X11 window.  It simulates fast scrolling, in
+which every frame exposes a strip of the window as many small rectangles, in the way that the Surface module copies
+its buffers after a redraw.  Each frame ends with a Flush of the display.  The number of puts per frame and the bytes
+uploaded are read from GetPresentStats() and reported next to the number of areas that were submitted.  The content
+of the window is then read back and compared with the source bitmap.
+
+The test needs an X server and can be run headless with Xvfb:
+
+   xvfb-run -s "-screen 0 1024x768x24" ./display_present
+
+It exits without failing if the display is not driven by X11.
+
+Options: -frames [n] -tile [n]
+
+*****************************************************************************/
+
+#include <parasol/main.h>
+#include <startup.h>
+#include <parasol/modules/core.h>
+#include <parasol/modules/display.h>
+
+#include <stdio.h>
+
+CSTRING ProgName      = "Present";
+CSTRING ProgAuthor    = "Paul Manias";
+CSTRING ProgDate      = "October 2026";
+CSTRING ProgCopyright = "Paul Manias (c) 2026";
+LONG  ProgDebug = -1;
+FLOAT ProgCoreVersion = 1.0;
+
+extern struct CoreBase *CoreBase;
+static struct DisplayBase *DisplayBase;
+static LONG glFrames   = 200;
+static LONG glTile     = 16;
+static LONG glFailures = 0;
+
+#define WIDTH  640
+#define HEIGHT 480
+#define STRIP  24   // Height of the area exposed by each scroll step
+
+//****************************************************************************
+// Draws the content of the source for a scroll position.  Sync() must be called first, because the X server may
+// still be reading the previous frame from shared memory.
+
+static void draw_source(objBitmap *Bitmap, LONG Scroll)
+{
+   gfxSync(Bitmap);
+   for (LONG y=0; y < Bitmap->Height; y++) {
+      ULONG *row = (ULONG *)(Bitmap->Data + (y * Bitmap->LineWidth));
+      const LONG v = y + Scroll;
+      for (LONG x=0; x < Bitmap->Width; x++) {
+         row[x] = PackPixelWBA(Bitmap, (x ^ v) & 0xff, (v * 3) & 0xff, ((x>>2) + (v>>1)) & 0xff, 255);
+      }
+   }
+}
+
+//****************************************************************************
+// Presents one scroll step.  The window content moves up with a single copy and the exposed strip is copied in tiles.
+
+static void present_frame(objDisplay *Display, objBitmap *Source)
+{
+   objBitmap *window = Display->Bitmap;
+
+   gfxCopyArea(Source, window, 0, 0, 0, WIDTH, HEIGHT - STRIP, 0, 0);
+   for (LONG y=HEIGHT - STRIP; y < HEIGHT; y += glTile) {
+      for (LONG x=0; x < WIDTH; x += glTile) {
+         const LONG w = (x + glTile > WIDTH) ? WIDTH - x : glTile;
+         const LONG h = (y + glTile > HEIGHT) ? HEIGHT - y : glTile;
+         gfxCopyArea(Source, window, 0, x, y, w, h, x, y);
+      }
+   }
+
+   acFlush(Display);
+}
+
+//****************************************************************************
+// Compares the window with the source bitmap.
+
+static void verify_window(objDisplay *Display, objBitmap *Source)
+{
+   objBitmap *window = Display->Bitmap;
+   if (acLock(window)) {
+      print("Unable to read the content of the window.");
+      glFailures++;
+      return;
+   }
+
+   LONG mismatches = 0;
+   for (LONG y=0; y < HEIGHT; y += 7) {
+      for (LONG x=0; x < WIDTH; x += 5) {
+         RGB8 *pixel, expected, result;
+         gfxReadRGBPixel(Source, x, y, &pixel);
+         expected = *pixel;
+         gfxReadRGBPixel(window, x, y, &pixel);
+         result = *pixel;
+         if ((expected.Red != result.Red) or (expected.Green != result.Green) or (expected.Blue != result.Blue)) {
+            if (!mismatches) {
+               print("Pixel %d,%d is %d,%d,%d, expected %d,%d,%d", x, y, result.Red, result.Green, result.Blue,
+                  expected.Red, expected.Green, expected.Blue);
+            }
+            mismatches++;
+         }
+      }
+   }
+
+   acUnlock(window);
+
+   print("Window content: %d mismatches", mismatches);
+   if (mismatches) glFailures++;
+}
+
+//****************************************************************************
+
+int main(int argc, CSTRING *argv)
+{
+   const char *msg = init_parasol(argc, argv);
+   if (msg) {
+      print(msg);
+      return -1;
+   }
+
+   CSTRING *args;
+   if ((!GetPointer(CurrentTask(), FID_Parameters, &args)) and (args)) {
+      for (LONG i=0; args[i]; i++) {
+         if (!StrMatch(args[i], "-frames")) {
+            if (args[++i]) glFrames = StrToInt(args[i]);
+            else break;
+         }
+         else if (!StrMatch(args[i], "-tile")) {
+            if (args[++i]) glTile = StrToInt(args[i]);
+            else break;
+         }
+      }
+   }
+
+   if (glFrames < 1) glFrames = 1;
+   if (glTile < 1) glTile = 1;
+
+   OBJECTPTR module;
+   if (LoadModule("display", MODVERSION_DISPLAY, &module, &DisplayBase)) {
+      print("Failed to load the display module.");
+      close_parasol();
+      return -1;
+   }
+
+   if (gfxGetDisplayType() != DT_X11) {
+      print("The display is not driven by X11, nothing to test.");
+      acFree(module);
+      close_parasol();
+      return 0;
+   }
+
+   objDisplay *display;
+   objBitmap *source;
+   if (!CreateObject(ID_DISPLAY, 0, &display,
+         FID_Width|TLONG,  WIDTH,
+         FID_Height|TLONG, HEIGHT,
+         TAGEND)) {
+      acShow(display);
+
+      if (!CreateObject(ID_BITMAP, 0, &source,
+            FID_Width|TLONG,        WIDTH,
+            FID_Height|TLONG,       HEIGHT,
+            FID_BitsPerPixel|TLONG, 32,
+            TAGEND)) {
+
+         draw_source(source, 0);
+         present_frame(display, source);
+
+         LARGE frames, areas, puts, bytes;
+         gfxGetPresentStats(&frames, &areas, &puts, &bytes);
+
+         LARGE start = PreciseTime();
+         for (LONG f=1; f <= glFrames; f++) {
+            draw_source(source, f * STRIP);
+            present_frame(display, source);
+         }
+         LARGE elapsed = PreciseTime() - start;
+
+         LARGE end_frames, end_areas, end_puts, end_bytes;
+         gfxGetPresentStats(&end_frames, &end_areas, &end_puts, &end_bytes);
+         frames = end_frames - frames;
+         areas  = end_areas - areas;
+         puts   = end_puts - puts;
+         bytes  = end_bytes - bytes;
+
+         print("%d frames, %dx%d tiles, %.2f ms per frame", glFrames, glTile, glTile,
+            DOUBLE(elapsed) / glFrames / 1000.0);
+         print("Areas per frame: %.1f", frames ? DOUBLE(areas) / frames : 0.0);
+         print("Puts per frame:  %.1f", frames ? DOUBLE(puts) / frames : 0.0);
+         print("Bytes per frame: %.0f", frames ? DOUBLE(bytes) / frames : 0.0);
+
+         if (frames != glFrames) {
+            print("Expected %d frames to be counted, got %d.", glFrames, LONG(frames));
+            glFailures++;
+         }
+
+         if (puts >= areas) {
+            print("No areas were merged.");
+            glFailures++;
+         }
+
+         // Nothing outside of the window may be uploaded, even when areas are merged.
+
+         if (bytes > LARGE(frames) * WIDTH * HEIGHT * source->BytesPerPixel) {
+            print("More bytes were uploaded than the window holds.");
+            glFailures++;
+         }
+
+         gfxSync(source);
+         verify_window(display, source);
+
+         acFree(source);
+      }
+      else {
+         print("Failed to create the source bitmap.");
+         glFailures++;
+      }
+
+      acFree(display);
+   }
+   else {
+      print("Failed to create the display.");
+      glFailures++;
+   }
+
+   acFree(module);
+
+   if (glFailures) print("%d failures detected.", glFailures);
+
+   close_parasol();
+   return glFailures ? -1 : 0;
+}
@@ -0,0 +1,587 @@
+/*****************************************************************************
+
+The source code of the Parasol project is made publicly available under the
+terms described in the LICENSE.TXT file that is distributed with this package.
+Please refer to it for further information on licensing.
+
+******************************************************************************
+
+This program checks the span routines that gfxDrawRectangle(), gfxDrawLine(), gfxDrawEllipse() and the Flood method
+use for software drawing.  Random primitives are drawn to 32, 24, 16 and 8 bit bitmaps with solid and translucent
+colours and a random clipping area.  Each result must be bit-identical to a reference image.  Reference images are
+produced by the original per-pixel algorithms, which mark the pixels that they cover before each pixel is blended once.
+The span routines are tested with direct access to the bitmap data and through the per-pixel fallback that video
+bitmaps use.
+
+The throughput of each primitive is reported in Mpixels/s next to that of the per-pixel fallback.
+
+Options: -iterations [n] -seed [n]
+
+*****************************************************************************/
+
+#include <parasol/main.h>
+#include <startup.h>
+#include <parasol/modules/core.h>
+#include <parasol/modules/display.h>
+
+#include <stdio.h>
+#include <string.h>
+#include <utility>
+#include <vector>
+
+static bool is_mem_bitmap(objBitmap *Bitmap)
+{
+   return Bitmap->Type IS BMP_CHUNKY;
+}
+
+#include "../lib_spans.cpp"
+
+CSTRING ProgName      = "Primitives";
+CSTRING ProgAuthor    = "Paul Manias";
+CSTRING ProgDate      = "October 2026";
+CSTRING ProgCopyright = "Paul Manias (c) 2026";
+LONG  ProgDebug = -1;
+FLOAT ProgCoreVersion = 1.0;
+
+extern struct CoreBase *CoreBase;
+static LONG glIterations = 50;
+static ULONG glSeed      = 0x2545f491;
+static LONG glFailures   = 0;
+
+enum { FMT_BGRA=0, FMT_BGR, FMT_565, FMT_555, FMT_PAL, FMT_END };
+enum { PRIM_RECTANGLE=0, PRIM_LINE, PRIM_ELLIPSE, PRIM_FILLED_ELLIPSE, PRIM_FLOOD, PRIM_END };
+
+static const CSTRING glFormatNames[FMT_END] = { "BGRA", "BGR", "565", "555", "8-bit" };
+static const CSTRING glPrimNames[PRIM_END] = { "Rectangle", "Line", "Ellipse", "Filled ellipse", "Flood" };
+
+struct test_bitmap {
+   objBitmap Bitmap;
+   ColourFormat Format;
+   RGBPalette Palette;
+   std::vector<UBYTE> Data;
+
+   test_bitmap(LONG Width, LONG Height, LONG Type);
+   test_bitmap(const test_bitmap &) = delete;
+};
+
+struct primitive {
+   LONG Type;
+   LONG X, Y, Width, Height; // End points for lines, the bounds of rectangles and ellipses, the seed of a flood fill
+};
+
+//****************************************************************************
+
+static ULONG rnd(void)
+{
+   glSeed ^= glSeed << 13;
+   glSeed ^= glSeed >> 17;
+   glSeed ^= glSeed << 5;
+   return glSeed;
+}
+
+//****************************************************************************
+// Per-pixel access, as provided by the display module's pixel routines for each type of bitmap.
+
+static ULONG read_pixel(objBitmap *Bitmap, LONG X, LONG Y)
+{
+   const UBYTE *row = Bitmap->Data + (Y * Bitmap->LineWidth);
+   switch (Bitmap->BytesPerPixel) {
+      case 4:  return ((ULONG *)row)[X];
+      case 3:  return (row[(X * 3) + 2]<<16) | (row[(X * 3) + 1]<<8) | row[X * 3];
+      case 2:  return ((UWORD *)row)[X];
+      default: return row[X];
+   }
+}
+
+static void draw_pixel(objBitmap *Bitmap, LONG X, LONG Y, ULONG Colour)
+{
+   UBYTE *row = Bitmap->Data + (Y * Bitmap->LineWidth);
+   switch (Bitmap->BytesPerPixel) {
+      case 4: ((ULONG *)row)[X] = Colour; break;
+      case 3: row[X * 3] = Colour; row[(X * 3) + 1] = Colour>>8; row[(X * 3) + 2] = Colour>>16; break;
+      case 2: ((UWORD *)row)[X] = Colour; break;
+      default: row[X] = Colour; break;
+   }
+}
+
+static void read_rgb_pixel(objBitmap *Bitmap, LONG X, LONG Y, RGB8 *Pixel)
+{
+   const ULONG colour = read_pixel(Bitmap, X, Y);
+   if (Bitmap->BytesPerPixel IS 1) {
+      *Pixel = Bitmap->Palette->Col[colour];
+      return;
+   }
+
+   Pixel->Red   = UnpackRed(Bitmap, colour);
+   Pixel->Green = UnpackGreen(Bitmap, colour);
+   Pixel->Blue  = UnpackBlue(Bitmap, colour);
+   Pixel->Alpha = 255;
+}
+
+static void draw_rgb_pixel(objBitmap *Bitmap, LONG X, LONG Y, RGB8 *Pixel)
+{
+   draw_pixel(Bitmap, X, Y, (Bitmap->BytesPerPixel IS 4) ?
+      CFPackPixelWBA(Bitmap->ColourFormat, Pixel->Red, Pixel->Green, Pixel->Blue, Pixel->Alpha) :
+      CFPackPixel(Bitmap->ColourFormat, Pixel->Red, Pixel->Green, Pixel->Blue));
+}
+
+//****************************************************************************
+
+static void init_format(ColourFormat &Format, LONG Type)
+{
+   ClearMemory(&Format, sizeof(Format));
+   switch (Type) {
+      case FMT_BGRA:
+      case FMT_BGR:
+         Format.RedPos   = 16;
+         Format.GreenPos = 8;
+         Format.BluePos  = 0;
+         Format.AlphaPos = 24;
+         Format.RedMask = Format.GreenMask = Format.BlueMask = 0xff;
+         Format.AlphaMask = (Type IS FMT_BGRA) ? 0xff : 0;
+         Format.BitsPerPixel = (Type IS FMT_BGRA) ? 32 : 24;
+         break;
+
+      case FMT_565:
+      case FMT_555:
+         Format.RedShift   = 3;
+         Format.GreenShift = (Type IS FMT_565) ? 2 : 3;
+         Format.BlueShift  = 3;
+         Format.RedMask    = 0x1f;
+         Format.GreenMask  = (Type IS FMT_565) ? 0x3f : 0x1f;
+         Format.BlueMask   = 0x1f;
+         Format.RedPos     = (Type IS FMT_565) ? 11 : 10;
+         Format.GreenPos   = 5;
+         Format.BluePos    = 0;
+         Format.BitsPerPixel = (Type IS FMT_565) ? 16 : 15;
+         break;
+
+      case FMT_PAL:
+         Format.RedMask = Format.GreenMask = Format.BlueMask = 0xff;
+         Format.BitsPerPixel = 8;
+         break;
+   }
+}
+
+test_bitmap::test_bitmap(LONG Width, LONG Height, LONG Type)
+{
+   ClearMemory(&Bitmap, sizeof(Bitmap));
+   ClearMemory(&Palette, sizeof(Palette));
+   init_format(Format, Type);
+
+   Palette.AmtColours = 256;
+   for (LONG i=0; i < 256; i++) {
+      Palette.Col[i].Red   = i;
+      Palette.Col[i].Green = 255 - i;
+      Palette.Col[i].Blue  = i ^ 0x55;
+      Palette.Col[i].Alpha = 255;
+   }
+
+   Bitmap.Width         = Width;
+   Bitmap.Height        = Height;
+   Bitmap.BitsPerPixel  = Format.BitsPerPixel;
+   Bitmap.BytesPerPixel = (Format.BitsPerPixel + 7) / 8;
+   Bitmap.LineWidth     = ((Width * Bitmap.BytesPerPixel) + 3) & ~3;
+   Bitmap.Type          = BMP_CHUNKY;
+   Bitmap.ColourFormat  = &Format;
+   Bitmap.Palette       = &Palette;
+   Bitmap.DrawUCPixel   = draw_pixel;
+   Bitmap.ReadUCPixel   = read_pixel;
+   Bitmap.DrawUCRPixel  = draw_rgb_pixel;
+   Bitmap.ReadUCRPixel  = read_rgb_pixel;
+
+   Data.resize(Bitmap.LineWidth * Height);
+   Bitmap.Data = Data.data();
+}
+
+static ULONG random_colour(objBitmap *Bitmap)
+{
+   switch (Bitmap->BytesPerPixel) {
+      case 4:  return rnd() | 0xff000000;
+      case 3:  return rnd() & 0xffffff;
+      case 2:  return rnd() & ((Bitmap->BitsPerPixel IS 15) ? 0x7fff : 0xffff);
+      default: return rnd() & 0xff;
+   }
+}
+
+// Noise is used for most primitives.  Flood fills need connected areas, so a few colours are scattered instead.
+
+static void fill_bitmap(test_bitmap &Bitmap, const ULONG *Colours, LONG Total)
+{
+   objBitmap *bmp = &Bitmap.Bitmap;
+   for (LONG y=0; y < bmp->Height; y++) {
+      for (LONG x=0; x < bmp->Width; x++) {
+         if (Total > 1) draw_pixel(bmp, x, y, Colours[(rnd() % 8) < 6 ? 0 : (1 + (rnd() % (Total - 1)))]);
+         else if (Total) draw_pixel(bmp, x, y, Colours[0]);
+         else draw_pixel(bmp, x, y, random_colour(bmp));
+      }
+   }
+}
+
+//****************************************************************************
+// The original per-pixel algorithms.  Each marks the pixels that it covers in Mask, ignoring the clipping area.
+
+static void reference_geometry(const primitive &Prim, objBitmap *Bitmap, const ClipRectangle &Clip,
+   std::vector<UBYTE> &Mask)
+{
+   const LONG width = Bitmap->Width, height = Bitmap->Height;
+   auto mark = [&](LONG X, LONG Y) {
+      if ((X >= 0) and (Y >= 0) and (X < width) and (Y < height)) Mask[(Y * width) + X] = 1;
+   };
+
+   switch (Prim.Type) {
+      case PRIM_RECTANGLE:
+         for (LONG y=Prim.Y; y < Prim.Y + Prim.Height; y++) {
+            for (LONG x=Prim.X; x < Prim.X + Prim.Width; x++) mark(x, y);
+         }
+         break;
+
+      case PRIM_LINE: {
+         LONG drawx = Prim.X, drawy = Prim.Y;
+         const LONG dx = Prim.Width - Prim.X, dy = Prim.Height - Prim.Y;
+         const LONG x_inc = (dx < 0) ? -1 : 1, y_inc = (dy < 0) ? -1 : 1;
+         const LONG l = (dx < 0) ? -dx : dx, m = (dy < 0) ? -dy : dy;
+         const LONG dx2 = l<<1, dy2 = m<<1;
+         if (l >= m) {
+            LONG err_1 = dy2 - l;
+            for (LONG i=0; i < l; i++) {
+               mark(drawx, drawy);
+               if (err_1 > 0) { drawy += y_inc; err_1 -= dx2; }
+               err_1 += dy2;
+               drawx += x_inc;
+            }
+         }
+         else {
+            LONG err_1 = dx2 - m;
+            for (LONG i=0; i < m; i++) {
+               mark(drawx, drawy);
+               if (err_1 > 0) { drawx += x_inc; err_1 -= dy2; }
+               err_1 += dx2;
+               drawy += y_inc;
+            }
+         }
+         mark(drawx, drawy);
+         break;
+      }
+
+      case PRIM_ELLIPSE:
+      case PRIM_FILLED_ELLIPSE: {
+         LONG rx = Prim.Width>>1, ry = Prim.Height>>1;
+         const LONG cx = Prim.X + rx, cy = Prim.Y + ry;
+         if (rx < 1) rx = 1;
+         if (ry < 1) ry = 1;
+
+         auto plot = [&](LONG X, LONG Y) {
+            if (Prim.Type IS PRIM_ELLIPSE) {
+               mark(cx + X, cy + Y); mark(cx + X, cy - Y);
+               mark(cx - X, cy + Y); mark(cx - X, cy - Y);
+            }
+            else for (LONG x=-X; x <= X; x++) { mark(cx + x, cy + Y); mark(cx + x, cy - Y); }
+         };
+
+         LONG t1 = rx * rx, t2 = t1<<1, t3 = t2<<1;
+         LONG t4 = ry * ry, t5 = t4<<1, t6 = t5<<1;
+         LONG t7 = rx * t5, t8 = t7<<1, t9 = 0;
+         LONG d1 = t2 - t7 + (t4>>1);
+         LONG d2 = (t1>>1) - t8 + t5;
+         LONG x = rx, y = 0;
+
+         while (d2 < 0) {
+            plot(x, y);
+            y++;
+            t9 += t3;
+            if (d1 < 0) { d1 += t9 + t2; d2 += t9; }
+            else {
+               x--;
+               t8 -= t6;
+               d1 += t9 + t2 - t8;
+               d2 += t9 + t5 - t8;
+            }
+         }
+
+         do {
+            plot(x, y);
+            x--;
+            t8 -= t6;
+            if (d2 < 0) {
+               y++;
+               t9 += t3;
+               d2 += t9 + t5 - t8;
+            }
+            else d2 += t5 - t8;
+         } while (x >= 0);
+         break;
+      }
+
+      case PRIM_FLOOD: {
+         const ULONG background = read_pixel(Bitmap, Prim.X, Prim.Y);
+         std::vector<std::pair<LONG, LONG>> stack = { { Prim.X, Prim.Y } };
+         while (!stack.empty()) {
+            const auto [ x, y ] = stack.back();
+            stack.pop_back();
+            if ((x < Clip.Left) or (x >= Clip.Right) or (y < Clip.Top) or (y >= Clip.Bottom)) continue;
+            if ((Mask[(y * width) + x]) or (read_pixel(Bitmap, x, y) != background)) continue;
+            Mask[(y * width) + x] = 1;
+            stack.insert(stack.end(), { { x - 1, y }, { x + 1, y }, { x, y - 1 }, { x, y + 1 } });
+         }
+         break;
+      }
+   }
+}
+
+static void reference_draw(const primitive &Prim, objBitmap *Bitmap, const ClipRectangle &Clip, ULONG Colour,
+   UBYTE Opacity)
+{
+   std::vector<UBYTE> mask(Bitmap->Width * Bitmap->Height, 0);
+   reference_geometry(Prim, Bitmap, Clip, mask);
+
+   RGB8 rgb;
+   rgb.Red   = UnpackRed(Bitmap, Colour);
+   rgb.Green = UnpackGreen(Bitmap, Colour);
+   rgb.Blue  = UnpackBlue(Bitmap, Colour);
+
+   for (LONG y=Clip.Top; y < Clip.Bottom; y++) {
+      for (LONG x=Clip.Left; x < Clip.Right; x++) {
+         if (!mask[(y * Bitmap->Width) + x]) continue;
+         if (Opacity < 255) {
+            RGB8 pixel;
+            read_rgb_pixel(Bitmap, x, y, &pixel);
+            pixel.Red   = (((rgb.Red   - pixel.Red)   * Opacity)>>8) + pixel.Red;
+            pixel.Green = (((rgb.Green - pixel.Green) * Opacity)>>8) + pixel.Green;
+            pixel.Blue  = (((rgb.Blue  - pixel.Blue)  * Opacity)>>8) + pixel.Blue;
+            pixel.Alpha = 255;
+            draw_rgb_pixel(Bitmap, x, y, &pixel);
+         }
+         else draw_pixel(Bitmap, x, y, Colour);
+      }
+   }
+}
+
+//****************************************************************************
+// Draws a primitive with the span routines, in the same way as the display module.
+
+static LARGE span_draw(const primitive &Prim, objBitmap *Bitmap, const ClipRectangle &Clip, span_colour &Span)
+{
+   LARGE pixels = 0;
+   auto span = [&](LONG X, LONG Y, LONG Width) {
+      fill_clipped_span(Bitmap, Span, Clip, X, Y, Width);
+      pixels += Width;
+   };
+
+   switch (Prim.Type) {
+      case PRIM_RECTANGLE: {
+         LONG x = Prim.X, y = Prim.Y, width = Prim.Width, height = Prim.Height;
+         if (x < Clip.Left) { width -= Clip.Left - x; x = Clip.Left; }
+         if (y < Clip.Top) { height -= Clip.Top - y; y = Clip.Top; }
+         if (x + width > Clip.Right) width = Clip.Right - x;
+         if (y + height > Clip.Bottom) height = Clip.Bottom - y;
+         if (width > 0) {
+            for (; height > 0; height--, y++, pixels += width) fill_span(Bitmap, Span, x, y, width);
+         }
+         break;
+      }
+
+      case PRIM_LINE:
+         line_spans(Prim.X, Prim.Y, Prim.Width, Prim.Height, span);
+         break;
+
+      case PRIM_ELLIPSE:
+      case PRIM_FILLED_ELLIPSE: {
+         LONG rx = Prim.Width>>1, ry = Prim.Height>>1;
+         const LONG cx = Prim.X + rx, cy = Prim.Y + ry;
+         if (rx < 1) rx = 1;
+         if (ry < 1) ry = 1;
+         ellipse_spans(rx, ry, Prim.Type IS PRIM_FILLED_ELLIPSE, [&](LONG X, LONG Y, LONG Width) {
+            span(cx + X, cy + Y, Width);
+         });
+         break;
+      }
+
+      case PRIM_FLOOD:
+         flood_spans(Bitmap, Span, Prim.X, Prim.Y, Clip);
+         pixels = Bitmap->Width * Bitmap->Height;
+         break;
+   }
+
+   return pixels;
+}
+
+//****************************************************************************
+
+static void random_primitive(primitive &Prim, LONG Type, LONG Width, LONG Height)
+{
+   Prim.Type = Type;
+   if (Type IS PRIM_LINE) {
+      Prim.X      = LONG(rnd() % (Width + 20)) - 10;
+      Prim.Y      = LONG(rnd() % (Height + 20)) - 10;
+      Prim.Width  = LONG(rnd() % (Width + 20)) - 10;
+      Prim.Height = LONG(rnd() % (Height + 20)) - 10;
+      if (!(rnd() & 7)) Prim.Height = Prim.Y; // Horizontal and vertical lines are common
+      else if (!(rnd() & 7)) Prim.Width = Prim.X;
+   }
+   else {
+      Prim.X      = LONG(rnd() % (Width + 10)) - 20;
+      Prim.Y      = LONG(rnd() % (Height + 10)) - 20;
+      Prim.Width  = 1 + (rnd() % (Width + 10));
+      Prim.Height = 1 + (rnd() % (Height + 10));
+   }
+}
+
+static bool compare(test_bitmap &Result, test_bitmap &Expected, CSTRING Name)
+{
+   objBitmap *bmp = &Result.Bitmap;
+   for (LONG y=0; y < bmp->Height; y++) {
+      for (LONG x=0; x < bmp->Width; x++) {
+         const ULONG result = read_pixel(bmp, x, y), expected = read_pixel(&Expected.Bitmap, x, y);
+         if (result != expected) {
+            print("%s: pixel %d,%d is $%.8x, expected $%.8x", Name, x, y, result, expected);
+            return false;
+         }
+      }
+   }
+   return true;
+}
+
+static void test_reference(void)
+{
+   LONG mismatches = 0, total = 0;
+   for (LONG i=0; i < glIterations; i++) {
+      for (LONG format=0; format < FMT_END; format++) {
+         for (LONG type=0; type < PRIM_END; type++) {
+            for (LONG blend=0; blend < 2; blend++) {
+               if ((blend) and ((type IS PRIM_FLOOD) or (format IS FMT_PAL))) continue; // Not supported
+
+               const LONG width = 1 + (rnd() % 90), height = 1 + (rnd() % 60);
+               test_bitmap expected(width, height, format), direct(width, height, format), fallback(width, height, format);
+
+               ULONG colours[4];
+               for (auto &c : colours) c = random_colour(&expected.Bitmap);
+               const ULONG saved = glSeed;
+               fill_bitmap(expected, colours, (type IS PRIM_FLOOD) ? 3 : 0);
+               glSeed = saved;
+               fill_bitmap(direct, colours, (type IS PRIM_FLOOD) ? 3 : 0);
+               glSeed = saved;
+               fill_bitmap(fallback, colours, (type IS PRIM_FLOOD) ? 3 : 0);
+
+               ClipRectangle clip;
+               clip.Left   = rnd() % (width>>1 ? width>>1 : 1);
+               clip.Top    = rnd() % (height>>1 ? height>>1 : 1);
+               clip.Right  = width - (rnd() % (width>>2 ? width>>2 : 1));
+               clip.Bottom = height - (rnd() % (height>>2 ? height>>2 : 1));
+
+               primitive prim;
+               random_primitive(prim, type, width, height);
+               ULONG colour = colours[3];
+               if (type IS PRIM_FLOOD) {
+                  prim.X = clip.Left + (rnd() % (clip.Right - clip.Left));
+                  prim.Y = clip.Top + (rnd() % (clip.Bottom - clip.Top));
+                  if (read_pixel(&expected.Bitmap, prim.X, prim.Y) IS colour) continue; // Flood() ignores this case
+               }
+
+               const UBYTE opacity = blend ? 1 + (rnd() % 254) : 255;
+               reference_draw(prim, &expected.Bitmap, clip, colour, opacity);
+
+               span_colour span;
+               init_span_colour(span, &direct.Bitmap, colour, opacity);
+               span_draw(prim, &direct.Bitmap, clip, span);
+               span.Direct = false;
+               span_draw(prim, &fallback.Bitmap, clip, span);
+
+               char name[80];
+               snprintf(name, sizeof(name), "%s %s %s", glFormatNames[format], glPrimNames[type], blend ? "blended" : "solid");
+               if (!compare(direct, expected, name)) mismatches++;
+               if (!compare(fallback, expected, name)) mismatches++;
+               total += 2;
+            }
+         }
+      }
+   }
+
+   print("Reference images: %d tested, %d mismatches", total, mismatches);
+   if (mismatches) glFailures++;
+}
+
+//****************************************************************************
+
+static void benchmark(void)
+{
+   const LONG width = 1024, height = 768;
+   test_bitmap bitmap(width, height, FMT_BGRA);
+   ClipRectangle clip;
+   clip.Left   = 0;
+   clip.Top    = 0;
+   clip.Right  = width;
+   clip.Bottom = height;
+
+   std::vector<primitive> lines(2000);
+   for (auto &line : lines) random_primitive(line, PRIM_LINE, width, height);
+
+   for (LONG type=0; type < PRIM_END; type++) {
+      for (LONG blend=0; blend < 2; blend++) {
+         if ((blend) and (type IS PRIM_FLOOD)) continue;
+
+         DOUBLE rate[2];
+         for (LONG direct=0; direct < 2; direct++) {
+            ULONG colours[2] = { 0xff102030, 0xff405060 };
+            fill_bitmap(bitmap, colours, 1);
+
+            const LONG repeat = (type IS PRIM_LINE) ? 1 : 10;
+            LARGE pixels = 0;
+            LARGE start = PreciseTime();
+            for (LONG r=0; r < repeat; r++) {
+               span_colour span;
+               init_span_colour(span, &bitmap.Bitmap, colours[(r & 1) ^ 1], blend ? 128 : 255);
+               span.Direct = direct;
+               if (type IS PRIM_LINE) {
+                  for (auto &line : lines) pixels += span_draw(line, &bitmap.Bitmap, clip, span);
+               }
+               else {
+                  primitive prim = { type, 0, 0, width, height };
+                  if (type IS PRIM_FLOOD) prim.Width = prim.Height = 0;
+                  pixels += span_draw(prim, &bitmap.Bitmap, clip, span);
+               }
+            }
+            LARGE elapsed = PreciseTime() - start;
+            rate[direct] = DOUBLE(pixels) / DOUBLE(elapsed ? elapsed : 1);
+         }
+
+         print("%-15s %-8s %8.1f Mpixels/s (per-pixel: %.1f Mpixels/s)", glPrimNames[type],
+            blend ? "blended" : "solid", rate[1], rate[0]);
+      }
+   }
+}
+
+//****************************************************************************
+
+int main(int argc, CSTRING *argv)
+{
+   const char *msg = init_parasol(argc, argv);
+   if (msg) {
+      print(msg);
+      return -1;
+   }
+
+   CSTRING *args;
+   if ((!GetPointer(CurrentTask(), FID_Parameters, &args)) and (args)) {
+      for (LONG i=0; args[i]; i++) {
+         if (!StrMatch(args[i], "-iterations")) {
+            if (args[++i]) glIterations = StrToInt(args[i]);
+            else break;
+         }
+         else if (!StrMatch(args[i], "-seed")) {
+            if (args[++i]) glSeed = StrToInt(args[i]);
+            else break;
+         }
+      }
+   }
+
+   if (!glSeed) glSeed = 1;
+
+   test_reference();
+   benchmark();
+
+   if (glFailures) print("%d failures detected.", glFailures);
+
+   close_parasol();
+   return glFailures ? -1 : 0;
+}
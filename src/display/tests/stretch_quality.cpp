@@ -0,0 +1,296 @@
+/*****************************************************************************
+
+The source code of the Parasol project is made publicly available under the
+terms described in the LICENSE.TXT file that is distributed with this package.
+Please refer to it for further information on licensing.
+
+******************************************************************************
+
+This program measures the quality and throughput of each resampling mode of gfxCopyStretch().  The source image is
+sampled from a function with a zone plate in the red channel, fine stripes in the green channel and a smooth gradient
+in the blue channel.  Every mode stretches it to a set of reductions and enlargements.  The result is compared to a
+reference computed from the same function, which is averaged over the area of each output pixel.  Aliasing and
+blurring both lower the PSNR that is reported.
+
+The source and its clipping region are recreated for every run, as CSTF_FILTER_SOURCE modifies them for the older
+modes.  The CUBIC, LANCZOS and AREA filters must leave the source unmodified.  The edges of an opaque source with an
+alpha channel must fade out with the CUBIC and LANCZOS filters unless CSTF_CLAMP is used.
+
+Options: -iterations [n] -size [WxH]
+
+*****************************************************************************/
+
+#include <parasol/main.h>
+#include <startup.h>
+#include <parasol/modules/core.h>
+#include <parasol/modules/display.h>
+
+#include <math.h>
+#include <stdio.h>
+
+CSTRING ProgName      = "StretchQuality";
+CSTRING ProgAuthor    = "Paul Manias";
+CSTRING ProgDate      = "October 2026";
+CSTRING ProgCopyright = "Paul Manias (c) 2026";
+LONG  ProgDebug = -1;
+FLOAT ProgCoreVersion = 1.0;
+
+extern struct CoreBase *CoreBase;
+static struct DisplayBase *DisplayBase;
+static LONG glIterations = 3;
+static LONG glSrcWidth   = 2400;
+static LONG glSrcHeight  = 1800;
+static LONG glFailures   = 0;
+
+struct Mode {
+   CSTRING Name;
+   LONG Flags;
+};
+
+static const Mode glModes[] = {
+   { "NEIGHBOUR",             CSTF_NEIGHBOUR },
+   { "BRESENHAM",             CSTF_BRESENHAM },
+   { "BILINEAR",              CSTF_BILINEAR },
+   { "BILINEAR+FILTER",       CSTF_BILINEAR|CSTF_FILTER_SOURCE },
+   { "CUBIC",                 CSTF_CUBIC },
+   { "LANCZOS",               CSTF_LANCZOS },
+   { "LANCZOS+FILTER",        CSTF_LANCZOS|CSTF_FILTER_SOURCE },
+   { "AREA",                  CSTF_AREA },
+   { "AREA+FILTER",           CSTF_AREA|CSTF_FILTER_SOURCE }
+};
+
+// Output sizes as a fraction of the source size.
+
+static const DOUBLE glScales[] = { 0.05, 0.125, 0.3, 0.7, 1.6 };
+
+#define SUPERSAMPLE 4
+
+//****************************************************************************
+// The test image.  U and V are normalised coordinates and the result is a channel value between 0 and 1.
+
+static DOUBLE image_fn(LONG Channel, DOUBLE U, DOUBLE V)
+{
+   switch (Channel) {
+      case 0: { // Zone plate
+         const DOUBLE dx = U - 0.5, dy = V - 0.5;
+         return 0.5 + 0.5 * cos(600.0 * (dx * dx + dy * dy));
+      }
+      case 1:  return 0.5 + 0.5 * sin(U * 2.0 * 3.141592653589793 * 40.0); // Stripes
+      default: return 0.25 + 0.5 * U * V; // Gradient
+   }
+}
+
+static objBitmap * create_bitmap(LONG Width, LONG Height)
+{
+   objBitmap *bitmap;
+   if (!CreateObject(ID_BITMAP, 0, &bitmap,
+         FID_Width|TLONG,        Width,
+         FID_Height|TLONG,       Height,
+         FID_BitsPerPixel|TLONG, 32,
+         TAGEND)) return bitmap;
+   else return NULL;
+}
+
+static void fill_source(objBitmap *Bitmap)
+{
+   // CSTF_FILTER_SOURCE also reduces the clipping region of the source for the older modes.
+
+   Bitmap->Clip.Left   = 0;
+   Bitmap->Clip.Top    = 0;
+   Bitmap->Clip.Right  = Bitmap->Width;
+   Bitmap->Clip.Bottom = Bitmap->Height;
+
+   for (LONG y=0; y < Bitmap->Height; y++) {
+      ULONG *row = (ULONG *)(Bitmap->Data + (y * Bitmap->LineWidth));
+      for (LONG x=0; x < Bitmap->Width; x++) {
+         const DOUBLE u = (x + 0.5) / Bitmap->Width, v = (y + 0.5) / Bitmap->Height;
+         row[x] = PackPixelWBA(Bitmap, F2T(image_fn(0, u, v) * 255.0 + 0.5), F2T(image_fn(1, u, v) * 255.0 + 0.5),
+            F2T(image_fn(2, u, v) * 255.0 + 0.5), 255);
+      }
+   }
+}
+
+static ULONG checksum(objBitmap *Bitmap)
+{
+   ULONG hash = 2166136261;
+   for (LONG y=0; y < Bitmap->Height; y++) {
+      const UBYTE *row = Bitmap->Data + (y * Bitmap->LineWidth);
+      for (LONG x=0; x < Bitmap->Width * 4; x++) hash = (hash ^ row[x]) * 16777619;
+   }
+   return hash;
+}
+
+//****************************************************************************
+// Computes the PSNR of the RGB channels against the area average of the test image.  For enlargements the reference
+// is limited by the source resolution, so the function is averaged over the footprint of a source pixel instead.
+
+static DOUBLE measure_psnr(objBitmap *Bitmap)
+{
+   const DOUBLE fw = (Bitmap->Width < glSrcWidth) ? Bitmap->Width : glSrcWidth;
+   const DOUBLE fh = (Bitmap->Height < glSrcHeight) ? Bitmap->Height : glSrcHeight;
+   DOUBLE error = 0;
+
+   for (LONG y=0; y < Bitmap->Height; y++) {
+      const ULONG *row = (const ULONG *)(Bitmap->Data + (y * Bitmap->LineWidth));
+      for (LONG x=0; x < Bitmap->Width; x++) {
+         const DOUBLE cu = (x + 0.5) / Bitmap->Width, cv = (y + 0.5) / Bitmap->Height;
+         DOUBLE ref[3] = { 0, 0, 0 };
+         for (LONG j=0; j < SUPERSAMPLE; j++) {
+            for (LONG i=0; i < SUPERSAMPLE; i++) {
+               const DOUBLE u = cu + (((i + 0.5) / SUPERSAMPLE) - 0.5) / fw;
+               const DOUBLE v = cv + (((j + 0.5) / SUPERSAMPLE) - 0.5) / fh;
+               for (LONG c=0; c < 3; c++) ref[c] += image_fn(c, u, v);
+            }
+         }
+
+         const DOUBLE n = SUPERSAMPLE * SUPERSAMPLE;
+         const DOUBLE r = UnpackRed(Bitmap, row[x]) - ref[0] * 255.0 / n;
+         const DOUBLE g = UnpackGreen(Bitmap, row[x]) - ref[1] * 255.0 / n;
+         const DOUBLE b = UnpackBlue(Bitmap, row[x]) - ref[2] * 255.0 / n;
+         error += (r * r) + (g * g) + (b * b);
+      }
+   }
+
+   const DOUBLE mse = error / (DOUBLE(Bitmap->Width) * DOUBLE(Bitmap->Height) * 3.0);
+   return (mse > 0) ? 10.0 * log10((255.0 * 255.0) / mse) : 99.0;
+}
+
+//****************************************************************************
+
+static void run_mode(const Mode &Mode, objBitmap *Source, DOUBLE Scale, ULONG SourceSum)
+{
+   const LONG width = F2T(glSrcWidth * Scale), height = F2T(glSrcHeight * Scale);
+   objBitmap *dest;
+   if (!(dest = create_bitmap(width, height))) {
+      print("Failed to create a %dx%d bitmap.", width, height);
+      glFailures++;
+      return;
+   }
+
+   LARGE elapsed = 0, best = 0x7fffffffffffffffLL;
+   for (LONG i=0; i < glIterations; i++) {
+      if (Mode.Flags & CSTF_FILTER_SOURCE) fill_source(Source);
+
+      LARGE start = PreciseTime();
+      gfxCopyStretch(Source, dest, Mode.Flags, 0, 0, glSrcWidth, glSrcHeight, 0, 0, width, height);
+      LARGE time = PreciseTime() - start;
+      elapsed += time;
+      if (time < best) best = time;
+   }
+
+   const bool modified = checksum(Source) != SourceSum;
+   if ((modified) and (Mode.Flags & (CSTF_CUBIC|CSTF_LANCZOS|CSTF_AREA))) {
+      print("%s modified the source bitmap.", Mode.Name);
+      glFailures++;
+   }
+
+   print("%-16s %4dx%-4d  PSNR %6.2f dB  %8.2f ms  %8.1f Mpixels/s", Mode.Name, width, height, measure_psnr(dest),
+      DOUBLE(elapsed) / glIterations / 1000.0, (DOUBLE(glSrcWidth) * DOUBLE(glSrcHeight)) / DOUBLE(best ? best : 1));
+
+   if (modified) fill_source(Source);
+   acFree(dest);
+}
+
+//****************************************************************************
+// Past the edges of the source, the filter taps are transparent unless CSTF_CLAMP is set.
+
+static void check_edges(void)
+{
+   objBitmap *source, *dest;
+   if (CreateObject(ID_BITMAP, 0, &source,
+         FID_Width|TLONG,        64,
+         FID_Height|TLONG,       64,
+         FID_BitsPerPixel|TLONG, 32,
+         FID_Flags|TLONG,        BMF_ALPHA_CHANNEL,
+         TAGEND)) { glFailures++; return; }
+
+   if (CreateObject(ID_BITMAP, 0, &dest,
+         FID_Width|TLONG,        16,
+         FID_Height|TLONG,       16,
+         FID_BitsPerPixel|TLONG, 32,
+         FID_Flags|TLONG,        BMF_ALPHA_CHANNEL,
+         TAGEND)) { acFree(source); glFailures++; return; }
+
+   gfxDrawRectangle(source, 0, 0, 64, 64, PackPixelWBA(source, 200, 100, 50, 255), BAF_FILL);
+
+   for (auto filter : { CSTF_CUBIC, CSTF_LANCZOS }) {
+      for (auto clamp : { 0, CSTF_CLAMP }) {
+         gfxCopyStretch(source, dest, filter|clamp, 0, 0, 64, 64, 0, 0, 16, 16);
+         const UBYTE corner = UnpackAlpha(dest, ((ULONG *)dest->Data)[0]);
+         const UBYTE centre = UnpackAlpha(dest, ((ULONG *)(dest->Data + (8 * dest->LineWidth)))[8]);
+         if ((centre != 255) or ((clamp) and (corner != 255)) or ((!clamp) and (corner IS 255))) {
+            print("Edge alpha of filter $%.8x is wrong: corner %d, centre %d", filter|clamp, corner, centre);
+            glFailures++;
+         }
+      }
+   }
+
+   acFree(dest);
+   acFree(source);
+}
+
+//****************************************************************************
+
+int main(int argc, CSTRING *argv)
+{
+   const char *msg = init_parasol(argc, argv);
+   if (msg) {
+      print(msg);
+      return -1;
+   }
+
+   CSTRING *args;
+   if ((!GetPointer(CurrentTask(), FID_Parameters, &args)) and (args)) {
+      for (LONG i=0; args[i]; i++) {
+         if (!StrMatch(args[i], "-iterations")) {
+            if (args[++i]) glIterations = StrToInt(args[i]);
+            else break;
+         }
+         else if (!StrMatch(args[i], "-size")) {
+            if (args[++i]) {
+               if ((sscanf(args[i], "%dx%d", &glSrcWidth, &glSrcHeight) != 2) or (glSrcWidth < 16) or (glSrcHeight < 16)) {
+                  print("Invalid size '%s'", args[i]);
+                  glSrcWidth = 2400;
+                  glSrcHeight = 1800;
+               }
+            }
+            else break;
+         }
+      }
+   }
+
+   if (glIterations < 1) glIterations = 1;
+
+   OBJECTPTR module;
+   if (LoadModule("display", MODVERSION_DISPLAY, &module, &DisplayBase)) {
+      print("Failed to load the display module.");
+      close_parasol();
+      return -1;
+   }
+
+   check_edges();
+
+   objBitmap *source;
+   if ((source = create_bitmap(glSrcWidth, glSrcHeight))) {
+      fill_source(source);
+      const ULONG source_sum = checksum(source);
+
+      print("Source: %dx%d, %d iterations", glSrcWidth, glSrcHeight, glIterations);
+      for (auto scale : glScales) {
+         for (auto &mode : glModes) run_mode(mode, source, scale, source_sum);
+      }
+
+      acFree(source);
+   }
+   else {
+      print("Failed to create the source bitmap.");
+      glFailures++;
+   }
+
+   acFree(module);
+
+   if (glFailures) print("%d failures detected.", glFailures);
+
+   close_parasol();
+   return glFailures ? -1 : 0;
+}
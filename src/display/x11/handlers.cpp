@@ -92,6 +92,10 @@ static void X11ManagerLoop(HOSTHANDLE FD, APTR Data)
                }
             }
             break;
+
+         default:
+            if (xevent.type IS glShmCompletion) shm_completed((XShmCompletionEvent *)&xevent);
+            break;
       }
 
       if ((XRandRBase) AND (xrNotify(&xevent))) {
@@ -122,6 +126,8 @@ static void X11ManagerLoop(HOSTHANDLE FD, APTR Data)
       }
    }
 
+   flush_damage(); // Send any damage that was not followed by a Flush of the display
+
    XFlush(XDisplay);
    if (XDisplay) XSync(XDisplay, False);
 }
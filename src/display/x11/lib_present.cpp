@@ -0,0 +1,231 @@
+/*****************************************************************************
+
+Batched presentation of client bitmaps to X11 windows.
+
+CopyArea() does not send client bitmaps to a window immediately.  The areas that are copied are collected as damage
+rectangles for the current frame.  Rectangles that overlap or are close to each other are merged, provided that the
+merged area does not upload too many pixels that were not damaged.  The batch is sent when the frame ends, which is
+signalled by the Flush action of the Display, or earlier if a different source is presented or the window is drawn
+to by other means.
+
+XShm images are put with completion events enabled.  The X server reads the shared memory asynchronously, so
+sync_shm_image() must wait for the outstanding puts of a bitmap before its pixels are modified again.  LockSurface(),
+the Lock action and Sync() do this.
+
+*****************************************************************************/
+
+#include <unordered_map>
+
+#define MAX_DAMAGE         32    // Maximum number of rectangles in a batch
+#define DAMAGE_MERGE_WASTE 4096  // Undamaged pixels that may be uploaded to save a put, in addition to 1/4 of the area
+
+struct damage_batch {
+   objBitmap *Source;
+   Drawable Target;
+   LONG OffsetX, OffsetY;  // Source coordinates minus target coordinates
+   LONG Total;
+   ClipRectangle Rects[MAX_DAMAGE]; // Target coordinates
+};
+
+static damage_batch glDamage;
+static std::unordered_map<ShmSeg, LONG> glShmPending; // Outstanding XShmPutImage() requests for each segment
+static LONG glShmCompletion = -1; // Event type of XShmCompletionEvent
+static LARGE glPresentFrames = 0, glPresentRects = 0, glPresentPuts = 0, glPresentBytes = 0;
+static bool glPresentActive = false; // True if something has been presented since the last frame
+
+//****************************************************************************
+
+INLINE LARGE rect_area(const ClipRectangle &Rect)
+{
+   return LARGE(Rect.Right - Rect.Left) * LARGE(Rect.Bottom - Rect.Top);
+}
+
+// Returns the number of pixels that would be uploaded without being damaged if A and B were merged.
+
+static LARGE merge_waste(const ClipRectangle &A, const ClipRectangle &B, ClipRectangle &Union)
+{
+   Union.Left   = (A.Left < B.Left) ? A.Left : B.Left;
+   Union.Top    = (A.Top < B.Top) ? A.Top : B.Top;
+   Union.Right  = (A.Right > B.Right) ? A.Right : B.Right;
+   Union.Bottom = (A.Bottom > B.Bottom) ? A.Bottom : B.Bottom;
+
+   LARGE covered = rect_area(A) + rect_area(B);
+   const LONG ol = (A.Left > B.Left) ? A.Left : B.Left, or_ = (A.Right < B.Right) ? A.Right : B.Right;
+   const LONG ot = (A.Top > B.Top) ? A.Top : B.Top, ob = (A.Bottom < B.Bottom) ? A.Bottom : B.Bottom;
+   if ((ol < or_) and (ot < ob)) covered -= LARGE(or_ - ol) * LARGE(ob - ot);
+
+   return rect_area(Union) - covered;
+}
+
+//****************************************************************************
+// Adds a rectangle to the batch, merging it with existing rectangles where that is cheaper than a separate put.
+
+static void add_damage(ClipRectangle Rect)
+{
+   glPresentRects++;
+
+   for (bool merged=true; merged; ) {
+      merged = false;
+      for (LONG i=0; i < glDamage.Total; i++) {
+         ClipRectangle merge;
+         const LARGE waste = merge_waste(glDamage.Rects[i], Rect, merge);
+         if (waste <= DAMAGE_MERGE_WASTE + ((rect_area(merge) - waste)>>2)) {
+            Rect = merge;
+            glDamage.Rects[i] = glDamage.Rects[--glDamage.Total];
+            merged = true;
+            break;
+         }
+      }
+   }
+
+   if (glDamage.Total >= MAX_DAMAGE) { // The batch is full, so merge with the rectangle that wastes the least
+      LONG best = 0;
+      LARGE best_waste = 0x7fffffffffffffffLL;
+      ClipRectangle best_merge;
+      for (LONG i=0; i < glDamage.Total; i++) {
+         ClipRectangle merge;
+         const LARGE waste = merge_waste(glDamage.Rects[i], Rect, merge);
+         if (waste < best_waste) { best = i; best_waste = waste; best_merge = merge; }
+      }
+      glDamage.Rects[best] = best_merge;
+      return;
+   }
+
+   glDamage.Rects[glDamage.Total++] = Rect;
+}
+
+//****************************************************************************
+// Sends the current batch to the X server.
+
+static void flush_damage(void)
+{
+   if (!glDamage.Total) return;
+
+   objBitmap *src = glDamage.Source;
+   for (LONG i=0; i < glDamage.Total; i++) {
+      const ClipRectangle &r = glDamage.Rects[i];
+      const LONG width = r.Right - r.Left, height = r.Bottom - r.Top;
+
+      if (src->x11.XShmImage IS TRUE) {
+         if (XShmPutImage(XDisplay, glDamage.Target, glXGC, &src->x11.ximage, r.Left + glDamage.OffsetX,
+               r.Top + glDamage.OffsetY, r.Left, r.Top, width, height, glShmCompletion != -1)) {
+            if (glShmCompletion != -1) glShmPending[src->x11.ShmInfo.shmseg]++;
+         }
+         else {
+            parasol::Log log(__FUNCTION__);
+            log.warning("XShmPutImage() failed.");
+            continue;
+         }
+      }
+      else XPutImage(XDisplay, glDamage.Target, glXGC, &src->x11.ximage, r.Left + glDamage.OffsetX,
+         r.Top + glDamage.OffsetY, r.Left, r.Top, width, height);
+
+      glPresentPuts++;
+      glPresentBytes += LARGE(width) * LARGE(height) * src->BytesPerPixel;
+   }
+
+   glDamage.Total  = 0;
+   glDamage.Source = NULL;
+   glDamage.Target = 0;
+   glPresentActive = true;
+}
+
+//****************************************************************************
+// Queues an area of a client bitmap for presentation to an X11 drawable.  Coordinates are absolute and clipped.
+
+static void present_area(objBitmap *Source, Drawable Target, LONG X, LONG Y, LONG Width, LONG Height, LONG DestX,
+   LONG DestY)
+{
+   if ((Width < 1) or (Height < 1)) return;
+
+   if ((glDamage.Total) and ((glDamage.Source != Source) or (glDamage.Target != Target) or
+       (glDamage.OffsetX != X - DestX) or (glDamage.OffsetY != Y - DestY))) {
+      flush_damage();
+   }
+
+   glDamage.Source  = Source;
+   glDamage.Target  = Target;
+   glDamage.OffsetX = X - DestX;
+   glDamage.OffsetY = Y - DestY;
+
+   ClipRectangle rect;
+   rect.Left   = DestX;
+   rect.Top    = DestY;
+   rect.Right  = DestX + Width;
+   rect.Bottom = DestY + Height;
+   add_damage(rect);
+}
+
+// Ends the current frame.  Called from the Flush action of the Display.
+
+static void present_frame(void)
+{
+   flush_damage();
+   if (glPresentActive) {
+      glPresentFrames++;
+      glPresentActive = false;
+   }
+}
+
+// Discards any queued damage that refers to a bitmap or drawable that is about to be destroyed.
+
+static void discard_damage(objBitmap *Source, Drawable Target)
+{
+   if ((glDamage.Total) and (((Source) and (glDamage.Source IS Source)) or ((Target) and (glDamage.Target IS Target)))) {
+      glDamage.Total  = 0;
+      glDamage.Source = NULL;
+      glDamage.Target = 0;
+   }
+}
+
+//****************************************************************************
+// Called by the event loop for each XShmCompletionEvent.
+
+static void shm_completed(XShmCompletionEvent *Event)
+{
+   auto it = glShmPending.find(Event->shmseg);
+   if ((it != glShmPending.end()) and (--it->second <= 0)) glShmPending.erase(it);
+}
+
+static Bool is_shm_completion(_XDisplay *Server, XEvent *Event, XPointer Arg)
+{
+   return (Event->type IS glShmCompletion) and (((XShmCompletionEvent *)Event)->shmseg IS *(ShmSeg *)Arg);
+}
+
+//****************************************************************************
+// Waits until the X server has finished reading the shared memory of a bitmap, so that the CPU can write to it.  Any
+// damage that is queued from the bitmap is sent first.  If the completion events have not arrived yet, XSync() is
+// used to wait for them, as it guarantees that the server has processed every put.
+
+static void sync_shm_image(objBitmap *Bitmap)
+{
+   if (!XDisplay) return;
+
+   if ((glDamage.Total) and ((!Bitmap) or (glDamage.Source IS Bitmap))) flush_damage();
+
+   if (glShmPending.empty()) return;
+
+   if (!Bitmap) {
+      XSync(XDisplay, False);
+      XEvent event;
+      while (XCheckTypedEvent(XDisplay, glShmCompletion, &event)) shm_completed((XShmCompletionEvent *)&event);
+      glShmPending.clear();
+      return;
+   }
+
+   if (Bitmap->x11.XShmImage != TRUE) return;
+
+   ShmSeg seg = Bitmap->x11.ShmInfo.shmseg;
+   auto it = glShmPending.find(seg);
+   if (it IS glShmPending.end()) return;
+
+   XEvent event;
+   while ((it->second > 0) and (XCheckIfEvent(XDisplay, &event, is_shm_completion, (XPointer)&seg))) it->second--;
+
+   if (it->second > 0) {
+      XSync(XDisplay, False);
+      while (XCheckIfEvent(XDisplay, &event, is_shm_completion, (XPointer)&seg));
+   }
+
+   glShmPending.erase(seg);
+}
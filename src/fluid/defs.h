@@ -29,6 +29,15 @@ struct eventsub {
    APTR EventHandle;
 };
 
+#define FIELD_CACHE_SIZE 128 // Must be a power of 2
+
+struct fieldcache {
+   APTR   Class;       // The class that the field was resolved for
+   CSTRING Name;       // Interned Lua string of the field name, anchored in the registry
+   struct Field *Field; // Set if the field belongs to the class, otherwise FieldID is used
+   ULONG  FieldID;
+};
+
 struct prvFluid {
    lua_State *Lua;     // Lua instance
    struct actionmonitor *ActionList; // Action subscriptions managed by subscribe()
@@ -47,6 +56,7 @@ struct prvFluid {
    UWORD  Catch; // Operating within a catch() block if > 0
    UWORD  RequireCounter;
    LONG   ErrorLine;   // Line at which the last error was thrown.
+   struct fieldcache FieldCache[FIELD_CACHE_SIZE]; // Resolved field handles, see resolve_field()
 };
 
 struct array {
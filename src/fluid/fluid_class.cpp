@@ -103,6 +103,8 @@ static void free_all(objScript *Self)
 
    lua_close(prv->Lua);
    prv->Lua = NULL;
+
+   ClearMemory(prv->FieldCache, sizeof(prv->FieldCache)); // Cached names belonged to the closed Lua instance
 }
 
 //****************************************************************************
@@ -32,8 +32,8 @@ extern "C" {
 
 static int object_call(lua_State *);
 static LONG get_results(lua_State *, const FunctionField *, const BYTE *);
-static int getfield(lua_State *, struct object *, CSTRING);
-static ERROR set_object_field(lua_State *, OBJECTPTR, CSTRING, LONG);
+static int getfield(lua_State *, struct object *, CSTRING, LONG);
+static ERROR set_object_field(lua_State *, OBJECTPTR, CSTRING, LONG, LONG);
 
 static int object_setvar(lua_State *Lua);
 static int object_set(lua_State *Lua);
@@ -167,7 +167,7 @@ static int object_new(lua_State *Lua)
          while (lua_next(Lua, 2) != 0) {
             if ((field_name = luaL_checkstring(Lua, -2))) {
                if (!StrMatch("owner", field_name)) field_error = ERR_UnsupportedOwner; // Setting the owner is not permitted.
-               else field_error = set_object_field(Lua, obj, field_name, -1);
+               else field_error = set_object_field(Lua, obj, field_name, -2, -1);
             }
             else field_error = ERR_UnsupportedField;
 
@@ -292,7 +292,7 @@ static int object_newchild(lua_State *Lua)
       lua_setmetatable(Lua, -2);
 
       lua_pushinteger(Lua, parent->ObjectID); // ID of the would-be parent.
-      set_object_field(Lua, obj, "owner", lua_gettop(Lua));
+      set_object_field(Lua, obj, "owner", 0, lua_gettop(Lua));
       lua_pop(Lua, 1);
 
       if (lua_istable(Lua, 2)) {
@@ -305,7 +305,7 @@ static int object_newchild(lua_State *Lua)
          while (lua_next(Lua, 2) != 0) {
             if ((field_name = luaL_checkstring(Lua, -2))) {
                if (!StrMatch("owner", field_name)) field_error = ERR_UnsupportedOwner; // Setting the owner is not permitted.
-               else field_error = set_object_field(Lua, obj, field_name, -1);
+               else field_error = set_object_field(Lua, obj, field_name, -2, -1);
             }
             else field_error = ERR_UnsupportedField;
 
@@ -965,7 +965,7 @@ static int object_index(lua_State *Lua)
                   // with odd caps.
 
                   auto prv = (prvFluid *)Lua->Script->Head.ChildPrivate;
-                  prv->CaughtError = getfield(Lua, def, code);
+                  prv->CaughtError = getfield(Lua, def, code, 2);
                   if (!prv->CaughtError) return 1;
                   //if (prv->ThrowErrors) luaL_error(Lua, GetErrorMsg);
                }
@@ -12,7 +12,7 @@ static int object_newindex(lua_State *Lua)
       if ((fieldname = luaL_checkstring(Lua, 2))) {
          OBJECTPTR obj;
          if ((obj = access_object(object))) {
-            ERROR error = set_object_field(Lua, obj, fieldname, 3);
+            ERROR error = set_object_field(Lua, obj, fieldname, 2, 3);
             release_object(object);
             if (error >= ERR_ExceptionThreshold) {
                auto prv = (prvFluid *)Lua->Script->Head.ChildPrivate;
@@ -44,7 +44,7 @@ static int object_get(lua_State *Lua)
    CSTRING fieldname;
    if ((fieldname = luaL_checkstring(Lua, 1))) {
       log.trace("obj.get('%s')", fieldname);
-      ERROR error = getfield(Lua, object, fieldname);
+      ERROR error = getfield(Lua, object, fieldname, 1);
       if (!error) return 1;
       lua_pushvalue(Lua, 2);
       return 1;
@@ -178,11 +178,86 @@ static int object_setvar(lua_State *Lua)
    return 0;
 }
 
+//****************************************************************************
+// Resolves a field name to a handle.  Resolved fields are kept in a small direct-mapped cache that is keyed on the
+// class and the address of the field name.  Lua strings are interned, so a name on the stack has the same address
+// every time it is used by the script and a cache hit avoids hashing the name and searching the field table.  Cached
+// names are anchored in a registry table so that their addresses cannot be reused by another string.  The anchors
+// are counted per cache entry and released on eviction, so the table never holds more than FIELD_CACHE_SIZE names.
+//
+// Only fields that belong to the class itself are cached as a Field pointer.  Fields that are promoted from an
+// integral child depend on the object, so only their field ID is cached.  Names that cannot be resolved are not cached
+// because an integral child may support them on other objects of the class.
+//
+// NameIndex refers to the field name on the stack, or is zero if the name is not on the stack.
+
+static UBYTE glFieldAnchorKey; // The address is the registry key of the table that anchors cached names
+
+static ERROR resolve_field(lua_State *Lua, OBJECTPTR Object, CSTRING FName, LONG NameIndex, FieldHandle *Handle)
+{
+   if (!NameIndex) return ResolveFieldHandle(Object, StrHash(FName, FALSE), Handle);
+
+   auto prv = (prvFluid *)Lua->Script->Head.ChildPrivate;
+   auto entry = prv->FieldCache + ((((size_t)FName >> 4) ^ ((size_t)Object->Class >> 6)) & (FIELD_CACHE_SIZE - 1));
+
+   if ((entry->Name IS FName) and (entry->Class IS Object->Class)) {
+      if (entry->Field) {
+         Handle->Object = Object;
+         Handle->Field  = entry->Field;
+         return ERR_Okay;
+      }
+      else return ResolveFieldHandle(Object, entry->FieldID, Handle);
+   }
+
+   ULONG field_id = StrHash(FName, FALSE);
+   ERROR error = ResolveFieldHandle(Object, field_id, Handle);
+   if ((!error) and (lua_type(Lua, NameIndex) IS LUA_TSTRING) and (lua_tostring(Lua, NameIndex) IS FName)) {
+      if (NameIndex < 0) NameIndex = lua_gettop(Lua) + NameIndex + 1;
+
+      lua_pushlightuserdata(Lua, &glFieldAnchorKey);
+      lua_rawget(Lua, LUA_REGISTRYINDEX);
+      if (!lua_istable(Lua, -1)) {
+         lua_pop(Lua, 1);
+         lua_newtable(Lua);
+         lua_pushlightuserdata(Lua, &glFieldAnchorKey);
+         lua_pushvalue(Lua, -2);
+         lua_rawset(Lua, LUA_REGISTRYINDEX);
+      }
+
+      if (entry->Name) { // Release the anchor of the evicted name
+         lua_pushstring(Lua, entry->Name);
+         lua_pushvalue(Lua, -1);
+         lua_rawget(Lua, -3);
+         LONG refs = lua_tointeger(Lua, -1) - 1;
+         lua_pop(Lua, 1);
+         if (refs > 0) lua_pushinteger(Lua, refs);
+         else lua_pushnil(Lua);
+         lua_rawset(Lua, -3);
+      }
+
+      lua_pushvalue(Lua, NameIndex);
+      lua_pushvalue(Lua, NameIndex);
+      lua_rawget(Lua, -3);
+      LONG refs = lua_tointeger(Lua, -1) + 1;
+      lua_pop(Lua, 1);
+      lua_pushinteger(Lua, refs);
+      lua_rawset(Lua, -3);
+      lua_pop(Lua, 1);
+
+      entry->Class   = Object->Class;
+      entry->Name    = FName;
+      entry->Field   = (Handle->Object IS Object) ? Handle->Field : NULL;
+      entry->FieldID = field_id;
+   }
+
+   return error;
+}
+
 //****************************************************************************
 // If successful, a value is pushed on the stack and ERR_Okay is returned.  If any other error code is returned,
-// the stack is unmodified.
+// the stack is unmodified.  NameIndex is the stack index of FName, or zero.
 
-static ERROR getfield(lua_State *Lua, struct object *object, CSTRING FName)
+static ERROR getfield(lua_State *Lua, struct object *object, CSTRING FName, LONG NameIndex)
 {
    parasol::Log log("obj.get");
 
@@ -191,8 +266,7 @@ static ERROR getfield(lua_State *Lua, struct object *object, CSTRING FName)
    OBJECTPTR obj;
    if (!(obj = access_object(object))) return log.warning(ERR_AccessObject);
 
-   OBJECTPTR src;
-   Field *field;
+   FieldHandle handle;
    ERROR error = ERR_Okay;
    if (FName[0] IS '$') {
       char buffer[1024];
@@ -203,11 +277,14 @@ static ERROR getfield(lua_State *Lua, struct object *object, CSTRING FName)
       // by using an uppercase 'ID'.
       lua_pushnumber(Lua, obj->UniqueID);
    }
-   else if ((field = FindField(obj, StrHash(FName, FALSE), &src))) {
+   else if (!resolve_field(Lua, obj, FName, NameIndex, &handle)) {
+      // The field is read through the handle to avoid further lookups.
+      auto field = handle.Field;
+      auto src = handle.Object;
       if (field->Flags & FD_ARRAY) {
          if (field->Flags & FD_RGB) {
             STRING rgb;
-            if ((!(error = GetString(src, field->FieldID, &rgb))) AND (rgb)) {
+            if ((!(error = GetFieldByHandle(&handle, TSTRING, &rgb))) AND (rgb)) {
                lua_pushstring(Lua, rgb);
             }
          }
@@ -234,7 +311,7 @@ static ERROR getfield(lua_State *Lua, struct object *object, CSTRING FName)
       else if (field->Flags & FD_STRUCT) { // Structs are copied into standard Lua tables.
          APTR result;
          if (field->Arg) {
-            if (!(error = GetPointer(src, field->FieldID, &result))) {
+            if (!(error = GetFieldByHandle(&handle, TPTR, &result))) {
                named_struct_to_table(Lua, (CSTRING)field->Arg, result);
             }
          }
@@ -245,39 +322,39 @@ static ERROR getfield(lua_State *Lua, struct object *object, CSTRING FName)
       }
       else if (field->Flags & FD_STRING) {
          STRING result;
-         if (!(error = GetString(src, field->FieldID, &result))) lua_pushstring(Lua, result);
+         if (!(error = GetFieldByHandle(&handle, TSTRING, &result))) lua_pushstring(Lua, result);
       }
       else if (field->Flags & FD_POINTER) {
          if (field->Flags & (FD_OBJECT|FD_INTEGRAL)) {
             OBJECTPTR obj;
-            if (!(error = GetPointer(src, field->FieldID, &obj))) {
+            if (!(error = GetFieldByHandle(&handle, TPTR, &obj))) {
                if (obj) push_object(Lua, obj);
                else lua_pushnil(Lua);
             }
          }
          else {
             APTR result;
-            if (!(error = GetPointer(src, field->FieldID, &result))) lua_pushlightuserdata(Lua, result);
+            if (!(error = GetFieldByHandle(&handle, TPTR, &result))) lua_pushlightuserdata(Lua, result);
          }
       }
       else if (field->Flags & FD_DOUBLE) {
          DOUBLE result;
-         if (!(error = GetDouble(src, field->FieldID, &result))) lua_pushnumber(Lua, result);
+         if (!(error = GetFieldByHandle(&handle, TDOUBLE, &result))) lua_pushnumber(Lua, result);
       }
       else if (field->Flags & FD_LARGE) {
          LARGE result;
-         if (!(error = GetLarge(src, field->FieldID, &result))) lua_pushnumber(Lua, result);
+         if (!(error = GetFieldByHandle(&handle, TLARGE, &result))) lua_pushnumber(Lua, result);
       }
       else if (field->Flags & FD_LONG) {
          if (field->Flags & FD_UNSIGNED) {
             ULONG result;
-            if (!(error = GetLong(src, field->FieldID, (LONG *)&result))) {
+            if (!(error = GetFieldByHandle(&handle, TLONG, &result))) {
                lua_pushnumber(Lua, result);
             }
          }
          else {
             LONG result;
-            if (!(error = GetLong(src, field->FieldID, &result))) {
+            if (!(error = GetFieldByHandle(&handle, TLONG, &result))) {
                if (field->Flags & FD_OBJECT) push_object_id(Lua, result);
                else lua_pushinteger(Lua, result);
             }
@@ -303,9 +380,10 @@ static ERROR getfield(lua_State *Lua, struct object *object, CSTRING FName)
 
 //****************************************************************************
 // Note that SetFieldEval() will translate object references and computations in the string.
-// Prefixing the field name with '_' forces the field to be set as a custom variable.
+// Prefixing the field name with '_' forces the field to be set as a custom variable.  NameIndex is the stack index of
+// FName, or zero.
 
-static ERROR set_object_field(lua_State *Lua, OBJECTPTR obj, CSTRING FName, LONG ValueIndex)
+static ERROR set_object_field(lua_State *Lua, OBJECTPTR obj, CSTRING FName, LONG NameIndex, LONG ValueIndex)
 {
    parasol::Log log("obj.setfield");
 
@@ -320,9 +398,10 @@ static ERROR set_object_field(lua_State *Lua, OBJECTPTR obj, CSTRING FName, LONG
 
    LONG type = lua_type(Lua, ValueIndex);
 
-   OBJECTPTR src;
-   Field *field;
-   if ((field = FindField(obj, StrHash(FName, FALSE), &src))) {
+   FieldHandle handle;
+   if (!resolve_field(Lua, obj, FName, NameIndex, &handle)) {
+      auto field = handle.Field;
+      auto src = handle.Object;
       log.traceBranch("Field: %s, Flags: $%.8x, (type: %s)", FName, field->Flags, lua_typename(Lua, type));
 
       if (field->Flags & FD_ARRAY) {
@@ -439,7 +518,7 @@ static ERROR set_object_field(lua_State *Lua, OBJECTPTR obj, CSTRING FName, LONG
             else return SetPointer(src, field->FieldID, NULL);
          }
          else if (type IS LUA_TSTRING) {
-            return SetString(src, field->FieldID, lua_tostring(Lua, ValueIndex));
+            return SetFieldByHandle(&handle, TSTRING, lua_tostring(Lua, ValueIndex));
          }
          else if (type IS LUA_TNUMBER) {
             if (field->Flags & FD_STRING) {
@@ -464,10 +543,10 @@ static ERROR set_object_field(lua_State *Lua, OBJECTPTR obj, CSTRING FName, LONG
       }
       else switch(type) {
          case LUA_TNUMBER:
-            return SetDouble(src, field->FieldID, lua_tonumber(Lua, ValueIndex));
+            return SetFieldByHandle(&handle, TDOUBLE, (DOUBLE)lua_tonumber(Lua, ValueIndex));
 
          case LUA_TBOOLEAN:
-            return SetLong(src, field->FieldID, lua_toboolean(Lua, ValueIndex));
+            return SetFieldByHandle(&handle, TLONG, (LONG)lua_toboolean(Lua, ValueIndex));
 
          case LUA_TNIL: // Setting a field with nil does nothing.  Use zero to be explicit.
             return ERR_Okay;
@@ -495,7 +574,7 @@ static ERROR set_object_field(lua_State *Lua, OBJECTPTR obj, CSTRING FName, LONG
       // Default to setting a custom variable rather than throwing an error - primarily for legacy reasons.
       CSTRING vstr = lua_tostring(Lua, ValueIndex);
       if (vstr) {
-         log.msg("Field '%s' is not in class '%s' - defaulting to custom variable. [DEPRECATED]", FName, src->Class->ClassName);
+         log.msg("Field '%s' is not in class '%s' - defaulting to custom variable. [DEPRECATED]", FName, obj->Class->ClassName);
          return SetFieldEval(obj, FName, vstr);
       }
       else return ERR_UnsupportedField;
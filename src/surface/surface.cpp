@@ -1773,6 +1773,7 @@ static ERROR _redraw_surface(OBJECTID SurfaceID, SurfaceList *list, WORD index,
          // Check if there has been a change in the video bit depth.  If so, regenerate the bitmap with a matching depth.
 
          check_bmp_buffer_depth(surface, bitmap);
+         gfxSync(bitmap); // Wait until the display has finished reading the buffer before redrawing it
          _redraw_surface_do(surface, list, Total, index, Left, Top, Right, Bottom, bitmap, (Flags & IRF_FORCE_DRAW) | ((Flags & (IRF_IGNORE_CHILDREN|IRF_IGNORE_NV_CHILDREN)) ? 0 : URF_HATE_CHILDREN));
          ReleaseObject(bitmap);
       }
@@ -225,13 +225,22 @@ namespace agg
 
         //--------------------------------------------------------------------
         template<class Scanline> bool sweep_scanline(Scanline& sl)
+        {
+            return sweep_scanline(sl, m_scan_y, m_outline.max_y());
+        }
+
+        //--------------------------------------------------------------------
+        // Sweeps from the caller's scan_y, stopping after max_y.  The rasterizer 
+        // is not modified, so once it has been sorted, separate threads can 
+        // sweep separate bands of it concurrently.
+        template<class Scanline> bool sweep_scanline(Scanline& sl, int& scan_y, int max_y) const
         {
             for(;;)
             {
-                if(m_scan_y > m_outline.max_y()) return false;
+                if(scan_y > max_y) return false;
                 sl.reset_spans();
-                unsigned num_cells = m_outline.scanline_num_cells(m_scan_y);
-                const cell_aa* const* cells = m_outline.scanline_cells(m_scan_y);
+                unsigned num_cells = m_outline.scanline_num_cells(scan_y);
+                const cell_aa* const* cells = m_outline.scanline_cells(scan_y);
                 int cover = 0;
 
                 while(num_cells)
@@ -273,11 +282,11 @@ namespace agg
                 }
         
                 if(sl.num_spans()) break;
-                ++m_scan_y;
+                ++scan_y;
             }
 
-            sl.finalize(m_scan_y);
-            ++m_scan_y;
+            sl.finalize(scan_y);
+            ++scan_y;
             return true;
         }
 
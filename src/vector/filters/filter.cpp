@@ -13,8 +13,10 @@ internal list of instructions.  It is not possible to modify the instructions on
 can be cleared and a new set of instructions can be applied.
 
 It is important to note that filter effects are CPU intensive tasks and real-time performance may be disappointing.
-If this is an issue, it can often be rectified by pre-rendering the filter effects in advance and storing the results
-in cached bitmaps.
+To mitigate this, the result of the effect chain is retained between draws.  If the rendered source graphic, the
+filter area and the effects are unchanged then the retained result is drawn without processing the effects again.
+The amount of memory that is available for retained results is managed by the ~Vector.SetFilterCache() function.
+Filters that use BackgroundImage or BackgroundAlpha as an input are always processed in full.
 
 -END-
 
@@ -46,6 +48,7 @@ static void remove_effect(objVectorFilter *, effect *);
 
 //****************************************************************************
 
+#include "filter_pixels.cpp"
 #include "filter_blur.cpp"
 #include "filter_composite.cpp"
 #include "filter_flood.cpp"
@@ -57,71 +60,6 @@ static void remove_effect(objVectorFilter *, effect *);
 #include "filter_turbulence.cpp"
 #include "filter_morphology.cpp"
 
-//****************************************************************************
-
-static void premultiply_bitmap(objBitmap *bmp)
-{
-   const UBYTE A = bmp->ColourFormat->AlphaPos>>3;
-   const UBYTE R = bmp->ColourFormat->RedPos>>3;
-   const UBYTE G = bmp->ColourFormat->GreenPos>>3;
-   const UBYTE B = bmp->ColourFormat->BluePos>>3;
-
-   const ULONG w = (ULONG)(bmp->Clip.Right - bmp->Clip.Left);
-   const ULONG h = (ULONG)(bmp->Clip.Bottom - bmp->Clip.Top);
-
-   UBYTE *data = bmp->Data + (bmp->Clip.Left<<2) + (bmp->Clip.Top * bmp->LineWidth);
-
-   for (ULONG y=0; y < h; y++) {
-      UBYTE *pixel = data + (bmp->LineWidth * y);
-      for (ULONG x=0; x < w; x++) {
-         UBYTE a = pixel[A];
-         if (a < 0xff) {
-             if (a == 0) pixel[R] = pixel[G] = pixel[B] = 0;
-             else {
-                pixel[R] = UBYTE((pixel[R] * a + 0xff) >> 8);
-                pixel[G] = UBYTE((pixel[G] * a + 0xff) >> 8);
-                pixel[B] = UBYTE((pixel[B] * a + 0xff) >> 8);
-             }
-         }
-         pixel += 4;
-      }
-   }
-}
-
-//****************************************************************************
-
-static void demultiply_bitmap(objBitmap *bmp)
-{
-   const UBYTE A = bmp->ColourFormat->AlphaPos>>3;
-   const UBYTE R = bmp->ColourFormat->RedPos>>3;
-   const UBYTE G = bmp->ColourFormat->GreenPos>>3;
-   const UBYTE B = bmp->ColourFormat->BluePos>>3;
-
-   const ULONG w = (ULONG)(bmp->Clip.Right - bmp->Clip.Left);
-   const ULONG h = (ULONG)(bmp->Clip.Bottom - bmp->Clip.Top);
-
-   UBYTE *data = bmp->Data + (bmp->Clip.Left<<2) + (bmp->Clip.Top * bmp->LineWidth);
-
-   for (ULONG y=0; y < h; y++) {
-      UBYTE *pixel = data + (bmp->LineWidth * y);
-      for (ULONG x=0; x < w; x++) {
-         UBYTE a = pixel[A];
-         if (a < 0xff) {
-            if (a == 0) pixel[R] = pixel[G] = pixel[B] = 0;
-            else {
-               ULONG r = (ULONG(pixel[R]) * 0xff) / a;
-               ULONG g = (ULONG(pixel[G]) * 0xff) / a;
-               ULONG b = (ULONG(pixel[B]) * 0xff) / a;
-               pixel[R] = UBYTE((r > 0xff) ? 0xff : r);
-               pixel[G] = UBYTE((g > 0xff) ? 0xff : g);
-               pixel[B] = UBYTE((b > 0xff) ? 0xff : b);
-            }
-         }
-         pixel += 4;
-      }
-   }
-}
-
 //****************************************************************************
 // Retrieve a bitmap that is associated with the effect.
 
@@ -130,8 +68,10 @@ static ERROR get_bitmap(objVectorFilter *Self, objBitmap **BitmapResult, UBYTE S
    parasol::Log log(__FUNCTION__);
    //log.trace("Effect: %p, Size: %dx%d", Effect, width, height);
 
-   // Retrieve a bitmap from the bank.  In order to save memory, bitmap data is managed internally so that it always
-   // reflects the size of the clipping region.
+   // Retrieve a bitmap from the bank.  In order to save memory, the bitmap data always reflects the size of the
+   // clipping region.  The data is borrowed from the scratch pool of the scene that is drawing the filter.
+
+   if (!Self->Pool) return ERR_FieldNotSet;
 
    LONG bi = Self->BankIndex;
    if (bi >= ARRAYSIZE(Self->Bank)) return ERR_ArrayFull;
@@ -161,14 +101,14 @@ static ERROR get_bitmap(objVectorFilter *Self, objBitmap **BitmapResult, UBYTE S
    bmp->LineWidth = canvas_width * bmp->BytesPerPixel;
 
    if ((Self->Bank[bi].Data) AND (Self->Bank[bi].DataSize < bmp->LineWidth * canvas_height)) {
-      FreeResource(Self->Bank[bi].Data);
+      Self->Pool->give_back(Self->Bank[bi].Data, Self->Bank[bi].DataSize);
       Self->Bank[bi].Data = NULL;
-      bmp->Data = NULL;
+      Self->Bank[bi].DataSize = 0;
    }
 
-   if (!bmp->Data) {
-      if (!AllocMemory(bmp->LineWidth * canvas_height, MEM_DATA|MEM_NO_CLEAR, &Self->Bank[bi].Data, NULL)) {
-         Self->Bank[bi].DataSize = bmp->LineWidth * canvas_height;
+   if (!Self->Bank[bi].Data) {
+      if (!(Self->Bank[bi].Data = Self->Pool->borrow(bmp->LineWidth * canvas_height, &Self->Bank[bi].DataSize))) {
+         return ERR_AllocMemory;
       }
    }
 
@@ -239,6 +179,113 @@ static ERROR get_bitmap(objVectorFilter *Self, objBitmap **BitmapResult, UBYTE S
    return ERR_Okay;
 }
 
+//****************************************************************************
+// Effect results are cached against a hash of everything that contributes to them: the pixels of the rendered source
+// graphic, the filter area and the colour space.  Effect parameters can only change through DataFeed and Clear, which
+// discard the cached result.  Effects that read the background are not cached because the background content cannot
+// be tracked.  A key of zero indicates that the result cannot be cached.
+
+static uint64_t hash_data(uint64_t Hash, const UBYTE *Data, LONG Size)
+{
+   LONG i = 0;
+   for (; i + 8 <= Size; i += 8) {
+      uint64_t v;
+      CopyMemory(Data + i, &v, sizeof(v));
+      Hash = (Hash ^ v) * 0x9e3779b97f4a7c15ULL;
+      Hash ^= Hash >> 32;
+   }
+   for (; i < Size; i++) Hash = (Hash ^ Data[i]) * 0x100000001b3ULL;
+   return Hash;
+}
+
+static LARGE filter_cache_key(objVectorFilter *Self)
+{
+   if (glFilterCacheLimit <= 0) return 0;
+
+   for (auto e=Self->Effects; e; e=e->Next) {
+      if ((e->Source IS VSF_BKGD) or (e->Source IS VSF_BKGD_ALPHA)) return 0;
+   }
+
+   auto src = Self->SrcBitmap;
+   const DOUBLE area[] = {
+      DOUBLE(Self->BoundX), DOUBLE(Self->BoundY), DOUBLE(Self->BoundWidth), DOUBLE(Self->BoundHeight),
+      DOUBLE(Self->ViewX), DOUBLE(Self->ViewY), DOUBLE(Self->ViewWidth), DOUBLE(Self->ViewHeight),
+      DOUBLE(src->Clip.Left), DOUBLE(src->Clip.Top), DOUBLE(src->Clip.Right), DOUBLE(src->Clip.Bottom),
+      DOUBLE(Self->ColourSpace), DOUBLE(Self->PrimitiveUnits),
+      Self->Viewport->vpFixedWidth, Self->Viewport->vpFixedHeight
+   };
+
+   uint64_t hash = hash_data(0xcbf29ce484222325ULL, (const UBYTE *)area, sizeof(area));
+
+   const LONG row_size = (src->Clip.Right - src->Clip.Left) * src->BytesPerPixel;
+   for (LONG y=src->Clip.Top; y < src->Clip.Bottom; y++) {
+      hash = hash_data(hash, src->Data + (y * src->LineWidth) + (src->Clip.Left * src->BytesPerPixel), row_size);
+   }
+
+   return hash ? LARGE(hash) : 1;
+}
+
+//****************************************************************************
+// Release the bitmap memory that is held for the cached result.  Bank 0 is the source graphic and is always retained.
+// The memory is given back to the scratch pool that it was borrowed from.
+
+static void release_filter_cache(objVectorFilter *Self, bool FreeBitmaps)
+{
+   if (Self->CacheSize) {
+      __sync_fetch_and_sub(&glFilterCacheUsage, Self->CacheSize);
+      Self->CacheSize = 0;
+   }
+   Self->CacheKey = 0;
+
+   if ((FreeBitmaps) and (Self->Pool)) {
+      for (LONG i=1; i < ARRAYSIZE(Self->Bank); i++) {
+         if (Self->Bank[i].Data) {
+            Self->Pool->give_back(Self->Bank[i].Data, Self->Bank[i].DataSize);
+            Self->Bank[i].Data = NULL;
+            Self->Bank[i].DataSize = 0;
+            if (Self->Bank[i].Bitmap) Self->Bank[i].Bitmap->Data = NULL;
+         }
+      }
+
+      if (Self->MergeBitmap) { Self->Pool->give_back_bitmap(Self->MergeBitmap); Self->MergeBitmap = NULL; }
+   }
+}
+
+//****************************************************************************
+// Called by draw_vectors() to declare the scratch pool of the scene that is drawing the filter.  Surfaces that were
+// borrowed from a different scene are given back to it first.
+
+static void set_filter_pool(objVectorFilter *Self, ScratchPool *Pool)
+{
+   if (Self->Pool IS Pool) return;
+
+   release_filter_cache(Self, true);
+   if (Self->Pool) Self->Pool->release();
+   if ((Self->Pool = Pool)) Pool->retain();
+}
+
+//****************************************************************************
+// Called after the effects have been processed in full.  The result is retained for future draws if the key is valid
+// and the memory budget permits it, otherwise the bitmaps are given back to the scratch pool for reuse.
+
+static void update_filter_cache(objVectorFilter *Self, LARGE Key)
+{
+   if (!Key) {
+      release_filter_cache(Self, true);
+      return;
+   }
+
+   LARGE size = 0;
+   for (LONG i=1; i < ARRAYSIZE(Self->Bank); i++) size += Self->Bank[i].DataSize;
+   if (Self->MergeBitmap) size += Self->MergeBitmap->Size;
+
+   LARGE usage = __sync_add_and_fetch(&glFilterCacheUsage, size - Self->CacheSize);
+   Self->CacheSize = size;
+
+   if (usage <= glFilterCacheLimit) Self->CacheKey = Key;
+   else release_filter_cache(Self, true);
+}
+
 //****************************************************************************
 // Create a new filter and append it to the filter chain.
 
@@ -248,7 +295,7 @@ static effect * add_effect(objVectorFilter *Filter, UBYTE Type)
    effect *effect;
 
    log.trace("Type: %d", Type);
-   if (!AllocMemory(sizeof(effect), MEM_DATA, &effect, NULL)) {
+   if (!AllocMemory(sizeof(struct effect), MEM_DATA, &effect, NULL)) { // NB: The variable shadows the type
       effect->Prev = Filter->LastEffect;
       effect->Next = NULL;
       effect->Type = Type;
@@ -372,9 +419,10 @@ static ERROR VECTORFILTER_Clear(objVectorFilter *Self, APTR Void)
 
    if (Self->Merge) { FreeResource(Self->Merge); Self->Merge = NULL; }
 
+   release_filter_cache(Self, true);
+
    for (LONG i=0; i < ARRAYSIZE(Self->Bank); i++) {
       if (Self->Bank[i].Bitmap) { acFree(Self->Bank[i].Bitmap); Self->Bank[i].Bitmap = NULL; }
-      if (Self->Bank[i].Data) { FreeResource(Self->Bank[i].Data); Self->Bank[i].Data = NULL; }
    }
 
    return ERR_Okay;
@@ -417,6 +465,8 @@ static ERROR VECTORFILTER_DataFeed(objVectorFilter *Self, struct acDataFeed *Arg
    if (Args->DataType IS DATA_XML) {
       if (Self->EffectXML) { acFree(Self->EffectXML); Self->EffectXML = NULL; }
 
+      release_filter_cache(Self, false);
+
       if (!NewObject(ID_XML, NF_INTEGRAL, &Self->EffectXML)) {
          SetString(Self->EffectXML, FID_Statement, (CSTRING)Args->Buffer);
          if (!acInit(Self->EffectXML)) {
@@ -463,6 +513,33 @@ static ERROR VECTORFILTER_DataFeed(objVectorFilter *Self, struct acDataFeed *Arg
    return ERR_Okay;
 }
 
+//****************************************************************************
+// Copy the prepared filter results to the destination bitmap.
+
+static void draw_filter_result(objVectorFilter *Self)
+{
+   parasol::Log log(__FUNCTION__);
+
+   if (Self->Merge) {
+      if (!Self->MergeBitmap) return;
+      if (Self->Opacity < 1.0) Self->MergeBitmap->Opacity = 255.0 * Self->Opacity;
+      gfxCopyArea(Self->MergeBitmap, Self->BkgdBitmap, BAF_BLEND|BAF_COPY, 0, 0, Self->BoundWidth, Self->BoundHeight, Self->BoundX, Self->BoundY);
+      Self->MergeBitmap->Opacity = 255;
+   }
+   else { // If no merge is specified, then draw all the available bitmaps in sequence.
+      objBitmap *bmp;
+      for (auto e = Self->Effects; e; e=e->Next) {
+         if ((e->ID) AND (e->UsageCount > 0)) continue; // Don't draw the effect if it's being piped to something else.
+         if ((bmp = e->Bitmap)) {
+            if (Self->Opacity < 1.0) bmp->Opacity = 255.0 * Self->Opacity;
+            gfxCopyArea(bmp, Self->BkgdBitmap, BAF_BLEND|BAF_COPY, 0, 0, bmp->Width, bmp->Height, 0, 0);
+            bmp->Opacity = 255;
+         }
+         else log.trace("No Bitmap generated by effect '%s'.", get_effect_name(e->Type));
+      }
+   }
+}
+
 //****************************************************************************
 
 static ERROR VECTORFILTER_Draw(objVectorFilter *Self, struct acDraw *Args)
@@ -476,6 +553,12 @@ static ERROR VECTORFILTER_Draw(objVectorFilter *Self, struct acDraw *Args)
 
    if (!Self->Viewport->Child) { log.warning("Target vector not defined."); return ERR_FieldNotSet; }
 
+   // Filters are normally drawn by draw_vectors(), which declares the scratch pool of the drawing scene.  Otherwise
+   // the pool of the internal scene is used.
+
+   if (!Self->Pool) set_filter_pool(Self, scratch_pool(Self->Scene));
+   if (!Self->Pool) return log.warning(ERR_AllocMemory);
+
    Self->DrawStamp = PreciseTime();
 
    // The target bitmap will mirror the size of the vector's nearest viewport.
@@ -627,6 +710,16 @@ static ERROR VECTORFILTER_Draw(objVectorFilter *Self, struct acDraw *Args)
    child->Filter = Self;
    child->Next = save_vector;
 
+   // If none of the inputs have changed since the last draw, the retained result is redrawn as-is.
+
+   LARGE key = filter_cache_key(Self);
+   if ((key) and (key IS Self->CacheKey)) {
+      draw_filter_result(Self);
+      return ERR_Okay;
+   }
+
+   Self->CacheKey = 0;
+
    /*** Now apply the effects to the rendered scene ***/
 
    for (auto *e = Self->Effects; e; e=e->Next) {
@@ -679,24 +772,19 @@ static ERROR VECTORFILTER_Draw(objVectorFilter *Self, struct acDraw *Args)
       else if (error != ERR_Continue) log.warning("Failed to configure bitmap for effect type %s", get_effect_name(e->Type));
    }
 
-   // Render the filter results to the destination bitmap
+   // Prepare the filter results for drawing to the destination bitmap
 
    if (Self->Merge) {
       // 1. Merge everything to the scratch bitmap allocated by the filter.
       // 2. Do the linear2RGB conversion on the result.
-      // 3. Copy the result to the display.
 
-      if (!Self->MergeBitmap) {
-         if (CreateObject(ID_BITMAP, NF_INTEGRAL, &Self->MergeBitmap,
-               FID_Name|TSTR,          "MergeBitmap",
-               FID_Width|TLONG,        Self->BoundWidth,
-               FID_Height|TLONG,       Self->BoundHeight,
-               FID_BitsPerPixel|TLONG, 32,
-               FID_Flags|TLONG,        BMF_ALPHA_CHANNEL,
-               TAGEND)) return ERR_CreateObject;
+      if ((Self->MergeBitmap) and ((Self->BoundWidth != Self->MergeBitmap->Width) or (Self->BoundHeight != Self->MergeBitmap->Height))) {
+         Self->Pool->give_back_bitmap(Self->MergeBitmap);
+         Self->MergeBitmap = NULL;
       }
-      else if ((Self->BoundWidth != Self->MergeBitmap->Width) or (Self->BoundHeight != Self->MergeBitmap->Height)) {
-         acResize(Self->MergeBitmap, Self->BoundWidth, Self->BoundHeight, 32);
+
+      if (!Self->MergeBitmap) {
+         if (!(Self->MergeBitmap = Self->Pool->borrow_bitmap(Self->BoundWidth, Self->BoundHeight))) return ERR_AllocMemory;
       }
 
       gfxDrawRectangle(Self->MergeBitmap, 0, 0, Self->MergeBitmap->Width, Self->MergeBitmap->Height, 0x00000000, BAF_FILL);
@@ -713,28 +801,17 @@ static ERROR VECTORFILTER_Draw(objVectorFilter *Self, struct acDraw *Args)
          }
       }
 
-      // Final copy to the display.
-
       if (Self->ColourSpace IS CS_LINEAR_RGB) linear2RGB(*Self->MergeBitmap);
-
-      if (Self->Opacity < 1.0) Self->MergeBitmap->Opacity = 255.0 * Self->Opacity;
-      gfxCopyArea(Self->MergeBitmap, Self->BkgdBitmap, BAF_BLEND|BAF_COPY, 0, 0, Self->BoundWidth, Self->BoundHeight, Self->BoundX, Self->BoundY);
-      Self->MergeBitmap->Opacity = 255;
    }
-   else { // If no merge is specified, then draw all the available bitmaps in sequence.
-      objBitmap *bmp;
+   else if (Self->ColourSpace IS CS_LINEAR_RGB) {
       for (auto e = Self->Effects; e; e=e->Next) {
-         if ((e->ID) AND (e->UsageCount > 0)) continue; // Don't draw the effect if it's being piped to something else.
-         if ((bmp = e->Bitmap)) {
-            if (Self->ColourSpace IS CS_LINEAR_RGB) linear2RGB(*bmp);
-            if (Self->Opacity < 1.0) bmp->Opacity = 255.0 * Self->Opacity;
-            gfxCopyArea(bmp, Self->BkgdBitmap, BAF_BLEND|BAF_COPY, 0, 0, bmp->Width, bmp->Height, 0, 0);
-            bmp->Opacity = 255;
-         }
-         else log.trace("No Bitmap generated by effect '%s'.", get_effect_name(e->Type));
+         if ((e->ID) AND (e->UsageCount > 0)) continue;
+         if (e->Bitmap) linear2RGB(*e->Bitmap);
       }
    }
 
+   draw_filter_result(Self);
+   update_filter_cache(Self, key);
    return ERR_Okay;
 }
 
@@ -746,7 +823,7 @@ static ERROR VECTORFILTER_Free(objVectorFilter *Self, APTR Void)
 
    if (Self->EffectXML)   { acFree(Self->EffectXML);   Self->EffectXML = NULL; }
    if (Self->Scene)       { acFree(Self->Scene);       Self->Scene = NULL; }
-   if (Self->MergeBitmap) { acFree(Self->MergeBitmap); Self->MergeBitmap = NULL; }
+   if (Self->Pool)        { Self->Pool->release();     Self->Pool = NULL; }
    if (Self->Path)        { FreeResource(Self->Path);  Self->Path = NULL; }
    return ERR_Okay;
 }
@@ -335,52 +335,8 @@ public:
 
 static void apply_cmatrix(objVectorFilter *Self, struct effect *Effect)
 {
-   objBitmap *bmp = Effect->Bitmap;
-   if (bmp->BytesPerPixel != 4) return;
    if (!Effect->Colour.Matrix) return;
-
-   const UBYTE A = bmp->ColourFormat->AlphaPos>>3;
-   const UBYTE R = bmp->ColourFormat->RedPos>>3;
-   const UBYTE G = bmp->ColourFormat->GreenPos>>3;
-   const UBYTE B = bmp->ColourFormat->BluePos>>3;
-
-   ColourMatrix &matrix = *Effect->Colour.Matrix;
-
-   UBYTE *data = bmp->Data + (bmp->Clip.Left<<2) + (bmp->Clip.Top * bmp->LineWidth);
-
-   for (LONG y=0; y < bmp->Clip.Bottom - bmp->Clip.Top; y++) {
-      UBYTE *pixel = data + (bmp->LineWidth * y);
-      for (LONG x=0; x < bmp->Clip.Right - bmp->Clip.Left; x++) {
-
-         DOUBLE a = pixel[A];
-         DOUBLE r = pixel[R];
-         DOUBLE g = pixel[G];
-         DOUBLE b = pixel[B];
-
-         LONG r2 = 0.5 + (r * matrix[0]) + (g * matrix[1]) + (b * matrix[2]) + (a * matrix[3]) + matrix[4];
-         LONG g2 = 0.5 + (r * matrix[5]) + (g * matrix[6]) + (b * matrix[7]) + (a * matrix[8]) + matrix[9];
-         LONG b2 = 0.5 + (r * matrix[10]) + (g * matrix[11]) + (b * matrix[12]) + (a * matrix[13]) + matrix[14];
-         LONG a2 = 0.5 + (r * matrix[15]) + (g * matrix[16]) + (b * matrix[17]) + (a * matrix[18]) + matrix[19];
-
-         if (a2 < 0) pixel[A] = 0;
-         else if (a2 > 255) pixel[A] = 255;
-         else pixel[A] = a2;
-
-         if (r2 < 0)   pixel[R] = 0;
-         else if (r2 > 255) pixel[R] = 255;
-         else pixel[R] = r2;
-
-         if (g2 < 0) pixel[G] = 0;
-         else if (g2 > 255) pixel[G] = 255;
-         else pixel[G] = g2;
-
-         if (b2 < 0) pixel[B] = 0;
-         else if (b2 > 255) pixel[B] = 255;
-         else pixel[B] = b2;
-
-         pixel += 4;
-      }
-   }
+   cmatrix_bitmap(Effect->Bitmap, Effect->Colour.Matrix->matrix.data());
 }
 
 //****************************************************************************
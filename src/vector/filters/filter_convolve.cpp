@@ -1,200 +1,8 @@
 /*****************************************************************************
 
-*****************************************************************************/
-
-#include <array>
-
-enum EdgeModeType { EM_DUPLICATE = 1, EM_WRAP, EM_NONE };
-
-#define MAX_DIM 9
-
-class ConvolveMatrix {
-public:
-
-   LONG TargetX, TargetY;
-   DOUBLE KernelUnitX, KernelUnitY;
-   UBYTE FilterWidth, FilterHeight;
-   UBYTE FilterSize;
-   DOUBLE Divisor;
-   DOUBLE Bias;
-   LONG EdgeMode;
-   bool PreserveAlpha;
-   std::array<DOUBLE, MAX_DIM * MAX_DIM> KernelMatrix;
-
-   ConvolveMatrix() :
-      KernelUnitX(1),
-      KernelUnitY(1),
-      FilterWidth(3),
-      FilterHeight(3),
-      FilterSize(0),
-      Divisor(0),
-      Bias(0),
-      EdgeMode(EM_DUPLICATE),
-      PreserveAlpha(false) { }
-
-   inline UBYTE * getPixel(objBitmap &Bitmap, LONG X, LONG Y) const {
-      if ((X >= Bitmap.Clip.Left) and (X < Bitmap.Clip.Right) and
-          (Y >= Bitmap.Clip.Top) and (Y < Bitmap.Clip.Bottom)) {
-         return Bitmap.Data + (Y * Bitmap.LineWidth) + (X<<2);
-      }
-
-      switch (EdgeMode) {
-         default: return NULL;
-
-         case EM_DUPLICATE:
-            if (X < Bitmap.Clip.Left) X = Bitmap.Clip.Left;
-            else if (X >= Bitmap.Clip.Right) X = Bitmap.Clip.Right - 1;
-            if (Y < Bitmap.Clip.Top) Y = Bitmap.Clip.Top;
-            else if (Y >= Bitmap.Clip.Bottom) Y = Bitmap.Clip.Bottom - 1;
-            return Bitmap.Data + (Y * Bitmap.LineWidth) + (X<<2);
-
-         case EM_WRAP:
-            while (X < Bitmap.Clip.Left) X += Bitmap.Clip.Right - Bitmap.Clip.Left;
-            X %= Bitmap.Clip.Right - Bitmap.Clip.Left;
-            while (Y < Bitmap.Clip.Top) Y += Bitmap.Clip.Bottom - Bitmap.Clip.Top;
-            Y %= Bitmap.Clip.Bottom - Bitmap.Clip.Top;
-            return Bitmap.Data + (Y * Bitmap.LineWidth) + (X<<2);
-      }
-   }
-
-   void apply(objVectorFilter *Self, struct effect *Filter)
-   {
-      objBitmap *bmp = Filter->Bitmap;
-      if (bmp->BytesPerPixel != 4) return;
-
-      const LONG canvasWidth = bmp->Clip.Right - bmp->Clip.Left;
-      const LONG canvasHeight = bmp->Clip.Bottom - bmp->Clip.Top;
-
-      if (canvasWidth * canvasHeight > 4096 * 4096) return; // Bail on really large bitmaps.
-
-      UBYTE *output = new (std::nothrow) UBYTE[canvasWidth * canvasHeight * bmp->BytesPerPixel];
-      if (!output) return;
-
-      if ((canvasWidth > FilterWidth*3) and (canvasHeight > FilterHeight*3)) {
-         const LONG ew = FilterWidth>>1;
-         const LONG eh = FilterHeight>>1;
-         processClipped(Filter, output,                       bmp->Clip.Left,     bmp->Clip.Top, bmp->Clip.Left+ew,  bmp->Clip.Bottom); // Left
-         processClipped(Filter, output+((canvasWidth-ew)*4),  bmp->Clip.Right-ew, bmp->Clip.Top, bmp->Clip.Right,    bmp->Clip.Bottom); // Right
-         processClipped(Filter, output+(ew*4),                bmp->Clip.Left+ew,  bmp->Clip.Top, bmp->Clip.Right-ew, bmp->Clip.Top+eh); // Top
-         processClipped(Filter, output+((canvasHeight-eh)*4*canvasWidth), bmp->Clip.Left+ew,  bmp->Clip.Bottom-eh, bmp->Clip.Right-ew, bmp->Clip.Bottom); // Bottom
-         // Center
-         processFast(Filter, output+(ew*4)+(canvasWidth*eh*4), bmp->Clip.Left+ew, bmp->Clip.Top+eh, bmp->Clip.Right-ew, bmp->Clip.Bottom-eh);
-      }
-      else processClipped(Filter, output, bmp->Clip.Left, bmp->Clip.Top, bmp->Clip.Right, bmp->Clip.Bottom);
-
-      // Copy the resulting output back to the bitmap.
-
-      ULONG *pixel = (ULONG *)(bmp->Data + (bmp->Clip.Left<<2) + (bmp->Clip.Top * bmp->LineWidth));
-      ULONG *src   = (ULONG *)output;
-      for (LONG y=0; y < canvasHeight; y++) {
-         for (LONG x=0; x < canvasWidth; x++) pixel[x] = src[x];
-         pixel += bmp->LineWidth>>2;
-         src += canvasWidth;
-      }
+The ConvolveMatrix class, which performs the convolution, is defined in filter_pixels.cpp.
 
-      delete [] output;
-   }
-
-   void processClipped(struct effect *Filter, UBYTE *output, LONG Left, LONG Top, LONG Right, LONG Bottom)
-   {
-      objBitmap *bmp = Filter->Bitmap;
-
-      const UBYTE A = bmp->ColourFormat->AlphaPos>>3;
-      const UBYTE R = bmp->ColourFormat->RedPos>>3;
-      const UBYTE G = bmp->ColourFormat->GreenPos>>3;
-      const UBYTE B = bmp->ColourFormat->BluePos>>3;
-
-      const DOUBLE factor = 1.0 / Divisor;
-
-      UBYTE *input = bmp->Data + (Top * bmp->LineWidth);
-      UBYTE *outline = output;
-      for (LONG y=Top; y < Bottom; y++) {
-         UBYTE *out = outline;
-         for (LONG x=Left; x < Right; x++) {
-            DOUBLE r = 0.0, g = 0.0, b = 0.0, a = 0.0;
-
-            // Multiply every value of the filter with corresponding image pixel
-
-            UBYTE kv = 0;
-            for (int fy=y-TargetY; fy < y+FilterHeight-TargetY; fy++) {
-               for (int fx=x-TargetX; fx < x+FilterWidth-TargetX; fx++) {
-                  UBYTE *pixel = getPixel(*bmp, fx, fy);
-                  if (pixel) {
-                     r += pixel[R] * KernelMatrix[kv];
-                     g += pixel[G] * KernelMatrix[kv];
-                     b += pixel[B] * KernelMatrix[kv];
-                     a += pixel[A] * KernelMatrix[kv];
-                  }
-                  kv++;
-               }
-            }
-
-            LONG lr = F2I((factor * r) + Bias);
-            LONG lg = F2I((factor * g) + Bias);
-            LONG lb = F2I((factor * b) + Bias);
-            out[R] = MIN(MAX(lr, 0), 255);
-            out[G] = MIN(MAX(lg, 0), 255);
-            out[B] = MIN(MAX(lb, 0), 255);
-            if (!PreserveAlpha) out[A] = MIN(MAX(F2I(factor * a + Bias), 0), 255);
-            else out[A] = (input + (x<<2))[A];
-            out += 4;
-         }
-         input += bmp->LineWidth;
-         outline += (bmp->Clip.Right - bmp->Clip.Left)<<2;
-      }
-   }
-
-   // This algorithm is unclipped and performs no edge detection, so is unsafe to use near the edge of the bitmap.
-
-   void processFast(struct effect *Filter, UBYTE *output, LONG Left, LONG Top, LONG Right, LONG Bottom)
-   {
-      objBitmap *bmp = Filter->Bitmap;
-
-      const UBYTE A = bmp->ColourFormat->AlphaPos>>3;
-      const UBYTE R = bmp->ColourFormat->RedPos>>3;
-      const UBYTE G = bmp->ColourFormat->GreenPos>>3;
-      const UBYTE B = bmp->ColourFormat->BluePos>>3;
-
-      const DOUBLE factor = 1.0 / Divisor;
-
-      UBYTE *input = bmp->Data + (Top * bmp->LineWidth);
-      for (LONG y=Top; y < Bottom; y++) {
-         UBYTE *out = output;
-         UBYTE *filterEdge = bmp->Data + (y-TargetY) * bmp->LineWidth;
-         for (LONG x=Left; x < Right; x++) {
-            DOUBLE r = 0.0, g = 0.0, b = 0.0, a = 0.0;
-            UBYTE kv = 0;
-            const LONG fxs = x-TargetX;
-            const LONG fxe = x+FilterWidth-TargetX;
-            UBYTE *currentLine = filterEdge;
-            for (int fy=y-TargetY; fy < y+FilterHeight-TargetY; fy++) {
-               UBYTE *pixel = currentLine + (fxs<<2);
-               for (int fx=fxs; fx < fxe; fx++) {
-                  r += pixel[R] * KernelMatrix[kv];
-                  g += pixel[G] * KernelMatrix[kv];
-                  b += pixel[B] * KernelMatrix[kv];
-                  a += pixel[A] * KernelMatrix[kv];
-                  pixel += 4;
-                  kv++;
-               }
-               currentLine += bmp->LineWidth;
-            }
-
-            LONG lr = F2I((factor * r) + Bias);
-            LONG lg = F2I((factor * g) + Bias);
-            LONG lb = F2I((factor * b) + Bias);
-            out[R] = MIN(MAX(lr, 0), 255);
-            out[G] = MIN(MAX(lg, 0), 255);
-            out[B] = MIN(MAX(lb, 0), 255);
-            if (!PreserveAlpha) out[A] = MIN(MAX(F2I(factor * a + Bias), 0), 255);
-            else out[A] = (input + (x<<2))[A];
-            out += 4;
-         }
-         input += bmp->LineWidth;
-         output += (bmp->Clip.Right - bmp->Clip.Left)<<2;
-      }
-   }
-};
+*****************************************************************************/
 
 /*****************************************************************************
 ** Internal: apply_convolve()
@@ -203,7 +11,7 @@ public:
 static void apply_convolve(objVectorFilter *Self, struct effect *Filter)
 {
    if (!Filter->Convolve.Matrix) return;
-   Filter->Convolve.Matrix->apply(Self, Filter);
+   Filter->Convolve.Matrix->apply(Filter->Bitmap);
 }
 
 //****************************************************************************
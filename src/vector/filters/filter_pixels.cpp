@@ -0,0 +1,1102 @@
+/*****************************************************************************
+
+Pixel processing for the filter effects.  The routines in this file operate on the clipping region of 32-bit bitmaps
+and have no dependency on the VectorFilter class.
+
+Work is split into bands of rows (or columns) that are distributed across the worker pool of the Core with
+ThreadBatch() when the bitmap is large enough to justify it.  SSE2 code paths are used when glSpanISA permits it.  They
+use the same arithmetic as the scalar code and produce identical results, so glSpanISA can be set to SPAN_SCALAR to
+obtain reference output.
+
+*****************************************************************************/
+
+#include <array>
+
+#define MIN_FILTER_BAND     32    // Minimum number of rows or columns in a band
+#define MIN_PARALLEL_PIXELS 65536 // Bitmaps with fewer pixels than this are processed by the caller only
+#define BOX_BLUR_DEVIATION  127.0 // Larger deviations exceed the maximum radius of the stack blur
+#define MAX_BOX_SIZE        16384
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define FILTER_SSE2
+#include <emmintrin.h>
+#define SSE2_INLINE static inline __attribute__((target("sse2"), always_inline))
+#define SSE2_ROUTINE static __attribute__((target("sse2")))
+#endif
+
+typedef void BAND_ROUTINE(APTR Data, LONG Start, LONG End);
+
+struct band_batch {
+   BAND_ROUTINE *Routine;
+   APTR Data;
+   LONG Total;
+   LONG Bands;
+};
+
+INLINE UBYTE * clip_data(objBitmap *Bitmap)
+{
+   return Bitmap->Data + (Bitmap->Clip.Left<<2) + (Bitmap->Clip.Top * Bitmap->LineWidth);
+}
+
+//****************************************************************************
+
+static void process_band(APTR Data, LONG Index)
+{
+   auto batch = (band_batch *)Data;
+   batch->Routine(batch->Data, (batch->Total * Index) / batch->Bands, (batch->Total * (Index + 1)) / batch->Bands);
+}
+
+// Calls Routine for the range 0 to Total-1, where Total is a count of rows or columns that are Length pixels long.
+// The range is divided into bands that are processed in parallel if the area is large enough.
+
+static void process_bands(BAND_ROUTINE *Routine, APTR Data, LONG Total, LONG Length)
+{
+   LONG bands = 1;
+   if (LARGE(Total) * LARGE(Length) >= MIN_PARALLEL_PIXELS) {
+      bands = GetResource(RES_THREAD_POOL);
+      if (bands > Total / MIN_FILTER_BAND) bands = Total / MIN_FILTER_BAND;
+   }
+
+   if (bands < 2) Routine(Data, 0, Total);
+   else {
+      band_batch batch = { Routine, Data, Total, bands };
+      ThreadBatch(&process_band, &batch, bands);
+   }
+}
+
+//****************************************************************************
+// Alpha premultiplication.  The SSE2 routines process four pixels at a time and extract each channel with a shift, so
+// they work for any channel order.  Groups of opaque pixels are skipped as they are unaffected.
+
+#ifdef FILTER_SSE2
+
+SSE2_INLINE __m128i premultiply_channel(__m128i Pixels, __m128i Alpha, __m128i Shift)
+{
+   const __m128i c = _mm_and_si128(_mm_srl_epi32(Pixels, Shift), _mm_set1_epi32(0xff));
+   // The product fits in the low 16 bits of each lane.
+   const __m128i v = _mm_srli_epi32(_mm_add_epi32(_mm_mullo_epi16(c, Alpha), _mm_set1_epi32(0xff)), 8);
+   return _mm_sll_epi32(v, Shift);
+}
+
+SSE2_ROUTINE LONG premultiply_sse2(UBYTE *Pixel, LONG Width, const ColourFormat *Format)
+{
+   const __m128i ashift = _mm_cvtsi32_si128(Format->AlphaPos);
+   const __m128i rshift = _mm_cvtsi32_si128(Format->RedPos);
+   const __m128i gshift = _mm_cvtsi32_si128(Format->GreenPos);
+   const __m128i bshift = _mm_cvtsi32_si128(Format->BluePos);
+   const __m128i amask  = _mm_sll_epi32(_mm_set1_epi32(0xff), ashift);
+
+   LONG x;
+   for (x=0; x+4 <= Width; x += 4, Pixel += 16) {
+      const __m128i px = _mm_loadu_si128((const __m128i *)Pixel);
+      const __m128i alpha = _mm_and_si128(px, amask);
+      if (_mm_movemask_epi8(_mm_cmpeq_epi32(alpha, amask)) IS 0xffff) continue;
+
+      const __m128i a = _mm_srl_epi32(alpha, ashift);
+      __m128i out = _mm_or_si128(alpha, premultiply_channel(px, a, rshift));
+      out = _mm_or_si128(out, premultiply_channel(px, a, gshift));
+      out = _mm_or_si128(out, premultiply_channel(px, a, bshift));
+      _mm_storeu_si128((__m128i *)Pixel, out);
+   }
+   return x;
+}
+
+// Computes (c * 255) / a with truncation.  The single precision quotient is exact enough for truncation to give the
+// same result as integer division whenever it is less than 256, and larger values are clamped.
+
+SSE2_INLINE __m128i demultiply_channel(__m128i Pixels, __m128 Alpha, __m128i Shift)
+{
+   const __m128i byte = _mm_set1_epi32(0xff);
+   const __m128i c = _mm_and_si128(_mm_srl_epi32(Pixels, Shift), byte);
+   __m128i v = _mm_cvttps_epi32(_mm_div_ps(_mm_cvtepi32_ps(_mm_mullo_epi16(c, byte)), Alpha));
+   const __m128i over = _mm_cmpgt_epi32(v, byte);
+   v = _mm_or_si128(_mm_and_si128(over, byte), _mm_andnot_si128(over, v));
+   return _mm_sll_epi32(v, Shift);
+}
+
+SSE2_ROUTINE LONG demultiply_sse2(UBYTE *Pixel, LONG Width, const ColourFormat *Format)
+{
+   const __m128i ashift = _mm_cvtsi32_si128(Format->AlphaPos);
+   const __m128i rshift = _mm_cvtsi32_si128(Format->RedPos);
+   const __m128i gshift = _mm_cvtsi32_si128(Format->GreenPos);
+   const __m128i bshift = _mm_cvtsi32_si128(Format->BluePos);
+   const __m128i amask  = _mm_sll_epi32(_mm_set1_epi32(0xff), ashift);
+   const __m128i zero   = _mm_setzero_si128();
+
+   LONG x;
+   for (x=0; x+4 <= Width; x += 4, Pixel += 16) {
+      const __m128i px = _mm_loadu_si128((const __m128i *)Pixel);
+      const __m128i alpha = _mm_and_si128(px, amask);
+      if (_mm_movemask_epi8(_mm_cmpeq_epi32(alpha, amask)) IS 0xffff) continue;
+
+      const __m128 a = _mm_cvtepi32_ps(_mm_srl_epi32(alpha, ashift));
+      __m128i out = _mm_or_si128(alpha, demultiply_channel(px, a, rshift));
+      out = _mm_or_si128(out, demultiply_channel(px, a, gshift));
+      out = _mm_or_si128(out, demultiply_channel(px, a, bshift));
+      out = _mm_andnot_si128(_mm_cmpeq_epi32(alpha, zero), out); // Pixels with no alpha are cleared
+      _mm_storeu_si128((__m128i *)Pixel, out);
+   }
+   return x;
+}
+
+#endif
+
+static void premultiply_rows(APTR Data, LONG Start, LONG End)
+{
+   auto bmp = (objBitmap *)Data;
+
+   const UBYTE A = bmp->ColourFormat->AlphaPos>>3;
+   const UBYTE R = bmp->ColourFormat->RedPos>>3;
+   const UBYTE G = bmp->ColourFormat->GreenPos>>3;
+   const UBYTE B = bmp->ColourFormat->BluePos>>3;
+
+   const LONG w = bmp->Clip.Right - bmp->Clip.Left;
+   UBYTE *data = clip_data(bmp);
+
+   for (LONG y=Start; y < End; y++) {
+      UBYTE *pixel = data + (bmp->LineWidth * y);
+      LONG x = 0;
+#ifdef FILTER_SSE2
+      if (glSpanISA >= SPAN_SSE2) {
+         x = premultiply_sse2(pixel, w, bmp->ColourFormat);
+         pixel += x<<2;
+      }
+#endif
+      for (; x < w; x++) {
+         UBYTE a = pixel[A];
+         if (a < 0xff) {
+             if (a == 0) pixel[R] = pixel[G] = pixel[B] = 0;
+             else {
+                pixel[R] = UBYTE((pixel[R] * a + 0xff) >> 8);
+                pixel[G] = UBYTE((pixel[G] * a + 0xff) >> 8);
+                pixel[B] = UBYTE((pixel[B] * a + 0xff) >> 8);
+             }
+         }
+         pixel += 4;
+      }
+   }
+}
+
+static void demultiply_rows(APTR Data, LONG Start, LONG End)
+{
+   auto bmp = (objBitmap *)Data;
+
+   const UBYTE A = bmp->ColourFormat->AlphaPos>>3;
+   const UBYTE R = bmp->ColourFormat->RedPos>>3;
+   const UBYTE G = bmp->ColourFormat->GreenPos>>3;
+   const UBYTE B = bmp->ColourFormat->BluePos>>3;
+
+   const LONG w = bmp->Clip.Right - bmp->Clip.Left;
+   UBYTE *data = clip_data(bmp);
+
+   for (LONG y=Start; y < End; y++) {
+      UBYTE *pixel = data + (bmp->LineWidth * y);
+      LONG x = 0;
+#ifdef FILTER_SSE2
+      if (glSpanISA >= SPAN_SSE2) {
+         x = demultiply_sse2(pixel, w, bmp->ColourFormat);
+         pixel += x<<2;
+      }
+#endif
+      for (; x < w; x++) {
+         UBYTE a = pixel[A];
+         if (a < 0xff) {
+            if (a == 0) pixel[R] = pixel[G] = pixel[B] = 0;
+            else {
+               ULONG r = (ULONG(pixel[R]) * 0xff) / a;
+               ULONG g = (ULONG(pixel[G]) * 0xff) / a;
+               ULONG b = (ULONG(pixel[B]) * 0xff) / a;
+               pixel[R] = UBYTE((r > 0xff) ? 0xff : r);
+               pixel[G] = UBYTE((g > 0xff) ? 0xff : g);
+               pixel[B] = UBYTE((b > 0xff) ? 0xff : b);
+            }
+         }
+         pixel += 4;
+      }
+   }
+}
+
+static void premultiply_bitmap(objBitmap *bmp)
+{
+   process_bands(&premultiply_rows, bmp, bmp->Clip.Bottom - bmp->Clip.Top, bmp->Clip.Right - bmp->Clip.Left);
+}
+
+static void demultiply_bitmap(objBitmap *bmp)
+{
+   process_bands(&demultiply_rows, bmp, bmp->Clip.Bottom - bmp->Clip.Top, bmp->Clip.Right - bmp->Clip.Left);
+}
+
+/*****************************************************************************
+** Gaussian blur.  The stack blur algorithm originally implemented in AGG is used where possible, as it is about twice
+** as fast as three box blurs.  Its radius is limited to 254 pixels, so deviations beyond that use the three-pass box
+** blur that is suggested by the SVG specification, which also has a constant cost per pixel.  Both are separable, so the rows and the columns are processed as independent lines.
+** The four channels of a pixel receive identical treatment, so their order is irrelevant.
+*/
+
+template<class T> struct stack_blur_tables
+{
+  static UWORD const g_stack_blur8_mul[255];
+  static UBYTE  const g_stack_blur8_shr[255];
+};
+
+//------------------------------------------------------------------------
+template<class T>
+UWORD const stack_blur_tables<T>::g_stack_blur8_mul[255] =
+{
+  512,512,456,512,328,456,335,512,405,328,271,456,388,335,292,512,
+  454,405,364,328,298,271,496,456,420,388,360,335,312,292,273,512,
+  482,454,428,405,383,364,345,328,312,298,284,271,259,496,475,456,
+  437,420,404,388,374,360,347,335,323,312,302,292,282,273,265,512,
+  497,482,468,454,441,428,417,405,394,383,373,364,354,345,337,328,
+  320,312,305,298,291,284,278,271,265,259,507,496,485,475,465,456,
+  446,437,428,420,412,404,396,388,381,374,367,360,354,347,341,335,
+  329,323,318,312,307,302,297,292,287,282,278,273,269,265,261,512,
+  505,497,489,482,475,468,461,454,447,441,435,428,422,417,411,405,
+  399,394,389,383,378,373,368,364,359,354,350,345,341,337,332,328,
+  324,320,316,312,309,305,301,298,294,291,287,284,281,278,274,271,
+  268,265,262,259,257,507,501,496,491,485,480,475,470,465,460,456,
+  451,446,442,437,433,428,424,420,416,412,408,404,400,396,392,388,
+  385,381,377,374,370,367,363,360,357,354,350,347,344,341,338,335,
+  332,329,326,323,320,318,315,312,310,307,304,302,299,297,294,292,
+  289,287,285,282,280,278,275,273,271,269,267,265,263,261,259
+};
+
+//------------------------------------------------------------------------
+template<class T>
+UBYTE const stack_blur_tables<T>::g_stack_blur8_shr[255] =
+{
+    9, 11, 12, 13, 13, 14, 14, 15, 15, 15, 15, 16, 16, 16, 16, 17,
+   17, 17, 17, 17, 17, 17, 18, 18, 18, 18, 18, 18, 18, 18, 18, 19,
+   19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 20, 20, 20,
+   20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 21,
+   21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21,
+   21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 22, 22, 22, 22, 22, 22,
+   22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22,
+   22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 23,
+   23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23,
+   23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23,
+   23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23,
+   23, 23, 23, 23, 23, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24,
+   24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24,
+   24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24,
+   24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24,
+   24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24
+};
+
+struct blur_job {
+   objBitmap *Bitmap;
+   UBYTE *Data;
+   LONG Width, Height;
+   ULONG Radius;  // Radius of the stack blur, or zero if a box blur is to be used
+   LONG BoxSize;  // Width of the box blur
+};
+
+//****************************************************************************
+// Blurs a line of Length pixels that are Step bytes apart.  Every entry of the Stack holds the four channels of a pixel
+// and there must be room for (Radius * 2) + 1 entries.
+
+static void stack_blur_line(UBYTE *Data, LONG Length, LONG Step, ULONG Radius, ULONG *Stack)
+{
+   const ULONG div     = Radius * 2 + 1;
+   const ULONG mul_sum = stack_blur_tables<int>::g_stack_blur8_mul[Radius];
+   const ULONG shr_sum = stack_blur_tables<int>::g_stack_blur8_shr[Radius];
+   const ULONG wm      = Length - 1;
+
+   ULONG sum[4] = { 0, 0, 0, 0 }, sum_in[4] = { 0, 0, 0, 0 }, sum_out[4] = { 0, 0, 0, 0 };
+
+   const UBYTE *src = Data;
+   for (ULONG i=0; i <= Radius; i++) {
+      ULONG *stack = Stack + (i<<2);
+      for (LONG c=0; c < 4; c++) {
+         stack[c] = src[c];
+         sum[c] += src[c] * (i + 1);
+         sum_out[c] += src[c];
+      }
+   }
+
+   for (ULONG i=1; i <= Radius; i++) {
+      if (i <= wm) src += Step;
+      ULONG *stack = Stack + ((i + Radius)<<2);
+      for (LONG c=0; c < 4; c++) {
+         stack[c] = src[c];
+         sum[c] += src[c] * (Radius + 1 - i);
+         sum_in[c] += src[c];
+      }
+   }
+
+   ULONG stack_ptr = Radius;
+   ULONG xp = (Radius > wm) ? wm : Radius;
+   src = Data + (xp * Step);
+   UBYTE *dst = Data;
+   for (LONG x=0; x < Length; x++) {
+      ULONG stack_start = stack_ptr + div - Radius;
+      if (stack_start >= div) stack_start -= div;
+      ULONG *stack = Stack + (stack_start<<2);
+
+      if (xp < wm) {
+         src += Step;
+         xp++;
+      }
+
+      if (++stack_ptr >= div) stack_ptr = 0;
+      const ULONG *next = Stack + (stack_ptr<<2);
+
+      for (LONG c=0; c < 4; c++) {
+         dst[c] = (sum[c] * mul_sum) >> shr_sum;
+         sum[c]     -= sum_out[c];
+         sum_out[c] -= stack[c];
+         stack[c]    = src[c];
+         sum_in[c]  += src[c];
+         sum[c]     += sum_in[c];
+         sum_out[c] += next[c];
+         sum_in[c]  -= next[c];
+      }
+      dst += Step;
+   }
+}
+
+// Blurs a line of Length pixels with a box of Low to High pixels, relative to each pixel.  Out of range pixels are
+// clamped to the ends of the line.
+
+static void box_blur_line(const ULONG *Src, ULONG *Dest, LONG Length, LONG Low, LONG High)
+{
+   const ULONG mul = ((1<<24) + ((High - Low + 1)>>1)) / (High - Low + 1);
+
+   ULONG sum[4] = { 0, 0, 0, 0 };
+   for (LONG k=Low; k <= High; k++) {
+      const UBYTE *pixel = (const UBYTE *)(Src + ((k < 0) ? 0 : (k >= Length) ? Length - 1 : k));
+      for (LONG c=0; c < 4; c++) sum[c] += pixel[c];
+   }
+
+   for (LONG x=0; x < Length; x++) {
+      UBYTE *out = (UBYTE *)(Dest + x);
+      for (LONG c=0; c < 4; c++) {
+         const ULONG v = (LARGE(sum[c]) * mul + (1<<23)) >> 24;
+         out[c] = (v > 0xff) ? 0xff : v;
+      }
+
+      const LONG add = x + High + 1, sub = x + Low;
+      const UBYTE *in  = (const UBYTE *)(Src + ((add >= Length) ? Length - 1 : add));
+      const UBYTE *out_px = (const UBYTE *)(Src + ((sub < 0) ? 0 : sub));
+      for (LONG c=0; c < 4; c++) sum[c] += in[c] - out_px[c];
+   }
+}
+
+#ifdef FILTER_SSE2
+
+SSE2_INLINE __m128i unpack_pixel(const UBYTE *Pixel)
+{
+   const __m128i zero = _mm_setzero_si128();
+   ULONG value;
+   memcpy(&value, Pixel, sizeof(value));
+   return _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(value), zero), zero);
+}
+
+SSE2_INLINE void pack_pixel(UBYTE *Pixel, __m128i Value)
+{
+   const ULONG value = _mm_cvtsi128_si32(_mm_packus_epi16(_mm_packs_epi32(Value, Value), Value));
+   memcpy(Pixel, &value, sizeof(value));
+}
+
+// Computes ((Value * Mul) + Round) >> Shift for each 32-bit lane without overflow.
+
+SSE2_INLINE __m128i mul_shift(__m128i Value, __m128i Mul, __m128i Round, __m128i Shift)
+{
+   const __m128i even = _mm_srl_epi64(_mm_add_epi64(_mm_mul_epu32(Value, Mul), Round), Shift);
+   const __m128i odd  = _mm_srl_epi64(_mm_add_epi64(_mm_mul_epu32(_mm_srli_epi64(Value, 32), Mul), Round), Shift);
+   return _mm_or_si128(even, _mm_slli_epi64(odd, 32));
+}
+
+SSE2_ROUTINE void stack_blur_line_sse2(UBYTE *Data, LONG Length, LONG Step, ULONG Radius, ULONG *Stack)
+{
+   const ULONG div = Radius * 2 + 1;
+   const ULONG wm  = Length - 1;
+   const __m128i mul_sum = _mm_set1_epi32(stack_blur_tables<int>::g_stack_blur8_mul[Radius]);
+   const __m128i shr_sum = _mm_cvtsi32_si128(stack_blur_tables<int>::g_stack_blur8_shr[Radius]);
+   const __m128i round   = _mm_setzero_si128();
+
+   __m128i sum = _mm_setzero_si128(), sum_in = _mm_setzero_si128(), sum_out = _mm_setzero_si128();
+
+   const UBYTE *src = Data;
+   __m128i px = unpack_pixel(src);
+   for (ULONG i=0; i <= Radius; i++) {
+      _mm_storeu_si128((__m128i *)(Stack + (i<<2)), px);
+      sum = _mm_add_epi32(sum, _mm_mullo_epi16(px, _mm_set1_epi32(i + 1)));
+      sum_out = _mm_add_epi32(sum_out, px);
+   }
+
+   for (ULONG i=1; i <= Radius; i++) {
+      if (i <= wm) {
+         src += Step;
+         px = unpack_pixel(src);
+      }
+      _mm_storeu_si128((__m128i *)(Stack + ((i + Radius)<<2)), px);
+      sum = _mm_add_epi32(sum, _mm_mullo_epi16(px, _mm_set1_epi32(Radius + 1 - i)));
+      sum_in = _mm_add_epi32(sum_in, px);
+   }
+
+   ULONG stack_ptr = Radius;
+   ULONG xp = (Radius > wm) ? wm : Radius;
+   src = Data + (xp * Step);
+   px = unpack_pixel(src);
+   UBYTE *dst = Data;
+   for (LONG x=0; x < Length; x++) {
+      pack_pixel(dst, mul_shift(sum, mul_sum, round, shr_sum));
+      dst += Step;
+
+      sum = _mm_sub_epi32(sum, sum_out);
+
+      ULONG stack_start = stack_ptr + div - Radius;
+      if (stack_start >= div) stack_start -= div;
+      __m128i *stack = (__m128i *)(Stack + (stack_start<<2));
+      sum_out = _mm_sub_epi32(sum_out, _mm_loadu_si128(stack));
+
+      if (xp < wm) {
+         src += Step;
+         xp++;
+         px = unpack_pixel(src);
+      }
+
+      _mm_storeu_si128(stack, px);
+      sum_in = _mm_add_epi32(sum_in, px);
+      sum = _mm_add_epi32(sum, sum_in);
+
+      if (++stack_ptr >= div) stack_ptr = 0;
+      const __m128i next = _mm_loadu_si128((const __m128i *)(Stack + (stack_ptr<<2)));
+      sum_out = _mm_add_epi32(sum_out, next);
+      sum_in = _mm_sub_epi32(sum_in, next);
+   }
+}
+
+SSE2_ROUTINE void box_blur_line_sse2(const ULONG *Src, ULONG *Dest, LONG Length, LONG Low, LONG High)
+{
+   const __m128i mul   = _mm_set1_epi32(((1<<24) + ((High - Low + 1)>>1)) / (High - Low + 1));
+   const __m128i round = _mm_set1_epi64x(1<<23);
+   const __m128i shift = _mm_cvtsi32_si128(24);
+
+   __m128i sum = _mm_setzero_si128();
+   for (LONG k=Low; k <= High; k++) {
+      sum = _mm_add_epi32(sum, unpack_pixel((const UBYTE *)(Src + ((k < 0) ? 0 : (k >= Length) ? Length - 1 : k))));
+   }
+
+   for (LONG x=0; x < Length; x++) {
+      pack_pixel((UBYTE *)(Dest + x), mul_shift(sum, mul, round, shift));
+
+      const LONG add = x + High + 1, sub = x + Low;
+      sum = _mm_add_epi32(sum, unpack_pixel((const UBYTE *)(Src + ((add >= Length) ? Length - 1 : add))));
+      sum = _mm_sub_epi32(sum, unpack_pixel((const UBYTE *)(Src + ((sub < 0) ? 0 : sub))));
+   }
+}
+
+#endif
+
+// Applies the three box blurs to a line.  Line and Temp must both have room for Length pixels, and the result is
+// returned in Line.  An even box size is split into two boxes that are offset in opposite directions and a third that
+// is one pixel wider, as per the SVG specification.
+
+static void box_blur(ULONG *Line, ULONG *Temp, LONG Length, LONG BoxSize)
+{
+   const LONG half = BoxSize>>1;
+   LONG low[3], high[3];
+   if (BoxSize & 1) {
+      low[0] = low[1] = low[2] = -half;
+      high[0] = high[1] = high[2] = half;
+   }
+   else {
+      low[0] = -half;     high[0] = half - 1;
+      low[1] = -half + 1; high[1] = half;
+      low[2] = -half;     high[2] = half;
+   }
+
+   ULONG *src = Line, *dest = Temp;
+   for (LONG pass=0; pass < 3; pass++) {
+#ifdef FILTER_SSE2
+      if (glSpanISA >= SPAN_SSE2) box_blur_line_sse2(src, dest, Length, low[pass], high[pass]);
+      else box_blur_line(src, dest, Length, low[pass], high[pass]);
+#else
+      box_blur_line(src, dest, Length, low[pass], high[pass]);
+#endif
+      std::swap(src, dest);
+   }
+
+   if (src != Line) CopyMemory(src, Line, Length * sizeof(ULONG));
+}
+
+static void blur_line(blur_job *Job, UBYTE *Data, LONG Length, LONG Step, ULONG *Buffer)
+{
+   if (Job->Radius) {
+#ifdef FILTER_SSE2
+      if (glSpanISA >= SPAN_SSE2) stack_blur_line_sse2(Data, Length, Step, Job->Radius, Buffer);
+      else stack_blur_line(Data, Length, Step, Job->Radius, Buffer);
+#else
+      stack_blur_line(Data, Length, Step, Job->Radius, Buffer);
+#endif
+   }
+   else {
+      for (LONG i=0; i < Length; i++) memcpy(Buffer + i, Data + (i * Step), sizeof(ULONG));
+      box_blur(Buffer, Buffer + Length, Length, Job->BoxSize);
+      for (LONG i=0; i < Length; i++) memcpy(Data + (i * Step), Buffer + i, sizeof(ULONG));
+   }
+}
+
+static LONG blur_buffer_size(blur_job *Job, LONG Length)
+{
+   if (Job->Radius) return ((Job->Radius * 2) + 1) * 4;
+   else return Length * 2;
+}
+
+static void blur_rows(APTR Data, LONG Start, LONG End)
+{
+   auto job = (blur_job *)Data;
+   std::vector<ULONG> buffer(blur_buffer_size(job, job->Width));
+   for (LONG y=Start; y < End; y++) {
+      blur_line(job, job->Data + (y * job->Bitmap->LineWidth), job->Width, 4, buffer.data());
+   }
+}
+
+static void blur_columns(APTR Data, LONG Start, LONG End)
+{
+   auto job = (blur_job *)Data;
+   std::vector<ULONG> buffer(blur_buffer_size(job, job->Height));
+   for (LONG x=Start; x < End; x++) {
+      blur_line(job, job->Data + (x<<2), job->Height, job->Bitmap->LineWidth, buffer.data());
+   }
+}
+
+// Configures the job for a blur with standard deviation Dev.  Returns false if no blur is required.
+
+static bool blur_setup(blur_job &Job, DOUBLE Dev)
+{
+   if (Dev > BOX_BLUR_DEVIATION) {
+      Job.Radius  = 0;
+      Job.BoxSize = F2T(Dev * 3.0 * sqrt(2.0 * agg::pi) / 4.0 + 0.5);
+      if (Job.BoxSize > MAX_BOX_SIZE) Job.BoxSize = MAX_BOX_SIZE;
+      return true;
+   }
+
+   Job.Radius = Dev * 2;
+   return Job.Radius > 0;
+}
+
+static void blur_bitmap(objBitmap *Bitmap, DOUBLE DevX, DOUBLE DevY)
+{
+   if (Bitmap->BytesPerPixel != 4) return;
+
+   blur_job job;
+   job.Bitmap = Bitmap;
+   job.Data   = clip_data(Bitmap);
+   job.Width  = Bitmap->Clip.Right - Bitmap->Clip.Left;
+   job.Height = Bitmap->Clip.Bottom - Bitmap->Clip.Top;
+   if ((job.Width < 1) or (job.Height < 1)) return;
+
+   blur_job vjob = job;
+   const bool horizontal = blur_setup(job, DevX);
+   const bool vertical   = blur_setup(vjob, DevY);
+   if ((!horizontal) and (!vertical)) return;
+
+   // Premultiplying prevents the blur from picking up colour values in pixels where the alpha = 0.
+
+   premultiply_bitmap(Bitmap);
+   if (horizontal) process_bands(&blur_rows, &job, job.Height, job.Width);
+   if (vertical) process_bands(&blur_columns, &vjob, vjob.Width, vjob.Height);
+   demultiply_bitmap(Bitmap);
+}
+
+/*****************************************************************************
+** Morphology.  Each channel of a pixel is replaced with the minimum (erode) or maximum (dilate) value of the
+** channel in the surrounding rectangle, computed as a horizontal pass followed by a vertical pass.  The SSE2 path
+** operates on four whole pixels per instruction.
+*/
+
+struct morph_job {
+   objBitmap *Bitmap;
+   const UBYTE *Input;
+   UBYTE *Output;
+   LONG Width, Height;
+   LONG Radius;
+};
+
+template <bool Dilate> INLINE UBYTE morph_op(UBYTE A, UBYTE B)
+{
+   if (Dilate) return (A > B) ? A : B;
+   else return (A < B) ? A : B;
+}
+
+#ifdef FILTER_SSE2
+template <bool Dilate> SSE2_INLINE __m128i morph_op4(__m128i A, __m128i B)
+{
+   if (Dilate) return _mm_max_epu8(A, B);
+   else return _mm_min_epu8(A, B);
+}
+#endif
+
+// The window of each pixel covers Radius pixels either side of it in the row.
+
+template <bool Dilate> static void morph_rows(APTR Data, LONG Start, LONG End)
+{
+   auto job = (morph_job *)Data;
+   const LONG w = job->Width, r = job->Radius;
+
+   for (LONG y=Start; y < End; y++) {
+      const UBYTE *in = job->Input + (y * job->Bitmap->LineWidth);
+      UBYTE *out = job->Output + ((y * w)<<2);
+      LONG x = 0;
+      while (x < w) {
+         const LONG lo = (x - r < 0) ? 0 : x - r;
+#ifdef FILTER_SSE2
+         if ((glSpanISA >= SPAN_SSE2) and (x >= r) and (x + 3 + r < w)) {
+            const UBYTE *p = in + (lo<<2);
+            __m128i v = _mm_loadu_si128((const __m128i *)p);
+            for (LONG k=1; k <= r * 2; k++) {
+               v = morph_op4<Dilate>(v, _mm_loadu_si128((const __m128i *)(p + (k<<2))));
+            }
+            _mm_storeu_si128((__m128i *)(out + (x<<2)), v);
+            x += 4;
+            continue;
+         }
+#endif
+         const LONG hi = (x + r >= w) ? w - 1 : x + r;
+         UBYTE *dest = out + (x<<2);
+         for (LONG c=0; c < 4; c++) {
+            UBYTE v = in[(lo<<2) + c];
+            for (LONG k=lo+1; k <= hi; k++) v = morph_op<Dilate>(v, in[(k<<2) + c]);
+            dest[c] = v;
+         }
+         x++;
+      }
+   }
+}
+
+// The window of each pixel covers Radius pixels either side of it in the column.  Whole rows are combined, so that
+// memory is accessed sequentially.
+
+template <bool Dilate> static void morph_columns(APTR Data, LONG Start, LONG End)
+{
+   auto job = (morph_job *)Data;
+   const LONG bytes = job->Width<<2, r = job->Radius;
+
+   for (LONG y=Start; y < End; y++) {
+      const LONG lo = (y - r < 0) ? 0 : y - r;
+      const LONG hi = (y + r >= job->Height) ? job->Height - 1 : y + r;
+      UBYTE *out = job->Output + (y * bytes);
+      CopyMemory(job->Input + (lo * job->Bitmap->LineWidth), out, bytes);
+
+      for (LONG k=lo+1; k <= hi; k++) {
+         const UBYTE *in = job->Input + (k * job->Bitmap->LineWidth);
+         LONG i = 0;
+#ifdef FILTER_SSE2
+         if (glSpanISA >= SPAN_SSE2) {
+            for (; i+16 <= bytes; i += 16) {
+               _mm_storeu_si128((__m128i *)(out + i), morph_op4<Dilate>(_mm_loadu_si128((const __m128i *)(out + i)),
+                  _mm_loadu_si128((const __m128i *)(in + i))));
+            }
+         }
+#endif
+         for (; i < bytes; i++) out[i] = morph_op<Dilate>(out[i], in[i]);
+      }
+   }
+}
+
+static void morph_bitmap(objBitmap *Bitmap, LONG RX, LONG RY, bool Dilate)
+{
+   if (Bitmap->BytesPerPixel != 4) return;
+
+   morph_job job;
+   job.Bitmap = Bitmap;
+   job.Input  = clip_data(Bitmap);
+   job.Width  = Bitmap->Clip.Right - Bitmap->Clip.Left;
+   job.Height = Bitmap->Clip.Bottom - Bitmap->Clip.Top;
+
+   if ((job.Width < 1) or (job.Height < 1)) return;
+   if (job.Width * job.Height > 4096 * 4096) return; // Bail on really large bitmaps.
+
+   std::unique_ptr<UBYTE[]> output(new (std::nothrow) UBYTE[job.Width * job.Height * 4]);
+   if (!(job.Output = output.get())) return;
+
+   for (LONG pass=0; pass < 2; pass++) {
+      if ((job.Radius = pass ? RY : RX) <= 0) continue;
+
+      if (!pass) {
+         if (job.Radius > job.Width - 1) job.Radius = job.Width - 1;
+         process_bands(Dilate ? &morph_rows<true> : &morph_rows<false>, &job, job.Height, job.Width);
+      }
+      else {
+         if (job.Radius > job.Height - 1) job.Radius = job.Height - 1;
+         process_bands(Dilate ? &morph_columns<true> : &morph_columns<false>, &job, job.Height, job.Width);
+      }
+
+      // Copy the resulting output back to the bitmap.
+
+      UBYTE *pixel = clip_data(Bitmap);
+      for (LONG y=0; y < job.Height; y++) {
+         CopyMemory(job.Output + ((y * job.Width)<<2), pixel, job.Width<<2);
+         pixel += Bitmap->LineWidth;
+      }
+   }
+}
+
+/*****************************************************************************
+** Colour matrix.  The SSE2 path computes two channels per instruction in double precision, in the same order as the
+** scalar code.
+*/
+
+struct cmatrix_job {
+   objBitmap *Bitmap;
+   const DOUBLE *Matrix;
+};
+
+#ifdef FILTER_SSE2
+SSE2_ROUTINE void cmatrix_line_sse2(UBYTE *Pixel, LONG Width, const DOUBLE *M, UBYTE R, UBYTE G, UBYTE B, UBYTE A)
+{
+   const __m128d rg_r = _mm_setr_pd(M[0], M[5]),   rg_g = _mm_setr_pd(M[1], M[6]),   rg_b = _mm_setr_pd(M[2], M[7]);
+   const __m128d rg_a = _mm_setr_pd(M[3], M[8]),   rg_k = _mm_setr_pd(M[4], M[9]);
+   const __m128d ba_r = _mm_setr_pd(M[10], M[15]), ba_g = _mm_setr_pd(M[11], M[16]), ba_b = _mm_setr_pd(M[12], M[17]);
+   const __m128d ba_a = _mm_setr_pd(M[13], M[18]), ba_k = _mm_setr_pd(M[14], M[19]);
+   const __m128d half = _mm_set1_pd(0.5);
+
+   for (LONG x=0; x < Width; x++, Pixel += 4) {
+      const __m128d r = _mm_set1_pd(Pixel[R]);
+      const __m128d g = _mm_set1_pd(Pixel[G]);
+      const __m128d b = _mm_set1_pd(Pixel[B]);
+      const __m128d a = _mm_set1_pd(Pixel[A]);
+
+      __m128d rg = _mm_add_pd(half, _mm_mul_pd(r, rg_r));
+      __m128d ba = _mm_add_pd(half, _mm_mul_pd(r, ba_r));
+      rg = _mm_add_pd(rg, _mm_mul_pd(g, rg_g));
+      ba = _mm_add_pd(ba, _mm_mul_pd(g, ba_g));
+      rg = _mm_add_pd(rg, _mm_mul_pd(b, rg_b));
+      ba = _mm_add_pd(ba, _mm_mul_pd(b, ba_b));
+      rg = _mm_add_pd(rg, _mm_mul_pd(a, rg_a));
+      ba = _mm_add_pd(ba, _mm_mul_pd(a, ba_a));
+      rg = _mm_add_pd(rg, rg_k);
+      ba = _mm_add_pd(ba, ba_k);
+
+      const __m128i v = _mm_unpacklo_epi64(_mm_cvttpd_epi32(rg), _mm_cvttpd_epi32(ba));
+      const ULONG out = _mm_cvtsi128_si32(_mm_packus_epi16(_mm_packs_epi32(v, v), v));
+      Pixel[R] = out;
+      Pixel[G] = out>>8;
+      Pixel[B] = out>>16;
+      Pixel[A] = out>>24;
+   }
+}
+#endif
+
+static void cmatrix_rows(APTR Data, LONG Start, LONG End)
+{
+   auto job = (cmatrix_job *)Data;
+   objBitmap *bmp = job->Bitmap;
+   const DOUBLE *matrix = job->Matrix;
+
+   const UBYTE A = bmp->ColourFormat->AlphaPos>>3;
+   const UBYTE R = bmp->ColourFormat->RedPos>>3;
+   const UBYTE G = bmp->ColourFormat->GreenPos>>3;
+   const UBYTE B = bmp->ColourFormat->BluePos>>3;
+
+   const LONG w = bmp->Clip.Right - bmp->Clip.Left;
+   UBYTE *data = clip_data(bmp);
+
+   for (LONG y=Start; y < End; y++) {
+      UBYTE *pixel = data + (bmp->LineWidth * y);
+
+#ifdef FILTER_SSE2
+      if (glSpanISA >= SPAN_SSE2) {
+         cmatrix_line_sse2(pixel, w, matrix, R, G, B, A);
+         continue;
+      }
+#endif
+
+      for (LONG x=0; x < w; x++) {
+         DOUBLE a = pixel[A];
+         DOUBLE r = pixel[R];
+         DOUBLE g = pixel[G];
+         DOUBLE b = pixel[B];
+
+         LONG r2 = 0.5 + (r * matrix[0]) + (g * matrix[1]) + (b * matrix[2]) + (a * matrix[3]) + matrix[4];
+         LONG g2 = 0.5 + (r * matrix[5]) + (g * matrix[6]) + (b * matrix[7]) + (a * matrix[8]) + matrix[9];
+         LONG b2 = 0.5 + (r * matrix[10]) + (g * matrix[11]) + (b * matrix[12]) + (a * matrix[13]) + matrix[14];
+         LONG a2 = 0.5 + (r * matrix[15]) + (g * matrix[16]) + (b * matrix[17]) + (a * matrix[18]) + matrix[19];
+
+         if (a2 < 0) pixel[A] = 0;
+         else if (a2 > 255) pixel[A] = 255;
+         else pixel[A] = a2;
+
+         if (r2 < 0)   pixel[R] = 0;
+         else if (r2 > 255) pixel[R] = 255;
+         else pixel[R] = r2;
+
+         if (g2 < 0) pixel[G] = 0;
+         else if (g2 > 255) pixel[G] = 255;
+         else pixel[G] = g2;
+
+         if (b2 < 0) pixel[B] = 0;
+         else if (b2 > 255) pixel[B] = 255;
+         else pixel[B] = b2;
+
+         pixel += 4;
+      }
+   }
+}
+
+// Matrix is a 5x4 colour matrix in row-major order.
+
+static void cmatrix_bitmap(objBitmap *Bitmap, const DOUBLE *Matrix)
+{
+   if (Bitmap->BytesPerPixel != 4) return;
+   cmatrix_job job = { Bitmap, Matrix };
+   process_bands(&cmatrix_rows, &job, Bitmap->Clip.Bottom - Bitmap->Clip.Top, Bitmap->Clip.Right - Bitmap->Clip.Left);
+}
+
+/*****************************************************************************
+** Convolution matrix.  Pixels that have the entire kernel within the bitmap take the fast path, which has no edge
+** handling.  The SSE2 path accumulates two channels per instruction in double precision, in the same order as the
+** scalar code.
+*/
+
+enum EdgeModeType { EM_DUPLICATE = 1, EM_WRAP, EM_NONE };
+
+#define MAX_DIM 9
+
+class ConvolveMatrix {
+public:
+
+   LONG TargetX, TargetY;
+   DOUBLE KernelUnitX, KernelUnitY;
+   UBYTE FilterWidth, FilterHeight;
+   UBYTE FilterSize;
+   DOUBLE Divisor;
+   DOUBLE Bias;
+   LONG EdgeMode;
+   bool PreserveAlpha;
+   std::array<DOUBLE, MAX_DIM * MAX_DIM> KernelMatrix;
+
+   ConvolveMatrix() :
+      KernelUnitX(1),
+      KernelUnitY(1),
+      FilterWidth(3),
+      FilterHeight(3),
+      FilterSize(0),
+      Divisor(0),
+      Bias(0),
+      EdgeMode(EM_DUPLICATE),
+      PreserveAlpha(false) { }
+
+   inline UBYTE * getPixel(objBitmap &Bitmap, LONG X, LONG Y) const {
+      if ((X >= Bitmap.Clip.Left) and (X < Bitmap.Clip.Right) and
+          (Y >= Bitmap.Clip.Top) and (Y < Bitmap.Clip.Bottom)) {
+         return Bitmap.Data + (Y * Bitmap.LineWidth) + (X<<2);
+      }
+
+      switch (EdgeMode) {
+         default: return NULL;
+
+         case EM_DUPLICATE:
+            if (X < Bitmap.Clip.Left) X = Bitmap.Clip.Left;
+            else if (X >= Bitmap.Clip.Right) X = Bitmap.Clip.Right - 1;
+            if (Y < Bitmap.Clip.Top) Y = Bitmap.Clip.Top;
+            else if (Y >= Bitmap.Clip.Bottom) Y = Bitmap.Clip.Bottom - 1;
+            return Bitmap.Data + (Y * Bitmap.LineWidth) + (X<<2);
+
+         case EM_WRAP:
+            while (X < Bitmap.Clip.Left) X += Bitmap.Clip.Right - Bitmap.Clip.Left;
+            X %= Bitmap.Clip.Right - Bitmap.Clip.Left;
+            while (Y < Bitmap.Clip.Top) Y += Bitmap.Clip.Bottom - Bitmap.Clip.Top;
+            Y %= Bitmap.Clip.Bottom - Bitmap.Clip.Top;
+            return Bitmap.Data + (Y * Bitmap.LineWidth) + (X<<2);
+      }
+   }
+
+   void apply(objBitmap *Bitmap)
+   {
+      if (Bitmap->BytesPerPixel != 4) return;
+
+      const LONG canvasWidth = Bitmap->Clip.Right - Bitmap->Clip.Left;
+      const LONG canvasHeight = Bitmap->Clip.Bottom - Bitmap->Clip.Top;
+
+      if ((canvasWidth < 1) or (canvasHeight < 1)) return;
+      if (canvasWidth * canvasHeight > 4096 * 4096) return; // Bail on really large bitmaps.
+
+      std::unique_ptr<UBYTE[]> output(new (std::nothrow) UBYTE[canvasWidth * canvasHeight * 4]);
+      if (!output) return;
+
+      job j = { this, Bitmap, output.get() };
+      process_bands(&process_rows, &j, canvasHeight, canvasWidth);
+
+      // Copy the resulting output back to the bitmap.
+
+      UBYTE *pixel = clip_data(Bitmap);
+      for (LONG y=0; y < canvasHeight; y++) {
+         CopyMemory(output.get() + ((y * canvasWidth)<<2), pixel, canvasWidth<<2);
+         pixel += Bitmap->LineWidth;
+      }
+   }
+
+private:
+   struct job {
+      ConvolveMatrix *Matrix;
+      objBitmap *Bitmap;
+      UBYTE *Output;
+   };
+
+   static void process_rows(APTR Data, LONG Start, LONG End)
+   {
+      auto j = (job *)Data;
+      objBitmap *bmp = j->Bitmap;
+      const ConvolveMatrix &cm = *j->Matrix;
+      const LONG canvasWidth = bmp->Clip.Right - bmp->Clip.Left;
+
+      // The range of pixels in each row that can use the fast path.
+
+      LONG fast_left  = bmp->Clip.Left + cm.TargetX;
+      LONG fast_right = bmp->Clip.Right - cm.FilterWidth + cm.TargetX + 1;
+      if (fast_left > bmp->Clip.Right) fast_left = bmp->Clip.Right;
+      if (fast_right < fast_left) fast_right = fast_left;
+
+      for (LONG y=bmp->Clip.Top+Start; y < bmp->Clip.Top+End; y++) {
+         UBYTE *out = j->Output + ((y - bmp->Clip.Top) * canvasWidth * 4);
+         if ((y - cm.TargetY < bmp->Clip.Top) or (y - cm.TargetY + cm.FilterHeight > bmp->Clip.Bottom)) {
+            cm.processClipped(bmp, out, bmp->Clip.Left, bmp->Clip.Right, y);
+         }
+         else {
+            cm.processClipped(bmp, out, bmp->Clip.Left, fast_left, y);
+            cm.processFast(bmp, out + ((fast_left - bmp->Clip.Left)<<2), fast_left, fast_right, y);
+            cm.processClipped(bmp, out + ((fast_right - bmp->Clip.Left)<<2), fast_right, bmp->Clip.Right, y);
+         }
+      }
+   }
+
+   // Processes the pixels from Left to Right on row Y, with edge handling.
+
+   void processClipped(objBitmap *bmp, UBYTE *out, LONG Left, LONG Right, LONG y) const
+   {
+      const UBYTE A = bmp->ColourFormat->AlphaPos>>3;
+      const UBYTE R = bmp->ColourFormat->RedPos>>3;
+      const UBYTE G = bmp->ColourFormat->GreenPos>>3;
+      const UBYTE B = bmp->ColourFormat->BluePos>>3;
+
+      const DOUBLE factor = 1.0 / Divisor;
+
+      UBYTE *input = bmp->Data + (y * bmp->LineWidth);
+      for (LONG x=Left; x < Right; x++) {
+         DOUBLE r = 0.0, g = 0.0, b = 0.0, a = 0.0;
+
+         // Multiply every value of the filter with corresponding image pixel
+
+         UBYTE kv = 0;
+         for (int fy=y-TargetY; fy < y+FilterHeight-TargetY; fy++) {
+            for (int fx=x-TargetX; fx < x+FilterWidth-TargetX; fx++) {
+               UBYTE *pixel = getPixel(*bmp, fx, fy);
+               if (pixel) {
+                  r += pixel[R] * KernelMatrix[kv];
+                  g += pixel[G] * KernelMatrix[kv];
+                  b += pixel[B] * KernelMatrix[kv];
+                  a += pixel[A] * KernelMatrix[kv];
+               }
+               kv++;
+            }
+         }
+
+         LONG lr = F2I((factor * r) + Bias);
+         LONG lg = F2I((factor * g) + Bias);
+         LONG lb = F2I((factor * b) + Bias);
+         out[R] = MIN(MAX(lr, 0), 255);
+         out[G] = MIN(MAX(lg, 0), 255);
+         out[B] = MIN(MAX(lb, 0), 255);
+         if (!PreserveAlpha) out[A] = MIN(MAX(F2I(factor * a + Bias), 0), 255);
+         else out[A] = (input + (x<<2))[A];
+         out += 4;
+      }
+   }
+
+   // This algorithm is unclipped and performs no edge detection, so the kernel must be entirely within the bitmap for
+   // every pixel from Left to Right.
+
+   void processFast(objBitmap *bmp, UBYTE *out, LONG Left, LONG Right, LONG y) const
+   {
+#ifdef FILTER_SSE2
+      if (glSpanISA >= SPAN_SSE2) {
+         processFastSSE2(bmp, out, Left, Right, y);
+         return;
+      }
+#endif
+
+      const UBYTE A = bmp->ColourFormat->AlphaPos>>3;
+      const UBYTE R = bmp->ColourFormat->RedPos>>3;
+      const UBYTE G = bmp->ColourFormat->GreenPos>>3;
+      const UBYTE B = bmp->ColourFormat->BluePos>>3;
+
+      const DOUBLE factor = 1.0 / Divisor;
+
+      UBYTE *input = bmp->Data + (y * bmp->LineWidth);
+      UBYTE *filterEdge = bmp->Data + (y-TargetY) * bmp->LineWidth;
+      for (LONG x=Left; x < Right; x++) {
+         DOUBLE r = 0.0, g = 0.0, b = 0.0, a = 0.0;
+         UBYTE kv = 0;
+         const LONG fxs = x-TargetX;
+         const LONG fxe = x+FilterWidth-TargetX;
+         UBYTE *currentLine = filterEdge;
+         for (int fy=y-TargetY; fy < y+FilterHeight-TargetY; fy++) {
+            UBYTE *pixel = currentLine + (fxs<<2);
+            for (int fx=fxs; fx < fxe; fx++) {
+               r += pixel[R] * KernelMatrix[kv];
+               g += pixel[G] * KernelMatrix[kv];
+               b += pixel[B] * KernelMatrix[kv];
+               a += pixel[A] * KernelMatrix[kv];
+               pixel += 4;
+               kv++;
+            }
+            currentLine += bmp->LineWidth;
+         }
+
+         LONG lr = F2I((factor * r) + Bias);
+         LONG lg = F2I((factor * g) + Bias);
+         LONG lb = F2I((factor * b) + Bias);
+         out[R] = MIN(MAX(lr, 0), 255);
+         out[G] = MIN(MAX(lg, 0), 255);
+         out[B] = MIN(MAX(lb, 0), 255);
+         if (!PreserveAlpha) out[A] = MIN(MAX(F2I(factor * a + Bias), 0), 255);
+         else out[A] = (input + (x<<2))[A];
+         out += 4;
+      }
+   }
+
+#ifdef FILTER_SSE2
+   // The channels are processed in memory order, which makes no difference to the result.
+
+   __attribute__((target("sse2"))) void processFastSSE2(objBitmap *bmp, UBYTE *out, LONG Left, LONG Right, LONG y) const
+   {
+      const UBYTE A = bmp->ColourFormat->AlphaPos>>3;
+      const __m128d factor = _mm_set1_pd(1.0 / Divisor);
+      const __m128d bias = _mm_set1_pd(Bias);
+      const __m128i zero = _mm_setzero_si128();
+
+      UBYTE *input = bmp->Data + (y * bmp->LineWidth);
+      UBYTE *filterEdge = bmp->Data + (y-TargetY) * bmp->LineWidth;
+      for (LONG x=Left; x < Right; x++) {
+         __m128d lo = _mm_setzero_pd(), hi = _mm_setzero_pd();
+         const DOUBLE *kernel = KernelMatrix.data();
+         const UBYTE *currentLine = filterEdge + ((x-TargetX)<<2);
+         for (LONG fy=0; fy < FilterHeight; fy++) {
+            const UBYTE *pixel = currentLine;
+            for (LONG fx=0; fx < FilterWidth; fx++) {
+               ULONG value;
+               memcpy(&value, pixel, sizeof(value));
+               const __m128i px = _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(value), zero), zero);
+               const __m128d k = _mm_set1_pd(*kernel++);
+               lo = _mm_add_pd(lo, _mm_mul_pd(_mm_cvtepi32_pd(px), k));
+               hi = _mm_add_pd(hi, _mm_mul_pd(_mm_cvtepi32_pd(_mm_srli_si128(px, 8)), k));
+               pixel += 4;
+            }
+            currentLine += bmp->LineWidth;
+         }
+
+         const __m128i ilo = _mm_cvtpd_epi32(_mm_add_pd(_mm_mul_pd(factor, lo), bias));
+         const __m128i ihi = _mm_cvtpd_epi32(_mm_add_pd(_mm_mul_pd(factor, hi), bias));
+         const __m128i v = _mm_unpacklo_epi64(ilo, ihi);
+         const ULONG result = _mm_cvtsi128_si32(_mm_packus_epi16(_mm_packs_epi32(v, v), v));
+         memcpy(out, &result, sizeof(result));
+         if (PreserveAlpha) out[A] = (input + (x<<2))[A];
+         out += 4;
+      }
+   }
+#endif
+};
@@ -1,2 +1,2 @@
 #undef MOD_IDL
-#define MOD_IDL "s.GradientStop:dOffset,eRGB:DRGB\ns.Transition:dOffset,sTransform\ns.VectorPoint:dX,dY,ucBit,ucBit\ns.PathCommand:ucType,ucCurved,ucLargeArc,ucSweep,lPad,dX,dY,dAbsX,dAbsY,dX2,dY2,dX3,dY3,dAngle\ns.VectorTransform:pNext:VectorTransform,pPrev:VectorTransform,dX,dY,dAngle,dMatrix[6],wType\nc.WVC:NONE=0x1,BOTTOM=0x3,TOP=0x2\nc.CS:LINEAR_RGB=0x2,SRGB=0x1,INHERIT=0x3\nc.VIJ:BEVEL=0x1,JAG=0x3,ROUND=0x4,INHERIT=0x5,MITER=0x2\nc.PE:Move=0x1,VLineRel=0x8,Smooth=0xb,Arc=0x11,VLine=0x7,Curve=0x9,QuadCurve=0xd,QuadSmooth=0xf,HLine=0x5,LineRel=0x4,ClosePath=0x13,ArcRel=0x12,MoveRel=0x2,HLineRel=0x6,Line=0x3,QuadCurveRel=0xe,SmoothRel=0xc,CurveRel=0xa,QuadSmoothRel=0x10\nc.VTXF:LINE_THROUGH=0x4,OVERLINE=0x2,BLINK=0x8,UNDERLINE=0x1\nc.VGF:FIXED_FY=0x10000,RELATIVE_X2=0x4,RELATIVE_X1=0x1,FIXED_X1=0x200,FIXED_Y2=0x1000,RELATIVE_CX=0x10,FIXED_RADIUS=0x20000,RELATIVE_RADIUS=0x100,RELATIVE_FX=0x40,FIXED_CX=0x2000,RELATIVE_Y2=0x8,RELATIVE_CY=0x20,FIXED_FX=0x8000,RELATIVE_FY=0x80,FIXED_Y1=0x400,FIXED_CY=0x4000,RELATIVE_Y1=0x2,FIXED_X2=0x800\nc.VSPREAD:REFLECT_Y=0x5,UNDEFINED=0x0,REPEAT=0x3,CLIP=0x6,REFLECT_X=0x4,PAD=0x1,END=0x7,REFLECT=0x2\nc.ARF:NONE=0x100,Y_MIN=0x8,Y_MAX=0x20,X_MID=0x2,X_MIN=0x1,X_MAX=0x4,SLICE=0x80,Y_MID=0x10,MEET=0x40\nc.VUNIT:END=0x3,UNDEFINED=0x0,BOUNDING_BOX=0x1,USERSPACE=0x2\nc.VMF:STRETCH=0x1,Y_MID=0x40,Y_MIN=0x20,X_MIN=0x4,X_MAX=0x10,Y_MAX=0x80,AUTO_SPACING=0x2,X_MID=0x8\nc.VTF:SKEW=0x10,TRANSLATE=0x2,MATRIX=0x1,SCALE=0x4,ROTATE=0x8\nc.VBF:INCLUSIVE=0x1,NO_TRANSFORM=0x2\nc.VPF:RENDER_TIME=0x2,BITMAP_SIZED=0x1,RESIZE=0x4\nc.VIS:COLLAPSE=0x2,VISIBLE=0x1,INHERIT=0x3,HIDDEN=0x0\nc.VTS:EXTRA_EXPANDED=0xb,SEMI_EXPANDED=0x9,NARROWER=0x3,ULTRA_EXPANDED=0xa,CONDENSED=0x6,NORMAL=0x1,EXPANDED=0x8,WIDER=0x2,EXTRA_CONDENSED=0x5,ULTRA_CONDENSED=0x4,INHERIT=0x0,SEMI_CONDENSED=0x7\nc.VLJ:MITER=0x0,ROUND=0x2,MITER_ROUND=0x4,MITER_REVERT=0x1,INHERIT=0x5,BEVEL=0x3\nc.VSM:BLACKMAN8=0xf,LANCZOS8=0xe,SPLINE16=0x4,MITCHELL=0x9,GAUSSIAN=0x7,SINC8=0xd,BLACKMAN3=0xc,AUTO=0x0,BICUBIC=0x3,LANCZOS3=0xb,BESSEL=0x8,KAISER=0x5,SINC3=0xa,NEIGHBOUR=0x1,QUADRIC=0x6,BILINEAR=0x2\nc.VLC:ROUND=0x3,SQUARE=0x2,INHERIT=0x4,BUTT=0x1\nc.VGT:CONTOUR=0x4,RADIAL=0x1,DIAMOND=0x3,CONIC=0x2,LINEAR=0x0\nc.RC:TRANSFORM=0x4,FINAL_PATH=0x1,ALL=0xff,BASE_PATH=0x2\nc.VFR:EVEN_ODD=0x2,END=0x4,INHERIT=0x3,NON_ZERO=0x1\nc.ARC:LARGE=0x1,SWEEP=0x2\n"
+#define MOD_IDL "s.GradientStop:dOffset,eRGB:DRGB\ns.Transition:dOffset,sTransform\ns.VectorPoint:dX,dY,ucBit,ucBit\ns.PathCommand:ucType,ucCurved,ucLargeArc,ucSweep,lPad,dX,dY,dAbsX,dAbsY,dX2,dY2,dX3,dY3,dAngle\ns.VectorTransform:pNext:VectorTransform,pPrev:VectorTransform,dX,dY,dAngle,dMatrix[6],wType\nc.WVC:NONE=0x1,BOTTOM=0x3,TOP=0x2\nc.CS:LINEAR_RGB=0x2,SRGB=0x1,INHERIT=0x3\nc.VIJ:BEVEL=0x1,JAG=0x3,ROUND=0x4,INHERIT=0x5,MITER=0x2\nc.PE:Move=0x1,VLineRel=0x8,Smooth=0xb,Arc=0x11,VLine=0x7,Curve=0x9,QuadCurve=0xd,QuadSmooth=0xf,HLine=0x5,LineRel=0x4,ClosePath=0x13,ArcRel=0x12,MoveRel=0x2,HLineRel=0x6,Line=0x3,QuadCurveRel=0xe,SmoothRel=0xc,CurveRel=0xa,QuadSmoothRel=0x10\nc.VTXF:LINE_THROUGH=0x4,OVERLINE=0x2,BLINK=0x8,UNDERLINE=0x1\nc.VGF:FIXED_FY=0x10000,RELATIVE_X2=0x4,RELATIVE_X1=0x1,FIXED_X1=0x200,FIXED_Y2=0x1000,RELATIVE_CX=0x10,FIXED_RADIUS=0x20000,RELATIVE_RADIUS=0x100,RELATIVE_FX=0x40,FIXED_CX=0x2000,RELATIVE_Y2=0x8,RELATIVE_CY=0x20,FIXED_FX=0x8000,RELATIVE_FY=0x80,FIXED_Y1=0x400,FIXED_CY=0x4000,RELATIVE_Y1=0x2,FIXED_X2=0x800\nc.VSPREAD:REFLECT_Y=0x5,UNDEFINED=0x0,REPEAT=0x3,CLIP=0x6,REFLECT_X=0x4,PAD=0x1,END=0x7,REFLECT=0x2\nc.ARF:NONE=0x100,Y_MIN=0x8,Y_MAX=0x20,X_MID=0x2,X_MIN=0x1,X_MAX=0x4,SLICE=0x80,Y_MID=0x10,MEET=0x40\nc.VUNIT:END=0x3,UNDEFINED=0x0,BOUNDING_BOX=0x1,USERSPACE=0x2\nc.VMF:STRETCH=0x1,Y_MID=0x40,Y_MIN=0x20,X_MIN=0x4,X_MAX=0x10,Y_MAX=0x80,AUTO_SPACING=0x2,X_MID=0x8\nc.VTF:SKEW=0x10,TRANSLATE=0x2,MATRIX=0x1,SCALE=0x4,ROTATE=0x8\nc.VBF:INCLUSIVE=0x1,NO_TRANSFORM=0x2\nc.VPF:RENDER_TIME=0x2,CLEAR=0x20,BITMAP_SIZED=0x1,INCREMENTAL=0x10,PARALLEL=0x8,RESIZE=0x4\nc.VIS:COLLAPSE=0x2,VISIBLE=0x1,INHERIT=0x3,HIDDEN=0x0\nc.VTS:EXTRA_EXPANDED=0xb,SEMI_EXPANDED=0x9,NARROWER=0x3,ULTRA_EXPANDED=0xa,CONDENSED=0x6,NORMAL=0x1,EXPANDED=0x8,WIDER=0x2,EXTRA_CONDENSED=0x5,ULTRA_CONDENSED=0x4,INHERIT=0x0,SEMI_CONDENSED=0x7\nc.VLJ:MITER=0x0,ROUND=0x2,MITER_ROUND=0x4,MITER_REVERT=0x1,INHERIT=0x5,BEVEL=0x3\nc.VSM:BLACKMAN8=0xf,LANCZOS8=0xe,SPLINE16=0x4,MITCHELL=0x9,GAUSSIAN=0x7,SINC8=0xd,BLACKMAN3=0xc,AUTO=0x0,BICUBIC=0x3,LANCZOS3=0xb,BESSEL=0x8,KAISER=0x5,SINC3=0xa,NEIGHBOUR=0x1,QUADRIC=0x6,BILINEAR=0x2\nc.VLC:ROUND=0x3,SQUARE=0x2,INHERIT=0x4,BUTT=0x1\nc.VGT:CONTOUR=0x4,RADIAL=0x1,DIAMOND=0x3,CONIC=0x2,LINEAR=0x0\nc.RC:TRANSFORM=0x4,FINAL_PATH=0x1,ALL=0xff,BASE_PATH=0x2\nc.VFR:EVEN_ODD=0x2,END=0x4,INHERIT=0x3,NON_ZERO=0x1\nc.ARC:LARGE=0x1,SWEEP=0x2\n"
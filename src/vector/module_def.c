@@ -14,11 +14,14 @@ FDEF argsFreePath[] = { { "Void", FD_VOID }, { "Path", FD_PTR }, { 0, 0 } };
 FDEF argsGenerateEllipse[] = { { "Error", FD_LONG|FD_ERROR }, { "CX", FD_DOUBLE }, { "CY", FD_DOUBLE }, { "RX", FD_DOUBLE }, { "RY", FD_DOUBLE }, { "Vertices", FD_LONG }, { "Path", FD_PTR|FD_RESULT }, { 0, 0 } };
 FDEF argsGeneratePath[] = { { "Error", FD_LONG|FD_ERROR }, { "Sequence", FD_STR }, { "Path", FD_PTR|FD_RESULT }, { 0, 0 } };
 FDEF argsGenerateRectangle[] = { { "Error", FD_LONG|FD_ERROR }, { "X", FD_DOUBLE }, { "Y", FD_DOUBLE }, { "Width", FD_DOUBLE }, { "Height", FD_DOUBLE }, { "Path", FD_PTR|FD_RESULT }, { 0, 0 } };
+FDEF argsGetGlyphCacheStats[] = { { "Void", FD_VOID }, { "Hits", FD_LARGE|FD_RESULT }, { "Misses", FD_LARGE|FD_RESULT }, { "Usage", FD_LARGE|FD_RESULT }, { 0, 0 } };
 FDEF argsGetVertex[] = { { "Result", FD_LONG }, { "Path", FD_PTR }, { "X", FD_DOUBLE|FD_RESULT }, { "Y", FD_DOUBLE|FD_RESULT }, { 0, 0 } };
 FDEF argsLineTo[] = { { "Void", FD_VOID }, { "Path", FD_PTR }, { "X", FD_DOUBLE }, { "Y", FD_DOUBLE }, { 0, 0 } };
 FDEF argsMoveTo[] = { { "Void", FD_VOID }, { "Path", FD_PTR }, { "X", FD_DOUBLE }, { "Y", FD_DOUBLE }, { 0, 0 } };
 FDEF argsReadPainter[] = { { "Void", FD_VOID }, { "Vector", FD_OBJECTPTR }, { "IRI", FD_STR }, { "DRGB:RGB", FD_PTR|FD_STRUCT }, { "Gradient", FD_OBJECTPTR|FD_RESULT }, { "Image", FD_OBJECTPTR|FD_RESULT }, { "Pattern", FD_OBJECTPTR|FD_RESULT }, { 0, 0 } };
 FDEF argsRewindPath[] = { { "Void", FD_VOID }, { "Path", FD_PTR }, { 0, 0 } };
+FDEF argsSetFilterCache[] = { { "Void", FD_VOID }, { "Limit", FD_LARGE }, { 0, 0 } };
+FDEF argsSetGlyphCache[] = { { "Void", FD_VOID }, { "Limit", FD_LARGE }, { 0, 0 } };
 FDEF argsSmooth3[] = { { "Void", FD_VOID }, { "Path", FD_PTR }, { "X", FD_DOUBLE }, { "Y", FD_DOUBLE }, { 0, 0 } };
 FDEF argsSmooth4[] = { { "Void", FD_VOID }, { "Path", FD_PTR }, { "CtrlX", FD_DOUBLE }, { "CtrlY", FD_DOUBLE }, { "X", FD_DOUBLE }, { "Y", FD_DOUBLE }, { 0, 0 } };
 FDEF argsTranslatePath[] = { { "Void", FD_VOID }, { "Path", FD_PTR }, { "X", FD_DOUBLE }, { "Y", FD_DOUBLE }, { 0, 0 } };
@@ -42,6 +45,9 @@ const struct Function glFunctions[] = {
    { (APTR)vecRewindPath, "RewindPath", argsRewindPath },
    { (APTR)vecGetVertex, "GetVertex", argsGetVertex },
    { (APTR)vecApplyPath, "ApplyPath", argsApplyPath },
+   { (APTR)vecSetFilterCache, "SetFilterCache", argsSetFilterCache },
+   { (APTR)vecSetGlyphCache, "SetGlyphCache", argsSetGlyphCache },
+   { (APTR)vecGetGlyphCacheStats, "GetGlyphCacheStats", argsGetGlyphCacheStats },
    { NULL, NULL, NULL }
 };
 
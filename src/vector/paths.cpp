@@ -1,6 +1,30 @@
 
 #include "agg_trans_single_path.h"
 
+//****************************************************************************
+// Computes a key for the settings that determine the stroke outline of a vector.  Not all of the stroke fields mark
+// the vector as dirty when they are set, so the key is used to detect changes to the stroke when the flattened stroke
+// path is reused.
+
+static LARGE stroke_key(objVector *Vector)
+{
+   const DOUBLE values[] = {
+      Vector->StrokeWidth, DOUBLE(Vector->LineJoin), DOUBLE(Vector->LineCap), DOUBLE(Vector->InnerJoin),
+      Vector->MiterLimit, Vector->InnerMiterLimit, Vector->DashOffset, DOUBLE(Vector->DashTotal)
+   };
+
+   uint64_t hash = 0xcbf29ce484222325ULL;
+   auto bytes = (const UBYTE *)values;
+   for (LONG i=0; i < (LONG)sizeof(values); i++) hash = (hash ^ bytes[i]) * 0x100000001b3ULL;
+
+   if (Vector->DashArray) {
+      bytes = (const UBYTE *)Vector->DashArray;
+      for (LONG i=0; i < Vector->DashTotal * (LONG)sizeof(DOUBLE); i++) hash = (hash ^ bytes[i]) * 0x100000001b3ULL;
+   }
+
+   return LARGE(hash);
+}
+
 //****************************************************************************
 // (Re)Generates the path for a vector.
 
@@ -141,6 +165,11 @@ static void gen_vector_path(objVector *Vector)
       Vector->Dirty &= ~(RC_TRANSFORM | RC_FINAL_PATH | RC_BASE_PATH);
    }
    else if (Vector->Head.ClassID IS ID_VECTOR) {
+      // If nothing but the transform has changed, the flattened fill and stroke paths from the last run can be
+      // re-rasterised with the new transform.  Curve flattening and stroking are the costly parts of path generation.
+
+      bool reuse_flat = !(Vector->Dirty & (RC_BASE_PATH|RC_FINAL_PATH));
+
       if ((Vector->Dirty & RC_TRANSFORM) AND (Vector->Head.SubID != ID_VECTORTEXT)) {
          // First, calculate the FinalX and FinalY field values, without any viewport scaling applied.  Note that
          // VectorText is excluded at this stage because the final X/Y needs to take alignment of the base path into
@@ -173,6 +202,7 @@ static void gen_vector_path(objVector *Vector)
       }
 
       if (Vector->Dirty & RC_BASE_PATH) {
+         reuse_flat = false;
          Vector->BasePath->free_all();
 
          Vector->GeneratePath((objVector *)Vector);
@@ -184,7 +214,7 @@ static void gen_vector_path(objVector *Vector)
             else {
                auto morph = (objVector *)Vector->Morph;
 
-               if (morph->Dirty) { // Regenerate the target path if necessary
+               if ((!morph->BasePath) or (morph->Dirty & RC_BASE_PATH)) { // Regenerate the target path if necessary
                   gen_vector_path((objVector *)morph);
                   morph->Dirty = 0;
                }
@@ -243,28 +273,45 @@ static void gen_vector_path(objVector *Vector)
          Vector->BasePath->approximation_scale(scale);
          if (scale > 1.0) Vector->BasePath->angle_tolerance(0.2); // Set in radians.  The less this value is, the more accurate it will be at sharp turns.
          else Vector->BasePath->angle_tolerance(0);
+
+         // Curves are flattened to suit the scale of the vector, so a change of scale requires the flattened paths to
+         // be regenerated.  Rotation can introduce rounding errors in the scale, which are tolerated.
+
+         if ((scale > Vector->FlatScale * 1.001) or (scale < Vector->FlatScale * 0.999) or
+             ((scale > 1.0) != (Vector->FlatScale > 1.0))) reuse_flat = false;
+         if (!reuse_flat) Vector->FlatScale = scale;
       }
 
       //Vector->BasePath->cusp_limit(x); // Set in radians.  If more than 0, it restricts sharpness at the cusp (presumably for awkward angles).  Do not exceed 10-15 degrees
 
-      if ((Vector->FillColour.Alpha > 0) or (Vector->FillGradient) or (Vector->FillImage) or (Vector->FillPattern)) {
+      if (has_fill(Vector)) {
          if (!Vector->FillRaster) {
             Vector->FillRaster = new (std::nothrow) agg::rasterizer_scanline_aa<>;
             if (!Vector->FillRaster) return;
          }
          else Vector->FillRaster->reset();
 
-         agg::conv_transform<agg::path_storage, agg::trans_affine> fill_path(*Vector->BasePath, *Vector->Transform);
+         if ((!reuse_flat) or (!Vector->FlatFill)) {
+            if (!Vector->FlatFill) {
+               Vector->FlatFill = new (std::nothrow) agg::path_storage;
+               if (!Vector->FlatFill) return;
+            }
+            else Vector->FlatFill->remove_all();
+
+            Vector->FlatFill->concat_path(*Vector->BasePath);
+         }
+
+         agg::conv_transform<agg::path_storage, agg::trans_affine> fill_path(*Vector->FlatFill, *Vector->Transform);
          Vector->FillRaster->add_path(fill_path);
       }
-      else if (Vector->FillRaster) {
+      else {
          delete Vector->FillRaster;
          Vector->FillRaster = NULL;
+         delete Vector->FlatFill;
+         Vector->FlatFill = NULL;
       }
 
-      if ((Vector->StrokeWidth > 0) and
-          ((Vector->StrokePattern) or (Vector->StrokeGradient) or (Vector->StrokeImage) or
-           (Vector->StrokeColour.Alpha * Vector->StrokeOpacity * Vector->Opacity > 0.001))){
+      if (has_stroke(Vector)) {
 
          // Configure the curve algorithm so that it generates nicer looking curves when the vector is scaled up.  This
          // is not required if the vector scale is <= 1.0 (the angle_tolerance controls this).
@@ -275,46 +322,146 @@ static void gen_vector_path(objVector *Vector)
          }
          else Vector->StrokeRaster->reset();
 
-         if (Vector->DashArray) {
-            agg::conv_dash<agg::path_storage> dashed_path(*Vector->BasePath);
-            agg::conv_stroke<agg::conv_dash<agg::path_storage>> dashed_stroke(dashed_path);
-
-            dashed_path.remove_all_dashes();
-            DOUBLE total_length = 0;
-            for (LONG i=0; i < Vector->DashTotal-1; i+=2) {
-              dashed_path.add_dash(Vector->DashArray[i], Vector->DashArray[i+1]);
-               total_length += Vector->DashArray[i] + Vector->DashArray[i+1];
+         const LARGE key = stroke_key(Vector);
+         if ((!reuse_flat) or (!Vector->FlatStroke) or (Vector->StrokeKey != key)) {
+            if (!Vector->FlatStroke) {
+               Vector->FlatStroke = new (std::nothrow) agg::path_storage;
+               if (!Vector->FlatStroke) return;
             }
+            else Vector->FlatStroke->remove_all();
 
-            // The stroke-dashoffset is used to set how far into dash pattern to start the pattern.  E.g. a
-            // value of 5 means that the entire pattern is shifted 5 pixels to the left.
+            if (Vector->DashArray) {
+               agg::conv_dash<agg::path_storage> dashed_path(*Vector->BasePath);
+               agg::conv_stroke<agg::conv_dash<agg::path_storage>> dashed_stroke(dashed_path);
 
-            if (Vector->DashOffset > 0) dashed_path.dash_start(Vector->DashOffset);
-            else if (Vector->DashOffset < 0) dashed_path.dash_start(total_length + Vector->DashOffset);
+               dashed_path.remove_all_dashes();
+               DOUBLE total_length = 0;
+               for (LONG i=0; i < Vector->DashTotal-1; i+=2) {
+                 dashed_path.add_dash(Vector->DashArray[i], Vector->DashArray[i+1]);
+                  total_length += Vector->DashArray[i] + Vector->DashArray[i+1];
+               }
 
-            configure_stroke((objVector &)*Vector, dashed_stroke);
+               // The stroke-dashoffset is used to set how far into dash pattern to start the pattern.  E.g. a
+               // value of 5 means that the entire pattern is shifted 5 pixels to the left.
 
-            agg::conv_transform<agg::conv_stroke<agg::conv_dash<agg::path_storage>>, agg::trans_affine> stroke_path(dashed_stroke, *Vector->Transform);
-            Vector->StrokeRaster->add_path(stroke_path);
-         }
-         else {
-            agg::conv_stroke<agg::path_storage> stroked_path(*Vector->BasePath);
-            configure_stroke((objVector &)*Vector, stroked_path);
-            agg::conv_transform<agg::conv_stroke<agg::path_storage>, agg::trans_affine> stroke_path(stroked_path, *Vector->Transform);
-            Vector->StrokeRaster->add_path(stroke_path);
+               if (Vector->DashOffset > 0) dashed_path.dash_start(Vector->DashOffset);
+               else if (Vector->DashOffset < 0) dashed_path.dash_start(total_length + Vector->DashOffset);
+
+               configure_stroke((objVector &)*Vector, dashed_stroke);
+               Vector->FlatStroke->concat_path(dashed_stroke);
+            }
+            else {
+               agg::conv_stroke<agg::path_storage> stroked_path(*Vector->BasePath);
+               configure_stroke((objVector &)*Vector, stroked_path);
+               Vector->FlatStroke->concat_path(stroked_path);
+            }
+
+            Vector->StrokeKey = key;
          }
+
+         agg::conv_transform<agg::path_storage, agg::trans_affine> stroke_path(*Vector->FlatStroke, *Vector->Transform);
+         Vector->StrokeRaster->add_path(stroke_path);
       }
-      else if (Vector->StrokeRaster) {
+      else {
          delete Vector->StrokeRaster;
          Vector->StrokeRaster = NULL;
+         delete Vector->FlatStroke;
+         Vector->FlatStroke = NULL;
       }
 
+      // Record the area of the bitmap that the vector will draw to, which is needed for damage tracking.  The
+      // right and bottom edges are exclusive.
+
+      LONG x1 = 0x7fffffff, y1 = 0x7fffffff, x2 = -0x7fffffff, y2 = -0x7fffffff;
+      for (auto raster : { Vector->FillRaster, Vector->StrokeRaster }) {
+         if ((!raster) or (raster->min_x() > raster->max_x())) continue;
+         if (raster->min_x() < x1) x1 = raster->min_x();
+         if (raster->min_y() < y1) y1 = raster->min_y();
+         if (raster->max_x() + 1 > x2) x2 = raster->max_x() + 1;
+         if (raster->max_y() + 1 > y2) y2 = raster->max_y() + 1;
+      }
+
+      if (x1 < x2) { Vector->BX1 = x1; Vector->BY1 = y1; Vector->BX2 = x2; Vector->BY2 = y2; }
+      else Vector->BX1 = Vector->BY1 = Vector->BX2 = Vector->BY2 = 0;
+
       Vector->Dirty &= ~RC_FINAL_PATH;
    }
    else log.warning("Target vector is not a shape.");
 
 }
 
+//****************************************************************************
+// Generates the path of a dirty vector on behalf of Scene.  If RENDER_TIME is enabled, the time taken is added to the
+// PathTime of the scene.
+
+static void gen_scene_path(objVectorScene *Scene, objVector *Shape)
+{
+   if ((Scene) and (Scene->Flags & VPF_RENDER_TIME)) {
+      const LARGE start = PreciseTime();
+      gen_vector_path(Shape);
+      Scene->PathTime += PreciseTime() - start;
+   }
+   else gen_vector_path(Shape);
+}
+
+//****************************************************************************
+// Updates the cached device-space boundary of a vector and everything that it draws (TBX1, TBY1, TBX2, TBY2).  Dirty
+// paths in the branch are regenerated in the process.  Shapes do not draw their children, so their boundary is that of
+// their own path.  The content of a viewport is clipped to the viewport.  Filter effects can draw outside of the
+// paths they are applied to, so filtered vectors are given an unlimited boundary.
+
+static void update_tree_bounds(objVector *Vector)
+{
+   if (Vector->Dirty) {
+      gen_scene_path(Vector->Scene, Vector);
+      Vector->Dirty = 0;
+   }
+
+   if (Vector->ValidBounds) return;
+
+   if (Vector->GeneratePath) {
+      Vector->TBX1 = Vector->BX1;
+      Vector->TBY1 = Vector->BY1;
+      Vector->TBX2 = Vector->BX2;
+      Vector->TBY2 = Vector->BY2;
+   }
+   else {
+      DOUBLE x1 = DBL_MAX, y1 = DBL_MAX, x2 = -DBL_MAX, y2 = -DBL_MAX;
+      for (auto child=(objVector *)Vector->Child; child; child=(objVector *)child->Next) {
+         if (child->Head.ClassID != ID_VECTOR) continue;
+         update_tree_bounds(child);
+         if (child->TBX1 >= child->TBX2) continue;
+         if (child->TBX1 < x1) x1 = child->TBX1;
+         if (child->TBY1 < y1) y1 = child->TBY1;
+         if (child->TBX2 > x2) x2 = child->TBX2;
+         if (child->TBY2 > y2) y2 = child->TBY2;
+      }
+
+      if (Vector->Head.SubID IS ID_VECTORVIEWPORT) {
+         auto view = (objVectorViewport *)Vector;
+         if (view->vpBX1 > x1) x1 = view->vpBX1;
+         if (view->vpBY1 > y1) y1 = view->vpBY1;
+         if (view->vpBX2 < x2) x2 = view->vpBX2;
+         if (view->vpBY2 < y2) y2 = view->vpBY2;
+      }
+
+      if ((x1 < x2) and (y1 < y2)) {
+         Vector->TBX1 = x1;
+         Vector->TBY1 = y1;
+         Vector->TBX2 = x2;
+         Vector->TBY2 = y2;
+      }
+      else Vector->TBX1 = Vector->TBY1 = Vector->TBX2 = Vector->TBY2 = 0;
+   }
+
+   if (Vector->Filter) {
+      Vector->TBX1 = Vector->TBY1 = -DBL_MAX;
+      Vector->TBX2 = Vector->TBY2 = DBL_MAX;
+   }
+
+   Vector->ValidBounds = TRUE;
+}
+
 //****************************************************************************
 // Apply all transforms in the correct SVG order to a target agg::trans_affine object.  The process starts with the
 // vector passed in to the function, and proceeds upwards through the parent nodes.
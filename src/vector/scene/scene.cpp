@@ -109,7 +109,17 @@ Draw: Renders the scene to a bitmap.
 The Draw action will render the scene to the target #Bitmap.  If #Bitmap is NULL, an error will be
 returned.
 
-In addition, the #RenderTime field will be updated if the RENDER_TIME flag is defined.
+In addition, the #RenderTime, #PathTime and #FilterTime fields will be updated if the RENDER_TIME flag is defined.
+
+The scene is drawn over the existing content of the Bitmap.  If the CLEAR flag is defined, the clipping region of the
+Bitmap is cleared to its background colour first.
+
+If the INCREMENTAL and CLEAR flags are both defined, the scene will only redraw the areas of the #Bitmap that are
+affected by vectors that have changed, been removed or been restacked since the last drawing operation.  Each area is
+cleared and redrawn in the same way as a full drawing of the scene.  The bounds of the redrawn areas are reported in
+the #DamageX, #DamageY, #DamageWidth and #DamageHeight fields so that the client can limit the display of the Bitmap
+to that area.  The entire scene is redrawn if the Bitmap or its clipping region has changed, or if a dirty vector is
+affected by a filter.  Incremental drawing requires that the content of the Bitmap is retained between calls to Draw.
 
 -ERRORS-
 Okay
@@ -143,12 +153,75 @@ static ERROR VECTORSCENE_Draw(objVectorScene *Self, struct acDraw *Args)
    }
    else adaptor = static_cast<VMAdaptor *> (Self->Adaptor);
 
+   LARGE time = 0;
    if (Self->Flags & VPF_RENDER_TIME) {
-      LARGE time = PreciseTime();
+      time = PreciseTime();
+      Self->PathTime = 0;
+      Self->FilterTime = 0;
+   }
+
+   if ((Self->Flags & (VPF_INCREMENTAL|VPF_CLEAR)) IS (VPF_INCREMENTAL|VPF_CLEAR)) {
+      // The content of the bitmap can only be reused if it was drawn by this scene with the same clipping region.
+
+      const ClipRectangle clip = bmp->Clip;
+      if ((Self->LastBitmap != bmp) or (!Self->Viewport) or
+          (Self->LastClip.Left != clip.Left) or (Self->LastClip.Top != clip.Top) or
+          (Self->LastClip.Right != clip.Right) or (Self->LastClip.Bottom != clip.Bottom) or
+          (!collect_damage(Self, Self->Viewport))) {
+         Self->TotalDamage = 0;
+         add_damage(Self, clip.Left, clip.Top, clip.Right, clip.Bottom);
+      }
+
+      Self->LastBitmap = bmp;
+      Self->LastClip   = clip;
+
+      ClipRectangle bounds;
+      bounds.Left  = bounds.Top    = 0x7fffffff;
+      bounds.Right = bounds.Bottom = -0x7fffffff;
+      for (LONG i=0; i < Self->TotalDamage; i++) {
+         ClipRectangle area = Self->Damage[i];
+         if (area.Left < clip.Left)     area.Left   = clip.Left;
+         if (area.Top < clip.Top)       area.Top    = clip.Top;
+         if (area.Right > clip.Right)   area.Right  = clip.Right;
+         if (area.Bottom > clip.Bottom) area.Bottom = clip.Bottom;
+         if ((area.Left >= area.Right) or (area.Top >= area.Bottom)) continue;
+
+         log.trace("Redrawing area %d %d %d %d", area.Left, area.Top, area.Right, area.Bottom);
+
+         bmp->Clip = area;
+         gfxDrawRectangle(bmp, area.Left, area.Top, area.Right - area.Left, area.Bottom - area.Top, bmp->BkgdIndex, BAF_FILL);
+         adaptor->draw(bmp);
+
+         if (area.Left < bounds.Left)     bounds.Left   = area.Left;
+         if (area.Top < bounds.Top)       bounds.Top    = area.Top;
+         if (area.Right > bounds.Right)   bounds.Right  = area.Right;
+         if (area.Bottom > bounds.Bottom) bounds.Bottom = area.Bottom;
+      }
+
+      bmp->Clip = clip;
+      Self->TotalDamage = 0;
+
+      if (bounds.Left < bounds.Right) {
+         Self->DamageX      = bounds.Left;
+         Self->DamageY      = bounds.Top;
+         Self->DamageWidth  = bounds.Right - bounds.Left;
+         Self->DamageHeight = bounds.Bottom - bounds.Top;
+      }
+      else Self->DamageX = Self->DamageY = Self->DamageWidth = Self->DamageHeight = 0;
+   }
+   else {
+      if (Self->Flags & VPF_CLEAR) {
+         gfxDrawRectangle(bmp, bmp->Clip.Left, bmp->Clip.Top, bmp->Clip.Right - bmp->Clip.Left,
+            bmp->Clip.Bottom - bmp->Clip.Top, bmp->BkgdIndex, BAF_FILL);
+      }
       adaptor->draw(bmp);
+   }
+
+   if (Self->Scratch) Self->Scratch->end_frame();
+
+   if (Self->Flags & VPF_RENDER_TIME) {
       if ((Self->RenderTime = PreciseTime() - time) < 1) Self->RenderTime = 1;
    }
-   else adaptor->draw(bmp);
 
    return ERR_Okay;
 }
@@ -215,6 +288,7 @@ static ERROR VECTORSCENE_Free(objVectorScene *Self, APTR Args)
    if (Self->Adaptor) { delete Self->Adaptor; Self->Adaptor = NULL; }
    if (Self->Buffer) { delete Self->Buffer; Self->Buffer = NULL; }
    if (Self->Defs) { FreeResource(Self->Defs); Self->Defs = NULL; }
+   if (Self->Scratch) { Self->Scratch->release(); Self->Scratch = NULL; }
    return ERR_Okay;
 }
 
@@ -348,6 +422,8 @@ The target bitmap to use when drawing the vectors must be specified here.
 
 static ERROR SET_Bitmap(objVectorScene *Self, objBitmap *Value)
 {
+   if (Value != Self->Bitmap) Self->LastBitmap = NULL; // Incremental drawing cannot reuse the content of a new bitmap.
+
    if (Value) {
       if (Self->Buffer) delete Self->Buffer;
 
@@ -370,6 +446,37 @@ static ERROR SET_Bitmap(objVectorScene *Self, objBitmap *Value)
 
 /*****************************************************************************
 
+-FIELD-
+DamageHeight: The height of the area that was redrawn by the last incremental Draw.
+
+Refer to #DamageX for further information.
+
+-FIELD-
+DamageWidth: The width of the area that was redrawn by the last incremental Draw.
+
+Refer to #DamageX for further information.
+
+-FIELD-
+DamageX: The left edge of the area that was redrawn by the last incremental Draw.
+
+When the INCREMENTAL and CLEAR flags are set, the DamageX, DamageY, #DamageWidth and #DamageHeight fields report the
+bounds of the areas of the #Bitmap that were redrawn by the last call to #Draw().  The coordinates are relative to the
+Bitmap.  If nothing in the scene had changed, the DamageWidth and DamageHeight will be zero.
+
+-FIELD-
+DamageY: The top edge of the area that was redrawn by the last incremental Draw.
+
+Refer to #DamageX for further information.
+
+-FIELD-
+FilterTime: Returns the time spent processing filter effects in the last scene.
+
+FilterTime returns the time that was spent drawing filtered vectors in the last scene that was drawn, measured in
+microseconds.  This includes the rendering of the source graphics of the filters as well as the processing of their
+effects.  It is a subset of #RenderTime and does not overlap with #PathTime.
+
+The RENDER_TIME flag must be set for this value to be computed.
+
 -FIELD-
 Flags: Optional flags.
 
@@ -415,6 +522,15 @@ static ERROR SET_PageWidth(objVectorScene *Self, LONG Value)
 
 /****************************************************************************
 
+-FIELD-
+PathTime: Returns the time spent generating vector paths in the last scene.
+
+PathTime returns the time that was spent generating the paths of vectors that had been modified since the previous
+drawing of the scene, measured in microseconds.  It is a subset of #RenderTime.  The time taken to draw the vectors once
+their paths are generated can be computed as #RenderTime - PathTime - #FilterTime.
+
+The RENDER_TIME flag must be set for this value to be computed.
+
 -FIELD-
 RenderTime: Returns the rendering time of the last scene.
 
@@ -469,6 +585,12 @@ static const FieldArray clSceneFields[] = {
    { "PageWidth",    FDF_LONG|FDF_RW,            0, NULL, (APTR)SET_PageWidth },
    { "PageHeight",   FDF_LONG|FDF_RW,            0, NULL, (APTR)SET_PageHeight },
    { "SampleMethod", FDF_LONG|FDF_LOOKUP|FDF_RW, (MAXINT)&clVectorSceneSampleMethod, NULL, NULL },
+   { "DamageX",      FDF_LONG|FDF_R,             0, NULL, NULL },
+   { "DamageY",      FDF_LONG|FDF_R,             0, NULL, NULL },
+   { "DamageWidth",  FDF_LONG|FDF_R,             0, NULL, NULL },
+   { "DamageHeight", FDF_LONG|FDF_R,             0, NULL, NULL },
+   { "PathTime",     FDF_LARGE|FDF_R,            0, NULL, NULL },
+   { "FilterTime",   FDF_LARGE|FDF_R,            0, NULL, NULL },
    END_FIELD
 };
 
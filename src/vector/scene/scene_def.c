@@ -4,6 +4,9 @@ static const struct FieldDef clVectorSceneFlags[] = {
    { "RenderTime", 0x00000002 },
    { "BitmapSized", 0x00000001 },
    { "Resize", 0x00000004 },
+   { "Parallel", 0x00000008 },
+   { "Incremental", 0x00000010 },
+   { "Clear", 0x00000020 },
    { NULL, 0 }
 };
 
@@ -51,7 +51,7 @@ private:
 static LONG check_dirty(objVector *Shape) {
    while (Shape) {
       if (Shape->Head.ClassID != ID_VECTOR) return TRUE;
-      if (Shape->Dirty) return TRUE;
+      if ((Shape->Dirty) or (Shape->PaintDirty)) return TRUE;
 
       if (Shape->Child) {
          if (check_dirty(Shape->Child)) return TRUE;
@@ -62,9 +62,62 @@ static LONG check_dirty(objVector *Shape) {
 }
 
 //****************************************************************************
+// Regenerates the paths of dirty vectors and adds the parts of the bitmap that the vectors occupied before and after
+// the change to the damage list of the Scene.  Vectors with modified paint, and vectors that use a dirty pattern, add
+// their current area.  Returns false if the damage cannot be determined, in which case the entire scene must be
+// redrawn.
 
-template <class T> static void drawBitmapRender(agg::renderer_base<agg::pixfmt_rkl> &RenderBase,
-   agg::rasterizer_scanline_aa<> &Raster, T &spangen, DOUBLE Opacity)
+static bool collect_damage(objVectorScene *Scene, objVector *Vector)
+{
+   for (auto shape=Vector; shape; shape=(objVector *)shape->Next) {
+      if (shape->Head.ClassID != ID_VECTOR) continue;
+
+      if (shape->Filter) { // Filter effects can extend beyond the boundary of the vectors that they are applied to.
+         if ((shape->Dirty) or (shape->PaintDirty) or ((shape->Child) and (check_dirty((objVector *)shape->Child)))) return false;
+         continue;
+      }
+
+      if (shape->Head.SubID IS ID_VECTORVIEWPORT) {
+         if (shape->Dirty) {
+            auto view = (objVectorViewport *)shape;
+            add_damage(Scene, view->vpBX1, view->vpBY1, view->vpBX2, view->vpBY2);
+            gen_scene_path(Scene, shape);
+            shape->Dirty = 0;
+            add_damage(Scene, view->vpBX1, view->vpBY1, view->vpBX2, view->vpBY2);
+         }
+      }
+      else if (shape->Dirty) { // The tree boundary of a shape is that of its path when it was last drawn.
+         add_damage(Scene, shape->TBX1, shape->TBY1, shape->TBX2, shape->TBY2);
+         gen_scene_path(Scene, shape);
+         shape->Dirty = 0;
+         add_damage(Scene, shape->BX1, shape->BY1, shape->BX2, shape->BY2);
+      }
+      else if (((shape->FillPattern) and (shape->FillPattern->Scene) and (check_dirty(shape->FillPattern->Scene->Viewport))) or
+               ((shape->StrokePattern) and (shape->StrokePattern->Scene) and (check_dirty(shape->StrokePattern->Scene->Viewport)))) {
+         add_damage(Scene, shape->BX1, shape->BY1, shape->BX2, shape->BY2);
+      }
+
+      if (shape->Child) {
+         if (!collect_damage(Scene, (objVector *)shape->Child)) return false;
+      }
+
+      // Paint changes affect everything that the vector draws, including its children.  The boundary is computed
+      // after the children have been processed, so that their previous areas are recorded first.
+
+      if (shape->PaintDirty) {
+         if (!shape->ValidBounds) update_tree_bounds(shape);
+         add_damage(Scene, shape->TBX1, shape->TBY1, shape->TBX2, shape->TBY2);
+         shape->PaintDirty = FALSE;
+      }
+   }
+
+   return true;
+}
+
+//****************************************************************************
+
+template <class RASTER, class T> static void drawBitmapRender(agg::renderer_base<agg::pixfmt_rkl> &RenderBase,
+   RASTER &Raster, T &spangen, DOUBLE Opacity)
 {
    agg::span_allocator<agg::rgba8> spanalloc;
    agg::scanline_u8 scanline;
@@ -90,6 +143,59 @@ static void setRasterClip(agg::rasterizer_scanline_aa<> &Raster, LONG X, LONG Y,
    Raster.add_path(clip);
 }
 
+//****************************************************************************
+// Presents a horizontal band of a rasterizer to the AGG scanline renderers.  The rasterizer must have been sorted
+// with rewind_scanlines() beforehand.  It is only read from that point, so any number of bands can be rendered from
+// it concurrently.  The boundary of the vector's base path is provided by the display list, because the path cannot
+// be read by more than one thread at a time.
+
+class band_raster
+{
+public:
+   band_raster(const agg::rasterizer_scanline_aa<> &Raster, LONG Top, LONG Bottom, const DOUBLE *PathBounds) :
+      mRaster(Raster), mPathBounds(PathBounds), mTop(Top), mBottom(Bottom) { }
+
+   bool rewind_scanlines() {
+      mY   = (mRaster.min_y() > mTop) ? mRaster.min_y() : mTop;
+      mEnd = (mRaster.max_y() < mBottom) ? mRaster.max_y() : mBottom;
+      return mY <= mEnd;
+   }
+
+   int min_x() const { return mRaster.min_x(); }
+   int max_x() const { return mRaster.max_x(); }
+
+   template <class Scanline> bool sweep_scanline(Scanline &SL) {
+      return mRaster.sweep_scanline(SL, mY, mEnd);
+   }
+
+   void path_bounds(DOUBLE *X1, DOUBLE *Y1, DOUBLE *X2, DOUBLE *Y2) const {
+      *X1 = mPathBounds[0];
+      *Y1 = mPathBounds[1];
+      *X2 = mPathBounds[2];
+      *Y2 = mPathBounds[3];
+   }
+
+private:
+   const agg::rasterizer_scanline_aa<> &mRaster;
+   const DOUBLE *mPathBounds;
+   LONG mTop, mBottom;
+   int mY, mEnd;
+};
+
+//****************************************************************************
+// Returns the boundary of the path that is being drawn through Raster.
+
+static void get_path_bounds(agg::rasterizer_scanline_aa<> &Raster, agg::path_storage &Path, DOUBLE *X1, DOUBLE *Y1,
+   DOUBLE *X2, DOUBLE *Y2)
+{
+   bounding_rect_single(Path, 0, X1, Y1, X2, Y2);
+}
+
+static void get_path_bounds(band_raster &Raster, agg::path_storage &Path, DOUBLE *X1, DOUBLE *Y1, DOUBLE *X2, DOUBLE *Y2)
+{
+   Raster.path_bounds(X1, Y1, X2, Y2);
+}
+
 //****************************************************************************
 
 static void set_filter(agg::image_filter_lut &Filter, UBYTE Method)
@@ -121,7 +227,7 @@ static void set_filter(agg::image_filter_lut &Filter, UBYTE Method)
 //****************************************************************************
 // A generic drawing function for VMImage and VMPattern, this is used to fill vectors with bitmap images.
 
-static void drawBitmap(LONG SampleMethod, agg::renderer_base<agg::pixfmt_rkl> &RenderBase, agg::rasterizer_scanline_aa<> &Raster,
+template <class RASTER> static void drawBitmap(LONG SampleMethod, agg::renderer_base<agg::pixfmt_rkl> &RenderBase, RASTER &Raster,
    objBitmap *SrcBitmap, LONG SpreadMethod, DOUBLE Opacity, agg::trans_affine *Transform, DOUBLE XOffset, DOUBLE YOffset)
 {
    agg::rendering_buffer imgSource;
@@ -183,17 +289,27 @@ static void drawBitmap(LONG SampleMethod, agg::renderer_base<agg::pixfmt_rkl> &R
 }
 
 //****************************************************************************
+// Redraw the pattern source if any part of the definition is marked as dirty.
 
-static void draw_pattern(objVector *Vector, agg::path_storage *Path,
-   LONG SampleMethod, DOUBLE X, DOUBLE Y, DOUBLE ViewWidth, DOUBLE ViewHeight,
-   struct rkVectorPattern &Pattern, agg::renderer_base<agg::pixfmt_rkl> &RenderBase,
-   agg::rasterizer_scanline_aa<> &Raster)
+static void refresh_pattern(struct rkVectorPattern &Pattern)
 {
-   if (Pattern.Scene) {  // Redraw the pattern source if any part of the definition is marked as dirty.
+   if (Pattern.Scene) {
       if (check_dirty(Pattern.Scene->Viewport)) {
          acDraw(&Pattern);
       }
    }
+}
+
+//****************************************************************************
+// The pattern is refreshed prior to drawing unless Refresh is false, which is the case for display lists because the
+// pattern was refreshed when the list was recorded.
+
+template <class RASTER> static void draw_pattern(objVector *Vector, agg::path_storage *Path,
+   LONG SampleMethod, DOUBLE X, DOUBLE Y, DOUBLE ViewWidth, DOUBLE ViewHeight,
+   struct rkVectorPattern &Pattern, agg::renderer_base<agg::pixfmt_rkl> &RenderBase,
+   RASTER &Raster, bool Refresh = true)
+{
+   if (Refresh) refresh_pattern(Pattern);
 
    DOUBLE dx, dy;
 
@@ -211,7 +327,7 @@ static void draw_pattern(objVector *Vector, agg::path_storage *Path,
       // to the base position, which is taken from the vector's path.
 
       DOUBLE bx1, by1, bx2, by2;
-      bounding_rect_single(*Path, 0, &bx1, &by1, &bx2, &by2); // Get the boundary of the original path without transforms.
+      get_path_bounds(Raster, *Path, &bx1, &by1, &bx2, &by2); // Get the boundary of the original path without transforms.
       const DOUBLE width = bx2 - bx1;
       const DOUBLE height = by2 - by1;
       dx = X;
@@ -384,8 +500,8 @@ void draw_texstroke(struct rkVectorImage &Image,
 //****************************************************************************
 // Image extension
 
-static void draw_image(objVector *Vector, agg::path_storage &Path, LONG SampleMethod, DOUBLE X, DOUBLE Y, DOUBLE ViewWidth, DOUBLE ViewHeight, struct rkVectorImage &Image, agg::renderer_base<agg::pixfmt_rkl> &RenderBase,
-   agg::rasterizer_scanline_aa<> &Raster, DOUBLE BorderWidth = 0, DOUBLE Alpha = 1.0)
+template <class RASTER> static void draw_image(objVector *Vector, agg::path_storage &Path, LONG SampleMethod, DOUBLE X, DOUBLE Y, DOUBLE ViewWidth, DOUBLE ViewHeight, struct rkVectorImage &Image, agg::renderer_base<agg::pixfmt_rkl> &RenderBase,
+   RASTER &Raster, DOUBLE BorderWidth = 0, DOUBLE Alpha = 1.0)
 {
    DOUBLE dx, dy, bx1, by1, bx2, by2;
    agg::trans_affine transform;
@@ -399,7 +515,7 @@ static void draw_image(objVector *Vector, agg::path_storage &Path, LONG SampleMe
       else dy = Image.Y;
 
       if (Image.SpreadMethod IS VSPREAD_PAD) { // In pad mode, stretch the image to fit the boundary
-         bounding_rect_single(Path, 0, &bx1, &by1, &bx2, &by2); // Get the boundary of the original path without transforms.
+         get_path_bounds(Raster, Path, &bx1, &by1, &bx2, &by2); // Get the boundary of the original path without transforms.
          transform.scale((bx2-bx1) / Image.Bitmap->Width, (by2-by1) / Image.Bitmap->Height);
       }
    }
@@ -407,7 +523,7 @@ static void draw_image(objVector *Vector, agg::path_storage &Path, LONG SampleMe
       // VUNIT_BOUNDING_BOX (align to vector).  In this mode the image's (x,y) is an optional offset applied
       // to the base position, which is taken from the vector's path.
 
-      bounding_rect_single(Path, 0, &bx1, &by1, &bx2, &by2); // Get the boundary of the original path without transforms.
+      get_path_bounds(Raster, Path, &bx1, &by1, &bx2, &by2); // Get the boundary of the original path without transforms.
       const DOUBLE width = bx2 - bx1;
       const DOUBLE height = by2 - by1;
       if (Image.Dimensions & DMF_RELATIVE_X) dx = X + (width * Image.X);
@@ -438,10 +554,10 @@ static void draw_image(objVector *Vector, agg::path_storage &Path, LONG SampleMe
 // Gradient extension
 // Not currently implemented: gradient_xy (rounded corner), gradient_sqrt_xy
 
-void draw_gradient(objVector *Vector, agg::path_storage *mPath, DOUBLE X, DOUBLE Y, DOUBLE ViewWidth, DOUBLE ViewHeight, struct rkVectorGradient &Gradient,
+template <class RASTER> void draw_gradient(objVector *Vector, agg::path_storage *mPath, DOUBLE X, DOUBLE Y, DOUBLE ViewWidth, DOUBLE ViewHeight, struct rkVectorGradient &Gradient,
    GRADIENT_TABLE *Table,
    agg::renderer_base<agg::pixfmt_rkl> &RenderBase,
-   agg::rasterizer_scanline_aa<> &Raster,
+   RASTER &Raster,
    DOUBLE BorderWidth)
 {
    typedef agg::span_interpolator_linear<> interpolator_type;
@@ -456,7 +572,7 @@ void draw_gradient(objVector *Vector, agg::path_storage *mPath, DOUBLE X, DOUBLE
    span_allocator_type span_allocator;
 
    DOUBLE bx1, by1, bx2, by2;
-   bounding_rect_single(*mPath, 0, &bx1, &by1, &bx2, &by2);
+   get_path_bounds(Raster, *mPath, &bx1, &by1, &bx2, &by2);
 
    if (Gradient.Type IS VGT_LINEAR) {
       DOUBLE ax1, ay1, ax2, ay2;
@@ -806,7 +922,32 @@ void draw_gradient(objVector *Vector, agg::path_storage *mPath, DOUBLE X, DOUBLE
    }
 }
 
-/****************************************************************************/
+/*****************************************************************************
+** Parallel drawing of a scene (VPF_PARALLEL) is a two step process.  The vector tree is parsed on the caller's thread
+** to generate paths and a display list of fill and stroke operations.  The bitmap's clip region is then divided into
+** horizontal bands and each band replays the display list with its own renderer, in order, so the output is identical
+** to that of draw_vectors().
+*/
+
+#define MIN_BAND_HEIGHT 64
+
+enum { DL_SOLID=1, DL_IMAGE, DL_GRADIENT, DL_PATTERN };
+
+struct DrawCommand {
+   objVector *Shape;
+   agg::rasterizer_scanline_aa<> *Raster;
+   APTR Paint;                // rkVectorImage, rkVectorGradient or rkVectorPattern
+   GRADIENT_TABLE *Table;
+   agg::rgba Colour;
+   DOUBLE ViewWidth, ViewHeight;
+   DOUBLE Opacity;
+   DOUBLE BorderWidth;
+   DOUBLE Bounds[4];          // Boundary of the shape's base path
+   LONG ClipLeft, ClipTop, ClipRight, ClipBottom;
+   UBYTE Type;
+};
+
+//****************************************************************************
 
 class VMAdaptor
 {
@@ -817,6 +958,8 @@ private:
    agg::scanline_u8 mScanLine;  // Use scanline_p for large solid polygons and scanline_u for things like text and gradients
    objVectorViewport *mView; // The current view
    objBitmap *mBitmap;
+   std::vector<DrawCommand> mCommands; // Display list for parallel drawing
+   LONG mBandTop, mBandHeight, mBands;
 
 public:
    objVectorScene *Scene; // The top-level VectorScene performing the draw.
@@ -837,12 +980,292 @@ public:
          mView = NULL; // Current view
          mRenderBase.clip_box(Bitmap->Clip.Left, Bitmap->Clip.Top, Bitmap->Clip.Right-1, Bitmap->Clip.Bottom-1);
 
+         if ((Scene->Flags & VPF_PARALLEL) and (draw_bands())) return;
+
+         mView = NULL;
          VectorState state;
          draw_vectors(Scene->Viewport, state);
       }
    }
 
 private:
+   // Returns true if nothing that the vector draws can intersect with the current clipping region, in which case the
+   // vector and its children can be skipped.
+
+   bool is_culled(objVector *Shape)
+   {
+      if (!Shape->ValidBounds) update_tree_bounds(Shape);
+
+      if (Shape->TBX1 >= Shape->TBX2) return true;
+      if ((Shape->TBX2 <= mRenderBase.xmin()) or (Shape->TBX1 > mRenderBase.xmax())) return true;
+      if ((Shape->TBY2 <= mRenderBase.ymin()) or (Shape->TBY1 > mRenderBase.ymax())) return true;
+      return false;
+   }
+
+   // Draws the scene in parallel bands.  Returns false if the scene cannot be drawn in this way, in which case the
+   // caller is expected to fall back to draw_vectors().
+
+   bool draw_bands()
+   {
+      parasol::Log log;
+
+      mBandTop    = mRenderBase.ymin();
+      mBandHeight = mRenderBase.ymax() - mRenderBase.ymin() + 1;
+      mBands      = GetResource(RES_THREAD_POOL);
+      if (mBands > mBandHeight / MIN_BAND_HEIGHT) mBands = mBandHeight / MIN_BAND_HEIGHT;
+      if (mBands < 2) return false;
+
+      if (!can_draw_bands(Scene->Viewport, VIS_VISIBLE)) {
+         log.trace("Scene requires serial drawing.");
+         return false;
+      }
+
+      mCommands.clear();
+      VectorState state;
+      record_vectors(Scene->Viewport, state);
+
+      log.trace("Drawing %d commands in %d bands.", (LONG)mCommands.size(), mBands);
+
+      ThreadBatch(&draw_band, this, mBands);
+      return true;
+   }
+
+   // Renders one band of the display list.  Runs concurrently with the other bands, so nothing in the vector tree may
+   // be modified from here.
+
+   static void draw_band(APTR Data, LONG Index)
+   {
+      auto self = (VMAdaptor *)Data;
+      const LONG top    = self->mBandTop + (self->mBandHeight * Index) / self->mBands;
+      const LONG bottom = self->mBandTop + (self->mBandHeight * (Index + 1)) / self->mBands - 1;
+
+      agg::pixfmt_rkl format;
+      format.setBitmap(*self->mBitmap);
+      agg::renderer_base<agg::pixfmt_rkl> base(format);
+      agg::renderer_scanline_aa_solid< agg::renderer_base<agg::pixfmt_rkl> > solid(base);
+      agg::scanline_u8 scanline;
+
+      for (auto &cmd : self->mCommands) {
+         if ((cmd.Raster->max_y() < top) or (cmd.Raster->min_y() > bottom)) continue;
+
+         const LONG y1 = (cmd.ClipTop > top) ? cmd.ClipTop : top;
+         const LONG y2 = (cmd.ClipBottom < bottom) ? cmd.ClipBottom : bottom;
+         if (y1 > y2) continue;
+         base.clip_box(cmd.ClipLeft, y1, cmd.ClipRight, y2);
+
+         band_raster raster(*cmd.Raster, y1, y2, cmd.Bounds);
+         auto shape = cmd.Shape;
+
+         switch (cmd.Type) {
+            case DL_SOLID:
+               solid.color(cmd.Colour);
+               agg::render_scanlines(raster, scanline, solid);
+               break;
+
+            case DL_IMAGE:
+               draw_image(shape, *shape->BasePath, shape->Scene->SampleMethod, shape->FinalX, shape->FinalY,
+                  cmd.ViewWidth, cmd.ViewHeight, *(struct rkVectorImage *)cmd.Paint, base, raster, 0, cmd.Opacity);
+               break;
+
+            case DL_GRADIENT:
+               draw_gradient(shape, shape->BasePath, shape->FinalX, shape->FinalY, cmd.ViewWidth, cmd.ViewHeight,
+                  *(struct rkVectorGradient *)cmd.Paint, cmd.Table, base, raster, cmd.BorderWidth);
+               break;
+
+            case DL_PATTERN:
+               draw_pattern(shape, shape->BasePath, shape->Scene->SampleMethod, shape->FinalX, shape->FinalY,
+                  cmd.ViewWidth, cmd.ViewHeight, *(struct rkVectorPattern *)cmd.Paint, base, raster, false);
+               break;
+         }
+      }
+   }
+
+   // Adds a command to the display list.  The raster is sorted here so that it can be swept concurrently by the
+   // bands.  Rasters without coverage are not recorded.
+
+   DrawCommand * record(LONG Type, objVector *Shape, agg::rasterizer_scanline_aa<> *Raster, DOUBLE ViewWidth, DOUBLE ViewHeight)
+   {
+      if (!Raster->rewind_scanlines()) return NULL;
+
+      DrawCommand cmd;
+      cmd.Type       = Type;
+      cmd.Shape      = Shape;
+      cmd.Raster     = Raster;
+      cmd.Paint      = NULL;
+      cmd.Table      = NULL;
+      cmd.ViewWidth  = ViewWidth;
+      cmd.ViewHeight = ViewHeight;
+      cmd.Opacity    = 1.0;
+      cmd.BorderWidth = 0;
+      cmd.ClipLeft   = mRenderBase.xmin();
+      cmd.ClipTop    = mRenderBase.ymin();
+      cmd.ClipRight  = mRenderBase.xmax();
+      cmd.ClipBottom = mRenderBase.ymax();
+      if (Type IS DL_SOLID) cmd.Bounds[0] = cmd.Bounds[1] = cmd.Bounds[2] = cmd.Bounds[3] = 0;
+      else bounding_rect_single(*Shape->BasePath, 0, &cmd.Bounds[0], &cmd.Bounds[1], &cmd.Bounds[2], &cmd.Bounds[3]);
+
+      mCommands.push_back(cmd);
+      return &mCommands.back();
+   }
+
+   // Returns false if a visible vector in the tree uses a feature that draws to intermediate bitmaps or reads the
+   // vector path while rendering; such scenes are drawn serially.  Nothing is modified, so the check is made before
+   // the display list is recorded.  Culling is not considered, so the result does not depend on the clip region.
+
+   static bool can_draw_bands(objVector *CurrentVector, LONG ParentVisibility)
+   {
+      for (auto shape=CurrentVector; shape; shape=(objVector *)shape->Next) {
+         if (shape->Head.ClassID != ID_VECTOR) continue;
+
+         LONG visibility = shape->Visibility;
+         if (visibility IS VIS_INHERIT) visibility = ParentVisibility;
+         if (visibility != VIS_VISIBLE) continue;
+
+         if ((shape->Filter) or (shape->EnableBkgd) or (shape->ClipMask)) return false;
+
+         if (shape->Head.SubID IS ID_VECTORVIEWPORT) {
+            if (((objVectorViewport *)shape)->vpClipMask) return false;
+         }
+         else {
+            if ((shape->FillGradient) and (shape->FillGradient->Type IS VGT_CONTOUR)) return false;
+            if ((shape->StrokeImage) and (!shape->StrokeGradient) and (!shape->StrokePattern)) return false;
+            if ((shape->StrokeGradient) and (shape->StrokeGradient->Type IS VGT_CONTOUR)) return false;
+         }
+
+         if ((shape->Child) and (!can_draw_bands((objVector *)shape->Child, visibility))) return false;
+      }
+
+      return true;
+   }
+
+   // Builds the display list for draw_bands().  The vector tree is parsed in the same way as draw_vectors(), and all
+   // changes that drawing makes to the vectors (path generation, pattern updates, gradient tables) are made here.
+   // can_draw_bands() must have accepted the tree beforehand.
+
+   void record_vectors(objVector *CurrentVector, VectorState &ParentState)
+   {
+      for (auto shape=CurrentVector; shape; shape=(objVector *)shape->Next) {
+         VectorState state = VectorState(ParentState);
+
+         if (shape->Head.ClassID != ID_VECTOR) continue;
+
+         if (shape->Dirty) {
+            gen_scene_path(Scene, shape);
+            shape->Dirty = 0;
+         }
+         shape->PaintDirty = FALSE;
+
+         if (shape->Visibility IS VIS_INHERIT) {
+            if (ParentState.mVisible != VIS_VISIBLE) continue;
+         }
+         else if (shape->Visibility != VIS_VISIBLE) continue;
+
+         if (is_culled(shape)) continue;
+
+         state.mOpacity = shape->Opacity * state.mOpacity;
+
+         if (shape->Head.SubID IS ID_VECTORVIEWPORT) {
+            if (shape->Child) {
+               auto view = (objVectorViewport *)shape;
+
+               LONG xmin = mRenderBase.xmin(), ymin = mRenderBase.ymin(), xmax = mRenderBase.xmax(), ymax = mRenderBase.ymax();
+
+               LONG x1 = view->vpBX1, y1 = view->vpBY1, x2 = view->vpBX2-1, y2 = view->vpBY2-1;
+               if (xmin > x1) x1 = xmin;
+               if (ymin > y1) y1 = ymin;
+               if (xmax < x2) x2 = xmax;
+               if (ymax < y2) y2 = ymax;
+               mRenderBase.clip_box(x1, y1, x2, y2);
+
+               if ((x2 > x1) and (y2 > y1)) {
+                  objVectorViewport *saved_viewport = mView;
+                  mView = view;
+                  record_vectors((objVector *)view->Child, state);
+                  mView = saved_viewport;
+               }
+
+               mRenderBase.clip_box(xmin, ymin, xmax, ymax);
+            }
+         }
+         else if (shape->GeneratePath) {
+            if (!mView) return;
+
+            DOUBLE view_width, view_height;
+
+            if (mView->vpDimensions & (DMF_FIXED_WIDTH|DMF_RELATIVE_WIDTH)) view_width = mView->vpFixedWidth;
+            else if (mView->vpViewWidth > 0) view_width = mView->vpViewWidth;
+            else view_width = mView->Scene->PageWidth;
+
+            if (mView->vpDimensions & (DMF_FIXED_HEIGHT|DMF_RELATIVE_HEIGHT)) view_height = mView->vpFixedHeight;
+            else if (mView->vpViewHeight > 0) view_height = mView->vpViewHeight;
+            else view_height = mView->Scene->PageHeight;
+
+            if (shape->FillRaster) {
+               if (shape->FillRule IS VFR_NON_ZERO) shape->FillRaster->filling_rule(agg::fill_non_zero);
+               else if (shape->FillRule IS VFR_EVEN_ODD) shape->FillRaster->filling_rule(agg::fill_even_odd);
+
+               if (shape->FillColour.Alpha > 0) {
+                  if (auto cmd = record(DL_SOLID, shape, shape->FillRaster, view_width, view_height)) {
+                     cmd->Colour = agg::rgba(shape->FillColour.Red, shape->FillColour.Green, shape->FillColour.Blue, shape->FillColour.Alpha * shape->FillOpacity * state.mOpacity);
+                  }
+               }
+
+               if (shape->FillImage) {
+                  if (auto cmd = record(DL_IMAGE, shape, shape->FillRaster, view_width, view_height)) {
+                     cmd->Paint   = shape->FillImage;
+                     cmd->Opacity = shape->FillOpacity * state.mOpacity;
+                  }
+               }
+
+               if (shape->FillGradient) {
+                  if (GRADIENT_TABLE *table = get_fill_gradient_table(*shape, state.mOpacity * shape->FillOpacity)) {
+                     if (auto cmd = record(DL_GRADIENT, shape, shape->FillRaster, view_width, view_height)) {
+                        cmd->Paint = shape->FillGradient;
+                        cmd->Table = table;
+                     }
+                  }
+                  else LogErrorMsg("Failed to generate filled gradient for vector #%d", shape->Head.UniqueID);
+               }
+
+               if (shape->FillPattern) {
+                  refresh_pattern(*shape->FillPattern);
+                  if (auto cmd = record(DL_PATTERN, shape, shape->FillRaster, view_width, view_height)) {
+                     cmd->Paint = shape->FillPattern;
+                  }
+               }
+            }
+
+            if (shape->StrokeRaster) {
+               if (shape->Scene->Gamma != 1.0) shape->StrokeRaster->gamma(agg::gamma_power(shape->Scene->Gamma));
+
+               if (shape->FillRule IS VFR_NON_ZERO) shape->StrokeRaster->filling_rule(agg::fill_non_zero);
+               else if (shape->FillRule IS VFR_EVEN_ODD) shape->StrokeRaster->filling_rule(agg::fill_even_odd);
+
+               if (shape->StrokeGradient) {
+                  if (GRADIENT_TABLE *table = get_stroke_gradient_table(*shape)) {
+                     if (auto cmd = record(DL_GRADIENT, shape, shape->StrokeRaster, view_width, view_height)) {
+                        cmd->Paint       = shape->StrokeGradient;
+                        cmd->Table       = table;
+                        cmd->BorderWidth = shape->StrokeWidth;
+                     }
+                  }
+                  else LogErrorMsg("Failed to generate stroked gradient for vector #%d", shape->Head.UniqueID);
+               }
+               else if (shape->StrokePattern) {
+                  refresh_pattern(*shape->StrokePattern);
+                  if (auto cmd = record(DL_PATTERN, shape, shape->StrokeRaster, view_width, view_height)) {
+                     cmd->Paint = shape->StrokePattern;
+                  }
+               }
+               else if (auto cmd = record(DL_SOLID, shape, shape->StrokeRaster, view_width, view_height)) {
+                  cmd->Colour = agg::rgba(shape->StrokeColour.Red, shape->StrokeColour.Green, shape->StrokeColour.Blue, shape->StrokeColour.Alpha * shape->StrokeOpacity * state.mOpacity);
+               }
+            }
+         }
+         else if (shape->Child) record_vectors((objVector *)shape->Child, state);
+      }
+   }
+
    // This is the main routine for parsing the vector tree for drawing.
 
    void draw_vectors(objVector *CurrentVector, VectorState &ParentState)
@@ -858,9 +1281,10 @@ private:
          }
 
          if (shape->Dirty) {
-            gen_vector_path(shape);
+            gen_scene_path(Scene, shape);
             shape->Dirty = 0;
          }
+         shape->PaintDirty = FALSE;
 
          // Visibility management.
 
@@ -877,6 +1301,8 @@ private:
             }
          }
 
+         if (is_culled(shape)) continue;
+
          objVectorFilter *filter;
          if ((filter = shape->Filter)) {
             parasol::Log log;
@@ -886,7 +1312,13 @@ private:
 
             if (!SetPointer(filter, FID_Vector, shape)) { // Divert rendering of this vector through the filter.
                filter->BkgdBitmap = mBitmap;
-               acDraw(filter);
+               set_filter_pool(filter, scratch_pool(Scene));
+               if (Scene->Flags & VPF_RENDER_TIME) {
+                  const LARGE start = PreciseTime();
+                  acDraw(filter);
+                  Scene->FilterTime += PreciseTime() - start;
+               }
+               else acDraw(filter);
             }
             else log.trace("Failed to set Vector reference on Filter.");
 
@@ -907,13 +1339,9 @@ private:
 
          objBitmap *bmpBkgd = NULL;
          objBitmap *bmpSave = NULL;
-         if (shape->EnableBkgd) { // If the current bitmap already has the alpha-channel enabled then we don't need a new bitmap.
-            if (!CreateObject(ID_BITMAP, NF_INTEGRAL, &bmpBkgd,
-                  FID_Width|TLONG,  mBitmap->Width,
-                  FID_Height|TLONG, mBitmap->Height,
-                  FID_BitsPerPixel, 32,
-                  FID_Flags|TLONG,  BMF_ALPHA_CHANNEL,
-                  TAGEND)) {
+         ScratchPool *pool = NULL;
+         if (shape->EnableBkgd) { // The background layer is borrowed from the scene's scratch pool.
+            if ((pool = scratch_pool(Scene)) and (bmpBkgd = pool->borrow_bitmap(mBitmap->Width, mBitmap->Height))) {
                bmpSave = mBitmap;
                mBitmap = bmpBkgd;
                mFormat.setBitmap(*bmpBkgd);
@@ -1095,7 +1523,7 @@ private:
             mBitmap = bmpSave;
             mFormat.setBitmap(*mBitmap);
             drawBitmap(shape->Scene->SampleMethod, mRenderBase, raster, bmpBkgd, VSPREAD_CLIP, 1.0, NULL, 0, 0);
-            acFree(bmpBkgd);
+            pool->give_back_bitmap(bmpBkgd);
          }
 
          #ifdef DBG_DRAW
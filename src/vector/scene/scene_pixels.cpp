@@ -62,11 +62,17 @@ INLINE void COPY32(UBYTE *p, UBYTE r, UBYTE g, UBYTE b, UBYTE a, UBYTE cr, UBYTE
 }
 */
 
+#include "scene_spans.cpp"
+
 //****************************************************************************
-// These functions convert bitmaps between linear and RGB format with a pre-calculated gamma table.
+// These functions convert bitmaps between linear and RGB format with a pre-calculated gamma table.  They are marked
+// as unused because the unit tests include this file without calling them.
 
 static agg::gamma_lut<UBYTE, UWORD, 8, 12> glGamma(2.2);
 
+static void rgb2linear(objBitmap &) __attribute__((unused));
+static void linear2RGB(objBitmap &) __attribute__((unused));
+
 static void rgb2linear(objBitmap &Bitmap)
 {
    if (Bitmap.BytesPerPixel < 4) return;
@@ -129,8 +135,8 @@ public:
    typedef agg::rgba8 color_type;
    typedef typename agg::rendering_buffer::row_data row_data;
 
-   pixfmt_rkl() :  oR(0), oG(0), oB(0), oA(0) {}
-   explicit pixfmt_rkl(objBitmap &Bitmap) : oR(0), oG(0), oB(0), oA(0) {
+   pixfmt_rkl() : mSpans(NULL), oR(0), oG(0), oB(0), oA(0) {}
+   explicit pixfmt_rkl(objBitmap &Bitmap) : mSpans(NULL), oR(0), oG(0), oB(0), oA(0) {
       setBitmap(Bitmap);
    }
 
@@ -138,6 +144,7 @@ public:
       mBitmap = &Bitmap;
 
       mData = Bitmap.Data + (Bitmap.XOffset * Bitmap.BytesPerPixel) + (Bitmap.YOffset * Bitmap.LineWidth);
+      mSpans = NULL;
 
       if (Bitmap.BitsPerPixel IS 32) {
          fBlendHLine      = &blendHLine32;
@@ -151,12 +158,14 @@ public:
                fBlendPix = &blend32BGRA;
                fCopyPix  = &copy32BGRA;
                fCoverPix = &cover32BGRA;
+               use_spans(get_span_kernels(true));
             }
             else {
                pixel_order(0, 1, 2, 3); // RGBA
                fBlendPix = &blend32RGBA;
                fCopyPix  = &copy32RGBA;
                fCoverPix = &cover32RGBA;
+               use_spans(get_span_kernels(false));
             }
          }
          else if (Bitmap.ColourFormat->RedPos IS 24) {
@@ -238,6 +247,32 @@ private:
       oA = aoA;
    }
 
+   // Replace the generic 32-bit span routines with SIMD kernels, if available for this CPU.
+
+   void use_spans(const span_kernels *Spans)
+   {
+      if (!Spans) return;
+      mSpans = Spans;
+      fBlendHLine      = &blendHLine32SIMD;
+      fBlendSolidHSpan = &blendSolidHSpan32SIMD;
+      fBlendColorHSpan = &blendColorHSpan32SIMD;
+   }
+
+   static void blendHLine32SIMD(agg::pixfmt_rkl *Self, int x, int y, unsigned len, const agg::rgba8 &c, int8u cover) noexcept
+   {
+      Self->mSpans->BlendHLine(Self->mData + (y * Self->mBitmap->LineWidth) + (x<<2), len, c, cover);
+   }
+
+   static void blendSolidHSpan32SIMD(agg::pixfmt_rkl *Self, int x, int y, ULONG len, const agg::rgba8 &c, const UBYTE *covers) noexcept
+   {
+      Self->mSpans->BlendSolidHSpan(Self->mData + (y * Self->mBitmap->LineWidth) + (x<<2), len, c, covers);
+   }
+
+   static void blendColorHSpan32SIMD(agg::pixfmt_rkl *Self, int x, int y, ULONG len, const agg::rgba8 *colors, const UBYTE *covers, UBYTE cover) noexcept
+   {
+      Self->mSpans->BlendColorHSpan(Self->mData + (y * Self->mBitmap->LineWidth) + (x<<2), len, colors, covers, cover);
+   }
+
    // Blend the pixel at (p) with the provided colour values and store the result back in (p)
 
    static void blend32BGRA(agg::pixfmt_rkl *Self, UBYTE *p, ULONG cr, ULONG cg, ULONG cb, ULONG alpha) noexcept
@@ -895,6 +930,7 @@ public:
 public:
    UBYTE *mData;
    struct rkBitmap *mBitmap;
+   const span_kernels *mSpans;
    UBYTE oR, oG, oB, oA;
 };
 
@@ -0,0 +1,141 @@
+/*****************************************************************************
+
+The scratch pool recycles the temporary 32-bit surfaces that are needed while a scene is being drawn, such as the
+layers for enable-background and the effect bitmaps of filters.  Each VectorScene owns a pool, and surfaces are
+borrowed from it and given back once the drawing that needs them has completed.  In the steady state of an animation
+every request is met from the pool, so no memory is allocated and no Bitmap objects are created between frames.
+
+Buffers are filed by size class.  There are four classes for each power of two, so a buffer can be wasteful by 25% at
+most.  Buffers that have not been borrowed for SCRATCH_IDLE_FRAMES draws of the scene are released.
+
+A filter that retains its results between draws keeps a reference to the pool that it borrowed from, so the pool
+outlives its scene until the last of its surfaces has been given back.
+
+*****************************************************************************/
+
+#define SCRATCH_MIN_SIZE    4096 // Smallest size class, in bytes
+#define SCRATCH_IDLE_FRAMES 4    // Idle buffers are released if they are not borrowed within this many scene draws
+#define SCRATCH_MAX_HEADERS 16   // Maximum number of idle Bitmap headers to retain
+
+class ScratchPool {
+private:
+   struct idle_buffer {
+      UBYTE *Data;
+      LONG Frame; // The frame in which the buffer was given back
+   };
+
+   std::unordered_map<LONG, std::vector<idle_buffer>> mIdle; // Keyed by size class
+   std::vector<objBitmap *> mHeaders; // Idle bitmaps without a data area
+   LONG mFrame = 0;
+   LONG mRefs = 1;
+
+   ~ScratchPool() {
+      for (auto &cls : mIdle) {
+         for (auto &buffer : cls.second) FreeResource(buffer.Data);
+      }
+      for (auto bmp : mHeaders) acFree(bmp);
+   }
+
+public:
+   void retain() { mRefs++; }
+   void release() { if (!--mRefs) delete this; }
+
+   // Returns the size class for a buffer of Size bytes, which is also the true capacity of the buffer.  Size classes
+   // map to themselves.
+
+   static LONG size_class(LONG Size) {
+      if (Size <= SCRATCH_MIN_SIZE) return SCRATCH_MIN_SIZE;
+      LONG step = SCRATCH_MIN_SIZE / 4;
+      while (step * 8 <= Size) step <<= 1;
+      return (Size + step - 1) & ~(step - 1);
+   }
+
+   // Borrow an uncleared buffer of at least Size bytes.  The capacity of the buffer is returned in Capacity and must
+   // be passed to give_back().
+
+   UBYTE * borrow(LONG Size, LONG *Capacity) {
+      const LONG size = size_class(Size);
+
+      auto it = mIdle.find(size);
+      if ((it != mIdle.end()) and (!it->second.empty())) {
+         UBYTE *data = it->second.back().Data;
+         it->second.pop_back();
+         *Capacity = size;
+         return data;
+      }
+
+      UBYTE *data;
+      if (AllocMemory(size, MEM_DATA|MEM_NO_CLEAR|MEM_UNTRACKED, &data, NULL)) return NULL;
+      *Capacity = size;
+      return data;
+   }
+
+   void give_back(UBYTE *Data, LONG Capacity) {
+      if (Data) mIdle[Capacity].push_back({ Data, mFrame });
+   }
+
+   // Borrow an uncleared 32-bit bitmap with an alpha channel.  The content of the bitmap is undefined.
+
+   objBitmap * borrow_bitmap(LONG Width, LONG Height) {
+      objBitmap *bmp;
+      if (!mHeaders.empty()) {
+         bmp = mHeaders.back();
+         mHeaders.pop_back();
+      }
+      else if (CreateObject(ID_BITMAP, NF_UNTRACKED, &bmp,
+            FID_Name|TSTR,          "ScratchBitmap",
+            FID_Width|TLONG,        1,
+            FID_Height|TLONG,       1,
+            FID_BitsPerPixel|TLONG, 32,
+            FID_Flags|TLONG,        BMF_ALPHA_CHANNEL|BMF_NO_DATA,
+            TAGEND)) return NULL;
+
+      LONG capacity;
+      if (!(bmp->Data = borrow(Width * Height * bmp->BytesPerPixel, &capacity))) {
+         mHeaders.push_back(bmp);
+         return NULL;
+      }
+
+      bmp->Width       = Width;
+      bmp->Height      = Height;
+      bmp->LineWidth   = Width * bmp->BytesPerPixel;
+      bmp->Size        = bmp->LineWidth * Height;
+      bmp->Clip.Left   = 0;
+      bmp->Clip.Top    = 0;
+      bmp->Clip.Right  = Width;
+      bmp->Clip.Bottom = Height;
+      bmp->Opacity     = 255;
+      return bmp;
+   }
+
+   void give_back_bitmap(objBitmap *Bitmap) {
+      give_back(Bitmap->Data, size_class(Bitmap->LineWidth * Bitmap->Height));
+      Bitmap->Data = NULL;
+      if ((LONG)mHeaders.size() < SCRATCH_MAX_HEADERS) mHeaders.push_back(Bitmap);
+      else acFree(Bitmap);
+   }
+
+   // Called on completion of each scene draw.  Buffers that have been idle for too long are released.
+
+   void end_frame() {
+      mFrame++;
+      for (auto &cls : mIdle) {
+         auto &list = cls.second;
+         LONG keep = 0;
+         for (LONG i=0; i < (LONG)list.size(); i++) {
+            if (mFrame - list[i].Frame > SCRATCH_IDLE_FRAMES) FreeResource(list[i].Data);
+            else list[keep++] = list[i];
+         }
+         list.resize(keep);
+      }
+   }
+};
+
+//****************************************************************************
+// Returns the scratch pool of a scene, allocating it on first use.
+
+static ScratchPool * scratch_pool(objVectorScene *Scene)
+{
+   if (!Scene->Scratch) Scene->Scratch = new (std::nothrow) ScratchPool;
+   return Scene->Scratch;
+}
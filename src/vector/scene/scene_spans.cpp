@@ -0,0 +1,215 @@
+/*****************************************************************************
+
+SIMD span kernels for 32-bit BGRA and RGBA bitmaps.  These replace the generic blendHLine32(), blendSolidHSpan32() and
+blendColorHSpan32() routines of pixfmt_rkl and produce results that are bit-identical to BLEND32() and COPY32().  The
+best instruction set is chosen once at startup via CPUID and can be overridden by setting glSpanISA prior to calling
+pixfmt_rkl::setBitmap().
+
+The SSE kernels share their helpers, and the explanation of the blend formula, with the display module's blitter
+in display/simd_blend.h.
+
+*****************************************************************************/
+
+enum { SPAN_SCALAR=0, SPAN_SSE2, SPAN_SSSE3, SPAN_AVX2, SPAN_END };
+
+static const CSTRING glSpanISANames[SPAN_END] = { "Scalar", "SSE2", "SSSE3", "AVX2" };
+
+struct span_kernels {
+   void (*BlendHLine)(UBYTE *, ULONG Length, const agg::rgba8 &, UBYTE Cover);
+   void (*BlendSolidHSpan)(UBYTE *, ULONG Length, const agg::rgba8 &, const UBYTE *Covers);
+   void (*BlendColorHSpan)(UBYTE *, ULONG Length, const agg::rgba8 *, const UBYTE *Covers, UBYTE Cover);
+};
+
+//****************************************************************************
+// Scalar equivalents, used for the pixels that remain at the end of each span.
+
+template <bool BGRA> INLINE ULONG span_pack(ULONG R, ULONG G, ULONG B, ULONG A)
+{
+   if (BGRA) return B | (G<<8) | (R<<16) | (A<<24);
+   else return R | (G<<8) | (B<<16) | (A<<24);
+}
+
+// Equivalent to cover32BGRA() and cover32RGBA() once the alpha value has been multiplied by the coverage.
+
+template <bool BGRA> INLINE void span_pixel(UBYTE *p, ULONG R, ULONG G, ULONG B, ULONG Alpha)
+{
+   if ((Alpha IS 0xff) or (!p[3])) *(ULONG *)p = span_pack<BGRA>(R, G, B, Alpha);
+   else if (BGRA) BLEND32(p, 2, 1, 0, 3, R, G, B, Alpha);
+   else BLEND32(p, 0, 1, 2, 3, R, G, B, Alpha);
+}
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+
+#include <immintrin.h>
+#include "../../display/simd_blend.h"
+
+#define SIMD_NS     span_sse2
+#define SIMD_TARGET "sse2"
+#define SIMD_SSSE3  0
+#include "scene_spans_sse.cpp"
+#undef SIMD_NS
+#undef SIMD_TARGET
+#undef SIMD_SSSE3
+
+#define SIMD_NS     span_ssse3
+#define SIMD_TARGET "ssse3"
+#define SIMD_SSSE3  1
+#include "scene_spans_sse.cpp"
+#undef SIMD_NS
+#undef SIMD_TARGET
+#undef SIMD_SSSE3
+
+//****************************************************************************
+// AVX2 kernels process eight pixels per iteration.
+
+namespace span_avx2 {
+
+#define AVX2_INLINE static inline __attribute__((target("avx2"), always_inline))
+#define AVX2_KERNEL static __attribute__((target("avx2")))
+
+AVX2_INLINE __m256i select8(__m256i Mask, __m256i A, __m256i B)
+{
+   return _mm256_or_si256(_mm256_and_si256(Mask, A), _mm256_andnot_si256(Mask, B));
+}
+
+AVX2_INLINE __m256i covers8(const UBYTE *Covers)
+{
+   return _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)Covers));
+}
+
+template <bool BGRA> AVX2_INLINE __m256i order8(__m256i C)
+{
+   if (!BGRA) return C;
+   return _mm256_shuffle_epi8(C, _mm256_setr_epi8(2,1,0,3, 6,5,4,7, 10,9,8,11, 14,13,12,15,
+      2,1,0,3, 6,5,4,7, 10,9,8,11, 14,13,12,15));
+}
+
+// S is the source colour in bitmap order with the effective alpha in the top byte.  Pixels marked in Skip are
+// returned unchanged.
+
+AVX2_INLINE __m256i blend8(__m256i D, __m256i S, __m256i Skip)
+{
+   const __m256i zero = _mm256_setzero_si256();
+   const __m256i copy = _mm256_or_si256(_mm256_cmpeq_epi32(_mm256_srli_epi32(S, 24), _mm256_set1_epi32(0xff)),
+      _mm256_cmpeq_epi32(_mm256_srli_epi32(D, 24), zero));
+   const __m256i src  = _mm256_or_si256(S, _mm256_set1_epi32(0xff000000));
+   const __m256i alo  = _mm256_shuffle_epi8(S, _mm256_setr_epi8(3,-1,3,-1,3,-1,3,-1, 7,-1,7,-1,7,-1,7,-1,
+      3,-1,3,-1,3,-1,3,-1, 7,-1,7,-1,7,-1,7,-1));
+   const __m256i ahi  = _mm256_shuffle_epi8(S, _mm256_setr_epi8(11,-1,11,-1,11,-1,11,-1, 15,-1,15,-1,15,-1,15,-1,
+      11,-1,11,-1,11,-1,11,-1, 15,-1,15,-1,15,-1,15,-1));
+   const __m256i k256 = _mm256_set1_epi16(256);
+
+   const __m256i lo = _mm256_add_epi16(_mm256_mullo_epi16(_mm256_unpacklo_epi8(D, zero), _mm256_sub_epi16(k256, alo)),
+      _mm256_mullo_epi16(_mm256_unpacklo_epi8(src, zero), alo));
+   const __m256i hi = _mm256_add_epi16(_mm256_mullo_epi16(_mm256_unpackhi_epi8(D, zero), _mm256_sub_epi16(k256, ahi)),
+      _mm256_mullo_epi16(_mm256_unpackhi_epi8(src, zero), ahi));
+
+   const __m256i out = _mm256_packus_epi16(_mm256_srli_epi16(lo, 8), _mm256_srli_epi16(hi, 8));
+   return select8(Skip, D, select8(copy, S, out));
+}
+
+template <bool BGRA> AVX2_KERNEL void blend_hline(UBYTE *p, ULONG Length, const agg::rgba8 &c, UBYTE Cover)
+{
+   if (!c.a) return;
+   const ULONG alpha = (ULONG(c.a) * (ULONG(Cover) + 1)) >> 8;
+   const ULONG colour = span_pack<BGRA>(c.r, c.g, c.b, alpha);
+   const __m256i s = _mm256_set1_epi32(colour);
+
+   if (alpha IS 0xff) {
+      for (; Length >= 8; Length -= 8, p += 32) _mm256_storeu_si256((__m256i *)p, s);
+      for (; Length; Length--, p += 4) *(ULONG *)p = colour;
+   }
+   else {
+      const __m256i skip = _mm256_setzero_si256();
+      for (; Length >= 8; Length -= 8, p += 32) {
+         _mm256_storeu_si256((__m256i *)p, blend8(_mm256_loadu_si256((const __m256i *)p), s, skip));
+      }
+      for (; Length; Length--, p += 4) span_pixel<BGRA>(p, c.r, c.g, c.b, alpha);
+   }
+}
+
+template <bool BGRA> AVX2_KERNEL void blend_solid_hspan(UBYTE *p, ULONG Length, const agg::rgba8 &c, const UBYTE *Covers)
+{
+   if (!c.a) return;
+   const __m256i rgb  = _mm256_set1_epi32(span_pack<BGRA>(c.r, c.g, c.b, 0));
+   const __m256i ca   = _mm256_set1_epi32(c.a);
+   const __m256i one  = _mm256_set1_epi32(1);
+   const __m256i skip = _mm256_setzero_si256();
+   for (; Length >= 8; Length -= 8, p += 32, Covers += 8) {
+      const __m256i alpha = _mm256_srli_epi32(_mm256_mullo_epi16(ca, _mm256_add_epi32(covers8(Covers), one)), 8);
+      const __m256i s = _mm256_or_si256(rgb, _mm256_slli_epi32(alpha, 24));
+      _mm256_storeu_si256((__m256i *)p, blend8(_mm256_loadu_si256((const __m256i *)p), s, skip));
+   }
+
+   for (; Length; Length--, p += 4, Covers++) {
+      span_pixel<BGRA>(p, c.r, c.g, c.b, (ULONG(c.a) * (ULONG(*Covers) + 1)) >> 8);
+   }
+}
+
+template <bool BGRA> AVX2_KERNEL void blend_color_hspan(UBYTE *p, ULONG Length, const agg::rgba8 *Colours, const UBYTE *Covers, UBYTE Cover)
+{
+   const __m256i zero  = _mm256_setzero_si256();
+   const __m256i one   = _mm256_set1_epi32(1);
+   const __m256i rgb   = _mm256_set1_epi32(0x00ffffff);
+   const __m256i cover = _mm256_set1_epi32(ULONG(Cover) + 1);
+   for (; Length >= 8; Length -= 8, p += 32, Colours += 8) {
+      const __m256i col = order8<BGRA>(_mm256_loadu_si256((const __m256i *)Colours));
+      const __m256i a   = _mm256_srli_epi32(col, 24);
+      __m256i cv;
+      if (Covers) { cv = _mm256_add_epi32(covers8(Covers), one); Covers += 8; }
+      else cv = cover;
+      const __m256i alpha = _mm256_srli_epi32(_mm256_mullo_epi16(a, cv), 8);
+      const __m256i s = _mm256_or_si256(_mm256_and_si256(col, rgb), _mm256_slli_epi32(alpha, 24));
+      _mm256_storeu_si256((__m256i *)p, blend8(_mm256_loadu_si256((const __m256i *)p), s, _mm256_cmpeq_epi32(a, zero)));
+   }
+
+   for (; Length; Length--, p += 4, Colours++) {
+      const ULONG cv = Covers ? *Covers++ : Cover;
+      if (Colours->a) span_pixel<BGRA>(p, Colours->r, Colours->g, Colours->b, (ULONG(Colours->a) * (cv + 1)) >> 8);
+   }
+}
+
+#undef AVX2_INLINE
+#undef AVX2_KERNEL
+
+} // namespace
+
+//****************************************************************************
+
+static const span_kernels glSpanKernels[SPAN_END][2] = {
+   { { NULL, NULL, NULL }, { NULL, NULL, NULL } },
+   { { &span_sse2::blend_hline<false>, &span_sse2::blend_solid_hspan<false>, &span_sse2::blend_color_hspan<false> },
+     { &span_sse2::blend_hline<true>, &span_sse2::blend_solid_hspan<true>, &span_sse2::blend_color_hspan<true> } },
+   { { &span_ssse3::blend_hline<false>, &span_ssse3::blend_solid_hspan<false>, &span_ssse3::blend_color_hspan<false> },
+     { &span_ssse3::blend_hline<true>, &span_ssse3::blend_solid_hspan<true>, &span_ssse3::blend_color_hspan<true> } },
+   { { &span_avx2::blend_hline<false>, &span_avx2::blend_solid_hspan<false>, &span_avx2::blend_color_hspan<false> },
+     { &span_avx2::blend_hline<true>, &span_avx2::blend_solid_hspan<true>, &span_avx2::blend_color_hspan<true> } }
+};
+
+static LONG detect_span_isa(void)
+{
+   __builtin_cpu_init();
+   if (__builtin_cpu_supports("avx2")) return SPAN_AVX2;
+   else if (__builtin_cpu_supports("ssse3")) return SPAN_SSSE3;
+   else if (__builtin_cpu_supports("sse2")) return SPAN_SSE2;
+   else return SPAN_SCALAR;
+}
+
+static LONG glSpanISA = detect_span_isa();
+
+#else
+
+static const span_kernels glSpanKernels[SPAN_END][2] = { };
+static LONG glSpanISA = SPAN_SCALAR;
+
+#endif
+
+//****************************************************************************
+// Returns the span kernels for the active instruction set, or NULL if the scalar routines are to be used.
+
+static const span_kernels * get_span_kernels(bool BGRA)
+{
+   if ((glSpanISA <= SPAN_SCALAR) or (glSpanISA >= SPAN_END)) return NULL;
+   const span_kernels *kernels = &glSpanKernels[glSpanISA][BGRA ? 1 : 0];
+   return kernels->BlendHLine ? kernels : NULL;
+}
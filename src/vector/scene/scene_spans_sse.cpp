@@ -0,0 +1,103 @@
+// 128-bit span kernels that process four pixels per iteration.  The SSE2 and SSSE3 passes only differ in the byte
+// shuffles; see display/simd_blend.h for how this file is included.
+
+namespace SIMD_NS {
+
+// Converts four rgba8 values to the byte order of the bitmap.
+
+template <bool BGRA> SSE_INLINE __m128i order4(__m128i C)
+{
+   if (!BGRA) return C;
+#if SIMD_SSSE3
+   return _mm_shuffle_epi8(C, _mm_setr_epi8(2,1,0,3, 6,5,4,7, 10,9,8,11, 14,13,12,15));
+#else
+   const __m128i rb = _mm_and_si128(C, _mm_set1_epi32(0x00ff00ff));
+   return _mm_or_si128(_mm_and_si128(C, _mm_set1_epi32(0xff00ff00)),
+      _mm_or_si128(_mm_srli_epi32(rb, 16), _mm_slli_epi32(rb, 16)));
+#endif
+}
+
+// S is the source colour in bitmap order with the effective alpha in the top byte.  Pixels marked in Skip are
+// returned unchanged.
+
+SSE_INLINE __m128i blend4(__m128i D, __m128i S, __m128i Skip)
+{
+   const __m128i zero = _mm_setzero_si128();
+   const __m128i sa   = _mm_srli_epi32(S, 24);
+   const __m128i copy = _mm_or_si128(_mm_cmpeq_epi32(sa, _mm_set1_epi32(0xff)),
+      _mm_cmpeq_epi32(_mm_srli_epi32(D, 24), zero));
+   const __m128i src  = _mm_or_si128(S, _mm_set1_epi32(0xff000000));
+#if SIMD_SSSE3
+   const __m128i alo = _mm_shuffle_epi8(S, _mm_setr_epi8(3,-1,3,-1,3,-1,3,-1, 7,-1,7,-1,7,-1,7,-1));
+   const __m128i ahi = _mm_shuffle_epi8(S, _mm_setr_epi8(11,-1,11,-1,11,-1,11,-1, 15,-1,15,-1,15,-1,15,-1));
+#else
+   const __m128i a16 = _mm_or_si128(sa, _mm_slli_epi32(sa, 16));
+   const __m128i alo = _mm_unpacklo_epi32(a16, a16);
+   const __m128i ahi = _mm_unpackhi_epi32(a16, a16);
+#endif
+   return simd_select4(Skip, D, simd_select4(copy, S, simd_blend256(D, src, alo, ahi)));
+}
+
+template <bool BGRA> SSE_KERNEL void blend_hline(UBYTE *p, ULONG Length, const agg::rgba8 &c, UBYTE Cover)
+{
+   if (!c.a) return;
+   const ULONG alpha = (ULONG(c.a) * (ULONG(Cover) + 1)) >> 8;
+   const ULONG colour = span_pack<BGRA>(c.r, c.g, c.b, alpha);
+   const __m128i s = _mm_set1_epi32(colour);
+
+   if (alpha IS 0xff) {
+      for (; Length >= 4; Length -= 4, p += 16) _mm_storeu_si128((__m128i *)p, s);
+      for (; Length; Length--, p += 4) *(ULONG *)p = colour;
+   }
+   else {
+      const __m128i skip = _mm_setzero_si128();
+      for (; Length >= 4; Length -= 4, p += 16) {
+         _mm_storeu_si128((__m128i *)p, blend4(_mm_loadu_si128((const __m128i *)p), s, skip));
+      }
+      for (; Length; Length--, p += 4) span_pixel<BGRA>(p, c.r, c.g, c.b, alpha);
+   }
+}
+
+template <bool BGRA> SSE_KERNEL void blend_solid_hspan(UBYTE *p, ULONG Length, const agg::rgba8 &c, const UBYTE *Covers)
+{
+   if (!c.a) return;
+   const __m128i rgb  = _mm_set1_epi32(span_pack<BGRA>(c.r, c.g, c.b, 0));
+   const __m128i ca   = _mm_set1_epi32(c.a);
+   const __m128i one  = _mm_set1_epi32(1);
+   const __m128i skip = _mm_setzero_si128();
+   for (; Length >= 4; Length -= 4, p += 16, Covers += 4) {
+      // The product of alpha and coverage fits in the low 16 bits of each lane.
+      const __m128i alpha = _mm_srli_epi32(_mm_mullo_epi16(ca, _mm_add_epi32(simd_covers4(Covers), one)), 8);
+      const __m128i s = _mm_or_si128(rgb, _mm_slli_epi32(alpha, 24));
+      _mm_storeu_si128((__m128i *)p, blend4(_mm_loadu_si128((const __m128i *)p), s, skip));
+   }
+
+   for (; Length; Length--, p += 4, Covers++) {
+      span_pixel<BGRA>(p, c.r, c.g, c.b, (ULONG(c.a) * (ULONG(*Covers) + 1)) >> 8);
+   }
+}
+
+template <bool BGRA> SSE_KERNEL void blend_color_hspan(UBYTE *p, ULONG Length, const agg::rgba8 *Colours, const UBYTE *Covers, UBYTE Cover)
+{
+   const __m128i zero  = _mm_setzero_si128();
+   const __m128i one   = _mm_set1_epi32(1);
+   const __m128i rgb   = _mm_set1_epi32(0x00ffffff);
+   const __m128i cover = _mm_set1_epi32(ULONG(Cover) + 1);
+   for (; Length >= 4; Length -= 4, p += 16, Colours += 4) {
+      const __m128i col = order4<BGRA>(_mm_loadu_si128((const __m128i *)Colours));
+      const __m128i a   = _mm_srli_epi32(col, 24);
+      __m128i cv;
+      if (Covers) { cv = _mm_add_epi32(simd_covers4(Covers), one); Covers += 4; }
+      else cv = cover;
+      const __m128i alpha = _mm_srli_epi32(_mm_mullo_epi16(a, cv), 8);
+      const __m128i s = _mm_or_si128(_mm_and_si128(col, rgb), _mm_slli_epi32(alpha, 24));
+      _mm_storeu_si128((__m128i *)p, blend4(_mm_loadu_si128((const __m128i *)p), s, _mm_cmpeq_epi32(a, zero)));
+   }
+
+   for (; Length; Length--, p += 4, Colours++) {
+      const ULONG cv = Covers ? *Covers++ : Cover;
+      if (Colours->a) span_pixel<BGRA>(p, Colours->r, Colours->g, Colours->b, (ULONG(Colours->a) * (cv + 1)) >> 8);
+   }
+}
+
+} // namespace
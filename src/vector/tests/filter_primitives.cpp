@@ -0,0 +1,331 @@
+/*****************************************************************************
+
+The source code of the Parasol project is made publicly available under the
+terms described in the LICENSE.TXT file that is distributed with this package.
+Please refer to it for further information on licensing.
+
+******************************************************************************
+
+This program checks the SSE2 filter primitives of filter_pixels.cpp against the scalar code and benchmarks them.
+Random bitmaps with partially transparent pixels are processed in BGRA and RGBA order with random clipping regions,
+and every result must be bit-identical to the output of the scalar code.
+
+The benchmark applies a set of typical SVG filter primitives to 1080p and 4K bitmaps with the scalar and SSE2 code,
+and reports the time taken by each.  Work is distributed across the worker pool of the Core, so the results depend on
+the number of CPU cores that are available.
+
+Options: -iterations [n] -seed [n] -nobench
+
+*****************************************************************************/
+
+#include <parasol/main.h>
+#include <startup.h>
+#include <parasol/modules/core.h>
+#include <parasol/modules/display.h>
+
+#include "agg_basics.h"
+#include "agg_color_rgba.h"
+#include "agg_gamma_lut.h"
+#include "agg_image_accessors.h"
+#include "agg_rendering_buffer.h"
+
+#include <math.h>
+#include <string.h>
+#include <memory>
+#include <vector>
+
+#include "../scene/scene_pixels.cpp"
+#include "../filters/filter_pixels.cpp"
+
+CSTRING ProgName      = "FilterPrimitives";
+CSTRING ProgAuthor    = "Paul Manias";
+CSTRING ProgDate      = "October 2026";
+CSTRING ProgCopyright = "Paul Manias (c) 2026";
+LONG  ProgDebug = -1;
+FLOAT ProgCoreVersion = 1.0;
+
+extern struct CoreBase *CoreBase;
+static LONG glIterations = 40;
+static ULONG glSeed      = 0x2545f491;
+static LONG glFailures   = 0;
+static bool glBenchmark  = true;
+
+enum { P_PREMULTIPLY=0, P_DEMULTIPLY, P_BLUR_SMALL, P_BLUR_MEDIUM, P_BLUR_LARGE, P_BLUR_MIXED, P_ERODE, P_DILATE,
+   P_SATURATE, P_HUE_ROTATE, P_LUMINANCE_ALPHA, P_SHARPEN, P_EMBOSS, P_CONVOLVE_5X5, P_END };
+
+static const CSTRING glPrimitiveNames[P_END] = { "premultiply", "demultiply", "feGaussianBlur 3", "feGaussianBlur 20",
+   "feGaussianBlur 150", "feGaussianBlur 2,150", "feMorphology erode 2", "feMorphology dilate 5",
+   "feColorMatrix saturate", "feColorMatrix hueRotate", "feColorMatrix luminance", "feConvolveMatrix 3x3",
+   "feConvolveMatrix emboss", "feConvolveMatrix 5x5" };
+
+static DOUBLE glSaturate[20], glHueRotate[20];
+
+static const DOUBLE glLuminanceToAlpha[20] = { 0,0,0,0,0, 0,0,0,0,0, 0,0,0,0,0, 0.2125,0.7154,0.0721,0,0 };
+
+static ConvolveMatrix glSharpen, glEmboss, glConvolve5;
+
+//****************************************************************************
+
+static ULONG rnd(void)
+{
+   glSeed ^= glSeed << 13;
+   glSeed ^= glSeed >> 17;
+   glSeed ^= glSeed << 5;
+   return glSeed;
+}
+
+// Favour the alpha values that select special cases in the filter code.
+
+static UBYTE rnd_alpha(void)
+{
+   switch (rnd() % 4) {
+      case 0:  return 0;
+      case 1:  return 255;
+      default: return rnd();
+   }
+}
+
+//****************************************************************************
+// The matrices are calculated as described in the SVG specification.
+
+static void init_matrices(void)
+{
+   const DOUBLE s = 0.5;
+   const DOUBLE saturate[20] = {
+      0.213+0.787*s, 0.715-0.715*s, 0.072-0.072*s, 0, 0,
+      0.213-0.213*s, 0.715+0.285*s, 0.072-0.072*s, 0, 0,
+      0.213-0.213*s, 0.715-0.715*s, 0.072+0.928*s, 0, 0,
+      0, 0, 0, 1, 0 };
+   CopyMemory(saturate, glSaturate, sizeof(saturate));
+
+   const DOUBLE c = cos(90.0 * agg::pi / 180.0), n = sin(90.0 * agg::pi / 180.0);
+   const DOUBLE hue[20] = {
+      0.213+c*0.787-n*0.213, 0.715-c*0.715-n*0.715, 0.072-c*0.072+n*0.928, 0, 0,
+      0.213-c*0.213+n*0.143, 0.715+c*0.285+n*0.140, 0.072-c*0.072-n*0.283, 0, 0,
+      0.213-c*0.213-n*0.787, 0.715-c*0.715+n*0.715, 0.072+c*0.928+n*0.072, 0, 0,
+      0, 0, 0, 1, 0 };
+   CopyMemory(hue, glHueRotate, sizeof(hue));
+
+   const DOUBLE sharpen[9] = { 0,-1,0, -1,5,-1, 0,-1,0 };
+   const DOUBLE emboss[9]  = { -2,-1,0, -1,1,1, 0,1,2 };
+
+   glSharpen.FilterWidth = glSharpen.FilterHeight = 3;
+   for (LONG i=0; i < 9; i++) glSharpen.KernelMatrix[i] = sharpen[i];
+   glSharpen.Divisor = 1;
+   glSharpen.TargetX = glSharpen.TargetY = 1;
+
+   glEmboss = glSharpen;
+   for (LONG i=0; i < 9; i++) glEmboss.KernelMatrix[i] = emboss[i];
+   glEmboss.Bias = 0.5;
+   glEmboss.PreserveAlpha = true;
+   glEmboss.EdgeMode = EM_NONE;
+
+   glConvolve5.FilterWidth = glConvolve5.FilterHeight = 5;
+   glConvolve5.TargetX = glConvolve5.TargetY = 2;
+   glConvolve5.EdgeMode = EM_WRAP;
+   DOUBLE divisor = 0;
+   for (LONG i=0; i < 25; i++) divisor += glConvolve5.KernelMatrix[i] = 1 + (i % 7) - (i % 3);
+   glConvolve5.Divisor = divisor;
+
+   glSharpen.FilterSize = 9;
+   glEmboss.FilterSize = 9;
+   glConvolve5.FilterSize = 25;
+}
+
+static void run_primitive(objBitmap &Bitmap, LONG Primitive)
+{
+   switch (Primitive) {
+      case P_PREMULTIPLY:     premultiply_bitmap(&Bitmap); break;
+      case P_DEMULTIPLY:      demultiply_bitmap(&Bitmap); break;
+      case P_BLUR_SMALL:      blur_bitmap(&Bitmap, 3, 3); break;
+      case P_BLUR_MEDIUM:     blur_bitmap(&Bitmap, 20, 20); break;
+      case P_BLUR_LARGE:      blur_bitmap(&Bitmap, 150, 150); break;
+      case P_BLUR_MIXED:      blur_bitmap(&Bitmap, 2, 150); break;
+      case P_ERODE:           morph_bitmap(&Bitmap, 2, 2, false); break;
+      case P_DILATE:          morph_bitmap(&Bitmap, 5, 5, true); break;
+      case P_SATURATE:        cmatrix_bitmap(&Bitmap, glSaturate); break;
+      case P_HUE_ROTATE:      cmatrix_bitmap(&Bitmap, glHueRotate); break;
+      case P_LUMINANCE_ALPHA: cmatrix_bitmap(&Bitmap, glLuminanceToAlpha); break;
+      case P_SHARPEN:         glSharpen.apply(&Bitmap); break;
+      case P_EMBOSS:          glEmboss.apply(&Bitmap); break;
+      case P_CONVOLVE_5X5:    glConvolve5.apply(&Bitmap); break;
+   }
+}
+
+//****************************************************************************
+
+static void init_bitmap(objBitmap &Bitmap, ColourFormat &Format, UBYTE *Data, LONG Width, LONG Height, bool BGRA)
+{
+   ClearMemory(&Format, sizeof(Format));
+   Format.RedPos   = BGRA ? 16 : 0;
+   Format.GreenPos = 8;
+   Format.BluePos  = BGRA ? 0 : 16;
+   Format.AlphaPos = 24;
+   Format.RedMask = Format.GreenMask = Format.BlueMask = Format.AlphaMask = 0xff;
+   Format.BitsPerPixel = 32;
+
+   ClearMemory(&Bitmap, sizeof(Bitmap));
+   Bitmap.Data          = Data;
+   Bitmap.Width         = Width;
+   Bitmap.Height        = Height;
+   Bitmap.LineWidth     = Width * 4;
+   Bitmap.BytesPerPixel = 4;
+   Bitmap.BitsPerPixel  = 32;
+   Bitmap.ColourFormat  = &Format;
+   Bitmap.Clip.Right    = Width;
+   Bitmap.Clip.Bottom   = Height;
+}
+
+// Smooth content is generated so that the blur and morphology results are not uniform.
+
+static void fill_bitmap(UBYTE *Data, LONG Width, LONG Height)
+{
+   const LONG cx = rnd() % Width, cy = rnd() % Height;
+   for (LONG y=0; y < Height; y++) {
+      for (LONG x=0; x < Width; x++) {
+         UBYTE *pixel = Data + (((y * Width) + x)<<2);
+         if ((rnd() % 16) IS 0) {
+            pixel[0] = rnd(); pixel[1] = rnd(); pixel[2] = rnd(); pixel[3] = rnd_alpha();
+         }
+         else {
+            pixel[0] = x + y;
+            pixel[1] = (x * 3) ^ y;
+            pixel[2] = ((x - cx) * (x - cx) + (y - cy) * (y - cy)) >> 4;
+            pixel[3] = ((x / 7) & 1) ? 255 : (x * y) >> 3;
+         }
+      }
+   }
+}
+
+//****************************************************************************
+// Each primitive is applied to identical bitmaps with the scalar and SSE2 code, and the entire bitmap is compared so
+// that writes outside of the clipping region are detected too.
+
+static void test_primitives(bool BGRA)
+{
+   for (LONG p=0; p < P_END; p++) {
+      LONG mismatches = 0;
+      for (LONG i=0; i < glIterations; i++) {
+         const LONG width  = 1 + (rnd() % 96);
+         const LONG height = 1 + (rnd() % 96);
+
+         std::vector<UBYTE> expected(width * height * 4), result(width * height * 4);
+         fill_bitmap(expected.data(), width, height);
+         result = expected;
+
+         objBitmap expect_bmp, result_bmp;
+         ColourFormat expect_fmt, result_fmt;
+         init_bitmap(expect_bmp, expect_fmt, expected.data(), width, height, BGRA);
+         init_bitmap(result_bmp, result_fmt, result.data(), width, height, BGRA);
+
+         if (rnd() & 1) {
+            expect_bmp.Clip.Left   = rnd() % width;
+            expect_bmp.Clip.Top    = rnd() % height;
+            expect_bmp.Clip.Right  = expect_bmp.Clip.Left + 1 + (rnd() % (width - expect_bmp.Clip.Left));
+            expect_bmp.Clip.Bottom = expect_bmp.Clip.Top + 1 + (rnd() % (height - expect_bmp.Clip.Top));
+            result_bmp.Clip = expect_bmp.Clip;
+         }
+
+         const LONG detected = glSpanISA;
+         glSpanISA = SPAN_SCALAR;
+         run_primitive(expect_bmp, p);
+         glSpanISA = detected;
+         run_primitive(result_bmp, p);
+
+         if (expected != result) {
+            if (!mismatches) {
+               for (LONG n=0; n < width * height; n++) {
+                  if (((ULONG *)expected.data())[n] != ((ULONG *)result.data())[n]) {
+                     print("%s %s: pixel (%d,%d) is $%.8x, expected $%.8x (size: %dx%d)", glPrimitiveNames[p],
+                        BGRA ? "BGRA" : "RGBA", n % width, n / width, ((ULONG *)result.data())[n],
+                        ((ULONG *)expected.data())[n], width, height);
+                     break;
+                  }
+               }
+            }
+            mismatches++;
+         }
+      }
+
+      print("%-25s %s: %d bitmaps, %d mismatches", glPrimitiveNames[p], BGRA ? "BGRA" : "RGBA", glIterations, mismatches);
+      if (mismatches) glFailures++;
+   }
+}
+
+//****************************************************************************
+
+static void benchmark(LONG Width, LONG Height)
+{
+   std::vector<UBYTE> source(Width * Height * 4), work(Width * Height * 4);
+   fill_bitmap(source.data(), Width, Height);
+
+   objBitmap bmp;
+   ColourFormat fmt;
+   init_bitmap(bmp, fmt, work.data(), Width, Height, true);
+
+   print("%dx%d:", Width, Height);
+
+   const LONG detected = glSpanISA;
+   for (LONG p=0; p < P_END; p++) {
+      DOUBLE ms[2];
+      for (LONG simd=0; simd < 2; simd++) {
+         glSpanISA = simd ? detected : SPAN_SCALAR;
+         work = source;
+         LARGE start = PreciseTime();
+         run_primitive(bmp, p);
+         ms[simd] = DOUBLE(PreciseTime() - start) / 1000.0;
+      }
+      glSpanISA = detected;
+
+      print("  %-25s scalar %8.2f ms   SSE2 %8.2f ms   x%.2f", glPrimitiveNames[p], ms[0], ms[1],
+         ms[1] > 0 ? ms[0] / ms[1] : 0.0);
+   }
+}
+
+//****************************************************************************
+
+int main(int argc, CSTRING *argv)
+{
+   const char *msg = init_parasol(argc, argv);
+   if (msg) {
+      print(msg);
+      return -1;
+   }
+
+   CSTRING *args;
+   if ((!GetPointer(CurrentTask(), FID_Parameters, &args)) and (args)) {
+      for (LONG i=0; args[i]; i++) {
+         if (!StrMatch(args[i], "-iterations")) {
+            if (args[++i]) glIterations = StrToInt(args[i]);
+            else break;
+         }
+         else if (!StrMatch(args[i], "-seed")) {
+            if (args[++i]) glSeed = StrToInt(args[i]);
+            else break;
+         }
+         else if (!StrMatch(args[i], "-nobench")) glBenchmark = false;
+      }
+   }
+
+   if (!glSeed) glSeed = 1;
+
+   init_matrices();
+
+   print("Detected instruction set: %s, %d threads", glSpanISANames[glSpanISA], LONG(GetResource(RES_THREAD_POOL)));
+
+   if (glSpanISA >= SPAN_SSE2) {
+      test_primitives(true);
+      test_primitives(false);
+   }
+   else print("SSE2 is not available, the results will not be compared.");
+
+   if (glBenchmark) {
+      benchmark(1920, 1080);
+      benchmark(3840, 2160);
+   }
+
+   if (glFailures) print("%d failures detected.", glFailures);
+
+   close_parasol();
+   return glFailures ? -1 : 0;
+}
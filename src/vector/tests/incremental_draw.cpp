@@ -0,0 +1,237 @@
+/*****************************************************************************
+
+The source code of the Parasol project is made publicly available under the
+terms described in the LICENSE.TXT file that is distributed with this package.
+Please refer to it for further information on licensing.
+
+******************************************************************************
+
+This program checks the INCREMENTAL drawing mode of the VectorScene.  Two identical scenes are built, one of which is
+drawn incrementally while the other is drawn in full with the CLEAR flag.  The same change is applied to both scenes at
+each step (paint, position, visibility, opacity, stacking order, removal of a vector) and the bitmaps must be
+identical after every Draw.  Each incremental Draw must also report a damaged area that is smaller than the bitmap.
+
+Drawing is performed in memory only, so the display module is opened with the headless driver.
+
+*****************************************************************************/
+
+#include <parasol/main.h>
+#include <startup.h>
+#include <parasol/modules/core.h>
+#include <parasol/modules/display.h>
+#include <parasol/modules/vector.h>
+
+#include <string.h>
+#include <vector>
+
+CSTRING ProgName      = "IncrementalDraw";
+CSTRING ProgAuthor    = "Paul Manias";
+CSTRING ProgDate      = "October 2026";
+CSTRING ProgCopyright = "Paul Manias (c) 2026";
+LONG  ProgDebug = -1;
+FLOAT ProgCoreVersion = 1.0;
+
+extern struct CoreBase *CoreBase;
+static struct DisplayBase *DisplayBase;
+static LONG glFailures = 0;
+
+#define SIZE 256
+
+enum { EXPECT_FULL, EXPECT_NONE, EXPECT_PARTIAL }; // Expected size of the area redrawn by an incremental Draw
+
+struct Tree {
+   objBitmap *Bitmap;
+   objVectorScene *Scene;
+   OBJECTPTR Moving, Removed, Group, Ring;
+};
+
+//****************************************************************************
+
+static OBJECTPTR add_vector(CLASSID ClassID, OBJECTPTR Parent)
+{
+   OBJECTPTR vector;
+   if (NewObject(ClassID, 0, &vector)) return NULL;
+   SetOwner(vector, Parent);
+   return vector;
+}
+
+//****************************************************************************
+// Builds the test scene.  The bitmap is filled with a pattern first, so that a missing clear will be detected.
+
+static bool build_tree(Tree &Tree, LONG Flags)
+{
+   if (CreateObject(ID_BITMAP, 0, &Tree.Bitmap,
+         FID_Width|TLONG,        SIZE,
+         FID_Height|TLONG,       SIZE,
+         FID_BitsPerPixel|TLONG, 32,
+         TAGEND)) return false;
+
+   for (LONG y=0; y < SIZE; y += 8) {
+      gfxDrawRectangle(Tree.Bitmap, 0, y, SIZE, 4, PackPixel(Tree.Bitmap, y, 255 - y, 128), BAF_FILL);
+   }
+
+   if (CreateObject(ID_VECTORSCENE, 0, &Tree.Scene,
+         FID_Bitmap|TPTR,      Tree.Bitmap,
+         FID_PageWidth|TLONG,  SIZE,
+         FID_PageHeight|TLONG, SIZE,
+         FID_Flags|TLONG,      Flags,
+         TAGEND)) return false;
+
+   OBJECTPTR viewport, back, child;
+
+   if (!(viewport = add_vector(ID_VECTORVIEWPORT, &Tree.Scene->Head))) return false;
+   SetFields(viewport, FID_Width|TDOUBLE, (DOUBLE)SIZE, FID_Height|TDOUBLE, (DOUBLE)SIZE, TAGEND);
+   if (acInit(viewport)) return false;
+
+   if (!(back = add_vector(ID_VECTORRECTANGLE, viewport))) return false;
+   SetFields(back, FID_X|TDOUBLE, 8.0, FID_Y|TDOUBLE, 8.0, FID_Width|TDOUBLE, 240.0, FID_Height|TDOUBLE, 240.0,
+      FID_Fill|TSTR, "#283c50", TAGEND);
+   if (acInit(back)) return false;
+
+   if (!(Tree.Moving = add_vector(ID_VECTORRECTANGLE, viewport))) return false;
+   SetFields(Tree.Moving, FID_X|TDOUBLE, 20.5, FID_Y|TDOUBLE, 20.0, FID_Width|TDOUBLE, 60.0, FID_Height|TDOUBLE, 40.0,
+      FID_Fill|TSTR, "#ff0000", FID_Opacity|TDOUBLE, 0.75, TAGEND);
+   if (acInit(Tree.Moving)) return false;
+
+   if (!(Tree.Removed = add_vector(ID_VECTORELLIPSE, viewport))) return false;
+   SetFields(Tree.Removed, FID_CenterX|TDOUBLE, 180.0, FID_CenterY|TDOUBLE, 60.0, FID_RadiusX|TDOUBLE, 30.0,
+      FID_RadiusY|TDOUBLE, 30.0, FID_Fill|TSTR, "#00ff00", FID_Stroke|TSTR, "#ffffff", FID_StrokeWidth|TDOUBLE, 4.0,
+      TAGEND);
+   if (acInit(Tree.Removed)) return false;
+
+   if (!(Tree.Group = add_vector(ID_VECTORGROUP, viewport))) return false;
+   if (acInit(Tree.Group)) return false;
+
+   if (!(child = add_vector(ID_VECTORRECTANGLE, Tree.Group))) return false;
+   SetFields(child, FID_X|TDOUBLE, 100.0, FID_Y|TDOUBLE, 150.0, FID_Width|TDOUBLE, 80.0, FID_Height|TDOUBLE, 60.0,
+      FID_Fill|TSTR, "#0000ff", TAGEND);
+   if (acInit(child)) return false;
+
+   if (!(Tree.Ring = add_vector(ID_VECTORELLIPSE, viewport))) return false;
+   SetFields(Tree.Ring, FID_CenterX|TDOUBLE, 128.0, FID_CenterY|TDOUBLE, 128.0, FID_RadiusX|TDOUBLE, 50.0,
+      FID_RadiusY|TDOUBLE, 50.0, FID_Fill|TSTR, "none", FID_Stroke|TSTR, "#ffff00", FID_StrokeWidth|TDOUBLE, 6.0,
+      TAGEND);
+   if (acInit(Tree.Ring)) return false;
+
+   return true;
+}
+
+//****************************************************************************
+// Applies step Index to the tree.  Returns false when there are no more steps.
+
+static bool apply_step(Tree &Tree, LONG Index, CSTRING *Name)
+{
+   switch(Index) {
+      case 0: *Name = "Fill colour"; SetString(Tree.Moving, FID_Fill, "#ff8000"); break;
+      case 1: *Name = "Move"; SetDouble(Tree.Moving, FID_X, 130.25); break;
+      case 2: *Name = "Hide group"; SetLong(Tree.Group, FID_Visibility, VIS_HIDDEN); break;
+      case 3: *Name = "Show group";
+         SetLong(Tree.Group, FID_Visibility, VIS_VISIBLE);
+         SetDouble(Tree.Group, FID_Opacity, 0.5);
+         break;
+      case 4: *Name = "Free"; acFree(Tree.Removed); break;
+      case 5: *Name = "Restack"; vecPush(Tree.Ring, -2); break;
+      case 6: *Name = "Remove stroke"; SetString(Tree.Ring, FID_Stroke, "none"); break;
+      case 7: *Name = "Add fill"; SetString(Tree.Ring, FID_Fill, "#ff00ff80"); break;
+      case 8: *Name = "Stroke width";
+         SetString(Tree.Ring, FID_Stroke, "#ffffff");
+         SetDouble(Tree.Ring, FID_StrokeWidth, 12.0);
+         break;
+      case 9: *Name = "Opacity"; SetDouble(Tree.Ring, FID_Opacity, 0.0); break;
+      case 10: *Name = "Stroke opacity";
+         SetDouble(Tree.Ring, FID_Opacity, 1.0);
+         SetDouble(Tree.Ring, FID_StrokeOpacity, 0.5);
+         break;
+      default: return false;
+   }
+   return true;
+}
+
+//****************************************************************************
+
+static LONG compare_bitmaps(objBitmap *A, objBitmap *B)
+{
+   LONG mismatches = 0;
+   for (LONG y=0; y < SIZE; y++) {
+      if (memcmp(A->Data + (y * A->LineWidth), B->Data + (y * B->LineWidth), SIZE * A->BytesPerPixel)) mismatches++;
+   }
+   return mismatches;
+}
+
+//****************************************************************************
+
+static void check_draw(Tree &Incremental, Tree &Full, CSTRING Name, LONG Expect)
+{
+   acDraw(Incremental.Scene);
+   acDraw(Full.Scene);
+
+   const LONG damage = Incremental.Scene->DamageWidth * Incremental.Scene->DamageHeight;
+   const LONG mismatches = compare_bitmaps(Incremental.Bitmap, Full.Bitmap);
+
+   print("%-16s damage %dx%d at %d,%d, %d rows differ", Name, Incremental.Scene->DamageWidth,
+      Incremental.Scene->DamageHeight, Incremental.Scene->DamageX, Incremental.Scene->DamageY, mismatches);
+
+   if (mismatches) glFailures++;
+
+   if ((Expect IS EXPECT_FULL) and (damage != SIZE * SIZE)) {
+      print("The entire bitmap should have been redrawn.");
+      glFailures++;
+   }
+   else if ((Expect IS EXPECT_NONE) and (damage)) {
+      print("Nothing should have been redrawn.");
+      glFailures++;
+   }
+   else if ((Expect IS EXPECT_PARTIAL) and ((damage <= 0) or (damage >= SIZE * SIZE))) {
+      print("The damaged area should be smaller than the bitmap.");
+      glFailures++;
+   }
+}
+
+//****************************************************************************
+
+int main(int argc, CSTRING *argv)
+{
+   std::vector<CSTRING> startup(argv, argv + argc);
+   startup.push_back("--gfx-driver=headless");
+
+   const char *msg = init_parasol(startup.size(), startup.data());
+   if (msg) {
+      print(msg);
+      return -1;
+   }
+
+   OBJECTPTR module;
+   if (LoadModule("display", MODVERSION_DISPLAY, &module, &DisplayBase)) {
+      print("Failed to load the display module.");
+      close_parasol();
+      return -1;
+   }
+
+   Tree incremental = {}, full = {};
+   if ((build_tree(incremental, VPF_INCREMENTAL|VPF_CLEAR)) and (build_tree(full, VPF_CLEAR))) {
+      check_draw(incremental, full, "Initial", EXPECT_FULL);
+      check_draw(incremental, full, "Unchanged", EXPECT_NONE);
+
+      CSTRING name;
+      for (LONG step=0; apply_step(incremental, step, &name); step++) {
+         apply_step(full, step, &name);
+         check_draw(incremental, full, name, EXPECT_PARTIAL);
+      }
+   }
+   else {
+      print("Failed to build the test scenes.");
+      glFailures++;
+   }
+
+   for (auto tree : { &incremental, &full }) {
+      if (tree->Scene) acFree(tree->Scene);
+      if (tree->Bitmap) acFree(tree->Bitmap);
+   }
+
+   acFree(module);
+
+   if (glFailures) print("%d failures detected.", glFailures);
+
+   close_parasol();
+   return glFailures ? -1 : 0;
+}
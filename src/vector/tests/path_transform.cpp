@@ -0,0 +1,269 @@
+/*****************************************************************************
+
+The source code of the Parasol project is made publicly available under the
+terms described in the LICENSE.TXT file that is distributed with this package.
+Please refer to it for further information on licensing.
+
+******************************************************************************
+
+This program checks and benchmarks the generation of final paths for a scene of moving and rotating shapes.  Two
+identical VectorScenes are built from curved, stroked and dashed VectorPath objects.  Each frame applies the same new
+transform matrix to the shapes of both scenes.  In the first scene only the transform changes, so gen_vector_path()
+re-applies the transform to the retained flattened paths.  In the second scene the StrokeWidth of every shape is also
+reset to its current value, which forces a full regeneration of the fill and stroke paths.  Both scenes are drawn and
+their bitmaps must be identical on every frame.
+
+The path generation time of each scene is taken from the PathTime field of the VectorScene.
+
+Drawing is performed in memory only, so the display module is opened with the headless driver.
+
+Options: -shapes [n] -frames [n] -seed [n]
+
+*****************************************************************************/
+
+#include <parasol/main.h>
+#include <startup.h>
+#include <parasol/modules/core.h>
+#include <parasol/modules/display.h>
+#include <parasol/modules/vector.h>
+
+#include <math.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+CSTRING ProgName      = "PathTransform";
+CSTRING ProgAuthor    = "Paul Manias";
+CSTRING ProgDate      = "October 2026";
+CSTRING ProgCopyright = "Paul Manias (c) 2026";
+LONG  ProgDebug = -1;
+FLOAT ProgCoreVersion = 1.0;
+
+extern struct CoreBase *CoreBase;
+static LONG glShapes   = 400;
+static LONG glFrames   = 100;
+static ULONG glSeed    = 0x2545f491;
+static LONG glFailures = 0;
+
+#define PAGE_WIDTH  1920
+#define PAGE_HEIGHT 1080
+#define PI 3.14159265358979323846
+
+struct Shape {
+   std::string Sequence, Dashes;
+   DOUBLE X, Y, Angle, Spin, Scale, StrokeWidth;
+};
+
+struct Scene {
+   objBitmap *Bitmap;
+   objVectorScene *Scene;
+   std::vector<OBJECTPTR> Paths;
+   LARGE PathTime, DrawTime;
+};
+
+//****************************************************************************
+
+static ULONG rnd(void)
+{
+   glSeed ^= glSeed << 13;
+   glSeed ^= glSeed >> 17;
+   glSeed ^= glSeed << 5;
+   return glSeed;
+}
+
+static DOUBLE rnd_range(DOUBLE Min, DOUBLE Max)
+{
+   return Min + (Max - Min) * DOUBLE(rnd() & 0xffff) / 65535.0;
+}
+
+//****************************************************************************
+// Each shape is a closed star of cubic curves, which is typical of the paths produced by SVG documents.
+
+static void init_shape(Shape &Shape)
+{
+   const LONG points = 5 + (rnd() % 8);
+   const DOUBLE outer = rnd_range(20, 60), inner = outer * rnd_range(0.3, 0.7);
+
+   char buffer[160];
+   for (LONG i=0; i < points * 2; i++) {
+      const DOUBLE a1 = (PI * i) / points, a2 = (PI * (i + 1)) / points;
+      const DOUBLE r1 = (i & 1) ? inner : outer, r2 = (i & 1) ? outer : inner;
+      if (!i) {
+         snprintf(buffer, sizeof(buffer), "M %f %f ", cos(a1) * r1, sin(a1) * r1);
+         Shape.Sequence += buffer;
+      }
+      snprintf(buffer, sizeof(buffer), "C %f %f %f %f %f %f ", cos(a1 + 0.2) * r1 * 1.2, sin(a1 + 0.2) * r1 * 1.2,
+         cos(a2 - 0.2) * r2 * 1.2, sin(a2 - 0.2) * r2 * 1.2, cos(a2) * r2, sin(a2) * r2);
+      Shape.Sequence += buffer;
+   }
+   Shape.Sequence += "Z";
+
+   Shape.X = rnd_range(0, PAGE_WIDTH);
+   Shape.Y = rnd_range(0, PAGE_HEIGHT);
+   Shape.Angle = rnd_range(0, 360);
+   Shape.Spin  = rnd_range(-4, 4);
+   Shape.Scale = rnd_range(0.5, 2.0);
+   Shape.StrokeWidth = rnd_range(1, 6);
+   if (rnd() & 1) {
+      snprintf(buffer, sizeof(buffer), "%f,%f", rnd_range(4, 12), rnd_range(2, 8));
+      Shape.Dashes = buffer;
+   }
+}
+
+//****************************************************************************
+
+static bool build_scene(Scene &Scene, std::vector<Shape> &Shapes)
+{
+   if (CreateObject(ID_BITMAP, 0, &Scene.Bitmap,
+         FID_Width|TLONG,        PAGE_WIDTH,
+         FID_Height|TLONG,       PAGE_HEIGHT,
+         FID_BitsPerPixel|TLONG, 32,
+         TAGEND)) return false;
+
+   if (CreateObject(ID_VECTORSCENE, 0, &Scene.Scene,
+         FID_Bitmap|TPTR,      Scene.Bitmap,
+         FID_PageWidth|TLONG,  PAGE_WIDTH,
+         FID_PageHeight|TLONG, PAGE_HEIGHT,
+         FID_Flags|TLONG,      VPF_RENDER_TIME|VPF_CLEAR,
+         TAGEND)) return false;
+
+   OBJECTPTR viewport;
+   if (NewObject(ID_VECTORVIEWPORT, 0, &viewport)) return false;
+   SetOwner(viewport, Scene.Scene);
+   SetFields(viewport, FID_Width|TDOUBLE, (DOUBLE)PAGE_WIDTH, FID_Height|TDOUBLE, (DOUBLE)PAGE_HEIGHT, TAGEND);
+   if (acInit(viewport)) return false;
+
+   for (auto &shape : Shapes) {
+      OBJECTPTR path;
+      if (NewObject(ID_VECTORPATH, 0, &path)) return false;
+      SetOwner(path, viewport);
+      SetFields(path,
+         FID_Sequence|TSTR,      shape.Sequence.c_str(),
+         FID_Fill|TSTR,          "#4080c0a0",
+         FID_Stroke|TSTR,        "#ffe020",
+         FID_StrokeWidth|TDOUBLE, shape.StrokeWidth,
+         TAGEND);
+      if (!shape.Dashes.empty()) SetString(path, FID_DashArray, shape.Dashes.c_str());
+      if (acInit(path)) return false;
+      Scene.Paths.push_back(path);
+   }
+
+   Scene.PathTime = 0;
+   Scene.DrawTime = 0;
+   return true;
+}
+
+//****************************************************************************
+// Moves and rotates the shapes as an animation would, without changing their scale.  If Regenerate is true, the
+// StrokeWidth is reset to force a full regeneration of the paths.
+
+static void animate(Scene &Scene, std::vector<Shape> &Shapes, LONG Frame, bool Regenerate)
+{
+   for (size_t i=0; i < Shapes.size(); i++) {
+      auto &shape = Shapes[i];
+      const DOUBLE angle = (shape.Angle + shape.Spin * Frame) * PI / 180.0;
+      const DOUBLE sx = shape.Scale * cos(angle), sy = shape.Scale * sin(angle);
+      vecApplyMatrix(Scene.Paths[i], sx, sy, -sy, sx, shape.X + 3.0 * Frame, shape.Y + 2.0 * Frame);
+      if (Regenerate) SetDouble(Scene.Paths[i], FID_StrokeWidth, shape.StrokeWidth);
+   }
+
+   acDraw(Scene.Scene);
+   Scene.PathTime += Scene.Scene->PathTime;
+   Scene.DrawTime += Scene.Scene->RenderTime;
+}
+
+//****************************************************************************
+
+static LONG compare_bitmaps(objBitmap *A, objBitmap *B)
+{
+   LONG mismatches = 0;
+   for (LONG y=0; y < A->Height; y++) {
+      if (memcmp(A->Data + (y * A->LineWidth), B->Data + (y * B->LineWidth), A->Width * A->BytesPerPixel)) mismatches++;
+   }
+   return mismatches;
+}
+
+//****************************************************************************
+
+int main(int argc, CSTRING *argv)
+{
+   std::vector<CSTRING> startup(argv, argv + argc);
+   startup.push_back("--gfx-driver=headless");
+
+   const char *msg = init_parasol(startup.size(), startup.data());
+   if (msg) {
+      print(msg);
+      return -1;
+   }
+
+   CSTRING *args;
+   if ((!GetPointer(CurrentTask(), FID_Parameters, &args)) and (args)) {
+      for (LONG i=0; args[i]; i++) {
+         if (!StrMatch(args[i], "-shapes")) {
+            if (args[++i]) glShapes = StrToInt(args[i]);
+            else break;
+         }
+         else if (!StrMatch(args[i], "-frames")) {
+            if (args[++i]) glFrames = StrToInt(args[i]);
+            else break;
+         }
+         else if (!StrMatch(args[i], "-seed")) {
+            if (args[++i]) glSeed = StrToInt(args[i]);
+            else break;
+         }
+      }
+   }
+
+   if (glShapes < 1) glShapes = 1;
+   if (glFrames < 1) glFrames = 1;
+   if (!glSeed) glSeed = 1;
+
+   OBJECTPTR module;
+   if (LoadModule("display", MODVERSION_DISPLAY, &module, NULL)) {
+      print("Failed to load the display module.");
+      close_parasol();
+      return -1;
+   }
+
+   std::vector<Shape> shapes(glShapes);
+   for (auto &shape : shapes) init_shape(shape);
+
+   Scene reuse = {}, full = {};
+   if ((build_scene(reuse, shapes)) and (build_scene(full, shapes))) {
+      LONG mismatched_frames = 0;
+      for (LONG frame=0; frame < glFrames; frame++) {
+         animate(reuse, shapes, frame, false);
+         animate(full, shapes, frame, true);
+
+         if (LONG rows = compare_bitmaps(reuse.Bitmap, full.Bitmap)) {
+            if (!mismatched_frames) print("Frame %d: %d rows differ", frame, rows);
+            mismatched_frames++;
+         }
+      }
+
+      print("%d shapes, %d frames, %d mismatched frames", glShapes, glFrames, mismatched_frames);
+      print("Regenerated:    path %8.3f ms/frame, draw %8.3f ms/frame", DOUBLE(full.PathTime) / glFrames / 1000.0,
+         DOUBLE(full.DrawTime) / glFrames / 1000.0);
+      print("Transform only: path %8.3f ms/frame, draw %8.3f ms/frame (path %.2fx)",
+         DOUBLE(reuse.PathTime) / glFrames / 1000.0, DOUBLE(reuse.DrawTime) / glFrames / 1000.0,
+         DOUBLE(full.PathTime) / DOUBLE(reuse.PathTime > 0 ? reuse.PathTime : 1));
+
+      if (mismatched_frames) glFailures++;
+   }
+   else {
+      print("Failed to build the test scenes.");
+      glFailures++;
+   }
+
+   for (auto scene : { &reuse, &full }) {
+      if (scene->Scene) acFree(scene->Scene);
+      if (scene->Bitmap) acFree(scene->Bitmap);
+   }
+
+   acFree(module);
+
+   if (glFailures) print("%d failures detected.", glFailures);
+
+   close_parasol();
+   return glFailures ? -1 : 0;
+}
@@ -0,0 +1,253 @@
+/*****************************************************************************
+
+The source code of the Parasol project is made publicly available under the
+terms described in the LICENSE.TXT file that is distributed with this package.
+Please refer to it for further information on licensing.
+
+******************************************************************************
+
+This program checks the SIMD span kernels of pixfmt_rkl against the generic 32-bit routines.  Random spans are blended
+into random BGRA and RGBA rows with each instruction set that the CPU supports, and every resulting row must be
+bit-identical to the output of the scalar code.  The throughput of each kernel is then reported in Mpixels/s.
+
+Options: -iterations [n] -pixels [n] -seed [n]
+
+*****************************************************************************/
+
+#include <parasol/main.h>
+#include <startup.h>
+#include <parasol/modules/core.h>
+#include <parasol/modules/display.h>
+
+#include "agg_basics.h"
+#include "agg_color_rgba.h"
+#include "agg_gamma_lut.h"
+#include "agg_image_accessors.h"
+#include "agg_rendering_buffer.h"
+
+#include <string.h>
+
+#include "../scene/scene_pixels.cpp"
+
+CSTRING ProgName      = "SpanBlending";
+CSTRING ProgAuthor    = "Paul Manias";
+CSTRING ProgDate      = "October 2026";
+CSTRING ProgCopyright = "Paul Manias (c) 2026";
+LONG  ProgDebug = -1;
+FLOAT ProgCoreVersion = 1.0;
+
+extern struct CoreBase *CoreBase;
+static LONG glIterations = 200000;
+static LONG glPixels     = 1024;
+static ULONG glSeed      = 0x2545f491;
+static LONG glFailures   = 0;
+
+enum { OP_HLINE=0, OP_SOLID, OP_COLOUR_COVERS, OP_COLOUR_COPY, OP_COLOUR_COVER, OP_END };
+
+static const CSTRING glOpNames[OP_END] = { "blend_hline", "blend_solid_hspan", "blend_color_hspan",
+   "copy_color_hspan", "cover_color_hspan" };
+
+#define ROW_WIDTH 96
+
+//****************************************************************************
+
+static ULONG rnd(void)
+{
+   glSeed ^= glSeed << 13;
+   glSeed ^= glSeed >> 17;
+   glSeed ^= glSeed << 5;
+   return glSeed;
+}
+
+// Favour the values that select special cases in the blending code.
+
+static UBYTE rnd_byte(void)
+{
+   switch (rnd() % 4) {
+      case 0:  return 0;
+      case 1:  return 255;
+      default: return rnd();
+   }
+}
+
+//****************************************************************************
+
+static void init_bitmap(objBitmap &Bitmap, ColourFormat &Format, UBYTE *Data, LONG Width, bool BGRA)
+{
+   ClearMemory(&Format, sizeof(Format));
+   Format.RedPos   = BGRA ? 16 : 0;
+   Format.GreenPos = 8;
+   Format.BluePos  = BGRA ? 0 : 16;
+   Format.AlphaPos = 24;
+   Format.RedMask = Format.GreenMask = Format.BlueMask = Format.AlphaMask = 0xff;
+   Format.BitsPerPixel = 32;
+
+   ClearMemory(&Bitmap, sizeof(Bitmap));
+   Bitmap.Data          = Data;
+   Bitmap.Width         = Width;
+   Bitmap.Height        = 1;
+   Bitmap.LineWidth     = Width * 4;
+   Bitmap.BytesPerPixel = 4;
+   Bitmap.BitsPerPixel  = 32;
+   Bitmap.ColourFormat  = &Format;
+   Bitmap.Clip.Right    = Width;
+   Bitmap.Clip.Bottom   = 1;
+}
+
+static void run_op(agg::pixfmt_rkl &Pixels, LONG Op, LONG X, LONG Length, const agg::rgba8 &Colour,
+   const agg::rgba8 *Colours, const UBYTE *Covers, UBYTE Cover)
+{
+   switch (Op) {
+      case OP_HLINE:         Pixels.blend_hline(X, 0, Length, Colour, Cover); break;
+      case OP_SOLID:         Pixels.blend_solid_hspan(X, 0, Length, Colour, Covers); break;
+      case OP_COLOUR_COVERS: Pixels.blend_color_hspan(X, 0, Length, Colours, Covers, 255); break;
+      case OP_COLOUR_COPY:   Pixels.blend_color_hspan(X, 0, Length, Colours, NULL, 255); break;
+      case OP_COLOUR_COVER:  Pixels.blend_color_hspan(X, 0, Length, Colours, NULL, Cover); break;
+   }
+}
+
+//****************************************************************************
+// Every kernel is compared to the scalar routines over the entire row, so writes beyond the span are detected too.
+
+static void test_kernels(LONG ISA, LONG Detected, bool BGRA)
+{
+   UBYTE expected[ROW_WIDTH * 4], result[ROW_WIDTH * 4], covers[ROW_WIDTH];
+   agg::rgba8 colours[ROW_WIDTH];
+   objBitmap expect_bmp, result_bmp;
+   ColourFormat expect_fmt, result_fmt;
+   init_bitmap(expect_bmp, expect_fmt, expected, ROW_WIDTH, BGRA);
+   init_bitmap(result_bmp, result_fmt, result, ROW_WIDTH, BGRA);
+
+   glSpanISA = SPAN_SCALAR;
+   agg::pixfmt_rkl scalar(expect_bmp);
+   glSpanISA = ISA;
+   agg::pixfmt_rkl simd(result_bmp);
+   glSpanISA = Detected;
+
+   if (!simd.mSpans) {
+      print("%s kernels are not available.", glSpanISANames[ISA]);
+      glFailures++;
+      return;
+   }
+
+   LONG mismatches = 0;
+   for (LONG i=0; i < glIterations; i++) {
+      const LONG op     = rnd() % OP_END;
+      const LONG x      = rnd() % 8;
+      const LONG length = 1 + (rnd() % (ROW_WIDTH - 8));
+
+      for (LONG p=0; p < ROW_WIDTH * 4; p++) expected[p] = (p & 3) IS 3 ? rnd_byte() : rnd();
+      for (LONG p=0; p < ROW_WIDTH; p++) {
+         colours[p] = agg::rgba8(rnd(), rnd(), rnd(), rnd_byte());
+         covers[p] = rnd_byte();
+      }
+      CopyMemory(expected, result, sizeof(result));
+
+      const agg::rgba8 colour(rnd(), rnd(), rnd(), rnd_byte());
+      const UBYTE cover = rnd_byte();
+
+      run_op(scalar, op, x, length, colour, colours, covers, cover);
+      run_op(simd, op, x, length, colour, colours, covers, cover);
+
+      if (memcmp(expected, result, sizeof(result))) {
+         if (!mismatches) {
+            for (LONG p=0; p < ROW_WIDTH; p++) {
+               if (((ULONG *)expected)[p] != ((ULONG *)result)[p]) {
+                  print("%s %s %s: pixel %d is $%.8x, expected $%.8x (x: %d, length: %d)", glSpanISANames[ISA],
+                     BGRA ? "BGRA" : "RGBA", glOpNames[op], p, ((ULONG *)result)[p], ((ULONG *)expected)[p], x, length);
+                  break;
+               }
+            }
+         }
+         mismatches++;
+      }
+   }
+
+   print("%-6s %s: %d spans, %d mismatches", glSpanISANames[ISA], BGRA ? "BGRA" : "RGBA", glIterations, mismatches);
+   if (mismatches) glFailures++;
+}
+
+//****************************************************************************
+
+static void benchmark(LONG ISA, LONG Detected)
+{
+   auto data    = new UBYTE[glPixels * 4];
+   auto covers  = new UBYTE[glPixels];
+   auto colours = new agg::rgba8[glPixels];
+   objBitmap bmp;
+   ColourFormat fmt;
+   init_bitmap(bmp, fmt, data, glPixels, true);
+
+   for (LONG p=0; p < glPixels; p++) {
+      colours[p] = agg::rgba8(rnd(), rnd(), rnd(), rnd());
+      covers[p] = rnd();
+   }
+
+   glSpanISA = ISA;
+   agg::pixfmt_rkl pixels(bmp);
+   glSpanISA = Detected;
+
+   const agg::rgba8 colour(0x40, 0x80, 0xc0, 0xc0);
+   const LONG repeat = (64 * 1024 * 1024) / glPixels;
+   for (LONG op=0; op < OP_END; op++) {
+      for (LONG p=0; p < glPixels * 4; p++) data[p] = (p & 3) IS 3 ? 0xff : p;
+
+      LARGE start = PreciseTime();
+      for (LONG r=0; r < repeat; r++) run_op(pixels, op, 0, glPixels, colour, colours, covers, 0x80);
+      LARGE elapsed = PreciseTime() - start;
+
+      print("%-6s %-18s %8.1f Mpixels/s", glSpanISANames[ISA], glOpNames[op],
+         DOUBLE(repeat) * DOUBLE(glPixels) / DOUBLE(elapsed ? elapsed : 1));
+   }
+
+   delete[] colours;
+   delete[] covers;
+   delete[] data;
+}
+
+//****************************************************************************
+
+int main(int argc, CSTRING *argv)
+{
+   const char *msg = init_parasol(argc, argv);
+   if (msg) {
+      print(msg);
+      return -1;
+   }
+
+   CSTRING *args;
+   if ((!GetPointer(CurrentTask(), FID_Parameters, &args)) and (args)) {
+      for (LONG i=0; args[i]; i++) {
+         if (!StrMatch(args[i], "-iterations")) {
+            if (args[++i]) glIterations = StrToInt(args[i]);
+            else break;
+         }
+         else if (!StrMatch(args[i], "-pixels")) {
+            if (args[++i]) glPixels = StrToInt(args[i]);
+            else break;
+         }
+         else if (!StrMatch(args[i], "-seed")) {
+            if (args[++i]) glSeed = StrToInt(args[i]);
+            else break;
+         }
+      }
+   }
+
+   if (glPixels < 1) glPixels = 1;
+   if (!glSeed) glSeed = 1;
+
+   const LONG detected = glSpanISA;
+   print("Detected instruction set: %s", glSpanISANames[detected]);
+
+   for (LONG isa=SPAN_SCALAR+1; isa <= detected; isa++) {
+      test_kernels(isa, detected, true);
+      test_kernels(isa, detected, false);
+   }
+
+   for (LONG isa=SPAN_SCALAR; isa <= detected; isa++) benchmark(isa, detected);
+
+   if (glFailures) print("%d failures detected.", glFailures);
+
+   close_parasol();
+   return glFailures ? -1 : 0;
+}
@@ -0,0 +1,321 @@
+/*****************************************************************************
+
+The source code of the Parasol project is made publicly available under the
+terms described in the LICENSE.TXT file that is distributed with this package.
+Please refer to it for further information on licensing.
+
+******************************************************************************
+
+This program benchmarks the rendering of a corpus of SVG files without a display.  Each file is loaded through the SVG
+class and drawn to an offscreen Bitmap at several resolutions.  Every iteration parses the file afresh and draws it
+twice: the first draw generates all paths from scratch and the second is a redraw of the unmodified scene.
+
+The first draw is broken down into path generation, rasterisation and filter processing with the RENDER_TIME
+timing fields of the VectorScene.  A checksum of the rendered pixels is computed for every iteration and must be
+identical across iterations.
+
+The results are output as JSON so that they can be compared between releases.  The default corpus is the svg folder
+that accompanies this program.
+
+Options: -corpus [folder] -iterations [n] -resolution [WxH] -output [file] -parallel
+
+The -resolution option can be repeated.  If it is not used, each file is drawn at 400x300, 1024x768 and 1920x1080.
+
+Drawing is performed in memory only, so the display module is opened with the headless driver and no X server is
+needed.  Pass --gfx-driver to override this.  The number of threads used by -parallel can be set with --threads=[n].
+
+*****************************************************************************/
+
+#include <parasol/main.h>
+#include <startup.h>
+#include <parasol/modules/core.h>
+#include <parasol/modules/display.h>
+#include <parasol/modules/vector.h>
+#include <parasol/modules/svg.h>
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#ifndef SVG_CORPUS
+#define SVG_CORPUS "svg/"
+#endif
+
+CSTRING ProgName      = "SVGBenchmark";
+CSTRING ProgAuthor    = "Paul Manias";
+CSTRING ProgDate      = "October 2026";
+CSTRING ProgCopyright = "Paul Manias (c) 2026";
+LONG  ProgDebug = -1;
+FLOAT ProgCoreVersion = 1.0;
+
+extern struct CoreBase *CoreBase;
+static std::string glCorpus = SVG_CORPUS;
+static CSTRING glOutput   = NULL;
+static LONG glIterations  = 10;
+static LONG glFailures    = 0;
+static bool glParallel    = false;
+
+struct Resolution {
+   LONG Width, Height;
+};
+
+struct Result {
+   std::string File;
+   Resolution Size;
+   ERROR Error;
+   LARGE Parse, Path, Raster, Filter, Draw, Redraw; // Totals, in microseconds
+   LARGE MinDraw;
+   ULONG Checksum;
+   bool Stable;
+};
+
+//****************************************************************************
+// Computes a checksum of the visible pixels of a bitmap.
+
+static ULONG bitmap_checksum(objBitmap *Bitmap)
+{
+   ULONG hash = 2166136261;
+   for (LONG y=0; y < Bitmap->Height; y++) {
+      const UBYTE *row = Bitmap->Data + (y * Bitmap->LineWidth);
+      for (LONG x=0; x < Bitmap->Width * Bitmap->BytesPerPixel; x++) hash = (hash ^ row[x]) * 16777619;
+   }
+   return hash;
+}
+
+//****************************************************************************
+// Returns the SVG files of the corpus in alphabetical order.
+
+static std::vector<std::string> read_corpus(void)
+{
+   std::vector<std::string> files;
+   DirInfo *dir;
+   if (!OpenDir(glCorpus.c_str(), RDF_FILE, &dir)) {
+      while (!ScanDir(dir)) {
+         std::string name(dir->Info->Name);
+         if ((name.size() > 4) and (!StrCompare(".svg", name.c_str() + name.size() - 4, 0, 0))) {
+            files.push_back(name);
+         }
+      }
+      FreeResource(dir);
+   }
+   std::sort(files.begin(), files.end());
+   return files;
+}
+
+//****************************************************************************
+// Loads and draws a single file for the configured number of iterations.
+
+static void bench_file(const std::string &File, Resolution Size, objBitmap *Bitmap, Result &Result)
+{
+   const std::string path = glCorpus + File;
+
+   Result = { File, Size, ERR_Okay, 0, 0, 0, 0, 0, 0, 0x7fffffffffffffffLL, 0, true };
+
+   for (LONG i=0; i < glIterations; i++) {
+      LARGE start = PreciseTime();
+
+      objSVG *svg;
+      if ((Result.Error = CreateObject(ID_SVG, 0, &svg, FID_Path|TSTR, path.c_str(), TAGEND))) return;
+
+      Result.Parse += PreciseTime() - start;
+
+      objVectorScene *scene;
+      if ((GetPointer(svg, FID_Scene, &scene)) or (!scene)) {
+         acFree(svg);
+         Result.Error = ERR_GetField;
+         return;
+      }
+
+      scene->Flags |= VPF_RENDER_TIME;
+      if (glParallel) scene->Flags |= VPF_PARALLEL;
+
+      // The first draw generates every path in the scene.
+
+      ClearMemory(Bitmap->Data, Bitmap->LineWidth * Bitmap->Height);
+      if ((Result.Error = svgRender(svg, Bitmap, 0, 0, Size.Width, Size.Height))) {
+         acFree(svg);
+         return;
+      }
+
+      const LARGE raster = scene->RenderTime - scene->PathTime - scene->FilterTime;
+      Result.Path   += scene->PathTime;
+      Result.Filter += scene->FilterTime;
+      Result.Raster += (raster > 0) ? raster : 0;
+      Result.Draw   += scene->RenderTime;
+      if (scene->RenderTime < Result.MinDraw) Result.MinDraw = scene->RenderTime;
+
+      const ULONG checksum = bitmap_checksum(Bitmap);
+      if (!i) Result.Checksum = checksum;
+      else if (checksum != Result.Checksum) Result.Stable = false;
+
+      // The redraw of an unmodified scene reuses the generated paths.
+
+      ClearMemory(Bitmap->Data, Bitmap->LineWidth * Bitmap->Height);
+      svgRender(svg, Bitmap, 0, 0, Size.Width, Size.Height);
+      Result.Redraw += scene->RenderTime;
+
+      acFree(svg);
+   }
+}
+
+//****************************************************************************
+
+static void append(std::string &Output, CSTRING Format, ...)
+{
+   char buffer[512];
+   va_list list;
+   va_start(list, Format);
+   vsnprintf(buffer, sizeof(buffer), Format, list);
+   va_end(list);
+   Output += buffer;
+}
+
+static std::string to_json(const std::vector<Result> &Results)
+{
+   std::string out;
+   append(out, "{\n  \"benchmark\": \"%s\",\n  \"iterations\": %d,\n  \"parallel\": %s,\n  \"results\": [\n",
+      ProgName, glIterations, glParallel ? "true" : "false");
+
+   for (size_t i=0; i < Results.size(); i++) {
+      auto &r = Results[i];
+      append(out, "    { \"file\": \"%s\", \"width\": %d, \"height\": %d, ", r.File.c_str(), r.Size.Width, r.Size.Height);
+      if (r.Error) append(out, "\"error\": \"%s\" }", GetErrorMsg(r.Error));
+      else {
+         const LARGE n = glIterations;
+         append(out, "\"parse_us\": " PF64() ", \"path_us\": " PF64() ", \"raster_us\": " PF64() ", \"filter_us\": " PF64() ", ",
+            r.Parse / n, r.Path / n, r.Raster / n, r.Filter / n);
+         append(out, "\"draw_us\": " PF64() ", \"min_draw_us\": " PF64() ", \"redraw_us\": " PF64() ", ",
+            r.Draw / n, r.MinDraw, r.Redraw / n);
+         append(out, "\"checksum\": \"%.8x\", \"stable\": %s }", r.Checksum, r.Stable ? "true" : "false");
+      }
+      out += (i + 1 < Results.size()) ? ",\n" : "\n";
+   }
+
+   out += "  ]\n}\n";
+   return out;
+}
+
+//****************************************************************************
+
+int main(int argc, CSTRING *argv)
+{
+   // Bitmaps are only drawn in memory, so the headless display driver is used unless the user names another.
+
+   std::vector<CSTRING> startup(argv, argv + argc);
+   if (std::none_of(startup.begin(), startup.end(), [](CSTRING Arg) { return !strncmp(Arg, "--gfx-driver=", 13); })) {
+      startup.push_back("--gfx-driver=headless");
+   }
+
+   const char *msg = init_parasol(startup.size(), startup.data());
+   if (msg) {
+      print(msg);
+      return -1;
+   }
+
+   OBJECTPTR module;
+   if (LoadModule("display", MODVERSION_DISPLAY, &module, NULL)) {
+      print("Failed to load the display module.");
+      close_parasol();
+      return -1;
+   }
+
+   std::vector<Resolution> sizes;
+
+   CSTRING *args;
+   if ((!GetPointer(CurrentTask(), FID_Parameters, &args)) and (args)) {
+      for (LONG i=0; args[i]; i++) {
+         if (!StrMatch(args[i], "-corpus")) {
+            if (args[++i]) glCorpus = args[i];
+            else break;
+         }
+         else if (!StrMatch(args[i], "-iterations")) {
+            if (args[++i]) glIterations = StrToInt(args[i]);
+            else break;
+         }
+         else if (!StrMatch(args[i], "-resolution")) {
+            if (args[++i]) {
+               Resolution size = { 0, 0 };
+               if ((sscanf(args[i], "%dx%d", &size.Width, &size.Height) IS 2) and (size.Width > 0) and (size.Height > 0)) {
+                  sizes.push_back(size);
+               }
+               else print("Invalid resolution '%s'", args[i]);
+            }
+            else break;
+         }
+         else if (!StrMatch(args[i], "-output")) {
+            if (args[++i]) glOutput = args[i];
+            else break;
+         }
+         else if (!StrMatch(args[i], "-parallel")) glParallel = true;
+      }
+   }
+
+   if (glIterations < 1) glIterations = 1;
+   if (sizes.empty()) sizes = { { 400, 300 }, { 1024, 768 }, { 1920, 1080 } };
+   if ((!glCorpus.empty()) and (glCorpus.back() != '/') and (glCorpus.back() != ':')) glCorpus += '/';
+
+   auto files = read_corpus();
+   if (files.empty()) {
+      print("No SVG files found in '%s'", glCorpus.c_str());
+      acFree(module);
+      close_parasol();
+      return -1;
+   }
+
+   std::vector<Result> results;
+   for (auto &size : sizes) {
+      objBitmap *bitmap;
+      if (CreateObject(ID_BITMAP, 0, &bitmap,
+            FID_Width|TLONG,        size.Width,
+            FID_Height|TLONG,       size.Height,
+            FID_BitsPerPixel|TLONG, 32,
+            FID_Flags|TLONG,        BMF_ALPHA_CHANNEL,
+            TAGEND)) {
+         print("Failed to create a %dx%d bitmap.", size.Width, size.Height);
+         glFailures++;
+         continue;
+      }
+
+      for (auto &file : files) {
+         Result result;
+         bench_file(file, size, bitmap, result);
+         if ((result.Error) or (!result.Stable)) glFailures++;
+         results.push_back(result);
+      }
+
+      acFree(bitmap);
+   }
+
+   auto json = to_json(results);
+
+   if (glOutput) {
+      OBJECTPTR file;
+      if (!CreateObject(ID_FILE, 0, &file,
+            FID_Path|TSTR,   glOutput,
+            FID_Flags|TLONG, FL_NEW|FL_WRITE,
+            TAGEND)) {
+         acWrite(file, json.c_str(), json.size(), NULL);
+         acFree(file);
+      }
+      else {
+         print("Failed to write '%s'", glOutput);
+         glFailures++;
+      }
+
+      for (auto &r : results) {
+         if (r.Error) print("%-20s %4dx%-4d  %s", r.File.c_str(), r.Size.Width, r.Size.Height, GetErrorMsg(r.Error));
+         else print("%-20s %4dx%-4d  draw %8.3f ms  redraw %8.3f ms%s", r.File.c_str(), r.Size.Width, r.Size.Height,
+            DOUBLE(r.Draw) / glIterations / 1000.0, DOUBLE(r.Redraw) / glIterations / 1000.0, r.Stable ? "" : "  UNSTABLE");
+      }
+   }
+   else print("%s", json.c_str());
+
+   if (glFailures) print("%d failures detected.", glFailures);
+
+   acFree(module);
+   close_parasol();
+   return glFailures ? -1 : 0;
+}
@@ -74,6 +74,7 @@ static FIELD FID_FreetypeFace;
 template <class T> static void mark_dirty(T *Vector, UBYTE Flags)
 {
    Vector->Dirty |= Flags;
+   invalidate_bounds((objVector *)Vector);
    for (objVector *scan=(objVector *)Vector->Child; scan; scan=(objVector *)scan->Next) {
       if ((scan->Dirty & Flags) == Flags) continue;
       mark_dirty(scan, Flags);
@@ -99,6 +100,96 @@ template <class T> static void reset_final_path(T *Vector)
    mark_dirty(Vector, RC_FINAL_PATH);
 }
 
+//****************************************************************************
+// Return true if the vector has a fill or stroke to draw.  Path generation only creates rasterizers for the paint that
+// is in use.
+
+static bool has_fill(objVector *Vector)
+{
+   return (Vector->FillColour.Alpha > 0) or (Vector->FillGradient) or (Vector->FillImage) or (Vector->FillPattern);
+}
+
+static bool has_stroke(objVector *Vector)
+{
+   return (Vector->StrokeWidth > 0) and
+      ((Vector->StrokePattern) or (Vector->StrokeGradient) or (Vector->StrokeImage) or
+       (Vector->StrokeColour.Alpha * Vector->StrokeOpacity * Vector->Opacity > 0.001));
+}
+
+//****************************************************************************
+// Call reset_paint() when the paint, opacity or visibility of a vector has changed but its shape has not.  The vector
+// is flagged so that incremental drawing will redraw its area.  The path is only regenerated if the change adds or
+// removes a fill or stroke.
+
+template <class T> static void reset_paint(T *Vector)
+{
+   auto vector = (objVector *)Vector;
+   if ((vector->GeneratePath) and
+       ((has_fill(vector) != (vector->FillRaster != NULL)) or (has_stroke(vector) != (vector->StrokeRaster != NULL)))) {
+      reset_final_path(Vector);
+   }
+   else vector->PaintDirty = TRUE;
+}
+
+//****************************************************************************
+// Adds an area of the scene's Bitmap to the list of areas that the next incremental Draw will redraw.  Coordinates
+// are rounded outwards and the right and bottom edges are exclusive.  An area that overlaps an existing entry is
+// merged with it.  If the list is full, the area is merged with the entry that grows the least as a result.
+
+static void add_damage(objVectorScene *Scene, DOUBLE X1, DOUBLE Y1, DOUBLE X2, DOUBLE Y2)
+{
+   if ((X1 >= X2) or (Y1 >= Y2)) return;
+
+   const DOUBLE LIMIT = 0x3fffffff; // Filtered vectors have unlimited bounds
+   const LONG x1 = (X1 < -LIMIT) ? -LIMIT : LONG(floor(X1));
+   const LONG y1 = (Y1 < -LIMIT) ? -LIMIT : LONG(floor(Y1));
+   const LONG x2 = (X2 > LIMIT) ? LIMIT : LONG(ceil(X2));
+   const LONG y2 = (Y2 > LIMIT) ? LIMIT : LONG(ceil(Y2));
+
+   LONG merge = -1;
+   DOUBLE least = DBL_MAX;
+   for (LONG i=0; i < Scene->TotalDamage; i++) {
+      auto &area = Scene->Damage[i];
+      if ((x1 < area.Right) and (x2 > area.Left) and (y1 < area.Bottom) and (y2 > area.Top)) {
+         merge = i;
+         least = 0;
+         break;
+      }
+
+      const DOUBLE growth = DOUBLE(std::max(x2, area.Right) - std::min(x1, area.Left)) *
+         DOUBLE(std::max(y2, area.Bottom) - std::min(y1, area.Top)) -
+         (DOUBLE(area.Right - area.Left) * DOUBLE(area.Bottom - area.Top));
+      if (growth < least) { least = growth; merge = i; }
+   }
+
+   if ((merge < 0) or ((least > 0) and (Scene->TotalDamage < ARRAYSIZE(Scene->Damage)))) {
+      auto &area = Scene->Damage[Scene->TotalDamage++];
+      area.Left   = x1;
+      area.Top    = y1;
+      area.Right  = x2;
+      area.Bottom = y2;
+   }
+   else {
+      auto &area = Scene->Damage[merge];
+      if (x1 < area.Left)   area.Left   = x1;
+      if (y1 < area.Top)    area.Top    = y1;
+      if (x2 > area.Right)  area.Right  = x2;
+      if (y2 > area.Bottom) area.Bottom = y2;
+   }
+}
+
+//****************************************************************************
+// Records the area that a vector and its children occupied when the scene was last drawn, for use when the vector is
+// removed from the tree or restacked.
+
+static void damage_vector(objVector *Vector)
+{
+   auto scene = Vector->Scene;
+   if ((!scene) or (!scene->LastBitmap)) return;
+   if ((scene->Flags & (VPF_INCREMENTAL|VPF_CLEAR)) != (VPF_INCREMENTAL|VPF_CLEAR)) return;
+   add_damage(scene, Vector->TBX1, Vector->TBY1, Vector->TBX2, Vector->TBY2);
+}
+
 //****************************************************************************
 
 static CSTRING get_name(OBJECTPTR) __attribute__ ((unused));
@@ -272,6 +363,22 @@ INLINE OBJECTPTR get_parent(objVector *Vector)
    return NULL;
 }
 
+//****************************************************************************
+// Discards the cached tree boundary of the vector and all vectors that contain it.  This is required whenever the path
+// of a vector changes, or when the vector is added to or removed from the tree.  A vector's boundary can only be valid
+// if the boundaries of its descendants are valid, so the search stops at the first parent that is already invalid.
+
+static void invalidate_bounds(objVector *Vector)
+{
+   Vector->ValidBounds = FALSE;
+   for (auto scan=get_parent(Vector); scan; scan=get_parent((objVector *)scan)) {
+      if (scan->ClassID != ID_VECTOR) break;
+      auto parent = (objVector *)scan;
+      if (!parent->ValidBounds) break;
+      parent->ValidBounds = FALSE;
+   }
+}
+
 //****************************************************************************
 // Creates a VectorTransform entry and attaches it to the target vector.
 
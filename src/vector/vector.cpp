@@ -67,8 +67,12 @@ Please refer to it for further information on licensing.
 #include <ft2build.h>
 #include <freetype/freetype.h>
 
+#include <algorithm>
 #include <array>
+#include <list>
 #include <memory>
+#include <unordered_map>
+#include <vector>
 
 #include "vectors/vector.h"
 #include "idl.h"
@@ -90,6 +94,12 @@ static OBJECTPTR clVectorSpiral = NULL, clVectorShape = NULL, clVectorTransition
 static OBJECTPTR modDisplay = NULL;
 static OBJECTPTR modFont = NULL;
 
+static LARGE glFilterCacheLimit = 64 * 1024 * 1024; // Maximum bitmap memory that filters may hold for cached results
+static LARGE glFilterCacheUsage = 0;
+static LARGE glGlyphCacheLimit = 8 * 1024 * 1024; // Maximum memory for the outlines held by the glyph cache
+static LARGE glGlyphCacheUsage = 0;
+static LARGE glGlyphCacheHits = 0, glGlyphCacheMisses = 0;
+
 #define DEG2RAD 0.0174532925 // Multiple any angle by this value to convert to radians
 
 #include "colours.cpp"
@@ -123,6 +133,7 @@ static void get_wave_xy(struct rkVectorWave *);
 
 static VectorTransform * add_transform(objVector *, LONG Type, LONG Create);
 static void apply_parent_transforms(objVector *, objVector *, agg::trans_affine &, WORD *);
+static void invalidate_bounds(objVector *);
 static void apply_transforms(VectorTransform *, DOUBLE, DOUBLE, agg::trans_affine &, WORD *);
 static void convert_to_aggpath(PathCommand *Paths, LONG TotalPoints, agg::path_storage *BasePath);
 static void gen_vector_path(objVector *);
@@ -132,6 +143,9 @@ static CSTRING read_numseq(CSTRING Value, ...);
 static ERROR read_path(PathCommand **, LONG *, CSTRING);
 static void apply_transition(objVectorTransition *, DOUBLE, agg::trans_affine &);
 static void apply_transition_xy(objVectorTransition *, DOUBLE, DOUBLE *X, DOUBLE *Y);
+static void set_filter_pool(objVectorFilter *, class ScratchPool *);
+static void trim_glyph_cache(void);
+static void clear_glyph_cache(void);
 
 FT_Error (*EFT_Set_Pixel_Sizes)(FT_Face, FT_UInt pixel_width, FT_UInt pixel_height );
 FT_Error (*EFT_Set_Char_Size)(FT_Face, FT_F26Dot6 char_width, FT_F26Dot6 char_height, FT_UInt horz_resolution, FT_UInt vert_resolution );
@@ -186,6 +200,8 @@ static ERROR CMDInit(OBJECTPTR argModule, struct CoreBase *argCoreBase)
 
 ERROR CMDExpunge(void)
 {
+   clear_glyph_cache(); // Must precede the release of the Font module, which owns the faces
+
    if (modDisplay)    { acFree(modDisplay); modDisplay = NULL; }
    if (modFont)       { acFree(modFont); modFont = NULL; }
 
@@ -217,6 +233,7 @@ ERROR CMDExpunge(void)
 #include "paths.cpp"
 #include "scene/scene_pixels.cpp"
 #include "vector_functions.cpp"
+#include "scene/scene_scratch.cpp"
 #include "scene/scene_draw.cpp"
 #include "scene/scene.cpp"
 
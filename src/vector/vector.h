@@ -3,6 +3,7 @@
    DOUBLE FinalX, FinalY; \
    DOUBLE FillGradientAlpha, StrokeGradientAlpha; \
    DOUBLE BX1, BY1, BX2, BY2; \
+   DOUBLE TBX1, TBY1, TBX2, TBY2; \
    objVectorFilter *Filter; \
    struct rkVectorViewport *ParentView; \
    STRING ID; \
@@ -11,6 +12,9 @@
    agg::rasterizer_scanline_aa<> *StrokeRaster; \
    agg::rasterizer_scanline_aa<> *FillRaster; \
    agg::trans_affine *Transform; \
+   agg::path_storage *FlatFill, *FlatStroke; \
+   DOUBLE FlatScale; \
+   LARGE  StrokeKey; \
    struct rkVectorClip     *ClipMask; \
    struct rkVectorGradient *StrokeGradient, *FillGradient; \
    struct rkVectorImage    *FillImage, *StrokeImage; \
@@ -28,6 +32,8 @@
    UBYTE  ClipRule; \
    UBYTE  Dirty; \
    UBYTE  EnableBkgd:1; \
+   UBYTE  ValidBounds:1; \
+   UBYTE  PaintDirty:1; \
    agg::line_join_e  LineJoin; \
    agg::line_cap_e   LineCap; \
    agg::inner_join_e InnerJoin; \
@@ -115,3 +121,6 @@ static void  vecSmooth4(class SimpleVector *, DOUBLE CtrlX2, DOUBLE CtrlY2, DOUB
 static void  vecClosePath(class SimpleVector *);
 static void  vecRewindPath(class SimpleVector *);
 static LONG  vecGetVertex(class SimpleVector *, DOUBLE *, DOUBLE *);
+static void  vecSetFilterCache(LARGE);
+static void  vecSetGlyphCache(LARGE);
+static void  vecGetGlyphCacheStats(LARGE *, LARGE *, LARGE *);
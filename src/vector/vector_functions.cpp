@@ -255,6 +255,29 @@ static void vecFreePath(APTR Path)
 
 /*****************************************************************************
 
+-FUNCTION-
+GetGlyphCacheStats: Returns the usage statistics of the glyph cache.
+
+The outlines and advances of the glyphs that are drawn by @VectorText objects are retained in a cache that is shared by
+all text in the process.  This function returns the number of glyph lookups that have been satisfied by the cache, the
+number that required the glyph to be loaded from its font, and the amount of memory that the cache is using.
+
+-INPUT-
+&large Hits: The total number of glyph lookups that were satisfied by the cache.
+&large Misses: The total number of glyph lookups that required the glyph to be loaded.
+&large Usage: The number of bytes currently used by the cache.
+
+*****************************************************************************/
+
+static void vecGetGlyphCacheStats(LARGE *Hits, LARGE *Misses, LARGE *Usage)
+{
+   if (Hits) *Hits = glGlyphCacheHits;
+   if (Misses) *Misses = glGlyphCacheMisses;
+   if (Usage) *Usage = glGlyphCacheUsage;
+}
+
+/*****************************************************************************
+
 -FUNCTION-
 GetVertex: Retrieve the coordinates of the current vertex.
 
@@ -676,6 +699,54 @@ static void vecRewindPath(SimpleVector *Vector)
 
 /*****************************************************************************
 
+-FUNCTION-
+SetFilterCache: Sets the memory budget for cached filter results.
+
+A @VectorFilter retains the result of its effect chain between draws, so that it can be redrawn without processing
+the effects again if its source graphic, dimensions and effects are unchanged.  The total amount of bitmap memory that
+is held for this purpose by all filters is limited by the budget that is set here.  Filters that would exceed the budget
+release their bitmaps after drawing and process their effects in full on every draw.
+
+The default limit is 64MB.  Setting a limit of zero disables the caching of filter results.  Reducing the limit does
+not release any memory until the affected filters are next drawn.
+
+-INPUT-
+large Limit: The maximum number of bytes to be used for cached filter results.
+
+*****************************************************************************/
+
+static void vecSetFilterCache(LARGE Limit)
+{
+   if (Limit < 0) Limit = 0;
+   glFilterCacheLimit = Limit;
+}
+
+/*****************************************************************************
+
+-FUNCTION-
+SetGlyphCache: Sets the memory limit of the glyph cache.
+
+The outlines and advances of the glyphs that are drawn by @VectorText objects are retained in a cache that is shared by
+all text in the process, so that text can be regenerated without loading and decomposing its glyphs again.  Glyphs are
+cached for each font face, size and glyph index.  When the cache exceeds the limit that is set here, the least
+recently used glyphs are discarded.
+
+The default limit is 8MB.  Setting a limit of zero disables the cache and discards its content.
+
+-INPUT-
+large Limit: The maximum number of bytes to be used for cached glyphs.
+
+*****************************************************************************/
+
+static void vecSetGlyphCache(LARGE Limit)
+{
+   if (Limit < 0) Limit = 0;
+   glGlyphCacheLimit = Limit;
+   trim_glyph_cache();
+}
+
+/*****************************************************************************
+
 -FUNCTION-
 Smooth3: Alter a path by setting a smooth3 command at the current vertex position.
 
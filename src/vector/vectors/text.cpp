@@ -219,6 +219,167 @@ Close:
    return ERR_Okay;
 }
 
+//****************************************************************************
+// The glyph cache retains the decomposed outlines and advances of glyphs so that text can be regenerated without
+// calling Freetype.  It is shared by all VectorText objects and is keyed by face, point size and glyph index.  Each
+// outline is stored as the vertex stream that it produces once curves have been flattened, so a cache hit costs no
+// more than an affine copy of the vertices.
+//
+// Memory usage is limited by glGlyphCacheLimit and the least recently used glyphs are discarded first.  Faces are
+// tracked through the generic finalizer of the FT_Face, so that their glyphs are discarded when Freetype closes them.
+
+struct glyph_key {
+   FT_Face Face;
+   LONG Size;  // Point size in 26.6 format
+   LONG Glyph;
+   bool operator==(const glyph_key &Other) const {
+      return (Face IS Other.Face) and (Size IS Other.Size) and (Glyph IS Other.Glyph);
+   }
+};
+
+struct glyph_key_hash {
+   size_t operator()(const glyph_key &Key) const {
+      return std::hash<APTR>()(Key.Face) ^ (size_t(Key.Size) * 0x9e3779b97f4a7c15ULL) ^ (size_t(Key.Glyph) << 20);
+   }
+};
+
+struct cached_glyph {
+   std::vector<DOUBLE> Coords;  // (X, Y) for each vertex
+   std::vector<UBYTE> Commands; // AGG path command for each vertex
+   DOUBLE AdvanceX, AdvanceY;
+   std::list<glyph_key>::iterator Used; // Position in the LRU list
+   LARGE Size;
+};
+
+// Vertex source for replaying a cached glyph outline.
+
+class glyph_path {
+   const cached_glyph &mGlyph;
+   size_t mIndex = 0;
+
+public:
+   glyph_path(const cached_glyph &Glyph) : mGlyph(Glyph) { }
+   void rewind(unsigned) { mIndex = 0; }
+   unsigned vertex(double *X, double *Y) {
+      if (mIndex >= mGlyph.Commands.size()) return agg::path_cmd_stop;
+      *X = mGlyph.Coords[mIndex * 2];
+      *Y = mGlyph.Coords[(mIndex * 2) + 1];
+      return mGlyph.Commands[mIndex++];
+   }
+};
+
+static std::unordered_map<glyph_key, cached_glyph, glyph_key_hash> glGlyphs;
+static std::list<glyph_key> glGlyphsUsed; // Most recently used glyphs are at the front
+static std::vector<FT_Face> glGlyphFaces; // Faces that have had their finalizer set by the cache
+
+// Discard least recently used glyphs until the cache is within its limit.
+
+static void trim_glyph_cache(void)
+{
+   while ((glGlyphCacheUsage > glGlyphCacheLimit) and (!glGlyphsUsed.empty())) {
+      auto it = glGlyphs.find(glGlyphsUsed.back());
+      glGlyphCacheUsage -= it->second.Size;
+      glGlyphs.erase(it);
+      glGlyphsUsed.pop_back();
+   }
+}
+
+// Called by Freetype when a face is closed.
+
+static void glyph_face_finalizer(void *Object)
+{
+   auto face = (FT_Face)Object;
+
+   for (auto it=glGlyphsUsed.begin(); it != glGlyphsUsed.end(); ) {
+      if (it->Face IS face) {
+         auto glyph = glGlyphs.find(*it);
+         glGlyphCacheUsage -= glyph->second.Size;
+         glGlyphs.erase(glyph);
+         it = glGlyphsUsed.erase(it);
+      }
+      else it++;
+   }
+
+   for (auto it=glGlyphFaces.begin(); it != glGlyphFaces.end(); it++) {
+      if (*it IS face) { glGlyphFaces.erase(it); break; }
+   }
+}
+
+// Empties the cache and detaches it from all faces.  Called on expunge.
+
+static void clear_glyph_cache(void)
+{
+   for (auto face : glGlyphFaces) {
+      if (face->generic.finalizer IS &glyph_face_finalizer) face->generic.finalizer = NULL;
+   }
+   glGlyphFaces.clear();
+   glGlyphs.clear();
+   glGlyphsUsed.clear();
+   glGlyphCacheUsage = 0;
+}
+
+// Returns the cached outline of a glyph, loading it from the face if necessary.  The size of the face must already be
+// set to Size.  Returns NULL if the glyph has no outline.
+
+static const cached_glyph * get_glyph(FT_Face Face, LONG Size, LONG Glyph)
+{
+   const glyph_key key = { Face, Size, Glyph };
+
+   auto it = glGlyphs.find(key);
+   if (it != glGlyphs.end()) {
+      glGlyphCacheHits++;
+      glGlyphsUsed.splice(glGlyphsUsed.begin(), glGlyphsUsed, it->second.Used);
+      return &it->second;
+   }
+
+   glGlyphCacheMisses++;
+
+   if (EFT_Load_Glyph(Face, Glyph, FT_LOAD_LINEAR_DESIGN)) return NULL;
+
+   agg::path_storage char_path;
+   if (decompose_ft_outline(Face->glyph->outline, true, char_path)) return NULL;
+
+   static cached_glyph glyph; // Holds the most recently loaded glyph if it is not cached
+   glyph.Coords.clear();
+   glyph.Commands.clear();
+
+   DOUBLE x, y;
+   unsigned cmd;
+   char_path.rewind(0);
+   while (!agg::is_stop(cmd = char_path.vertex(&x, &y))) {
+      glyph.Coords.push_back(x);
+      glyph.Coords.push_back(y);
+      glyph.Commands.push_back(cmd);
+   }
+
+   glyph.AdvanceX = int26p6_to_dbl(Face->glyph->advance.x);
+   glyph.AdvanceY = int26p6_to_dbl(Face->glyph->advance.y);
+   glyph.Size = sizeof(cached_glyph) + (glyph.Coords.size() * sizeof(DOUBLE)) + glyph.Commands.size();
+
+   if (glyph.Size > glGlyphCacheLimit) return &glyph;
+
+   // Faces that are in use by something else cannot be tracked, so their glyphs are not cached.
+
+   if (std::find(glGlyphFaces.begin(), glGlyphFaces.end(), Face) IS glGlyphFaces.end()) {
+      if (Face->generic.finalizer) return &glyph;
+      Face->generic.finalizer = &glyph_face_finalizer;
+      glGlyphFaces.push_back(Face);
+   }
+
+   glGlyphCacheUsage += glyph.Size;
+   trim_glyph_cache(); // Makes room for the new glyph, which cannot be evicted as it is not yet in the list
+
+   auto &entry = glGlyphs[key];
+   entry.Coords   = glyph.Coords;
+   entry.Commands = glyph.Commands;
+   entry.AdvanceX = glyph.AdvanceX;
+   entry.AdvanceY = glyph.AdvanceY;
+   entry.Size     = glyph.Size;
+   glGlyphsUsed.push_front(key);
+   entry.Used = glGlyphsUsed.begin();
+   return &entry;
+}
+
 //****************************************************************************
 // This path generator creates text as a single path, by concatenating the paths of all individual characters in the
 // string.
@@ -249,7 +410,7 @@ static void generate_text(objVectorText *Vector)
          morph = NULL;
       }
       else {
-         if (morph->Dirty) { // Regenerate the target path if necessary
+         if ((!morph->BasePath) or (morph->Dirty & RC_BASE_PATH)) { // Regenerate the target path if necessary
             gen_vector_path((objVector *)morph);
             morph->Dirty = 0;
          }
@@ -297,7 +458,6 @@ static void generate_text(objVectorText *Vector)
    DOUBLE upscale = 1;
    if ((Vector->Transition) or (morph)) upscale = 100;
 
-   agg::path_storage char_path;
    agg::trans_affine scale_char;
 
    // The '3/4' conversion makes sense if you refer to read_unit() and understand that a point is 3/4 of a pixel.
@@ -313,8 +473,9 @@ static void generate_text(objVectorText *Vector)
    if (!Vector->FreetypeSize) EFT_New_Size(ftface, &Vector->FreetypeSize);
    if (Vector->FreetypeSize != ftface->size) EFT_Activate_Size(Vector->FreetypeSize);
 
-   if (ftface->size->metrics.height != dbl_to_int26p6(point_size)) {
-      EFT_Set_Char_Size(ftface, 0, dbl_to_int26p6(point_size), FIXED_DPI, FIXED_DPI);
+   const LONG char_size = dbl_to_int26p6(point_size);
+   if (ftface->size->metrics.height != char_size) {
+      EFT_Set_Char_Size(ftface, 0, char_size, FIXED_DPI, FIXED_DPI);
    }
 
    while (*str) {
@@ -338,79 +499,76 @@ static void generate_text(objVectorText *Vector)
 
          LONG glyph = EFT_Get_Char_Index(ftface, unicode);
 
-         if (!EFT_Load_Glyph(ftface, glyph, FT_LOAD_LINEAR_DESIGN)) {
-            char_path.free_all();
-            if (!decompose_ft_outline(ftface->glyph->outline, true, char_path)) {
-               get_kerning_xy(ftface, glyph, prevglyph, &kx, &ky);
+         if (auto cached = get_glyph(ftface, char_size, glyph)) {
+            glyph_path char_path(*cached);
+            get_kerning_xy(ftface, glyph, prevglyph, &kx, &ky);
 
-               DOUBLE char_width = int26p6_to_dbl(ftface->glyph->advance.x) + kx;
+            DOUBLE char_width = cached->AdvanceX + kx;
 
-               char_width = char_width * ABS(transform.sx);
-               //char_width = char_width * transform.scale();
+            char_width = char_width * ABS(transform.sx);
+            //char_width = char_width * transform.scale();
 
-               if (morph) {
-                  // Compute end_vx,end_vy (the last vertex to use for angle computation) and store the distance from start_x,start_y to end_vx,end_vy in dist.
-                  if (char_width > dist) {
-                     while (cmd != agg::path_cmd_stop) {
-                        DOUBLE current_x, current_y;
-                        cmd = morph->BasePath->vertex(&current_x, &current_y);
-                        if (agg::is_vertex(cmd)) {
-                           const DOUBLE x = (current_x - end_vx), y = (current_y - end_vy);
-                           const DOUBLE vertex_dist = sqrt((x * x) + (y * y));
-                           dist += vertex_dist;
+            if (morph) {
+               // Compute end_vx,end_vy (the last vertex to use for angle computation) and store the distance from start_x,start_y to end_vx,end_vy in dist.
+               if (char_width > dist) {
+                  while (cmd != agg::path_cmd_stop) {
+                     DOUBLE current_x, current_y;
+                     cmd = morph->BasePath->vertex(&current_x, &current_y);
+                     if (agg::is_vertex(cmd)) {
+                        const DOUBLE x = (current_x - end_vx), y = (current_y - end_vy);
+                        const DOUBLE vertex_dist = sqrt((x * x) + (y * y));
+                        dist += vertex_dist;
 
-                           //log.trace("%c char_width: %.2f, VXY: %.2f %.2f, next: %.2f %.2f, dist: %.2f", unicode, char_width, start_x, start_y, end_vx, end_vy, dist);
+                        //log.trace("%c char_width: %.2f, VXY: %.2f %.2f, next: %.2f %.2f, dist: %.2f", unicode, char_width, start_x, start_y, end_vx, end_vy, dist);
 
-                           end_vx = current_x;
-                           end_vy = current_y;
+                        end_vx = current_x;
+                        end_vy = current_y;
 
-                           if (char_width <= dist) break; // Stop processing vertices if dist exceeds the character width.
-                        }
+                        if (char_width <= dist) break; // Stop processing vertices if dist exceeds the character width.
                      }
                   }
+               }
 
-                  // At this stage we can say that start_x,start_y is the bottom left corner of the character and end_vx,end_vy is
-                  // the bottom right corner.
+               // At this stage we can say that start_x,start_y is the bottom left corner of the character and end_vx,end_vy is
+               // the bottom right corner.
 
-                  DOUBLE tx = start_x, ty = start_y;
+               DOUBLE tx = start_x, ty = start_y;
 
-                  if (cmd != agg::path_cmd_stop) { // Advance (start_x,start_y) to the next point on the morph path.
-                     angle = atan2(end_vy - start_y, end_vx - start_x);
+               if (cmd != agg::path_cmd_stop) { // Advance (start_x,start_y) to the next point on the morph path.
+                  angle = atan2(end_vy - start_y, end_vx - start_x);
 
-                     DOUBLE x = end_vx - start_x, y = end_vy - start_y;
-                     DOUBLE d = sqrt(x * x + y * y);
-                     start_x += x / d * (char_width);
-                     start_y += y / d * (char_width);
+                  DOUBLE x = end_vx - start_x, y = end_vy - start_y;
+                  DOUBLE d = sqrt(x * x + y * y);
+                  start_x += x / d * (char_width);
+                  start_y += y / d * (char_width);
 
-                     dist -= char_width; // The distance to the next vertex is reduced by the width of the char.
-                  }
-                  else { // No more path to use - advance start_x,start_y by the last known angle.
-                     start_x += (char_width) * cos(angle);
-                     start_y += (char_width) * sin(angle);
-                  }
+                  dist -= char_width; // The distance to the next vertex is reduced by the width of the char.
+               }
+               else { // No more path to use - advance start_x,start_y by the last known angle.
+                  start_x += (char_width) * cos(angle);
+                  start_y += (char_width) * sin(angle);
+               }
 
-                  //log.trace("Char '%c' is at (%.2f %.2f) to (%.2f %.2f), angle: %.2f, remaining dist: %.2f", unicode, tx, ty, start_x, start_y, angle / DEG2RAD, dist);
+               //log.trace("Char '%c' is at (%.2f %.2f) to (%.2f %.2f), angle: %.2f, remaining dist: %.2f", unicode, tx, ty, start_x, start_y, angle / DEG2RAD, dist);
 
-                  if (unicode > 0x20) {
-                     transform.rotate(angle); // Rotate the character in accordance with its position on the path angle.
-                     transform.translate(tx, ty); // Move the character to its correct position on the path.
-                     agg::conv_transform<agg::path_storage, agg::trans_affine> trans_path(char_path, transform);
-                     Vector->BasePath->concat_path(trans_path);
-                  }
-                  dx += char_width;
-               }
-               else {
-                  transform.translate(dx, dy);
-                  agg::conv_transform<agg::path_storage, agg::trans_affine> trans_path(char_path, transform);
+               if (unicode > 0x20) {
+                  transform.rotate(angle); // Rotate the character in accordance with its position on the path angle.
+                  transform.translate(tx, ty); // Move the character to its correct position on the path.
+                  agg::conv_transform<glyph_path, agg::trans_affine> trans_path(char_path, transform);
                   Vector->BasePath->concat_path(trans_path);
-                  // Advance to next character coordinate
-                  dx += char_width;
-                  dy += int26p6_to_dbl(ftface->glyph->advance.y) + ky;
                }
-
+               dx += char_width;
+            }
+            else {
+               transform.translate(dx, dy);
+               agg::conv_transform<glyph_path, agg::trans_affine> trans_path(char_path, transform);
+               Vector->BasePath->concat_path(trans_path);
+               // Advance to next character coordinate
+               dx += char_width;
+               dy += cached->AdvanceY + ky;
             }
-            else log.trace("Failed to get outline of character.");
          }
+         else log.trace("Failed to get outline of character.");
          prevglyph = glyph;
       }
    }
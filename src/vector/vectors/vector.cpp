@@ -121,6 +121,11 @@ static ERROR VECTOR_Free(objVector *Self, APTR Args)
 
    VECTOR_ClearTransforms(Self, NULL);
 
+   if (Self->Head.Flags & NF_INITIALISED) {
+      damage_vector(Self); // The area occupied by the vector must be redrawn by incremental drawing.
+      invalidate_bounds(Self); // The vector will no longer contribute to its parents' boundaries.
+   }
+
    // Patch the nearest vectors that are linked to ours.
    if (Self->Next) Self->Next->Prev = Self->Prev;
    if (Self->Prev) Self->Prev->Next = Self->Next;
@@ -132,6 +137,8 @@ static ERROR VECTOR_Free(objVector *Self, APTR Args)
 
    delete Self->Transform;       Self->Transform = NULL;
    delete Self->BasePath;        Self->BasePath = NULL;
+   delete Self->FlatFill;        Self->FlatFill = NULL;
+   delete Self->FlatStroke;      Self->FlatStroke = NULL;
    delete Self->StrokeRaster;    Self->StrokeRaster = NULL;
    delete Self->FillRaster;      Self->FillRaster = NULL;
 
@@ -310,6 +317,8 @@ static ERROR VECTOR_Init(objVector *Self, APTR Void)
    }
    else return log.warning(ERR_UnsupportedOwner);
 
+   invalidate_bounds(Self); // Parent boundaries must be recalculated to include the new vector.
+
    // Find the nearest parent viewport.
 
    OBJECTPTR scan = get_parent(Self);
@@ -439,6 +448,13 @@ static ERROR VECTOR_PointInPath(objVector *Self, struct vecPointInPath *Args)
 
       if (!Self->BasePath) return ERR_NoData;
 
+      // The cached boundary of the rasterised path encloses the path, so points outside of it can be rejected
+      // without iterating over the path.
+
+      if ((Self->FillRaster) or (Self->StrokeRaster)) {
+         if ((Args->X < Self->BX1) or (Args->Y < Self->BY1) or (Args->X >= Self->BX2) or (Args->Y >= Self->BY2)) return ERR_False;
+      }
+
       // Quick check to see if (X,Y) is within the path's boundary.
 
       agg::conv_transform<agg::path_storage, agg::trans_affine> base_path(*Self->BasePath, *Self->Transform);
@@ -489,6 +505,7 @@ static ERROR VECTOR_Push(objVector *Self, struct vecPush *Args)
    if (Args->Position < 0) { // Move backward through the stack.
       if (!Self->Prev) return ERR_Okay; // Return if the vector is at the top of its branch
 
+      damage_vector(Self);
       LONG i = -Args->Position;
       Self->Prev->Next = Self->Next;
       if (Self->Next) Self->Next->Prev = Self->Prev;
@@ -499,7 +516,9 @@ static ERROR VECTOR_Push(objVector *Self, struct vecPush *Args)
       }
       Self->Next = scan;
       Self->Prev = scan->Prev;
-      if (!Self->Prev) {
+      scan->Prev = Self;
+      if (Self->Prev) Self->Prev->Next = Self;
+      else {
          if (scan->Parent->ClassID IS ID_VECTOR) ((objVector *)scan->Parent)->Child = Self;
          else if (scan->Parent->ClassID IS ID_VECTORSCENE) ((objVectorScene *)scan->Parent)->Viewport = Self;
          Self->Parent = scan->Parent;
@@ -508,6 +527,7 @@ static ERROR VECTOR_Push(objVector *Self, struct vecPush *Args)
    else if (Args->Position > 0) { // Move forward through the stack.
       if (!Self->Next) return ERR_Okay;
 
+      damage_vector(Self);
       LONG i = Args->Position;
       if (Self->Prev) Self->Prev->Next = Self->Next;
       Self->Next->Prev = Self->Prev;
@@ -522,6 +542,7 @@ static ERROR VECTOR_Push(objVector *Self, struct vecPush *Args)
       }
       Self->Prev = scan;
       Self->Next = scan->Next;
+      if (Self->Next) Self->Next->Prev = Self;
       scan->Next = Self;
    }
 
@@ -989,6 +1010,7 @@ static ERROR VECTOR_SET_Fill(objVector *Self, CSTRING Value)
    if (Self->FillString) { FreeResource(Self->FillString); Self->FillString = NULL; }
    Self->FillString = StrClone(Value);
    vecReadPainter(&Self->Head, Value, &Self->FillColour, &Self->FillGradient, &Self->FillImage, &Self->FillPattern);
+   reset_paint(Self);
    return ERR_Okay;
 }
 
@@ -1025,6 +1047,7 @@ static ERROR VECTOR_SET_FillColour(objVector *Self, FLOAT *Value, LONG Elements)
 
    if (Self->FillString) { FreeResource(Self->FillString); Self->FillString = NULL; }
 
+   reset_paint(Self);
    return ERR_Okay;
 }
 
@@ -1050,6 +1073,7 @@ static ERROR VECTOR_SET_FillOpacity(objVector *Self, DOUBLE Value)
 
    if ((Value >= 0) and (Value <= 1.0)) {
       Self->FillOpacity = Value;
+      reset_paint(Self);
       return ERR_Okay;
    }
    else return log.warning(ERR_OutOfRange);
@@ -1437,6 +1461,8 @@ static ERROR VECTOR_SET_Next(objVector *Self, objVector *Value)
    if ((!Value) or (Value IS Self)) return log.warning(ERR_InvalidValue);
    if (Self->Head.OwnerID != Value->Head.OwnerID) return log.warning(ERR_UnsupportedOwner); // Owners must match
 
+   damage_vector(Self);
+
    if (Self->Next) Self->Next->Prev = NULL; // Detach from the current Next object.
    if (Self->Prev) Self->Prev->Next = NULL; // Detach from the current Prev object.
 
@@ -1494,6 +1520,7 @@ static ERROR VECTOR_SET_Opacity(objVector *Self, DOUBLE Value)
 {
    if ((Value >= 0) and (Value <= 1.0)) {
       Self->Opacity = Value;
+      reset_paint(Self);
       return ERR_Okay;
    }
    else return ERR_OutOfRange;
@@ -1532,6 +1559,8 @@ static ERROR VECTOR_SET_Prev(objVector *Self, objVector *Value)
    if (!Value) return log.warning(ERR_InvalidValue);
    if (Self->Head.OwnerID != Value->Head.OwnerID) return log.warning(ERR_UnsupportedOwner); // Owners must match
 
+   damage_vector(Self);
+
    if (Self->Next) Self->Next->Prev = NULL; // Detach from the current Next object.
    if (Self->Prev) Self->Prev->Next = NULL; // Detach from the current Prev object.
 
@@ -1706,6 +1735,7 @@ static ERROR VECTOR_SET_Stroke(objVector *Self, STRING Value)
    if (Self->StrokeString) { FreeResource(Self->StrokeString); Self->StrokeString = NULL; }
    Self->StrokeString = StrClone(Value);
    vecReadPainter(&Self->Head, Value, &Self->StrokeColour, &Self->StrokeGradient, &Self->StrokeImage, &Self->StrokePattern);
+   reset_paint(Self);
    return ERR_Okay;
 }
 
@@ -1740,6 +1770,7 @@ static ERROR VECTOR_SET_StrokeColour(objVector *Self, FLOAT *Value, LONG Element
       else Self->StrokeColour.Alpha = 1;
    }
    else Self->StrokeColour.Alpha = 0;
+   reset_paint(Self);
    return ERR_Okay;
 }
 
@@ -1765,6 +1796,7 @@ static ERROR VECTOR_SET_StrokeOpacity(objVector *Self, DOUBLE Value)
 {
    if ((Value >= 0) and (Value <= 1.0)) {
       Self->StrokeOpacity = Value;
+      reset_paint(Self);
       return ERR_Okay;
    }
    else return ERR_OutOfRange;
@@ -1785,6 +1817,7 @@ static ERROR VECTOR_SET_StrokeWidth(objVector *Self, DOUBLE Value)
 {
    if ((Value >= 0.0) and (Value <= 1000.0)) {
       Self->StrokeWidth = Value;
+      reset_final_path(Self);
       return ERR_Okay;
    }
    else return ERR_OutOfRange;
@@ -1848,6 +1881,15 @@ Visibility: Controls the visibility of a vector and its children.
 
 *****************************************************************************/
 
+static ERROR VECTOR_SET_Visibility(objVector *Self, LONG Value)
+{
+   Self->Visibility = Value;
+   reset_paint(Self);
+   return ERR_Okay;
+}
+
+//****************************************************************************
+
 static const FieldDef clTransformFlags[] = {
    { "Matrix",    VTF_MATRIX },
    { "Translate", VTF_TRANSLATE },
@@ -1927,7 +1969,7 @@ static const FieldArray clVectorFields[] = {
    { "DashOffset",       FDF_DOUBLE|FD_RW,      0, NULL, NULL },
    { "ActiveTransforms", FDF_LONGFLAGS|FD_R,    (MAXINT)&clTransformFlags, NULL, NULL },
    { "DashTotal",        FDF_LONG|FDF_R,        0, NULL, NULL },
-   { "Visibility",       FDF_LONG|FDF_LOOKUP|FDF_RW,  (MAXINT)&clVisibility, NULL, NULL },
+   { "Visibility",       FDF_LONG|FDF_LOOKUP|FDF_RW,  (MAXINT)&clVisibility, NULL, (APTR)VECTOR_SET_Visibility },
    // Virtual fields
    { "ClipRule",      FDF_VIRTUAL|FDF_LONG|FDF_LOOKUP|FDF_RW, (MAXINT)&clFillRule, (APTR)VECTOR_GET_ClipRule, (APTR)VECTOR_SET_ClipRule },
    { "DashArray",     FDF_VIRTUAL|FDF_ARRAY|FDF_DOUBLE|FD_RW, 0, (APTR)VECTOR_GET_DashArray, (APTR)VECTOR_SET_DashArray },
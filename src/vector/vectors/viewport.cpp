@@ -69,7 +69,7 @@ static ERROR VIEW_Move(objVectorViewport *Self, struct acMove *Args)
       Self->vpDimensions = (Self->vpDimensions | DMF_FIXED_Y) & (~DMF_RELATIVE_Y);
       Self->vpTargetY += y;
 
-      mark_dirty((objVector *)Self, RC_FINAL_PATH|RC_TRANSFORM);
+      mark_dirty((objVector *)Self, RC_TRANSFORM); // Moving the viewport does not affect the paths of its content.
       return ERR_Okay;
    }
    else return ERR_GetField;
@@ -95,7 +95,7 @@ static ERROR VIEW_MoveToPoint(objVectorViewport *Self, struct acMoveToPoint *Arg
       Self->vpTargetY = Args->Y;
    }
 
-   mark_dirty((objVector *)Self, RC_FINAL_PATH|RC_TRANSFORM);
+   mark_dirty((objVector *)Self, RC_TRANSFORM);
    return ERR_Okay;
 }
 